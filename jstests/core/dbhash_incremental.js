@@ -0,0 +1,50 @@
+// Tests the incremental mode of the dbHash command: hashes answered from the incrementally
+// maintained multiset hash must track inserts, updates and deletes, and two identical data
+// sets must hash equal.
+
+var mydb = db.getSisterDB("dbhash_incremental");
+mydb.dropDatabase();
+
+var t = mydb.foo;
+
+t.insert({_id: 1, x: 1});
+t.insert({_id: 2, x: 2});
+
+function collHash() {
+    var res = mydb.runCommand({dbhash: 1, incremental: true});
+    assert.commandWorked(res);
+    return res.collections.foo;
+}
+
+// The first incremental dbHash seeds the hash; repeating it must be stable.
+var h1 = collHash();
+assert.eq(h1, collHash());
+
+// Writes change the hash...
+t.insert({_id: 3, x: 3});
+var h2 = collHash();
+assert.neq(h1, h2);
+
+t.update({_id: 3}, {$set: {x: 30}});
+var h3 = collHash();
+assert.neq(h2, h3);
+
+// ... and undoing them restores it.
+t.update({_id: 3}, {$set: {x: 3}});
+assert.eq(h2, collHash());
+t.remove({_id: 3});
+assert.eq(h1, collHash());
+
+// The incrementally maintained hash must agree with a fresh seed of the same data.
+var t2 = mydb.bar;
+t2.insert({_id: 2, x: 2});
+t2.insert({_id: 1, x: 1});
+var res = mydb.runCommand({dbhash: 1, incremental: true});
+assert.commandWorked(res);
+assert.eq(res.collections.foo, res.collections.bar);
+
+// Default (scan-based) dbHash output is unaffected by incremental runs.
+var scan1 = mydb.runCommand("dbhash");
+var scan2 = mydb.runCommand("dbhash");
+assert.commandWorked(scan1);
+assert.eq(scan1.collections.foo, scan2.collections.foo);
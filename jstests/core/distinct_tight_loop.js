@@ -0,0 +1,64 @@
+// Tests that a filter-less distinct over a single-field index (answered by the tight-loop
+// index iteration) returns the same values as a distinct backed by a collection scan, and
+// that requests the tight loop cannot serve (filters, multikey indexes) remain correct.
+// @tags: [assumes_unsharded_collection]
+
+var t = db.distinct_tight_loop;
+t.drop();
+
+function toSet(values) {
+    return values.map(tojson).sort();
+}
+
+var docs = [
+    {_id: 0, x: 1},
+    {_id: 1, x: 1},
+    {_id: 2, x: 2},
+    {_id: 3, x: NumberLong(3)},
+    {_id: 4, x: 5.5},
+    {_id: 5, x: "a"},
+    {_id: 6, x: "a"},
+    {_id: 7, x: "b"},
+    {_id: 8, x: null},
+    {_id: 9, x: true},
+    {_id: 10, x: false},
+    {_id: 11, x: new Date(0)},
+    {_id: 12, x: {y: 1}},
+    {_id: 13, x: {y: 2}},
+    {_id: 14},  // Missing 'x'; contributes a null index entry, and null is already present.
+];
+docs.forEach(function(doc) {
+    assert.writeOK(t.insert(doc));
+});
+
+// Baseline from a collection scan, before any index exists.
+var scanValues = t.distinct("x");
+
+// With a single-field index the tight loop serves the request; values must agree.
+assert.commandWorked(t.ensureIndex({x: 1}));
+assert.eq(toSet(scanValues), toSet(t.distinct("x")));
+
+// A compound index whose first field is the key is equally usable.
+assert.commandWorked(t.dropIndex({x: 1}));
+assert.commandWorked(t.ensureIndex({x: 1, _id: 1}));
+assert.eq(toSet(scanValues), toSet(t.distinct("x")));
+
+// A filtered distinct takes the regular executor path and stays correct.
+assert.eq([1, 2, 3, 5.5], t.distinct("x", {x: {$gt: 0}}).sort());
+
+// A multikey index cannot be served by the tight loop: distinct must expand arrays.
+var arrays = db.distinct_tight_loop_arrays;
+arrays.drop();
+assert.writeOK(arrays.insert({x: [1, 2]}));
+assert.writeOK(arrays.insert({x: [2, 3]}));
+assert.commandWorked(arrays.ensureIndex({x: 1}));
+assert.eq([1, 2, 3], arrays.distinct("x").sort());
+
+// A descending index does not qualify either, but results must still be right.
+var desc = db.distinct_tight_loop_desc;
+desc.drop();
+assert.writeOK(desc.insert({x: 1}));
+assert.writeOK(desc.insert({x: 2}));
+assert.writeOK(desc.insert({x: 2}));
+assert.commandWorked(desc.ensureIndex({x: -1}));
+assert.eq([1, 2], desc.distinct("x").sort());
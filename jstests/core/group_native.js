@@ -0,0 +1,91 @@
+// Tests that group specs whose reduce is a sequence of simple accumulations produce the same
+// results whether the reduce runs natively or in JavaScript.
+//
+// Cannot implicitly shard accessed collections because of unsupported group operator on sharded
+// collection.
+// @tags: [assumes_unsharded_collection]
+(function() {
+    "use strict";
+
+    const t = db.group_native;
+    t.drop();
+
+    assert.writeOK(t.insert({a: 1, price: 10, qty: 2}));
+    assert.writeOK(t.insert({a: 1, price: 2.5, qty: 4}));
+    assert.writeOK(t.insert({a: 2, price: 7, qty: 1}));
+    assert.writeOK(t.insert({a: 2, price: NumberInt(3), qty: 3}));
+
+    // A reduce of simple accumulations, and an equivalent one written in a form that must run
+    // in JavaScript.  Both must produce identical results.
+    const nativeSpec = {
+        key: {a: 1},
+        reduce: function(obj, prev) {
+            prev.total += obj.price;
+            prev.count++;
+        },
+        initial: {total: 0, count: 0}
+    };
+    const jsSpec = {
+        key: {a: 1},
+        reduce: function(obj, prev) {
+            prev.total = prev.total + obj.price;
+            prev.count = prev.count + 1;
+        },
+        initial: {total: 0, count: 0}
+    };
+    assert.eq(t.group(nativeSpec), t.group(jsSpec), "native vs JS reduce");
+
+    // The native path reports itself in explain.
+    function ranNatively(spec) {
+        const explain = db.runCommand({
+            explain: {group: Object.extend({ns: t.getName(), cond: {}}, spec)},
+            verbosity: "executionStats"
+        });
+        assert.commandWorked(explain);
+        let stage = explain.executionStats.executionStages;
+        while (stage.stage !== "GROUP") {
+            stage = stage.inputStage;
+        }
+        return stage.nativeReduce;
+    }
+    assert(ranNatively(nativeSpec), "expected native reduce");
+    assert(!ranNatively(jsSpec), "expected JavaScript reduce");
+
+    // A finalize function still runs in JavaScript, over natively accumulated results.
+    const avgSpec = Object.extend({
+        finalize: function(res) {
+            res.avg = res.total / res.count;
+        }
+    },
+                                  nativeSpec);
+    const avgRes = t.group(avgSpec);
+    assert.eq(2, avgRes.length);
+    assert.eq(avgRes[0].total / avgRes[0].count, avgRes[0].avg, "finalize over native results");
+
+    // A value that only JavaScript can coerce (here a string) forces a mid-stream fallback;
+    // the results must match a pure JavaScript run.
+    assert.writeOK(t.insert({a: 1, price: "n/a", qty: 1}));
+    assert.eq(t.group(nativeSpec), t.group(jsSpec), "fallback vs JS reduce");
+
+    // Missing fields accumulate as NaN on both paths.
+    t.drop();
+    assert.writeOK(t.insert({a: 1, price: 5}));
+    assert.writeOK(t.insert({a: 1}));
+    const nanRes = t.group(nativeSpec);
+    assert.eq(1, nanRes.length);
+    assert(isNaN(nanRes[0].total), "missing field accumulates as NaN");
+    assert.eq(2, nanRes[0].count);
+
+    // Dotted paths into the input document.
+    t.drop();
+    assert.writeOK(t.insert({a: 1, b: {c: 3}}));
+    assert.writeOK(t.insert({a: 1, b: {c: 4}}));
+    const dottedRes = t.group({
+        key: {a: 1},
+        reduce: function(obj, prev) {
+            prev.sum += obj.b.c;
+        },
+        initial: {sum: 0}
+    });
+    assert.eq([{a: 1, sum: 7}], dottedRes, "dotted source path");
+}());
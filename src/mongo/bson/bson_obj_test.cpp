@@ -577,6 +577,20 @@ TEST(BSONObj, getFields) {
     ASSERT_EQUALS(fields[2].numberInt(), 6);
 }
 
+TEST(BSONObj, getFieldShortAndLongNames) {
+    // Exercise both the short-name (vectorizable) lookup path and the generic path for names
+    // of 16 bytes or more, including lookups near the end of the buffer.
+    auto e = BSON("a" << 1 << "ab" << 2 << "averyveryverylongfieldname" << 3 << "z" << 4);
+    ASSERT_EQUALS(e.getField("a").numberInt(), 1);
+    ASSERT_EQUALS(e.getField("ab").numberInt(), 2);
+    ASSERT_EQUALS(e.getField("averyveryverylongfieldname").numberInt(), 3);
+    ASSERT_EQUALS(e.getField("z").numberInt(), 4);
+    ASSERT_TRUE(e.getField("ab2").eoo());
+    ASSERT_TRUE(e.getField("averyveryverylongfieldnamX").eoo());
+    // A prefix of an existing name must not match.
+    ASSERT_TRUE(e.getField("averyvery").eoo());
+}
+
 TEST(BSONObj, getFieldsWithDuplicates) {
     auto e = BSON("a" << 2 << "b"
                       << "3"
@@ -38,6 +38,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/platform/decimal128.h"
+#include "mongo/util/text.h"
 
 namespace mongo {
 
@@ -69,8 +70,12 @@ Status NOINLINE_DECL makeError(StringData baseMsg, BSONElement idElem, StringDat
 
 class Buffer {
 public:
-    Buffer(const char* buffer, uint64_t maxLength, BSONVersion version)
-        : _buffer(buffer), _position(0), _maxLength(maxLength), _version(version) {}
+    Buffer(const char* buffer, uint64_t maxLength, BSONVersion version, bool checkUTF8)
+        : _buffer(buffer),
+          _position(0),
+          _maxLength(maxLength),
+          _version(version),
+          _checkUTF8(checkUTF8) {}
 
     template <typename N>
     bool readNumber(N* out) {
@@ -97,6 +102,9 @@ public:
         StringData data(_buffer + _position, len);
         _position += len + 1;
 
+        if (_checkUTF8 && !isValidUTF8(data))
+            return makeError("invalid UTF-8 in c-string", _idElem, elemName);
+
         if (out) {
             *out = data;
         }
@@ -122,6 +130,7 @@ public:
             *out = StringData(_buffer + _position, sz);
         }
 
+        const uint64_t start = _position;
         if (!skip(sz - 1))
             return makeError("invalid bson", _idElem, elemName);
 
@@ -132,6 +141,10 @@ public:
         if (c != 0)
             return makeError("not null terminated string", _idElem, elemName);
 
+        // The bytes are known to be in bounds now, so a bulk UTF-8 scan is safe.
+        if (_checkUTF8 && !isValidUTF8(StringData(_buffer + start, sz - 1)))
+            return makeError("invalid UTF-8 string", _idElem, elemName);
+
         return Status::OK();
     }
 
@@ -165,6 +178,7 @@ private:
     uint64_t _maxLength;
     BSONElement _idElem;
     BSONVersion _version;
+    bool _checkUTF8;
 };
 
 struct ValidationState {
@@ -417,11 +431,18 @@ Status validateBSONIterative(Buffer* buffer) {
 }  // namespace
 
 Status validateBSON(const char* originalBuffer, uint64_t maxLength, BSONVersion version) {
+    return validateBSON(originalBuffer, maxLength, version, /*checkUTF8*/ false);
+}
+
+Status validateBSON(const char* originalBuffer,
+                    uint64_t maxLength,
+                    BSONVersion version,
+                    bool checkUTF8) {
     if (maxLength < 5) {
         return Status(ErrorCodes::InvalidBSON, "bson data has to be at least 5 bytes");
     }
 
-    Buffer buf(originalBuffer, maxLength, version);
+    Buffer buf(originalBuffer, maxLength, version, checkUTF8);
     return validateBSONIterative(&buf);
 }
 
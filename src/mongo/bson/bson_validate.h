@@ -46,4 +46,12 @@ class Status;
  */
 Status validateBSON(const char* buf, uint64_t maxLength, BSONVersion version);
 
+/**
+ * As above, but with 'checkUTF8' set additionally verifies that all strings, field names,
+ * DBRef namespaces and regex patterns are well-formed UTF-8. The UTF-8 scan is vectorized
+ * where the platform supports it, so enabling this on ingest paths costs little on the
+ * (overwhelmingly ASCII) common case.
+ */
+Status validateBSON(const char* buf, uint64_t maxLength, BSONVersion version, bool checkUTF8);
+
 }  // namespace mongo
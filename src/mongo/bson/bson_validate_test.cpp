@@ -354,4 +354,28 @@ TEST(BSONValidateBool, BoolValuesAreValidated) {
     }
 }
 
+TEST(BSONValidateUTF8, WellFormedStringsPass) {
+    BSONObj obj = BSON("ascii"
+                       << "plain old ascii that is long enough to hit the vectorized scan path"
+                       << "multibyte"
+                       << "\xc3\xa9\xe2\x82\xac\xf0\x9f\x92\xa9");  // é € and a 4-byte codepoint
+    ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest, true));
+}
+
+TEST(BSONValidateUTF8, MalformedStringRejectedOnlyWhenChecked) {
+    // A lone continuation byte is structurally valid BSON but malformed UTF-8.
+    BSONObj obj = BSON("bad"
+                       << "abc\x80xyz");
+    ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+    ASSERT_NOT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest, true));
+}
+
+TEST(BSONValidateUTF8, MalformedFieldNameRejected) {
+    // Truncated two-byte sequence in a field name.
+    BSONObj obj = BSON("fi\xc3"
+                       << 1);
+    ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+    ASSERT_NOT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest, true));
+}
+
 }  // namespace
@@ -677,6 +677,15 @@ public:
           ,
           totalSize(-1) {}
 
+    struct CachedSizeTag {};  // For disambiguation with the other constructors.
+
+    /** Construct a BSONElement where you already know the lengths of both the name (including
+     *  its null terminator) and the whole element, e.g. from offsets recorded during an
+     *  earlier iteration of the same object. Neither size is recomputed or validated.
+     */
+    BSONElement(const char* d, int fieldNameSize, int totSize, CachedSizeTag)
+        : data(d), fieldNameSize_(fieldNameSize), totalSize(totSize) {}
+
     std::string _asCode() const;
 
     template <typename T>
@@ -40,6 +40,10 @@
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/stringutils.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace mongo {
 using namespace std;
 /* BSONObj ------------------------------------------------------------*/
@@ -466,6 +470,36 @@ void BSONObj::getFields(unsigned n, const char** fieldNames, BSONElement* fields
 }
 
 BSONElement BSONObj::getField(StringData name) const {
+#if defined(__SSE2__)
+    // Fast path for short field names: decide equality (including the NUL terminator) with a
+    // single 16-byte vector compare per element rather than a length check plus memcmp. Field
+    // lookups on wide documents are hot in projection- and matcher-heavy workloads, and almost
+    // all real-world field names fit in 15 bytes.
+    if (name.size() < 16) {
+        alignas(16) char padded[16] = {};
+        name.copyTo(padded, true /* include ending null */);
+        const __m128i target = _mm_load_si128(reinterpret_cast<const __m128i*>(padded));
+        // Bytes participating in the comparison: the name itself plus its NUL terminator.
+        const unsigned significant = (1u << (name.size() + 1)) - 1;
+        const char* end = objdata() + objsize();
+        BSONObjIterator i(*this);
+        while (i.more()) {
+            BSONElement e = i.next();
+            const char* fn = e.fieldName();
+            if (end - fn >= 16) {
+                const __m128i candidate = _mm_loadu_si128(reinterpret_cast<const __m128i*>(fn));
+                const unsigned eq = _mm_movemask_epi8(_mm_cmpeq_epi8(candidate, target));
+                if ((eq & significant) == significant)
+                    return e;
+            } else if (name == e.fieldNameStringData()) {
+                // Too close to the end of the buffer for a vector load; compare the tail
+                // elements the scalar way.
+                return e;
+            }
+        }
+        return BSONElement();
+    }
+#endif
     BSONObjIterator i(*this);
     while (i.more()) {
         BSONElement e = i.next();
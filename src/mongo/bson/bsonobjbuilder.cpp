@@ -34,6 +34,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include "mongo/bson/timestamp.h"
+#include "mongo/bson/util/packed_array.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -256,4 +257,11 @@ const string BSONObjBuilder::numStrs[] = {
 // numStrs is initialized because it is a static variable
 bool BSONObjBuilder::numStrsReady = (numStrs[0].size() > 0);
 
+BSONObjBuilder& BSONObjBuilder::appendPackedArray(StringData fieldName,
+                                                  const int64_t* values,
+                                                  size_t count) {
+    packed_array::append(*this, fieldName, values, count);
+    return *this;
+}
+
 }  // namespace mongo
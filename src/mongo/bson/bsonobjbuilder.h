@@ -576,6 +576,10 @@ public:
         return appendBinData(fieldName, bd.length, bd.type, bd.data);
     }
 
+    /** Append a delta+varint compressed array of int64 values as a BinData element. See
+        bson/util/packed_array.h for the format and PackedArrayIterator for lazy decoding. */
+    BSONObjBuilder& appendPackedArray(StringData fieldName, const int64_t* values, size_t count);
+
     /**
     Subtype 2 is deprecated.
     Append a BSON bindata bytearray element.
@@ -151,13 +151,19 @@ Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
             return ret;
         }
     } else if (peekToken(DOUBLEQUOTE) || peekToken(SINGLEQUOTE)) {
-        std::string valueString;
-        valueString.reserve(STRINGVAL_RESERVE_SIZE);
-        Status ret = quotedString(&valueString);
-        if (ret != Status::OK()) {
-            return ret;
+        StringData valueView;
+        if (quotedStringView(&valueView)) {
+            // Escape-free string: append straight out of the input buffer.
+            builder.append(fieldName, valueView);
+        } else {
+            std::string valueString;
+            valueString.reserve(STRINGVAL_RESERVE_SIZE);
+            Status ret = quotedString(&valueString);
+            if (ret != Status::OK()) {
+                return ret;
+            }
+            builder.append(fieldName, valueString);
         }
-        builder.append(fieldName, valueString);
     } else if (readToken("true")) {
         builder.append(fieldName, true);
     } else if (readToken("false")) {
@@ -201,9 +207,9 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
     }
 
     // Special object
-    std::string firstField;
-    firstField.reserve(FIELD_RESERVE_SIZE);
-    Status ret = field(&firstField);
+    std::string firstFieldStorage;
+    StringData firstField;
+    Status ret = fieldView(&firstField, &firstFieldStorage);
     if (ret != Status::OK()) {
         return ret;
     }
@@ -315,9 +321,9 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
             return valueRet;
         }
         while (readToken(COMMA)) {
-            std::string fieldName;
-            fieldName.reserve(FIELD_RESERVE_SIZE);
-            Status fieldRet = field(&fieldName);
+            std::string fieldNameStorage;
+            StringData fieldName;
+            Status fieldRet = fieldView(&fieldName, &fieldNameStorage);
             if (fieldRet != Status::OK()) {
                 return fieldRet;
             }
@@ -1066,6 +1072,73 @@ Status JParse::field(std::string* result) {
     }
 }
 
+Status JParse::fieldView(StringData* out, std::string* storage) {
+    MONGO_JSON_DEBUG("");
+    if (peekToken(DOUBLEQUOTE) || peekToken(SINGLEQUOTE)) {
+        // Quoted key
+        if (quotedStringView(out)) {
+            return Status::OK();
+        }
+        storage->reserve(FIELD_RESERVE_SIZE);
+        Status ret = quotedString(storage);
+        if (ret == Status::OK()) {
+            *out = *storage;
+        }
+        return ret;
+    }
+    // Unquoted keys can never contain escape sequences, so they are always viewable.
+    while (_input < _input_end && isspace(*reinterpret_cast<const unsigned char*>(_input))) {
+        ++_input;
+    }
+    if (_input >= _input_end) {
+        return parseError("Field name expected");
+    }
+    if (!match(*_input, ALPHA "_$")) {
+        return parseError("First character in field must be [A-Za-z$_]");
+    }
+    const char* q = _input;
+    while (q < _input_end && match(*q, ALPHA DIGIT "_$")) {
+        ++q;
+    }
+    *out = StringData(_input, q - _input);
+    _input = q;
+    return Status::OK();
+}
+
+namespace {
+// Bytes at which the zero-copy string scan must stop: escape introducers and control
+// characters. Quote characters are checked separately since they depend on the delimiter.
+inline bool stringScanStop(unsigned char c) {
+    return c < 0x20 || c == '\\';
+}
+}  // namespace
+
+bool JParse::quotedStringView(StringData* out) {
+    MONGO_JSON_DEBUG("");
+    const char* start = _input;
+    char quote;
+    if (readToken(DOUBLEQUOTE)) {
+        quote = '"';
+    } else if (readToken(SINGLEQUOTE)) {
+        quote = '\'';
+    } else {
+        return false;
+    }
+    const char* q = _input;
+    while (q < _input_end && *q != quote && !stringScanStop(static_cast<unsigned char>(*q))) {
+        ++q;
+    }
+    if (q < _input_end && *q == quote) {
+        *out = StringData(_input, q - _input);
+        _input = q + 1;
+        return true;
+    }
+    // Contains an escape sequence or a control character (or is unterminated); rewind so the
+    // allocating path can reparse and produce the right result or error.
+    _input = start;
+    return false;
+}
+
 Status JParse::quotedString(std::string* result) {
     MONGO_JSON_DEBUG("");
     if (readToken(DOUBLEQUOTE)) {
@@ -366,6 +366,14 @@ private:
      */
     Status field(std::string* result);
 
+    /*
+     * As field(), but returns the name as a view into the input buffer whenever it contains
+     * no escape sequences, avoiding a per-field std::string allocation. Falls back to
+     * materializing into 'storage', in which case 'out' points into it; 'out' is only valid
+     * while the input buffer and 'storage' are both alive and unmodified.
+     */
+    Status fieldView(StringData* out, std::string* storage);
+
     /*
      * std::string :
      *     " "
@@ -375,6 +383,14 @@ private:
      */
     Status quotedString(std::string* result);
 
+    /*
+     * Attempts to consume a quoted string containing no escape sequences or control
+     * characters and return it zero-copy as a view into the input buffer. Returns false
+     * without consuming input when the fast table-driven scan cannot be used; the caller
+     * must then take the quotedString() path.
+     */
+    bool quotedStringView(StringData* out);
+
     /*
      * CHARS :
      *     CHAR
@@ -1384,8 +1384,36 @@ Element Element::findFirstChildNamed(StringData name) const {
     Element::RepIdx current = _repIdx;
     current = impl.resolveLeftChild(current);
     // TODO: Could DRY this loop with the identical logic in findElementNamed.
-    while ((current != kInvalidRepIdx) && (impl.getFieldName(impl.getElementRep(current)) != name))
+    bool tailChecked = false;
+    while (current != kInvalidRepIdx) {
+        {
+            const ElementRep& currentRep = impl.getElementRep(current);
+            if (impl.getFieldName(currentRep) == name)
+                break;
+            if (!tailChecked && (currentRep.sibling.right == kOpaqueRepIdx)) {
+                // The remaining siblings are still serialized. Peek at the raw buffer:
+                // if none of them carries 'name' we can answer the miss immediately,
+                // without realizing a rep for every left-over sibling. Any rep with an
+                // opaque right sibling is positioned in a valid serialized object (see
+                // resolveRightSibling), so the raw walk below mirrors what repeated
+                // resolution would traverse.
+                BSONElement tailElt = impl.getSerializedElement(currentRep);
+                bool found = false;
+                for (BSONElement next(tailElt.rawdata() + tailElt.size()); !next.eoo();
+                     next = BSONElement(next.rawdata() + next.size())) {
+                    if (name == next.fieldNameStringData()) {
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found)
+                    return Element(_doc, kInvalidRepIdx);
+                // A match exists ahead; realize reps only up to it.
+                tailChecked = true;
+            }
+        }
         current = impl.resolveRightSibling(current);
+    }
     return Element(_doc, current);
 }
 
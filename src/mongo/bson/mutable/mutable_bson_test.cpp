@@ -812,6 +812,30 @@ TEST(Serialization, RoundTrip) {
     ASSERT_BSONOBJ_EQ(obj, built);
 }
 
+TEST(Lookup, FindFirstChildNamedOnLazyDocument) {
+    // findFirstChildNamed answers misses on a still-lazy document by peeking at the
+    // serialized buffer; the document must stay fully intact for later finds, mutation,
+    // and serialization.
+    mongo::BSONObj obj = mongo::fromjson(jsonSample);
+    mmb::Document doc(obj.copy(), mmb::Document::kInPlaceEnabled);
+
+    ASSERT_FALSE(doc.root().findFirstChildNamed("no such field").ok());
+
+    mmb::Element lastField = doc.root().findFirstChildNamed("lastfield");
+    ASSERT_TRUE(lastField.ok());
+    ASSERT_EQUALS(mongo::StringData("last"), lastField.getValueString());
+    ASSERT_FALSE(doc.root().findFirstChildNamed("lastfield2").ok());
+
+    mmb::Element score = doc.root().findFirstChildNamed("score");
+    ASSERT_TRUE(score.ok());
+    ASSERT_OK(score.setValueDouble(654.321));
+
+    mongo::BSONObj built = doc.getObject();
+    ASSERT_EQUALS(654.321, built["score"].Double());
+    ASSERT_EQUALS(obj.nFields(), built.nFields());
+    ASSERT_BSONOBJ_EQ(obj.removeField("score"), built.removeField("score"));
+}
+
 TEST(Documentation, Example1) {
     // Create a new document
     mmb::Document doc;
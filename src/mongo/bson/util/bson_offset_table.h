@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+/**
+ * A side-table of element offsets and sizes for one BSONObj, computed with a single
+ * iteration. Subsequent traversals read elements through elementAt(), which hands back
+ * BSONElements with their name and total sizes prepopulated, so none of the variable-length
+ * size computation in BSONElement::size() is repeated.
+ *
+ * This pays off when the same document is walked several times in a row — matched, then
+ * projected, then fed to key generation — which is the shape of the query execution hot
+ * path. The table holds a raw pointer to the object's data and must not outlive it.
+ */
+class BSONElementOffsetTable {
+public:
+    BSONElementOffsetTable() = default;
+
+    explicit BSONElementOffsetTable(const BSONObj& obj) {
+        reset(obj);
+    }
+
+    /**
+     * Rebuilds the table for 'obj', discarding any previous contents.
+     */
+    void reset(const BSONObj& obj);
+
+    /**
+     * Returns true if this table was built for the exact buffer backing 'obj'.
+     */
+    bool isFor(const BSONObj& obj) const {
+        return _objdata == obj.objdata();
+    }
+
+    size_t numElements() const {
+        return _entries.size();
+    }
+
+    /**
+     * Returns the i-th element without rescanning its name or value.
+     */
+    BSONElement elementAt(size_t i) const {
+        const Entry& e = _entries[i];
+        return BSONElement(
+            _objdata + e.offset, e.fieldNameSize, e.totalSize, BSONElement::CachedSizeTag());
+    }
+
+    size_t memUsage() const {
+        return _entries.capacity() * sizeof(Entry);
+    }
+
+private:
+    struct Entry {
+        int offset;
+        int fieldNameSize;  // Includes the null terminator.
+        int totalSize;
+    };
+
+    const char* _objdata = nullptr;
+    std::vector<Entry> _entries;
+};
+
+}  // namespace mongo
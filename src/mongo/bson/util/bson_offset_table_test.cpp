@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/util/bson_offset_table.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+
+TEST(BSONElementOffsetTable, MatchesIteratorForMixedTypes) {
+    BSONObj obj = BSON("a" << 1 << "str"
+                           << "some string"
+                           << "sub"
+                           << BSON("x" << 1.5) << "arr" << BSON_ARRAY(1 << 2 << 3) << "n"
+                           << BSONNULL << "big" << std::string(500, 'q'));
+
+    BSONElementOffsetTable table(obj);
+    ASSERT_EQUALS(table.numElements(), static_cast<size_t>(obj.nFields()));
+
+    BSONObjIterator it(obj);
+    for (size_t i = 0; i < table.numElements(); i++) {
+        BSONElement expected = it.next();
+        BSONElement actual = table.elementAt(i);
+        ASSERT_EQUALS(actual.rawdata(), expected.rawdata());
+        ASSERT_EQUALS(actual.size(), expected.size());
+        ASSERT_EQUALS(actual.fieldNameSize(), expected.fieldNameSize());
+        ASSERT_EQUALS(actual.fieldNameStringData(), expected.fieldNameStringData());
+    }
+    ASSERT_FALSE(it.more());
+}
+
+TEST(BSONElementOffsetTable, EmptyObject) {
+    BSONObj obj;
+    BSONElementOffsetTable table(obj);
+    ASSERT_EQUALS(table.numElements(), 0u);
+    ASSERT_TRUE(table.isFor(obj));
+}
+
+TEST(BSONElementOffsetTable, ResetRetargetsTable) {
+    BSONObj first = BSON("a" << 1);
+    BSONObj second = BSON("b" << 2 << "c" << 3);
+
+    BSONElementOffsetTable table(first);
+    ASSERT_TRUE(table.isFor(first));
+    ASSERT_FALSE(table.isFor(second));
+
+    table.reset(second);
+    ASSERT_TRUE(table.isFor(second));
+    ASSERT_EQUALS(table.numElements(), 2u);
+    ASSERT_EQUALS(table.elementAt(1).fieldNameStringData(), "c");
+}
+
+}  // namespace
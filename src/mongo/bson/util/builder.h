@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cfloat>
 #include <cinttypes>
 #include <cstdint>
@@ -36,6 +37,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <string>
+#include <vector>
 
 
 #include "mongo/base/data_type_endian.h"
@@ -49,6 +51,7 @@
 #include "mongo/stdx/type_traits.h"
 #include "mongo/util/allocator.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/bump_arena.h"
 #include "mongo/util/itoa.h"
 #include "mongo/util/shared_buffer.h"
 
@@ -152,6 +155,51 @@ private:
     void* _ptr = _buf;
 };
 
+/**
+ * Draws buffer space from a BumpArena. Growth allocates a fresh block from the arena and
+ * copies; the abandoned block is reclaimed when the arena is reset. Freeing is a no-op, so
+ * builders over this allocator are extremely cheap to create and destroy but keep their
+ * memory live until the arena is reset.
+ */
+class ArenaAllocator {
+    MONGO_DISALLOW_COPYING(ArenaAllocator);
+
+public:
+    explicit ArenaAllocator(BumpArena& arena) : _arena(&arena) {}
+
+    ArenaAllocator(ArenaAllocator&&) = default;
+    ArenaAllocator& operator=(ArenaAllocator&&) = default;
+
+    void malloc(size_t sz) {
+        _ptr = _arena->allocate(sz);
+        _size = sz;
+    }
+    void realloc(size_t sz) {
+        char* newPtr = _arena->allocate(sz);
+        if (_ptr && sz > 0)
+            memcpy(newPtr, _ptr, std::min(_size, sz));
+        _ptr = newPtr;
+        _size = sz;
+    }
+    void free() {
+        // The arena reclaims this space on reset.
+        _ptr = nullptr;
+        _size = 0;
+    }
+
+    // Not supported on this allocator: the buffer's lifetime is tied to the arena.
+    void release() = delete;
+
+    char* get() const {
+        return _ptr;
+    }
+
+private:
+    BumpArena* _arena;
+    char* _ptr = nullptr;
+    size_t _size = 0;
+};
+
 template <class BufferAllocator>
 class _BufBuilder {
 public:
@@ -163,6 +211,16 @@ public:
         reservedBytes = 0;
     }
 
+    /** Construct over a specific allocator instance; used by allocator-parameterized builders
+        such as ArenaBufBuilder. */
+    _BufBuilder(BufferAllocator allocator, int initsize) : _buf(std::move(allocator)), size(initsize) {
+        if (size > 0) {
+            _buf.malloc(size);
+        }
+        l = 0;
+        reservedBytes = 0;
+    }
+
     void kill() {
         _buf.free();
     }
@@ -189,6 +247,15 @@ public:
         return grow(n);
     }
 
+    /** Pre-size the buffer so that at least 'numBytes' more bytes can be appended without
+        reallocating. Callers that can precompute their exact serialized size use this to
+        avoid repeated grow-and-copy cycles. Does not change the builder's length. */
+    void sizeHint(int numBytes) {
+        const int minSize = l + reservedBytes + numBytes;
+        if (minSize > size)
+            grow_reallocate(minSize);
+    }
+
     /* note this may be deallocated (realloced) if you keep writing. */
     char* buf() {
         return _buf.get();
@@ -378,6 +445,92 @@ public:
 };
 MONGO_STATIC_ASSERT(!std::is_move_constructible<StackBufBuilder>::value);
 
+/** Accumulates output as a chain of segments rather than a single contiguous buffer. Small
+    appends are coalesced into owned segments; large already-serialized regions are chained
+    by reference with no copy, so growth never moves previously appended bytes. The result
+    is materialized exactly once: writeTo() scatters into a caller-provided region (e.g. a
+    DocWriter destination) and done() performs a single gather copy. */
+class SegmentedBufBuilder {
+    MONGO_DISALLOW_COPYING(SegmentedBufBuilder);
+
+public:
+    explicit SegmentedBufBuilder(int segmentSize = 512)
+        : _segmentSize(segmentSize), _tail(segmentSize) {}
+
+    /** Copies 'len' bytes into the owned tail segment. */
+    void appendBuf(const void* src, int len) {
+        _tail.appendBuf(src, len);
+    }
+
+    /** Chains 'len' bytes of 'buf' into the output without copying. */
+    void appendSharedBuffer(SharedBuffer buf, int len) {
+        const char* data = buf.get();
+        appendOwnedRegion(std::move(buf), data, len);
+    }
+
+    /** Chains 'len' bytes starting at 'data' into the output without copying. 'owner' keeps
+        the region alive; 'data' need not point at the start of the owned allocation, so a
+        BSONObj sitting inside a larger shared buffer can be adopted in place. */
+    void appendOwnedRegion(ConstSharedBuffer owner, const char* data, int len) {
+        _flushTail();
+        _totalLen += len;
+        _segments.push_back({std::move(owner), data, len});
+    }
+
+    int len() const {
+        return _totalLen + _tail.len();
+    }
+
+    /** Writes all segments contiguously to 'dst', which must have room for len() bytes. */
+    void writeTo(char* dst) const {
+        for (size_t i = 0; i < _segments.size(); i++) {
+            memcpy(dst, _segments[i].data, _segments[i].len);
+            dst += _segments[i].len;
+        }
+        memcpy(dst, _tail.buf(), _tail.len());
+    }
+
+    /** Gathers all segments into a single freshly allocated buffer. */
+    SharedBuffer done() const {
+        SharedBuffer out = SharedBuffer::allocate(len());
+        writeTo(out.get());
+        return out;
+    }
+
+private:
+    struct Segment {
+        ConstSharedBuffer owner;
+        const char* data;
+        int len;
+    };
+
+    void _flushTail() {
+        const int tailLen = _tail.len();
+        if (tailLen == 0)
+            return;
+        _totalLen += tailLen;
+        SharedBuffer buf = _tail.release();
+        const char* data = buf.get();
+        _segments.push_back({std::move(buf), data, tailLen});
+        _tail = BufBuilder(_segmentSize);
+    }
+
+    std::vector<Segment> _segments;
+    int _segmentSize;
+    int _totalLen = 0;
+    BufBuilder _tail;
+};
+
+/** An ArenaBufBuilder draws all of its storage from a BumpArena, so per-builder heap
+    round-trips disappear for request-scoped construction. The built buffer remains valid
+    until the arena is reset, which must not happen while the buffer is still in use. */
+class ArenaBufBuilder : public _BufBuilder<ArenaAllocator> {
+public:
+    explicit ArenaBufBuilder(BumpArena& arena, int initsize = 512)
+        : _BufBuilder<ArenaAllocator>(ArenaAllocator(arena), initsize) {}
+    void release() = delete;  // not allowed. not implemented.
+};
+
 /** std::stringstream deals with locale so this is a lot faster than std::stringstream for UTF8 */
 template <typename Allocator>
 class StringBuilderImpl {
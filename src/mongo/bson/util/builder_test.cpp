@@ -123,4 +123,35 @@ TEST(Builder, AppendUnsignedLongLong) {
 TEST(Builder, AppendShort) {
     testStringBuilderIntegral<short>();
 }
+
+TEST(Builder, SizeHintAvoidsReallocation) {
+    BufBuilder b(8);
+    b.sizeHint(4096);
+    const char* bufBefore = b.buf();
+    for (int i = 0; i < 1024; i++) {
+        b.appendNum(i);
+    }
+    // All appends fit in the hinted capacity, so the buffer must not have moved.
+    ASSERT_EQUALS(bufBefore, b.buf());
+    ASSERT_EQUALS(b.len(), 4096);
+}
+
+TEST(Builder, SegmentedBufBuilderGathersSegmentsInOrder) {
+    SegmentedBufBuilder b(16);
+    b.appendBuf("head-", 5);
+
+    SharedBuffer big = SharedBuffer::allocate(1000);
+    memset(big.get(), 'x', 1000);
+    b.appendSharedBuffer(std::move(big), 1000);
+
+    b.appendBuf("-tail", 5);
+    ASSERT_EQUALS(b.len(), 1010);
+
+    SharedBuffer out = b.done();
+    ASSERT_EQUALS(memcmp(out.get(), "head-", 5), 0);
+    for (int i = 5; i < 1005; i++) {
+        ASSERT_EQUALS(out.get()[i], 'x');
+    }
+    ASSERT_EQUALS(memcmp(out.get() + 1005, "-tail", 5), 0);
+}
 }
@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/util/packed_array.h"
+
+#include "mongo/bson/util/builder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+const char kMagic = 'P';
+const char kVersion = 1;
+const size_t kHeaderSize = 3;
+
+// Varint and zigzag helpers; same encoding as db/ftdc/varint.h, duplicated here because the
+// bson layer cannot depend on db/.
+void appendVarint(BufBuilder& buf, uint64_t value) {
+    while (value >= 0x80) {
+        buf.appendUChar(static_cast<unsigned char>(value) | 0x80);
+        value >>= 7;
+    }
+    buf.appendUChar(static_cast<unsigned char>(value));
+}
+
+uint64_t zigzagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigzagDecode(uint64_t value) {
+    return static_cast<int64_t>((value >> 1) ^ (0 - (value & 1)));
+}
+
+uint64_t readVarint(const char** pos, const char* end) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (*pos < end && shift <= 63) {
+        const unsigned char byte = static_cast<unsigned char>(*(*pos)++);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return value;
+        shift += 7;
+    }
+    uasserted(50901, "malformed varint in packed array");
+}
+
+}  // namespace
+
+namespace packed_array {
+
+void append(BSONObjBuilder& builder, StringData fieldName, const int64_t* values, size_t count) {
+    BufBuilder payload(kHeaderSize + count * 2);
+    payload.appendChar(kMagic);
+    payload.appendChar(kVersion);
+    payload.appendChar(static_cast<char>(NumberLong));
+    appendVarint(payload, count);
+    int64_t previous = 0;
+    for (size_t i = 0; i < count; i++) {
+        appendVarint(payload, zigzagEncode(values[i] - previous));
+        previous = values[i];
+    }
+    builder.appendBinData(fieldName, payload.len(), bdtCustom, payload.buf());
+}
+
+bool isPackedArray(const BSONElement& elem) {
+    if (elem.type() != BinData || elem.binDataType() != bdtCustom)
+        return false;
+    int len = 0;
+    const char* data = elem.binData(len);
+    return static_cast<size_t>(len) >= kHeaderSize && data[0] == kMagic && data[1] == kVersion;
+}
+
+}  // namespace packed_array
+
+PackedArrayIterator::PackedArrayIterator(const BSONElement& elem) {
+    uassert(50902, "element is not a packed array", packed_array::isPackedArray(elem));
+    int len = 0;
+    const char* data = elem.binData(len);
+    uassert(50903,
+            "unsupported packed array element type",
+            data[2] == static_cast<char>(NumberLong));
+    _pos = data + kHeaderSize;
+    _end = data + len;
+    _count = readVarint(&_pos, _end);
+    _remaining = _count;
+}
+
+int64_t PackedArrayIterator::next() {
+    invariant(_remaining > 0);
+    _remaining--;
+    _previous += zigzagDecode(readVarint(&_pos, _end));
+    return _previous;
+}
+
+}  // namespace mongo
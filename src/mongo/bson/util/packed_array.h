@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+/**
+ * A packed array stores a sequence of int64 values as a BinData element (subtype bdtCustom)
+ * using delta + zigzag + varint encoding, the same scheme FTDC uses for metric chunks. For
+ * metrics-style documents whose arrays are large and slowly varying, this is typically 5-10x
+ * denser than a BSON array, which spends an element header and field name on every value.
+ *
+ * Layout of the BinData payload:
+ *   byte 0:  'P' (magic)
+ *   byte 1:  format version (currently 1)
+ *   byte 2:  element type (currently always NumberLong)
+ *   then:    varint element count, followed by one zigzag-encoded varint delta per element.
+ *
+ * Consumers iterate lazily with PackedArrayIterator; no per-element BSON is ever
+ * materialized.
+ */
+namespace packed_array {
+
+/**
+ * Appends 'values' to 'builder' under 'fieldName' as a packed array.
+ */
+void append(BSONObjBuilder& builder,
+            StringData fieldName,
+            const int64_t* values,
+            size_t count);
+
+inline void append(BSONObjBuilder& builder,
+                   StringData fieldName,
+                   const std::vector<int64_t>& values) {
+    append(builder, fieldName, values.empty() ? nullptr : values.data(), values.size());
+}
+
+/**
+ * Returns true if 'elem' is a BinData element holding a packed array.
+ */
+bool isPackedArray(const BSONElement& elem);
+
+}  // namespace packed_array
+
+/**
+ * Streaming decoder over a packed array element. Values are decoded on demand; the source
+ * BSON must outlive the iterator.
+ *
+ * Usage:
+ *     PackedArrayIterator it(elem);
+ *     while (it.more())
+ *         use(it.next());
+ */
+class PackedArrayIterator {
+public:
+    /**
+     * Throws a UserException if 'elem' is not a packed array.
+     */
+    explicit PackedArrayIterator(const BSONElement& elem);
+
+    bool more() const {
+        return _remaining > 0;
+    }
+
+    /**
+     * Returns the next value. Illegal to call when more() is false. Throws a UserException
+     * on a truncated or malformed payload.
+     */
+    int64_t next();
+
+    /**
+     * Number of elements in the array.
+     */
+    size_t size() const {
+        return _count;
+    }
+
+private:
+    const char* _pos;
+    const char* _end;
+    size_t _count;
+    size_t _remaining;
+    int64_t _previous = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+#include <vector>
+
+#include "mongo/bson/util/packed_array.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+
+std::vector<int64_t> roundTrip(const std::vector<int64_t>& values) {
+    BSONObjBuilder bob;
+    bob.appendPackedArray("a", values.empty() ? nullptr : values.data(), values.size());
+    BSONObj obj = bob.obj();
+    ASSERT_TRUE(packed_array::isPackedArray(obj["a"]));
+    PackedArrayIterator it(obj["a"]);
+    ASSERT_EQUALS(it.size(), values.size());
+    std::vector<int64_t> out;
+    while (it.more()) {
+        out.push_back(it.next());
+    }
+    return out;
+}
+
+TEST(PackedArray, RoundTripEmpty) {
+    ASSERT_TRUE(roundTrip({}).empty());
+}
+
+TEST(PackedArray, RoundTripMetricsStyle) {
+    // Slowly varying counters: the case the encoding is designed for.
+    std::vector<int64_t> values;
+    int64_t v = 1000000;
+    for (int i = 0; i < 1000; i++) {
+        v += i % 7;
+        values.push_back(v);
+    }
+    ASSERT_TRUE(roundTrip(values) == values);
+
+    // The packed form should be far denser than one BSON element per value.
+    BSONObjBuilder bob;
+    bob.appendPackedArray("a", values.data(), values.size());
+    ASSERT_LESS_THAN(bob.obj().objsize(), 3000);
+}
+
+TEST(PackedArray, RoundTripExtremes) {
+    std::vector<int64_t> values = {0,
+                                   -1,
+                                   1,
+                                   std::numeric_limits<int64_t>::max(),
+                                   std::numeric_limits<int64_t>::min(),
+                                   42};
+    ASSERT_TRUE(roundTrip(values) == values);
+}
+
+TEST(PackedArray, OrdinaryBinDataIsNotPacked) {
+    BSONObjBuilder bob;
+    const char bytes[] = {0, 1, 2, 3};
+    bob.appendBinData("b", sizeof(bytes), BinDataGeneral, bytes);
+    ASSERT_FALSE(packed_array::isPackedArray(bob.obj()["b"]));
+}
+
+}  // namespace
@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/util/segmented_object_builder.h"
+
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/itoa.h"
+
+namespace mongo {
+
+namespace {
+const char kZeroLength[4] = {0, 0, 0, 0};
+}  // namespace
+
+SegmentedBSONObjBuilder::SegmentedBSONObjBuilder() {
+    // Length placeholder for the outer object; patched in obj().
+    _buf.appendBuf(kZeroLength, 4);
+}
+
+void SegmentedBSONObjBuilder::_appendElementHeader(char type, StringData fieldName) {
+    _buf.appendBuf(&type, 1);
+    _buf.appendBuf(fieldName.rawData(), fieldName.size());
+    const char nul = 0;
+    _buf.appendBuf(&nul, 1);
+}
+
+void SegmentedBSONObjBuilder::append(StringData fieldName, const BSONObj& obj) {
+    invariant(!_done);
+    _appendElementHeader(Object, fieldName);
+    if (obj.isOwned()) {
+        _buf.appendOwnedRegion(obj.sharedBuffer(), obj.objdata(), obj.objsize());
+    } else {
+        _buf.appendBuf(obj.objdata(), obj.objsize());
+    }
+}
+
+void SegmentedBSONObjBuilder::appendArrayOfObjects(StringData fieldName,
+                                                   const std::vector<BSONObj>& docs) {
+    invariant(!_done);
+    _appendElementHeader(Array, fieldName);
+    const int lenOffset = _buf.len();
+    _buf.appendBuf(kZeroLength, 4);
+    for (size_t i = 0; i < docs.size(); i++) {
+        ItoA index(i);
+        _appendElementHeader(Object, StringData(index));
+        if (docs[i].isOwned()) {
+            _buf.appendOwnedRegion(docs[i].sharedBuffer(), docs[i].objdata(), docs[i].objsize());
+        } else {
+            _buf.appendBuf(docs[i].objdata(), docs[i].objsize());
+        }
+    }
+    const char eoo = EOO;
+    _buf.appendBuf(&eoo, 1);
+    _fixups.push_back({lenOffset, _buf.len() - lenOffset});
+}
+
+void SegmentedBSONObjBuilder::appendElements(const BSONObj& obj) {
+    invariant(!_done);
+    // Everything between the length prefix and the trailing EOO.
+    _buf.appendBuf(obj.objdata() + 4, obj.objsize() - 5);
+}
+
+BSONObj SegmentedBSONObjBuilder::obj() {
+    invariant(!_done);
+    _done = true;
+    const char eoo = EOO;
+    _buf.appendBuf(&eoo, 1);
+    _fixups.push_back({0, _buf.len()});
+
+    SharedBuffer out = SharedBuffer::allocate(_buf.len());
+    _buf.writeTo(out.get());
+    for (size_t i = 0; i < _fixups.size(); i++) {
+        DataView(out.get()).write<LittleEndian<int>>(_fixups[i].value, _fixups[i].offset);
+    }
+    return BSONObj(std::move(out));
+}
+
+}  // namespace mongo
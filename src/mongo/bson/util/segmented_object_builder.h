@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/util/builder.h"
+
+namespace mongo {
+
+/**
+ * Builds a BSON object out of gather-write segments, adopting owned subdocuments by
+ * reference instead of copying their bytes. This is aimed at response assembly, where a
+ * reply wraps a batch of multi-megabyte documents that already live in SharedBuffer-backed
+ * BSONObjs: adopting them defers the copy to a single gather when the object is finished,
+ * instead of copying each document into a growing builder and then again into the message.
+ *
+ * Unowned documents are copied, since nothing pins their bytes.
+ *
+ * The builder is single-use: obj() finishes the object and performs the one gather copy.
+ */
+class SegmentedBSONObjBuilder {
+    MONGO_DISALLOW_COPYING(SegmentedBSONObjBuilder);
+
+public:
+    SegmentedBSONObjBuilder();
+
+    /**
+     * Appends an object-valued field. Owned objects are adopted by reference.
+     */
+    void append(StringData fieldName, const BSONObj& obj);
+
+    /**
+     * Appends an array-valued field whose elements are 'docs', each adopted by reference
+     * when owned. This is the batch shape of find/getMore replies.
+     */
+    void appendArrayOfObjects(StringData fieldName, const std::vector<BSONObj>& docs);
+
+    /**
+     * Copies the fields of 'obj' (without its outer header and EOO) into this object; used
+     * for the small scalar portions of a reply.
+     */
+    void appendElements(const BSONObj& obj);
+
+    /**
+     * Finishes the object and gathers all segments into a single owned BSONObj.
+     */
+    BSONObj obj();
+
+private:
+    void _appendElementHeader(char type, StringData fieldName);
+
+    struct Fixup {
+        int offset;
+        int value;
+    };
+
+    SegmentedBufBuilder _buf;
+    std::vector<Fixup> _fixups;
+    bool _done = false;
+};
+
+}  // namespace mongo
@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/util/segmented_object_builder.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+
+TEST(SegmentedBSONObjBuilder, MatchesRegularBuilderOutput) {
+    BSONObj docA = BSON("a" << 1 << "payload"
+                            << std::string(1000, 'x'));
+    BSONObj docB = BSON("b" << 2);
+    std::vector<BSONObj> batch = {docA, docB};
+
+    SegmentedBSONObjBuilder seg;
+    seg.appendElements(BSON("header" << 42));
+    seg.appendArrayOfObjects("firstBatch", batch);
+    seg.append("trailer", docB);
+    BSONObj actual = seg.obj();
+
+    BSONObjBuilder ref;
+    ref.append("header", 42);
+    {
+        BSONArrayBuilder arr(ref.subarrayStart("firstBatch"));
+        arr.append(docA);
+        arr.append(docB);
+    }
+    ref.append("trailer", docB);
+
+    ASSERT_BSONOBJ_EQ(actual, ref.obj());
+    ASSERT_OK(validateBSON(actual.objdata(), actual.objsize(), BSONVersion::kLatest));
+}
+
+TEST(SegmentedBSONObjBuilder, AdoptsUnownedObjectsByCopy) {
+    BSONObj owned = BSON("x" << 1);
+    BSONObj unowned(owned.objdata());  // view, not owned
+    ASSERT_FALSE(unowned.isOwned());
+
+    SegmentedBSONObjBuilder seg;
+    seg.append("doc", unowned);
+    BSONObj out = seg.obj();
+    ASSERT_BSONOBJ_EQ(out["doc"].Obj(), owned);
+}
+
+TEST(SegmentedBSONObjBuilder, EmptyBatch) {
+    SegmentedBSONObjBuilder seg;
+    seg.appendArrayOfObjects("firstBatch", {});
+    BSONObj out = seg.obj();
+    ASSERT_EQUALS(out["firstBatch"].Obj().nFields(), 0);
+    ASSERT_OK(validateBSON(out.objdata(), out.objsize(), BSONVersion::kLatest));
+}
+
+}  // namespace
@@ -0,0 +1,384 @@
+/**
+ * Copyright (C) 2017 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/crypto/sha1_block_shani.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "mongo/util/assert_util.h"
+
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define MONGO_SHA1_HAVE_SHANI 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace mongo {
+namespace sha1_shani {
+
+#ifdef MONGO_SHA1_HAVE_SHANI
+
+namespace {
+
+// Streaming SHA-1 state: chaining values, a partial final block, and the running length.
+struct Context {
+    uint32_t state[5];
+    uint8_t buffer[64];
+    size_t bufferLen;
+    uint64_t totalBytes;
+};
+
+// Runs the SHA-1 compression function over numBlocks 64-byte blocks, using the sha1rnds4
+// round and sha1msg1/sha1msg2 schedule instructions. The round sequence follows Intel's
+// published SHA extensions example code.
+__attribute__((target("sha,sse4.1"))) void processBlocks(uint32_t state[5],
+                                                         const uint8_t* data,
+                                                         size_t numBlocks) {
+    const __m128i byteSwapMask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+    abcd = _mm_shuffle_epi32(abcd, 0x1B);
+    __m128i e0 = _mm_set_epi32(state[4], 0, 0, 0);
+    __m128i e1;
+
+    while (numBlocks--) {
+        const __m128i abcdSave = abcd;
+        const __m128i eSave = e0;
+
+        __m128i msg0 = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0)), byteSwapMask);
+        __m128i msg1 = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), byteSwapMask);
+        __m128i msg2 = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), byteSwapMask);
+        __m128i msg3 = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), byteSwapMask);
+
+        // Rounds 0-3
+        e0 = _mm_add_epi32(e0, msg0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+        // Rounds 4-7
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+        // Rounds 8-11
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 12-15
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 16-19
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 20-23
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 24-27
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 28-31
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 32-35
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 36-39
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 40-43
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 44-47
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 48-51
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 52-55
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+        msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 56-59
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+        msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+        msg0 = _mm_xor_si128(msg0, msg2);
+
+        // Rounds 60-63
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+        msg1 = _mm_xor_si128(msg1, msg3);
+
+        // Rounds 64-67
+        e0 = _mm_sha1nexte_epu32(e0, msg0);
+        e1 = abcd;
+        msg1 = _mm_sha1msg2_epu32(msg1, msg0);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+        msg3 = _mm_sha1msg1_epu32(msg3, msg0);
+        msg2 = _mm_xor_si128(msg2, msg0);
+
+        // Rounds 68-71
+        e1 = _mm_sha1nexte_epu32(e1, msg1);
+        e0 = abcd;
+        msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+        msg3 = _mm_xor_si128(msg3, msg1);
+
+        // Rounds 72-75
+        e0 = _mm_sha1nexte_epu32(e0, msg2);
+        e1 = abcd;
+        msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+        // Rounds 76-79
+        e1 = _mm_sha1nexte_epu32(e1, msg3);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+        // Add this block's result to the chaining values.
+        e0 = _mm_sha1nexte_epu32(e0, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+
+        data += 64;
+    }
+
+    abcd = _mm_shuffle_epi32(abcd, 0x1B);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), abcd);
+    state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+void contextInit(Context* ctx) {
+    ctx->state[0] = 0x67452301;
+    ctx->state[1] = 0xEFCDAB89;
+    ctx->state[2] = 0x98BADCFE;
+    ctx->state[3] = 0x10325476;
+    ctx->state[4] = 0xC3D2E1F0;
+    ctx->bufferLen = 0;
+    ctx->totalBytes = 0;
+}
+
+void contextUpdate(Context* ctx, const uint8_t* data, size_t len) {
+    ctx->totalBytes += len;
+    if (ctx->bufferLen) {
+        const size_t take = std::min(len, sizeof(ctx->buffer) - ctx->bufferLen);
+        memcpy(ctx->buffer + ctx->bufferLen, data, take);
+        ctx->bufferLen += take;
+        data += take;
+        len -= take;
+        if (ctx->bufferLen == sizeof(ctx->buffer)) {
+            processBlocks(ctx->state, ctx->buffer, 1);
+            ctx->bufferLen = 0;
+        }
+    }
+    if (len >= 64) {
+        processBlocks(ctx->state, data, len / 64);
+        data += len - len % 64;
+        len %= 64;
+    }
+    if (len) {
+        memcpy(ctx->buffer, data, len);
+        ctx->bufferLen = len;
+    }
+}
+
+void contextFinal(Context* ctx, uint8_t* output) {
+    // Append the 0x80 terminator, zero padding, and the big-endian message bit length.
+    const uint64_t totalBits = ctx->totalBytes * 8;
+    const uint8_t terminator = 0x80;
+    contextUpdate(ctx, &terminator, 1);
+    const uint8_t zero = 0;
+    while (ctx->bufferLen != 56) {
+        contextUpdate(ctx, &zero, 1);
+    }
+    uint8_t lengthBytes[8];
+    for (int i = 0; i < 8; i++) {
+        lengthBytes[i] = static_cast<uint8_t>(totalBits >> (56 - 8 * i));
+    }
+    contextUpdate(ctx, lengthBytes, sizeof(lengthBytes));
+    invariant(ctx->bufferLen == 0);
+
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 4; j++) {
+            output[4 * i + j] = static_cast<uint8_t>(ctx->state[i] >> (24 - 8 * j));
+        }
+    }
+}
+
+}  // namespace
+
+bool isSupported() {
+    static const bool supported = [] {
+        if (__get_cpuid_max(0, nullptr) < 7) {
+            return false;
+        }
+        unsigned int eax, ebx, ecx, edx;
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        return (ebx & (1u << 29)) != 0;
+    }();
+    return supported;
+}
+
+SHA1BlockTraits::HashType computeHash(std::initializer_list<ConstDataRange> input) {
+    SHA1BlockTraits::HashType output;
+    Context ctx;
+    contextInit(&ctx);
+    for (const auto& range : input) {
+        contextUpdate(&ctx, reinterpret_cast<const uint8_t*>(range.data()), range.length());
+    }
+    contextFinal(&ctx, output.data());
+    return output;
+}
+
+void computeHmac(const uint8_t* key,
+                 size_t keyLen,
+                 const uint8_t* input,
+                 size_t inputLen,
+                 SHA1BlockTraits::HashType* const output) {
+    // Standard HMAC (RFC 2104): H((K ^ opad) || H((K ^ ipad) || input)).
+    uint8_t keyBlock[64] = {};
+    if (keyLen > sizeof(keyBlock)) {
+        const auto keyHash =
+            computeHash({ConstDataRange(reinterpret_cast<const char*>(key), keyLen)});
+        memcpy(keyBlock, keyHash.data(), keyHash.size());
+    } else {
+        memcpy(keyBlock, key, keyLen);
+    }
+
+    uint8_t pad[64];
+    Context inner;
+    contextInit(&inner);
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] = keyBlock[i] ^ 0x36;
+    }
+    contextUpdate(&inner, pad, sizeof(pad));
+    contextUpdate(&inner, input, inputLen);
+    uint8_t innerHash[20];
+    contextFinal(&inner, innerHash);
+
+    Context outer;
+    contextInit(&outer);
+    for (size_t i = 0; i < sizeof(pad); i++) {
+        pad[i] = keyBlock[i] ^ 0x5c;
+    }
+    contextUpdate(&outer, pad, sizeof(pad));
+    contextUpdate(&outer, innerHash, sizeof(innerHash));
+    contextFinal(&outer, output->data());
+}
+
+#else  // MONGO_SHA1_HAVE_SHANI
+
+bool isSupported() {
+    return false;
+}
+
+SHA1BlockTraits::HashType computeHash(std::initializer_list<ConstDataRange> input) {
+    MONGO_UNREACHABLE;
+}
+
+void computeHmac(const uint8_t* key,
+                 size_t keyLen,
+                 const uint8_t* input,
+                 size_t inputLen,
+                 SHA1BlockTraits::HashType* const output) {
+    MONGO_UNREACHABLE;
+}
+
+#endif  // MONGO_SHA1_HAVE_SHANI
+
+}  // namespace sha1_shani
+}  // namespace mongo
@@ -0,0 +1,71 @@
+/**
+ * Copyright (C) 2017 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include "mongo/base/data_range.h"
+#include "mongo/crypto/sha1_block.h"
+
+namespace mongo {
+
+/**
+ * SHA-1 implemented with the x86 SHA extensions (SHA-NI).
+ *
+ * Used by the tomcrypt hash backend when the CPU supports the extensions; OpenSSL builds
+ * get equivalent dispatch inside libcrypto and do not need this.
+ */
+namespace sha1_shani {
+
+/**
+ * Returns true when the running CPU supports the SHA extensions. The result never
+ * changes, so callers may cache it.
+ */
+bool isSupported();
+
+/**
+ * Computes the SHA-1 hash of the concatenation of the input ranges. May only be called
+ * when isSupported() returns true.
+ */
+SHA1BlockTraits::HashType computeHash(std::initializer_list<ConstDataRange> input);
+
+/**
+ * Computes the HMAC-SHA-1 keyed hash of 'input' using the key 'key'. May only be called
+ * when isSupported() returns true.
+ */
+void computeHmac(const uint8_t* key,
+                 size_t keyLen,
+                 const uint8_t* input,
+                 size_t inputLen,
+                 SHA1BlockTraits::HashType* const output);
+
+}  // namespace sha1_shani
+}  // namespace mongo
@@ -29,6 +29,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/crypto/sha1_block.h"
+#include "mongo/crypto/sha1_block_shani.h"
 #include "mongo/crypto/sha256_block.h"
 
 #include "mongo/config.h"
@@ -99,6 +100,9 @@ void computeHmacImpl(const ltc_hash_descriptor* desc,
 
 SHA1BlockTraits::HashType SHA1BlockTraits::computeHash(
     std::initializer_list<ConstDataRange> input) {
+    if (sha1_shani::isSupported()) {
+        return sha1_shani::computeHash(input);
+    }
     return computeHashImpl<SHA1BlockTraits::HashType, sha1_init, sha1_process, sha1_done>(input);
 }
 
@@ -113,6 +117,9 @@ void SHA1BlockTraits::computeHmac(const uint8_t* key,
                                   const uint8_t* input,
                                   size_t inputLen,
                                   HashType* const output) {
+    if (sha1_shani::isSupported()) {
+        return sha1_shani::computeHmac(key, keyLen, input, inputLen, output);
+    }
     return computeHmacImpl<HashType>(&sha1_desc, key, keyLen, input, inputLen, output);
 }
 
@@ -50,6 +50,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
@@ -60,9 +61,18 @@ namespace mongo {
 namespace dps = ::mongo::dotted_path_support;
 using std::vector;
 
+// Enables the per-session privilege decision cache consulted by authorization checks. The
+// cache turns repeated checks against the same resource into a single hash lookup; it is
+// invalidated whenever the session's set of User objects changes.
+MONGO_EXPORT_SERVER_PARAMETER(authorizationSessionPrivilegeCacheEnabled, bool, false);
+
 namespace {
 const std::string ADMIN_DBNAME = "admin";
 
+// Upper bound on the per-session privilege decision cache; a session that somehow touches
+// more distinct resources than this simply starts over.
+const size_t kPrivilegeCacheMaxSize = 512;
+
 // Checks if this connection has the privileges necessary to create or modify the view 'viewNs'
 // to be a view on 'viewOnNs' with pipeline 'viewPipeline'. Call this function after verifying
 // that the user has the 'createCollection' or 'collMod' action, respectively.
@@ -164,6 +174,7 @@ Status AuthorizationSession::addAndAuthorizeUser(OperationContext* opCtx,
     // Calling add() on the UserSet may return a user that was replaced because it was from the
     // same database.
     userHolder.reset(_authenticatedUsers.add(userHolder.release()));
+    _clearPrivilegeCache();
 
     // If there are any users and roles in the impersonation data, clear it out.
     clearImpersonatedUserData();
@@ -197,6 +208,7 @@ void AuthorizationSession::logoutDatabase(const std::string& dbname) {
     if (removedUser) {
         getAuthorizationManager().releaseUser(removedUser);
     }
+    _clearPrivilegeCache();
     clearImpersonatedUserData();
     _buildAuthenticatedRolesVector();
 }
@@ -222,6 +234,7 @@ std::string AuthorizationSession::getAuthenticatedUserNamesToken() {
 
 void AuthorizationSession::grantInternalAuthorization() {
     _authenticatedUsers.add(internalSecurity.user);
+    _clearPrivilegeCache();
     _buildAuthenticatedRolesVector();
 }
 
@@ -792,6 +805,11 @@ void AuthorizationSession::_refreshUserInfoAsNeeded(OperationContext* opCtx) {
         User* user = *it;
 
         if (!user->isValid()) {
+            // The AuthorizationManager's cache generation has moved past this user object, so
+            // any privilege decisions cached from it are stale no matter how the refresh below
+            // turns out.
+            _clearPrivilegeCache();
+
             // Make a good faith effort to acquire an up-to-date user object, since the one
             // we've cached is marked "out-of-date."
             UserName name = user->getName();
@@ -877,12 +895,46 @@ void AuthorizationSession::_buildAuthenticatedRolesVector() {
     }
 }
 
+void AuthorizationSession::_clearPrivilegeCache() {
+    _privilegeCache.clear();
+}
+
 bool AuthorizationSession::_isAuthorizedForPrivilege(const Privilege& privilege) {
     const ResourcePattern& target(privilege.getResourcePattern());
 
+    // The cache is only usable when the decision depends solely on the authenticated users'
+    // privileges: with the localhost exception active, getDefaultPrivileges() contributes
+    // bootstrap privileges that can lapse without the user set changing.
+    const bool useCache = authorizationSessionPrivilegeCacheEnabled.load() &&
+        _authenticatedUsers.begin() != _authenticatedUsers.end() &&
+        !_externalState->shouldAllowLocalhost();
+    if (useCache) {
+        auto it = _privilegeCache.find(target);
+        if (it != _privilegeCache.end()) {
+            return it->second.isSupersetOf(privilege.getActions());
+        }
+    }
+
     ResourcePattern resourceSearchList[resourceSearchListCapacity];
     const int resourceSearchListLength = buildResourceSearchList(target, resourceSearchList);
 
+    if (useCache) {
+        // Compute and cache the full union of actions the users hold on this resource; the
+        // check for this and any future action set is then a superset test against it.
+        ActionSet granted;
+        for (UserSet::iterator it = _authenticatedUsers.begin(); it != _authenticatedUsers.end();
+             ++it) {
+            for (int i = 0; i < resourceSearchListLength; ++i) {
+                granted.addAllActionsFromSet((*it)->getActionsForResource(resourceSearchList[i]));
+            }
+        }
+        if (_privilegeCache.size() >= kPrivilegeCacheMaxSize) {
+            _clearPrivilegeCache();
+        }
+        _privilegeCache[target] = granted;
+        return granted.isSupersetOf(privilege.getActions());
+    }
+
     ActionSet unmetRequirements = privilege.getActions();
 
     PrivilegeVector defaultPrivileges = getDefaultPrivileges();
@@ -42,6 +42,8 @@
 #include "mongo/db/auth/user_name.h"
 #include "mongo/db/auth/user_set.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -51,6 +53,9 @@ struct CreateOrUpdateRoleArgs;
 }
 class Client;
 
+// Enables the per-session privilege decision cache; see AuthorizationSession::_privilegeCache.
+extern AtomicBool authorizationSessionPrivilegeCacheEnabled;
+
 /**
  * Contains all the authorization logic for a single client connection.  It contains a set of
  * the users which have been authenticated, as well as a set of privileges that have been
@@ -316,6 +321,19 @@ private:
     // lock on the admin database (to update out-of-date user privilege information).
     bool _isAuthorizedForPrivilege(const Privilege& privilege);
 
+    // Cached union of the actions the authenticated users are granted on a resource pattern,
+    // so sessions running many identical commands resolve authorization with one hash lookup
+    // instead of re-walking every user's privilege map. Entries are valid only for the
+    // current set of User objects; any mutation of _authenticatedUsers must go through
+    // _clearPrivilegeCache(). See _isAuthorizedForPrivilege for the conditions under which
+    // the cache is consulted.
+    stdx::unordered_map<ResourcePattern, ActionSet> _privilegeCache;
+
+    // Discards all cached privilege decisions. Called whenever the set of authenticated User
+    // objects changes: login, logout, and refreshes driven by the AuthorizationManager's
+    // cache generation.
+    void _clearPrivilegeCache();
+
     std::unique_ptr<AuthzSessionExternalState> _externalState;
 
     // A vector of impersonated UserNames and a vector of those users' RoleNames.
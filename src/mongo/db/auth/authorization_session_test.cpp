@@ -48,6 +48,7 @@
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_mock.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/map_util.h"
 
 #define ASSERT_NULL(EXPR) ASSERT_FALSE(EXPR)
@@ -501,6 +502,72 @@ TEST_F(AuthorizationSessionTest, InvalidateUser) {
     ASSERT_FALSE(authzSession->lookupUser(UserName("spencer", "test")));
 }
 
+TEST_F(AuthorizationSessionTest, PrivilegeCacheInvalidatedWithUser) {
+    authorizationSessionPrivilegeCacheEnabled.store(true);
+    const auto restoreGuard =
+        MakeGuard([] { authorizationSessionPrivilegeCacheEnabled.store(false); });
+
+    // Add a readWrite user
+    ASSERT_OK(managerState->insertPrivilegeDocument(_opCtx.get(),
+                                                    BSON("user"
+                                                         << "spencer"
+                                                         << "db"
+                                                         << "test"
+                                                         << "credentials"
+                                                         << BSON("MONGODB-CR"
+                                                                 << "a")
+                                                         << "roles"
+                                                         << BSON_ARRAY(BSON("role"
+                                                                            << "readWrite"
+                                                                            << "db"
+                                                                            << "test"))),
+                                                    BSONObj()));
+    ASSERT_OK(authzSession->addAndAuthorizeUser(_opCtx.get(), UserName("spencer", "test")));
+
+    // Repeated checks against the same resource exercise the cached decision path.
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(
+            authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::find));
+        ASSERT_TRUE(authzSession->isAuthorizedForActionsOnResource(testFooCollResource,
+                                                                   ActionType::insert));
+    }
+
+    // Change the user to be read-only
+    int ignored;
+    managerState
+        ->remove(_opCtx.get(),
+                 AuthorizationManager::usersCollectionNamespace,
+                 BSONObj(),
+                 BSONObj(),
+                 &ignored)
+        .transitional_ignore();
+    ASSERT_OK(managerState->insertPrivilegeDocument(_opCtx.get(),
+                                                    BSON("user"
+                                                         << "spencer"
+                                                         << "db"
+                                                         << "test"
+                                                         << "credentials"
+                                                         << BSON("MONGODB-CR"
+                                                                 << "a")
+                                                         << "roles"
+                                                         << BSON_ARRAY(BSON("role"
+                                                                            << "read"
+                                                                            << "db"
+                                                                            << "test"))),
+                                                    BSONObj()));
+
+    // Invalidating the user must also invalidate the cached decisions.
+    User* user = authzSession->lookupUser(UserName("spencer", "test"));
+    authzManager->invalidateUserByName(user->getName());
+    authzSession->startRequest(_opCtx.get());  // Refreshes cached data for invalid users
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(
+            authzSession->isAuthorizedForActionsOnResource(testFooCollResource, ActionType::find));
+        ASSERT_FALSE(authzSession->isAuthorizedForActionsOnResource(testFooCollResource,
+                                                                    ActionType::insert));
+    }
+}
+
 TEST_F(AuthorizationSessionTest, UseOldUserInfoInFaceOfConnectivityProblems) {
     // Add a readWrite user
     ASSERT_OK(managerState->insertPrivilegeDocument(_opCtx.get(),
@@ -148,15 +148,20 @@ std::string CompactOptions::toString() const {
 CappedInsertNotifier::CappedInsertNotifier() : _version(0), _dead(false) {}
 
 void CappedInsertNotifier::notifyAll() {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
-    ++_version;
+    {
+        // Bumping the epoch under the mutex guarantees any waiter that read the old value is
+        // already blocked on the condition variable and will receive the notify below.
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _version.fetchAndAdd(1);
+    }
+    // Notify outside the mutex so the woken herd does not immediately pile up behind it.
     _notifier.notify_all();
 }
 
 void CappedInsertNotifier::_wait(stdx::unique_lock<stdx::mutex>& lk,
                                  uint64_t prevVersion,
                                  Microseconds timeout) const {
-    while (!_dead && prevVersion == _version) {
+    while (!_dead.load() && prevVersion == _version.load()) {
         if (timeout == Microseconds::max()) {
             _notifier.wait(lk);
         } else if (stdx::cv_status::timeout == _notifier.wait_for(lk, timeout.toSystemDuration())) {
@@ -166,29 +171,35 @@ void CappedInsertNotifier::_wait(stdx::unique_lock<stdx::mutex>& lk,
 }
 
 void CappedInsertNotifier::wait(uint64_t prevVersion, Microseconds timeout) const {
+    // Fast path: if the epoch already moved past the caller's snapshot there is new data to
+    // read; return without ever touching the mutex.
+    if (_dead.load() || prevVersion != _version.load()) {
+        return;
+    }
     stdx::unique_lock<stdx::mutex> lk(_mutex);
     _wait(lk, prevVersion, timeout);
 }
 
 void CappedInsertNotifier::wait(Microseconds timeout) const {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
-    _wait(lk, _version, timeout);
+    _wait(lk, _version.load(), timeout);
 }
 
 void CappedInsertNotifier::wait() const {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
-    _wait(lk, _version, Microseconds::max());
+    _wait(lk, _version.load(), Microseconds::max());
 }
 
 void CappedInsertNotifier::kill() {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
-    _dead = true;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _dead.store(true);
+    }
     _notifier.notify_all();
 }
 
 bool CappedInsertNotifier::isDead() {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
-    return _dead;
+    return _dead.load();
 }
 
 // ----
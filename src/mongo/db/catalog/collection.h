@@ -50,6 +50,7 @@
 #include "mongo/db/storage/capped_callback.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/snapshot.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
@@ -135,7 +136,7 @@ public:
      * Returns the version for use as an additional wake condition when used above.
      */
     uint64_t getVersion() const {
-        return _version;
+        return _version.load();
     }
 
     /**
@@ -162,17 +163,19 @@ private:
     // Signalled when a successful insert is made into a capped collection.
     mutable stdx::condition_variable _notifier;
 
-    // Mutex used with '_notifier'. Protects access to '_version'.
+    // Mutex used with '_notifier'. Only serializes sleeping and waking; the epoch itself is
+    // read without it so waiters with work already available never touch the lock.
     mutable stdx::mutex _mutex;
 
-    // A counter, incremented on insertion of new data into the capped collection.
+    // A counter, incremented once per committed batch of inserts into the capped collection.
     //
     // The condition which '_cappedNewDataNotifier' is being notified of is an increment of this
-    // counter. Access to this counter is synchronized with '_mutex'.
-    uint64_t _version;
+    // counter. It is only incremented while '_mutex' is held so that a waiter that saw a stale
+    // value is guaranteed to be blocked on the condition variable by then.
+    mutable AtomicUInt64 _version;
 
     // True once the notifier is dead.
-    bool _dead;
+    AtomicBool _dead;
 };
 
 /**
@@ -47,6 +47,7 @@
 #include "mongo/db/catalog/index_create.h"
 #include "mongo/db/catalog/namespace_uuid_cache.h"
 #include "mongo/db/catalog/uuid_catalog.h"
+#include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
@@ -70,6 +71,7 @@
 
 #include "mongo/db/auth/user_document_parser.h"  // XXX-ANDY
 #include "mongo/rpc/object_check.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 
@@ -106,6 +108,31 @@ MONGO_INITIALIZER(InitializeParseValidationActionImpl)(InitializerContext* const
 // Used below to fail during inserts.
 MONGO_FP_DECLARE(failCollectionInserts);
 
+/**
+ * Registers one document's contribution to the collection's incremental multiset hash, to be
+ * applied if and when the unit of work commits. No-op while the hash is inactive, i.e. until
+ * an incremental dbHash has seeded it.
+ */
+void recordMultisetHashChange(OperationContext* opCtx,
+                              CollectionMultisetHash* multisetHash,
+                              const BSONObj& doc,
+                              bool isInsert) {
+    if (!multisetHash->isActive())
+        return;
+
+    uint64_t h[2];
+    CollectionMultisetHash::hashDocument(doc, h);
+    const uint64_t h0 = h[0];
+    const uint64_t h1 = h[1];
+    if (isInsert) {
+        opCtx->recoveryUnit()->onCommit(
+            [multisetHash, h0, h1] { multisetHash->applyInsert(h0, h1); });
+    } else {
+        opCtx->recoveryUnit()->onCommit(
+            [multisetHash, h0, h1] { multisetHash->applyDelete(h0, h1); });
+    }
+}
+
 const auto bannedExpressionsInValidators = std::set<StringData>{
     "$geoNear", "$near", "$nearSphere", "$text", "$where",
 };
@@ -445,6 +472,9 @@ Status CollectionImpl::insertDocument(OperationContext* opCtx,
         }
     }
 
+    _infoCache.getZoneMap()->recordInsert(loc.getValue(), doc);
+    recordMultisetHashChange(opCtx, _infoCache.getMultisetHash(), doc, true);
+
     vector<InsertStatement> inserts;
     inserts.emplace_back(doc);
 
@@ -509,6 +539,18 @@ Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
         opDebug->keysInserted += keysInserted;
     }
 
+    if (status.isOK()) {
+        // Feed the zone map so collection scans can skip record ranges whose min/max exclude
+        // their predicate. Recording an insert that later rolls back is harmless: it can only
+        // widen a zone's bounds, which makes skipping more conservative.
+        CollectionZoneMap* zoneMap = _infoCache.getZoneMap();
+        CollectionMultisetHash* multisetHash = _infoCache.getMultisetHash();
+        for (const auto& bsonRecord : bsonRecords) {
+            zoneMap->recordInsert(bsonRecord.id, *bsonRecord.docPtr);
+            recordMultisetHashChange(opCtx, multisetHash, *bsonRecord.docPtr, true);
+        }
+    }
+
     return status;
 }
 
@@ -567,6 +609,8 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
 
     _recordStore->deleteRecord(opCtx, loc);
 
+    recordMultisetHashChange(opCtx, _infoCache.getMultisetHash(), doc.value(), false);
+
     getGlobalServiceContext()->getOpObserver()->onDelete(
         opCtx, ns(), uuid(), stmtId, std::move(deleteState), fromMigrate);
 }
@@ -693,6 +737,13 @@ StatusWith<RecordId> CollectionImpl::updateDocument(OperationContext* opCtx,
     invariant(sid == opCtx->recoveryUnit()->getSnapshotId());
     args->updatedDoc = newDoc;
 
+    // The new version of the document may fall outside its zone's recorded min/max.
+    _infoCache.getZoneMap()->recordUpdate(oldLocation);
+
+    CollectionMultisetHash* multisetHash = _infoCache.getMultisetHash();
+    recordMultisetHashChange(opCtx, multisetHash, oldDoc.value(), false);
+    recordMultisetHashChange(opCtx, multisetHash, newDoc, true);
+
     getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, *args);
 
     return {oldLocation};
@@ -738,6 +789,14 @@ StatusWith<RecordId> CollectionImpl::_updateDocumentWithMove(OperationContext* o
     invariant(sid == opCtx->recoveryUnit()->getSnapshotId());
     args->updatedDoc = newDoc;
 
+    // The new location may have been carved out of space inside an already-sealed zone
+    // (MMAPv1 reuses record ids), so invalidate the zone containing it as well.
+    _infoCache.getZoneMap()->recordUpdate(newLocation.getValue());
+
+    CollectionMultisetHash* multisetHash = _infoCache.getMultisetHash();
+    recordMultisetHashChange(opCtx, multisetHash, oldDoc.value(), false);
+    recordMultisetHashChange(opCtx, multisetHash, newDoc, true);
+
     getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, *args);
 
     moveCounter.increment();
@@ -779,12 +838,32 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
     // Broadcast the mutation so that query results stay correct.
     _cursorManager.invalidateDocument(opCtx, loc, INVALIDATION_MUTATION);
 
+    // Hash the old version before the damages are applied; they may mutate these bytes in
+    // place.
+    CollectionMultisetHash* multisetHash = _infoCache.getMultisetHash();
+    const bool hashActive = multisetHash->isActive();
+    uint64_t oldDocHash[2] = {0, 0};
+    if (hashActive) {
+        CollectionMultisetHash::hashDocument(oldRec.value().toBson(), oldDocHash);
+    }
+
     auto newRecStatus =
         _recordStore->updateWithDamages(opCtx, loc, oldRec.value(), damageSource, damages);
 
     if (newRecStatus.isOK()) {
         args->updatedDoc = newRecStatus.getValue().toBson();
 
+        // The new version of the document may fall outside its zone's recorded min/max.
+        _infoCache.getZoneMap()->recordUpdate(loc);
+
+        if (hashActive) {
+            const uint64_t h0 = oldDocHash[0];
+            const uint64_t h1 = oldDocHash[1];
+            opCtx->recoveryUnit()->onCommit(
+                [multisetHash, h0, h1] { multisetHash->applyDelete(h0, h1); });
+            recordMultisetHashChange(opCtx, multisetHash, args->updatedDoc, true);
+        }
+
         getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, *args);
     }
     return newRecStatus;
@@ -876,6 +955,9 @@ Status CollectionImpl::truncate(OperationContext* opCtx) {
     if (!status.isOK())
         return status;
 
+    _infoCache.getZoneMap()->clear();
+    _infoCache.getMultisetHash()->deactivate();
+
     // 4) re-create indexes
     for (size_t i = 0; i < indexSpecs.size(); i++) {
         status = _indexCatalog.createIndexOnEmptyCollection(opCtx, indexSpecs[i]).getStatus();
@@ -894,6 +976,8 @@ void CollectionImpl::cappedTruncateAfter(OperationContext* opCtx, RecordId end,
 
     _cursorManager.invalidateAll(opCtx, false, "capped collection truncated");
     _recordStore->cappedTruncateAfter(opCtx, end, inclusive);
+    _infoCache.getZoneMap()->clear();
+    _infoCache.getMultisetHash()->deactivate();
 }
 
 Status CollectionImpl::setValidator(OperationContext* opCtx, BSONObj validatorDoc) {
@@ -1000,6 +1084,11 @@ const CollatorInterface* CollectionImpl::getDefaultCollator() const {
     return _collator.get();
 }
 
+// Number of threads that traverse indexes concurrently during validation. The record store scan
+// is unaffected; with the default of 1 the index phase also runs on the caller's thread as
+// before.
+MONGO_EXPORT_SERVER_PARAMETER(validateNumIndexScanThreads, int, 1);
+
 namespace {
 
 using ValidateResultsMap = std::map<std::string, ValidateResults>;
@@ -1024,6 +1113,33 @@ void _validateRecordStore(OperationContext* opCtx,
     }
 }
 
+// One index traversal's inputs and outputs; filled in by a validation worker.
+struct IndexValidateJob {
+    const IndexDescriptor* descriptor;
+    IndexAccessMethod* iam;
+    ValidateResults* curIndexResults;
+    bool checkCounts = false;
+    int64_t numTraversedKeys = 0;
+    int64_t numValidatedKeys = 0;
+};
+
+void _runIndexValidateJob(OperationContext* opCtx,
+                          RecordStoreValidateAdaptor* indexValidator,
+                          ValidateCmdLevel level,
+                          IndexValidateJob* job) {
+    log(LogComponent::kIndex) << "validating index " << job->descriptor->indexNamespace() << endl;
+
+    if (level == kValidateFull) {
+        job->iam->validate(opCtx, &job->numValidatedKeys, job->curIndexResults);
+        job->checkCounts = true;
+    }
+
+    if (job->curIndexResults->valid) {
+        indexValidator->traverseIndex(
+            opCtx, job->iam, job->descriptor, job->curIndexResults, &job->numTraversedKeys);
+    }
+}
+
 void _validateIndexes(OperationContext* opCtx,
                       IndexCatalog* indexCatalog,
                       BSONObjBuilder* keysPerIndex,
@@ -1032,40 +1148,78 @@ void _validateIndexes(OperationContext* opCtx,
                       ValidateResultsMap* indexNsResultsMap,
                       ValidateResults* results) {
 
+    // Gather the jobs up front so the results map entries are created before any worker runs;
+    // workers only touch their own entry.
+    std::vector<IndexValidateJob> jobs;
     IndexCatalog::IndexIterator i = indexCatalog->getIndexIterator(opCtx, false);
-
-    // Validate Indexes.
     while (i.more()) {
-        opCtx->checkForInterrupt();
         const IndexDescriptor* descriptor = i.next();
-        log(LogComponent::kIndex) << "validating index " << descriptor->indexNamespace() << endl;
-        IndexAccessMethod* iam = indexCatalog->getIndex(descriptor);
-        ValidateResults& curIndexResults = (*indexNsResultsMap)[descriptor->indexNamespace()];
-        bool checkCounts = false;
-        int64_t numTraversedKeys;
-        int64_t numValidatedKeys;
+        IndexValidateJob job;
+        job.descriptor = descriptor;
+        job.iam = indexCatalog->getIndex(descriptor);
+        job.curIndexResults = &(*indexNsResultsMap)[descriptor->indexNamespace()];
+        jobs.push_back(job);
+    }
 
-        if (level == kValidateFull) {
-            iam->validate(opCtx, &numValidatedKeys, &curIndexResults);
-            checkCounts = true;
+    const int numThreads = std::max(
+        1, std::min(validateNumIndexScanThreads.load(), static_cast<int>(jobs.size())));
+    if (numThreads <= 1) {
+        for (auto& job : jobs) {
+            opCtx->checkForInterrupt();
+            _runIndexValidateJob(opCtx, indexValidator, level, &job);
         }
+    } else {
+        // Traverse several indexes at once. The collection is held in MODE_X, so each worker's
+        // own snapshot sees the same quiesced data as the caller's; the adaptor's key count
+        // table is striped for concurrent reconciliation.
+        AtomicUInt32 nextJob;
+        std::vector<stdx::thread> workers;
+        for (int t = 0; t < numThreads; t++) {
+            workers.emplace_back([&] {
+                Client::initThread("validate index scan");
+                const ServiceContext::UniqueOperationContext workerOpCtxPtr =
+                    cc().makeOperationContext();
+                while (true) {
+                    const uint32_t jobNum = nextJob.fetchAndAdd(1);
+                    if (jobNum >= jobs.size()) {
+                        return;
+                    }
+                    IndexValidateJob& job = jobs[jobNum];
+                    try {
+                        _runIndexValidateJob(
+                            workerOpCtxPtr.get(), indexValidator, level, &job);
+                    } catch (const DBException& e) {
+                        job.curIndexResults->errors.push_back(
+                            str::stream() << "exception validating index "
+                                          << job.descriptor->indexNamespace() << ": "
+                                          << e.toString());
+                        job.curIndexResults->valid = false;
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        opCtx->checkForInterrupt();
+    }
 
+    for (auto& job : jobs) {
+        ValidateResults& curIndexResults = *job.curIndexResults;
         if (curIndexResults.valid) {
-            indexValidator->traverseIndex(iam, descriptor, &curIndexResults, &numTraversedKeys);
-
-            if (checkCounts && (numValidatedKeys != numTraversedKeys)) {
+            if (job.checkCounts && (job.numValidatedKeys != job.numTraversedKeys)) {
                 curIndexResults.valid = false;
                 string msg = str::stream()
-                    << "number of traversed index entries (" << numTraversedKeys
-                    << ") does not match the number of expected index entries (" << numValidatedKeys
-                    << ")";
+                    << "number of traversed index entries (" << job.numTraversedKeys
+                    << ") does not match the number of expected index entries ("
+                    << job.numValidatedKeys << ")";
                 results->errors.push_back(msg);
                 results->valid = false;
             }
 
             if (curIndexResults.valid) {
-                keysPerIndex->appendNumber(descriptor->indexNamespace(),
-                                           static_cast<long long>(numTraversedKeys));
+                keysPerIndex->appendNumber(job.descriptor->indexNamespace(),
+                                           static_cast<long long>(job.numTraversedKeys));
             } else {
                 results->valid = false;
             }
@@ -1164,8 +1318,7 @@ Status CollectionImpl::validate(OperationContext* opCtx,
     try {
         ValidateResultsMap indexNsResultsMap;
         BSONObjBuilder keysPerIndex;  // not using subObjStart to be exception safe
-        RecordStoreValidateAdaptor indexValidator =
-            RecordStoreValidateAdaptor(opCtx, level, &_indexCatalog, &indexNsResultsMap);
+        RecordStoreValidateAdaptor indexValidator(opCtx, level, &_indexCatalog, &indexNsResultsMap);
 
 
         // Validate the record store
@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include "mongo/db/catalog/collection_multiset_hash.h"
+#include "mongo/db/catalog/collection_zone_map.h"
+#include "mongo/db/catalog/field_name_interner.h"
 #include "mongo/db/collection_index_usage_tracker.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_settings.h"
@@ -53,6 +56,12 @@ public:
 
         virtual QuerySettings* getQuerySettings() const = 0;
 
+        virtual FieldNameInterner* getFieldNameInterner() const = 0;
+
+        virtual CollectionZoneMap* getZoneMap() const = 0;
+
+        virtual CollectionMultisetHash* getMultisetHash() const = 0;
+
         virtual const UpdateIndexData& getIndexKeys(OperationContext* opCtx) const = 0;
 
         virtual CollectionIndexUsageMap getIndexUsageStats() const = 0;
@@ -103,6 +112,30 @@ public:
         return this->_impl().getQuerySettings();
     }
 
+    /**
+     * Get the per-collection field-name intern table, used by hot paths to compare 32-bit
+     * ids instead of strings.
+     */
+    inline FieldNameInterner* getFieldNameInterner() const {
+        return this->_impl().getFieldNameInterner();
+    }
+
+    /**
+     * Get the per-collection zone map, used by collection scans to skip record ranges whose
+     * min/max exclude the query's predicate.
+     */
+    inline CollectionZoneMap* getZoneMap() const {
+        return this->_impl().getZoneMap();
+    }
+
+    /**
+     * Get the incrementally maintained multiset hash of the collection's documents, used by
+     * the dbHash command's incremental mode.
+     */
+    inline CollectionMultisetHash* getMultisetHash() const {
+        return this->_impl().getMultisetHash();
+    }
+
     /* get set of index keys for this namespace.  handy to quickly check if a given
        field is indexed (Note it might be a secondary component of a compound index.)
     */
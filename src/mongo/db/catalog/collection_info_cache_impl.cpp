@@ -34,6 +34,7 @@
 
 #include "mongo/base/init.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/plan_cache_persistence.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -177,7 +178,24 @@ QuerySettings* CollectionInfoCacheImpl::getQuerySettings() const {
     return _querySettings.get();
 }
 
+FieldNameInterner* CollectionInfoCacheImpl::getFieldNameInterner() const {
+    return &_fieldNameInterner;
+}
+
+CollectionZoneMap* CollectionInfoCacheImpl::getZoneMap() const {
+    return &_zoneMap;
+}
+
+CollectionMultisetHash* CollectionInfoCacheImpl::getMultisetHash() const {
+    return &_multisetHash;
+}
+
 void CollectionInfoCacheImpl::updatePlanCacheIndexEntries(OperationContext* opCtx) {
+    _planCache->notifyOfIndexEntries(makePlanCacheIndexEntries(opCtx));
+}
+
+std::vector<IndexEntry> CollectionInfoCacheImpl::makePlanCacheIndexEntries(
+    OperationContext* opCtx) {
     std::vector<IndexEntry> indexEntries;
 
     // TODO We shouldn't need to include unfinished indexes, but we must here because the index
@@ -200,7 +218,7 @@ void CollectionInfoCacheImpl::updatePlanCacheIndexEntries(OperationContext* opCt
                                   ice->getCollator());
     }
 
-    _planCache->notifyOfIndexEntries(indexEntries);
+    return indexEntries;
 }
 
 void CollectionInfoCacheImpl::init(OperationContext* opCtx) {
@@ -216,6 +234,11 @@ void CollectionInfoCacheImpl::init(OperationContext* opCtx) {
     }
 
     rebuildIndexData(opCtx);
+
+    // If a plan cache dump was written on the last clean shutdown, restore this collection's
+    // entries so steady-state plan selection does not have to re-run multi-planning.
+    plan_cache_persistence::loadPlanCache(
+        opCtx, _ns, makePlanCacheIndexEntries(opCtx), _planCache.get());
 }
 
 void CollectionInfoCacheImpl::addedIndex(OperationContext* opCtx, const IndexDescriptor* desc) {
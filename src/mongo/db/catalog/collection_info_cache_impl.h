@@ -61,6 +61,21 @@ public:
      */
     QuerySettings* getQuerySettings() const;
 
+    /**
+     * Get the per-collection field-name intern table.
+     */
+    FieldNameInterner* getFieldNameInterner() const;
+
+    /**
+     * Get the per-collection zone map.
+     */
+    CollectionZoneMap* getZoneMap() const;
+
+    /**
+     * Get the per-collection incremental multiset hash.
+     */
+    CollectionMultisetHash* getMultisetHash() const;
+
     /* get set of index keys for this namespace.  handy to quickly check if a given
        field is indexed (Note it might be a secondary component of a compound index.)
     */
@@ -111,6 +126,11 @@ private:
     void computeIndexKeys(OperationContext* opCtx);
     void updatePlanCacheIndexEntries(OperationContext* opCtx);
 
+    /**
+     * Builds an IndexEntry for every index in the collection's index catalog.
+     */
+    std::vector<IndexEntry> makePlanCacheIndexEntries(OperationContext* opCtx);
+
     /**
      * Rebuilds cached information that is dependent on index composition. Must be called
      * when index composition changes.
@@ -127,6 +147,15 @@ private:
     // A cache for query plans.
     std::unique_ptr<PlanCache> _planCache;
 
+    // Field-name intern table; see FieldNameInterner.
+    mutable FieldNameInterner _fieldNameInterner;
+
+    // Zone map; see CollectionZoneMap.
+    mutable CollectionZoneMap _zoneMap;
+
+    // Incremental multiset hash; see CollectionMultisetHash.
+    mutable CollectionMultisetHash _multisetHash;
+
     // Query settings.
     // Includes index filters.
     std::unique_ptr<QuerySettings> _querySettings;
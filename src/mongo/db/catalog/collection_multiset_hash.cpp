@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection_multiset_hash.h"
+
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+#include "mongo/base/data_view.h"
+#include "mongo/util/hex.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+// Fixed seed so that every node of a replica set computes the same per-document hashes.
+const uint32_t kHashSeed = 0xdb44a54e;
+
+}  // namespace
+
+// static
+void CollectionMultisetHash::hashDocument(const BSONObj& doc, uint64_t out[2]) {
+    MurmurHash3_x64_128(doc.objdata(), doc.objsize(), kHashSeed, out);
+}
+
+bool CollectionMultisetHash::isActive() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _active;
+}
+
+void CollectionMultisetHash::activate(const uint64_t lanes[2], long long count) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _active = true;
+    _lanes[0] = lanes[0];
+    _lanes[1] = lanes[1];
+    _count = count;
+}
+
+void CollectionMultisetHash::deactivate() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _active = false;
+    _lanes[0] = 0;
+    _lanes[1] = 0;
+    _count = 0;
+}
+
+bool CollectionMultisetHash::get(uint64_t lanes[2], long long* count) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_active) {
+        return false;
+    }
+    lanes[0] = _lanes[0];
+    lanes[1] = _lanes[1];
+    *count = _count;
+    return true;
+}
+
+void CollectionMultisetHash::applyInsert(uint64_t h0, uint64_t h1) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_active) {
+        return;
+    }
+    // Per-lane addition mod 2^64 is commutative and, unlike XOR, distinguishes a document
+    // occurring twice from it not occurring at all.
+    _lanes[0] += h0;
+    _lanes[1] += h1;
+    _count++;
+}
+
+void CollectionMultisetHash::applyDelete(uint64_t h0, uint64_t h1) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_active) {
+        return;
+    }
+    _lanes[0] -= h0;
+    _lanes[1] -= h1;
+    _count--;
+}
+
+// static
+std::string CollectionMultisetHash::format(const uint64_t lanes[2], long long count) {
+    // Serialize the lanes in a fixed byte order so the rendering does not depend on the
+    // host's endianness.
+    char bytes[16];
+    DataView(bytes).write<LittleEndian<uint64_t>>(lanes[0], 0);
+    DataView(bytes).write<LittleEndian<uint64_t>>(lanes[1], 8);
+    str::stream out;
+    out << toHexLower(bytes, sizeof(bytes)) << "-" << count;
+    return out;
+}
+
+}  // namespace mongo
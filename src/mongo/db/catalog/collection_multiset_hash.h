@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+/**
+ * An incrementally maintained, order-independent hash of a collection's documents, used by the
+ * dbHash command's incremental mode to answer consistency checks without rescanning the
+ * collection. Each document contributes a 128-bit fast hash of its BSON bytes; the collection
+ * hash is the per-lane sum of those contributions, so inserts add, deletes subtract, and two
+ * collections hash equal iff they hold the same multiset of documents (modulo hash collisions).
+ *
+ * The hash starts inactive and is seeded by the first incremental dbHash, which scans the
+ * collection once under the database S lock and calls activate(). From then on the write paths
+ * in CollectionImpl keep it current by applying per-document deltas on commit; since addition
+ * is commutative the application order does not matter. The state is in-memory only and is
+ * lost when the collection object is destroyed (e.g. on restart), after which the next
+ * incremental dbHash reseeds it.
+ *
+ * Capped collections are never activated: their record stores delete old documents internally,
+ * below the paths that maintain this hash.
+ *
+ * All methods are thread-safe.
+ */
+class CollectionMultisetHash {
+    MONGO_DISALLOW_COPYING(CollectionMultisetHash);
+
+public:
+    CollectionMultisetHash() = default;
+
+    /**
+     * Computes the 128-bit per-document hash of 'doc' into 'out'.
+     */
+    static void hashDocument(const BSONObj& doc, uint64_t out[2]);
+
+    /**
+     * Whether the hash has been seeded and is being maintained. Write paths may use this to
+     * skip computing per-document hashes when nobody has asked for the collection's hash.
+     */
+    bool isActive() const;
+
+    /**
+     * Seeds the hash with the totals of a full collection scan and starts maintenance. The
+     * caller must guarantee that no writes can commit between the scan and this call (the
+     * dbHash command holds the database S lock across both).
+     */
+    void activate(const uint64_t lanes[2], long long count);
+
+    /**
+     * Discards the hash, e.g. when the collection is truncated. The next incremental dbHash
+     * reseeds it.
+     */
+    void deactivate();
+
+    /**
+     * If active, fills in the current totals and returns true; returns false otherwise.
+     */
+    bool get(uint64_t lanes[2], long long* count) const;
+
+    /**
+     * Adds / removes one document's contribution, previously computed with hashDocument().
+     * No-ops while inactive. Must only be called for committed writes.
+     */
+    void applyInsert(uint64_t h0, uint64_t h1);
+    void applyDelete(uint64_t h0, uint64_t h1);
+
+    /**
+     * Renders 'lanes' and 'count' in the fixed format the dbHash command reports.
+     */
+    static std::string format(const uint64_t lanes[2], long long count);
+
+private:
+    mutable stdx::mutex _mutex;
+    bool _active = false;
+    uint64_t _lanes[2] = {0, 0};
+    long long _count = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection_multiset_hash.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const uint64_t kZeroLanes[2] = {0, 0};
+
+void applyInsertOf(CollectionMultisetHash* hash, const BSONObj& doc) {
+    uint64_t h[2];
+    CollectionMultisetHash::hashDocument(doc, h);
+    hash->applyInsert(h[0], h[1]);
+}
+
+void applyDeleteOf(CollectionMultisetHash* hash, const BSONObj& doc) {
+    uint64_t h[2];
+    CollectionMultisetHash::hashDocument(doc, h);
+    hash->applyDelete(h[0], h[1]);
+}
+
+std::string currentFormat(const CollectionMultisetHash& hash) {
+    uint64_t lanes[2];
+    long long count;
+    ASSERT_TRUE(hash.get(lanes, &count));
+    return CollectionMultisetHash::format(lanes, count);
+}
+
+TEST(CollectionMultisetHash, InactiveUntilActivated) {
+    CollectionMultisetHash hash;
+    ASSERT_FALSE(hash.isActive());
+
+    uint64_t lanes[2];
+    long long count;
+    ASSERT_FALSE(hash.get(lanes, &count));
+
+    // Deltas applied while inactive are dropped.
+    applyInsertOf(&hash, BSON("_id" << 1));
+    ASSERT_FALSE(hash.get(lanes, &count));
+
+    hash.activate(kZeroLanes, 0);
+    ASSERT_TRUE(hash.isActive());
+    ASSERT_TRUE(hash.get(lanes, &count));
+    ASSERT_EQUALS(0, count);
+}
+
+TEST(CollectionMultisetHash, InsertThenDeleteRestoresEmptyHash) {
+    CollectionMultisetHash hash;
+    hash.activate(kZeroLanes, 0);
+    const std::string empty = currentFormat(hash);
+
+    applyInsertOf(&hash, BSON("_id" << 1 << "a" << 1));
+    ASSERT_NOT_EQUALS(empty, currentFormat(hash));
+
+    applyDeleteOf(&hash, BSON("_id" << 1 << "a" << 1));
+    ASSERT_EQUALS(empty, currentFormat(hash));
+}
+
+TEST(CollectionMultisetHash, OrderIndependent) {
+    const BSONObj a = BSON("_id" << 1 << "x"
+                                 << "one");
+    const BSONObj b = BSON("_id" << 2 << "x"
+                                 << "two");
+    const BSONObj c = BSON("_id" << 3 << "x"
+                                 << "three");
+
+    CollectionMultisetHash forward;
+    forward.activate(kZeroLanes, 0);
+    applyInsertOf(&forward, a);
+    applyInsertOf(&forward, b);
+    applyInsertOf(&forward, c);
+
+    CollectionMultisetHash backward;
+    backward.activate(kZeroLanes, 0);
+    applyInsertOf(&backward, c);
+    applyInsertOf(&backward, b);
+    applyInsertOf(&backward, a);
+
+    ASSERT_EQUALS(currentFormat(forward), currentFormat(backward));
+}
+
+TEST(CollectionMultisetHash, DuplicateDocumentsAreDistinguished) {
+    const BSONObj doc = BSON("_id" << 1);
+
+    CollectionMultisetHash once;
+    once.activate(kZeroLanes, 0);
+    applyInsertOf(&once, doc);
+
+    CollectionMultisetHash twice;
+    twice.activate(kZeroLanes, 0);
+    applyInsertOf(&twice, doc);
+    applyInsertOf(&twice, doc);
+
+    // With a XOR-combined hash these would collide; with per-lane addition they must not.
+    ASSERT_NOT_EQUALS(currentFormat(once), currentFormat(twice));
+}
+
+TEST(CollectionMultisetHash, UpdateEqualsDeletePlusInsert) {
+    const BSONObj oldDoc = BSON("_id" << 1 << "a" << 1);
+    const BSONObj newDoc = BSON("_id" << 1 << "a" << 2);
+
+    CollectionMultisetHash updated;
+    updated.activate(kZeroLanes, 0);
+    applyInsertOf(&updated, oldDoc);
+    applyDeleteOf(&updated, oldDoc);
+    applyInsertOf(&updated, newDoc);
+
+    CollectionMultisetHash direct;
+    direct.activate(kZeroLanes, 0);
+    applyInsertOf(&direct, newDoc);
+
+    ASSERT_EQUALS(currentFormat(updated), currentFormat(direct));
+}
+
+TEST(CollectionMultisetHash, DeactivateDiscardsState) {
+    CollectionMultisetHash hash;
+    hash.activate(kZeroLanes, 0);
+    applyInsertOf(&hash, BSON("_id" << 1));
+
+    hash.deactivate();
+    ASSERT_FALSE(hash.isActive());
+
+    uint64_t lanes[2];
+    long long count;
+    ASSERT_FALSE(hash.get(lanes, &count));
+}
+
+TEST(CollectionMultisetHash, FormatIsStable) {
+    // The format is compared across replica set nodes, so it must not change silently.
+    ASSERT_EQUALS("00000000000000000000000000000000-0",
+                  CollectionMultisetHash::format(kZeroLanes, 0));
+
+    const uint64_t lanes[2] = {0x0123456789abcdefULL, 0xfedcba9876543210ULL};
+    ASSERT_EQUALS("efcdab89674523011032547698badcfe-5", CollectionMultisetHash::format(lanes, 5));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,306 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection_zone_map.h"
+
+#include <algorithm>
+
+#include "mongo/db/matcher/expression_leaf.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Types whose woCompare ordering is total and collator-free (except strings, which are
+ * handled separately), making their min/max meaningful for exclusion checks.
+ */
+bool isZoneComparableType(BSONType type) {
+    switch (type) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case NumberDecimal:
+        case String:
+        case Date:
+        case bsonTimestamp:
+        case jstOID:
+        case Bool:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Returns the comparison, or null when 'expr' is not a top-level comparison usable for zone
+ * exclusion: the path must be a single segment and the operand a comparable non-null scalar,
+ * with no collation in play for strings (zone bounds were collected with binary ordering).
+ */
+const ComparisonMatchExpression* asZoneComparison(const MatchExpression* expr) {
+    if (!ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        return nullptr;
+    }
+    const ComparisonMatchExpression* cmp = static_cast<const ComparisonMatchExpression*>(expr);
+    if (cmp->path().find('.') != std::string::npos) {
+        return nullptr;
+    }
+    const BSONElement& rhs = cmp->getData();
+    if (!isZoneComparableType(rhs.type())) {
+        return nullptr;
+    }
+    if ((rhs.type() == String) && cmp->getCollator()) {
+        return nullptr;
+    }
+    return cmp;
+}
+
+}  // namespace
+
+void CollectionZoneMap::recordInsert(const RecordId& id, const BSONObj& doc) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    // Zones assume the record ranges of successive inserts are ascending and disjoint. A
+    // record id at or below an already-sealed zone (rollback, manual repair) voids that
+    // assumption, so start over.
+    if (!_zones.empty() && id <= _zones.back().maxRecord) {
+        _zones.clear();
+        _trackedFields.clear();
+        _openZone = Zone();
+    }
+
+    if (_openZone.count == 0) {
+        _openZone.minRecord = id;
+        _openZone.maxRecord = id;
+        _openZone.fields.resize(_trackedFields.size());
+    }
+
+    // Adopt new tracked fields first-come until the cap. Fields adopted mid-zone were not
+    // accounted for this zone's earlier documents, so their stats start unusable.
+    if (_trackedFields.size() < kMaxTrackedFields) {
+        for (BSONObjIterator it(doc); it.more();) {
+            BSONElement elt = it.next();
+            if (!isZoneComparableType(elt.type())) {
+                continue;
+            }
+            StringData fieldName = elt.fieldNameStringData();
+            if (std::find(_trackedFields.begin(), _trackedFields.end(), fieldName) !=
+                _trackedFields.end()) {
+                continue;
+            }
+            _trackedFields.push_back(fieldName.toString());
+            FieldStats stats;
+            stats.usable = (_openZone.count == 0);
+            _openZone.fields.push_back(std::move(stats));
+            if (_trackedFields.size() == kMaxTrackedFields) {
+                break;
+            }
+        }
+    }
+
+    _openZone.maxRecord = std::max(_openZone.maxRecord, id);
+    _openZone.minRecord = std::min(_openZone.minRecord, id);
+    ++_openZone.count;
+
+    for (size_t i = 0; i < _trackedFields.size(); ++i) {
+        FieldStats& stats = _openZone.fields[i];
+        if (!stats.usable) {
+            continue;
+        }
+        BSONElement elt = doc.getField(_trackedFields[i]);
+        if (!isZoneComparableType(elt.type())) {
+            // A document without the field (or with an unsupported value) makes the zone's
+            // min/max meaningless for exclusion.
+            stats.usable = false;
+            continue;
+        }
+        if (!stats.seen) {
+            stats.min = elt.wrap().getOwned();
+            stats.max = stats.min;
+            stats.seen = true;
+            continue;
+        }
+        if (elt.canonicalType() != stats.min.firstElement().canonicalType()) {
+            // Mixed-type fields would need type-bracketed bounds; not worth tracking.
+            stats.usable = false;
+            continue;
+        }
+        if (elt.woCompare(stats.min.firstElement(), false) < 0) {
+            stats.min = elt.wrap().getOwned();
+        }
+        if (elt.woCompare(stats.max.firstElement(), false) > 0) {
+            stats.max = elt.wrap().getOwned();
+        }
+    }
+
+    if (_openZone.count >= kZoneSize) {
+        _zones.push_back(std::move(_openZone));
+        _openZone = Zone();
+    }
+}
+
+void CollectionZoneMap::recordUpdate(const RecordId& id) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    if (_openZone.count > 0 && id >= _openZone.minRecord && id <= _openZone.maxRecord) {
+        _openZone.usable = false;
+    }
+
+    // Last zone whose min is not greater than 'id'.
+    auto it = std::upper_bound(
+        _zones.begin(), _zones.end(), id, [](const RecordId& lhs, const Zone& zone) {
+            return lhs < zone.minRecord;
+        });
+    if (it == _zones.begin()) {
+        return;
+    }
+    --it;
+    if (id <= it->maxRecord) {
+        it->usable = false;
+    }
+}
+
+void CollectionZoneMap::clear() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _zones.clear();
+    _trackedFields.clear();
+    _openZone = Zone();
+}
+
+bool CollectionZoneMap::mightSkipFor(const MatchExpression* filter) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_zones.empty() && _openZone.count == 0) {
+        return false;
+    }
+
+    auto tracksComparison = [this](const MatchExpression* expr) {
+        const ComparisonMatchExpression* cmp = asZoneComparison(expr);
+        return cmp &&
+            std::find(_trackedFields.begin(), _trackedFields.end(), cmp->path()) !=
+            _trackedFields.end();
+    };
+
+    if (MatchExpression::AND == filter->matchType()) {
+        for (size_t i = 0; i < filter->numChildren(); ++i) {
+            if (tracksComparison(filter->getChild(i))) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return tracksComparison(filter);
+}
+
+boost::optional<RecordId> CollectionZoneMap::skipUpperBound(const RecordId& id,
+                                                            const MatchExpression* filter) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto it = std::upper_bound(
+        _zones.begin(), _zones.end(), id, [](const RecordId& lhs, const Zone& zone) {
+            return lhs < zone.minRecord;
+        });
+    if (it == _zones.begin()) {
+        return boost::none;
+    }
+    --it;
+    if (id > it->maxRecord || !it->usable) {
+        return boost::none;
+    }
+    if (!_zoneExcludes(*it, filter)) {
+        return boost::none;
+    }
+    return it->maxRecord;
+}
+
+size_t CollectionZoneMap::numZones() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _zones.size();
+}
+
+bool CollectionZoneMap::_zoneExcludes(const Zone& zone, const MatchExpression* filter) const {
+    // A conjunction cannot match in the zone if any single conjunct cannot; anything but a
+    // comparison or a top-level $and contributes nothing and is simply ignored.
+    if (MatchExpression::AND == filter->matchType()) {
+        for (size_t i = 0; i < filter->numChildren(); ++i) {
+            const ComparisonMatchExpression* cmp = asZoneComparison(filter->getChild(i));
+            if (cmp && _zoneExcludesComparison(zone, cmp)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const ComparisonMatchExpression* cmp = asZoneComparison(filter);
+    return cmp && _zoneExcludesComparison(zone, cmp);
+}
+
+bool CollectionZoneMap::_zoneExcludesComparison(const Zone& zone,
+                                                const ComparisonMatchExpression* cmp) const {
+    auto fieldIt = std::find(_trackedFields.begin(), _trackedFields.end(), cmp->path());
+    if (fieldIt == _trackedFields.end()) {
+        return false;
+    }
+    const size_t fieldIndex = fieldIt - _trackedFields.begin();
+    if (fieldIndex >= zone.fields.size()) {
+        return false;  // Field adopted after this zone was sealed.
+    }
+    const FieldStats& stats = zone.fields[fieldIndex];
+    if (!stats.seen || !stats.usable) {
+        return false;
+    }
+
+    const BSONElement& rhs = cmp->getData();
+    const BSONElement min = stats.min.firstElement();
+    const BSONElement max = stats.max.firstElement();
+    if (rhs.canonicalType() != min.canonicalType()) {
+        // Type-bracketed comparisons across canonical types never match these values at all,
+        // but leaving that to the filter keeps this check simple and obviously safe.
+        return false;
+    }
+
+    // Zone values v all satisfy min <= v <= max; exclude the zone when the predicate's
+    // solution set cannot intersect that interval.
+    switch (cmp->matchType()) {
+        case MatchExpression::EQ:
+            return rhs.woCompare(min, false) < 0 || rhs.woCompare(max, false) > 0;
+        case MatchExpression::LT:
+            return min.woCompare(rhs, false) >= 0;
+        case MatchExpression::LTE:
+            return min.woCompare(rhs, false) > 0;
+        case MatchExpression::GT:
+            return max.woCompare(rhs, false) <= 0;
+        case MatchExpression::GTE:
+            return max.woCompare(rhs, false) < 0;
+        default:
+            return false;
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class ComparisonMatchExpression;
+
+/**
+ * In-memory zone map for a collection: per range ("zone") of consecutively inserted records,
+ * the min and max values of a small set of automatically chosen top-level fields. Collection
+ * scans consult it to skip whole zones whose min/max exclude the query's equality or range
+ * predicate, which on append-mostly data (e.g. time-ordered telemetry with a time filter)
+ * eliminates most of the per-document work.
+ *
+ * Maintained opportunistically from the insert path and never persisted; the map starts empty
+ * after a restart and only describes records inserted since. Skipping is always conservative:
+ * a zone is only skipped when no document in it can possibly satisfy the predicate. Updates
+ * invalidate the zone containing the changed record; deletes need no handling because a
+ * zone's min/max stay a superset of its remaining values.
+ *
+ * All methods are thread-safe.
+ */
+class CollectionZoneMap {
+    MONGO_DISALLOW_COPYING(CollectionZoneMap);
+
+public:
+    // Number of inserts per zone. Zones are only consulted once sealed.
+    static const long long kZoneSize = 1024;
+
+    // Upper bound on the number of tracked fields, chosen first-come from inserted documents.
+    static const size_t kMaxTrackedFields = 8;
+
+    CollectionZoneMap() = default;
+
+    /**
+     * Accounts for a newly inserted document. Out-of-order record ids (e.g. after a rollback)
+     * discard the map rather than risk an unsound zone.
+     */
+    void recordInsert(const RecordId& id, const BSONObj& doc);
+
+    /**
+     * Invalidates the zone containing 'id'; the new document version may fall outside the
+     * zone's recorded min/max.
+     */
+    void recordUpdate(const RecordId& id);
+
+    /**
+     * Discards all zones, e.g. when the collection is truncated.
+     */
+    void clear();
+
+    /**
+     * Cheap per-query precheck: returns true if 'filter' contains at least one top-level
+     * comparison on a tracked field, i.e. consulting the map per record could ever pay off.
+     */
+    bool mightSkipFor(const MatchExpression* filter) const;
+
+    /**
+     * If 'id' falls in a sealed zone that no document can satisfy 'filter' in, returns the
+     * zone's last record id so the scan can skip everything up to and including it. Returns
+     * boost::none otherwise.
+     */
+    boost::optional<RecordId> skipUpperBound(const RecordId& id, const MatchExpression* filter) const;
+
+    /**
+     * Number of sealed zones. For tests and diagnostics.
+     */
+    size_t numZones() const;
+
+private:
+    // Min/max of one tracked field over one zone. Only usable while every document in the
+    // zone had the field with a value of the same canonical type.
+    struct FieldStats {
+        BSONObj min;  // Single-element object, owned.
+        BSONObj max;
+        bool seen = false;
+        bool usable = true;
+    };
+
+    struct Zone {
+        RecordId minRecord;
+        RecordId maxRecord;
+        long long count = 0;
+        std::vector<FieldStats> fields;  // Parallel to '_trackedFields'.
+        bool usable = true;              // Cleared when a record in the zone is updated.
+    };
+
+    bool _zoneExcludes(const Zone& zone, const MatchExpression* filter) const;
+    bool _zoneExcludesComparison(const Zone& zone, const ComparisonMatchExpression* cmp) const;
+
+    mutable stdx::mutex _mutex;
+    std::vector<std::string> _trackedFields;
+    std::vector<Zone> _zones;  // Sealed zones, ascending and disjoint by record range.
+    Zone _openZone;            // Still filling; never consulted for skipping.
+};
+
+}  // namespace mongo
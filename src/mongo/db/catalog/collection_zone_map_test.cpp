@@ -0,0 +1,214 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection_zone_map.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_tree.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+
+const long long kZoneSize = CollectionZoneMap::kZoneSize;
+
+/**
+ * Inserts 'numZones' full zones of {a: <value>, b: <ascending counter>} documents, with 'a'
+ * taking the i-th value of 'aValuesPerZone' throughout the i-th zone. Record ids start at 1.
+ */
+void fillZones(CollectionZoneMap* zoneMap, const std::vector<int>& aValuesPerZone) {
+    long long nextId = 1;
+    for (size_t zone = 0; zone < aValuesPerZone.size(); ++zone) {
+        for (long long i = 0; i < kZoneSize; ++i, ++nextId) {
+            zoneMap->recordInsert(RecordId(nextId),
+                                  BSON("a" << aValuesPerZone[zone] << "b" << nextId));
+        }
+    }
+}
+
+TEST(CollectionZoneMap, SealsZonesEveryKZoneSizeInserts) {
+    CollectionZoneMap zoneMap;
+    for (long long i = 1; i <= 3 * kZoneSize + 1; ++i) {
+        zoneMap.recordInsert(RecordId(i), BSON("a" << 1));
+    }
+    ASSERT_EQUALS(zoneMap.numZones(), 3u);
+}
+
+TEST(CollectionZoneMap, SkipsZoneWhoseRangeExcludesEquality) {
+    CollectionZoneMap zoneMap;
+    fillZones(&zoneMap, {10, 20, 30});
+
+    EqualityMatchExpression eq;
+    const BSONObj operand = BSON("a" << 20);
+    ASSERT_OK(eq.init("a", operand.firstElement()));
+
+    // Zones 1 and 3 hold only a:10 and a:30 and can be skipped; zone 2 cannot.
+    auto bound = zoneMap.skipUpperBound(RecordId(1), &eq);
+    ASSERT_TRUE(bound != boost::none);
+    ASSERT_EQUALS(*bound, RecordId(kZoneSize));
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(kZoneSize + 1), &eq) == boost::none);
+    bound = zoneMap.skipUpperBound(RecordId(2 * kZoneSize + 1), &eq);
+    ASSERT_TRUE(bound != boost::none);
+    ASSERT_EQUALS(*bound, RecordId(3 * kZoneSize));
+}
+
+TEST(CollectionZoneMap, SkipsZonesOutsideRangePredicate) {
+    CollectionZoneMap zoneMap;
+    fillZones(&zoneMap, {10, 20, 30});
+
+    // {a: {$gt: 20}} excludes the first two zones (max <= 20) but not the third.
+    GTMatchExpression gt;
+    const BSONObj gtOperand = BSON("a" << 20);
+    ASSERT_OK(gt.init("a", gtOperand.firstElement()));
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(1), &gt) != boost::none);
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(kZoneSize + 1), &gt) != boost::none);
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(2 * kZoneSize + 1), &gt) == boost::none);
+
+    // {a: {$lte: 10}} keeps the first zone (min == 10) and excludes the rest.
+    LTEMatchExpression lte;
+    const BSONObj lteOperand = BSON("a" << 10);
+    ASSERT_OK(lte.init("a", lteOperand.firstElement()));
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(1), &lte) == boost::none);
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(kZoneSize + 1), &lte) != boost::none);
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(2 * kZoneSize + 1), &lte) != boost::none);
+}
+
+TEST(CollectionZoneMap, OpenZoneIsNeverConsulted) {
+    CollectionZoneMap zoneMap;
+    // Half a zone: nothing is sealed, so nothing can be skipped however selective the filter.
+    for (long long i = 1; i <= kZoneSize / 2; ++i) {
+        zoneMap.recordInsert(RecordId(i), BSON("a" << 1));
+    }
+    ASSERT_EQUALS(zoneMap.numZones(), 0u);
+
+    EqualityMatchExpression eq;
+    const BSONObj operand = BSON("a" << 999);
+    ASSERT_OK(eq.init("a", operand.firstElement()));
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(1), &eq) == boost::none);
+}
+
+TEST(CollectionZoneMap, UpdateInvalidatesContainingZone) {
+    CollectionZoneMap zoneMap;
+    fillZones(&zoneMap, {10, 20});
+
+    EqualityMatchExpression eq;
+    const BSONObj operand = BSON("a" << 99);
+    ASSERT_OK(eq.init("a", operand.firstElement()));
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(1), &eq) != boost::none);
+
+    // The updated document may now hold any value, so its zone can no longer be excluded;
+    // the other zone is unaffected.
+    zoneMap.recordUpdate(RecordId(5));
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(1), &eq) == boost::none);
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(kZoneSize + 1), &eq) != boost::none);
+}
+
+TEST(CollectionZoneMap, OutOfOrderInsertDiscardsZones) {
+    CollectionZoneMap zoneMap;
+    fillZones(&zoneMap, {10});
+    ASSERT_EQUALS(zoneMap.numZones(), 1u);
+
+    // A record id within the sealed range means ids are being reused; every zone is suspect.
+    zoneMap.recordInsert(RecordId(2), BSON("a" << 99));
+    ASSERT_EQUALS(zoneMap.numZones(), 0u);
+}
+
+TEST(CollectionZoneMap, MissingOrMixedTypeFieldIsUnusable) {
+    CollectionZoneMap zoneMap;
+    for (long long i = 1; i <= kZoneSize; ++i) {
+        // 'a' is absent from every other document; 'b' flips between number and string.
+        BSONObjBuilder bob;
+        if (i % 2 == 0) {
+            bob.append("a", 1);
+        }
+        if (i % 2 == 0) {
+            bob.append("b", 1);
+        } else {
+            bob.append("b", "one");
+        }
+        zoneMap.recordInsert(RecordId(i), bob.obj());
+    }
+    ASSERT_EQUALS(zoneMap.numZones(), 1u);
+
+    EqualityMatchExpression eqA;
+    const BSONObj operandA = BSON("a" << 999);
+    ASSERT_OK(eqA.init("a", operandA.firstElement()));
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(1), &eqA) == boost::none);
+
+    EqualityMatchExpression eqB;
+    const BSONObj operandB = BSON("b" << 999);
+    ASSERT_OK(eqB.init("b", operandB.firstElement()));
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(1), &eqB) == boost::none);
+}
+
+TEST(CollectionZoneMap, ConjunctionSkipsWhenAnyConjunctExcludes) {
+    CollectionZoneMap zoneMap;
+    fillZones(&zoneMap, {10, 20});
+
+    auto eq = stdx::make_unique<EqualityMatchExpression>();
+    const BSONObj operand = BSON("a" << 10);
+    ASSERT_OK(eq->init("a", operand.firstElement()));
+    auto gt = stdx::make_unique<GTMatchExpression>();
+    const BSONObj gtOperand = BSON("b" << 0);
+    ASSERT_OK(gt->init("b", gtOperand.firstElement()));
+
+    AndMatchExpression andExpr;
+    andExpr.add(eq.release());
+    andExpr.add(gt.release());
+
+    // {a: 10} excludes the second zone even though {b: {$gt: 0}} matches everywhere.
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(1), &andExpr) == boost::none);
+    ASSERT_TRUE(zoneMap.skipUpperBound(RecordId(kZoneSize + 1), &andExpr) != boost::none);
+}
+
+TEST(CollectionZoneMap, MightSkipForRequiresTrackedComparison) {
+    CollectionZoneMap zoneMap;
+    fillZones(&zoneMap, {10});
+
+    EqualityMatchExpression tracked;
+    const BSONObj trackedOperand = BSON("a" << 1);
+    ASSERT_OK(tracked.init("a", trackedOperand.firstElement()));
+    ASSERT_TRUE(zoneMap.mightSkipFor(&tracked));
+
+    EqualityMatchExpression untracked;
+    const BSONObj untrackedOperand = BSON("zzz" << 1);
+    ASSERT_OK(untracked.init("zzz", untrackedOperand.firstElement()));
+    ASSERT_FALSE(zoneMap.mightSkipFor(&untracked));
+
+    // Dotted paths never use the zone map; min/max were collected on top-level values only.
+    EqualityMatchExpression dotted;
+    const BSONObj dottedOperand = BSON("a.b" << 1);
+    ASSERT_OK(dotted.init("a.b", dottedOperand.firstElement()));
+    ASSERT_FALSE(zoneMap.mightSkipFor(&dotted));
+}
+
+}  // namespace
@@ -0,0 +1,68 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/field_name_interner.h"
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+FieldNameInterner::FieldNameId FieldNameInterner::intern(StringData name) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _ids.find(name);
+    if (it != _ids.end()) {
+        return it->second;
+    }
+    invariant(_names.size() < kNotInterned);
+    const FieldNameId id = static_cast<FieldNameId>(_names.size());
+    _names.push_back(name.toString());
+    // Key the map off the stable storage in _names, not the caller's buffer.
+    _ids[StringData(_names.back())] = id;
+    return id;
+}
+
+FieldNameInterner::FieldNameId FieldNameInterner::lookup(StringData name) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _ids.find(name);
+    return it == _ids.end() ? kNotInterned : it->second;
+}
+
+StringData FieldNameInterner::name(FieldNameId id) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    invariant(id < _names.size());
+    return StringData(_names[id]);
+}
+
+size_t FieldNameInterner::size() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _names.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Maps field names to stable 32-bit ids so hot paths (key generation, projection) can compare
+ * ids instead of re-comparing the same handful of strings on every document. One interner
+ * lives on each CollectionInfoCache; ids are only meaningful within their interner and are
+ * never reused for the life of the interner.
+ *
+ * Thread-safe. Interning is expected at plan/executor setup time; per-document code should
+ * hold on to the ids it needs rather than calling intern() per document.
+ */
+class FieldNameInterner {
+    MONGO_DISALLOW_COPYING(FieldNameInterner);
+
+public:
+    typedef uint32_t FieldNameId;
+
+    static const FieldNameId kNotInterned = std::numeric_limits<uint32_t>::max();
+
+    FieldNameInterner() = default;
+
+    /**
+     * Returns the id for 'name', assigning a new one if this is the first time it is seen.
+     */
+    FieldNameId intern(StringData name);
+
+    /**
+     * Returns the id previously assigned to 'name', or kNotInterned if it has never been
+     * interned. Never mutates the table, so concurrent readers only contend on the mutex.
+     */
+    FieldNameId lookup(StringData name) const;
+
+    /**
+     * Returns the name for a previously assigned id. The returned StringData remains valid
+     * for the life of the interner.
+     */
+    StringData name(FieldNameId id) const;
+
+    /**
+     * Number of distinct names interned so far.
+     */
+    size_t size() const;
+
+private:
+    mutable stdx::mutex _mutex;
+    StringMap<FieldNameId> _ids;
+    // Provides stable storage for the interned strings; deque never relocates elements.
+    std::deque<std::string> _names;
+};
+
+}  // namespace mongo
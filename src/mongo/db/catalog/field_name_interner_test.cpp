@@ -0,0 +1,62 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/field_name_interner.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+
+TEST(FieldNameInterner, InternIsIdempotent) {
+    FieldNameInterner interner;
+    auto a = interner.intern("a");
+    auto b = interner.intern("b");
+    ASSERT_NOT_EQUALS(a, b);
+    ASSERT_EQUALS(interner.intern("a"), a);
+    ASSERT_EQUALS(interner.intern("b"), b);
+    ASSERT_EQUALS(interner.size(), 2u);
+}
+
+TEST(FieldNameInterner, LookupDoesNotIntern) {
+    FieldNameInterner interner;
+    ASSERT_EQUALS(interner.lookup("missing"), FieldNameInterner::kNotInterned);
+    ASSERT_EQUALS(interner.size(), 0u);
+    auto id = interner.intern("present");
+    ASSERT_EQUALS(interner.lookup("present"), id);
+}
+
+TEST(FieldNameInterner, NameRoundTrip) {
+    FieldNameInterner interner;
+    auto id = interner.intern("some.dotted.path");
+    ASSERT_EQUALS(interner.name(id), "some.dotted.path");
+}
+
+}  // namespace
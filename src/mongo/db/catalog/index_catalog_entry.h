@@ -50,6 +50,7 @@ class HeadManager;
 class IndexAccessMethod;
 class IndexDescriptor;
 class MatchExpression;
+class MatchProgram;
 class OperationContext;
 
 class IndexCatalogEntry {
@@ -77,6 +78,8 @@ public:
 
         virtual const MatchExpression* getFilterExpression() const = 0;
 
+        virtual const MatchProgram* getFilterProgram() const = 0;
+
         virtual const CollatorInterface* getCollator() const = 0;
 
         virtual const RecordId& head(OperationContext* opCtx) const = 0;
@@ -161,6 +164,14 @@ public:
         return this->_impl().getFilterExpression();
     }
 
+    /**
+     * Returns the compiled form of the partial filter expression, or null if there is no filter
+     * or it uses features the program cannot evaluate. See MatchProgram.
+     */
+    inline const MatchProgram* getFilterProgram() const {
+        return this->_impl().getFilterProgram();
+    }
+
     inline const CollatorInterface* getCollator() const {
         return this->_impl().getCollator();
     }
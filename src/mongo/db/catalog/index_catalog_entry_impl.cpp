@@ -110,6 +110,8 @@ IndexCatalogEntryImpl::IndexCatalogEntryImpl(IndexCatalogEntry* const this_,
         stdx::lock_guard<stdx::mutex> lk(_indexMultikeyPathsMutex);
         _isMultikey.store(_catalogIsMultikey(opCtx, &_indexMultikeyPaths));
         _indexTracksPathLevelMultikeyInfo = !_indexMultikeyPaths.empty();
+        _multikeyPathBits = std::vector<AtomicWord<unsigned long long>>(_indexMultikeyPaths.size());
+        _recordMultikeyPathBits(_indexMultikeyPaths);
     }
 
     if (BSONElement collationElement = _descriptor->getInfoElement("collation")) {
@@ -132,6 +134,9 @@ IndexCatalogEntryImpl::IndexCatalogEntryImpl(IndexCatalogEntry* const this_,
         // this should be checked in create, so can blow up here
         invariantOK(statusWithMatcher.getStatus());
         _filterExpression = std::move(statusWithMatcher.getValue());
+        // Compile the filter once so the write path can evaluate simple filters without
+        // interpreting the expression tree per document.
+        _filterProgram = MatchProgram::compile(_filterExpression.get());
         LOG(2) << "have filter expression for " << _ns << " " << _descriptor->indexName() << " "
                << redact(filter);
     }
@@ -234,6 +239,13 @@ void IndexCatalogEntryImpl::setMultikey(OperationContext* opCtx,
         return;
     }
 
+    if (_indexTracksPathLevelMultikeyInfo && _multikeyPathBitsCover(multikeyPaths)) {
+        // Every path component is already known (and persisted) to be multikey. This is the
+        // steady state for an index over array-valued fields, so it is worth answering with a
+        // relaxed atomic load per indexed element rather than a mutex-protected set comparison.
+        return;
+    }
+
     if (_indexTracksPathLevelMultikeyInfo) {
         stdx::lock_guard<stdx::mutex> lk(_indexMultikeyPathsMutex);
         invariant(multikeyPaths.size() == _indexMultikeyPaths.size());
@@ -307,6 +319,40 @@ void IndexCatalogEntryImpl::setMultikey(OperationContext* opCtx,
         for (size_t i = 0; i < multikeyPaths.size(); ++i) {
             _indexMultikeyPaths[i].insert(multikeyPaths[i].begin(), multikeyPaths[i].end());
         }
+        // The catalog write above has committed, so these components may now be trusted by the
+        // lock-free check.
+        _recordMultikeyPathBits(multikeyPaths);
+    }
+}
+
+bool IndexCatalogEntryImpl::_multikeyPathBitsCover(const MultikeyPaths& multikeyPaths) const {
+    const size_t wordBits = sizeof(unsigned long long) * 8;
+    invariant(multikeyPaths.size() == _multikeyPathBits.size());
+    for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+        if (multikeyPaths[i].empty()) {
+            continue;
+        }
+        const unsigned long long knownBits = _multikeyPathBits[i].loadRelaxed();
+        for (size_t component : multikeyPaths[i]) {
+            if (component >= wordBits ||
+                !(knownBits & (1ULL << component))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void IndexCatalogEntryImpl::_recordMultikeyPathBits(const MultikeyPaths& multikeyPaths) {
+    const size_t wordBits = sizeof(unsigned long long) * 8;
+    for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+        unsigned long long bits = _multikeyPathBits[i].loadRelaxed();
+        for (size_t component : multikeyPaths[i]) {
+            if (component < wordBits) {
+                bits |= 1ULL << component;
+            }
+        }
+        _multikeyPathBits[i].store(bits);
     }
 }
 
@@ -35,6 +35,7 @@
 #include "mongo/bson/ordering.h"
 #include "mongo/db/catalog/index_catalog_entry.h"
 #include "mongo/db/index/multikey_paths.h"
+#include "mongo/db/matcher/match_program.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/snapshot_name.h"
@@ -94,6 +95,10 @@ public:
         return _filterExpression.get();
     }
 
+    const MatchProgram* getFilterProgram() const final {
+        return _filterProgram.get();
+    }
+
     const CollatorInterface* getCollator() const final {
         return _collator.get();
     }
@@ -175,6 +180,21 @@ private:
 
     KVPrefix _catalogGetPrefix(OperationContext* opCtx) const;
 
+    /**
+     * Returns true if every path component in 'multikeyPaths' is already recorded in
+     * '_multikeyPathBits'. Performs one relaxed atomic load per indexed element and never takes
+     * '_indexMultikeyPathsMutex'. Conservatively returns false for components beyond the word
+     * width, which are handled by the mutex-protected comparison instead.
+     */
+    bool _multikeyPathBitsCover(const MultikeyPaths& multikeyPaths) const;
+
+    /**
+     * Records the path components in 'multikeyPaths' in '_multikeyPathBits'. Must be called with
+     * '_indexMultikeyPathsMutex' held and only after the catalog write persisting those components
+     * has committed.
+     */
+    void _recordMultikeyPathBits(const MultikeyPaths& multikeyPaths);
+
     // -----
 
     std::string _ns;
@@ -192,6 +212,10 @@ private:
     std::unique_ptr<CollatorInterface> _collator;
     std::unique_ptr<MatchExpression> _filterExpression;
 
+    // Compiled form of '_filterExpression', if it is a conjunction of simple comparisons. Null
+    // whenever '_filterExpression' is null or uses features the program cannot evaluate.
+    std::unique_ptr<MatchProgram> _filterProgram;
+
     // cached stuff
 
     Ordering _ordering;  // TODO: this might be b-tree specific
@@ -220,6 +244,13 @@ private:
     // causes the index to be multikey.
     MultikeyPaths _indexMultikeyPaths;
 
+    // Lock-free mirror of '_indexMultikeyPaths'. One word per element in the index key pattern;
+    // bit i is set once path component i of that element is known (and persisted) to be multikey.
+    // Only set under '_indexMultikeyPathsMutex' and only after the corresponding catalog write has
+    // committed, so a set bit can be trusted without taking the mutex. Components beyond the word
+    // width are tracked solely by '_indexMultikeyPaths'.
+    std::vector<AtomicWord<unsigned long long>> _multikeyPathBits;
+
     // KVPrefix used to differentiate between index entries in different logical indexes sharing the
     // same underlying sorted data interface.
     const KVPrefix _prefix;
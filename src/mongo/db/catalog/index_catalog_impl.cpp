@@ -56,6 +56,7 @@
 #include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/db/matcher/match_program.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/delete.h"
 #include "mongo/db/query/collation/collation_spec.h"
@@ -63,6 +64,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
@@ -70,6 +72,11 @@
 #include "mongo/util/represent_as.h"
 
 namespace mongo {
+
+// When enabled, multi-document inserts apply their index keys per index in one sorted batch
+// instead of descending the index once per document.
+MONGO_EXPORT_SERVER_PARAMETER(batchedIndexKeyInsertsEnabled, bool, false);
+
 namespace {
 MONGO_INITIALIZER(InitializeIndexCatalogFactory)(InitializerContext* const) {
     IndexCatalog::registerFactory([](
@@ -1310,6 +1317,17 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, index->descriptor(), &options);
 
+    if (batchedIndexKeyInsertsEnabled.load() && bsonRecords.size() > 1) {
+        // Apply the whole batch's keys to this index in one sorted pass. The caller's
+        // WriteUnitOfWork provides atomicity, so a failure needs no per-document cleanup here.
+        int64_t inserted = 0;
+        Status status = index->accessMethod()->insert(opCtx, bsonRecords, options, &inserted);
+        if (keysInsertedOut) {
+            *keysInsertedOut += inserted;
+        }
+        return status;
+    }
+
     for (auto bsonRecord : bsonRecords) {
         int64_t inserted;
         invariant(bsonRecord.id != RecordId());
@@ -1333,9 +1351,23 @@ Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
     if (!filter)
         return _indexFilteredRecords(opCtx, index, bsonRecords, keysInsertedOut);
 
+    // Evaluate the compiled form of the filter where possible; it answers simple filters in a
+    // single pass over the document and defers to the expression tree otherwise.
+    const MatchProgram* filterProgram = index->getFilterProgram();
+
     std::vector<BsonRecord> filteredBsonRecords;
     for (auto bsonRecord : bsonRecords) {
-        if (filter->matchesBSON(*(bsonRecord.docPtr)))
+        bool matches;
+        boost::optional<bool> fastResult;
+        if (filterProgram) {
+            fastResult = filterProgram->tryMatch(*(bsonRecord.docPtr));
+        }
+        if (fastResult) {
+            matches = *fastResult;
+        } else {
+            matches = filter->matchesBSON(*(bsonRecord.docPtr));
+        }
+        if (matches)
             filteredBsonRecords.push_back(bsonRecord);
     }
 
@@ -143,6 +143,10 @@ MultiIndexBlockImpl::MultiIndexBlockImpl(OperationContext* opCtx, Collection* co
       _needToCleanup(true) {}
 
 MultiIndexBlockImpl::~MultiIndexBlockImpl() {
+    // An interrupt or scan failure may leave a batch of bulk insertions in flight; those
+    // workers only touch this object's bulk builders, so they must finish before cleanup.
+    _joinBatchWorkers().ignore();
+
     if (!_needToCleanup || _indexes.empty())
         return;
     while (true) {
@@ -293,6 +297,102 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlockImpl::init(const std::vector<BSO
     return indexInfoObjs;
 }
 
+namespace {
+
+// Bounds on the documents buffered per batch before they are handed to the bulk-insertion
+// workers. Batches are double-buffered: the scan fills the next one while workers drain the
+// previous one.
+const size_t kIndexBuildBatchMaxDocs = 1000;
+const size_t kIndexBuildBatchMaxBytes = 16 * 1024 * 1024;
+
+}  // namespace
+
+bool MultiIndexBlockImpl::_canBatchInserts() const {
+    // Bulk builders never touch storage at insert time (keys go to an external sorter), so
+    // their per-document work can run off the scanning thread. The non-bulk path writes to
+    // the index inside the caller's WriteUnitOfWork and must stay on-thread.
+    if (_indexes.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < _indexes.size(); i++) {
+        if (!_indexes[i].bulk) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status MultiIndexBlockImpl::_dispatchBatch(std::vector<BatchedDoc> batch) {
+    Status joinStatus = _joinBatchWorkers();
+    if (!joinStatus.isOK()) {
+        return joinStatus;
+    }
+    if (batch.empty()) {
+        return Status::OK();
+    }
+
+    _inFlightBatch = std::make_shared<const std::vector<BatchedDoc>>(std::move(batch));
+    _batchStatuses.assign(_indexes.size(), Status::OK());
+    _batchNextIndex.store(0);
+
+    size_t numWorkers = stdx::thread::hardware_concurrency();
+    if (numWorkers == 0 || numWorkers > _indexes.size()) {
+        numWorkers = _indexes.size();
+    }
+
+    for (size_t w = 0; w < numWorkers; w++) {
+        _batchWorkers.emplace_back([this] {
+            const std::vector<BatchedDoc>& docs = *_inFlightBatch;
+            size_t i;
+            while ((i = _batchNextIndex.fetchAndAdd(1)) < _indexes.size()) {
+                IndexToBuild& index = _indexes[i];
+                try {
+                    for (size_t d = 0; d < docs.size(); d++) {
+                        if (index.filterExpression &&
+                            !index.filterExpression->matchesBSON(docs[d].doc)) {
+                            continue;
+                        }
+                        int64_t unused;
+                        // BulkBuilder::insert is storage-free and never dereferences the
+                        // OperationContext; this thread deliberately has none.
+                        Status status = index.bulk->insert(
+                            nullptr, docs[d].doc, docs[d].loc, index.options, &unused);
+                        if (!status.isOK()) {
+                            _batchStatuses[i] = std::move(status);
+                            break;
+                        }
+                    }
+                } catch (const DBException& e) {
+                    // Key generation errors surface as exceptions in kEnforceConstraints
+                    // mode; report them as this index's failure rather than crossing thread
+                    // boundaries.
+                    _batchStatuses[i] = e.toStatus();
+                }
+            }
+        });
+    }
+
+    return Status::OK();
+}
+
+Status MultiIndexBlockImpl::_joinBatchWorkers() {
+    for (size_t i = 0; i < _batchWorkers.size(); i++) {
+        _batchWorkers[i].join();
+    }
+    _batchWorkers.clear();
+    _inFlightBatch.reset();
+
+    for (size_t i = 0; i < _batchStatuses.size(); i++) {
+        if (!_batchStatuses[i].isOK()) {
+            Status first = _batchStatuses[i];
+            _batchStatuses.clear();
+            return first;
+        }
+    }
+    _batchStatuses.clear();
+    return Status::OK();
+}
+
 Status MultiIndexBlockImpl::insertAllDocumentsInCollection(std::set<RecordId>* dupsOut) {
     const char* curopMessage = _buildInBackground ? "Index Build (background)" : "Index Build";
     const auto numRecords = _collection->numRecords(_opCtx);
@@ -315,6 +415,16 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection(std::set<RecordId>* d
     auto exec =
         InternalPlanner::collectionScan(_opCtx, _collection->ns().ns(), _collection, yieldPolicy);
 
+    // When all indexes build through bulk builders, documents are batched and their key
+    // generation plus sorter insertion runs on worker threads while this thread keeps
+    // scanning (concurrent scan and sort).
+    const bool batchInserts = _canBatchInserts();
+    std::vector<BatchedDoc> batch;
+    size_t batchBytes = 0;
+    if (batchInserts) {
+        batch.reserve(kIndexBuildBatchMaxDocs);
+    }
+
     Snapshotted<BSONObj> objToIndex;
     RecordId loc;
     PlanExecutor::ExecState state;
@@ -336,22 +446,39 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection(std::set<RecordId>* d
             // Done before insert so we can retry document if it WCEs.
             progress->setTotalWhileRunning(_collection->numRecords(_opCtx));
 
-            WriteUnitOfWork wunit(_opCtx);
-            Status ret = insert(objToIndex.value(), loc);
-            if (_buildInBackground)
-                exec->saveState();
-            if (ret.isOK()) {
-                wunit.commit();
-            } else if (dupsOut && ret.code() == ErrorCodes::DuplicateKey) {
-                // If dupsOut is non-null, we should only fail the specific insert that
-                // led to a DuplicateKey rather than the whole index build.
-                dupsOut->insert(loc);
+            if (batchInserts) {
+                // No WriteUnitOfWork: bulk insertion writes nothing to storage. The document
+                // is copied out since the batch outlives this snapshot's record memory.
+                batch.push_back({objToIndex.value().getOwned(), loc});
+                batchBytes += batch.back().doc.objsize();
+                if (batch.size() >= kIndexBuildBatchMaxDocs ||
+                    batchBytes >= kIndexBuildBatchMaxBytes) {
+                    Status ret = _dispatchBatch(std::move(batch));
+                    if (!ret.isOK()) {
+                        return ret;
+                    }
+                    batch = std::vector<BatchedDoc>();
+                    batch.reserve(kIndexBuildBatchMaxDocs);
+                    batchBytes = 0;
+                }
             } else {
-                // Fail the index build hard.
-                return ret;
+                WriteUnitOfWork wunit(_opCtx);
+                Status ret = insert(objToIndex.value(), loc);
+                if (_buildInBackground)
+                    exec->saveState();
+                if (ret.isOK()) {
+                    wunit.commit();
+                } else if (dupsOut && ret.code() == ErrorCodes::DuplicateKey) {
+                    // If dupsOut is non-null, we should only fail the specific insert that
+                    // led to a DuplicateKey rather than the whole index build.
+                    dupsOut->insert(loc);
+                } else {
+                    // Fail the index build hard.
+                    return ret;
+                }
+                if (_buildInBackground)
+                    exec->restoreState();  // Handles any WCEs internally.
             }
-            if (_buildInBackground)
-                exec->restoreState();  // Handles any WCEs internally.
 
             // Go to the next document
             progress->hit();
@@ -370,6 +497,18 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection(std::set<RecordId>* d
         }
     }
 
+    if (batchInserts) {
+        // Flush the tail batch and wait for all in-flight bulk insertions before reporting
+        // the scan result; the sorters must be complete (or the error known) either way.
+        Status flushStatus = _dispatchBatch(std::move(batch));
+        if (flushStatus.isOK()) {
+            flushStatus = _joinBatchWorkers();
+        }
+        if (!flushStatus.isOK()) {
+            return flushStatus;
+        }
+    }
+
     uassert(28550,
             "Unable to complete index build due to collection scan failure: " +
                 WorkingSetCommon::toStatusString(objToIndex.value()),
@@ -41,6 +41,8 @@
 #include "mongo/db/catalog/index_catalog_impl.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/record_id.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 
@@ -204,6 +206,38 @@ private:
 
     std::vector<IndexToBuild> _indexes;
 
+    /**
+     * One owned document plus its location, queued for off-thread bulk insertion.
+     */
+    struct BatchedDoc {
+        BSONObj doc;
+        RecordId loc;
+    };
+
+    /**
+     * True when every index in this build uses a bulk builder, i.e. the per-document work is
+     * CPU-only key generation and sorter insertion that may safely run off the scanning
+     * thread.
+     */
+    bool _canBatchInserts() const;
+
+    /**
+     * Hands 'batch' to worker threads that run key generation and sorter insertion, one index
+     * per worker at a time. Joins the previous batch's workers first, so at most one batch is
+     * in flight; the scanning thread keeps pulling documents meanwhile.
+     */
+    Status _dispatchBatch(std::vector<BatchedDoc> batch);
+
+    /**
+     * Joins any in-flight batch workers and returns the first failure among them.
+     */
+    Status _joinBatchWorkers();
+
+    std::vector<stdx::thread> _batchWorkers;
+    std::vector<Status> _batchStatuses;
+    std::shared_ptr<const std::vector<BatchedDoc>> _inFlightBatch;
+    AtomicUInt32 _batchNextIndex{0};
+
     std::unique_ptr<BackgroundOperation> _backgroundOperation;
 
     // Pointers not owned here and must outlive 'this'
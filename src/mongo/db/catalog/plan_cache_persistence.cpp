@@ -0,0 +1,249 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/plan_cache_persistence.h"
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <fstream>
+#include <limits.h>
+#include <vector>
+
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/query_request.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace plan_cache_persistence {
+namespace {
+
+// Name of the dump file, relative to the dbpath. Each document in the file is
+// {ns: <string>, ...<serialized entry fields>}, concatenated mongodump-style.
+const char kDumpFilename[] = "plan_cache_dump.bson";
+
+boost::filesystem::path dumpFilePath() {
+    return boost::filesystem::path(storageGlobalParams.dbpath) / kDumpFilename;
+}
+
+// Protects the in-memory copy of the dump below.
+stdx::mutex dumpMutex;
+
+// True once the dump file has been read (or found absent). The file is consumed and deleted
+// on first access, so a stale dump never survives past the restart that read it.
+bool dumpConsumed = false;
+
+// Entries read from the dump file, keyed by namespace. Handed out (and erased) as each
+// collection's info cache initializes.
+stdx::unordered_map<std::string, std::vector<BSONObj>> dumpedEntries;
+
+/**
+ * Reads the dump file into 'dumpedEntries' and deletes it. Caller must hold 'dumpMutex'.
+ */
+void ensureDumpConsumed() {
+    if (dumpConsumed) {
+        return;
+    }
+    dumpConsumed = true;
+
+    const boost::filesystem::path path = dumpFilePath();
+    if (!boost::filesystem::exists(path)) {
+        return;
+    }
+
+    const auto fileSize = boost::filesystem::file_size(path);
+    std::vector<char> buffer(static_cast<size_t>(fileSize));
+    {
+        std::ifstream ifs(path.c_str(), std::ios_base::in | std::ios_base::binary);
+        if (!ifs || !ifs.read(buffer.data(), buffer.size())) {
+            warning() << "failed to read plan cache dump file " << path.string();
+            return;
+        }
+    }
+    boost::filesystem::remove(path);
+
+    size_t offset = 0;
+    size_t numEntries = 0;
+    while (offset + 4 <= buffer.size()) {
+        const int objSize = ConstDataView(buffer.data() + offset).read<LittleEndian<int>>();
+        if (objSize < BSONObj::kMinBSONLength ||
+            offset + static_cast<size_t>(objSize) > buffer.size()) {
+            warning() << "plan cache dump file " << path.string()
+                      << " is truncated or corrupt; ignoring the remainder";
+            break;
+        }
+        BSONObj doc(buffer.data() + offset);
+        offset += objSize;
+
+        BSONElement nsElt = doc["ns"];
+        if (nsElt.type() != String) {
+            continue;
+        }
+        dumpedEntries[nsElt.String()].push_back(doc.getOwned());
+        ++numEntries;
+    }
+
+    log() << "read " << numEntries << " plan cache entries for " << dumpedEntries.size()
+          << " collections from shutdown dump";
+}
+
+}  // namespace
+
+void dumpAllPlanCaches(OperationContext* opCtx) try {
+    StorageEngine* storageEngine = getGlobalServiceContext()->getGlobalStorageEngine();
+    if (!storageEngine) {
+        return;
+    }
+
+    Lock::GlobalLock globalLock(opCtx, MODE_IS, UINT_MAX);
+
+    std::vector<std::string> dbNames;
+    storageEngine->listDatabases(&dbNames);
+
+    BufBuilder buffer;
+    size_t numEntries = 0;
+    for (const std::string& dbName : dbNames) {
+        Lock::DBLock dbLock(opCtx, dbName, MODE_IS);
+        Database* db = dbHolder().get(opCtx, dbName);
+        if (!db) {
+            // The database was never opened, so nothing is cached for its collections.
+            continue;
+        }
+        for (Collection* coll : *db) {
+            for (const BSONObj& entry : coll->infoCache()->getPlanCache()->serializeEntries()) {
+                BSONObjBuilder bob;
+                bob.append("ns", coll->ns().ns());
+                bob.appendElements(entry);
+                const BSONObj doc = bob.obj();
+                buffer.appendBuf(doc.objdata(), doc.objsize());
+                ++numEntries;
+            }
+        }
+    }
+
+    if (0 == numEntries) {
+        return;
+    }
+
+    // Write to a temporary file and rename into place so a crash mid-write never leaves a
+    // half-written dump for the next startup to trip over.
+    const boost::filesystem::path path = dumpFilePath();
+    const boost::filesystem::path tempPath = path.string() + ".tmp";
+    {
+        std::ofstream ofs(tempPath.c_str(), std::ios_base::out | std::ios_base::binary);
+        if (!ofs || !ofs.write(buffer.buf(), buffer.len())) {
+            warning() << "failed to write plan cache dump file " << tempPath.string();
+            return;
+        }
+    }
+    boost::filesystem::rename(tempPath, path);
+
+    log() << "shutdown: wrote " << numEntries << " plan cache entries to " << path.string();
+} catch (const std::exception& ex) {
+    // The dump is purely an optimization; never let it interfere with shutdown.
+    warning() << "failed to dump plan caches: " << ex.what();
+}
+
+void loadPlanCache(OperationContext* opCtx,
+                   const NamespaceString& nss,
+                   const std::vector<IndexEntry>& indexEntries,
+                   PlanCache* planCache) {
+    std::vector<BSONObj> entries;
+    {
+        stdx::lock_guard<stdx::mutex> lk(dumpMutex);
+        ensureDumpConsumed();
+        auto it = dumpedEntries.find(nss.ns());
+        if (it == dumpedEntries.end()) {
+            return;
+        }
+        entries = std::move(it->second);
+        dumpedEntries.erase(it);
+    }
+
+    size_t numLoaded = 0;
+    for (const BSONObj& serialized : entries) {
+        auto qr = stdx::make_unique<QueryRequest>(nss);
+        if (serialized["query"].isABSONObj()) {
+            qr->setFilter(serialized["query"].Obj());
+        }
+        if (serialized["sort"].isABSONObj()) {
+            qr->setSort(serialized["sort"].Obj());
+        }
+        if (serialized["projection"].isABSONObj()) {
+            qr->setProj(serialized["projection"].Obj());
+        }
+        if (serialized["collation"].isABSONObj()) {
+            qr->setCollation(serialized["collation"].Obj());
+        }
+
+        // Noop extensions parse $text/$where into stand-ins with the same MatchType, so the
+        // computed cache key matches what the real parse of the same query would produce.
+        auto statusWithCQ =
+            CanonicalQuery::canonicalize(opCtx, std::move(qr), ExtensionsCallbackNoop());
+        if (!statusWithCQ.isOK()) {
+            LOG(1) << nss.ns() << ": skipping dumped plan cache entry: "
+                   << redact(statusWithCQ.getStatus());
+            continue;
+        }
+
+        const PlanCacheKey key = planCache->computeKey(*statusWithCQ.getValue());
+        Status status = planCache->loadSerializedEntry(key, serialized, indexEntries);
+        if (!status.isOK()) {
+            LOG(1) << nss.ns() << ": skipping dumped plan cache entry: " << redact(status);
+            continue;
+        }
+        ++numLoaded;
+    }
+
+    if (numLoaded > 0) {
+        LOG(1) << nss.ns() << ": restored " << numLoaded
+               << " plan cache entries from shutdown dump";
+    }
+}
+
+}  // namespace plan_cache_persistence
+}  // namespace mongo
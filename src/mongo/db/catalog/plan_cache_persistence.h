@@ -0,0 +1,65 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+namespace mongo {
+
+class NamespaceString;
+class OperationContext;
+class PlanCache;
+struct IndexEntry;
+
+namespace plan_cache_persistence {
+
+/**
+ * Serializes every open collection's plan cache into a single dump file under the dbpath.
+ * Called once on clean shutdown so that plan selection survives a restart without re-running
+ * multi-planning for every query shape. The dump is purely an optimization: any error is
+ * logged and swallowed.
+ */
+void dumpAllPlanCaches(OperationContext* opCtx);
+
+/**
+ * Loads the entries dumped for 'nss', if any, into 'planCache', resolving index assignments
+ * by name against 'indexEntries'. Called from CollectionInfoCacheImpl::init() while the
+ * collection lock is held in exclusive mode.
+ *
+ * The dump file is read into memory once per process and deleted immediately, so a stale
+ * dump never survives past the restart that consumed it. Entries that fail to canonicalize
+ * or that reference dropped indexes are skipped.
+ */
+void loadPlanCache(OperationContext* opCtx,
+                   const NamespaceString& nss,
+                   const std::vector<IndexEntry>& indexEntries,
+                   PlanCache* planCache);
+
+}  // namespace plan_cache_persistence
+}  // namespace mongo
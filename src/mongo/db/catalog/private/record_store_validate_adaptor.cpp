@@ -39,13 +39,19 @@
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/rpc/object_check.h"
 #include "mongo/util/log.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+// Caps the total bytes per second that validation reads through its record and index scans so
+// that it can run against nodes serving production traffic. Zero (the default) is unthrottled.
+MONGO_EXPORT_SERVER_PARAMETER(maxValidateMBperSec, int, 0);
+
 namespace {
 uint32_t hashIndexEntry(KeyString& ks, uint32_t hash) {
     MurmurHash3_x86_32(ks.getTypeBits().getBuffer(), ks.getTypeBits().getSize(), hash, &hash);
@@ -54,10 +60,34 @@ uint32_t hashIndexEntry(KeyString& ks, uint32_t hash) {
 }
 }
 
+void RecordStoreValidateAdaptor::_throttle(int64_t bytes) {
+    const int mbPerSec = maxValidateMBperSec.load();
+    if (mbPerSec <= 0) {
+        return;
+    }
+
+    const double bytesPerSec = static_cast<double>(mbPerSec) * 1024 * 1024;
+    int64_t sleepMillis = 0;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_throttleMutex);
+        _throttleBytes += bytes;
+        const double budget = bytesPerSec * _throttleTimer.micros() / (1000 * 1000);
+        if (_throttleBytes > budget) {
+            sleepMillis = static_cast<int64_t>((_throttleBytes - budget) / bytesPerSec * 1000);
+        }
+    }
+    // Sleep off the excess outside the mutex; other validation threads overshooting slightly in
+    // the meantime is fine.
+    if (sleepMillis > 0) {
+        sleepmillis(sleepMillis);
+    }
+}
+
 Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
                                             const RecordData& record,
                                             size_t* dataSize) {
     BSONObj recordBson = record.toBson();
+    _throttle(record.size());
 
     const Status status = validateBSON(
         recordBson.objdata(), recordBson.objsize(), Validator<BSONObj>::enabledBSONVersion());
@@ -121,8 +151,9 @@ Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
             KeyString ks(KeyString::kLatestVersion, key, ord, recordId);
             uint32_t indexEntryHash = hashIndexEntry(ks, indexNsHash);
 
+            scoped_spinlock lk(_ikcStripes[indexEntryHash % kIndexKeyCountStripes]);
             if ((*_ikc)[indexEntryHash] == 0) {
-                _indexKeyCountTableNumEntries++;
+                _indexKeyCountTableNumEntries.fetchAndAdd(1);
             }
             (*_ikc)[indexEntryHash]++;
         }
@@ -131,7 +162,8 @@ Status RecordStoreValidateAdaptor::validate(const RecordId& recordId,
     return status;
 }
 
-void RecordStoreValidateAdaptor::traverseIndex(const IndexAccessMethod* iam,
+void RecordStoreValidateAdaptor::traverseIndex(OperationContext* opCtx,
+                                               const IndexAccessMethod* iam,
                                                const IndexDescriptor* descriptor,
                                                ValidateResults* results,
                                                int64_t* numTraversedKeys) {
@@ -147,7 +179,7 @@ void RecordStoreValidateAdaptor::traverseIndex(const IndexAccessMethod* iam,
     std::unique_ptr<KeyString> prevIndexKeyString = nullptr;
     bool isFirstEntry = true;
 
-    std::unique_ptr<SortedDataInterface::Cursor> cursor = iam->newCursor(_opCtx, true);
+    std::unique_ptr<SortedDataInterface::Cursor> cursor = iam->newCursor(opCtx, true);
     // Seeking to BSONObj() is equivalent to seeking to the first entry of an index.
     for (auto indexEntry = cursor->seek(BSONObj(), true); indexEntry; indexEntry = cursor->next()) {
 
@@ -164,26 +196,35 @@ void RecordStoreValidateAdaptor::traverseIndex(const IndexAccessMethod* iam,
             results->valid = false;
         }
 
-        // Cache the index keys to cross-validate with documents later.
+        // Cache the index keys to cross-validate with documents later. Several indexes may be
+        // traversed concurrently; the table entry's stripe makes the decrement atomic with
+        // respect to theirs.
         uint32_t keyHash = hashIndexEntry(*indexKeyString, indexNsHash);
-        uint64_t& indexEntryCount = (*_ikc)[keyHash];
-        if (indexEntryCount != 0) {
-            indexEntryCount--;
-            dassert(indexEntryCount >= 0);
-            if (indexEntryCount == 0) {
-                _indexKeyCountTableNumEntries--;
+        {
+            scoped_spinlock lk(_ikcStripes[keyHash % kIndexKeyCountStripes]);
+            uint64_t& indexEntryCount = (*_ikc)[keyHash];
+            if (indexEntryCount != 0) {
+                indexEntryCount--;
+                dassert(indexEntryCount >= 0);
+                if (indexEntryCount == 0) {
+                    _indexKeyCountTableNumEntries.fetchAndSubtract(1);
+                }
+            } else {
+                _hasDocWithoutIndexEntry.store(true);
+                results->valid = false;
             }
-        } else {
-            _hasDocWithoutIndexEntry = true;
-            results->valid = false;
         }
         numKeys++;
+        _throttle(indexKeyString->getSize());
 
         isFirstEntry = false;
         prevIndexKeyString.swap(indexKeyString);
     }
 
-    _keyCounts[indexNs] = numKeys;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_countsMutex);
+        _keyCounts[indexNs] = numKeys;
+    }
     *numTraversedKeys = numKeys;
 }
 
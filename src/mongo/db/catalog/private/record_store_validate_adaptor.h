@@ -33,6 +33,10 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -68,9 +72,11 @@ public:
 
     /**
      * Traverses the index getting index entriess to validate them and keep track of the index keys
-     * for index consistency.
+     * for index consistency. Safe to call from several threads at once, one index per thread,
+     * provided each thread passes its own 'opCtx'.
      */
-    void traverseIndex(const IndexAccessMethod* iam,
+    void traverseIndex(OperationContext* opCtx,
+                       const IndexAccessMethod* iam,
                        const IndexDescriptor* descriptor,
                        ValidateResults* results,
                        int64_t* numTraversedKeys);
@@ -93,7 +99,7 @@ public:
      * Returns true if there are too many index entries, otherwise return false.
      */
     bool tooManyIndexEntries() const {
-        return _indexKeyCountTableNumEntries != 0;
+        return _indexKeyCountTableNumEntries.load() != 0;
     }
 
     /**
@@ -101,17 +107,36 @@ public:
      * and index entry, otherwise return false.
      */
     bool tooFewIndexEntries() const {
-        return _hasDocWithoutIndexEntry;
+        return _hasDocWithoutIndexEntry.load();
     }
 
 
 private:
+    /**
+     * When maxValidateMBperSec is set, accounts 'bytes' of work against the shared rate budget
+     * and sleeps off any excess so that all validation threads together stay under the cap.
+     */
+    void _throttle(int64_t bytes);
+
     std::map<std::string, int64_t> _longKeys;
     std::map<std::string, int64_t> _keyCounts;
+    // Guards _longKeys and _keyCounts against concurrent index traversal threads.
+    stdx::mutex _countsMutex;
     std::unique_ptr<IndexKeyCountTable> _ikc;
 
-    uint32_t _indexKeyCountTableNumEntries = 0;
-    bool _hasDocWithoutIndexEntry = false;
+    // The key count table is shared by the record store scan (which increments) and the index
+    // traversals (which decrement, possibly from several threads); each entry is guarded by the
+    // stripe its hash maps to.
+    enum { kIndexKeyCountStripes = 64 };
+    SpinLock _ikcStripes[kIndexKeyCountStripes];
+
+    AtomicUInt32 _indexKeyCountTableNumEntries;
+    AtomicBool _hasDocWithoutIndexEntry;
+
+    // Shared token-bucket state for _throttle().
+    stdx::mutex _throttleMutex;
+    Timer _throttleTimer;
+    int64_t _throttleBytes = 0;
 
     const int IndexKeyMaxSize = 1024;  // this goes away with SERVER-3372
 
@@ -46,6 +46,7 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/query/explain.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_parameters.h"
@@ -91,6 +92,7 @@ ClientCursor::ClientCursor(ClientCursorParams params,
       _originatingCommand(params.originatingCommandObj),
       _queryOptions(params.queryOptions),
       _exec(std::move(params.exec)),
+      _planSummary(Explain::getPlanSummary(_exec.get())),
       _lastUseDate(now) {
     invariant(_cursorManager);
     invariant(_exec);
@@ -141,6 +141,14 @@ public:
         return _exec.get();
     }
 
+    /**
+     * Returns a summary string of the cursor's query plan. The plan never changes over the
+     * cursor's lifetime, so this is computed once at construction rather than on every getMore.
+     */
+    const std::string& getPlanSummary() const {
+        return _planSummary;
+    }
+
     /**
      * Returns the query options bitmask.  If you'd like to know if the cursor is tailable or
      * awaitData, prefer using the specific methods isTailable() and isAwaitData() over using this
@@ -321,6 +329,10 @@ private:
     // The underlying query execution machinery. Must be non-null.
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> _exec;
 
+    // A summary of the cursor's query plan, cached at construction so that each getMore does not
+    // have to walk the execution tree to recompute it.
+    std::string _planSummary;
+
     //
     // The following fields are used by the CursorManager and the ClientCursorPin. In most
     // conditions, they can only be used while holding the CursorManager's mutex. Exceptions
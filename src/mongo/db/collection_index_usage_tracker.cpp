@@ -31,6 +31,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/collection_index_usage_tracker.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/clock_source.h"
 #include "mongo/util/log.h"
@@ -44,9 +45,18 @@ CollectionIndexUsageTracker::CollectionIndexUsageTracker(ClockSource* clockSourc
 
 void CollectionIndexUsageTracker::recordIndexAccess(StringData indexName) {
     invariant(!indexName.empty());
-    dassert(_indexUsageMap.find(indexName) != _indexUsageMap.end());
+    auto it = _indexUsageMap.find(indexName);
+    dassert(it != _indexUsageMap.end());
+    if (it == _indexUsageMap.end()) {
+        return;
+    }
 
-    _indexUsageMap[indexName].accesses.fetchAndAdd(1);
+    // Each thread consistently hashes to the same stripe, so under steady load every core bumps
+    // its own cache line.
+    static const std::hash<stdx::thread::id> hasher{};
+    const size_t stripe =
+        hasher(stdx::this_thread::get_id()) % StripedAccessCounters::kNumStripes;
+    it->second.counters->stripes[stripe].accesses.fetchAndAdd(1);
 }
 
 void CollectionIndexUsageTracker::registerIndex(StringData indexName, const BSONObj& indexKey) {
@@ -54,7 +64,7 @@ void CollectionIndexUsageTracker::registerIndex(StringData indexName, const BSON
     dassert(_indexUsageMap.find(indexName) == _indexUsageMap.end());
 
     // Create map entry.
-    _indexUsageMap[indexName] = IndexUsageStats(_clockSource->now(), indexKey);
+    _indexUsageMap[indexName] = UsageEntry(_clockSource->now(), indexKey);
 }
 
 void CollectionIndexUsageTracker::unregisterIndex(StringData indexName) {
@@ -64,7 +74,13 @@ void CollectionIndexUsageTracker::unregisterIndex(StringData indexName) {
 }
 
 CollectionIndexUsageMap CollectionIndexUsageTracker::getUsageStats() const {
-    return _indexUsageMap;
+    CollectionIndexUsageMap snapshot;
+    for (auto&& entry : _indexUsageMap) {
+        IndexUsageStats stats(entry.second.trackerStartTime, entry.second.indexKey);
+        stats.accesses.store(entry.second.counters->sum());
+        snapshot[entry.first] = stats;
+    }
+    return snapshot;
 }
 
 }  // namespace mongo
@@ -28,10 +28,13 @@
 
 #pragma once
 
+#include <memory>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/string_map.h"
 #include "mongo/util/time_support.h"
 
@@ -105,14 +108,59 @@ public:
     void unregisterIndex(StringData indexName);
 
     /**
-     * Get the current state of the usage statistics map. This map will only include indexes that
-     * exist at the time of calling. Must be called while holding the collection lock in any mode.
+     * Get the current state of the usage statistics map, with each index's striped counters
+     * summed into its 'accesses' value. This map will only include indexes that exist at the
+     * time of calling. Must be called while holding the collection lock in any mode.
      */
     StringMap<CollectionIndexUsageTracker::IndexUsageStats> getUsageStats() const;
 
 private:
+    /**
+     * Per-index access counters, striped so that threads on different cores increment different
+     * cache lines. The stripes are summed when usage statistics are read ($indexStats), which is
+     * rare compared to the per-operation increments.
+     */
+    struct StripedAccessCounters {
+        enum { kNumStripes = 8 };
+
+        // Padding keeps neighboring stripes from sharing a cache line; best effort, matching the
+        // per-partition lock statistics.
+        struct PaddedCounter {
+            AtomicInt64 accesses;
+            char padding[stdx::hardware_destructive_interference_size - sizeof(AtomicInt64)];
+        };
+
+        PaddedCounter stripes[kNumStripes];
+
+        long long sum() const {
+            long long total = 0;
+            for (size_t i = 0; i < kNumStripes; ++i) {
+                total += stripes[i].accesses.load();
+            }
+            return total;
+        }
+    };
+
+    // Internal per-index entry. The counters live behind a shared_ptr because they contain
+    // atomics and the map's values must remain copyable.
+    struct UsageEntry {
+        UsageEntry() = default;
+        UsageEntry(Date_t now, const BSONObj& key)
+            : trackerStartTime(now),
+              indexKey(key.getOwned()),
+              counters(std::make_shared<StripedAccessCounters>()) {}
+
+        // Date/Time that we started tracking index usage.
+        Date_t trackerStartTime;
+
+        // An owned copy of the associated IndexDescriptor's index key.
+        BSONObj indexKey;
+
+        std::shared_ptr<StripedAccessCounters> counters;
+    };
+
     // Map from index name to usage statistics.
-    StringMap<CollectionIndexUsageTracker::IndexUsageStats> _indexUsageMap;
+    StringMap<UsageEntry> _indexUsageMap;
 
     // Clock source. Used when the 'trackerStartTime' time for an IndexUsageStats object needs to
     // be set.
@@ -32,7 +32,9 @@
 
 #include "mongo/db/commands.h"
 
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "mongo/bson/mutable/document.h"
@@ -202,7 +204,59 @@ BSONObj Command::runCommandDirectly(OperationContext* opCtx, const OpMsgRequest&
     return out.obj();
 }
 
+namespace {
+
+/**
+ * Flat dispatch table built from the registered commands on first lookup. Command names
+ * are short and the command set is fixed once startup completes, so a lookup indexes a
+ * bucket by name length and binary-searches the handful of names of that length - no
+ * hashing of the name bytes on the per-operation path. Commands registered after the
+ * table is built (rare - almost all register during static initialization) are still
+ * found through the StringMap fallback in findCommand.
+ */
+class CommandDispatchTable {
+public:
+    explicit CommandDispatchTable(const Command::CommandMap& commands) {
+        size_t maxLen = 0;
+        for (const auto& entry : commands) {
+            maxLen = std::max(maxLen, entry.first.size());
+        }
+        _byLength.resize(maxLen + 1);
+        for (const auto& entry : commands) {
+            _byLength[entry.first.size()].emplace_back(entry.first, entry.second);
+        }
+        for (auto& bucket : _byLength) {
+            std::sort(bucket.begin(), bucket.end());
+        }
+    }
+
+    Command* find(StringData name) const {
+        if (name.size() >= _byLength.size())
+            return nullptr;
+        const auto& bucket = _byLength[name.size()];
+        auto it = std::lower_bound(
+            bucket.begin(),
+            bucket.end(),
+            name,
+            [](const std::pair<std::string, Command*>& entry, StringData name) {
+                return StringData(entry.first) < name;
+            });
+        if (it == bucket.end() || StringData(it->first) != name)
+            return nullptr;
+        return it->second;
+    }
+
+private:
+    std::vector<std::vector<std::pair<std::string, Command*>>> _byLength;
+};
+
+}  // namespace
+
 Command* Command::findCommand(StringData name) {
+    static const CommandDispatchTable dispatchTable(*_commands);
+    if (Command* command = dispatchTable.find(name))
+        return command;
+    // Fall back to the registration map for commands registered after the table was built.
     CommandMap::const_iterator i = _commands->find(name);
     if (i == _commands->end())
         return 0;
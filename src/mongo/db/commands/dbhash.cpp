@@ -36,6 +36,7 @@
 #include <string>
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_multiset_hash.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
 #include "mongo/db/commands.h"
@@ -92,6 +93,13 @@ public:
             }
         }
 
+        // With {incremental: true}, non-capped collections are hashed from their incrementally
+        // maintained multiset hash instead of being rescanned. The first incremental dbHash of
+        // a collection seeds the hash with one scan; subsequent ones are O(1). The reported
+        // hash strings differ from the scan-based ones, so all nodes being compared must use
+        // the same mode.
+        const bool incremental = cmdObj["incremental"].trueValue();
+
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
                 str::stream() << "Invalid db name: " << ns,
@@ -147,7 +155,7 @@ public:
                 continue;
 
             // Compute the hash for this collection.
-            std::string hash = _hashCollection(opCtx, db, collNss.toString());
+            std::string hash = _hashCollection(opCtx, db, collNss.toString(), incremental);
 
             bb.append(collNss.coll(), hash);
             md5_append(&globalState, (const md5_byte_t*)hash.c_str(), hash.size());
@@ -167,7 +175,8 @@ public:
 private:
     std::string _hashCollection(OperationContext* opCtx,
                                 Database* db,
-                                const std::string& fullCollectionName) {
+                                const std::string& fullCollectionName,
+                                bool incremental) {
 
         NamespaceString ns(fullCollectionName);
 
@@ -175,6 +184,13 @@ private:
         if (!collection)
             return "";
 
+        // Capped collections cannot maintain an incremental hash (their record stores delete
+        // old documents internally), so they always take the scan path below, which is
+        // equally deterministic across nodes.
+        if (incremental && !collection->isCapped()) {
+            return _incrementalHashCollection(opCtx, collection, fullCollectionName);
+        }
+
         IndexDescriptor* desc = collection->getIndexCatalog()->findIdIndex(opCtx);
 
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
@@ -220,6 +236,48 @@ private:
         return hash;
     }
 
+    std::string _incrementalHashCollection(OperationContext* opCtx,
+                                           Collection* collection,
+                                           const std::string& fullCollectionName) {
+        CollectionMultisetHash* multisetHash = collection->infoCache()->getMultisetHash();
+
+        uint64_t lanes[2];
+        long long count;
+        if (multisetHash->get(lanes, &count)) {
+            return CollectionMultisetHash::format(lanes, count);
+        }
+
+        // First incremental dbHash of this collection (or first since it was closed or
+        // truncated): seed the hash with one scan. The database S lock held by the command
+        // guarantees that no write can commit between the scan and activate().
+        lanes[0] = 0;
+        lanes[1] = 0;
+        count = 0;
+
+        auto exec = InternalPlanner::collectionScan(
+            opCtx, fullCollectionName, collection, PlanExecutor::NO_YIELD);
+
+        PlanExecutor::ExecState state;
+        BSONObj c;
+        while (PlanExecutor::ADVANCED == (state = exec->getNext(&c, NULL))) {
+            uint64_t h[2];
+            CollectionMultisetHash::hashDocument(c, h);
+            lanes[0] += h[0];
+            lanes[1] += h[1];
+            count++;
+        }
+        if (PlanExecutor::IS_EOF != state) {
+            warning() << "error while seeding incremental hash, db dropped? ns="
+                      << fullCollectionName;
+            uasserted(50342,
+                      "Plan executor error while running dbHash command: " +
+                          WorkingSetCommon::toStatusString(c));
+        }
+
+        multisetHash->activate(lanes, count);
+        return CollectionMultisetHash::format(lanes, count);
+    }
+
 } dbhashCmd;
 
 }  // namespace
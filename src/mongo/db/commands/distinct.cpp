@@ -48,6 +48,8 @@
 #include "mongo/db/commands/run_aggregate.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/namespace_string.h"
@@ -57,6 +59,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/parsed_distinct.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/view_response_formatter.h"
 #include "mongo/db/views/resolved_view.h"
@@ -194,6 +197,14 @@ public:
             return true;
         }
 
+        // A filter-less, collation-less distinct over a suitable single-field index can skip
+        // the stage and executor machinery entirely and iterate the index in a tight loop,
+        // seeking past each distinct value inside the storage layer.
+        if (internalQueryExecTightLoopDistinct.load() &&
+            _tryTightLoopDistinct(opCtx, collection, parsedDistinct.getValue(), result)) {
+            return true;
+        }
+
         auto executor = getExecutorDistinct(
             opCtx, collection, nss.ns(), &parsedDistinct.getValue(), PlanExecutor::YIELD_AUTO);
         if (!executor.isOK()) {
@@ -279,6 +290,107 @@ public:
 
         return true;
     }
+
+private:
+    /**
+     * Answers an unfiltered distinct directly from an index when one distinct value per index
+     * run is all that is needed: finds a non-multikey, non-sparse, non-partial btree index
+     * with a simple collation whose first field is the distinct key, then repeatedly seeks
+     * past the current value with an exclusive one-field prefix so the storage engine skips
+     * the rest of each run internally. Each surviving key's first element is appended
+     * straight to the reply builder; no stages, working set members or document
+     * rehydration are involved, so the cost is proportional to the number of distinct
+     * values rather than the number of index entries.
+     *
+     * Returns false without touching 'result' if no suitable index exists or the request is
+     * not eligible (filter, collation, multikey index); the caller then takes the regular
+     * executor path.
+     */
+    bool _tryTightLoopDistinct(OperationContext* opCtx,
+                               Collection* collection,
+                               const ParsedDistinct& parsedDistinct,
+                               BSONObjBuilder& result) {
+        if (!collection) {
+            return false;
+        }
+
+        // Any filter, query collation or collection default collation changes which values
+        // match and how they compare, so those requests keep the full planner treatment.
+        const CanonicalQuery* cq = parsedDistinct.getQuery();
+        if (!cq->getQueryRequest().getFilter().isEmpty() || cq->getCollator() ||
+            collection->getDefaultCollator()) {
+            return false;
+        }
+
+        const std::string& key = parsedDistinct.getKey();
+        const IndexDescriptor* desc = nullptr;
+        IndexCatalog::IndexIterator ii =
+            collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+        while (ii.more()) {
+            const IndexDescriptor* candidate = ii.next();
+            BSONElement firstField = candidate->keyPattern().firstElement();
+            // The first field must be the distinct key, indexed as an ascending btree field
+            // (hashed and other special indexes have non-numeric key pattern values, and a
+            // descending field inverts the stored order our MinKey seek relies on).
+            if (firstField.fieldNameStringData() != key || !firstField.isNumber() ||
+                firstField.number() <= 0) {
+                continue;
+            }
+            // A multikey index has one entry per array element, a sparse index omits
+            // documents missing the field, a partial index omits documents entirely and a
+            // non-simple collation stores collation-transformed keys; all of those would
+            // change the reported values.
+            if (candidate->isMultikey(opCtx) || candidate->isSparse() ||
+                candidate->isPartial() || candidate->getInfoElement("collation")) {
+                continue;
+            }
+            desc = candidate;
+            break;
+        }
+        if (!desc) {
+            return false;
+        }
+
+        {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            CurOp::get(opCtx)->setPlanSummary_inlock(
+                std::string(str::stream() << "DISTINCT_SCAN " << desc->keyPattern()));
+        }
+
+        const IndexAccessMethod* iam = collection->getIndexCatalog()->getIndex(desc);
+        auto cursor = iam->newCursor(opCtx, true);
+
+        const int bufSize = BSONObjMaxUserSize - 4096;
+        BufBuilder bb(bufSize);
+        BSONArrayBuilder arr(bb);
+
+        // After reporting a value, seek with an exclusive one-field prefix: the storage
+        // engine positions directly on the first key with a different leading value,
+        // skipping the rest of the current run without surfacing its entries.
+        IndexSeekPoint seekPoint;
+        seekPoint.prefixLen = 1;
+        seekPoint.prefixExclusive = true;
+
+        auto kv = cursor->seek(kMinBSONKey, true, SortedDataInterface::Cursor::kWantKey);
+        while (kv) {
+            opCtx->checkForInterrupt();
+
+            BSONElement elt = kv->key.firstElement();
+            uassert(50344, "distinct too big, 16mb cap", (bb.len() + elt.size() + 1024) < bufSize);
+            arr.append(elt);
+
+            if (!kv->key.isOwned()) {
+                kv->key = kv->key.getOwned();
+            }
+            seekPoint.keyPrefix = kv->key;
+            kv = cursor->seek(seekPoint, SortedDataInterface::Cursor::kWantKey);
+        }
+
+        collection->infoCache()->notifyOfQuery(opCtx, {desc->indexName()});
+
+        result.appendArray("values", arr.done());
+        return true;
+    }
 } distinctCmd;
 
 }  // namespace mongo
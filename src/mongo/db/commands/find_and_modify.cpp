@@ -363,19 +363,45 @@ public:
         auto curOp = CurOp::get(opCtx);
         OpDebug* opDebug = &curOp->debug();
 
+        // Parse the request once, up front. A write conflict retry below only needs to re-create
+        // the canonical query, which the attempt's plan executor consumed; the collation, array
+        // filters and update expression do not change between attempts.
+        const bool isExplain = false;
+
+        boost::optional<DeleteRequest> deleteRequest;
+        boost::optional<ParsedDelete> parsedDelete;
+        boost::optional<UpdateRequest> updateRequest;
+        boost::optional<UpdateLifecycleImpl> updateLifecycle;
+        boost::optional<ParsedUpdate> parsedUpdate;
+        if (args.isRemove()) {
+            deleteRequest.emplace(nsString);
+            makeDeleteRequest(args, isExplain, deleteRequest.get_ptr());
+
+            parsedDelete.emplace(opCtx, deleteRequest.get_ptr());
+            Status parsedDeleteStatus = parsedDelete->parseRequest();
+            if (!parsedDeleteStatus.isOK()) {
+                return appendCommandStatus(result, parsedDeleteStatus);
+            }
+        } else {
+            updateRequest.emplace(nsString);
+            updateLifecycle.emplace(nsString);
+            makeUpdateRequest(args, isExplain, updateLifecycle.get_ptr(), updateRequest.get_ptr());
+
+            parsedUpdate.emplace(opCtx, updateRequest.get_ptr());
+            Status parsedUpdateStatus = parsedUpdate->parseRequest();
+            if (!parsedUpdateStatus.isOK()) {
+                return appendCommandStatus(result, parsedUpdateStatus);
+            }
+        }
+
         // Although usually the PlanExecutor handles WCE internally, it will throw WCEs when it is
         // executing a findAndModify. This is done to ensure that we can always match, modify, and
         // return the document under concurrency, if a matching document exists.
         bool success = writeConflictRetry(opCtx, "findAndModify", nsString.ns(), [&] {
             if (args.isRemove()) {
-                DeleteRequest request(nsString);
-                const bool isExplain = false;
-                makeDeleteRequest(args, isExplain, &request);
-
-                ParsedDelete parsedDelete(opCtx, &request);
-                Status parsedDeleteStatus = parsedDelete.parseRequest();
-                if (!parsedDeleteStatus.isOK()) {
-                    appendCommandStatus(result, parsedDeleteStatus);
+                Status reparseStatus = parsedDelete->reparseQueryIfNeeded();
+                if (!reparseStatus.isOK()) {
+                    appendCommandStatus(result, reparseStatus);
                     return false;
                 }
 
@@ -406,7 +432,7 @@ public:
                     return false;
                 }
                 auto statusWithPlanExecutor =
-                    getExecutorDelete(opCtx, opDebug, collection, &parsedDelete);
+                    getExecutorDelete(opCtx, opDebug, collection, parsedDelete.get_ptr());
                 if (!statusWithPlanExecutor.isOK()) {
                     appendCommandStatus(result, statusWithPlanExecutor.getStatus());
                     return false;
@@ -448,15 +474,9 @@ public:
                 boost::optional<BSONObj> value = advanceStatus.getValue();
                 appendCommandResponse(exec.get(), args.isRemove(), value, result);
             } else {
-                UpdateRequest request(nsString);
-                UpdateLifecycleImpl updateLifecycle(nsString);
-                const bool isExplain = false;
-                makeUpdateRequest(args, isExplain, &updateLifecycle, &request);
-
-                ParsedUpdate parsedUpdate(opCtx, &request);
-                Status parsedUpdateStatus = parsedUpdate.parseRequest();
-                if (!parsedUpdateStatus.isOK()) {
-                    appendCommandStatus(result, parsedUpdateStatus);
+                Status reparseStatus = parsedUpdate->reparseQueryIfNeeded();
+                if (!reparseStatus.isOK()) {
+                    appendCommandStatus(result, reparseStatus);
                     return false;
                 }
 
@@ -518,7 +538,7 @@ public:
                 }
 
                 auto statusWithPlanExecutor =
-                    getExecutorUpdate(opCtx, opDebug, collection, &parsedUpdate);
+                    getExecutorUpdate(opCtx, opDebug, collection, parsedUpdate.get_ptr());
                 if (!statusWithPlanExecutor.isOK()) {
                     appendCommandStatus(result, statusWithPlanExecutor.getStatus());
                     return false;
@@ -305,10 +305,9 @@ public:
         exec->reattachToOperationContext(opCtx);
         exec->restoreState();
 
-        auto planSummary = Explain::getPlanSummary(exec);
         {
             stdx::lock_guard<Client> lk(*opCtx->getClient());
-            curOp->setPlanSummary_inlock(planSummary);
+            curOp->setPlanSummary_inlock(cursor->getPlanSummary());
 
             // Ensure that the original query or command object is available in the slow query log,
             // profiler and currentOp.
@@ -44,9 +44,11 @@
 #include "mongo/db/commands/server_status_internal.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/platform/process_id.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/log.h"
@@ -64,6 +66,11 @@ using std::map;
 using std::string;
 using std::stringstream;
 
+// How long, in milliseconds, the serverStatus command may reuse the last output of sections
+// that opt in via ServerStatusSection::supportsSectionCache(). A value of 0 disables the
+// cache and every invocation regenerates every section.
+MONGO_EXPORT_SERVER_PARAMETER(serverStatusSectionCachePeriodMillis, int, 0);
+
 class CmdServerStatus : public BasicCommand {
 public:
     CmdServerStatus() : BasicCommand("serverStatus"), _started(Date_t::now()), _runCalled(false) {}
@@ -133,7 +140,7 @@ public:
                 continue;
             }
 
-            section->appendSection(opCtx, elem, &result);
+            _appendSection(opCtx, section, elem, &result);
             timeBuilder.appendNumber(
                 static_cast<string>(str::stream() << "after " << section->getSectionName()),
                 durationCount<Milliseconds>(clock->now() - runStart));
@@ -178,11 +185,56 @@ public:
     }
 
 private:
+    /**
+     * Appends a section to the result, serving it from the section cache when the section
+     * supports caching, a cache period is configured, and the last generated output is
+     * still fresh. Callers passing a configuration document for the section always get
+     * freshly generated output.
+     */
+    void _appendSection(OperationContext* opCtx,
+                        ServerStatusSection* section,
+                        const BSONElement& configElement,
+                        BSONObjBuilder* result) {
+        const auto cachePeriod = Milliseconds(serverStatusSectionCachePeriodMillis.load());
+        if (cachePeriod <= Milliseconds::zero() || !section->supportsSectionCache() ||
+            configElement.isABSONObj()) {
+            section->appendSection(opCtx, configElement, result);
+            return;
+        }
+
+        const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+        {
+            stdx::lock_guard<stdx::mutex> lk(_sectionCacheMutex);
+            auto it = _sectionCache.find(section->getSectionName());
+            if (it != _sectionCache.end() && now - it->second.generated < cachePeriod) {
+                result->appendElements(it->second.obj);
+                return;
+            }
+        }
+
+        // Generate outside the mutex; two concurrent polls may both regenerate an expired
+        // entry, which is harmless.
+        BSONObjBuilder sectionBuilder;
+        section->appendSection(opCtx, configElement, &sectionBuilder);
+        auto obj = sectionBuilder.obj();
+        result->appendElements(obj);
+
+        stdx::lock_guard<stdx::mutex> lk(_sectionCacheMutex);
+        _sectionCache[section->getSectionName()] = {now, std::move(obj)};
+    }
+
     const Date_t _started;
     bool _runCalled;
 
     typedef map<string, ServerStatusSection*> SectionMap;
     SectionMap _sections;
+
+    struct CachedSection {
+        Date_t generated;
+        BSONObj obj;
+    };
+    stdx::mutex _sectionCacheMutex;
+    map<string, CachedSection> _sectionCache;
 };
 
 namespace {
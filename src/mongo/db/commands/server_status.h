@@ -65,6 +65,18 @@ public:
      */
     virtual bool includeByDefault() const = 0;
 
+    /**
+     * Sections that perform expensive aggregation (rather than reading a few counters) may
+     * return true here. When serverStatusSectionCachePeriodMillis is non-zero, the
+     * serverStatus command then reuses this section's last generated output until it is
+     * older than that period, so frequent metrics polls don't re-run the aggregation. The
+     * cache is bypassed when the caller passes a configuration document for the section,
+     * since the output may depend on it.
+     */
+    virtual bool supportsSectionCache() const {
+        return false;
+    }
+
     /**
      * Adds the privileges that are required to view this section
      * TODO: Remove this empty default implementation and implement for every section.
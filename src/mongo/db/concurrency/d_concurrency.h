@@ -362,6 +362,30 @@ public:
         Locker* const _lockState;
         const bool _orginalShouldConflict;
     };
+
+    /**
+     * RAII-style class to opt out of conflicting with the ParallelBatchWriterMode lock held
+     * during secondary oplog batch application, restoring the previous setting on destruction.
+     * Must be constructed before the global lock is acquired and must outlive it.
+     */
+    class ShouldNotConflictWithSecondaryBatchApplicationBlock {
+        MONGO_DISALLOW_COPYING(ShouldNotConflictWithSecondaryBatchApplicationBlock);
+
+    public:
+        explicit ShouldNotConflictWithSecondaryBatchApplicationBlock(Locker* lockState)
+            : _lockState(lockState),
+              _originalShouldConflict(_lockState->shouldConflictWithSecondaryBatchApplication()) {
+            _lockState->setShouldConflictWithSecondaryBatchApplication(false);
+        }
+
+        ~ShouldNotConflictWithSecondaryBatchApplicationBlock() {
+            _lockState->setShouldConflictWithSecondaryBatchApplication(_originalShouldConflict);
+        }
+
+    private:
+        Locker* const _lockState;
+        const bool _originalShouldConflict;
+    };
 };
 
 /**
@@ -43,6 +43,7 @@
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/stringutils.h"
 #include "mongo/util/timer.h"
 
@@ -379,7 +380,7 @@ void LockHead::migratePartitionedLockHeads() {
     // Migration time: lock each partition in turn and transfer its requests, if any
     while (partitioned()) {
         LockManager::Partition* partition = partitions.back();
-        stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
+        stdx::lock_guard<InstrumentedMutex> scopedLock(partition->mutex);
 
         LockManager::Partition::Map::iterator it = partition->data.find(resourceId);
         if (it != partition->data.end()) {
@@ -407,14 +408,44 @@ void LockHead::migratePartitionedLockHeads() {
 // LockManager
 //
 
-// Have more buckets than CPUs to reduce contention on lock and caches
-const unsigned LockManager::_numLockBuckets(128);
+namespace {
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+/**
+ * Rounds 'target' up to the next power of two so the bucket and partition counts stay
+ * cache-friendly regardless of the reported core count.
+ */
+unsigned nextPowerOfTwo(unsigned target) {
+    unsigned result = 1;
+    while (result < target) {
+        result <<= 1;
+    }
+    return result;
+}
+
+unsigned numAvailableCores() {
+    ProcessInfo pi;
+    return static_cast<unsigned>(pi.getNumAvailableCores().value_or(pi.getNumCores()));
+}
+
+// Have more buckets than CPUs to reduce contention on lock and caches. The historical value of
+// 128 is kept as a floor, but on larger hosts the count scales with the core count so that
+// grants for unrelated resources rarely share a bucket mutex. Capped so the deadlock detector
+// and cleanupUnusedLocks(), which walk every bucket, stay cheap.
+unsigned computeNumLockBuckets() {
+    return std::min(8192U, nextPowerOfTwo(std::max(128U, numAvailableCores() * 8)));
+}
+
+// Balance scalability of intent locks against potential added cost of conflicting locks. The
+// exact value doesn't appear very important, but should be power of two. Scales with the core
+// count (floor of the historical 32) since lockers hash to partitions by id.
+unsigned computeNumPartitions() {
+    return std::min(1024U, nextPowerOfTwo(std::max(32U, numAvailableCores() * 2)));
+}
+
+}  // namespace
 
-LockManager::LockManager() {
+LockManager::LockManager()
+    : _numLockBuckets(computeNumLockBuckets()), _numPartitions(computeNumPartitions()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
 }
@@ -442,7 +473,7 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
     // For intent modes, try the PartitionedLockHead
     if (request->partitioned) {
         Partition* partition = _getPartition(request);
-        stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
+        stdx::lock_guard<InstrumentedMutex> scopedLock(partition->mutex);
 
         // Fast path for intent locks
         PartitionedLockHead* partitionedLock = partition->find(resId);
@@ -458,14 +489,14 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
 
     // Use regular LockHead, maybe start partitioning
     LockBucket* bucket = _getBucket(resId);
-    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+    stdx::lock_guard<InstrumentedMutex> scopedLock(bucket->mutex);
 
     LockHead* lock = bucket->findOrInsert(resId);
 
     // Start a partitioned lock if possible
     if (request->partitioned && !(lock->grantedModes & (~intentModes)) && !lock->conflictModes) {
         Partition* partition = _getPartition(request);
-        stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
+        stdx::lock_guard<InstrumentedMutex> scopedLock(partition->mutex);
         PartitionedLockHead* partitionedLock = partition->findOrInsert(resId);
         invariant(partitionedLock);
         lock->partitions.push_back(partition);
@@ -506,7 +537,7 @@ LockResult LockManager::convert(ResourceId resId, LockRequest* request, LockMode
               LockConflictsTable[newMode]);
 
     LockBucket* bucket = _getBucket(resId);
-    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+    stdx::lock_guard<InstrumentedMutex> scopedLock(bucket->mutex);
 
     LockBucket::Map::iterator it = bucket->data.find(resId);
     invariant(it != bucket->data.end());
@@ -574,7 +605,7 @@ bool LockManager::unlock(LockRequest* request) {
         invariant(request->status == LockRequest::STATUS_GRANTED ||
                   request->status == LockRequest::STATUS_CONVERTING);
         Partition* partition = _getPartition(request);
-        stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
+        stdx::lock_guard<InstrumentedMutex> scopedLock(partition->mutex);
         //  Fast path: still partitioned.
         if (request->partitionedLock) {
             request->partitionedLock->grantedList.remove(request);
@@ -587,7 +618,7 @@ bool LockManager::unlock(LockRequest* request) {
 
     LockHead* lock = request->lock;
     LockBucket* bucket = _getBucket(lock->resourceId);
-    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+    stdx::lock_guard<InstrumentedMutex> scopedLock(bucket->mutex);
 
     if (request->status == LockRequest::STATUS_GRANTED) {
         // This releases a currently held lock and is the most common path, so it should be
@@ -647,7 +678,7 @@ void LockManager::downgrade(LockRequest* request, LockMode newMode) {
     LockHead* lock = request->lock;
 
     LockBucket* bucket = _getBucket(lock->resourceId);
-    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+    stdx::lock_guard<InstrumentedMutex> scopedLock(bucket->mutex);
 
     lock->incGrantedModeCount(newMode);
     lock->decGrantedModeCount(request->mode);
@@ -659,7 +690,7 @@ void LockManager::downgrade(LockRequest* request, LockMode newMode) {
 void LockManager::cleanupUnusedLocks() {
     for (unsigned i = 0; i < _numLockBuckets; i++) {
         LockBucket* bucket = &_lockBuckets[i];
-        stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+        stdx::lock_guard<InstrumentedMutex> scopedLock(bucket->mutex);
         _cleanupUnusedLocksInBucket(bucket);
     }
 }
@@ -816,7 +847,7 @@ void LockManager::dump() const {
 
     for (unsigned i = 0; i < _numLockBuckets; i++) {
         LockBucket* bucket = &_lockBuckets[i];
-        stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+        stdx::lock_guard<InstrumentedMutex> scopedLock(bucket->mutex);
 
         if (!bucket->data.empty()) {
             _dumpBucket(bucket);
@@ -876,7 +907,7 @@ void LockManager::getLockInfoBSON(const std::map<LockerId, BSONObj>& lockToClien
     BSONArrayBuilder lockInfo;
     for (unsigned i = 0; i < _numLockBuckets; i++) {
         LockBucket* bucket = &_lockBuckets[i];
-        stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+        stdx::lock_guard<InstrumentedMutex> scopedLock(bucket->mutex);
 
         _cleanupUnusedLocksInBucket(bucket);
         if (!bucket->data.empty()) {
@@ -1021,7 +1052,7 @@ std::string DeadlockDetector::toString() const {
 void DeadlockDetector::_processNextNode(const UnprocessedNode& node) {
     // Locate the request
     LockManager::LockBucket* bucket = _lockMgr._getBucket(node.resId);
-    stdx::lock_guard<SimpleMutex> scopedLock(bucket->mutex);
+    stdx::lock_guard<InstrumentedMutex> scopedLock(bucket->mutex);
 
     LockManager::LockBucket::Map::const_iterator iter = bucket->data.find(node.resId);
     if (iter == bucket->data.end()) {
@@ -42,6 +42,7 @@
 #include "mongo/platform/unordered_map.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/instrumented_mutex.h"
 #include "mongo/util/concurrency/mutex.h"
 
 namespace mongo {
@@ -141,7 +142,7 @@ private:
     // These types describe the locks hash table
 
     struct LockBucket {
-        SimpleMutex mutex;
+        InstrumentedMutex mutex{"LockManagerBucket"};
         typedef unordered_map<ResourceId, LockHead*> Map;
         Map data;
         LockHead* findOrInsert(ResourceId resId);
@@ -154,7 +155,7 @@ private:
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
         typedef unordered_map<ResourceId, PartitionedLockHead*> Map;
-        SimpleMutex mutex;
+        InstrumentedMutex mutex{"LockManagerPartition"};
         Map data;
     };
 
@@ -211,10 +212,11 @@ private:
      */
     void _cleanupUnusedLocksInBucket(LockBucket* bucket);
 
-    static const unsigned _numLockBuckets;
+    // Sized once at construction based on the host's core count; see lock_manager.cpp.
+    const unsigned _numLockBuckets;
     LockBucket* _lockBuckets;
 
-    static const unsigned _numPartitions;
+    const unsigned _numPartitions;
     Partition* _partitions;
 };
 
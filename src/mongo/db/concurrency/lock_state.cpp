@@ -32,13 +32,18 @@
 
 #include "mongo/db/concurrency/lock_state.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
 #include "mongo/platform/compiler.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/new.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/log.h"
@@ -48,58 +53,107 @@ namespace mongo {
 namespace {
 
 /**
- * Partitioned global lock statistics, so we don't hit the same bucket.
+ * Instance-wide lock statistics, kept as one slab of counters per thread so the hot path never
+ * writes to a cache line that another core is also writing. Threads register their slab on
+ * first use; report() and reset() walk the registry under its mutex, and a thread that goes
+ * away folds its totals into an exited-threads accumulator on the way out. The counters stay
+ * atomic so the reporting thread can read them while their owner keeps counting, but every
+ * write lands on thread-private cache lines.
  */
-class PartitionedInstanceWideLockStats {
-    MONGO_DISALLOW_COPYING(PartitionedInstanceWideLockStats);
+class ThreadLocalInstanceWideLockStats {
+    MONGO_DISALLOW_COPYING(ThreadLocalInstanceWideLockStats);
 
 public:
-    PartitionedInstanceWideLockStats() {}
+    ThreadLocalInstanceWideLockStats() {}
 
-    void recordAcquisition(LockerId id, ResourceId resId, LockMode mode) {
-        _get(id).recordAcquisition(resId, mode);
+    void recordAcquisition(ResourceId resId, LockMode mode) {
+        _get().recordAcquisition(resId, mode);
     }
 
-    void recordWait(LockerId id, ResourceId resId, LockMode mode) {
-        _get(id).recordWait(resId, mode);
+    void recordWait(ResourceId resId, LockMode mode) {
+        _get().recordWait(resId, mode);
     }
 
-    void recordWaitTime(LockerId id, ResourceId resId, LockMode mode, uint64_t waitMicros) {
-        _get(id).recordWaitTime(resId, mode, waitMicros);
+    void recordWaitTime(ResourceId resId, LockMode mode, uint64_t waitMicros) {
+        _get().recordWaitTime(resId, mode, waitMicros);
     }
 
     void recordDeadlock(ResourceId resId, LockMode mode) {
-        _get(resId).recordDeadlock(resId, mode);
+        _get().recordDeadlock(resId, mode);
     }
 
     void report(SingleThreadedLockStats* outStats) const {
-        for (int i = 0; i < NumPartitions; i++) {
-            outStats->append(_partitions[i].stats);
+        stdx::lock_guard<stdx::mutex> lk(_registryMutex);
+        for (const ThreadStats* node = _registryHead; node; node = node->next) {
+            outStats->append(node->stats);
         }
+        outStats->append(_exitedThreadsStats);
     }
 
     void reset() {
-        for (int i = 0; i < NumPartitions; i++) {
-            _partitions[i].stats.reset();
+        stdx::lock_guard<stdx::mutex> lk(_registryMutex);
+        for (ThreadStats* node = _registryHead; node; node = node->next) {
+            node->stats.reset();
         }
+        _exitedThreadsStats.reset();
     }
 
 private:
-    // This alignment is a best effort approach to ensure that each partition falls on a
-    // separate page/cache line in order to avoid false sharing.
-    struct alignas(stdx::hardware_destructive_interference_size) AlignedLockStats {
+    // This alignment is a best effort approach to ensure that each thread's counters fall on
+    // separate cache lines in order to avoid false sharing.
+    struct alignas(stdx::hardware_destructive_interference_size) ThreadStats {
         AtomicLockStats stats;
+        ThreadStats* prev{nullptr};
+        ThreadStats* next{nullptr};
     };
 
-    enum { NumPartitions = 8 };
+    // Links the owning thread's slab into the registry for the thread's lifetime.
+    class ThreadStatsRegistration {
+    public:
+        explicit ThreadStatsRegistration(ThreadLocalInstanceWideLockStats* owner)
+            : _owner(owner) {
+            stdx::lock_guard<stdx::mutex> lk(_owner->_registryMutex);
+            _node.next = _owner->_registryHead;
+            if (_owner->_registryHead) {
+                _owner->_registryHead->prev = &_node;
+            }
+            _owner->_registryHead = &_node;
+        }
+
+        ~ThreadStatsRegistration() {
+            stdx::lock_guard<stdx::mutex> lk(_owner->_registryMutex);
+            _owner->_exitedThreadsStats.append(_node.stats);
+            if (_node.prev) {
+                _node.prev->next = _node.next;
+            } else {
+                _owner->_registryHead = _node.next;
+            }
+            if (_node.next) {
+                _node.next->prev = _node.prev;
+            }
+        }
 
+        AtomicLockStats& stats() {
+            return _node.stats;
+        }
+
+    private:
+        ThreadLocalInstanceWideLockStats* const _owner;
+        ThreadStats _node;
+    };
 
-    AtomicLockStats& _get(LockerId id) {
-        return _partitions[id % NumPartitions].stats;
+    AtomicLockStats& _get() {
+        // Relies on there being a single instance of this class (the file-static globalStats
+        // below); the thread_local is per thread, not per thread and instance.
+        thread_local ThreadStatsRegistration registration(this);
+        return registration.stats();
     }
 
+    mutable stdx::mutex _registryMutex;
+    ThreadStats* _registryHead = nullptr;
 
-    AlignedLockStats _partitions[NumPartitions];
+    // Totals of threads that have already exited. Guarded by _registryMutex.
+    SingleThreadedLockStats _exitedThreadsStats;
 };
 
 
@@ -122,8 +176,80 @@ const Milliseconds DeadlockTimeout = Milliseconds(500);
 // Dispenses unique LockerId identifiers
 AtomicUInt64 idCounter(0);
 
-// Partitioned global lock statistics, so we don't hit the same bucket
-PartitionedInstanceWideLockStats globalStats;
+// Global lock statistics, tallied per thread so the hot path never shares write cache lines
+ThreadLocalInstanceWideLockStats globalStats;
+
+/**
+ * Runs wait-for-graph analysis on a dedicated thread so the cost of walking the lock manager's
+ * queues is not paid by blocked lockers. A waiter that wants deadlock checking registers a
+ * WaitRecord before going to sleep and, on each of its periodic wakeups, merely polls the flag
+ * the monitor sets when it finds a cycle rooted at that waiter.
+ *
+ * The monitor thread is started lazily on the first registration, so processes and unit tests
+ * that never wait with deadlock checking enabled pay nothing.
+ */
+class DeadlockMonitor {
+public:
+    /**
+     * One blocked locker. The monitor sets 'deadlocked' when the wait-for graph rooted at
+     * 'locker' contains a cycle; the warning with the cycle is logged by the monitor.
+     */
+    struct WaitRecord {
+        WaitRecord(const Locker* locker) : locker(locker) {}
+
+        const Locker* const locker;
+        AtomicBool deadlocked{false};
+    };
+
+    void registerWaiter(WaitRecord* record) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _waiters.push_back(record);
+        if (!_started) {
+            _started = true;
+            stdx::thread([this] { _run(); }).detach();
+        }
+        _wakeMonitor.notify_one();
+    }
+
+    void unregisterWaiter(WaitRecord* record) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _waiters.erase(std::find(_waiters.begin(), _waiters.end(), record));
+    }
+
+private:
+    void _run() {
+        setThreadName("DeadlockMonitor");
+
+        // Holding _mutex while detecting keeps the registered records alive; it only ever
+        // delays threads entering or leaving a lock wait, never the lock grant path itself.
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        while (true) {
+            if (_waiters.empty()) {
+                MONGO_IDLE_THREAD_BLOCK;
+                _wakeMonitor.wait(lk, [this] { return !_waiters.empty(); });
+            }
+
+            for (WaitRecord* record : _waiters) {
+                if (record->deadlocked.load())
+                    continue;
+                DeadlockDetector wfg(globalLockManager, record->locker);
+                if (wfg.check().hasCycle()) {
+                    warning() << "Deadlock found: " << wfg.toString();
+                    record->deadlocked.store(true);
+                }
+            }
+
+            _wakeMonitor.wait_for(lk, DeadlockTimeout.toSystemDuration());
+        }
+    }
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _wakeMonitor;
+    bool _started = false;
+    std::vector<WaitRecord*> _waiters;
+};
+
+DeadlockMonitor deadlockMonitor;
 
 
 /**
@@ -239,6 +365,10 @@ void CondVarLockGrantNotification::notify(ResourceId resId, LockResult result) {
 
 namespace {
 TicketHolder* ticketHolders[LockModesCount] = {};
+
+// Number of lockers currently blocked in lockComplete(). Consulted by Locker::hasContendedLocks
+// so query yield points can tell cheaply whether anyone would benefit from a yield.
+AtomicInt32 blockedLockerCount(0);
 }  // namespace
 
 
@@ -253,6 +383,11 @@ void Locker::setGlobalThrottling(class TicketHolder* reading, class TicketHolder
     ticketHolders[MODE_IX] = writing;
 }
 
+/* static */
+bool Locker::hasContendedLocks() {
+    return blockedLockerCount.load() > 0;
+}
+
 template <bool IsForMMAPV1>
 LockerImpl<IsForMMAPV1>::LockerImpl()
     : _id(idCounter.addAndFetch(1)), _wuowNestingLevel(0), _threadId(stdx::this_thread::get_id()) {}
@@ -365,7 +500,7 @@ void LockerImpl<IsForMMAPV1>::downgradeGlobalXtoSForMMAPV1() {
     // so it's OK.
 
     // Making this call here will record lock downgrades as acquisitions, which is acceptable
-    globalStats.recordAcquisition(_id, resourceIdGlobal, MODE_S);
+    globalStats.recordAcquisition(resourceIdGlobal, MODE_S);
     _stats.recordAcquisition(resourceIdGlobal, MODE_S);
 
     globalLockManager.downgrade(globalLockRequest, MODE_S);
@@ -678,7 +813,7 @@ LockResult LockerImpl<IsForMMAPV1>::lockBegin(ResourceId resId, LockMode mode) {
     }
 
     // Making this call here will record lock re-acquisitions and conversions as well.
-    globalStats.recordAcquisition(_id, resId, mode);
+    globalStats.recordAcquisition(resId, mode);
     _stats.recordAcquisition(resId, mode);
 
     // Give priority to the full modes for global, parallel batch writer mode,
@@ -703,6 +838,17 @@ LockResult LockerImpl<IsForMMAPV1>::lockBegin(ResourceId resId, LockMode mode) {
         };
     }
 
+    // Sticky fast path: if this locker already holds the resource in a mode that covers the
+    // requested one, the re-acquisition can be recorded entirely locally without touching the
+    // lock manager. The request belongs to this locker and is granted, so its mode cannot
+    // change underneath us; this takes the same branch LockManager::convert would, minus the
+    // call into the manager.
+    if (!isNew && request->status == LockRequest::STATUS_GRANTED &&
+        isModeCovered(mode, request->mode)) {
+        request->recursiveCount++;
+        return LOCK_OK;
+    }
+
     // The notification object must be cleared before we invoke the lock manager, because
     // otherwise we might reset state if the lock becomes granted very fast.
     _notify.clear();
@@ -711,7 +857,7 @@ LockResult LockerImpl<IsForMMAPV1>::lockBegin(ResourceId resId, LockMode mode) {
                               : globalLockManager.convert(resId, request, mode);
 
     if (result == LOCK_WAITING) {
-        globalStats.recordWait(_id, resId, mode);
+        globalStats.recordWait(resId, mode);
         _stats.recordWait(resId, mode);
     }
 
@@ -735,12 +881,21 @@ LockResult LockerImpl<IsForMMAPV1>::lockComplete(ResourceId resId,
 
     LockResult result;
 
-    // Don't go sleeping without bound in order to be able to report long waits or wake up for
-    // deadlock detection.
+    // Register with the deadlock monitor before going to sleep. Cycle detection runs on the
+    // monitor's thread; this thread only polls the record's flag on its periodic wakeups.
+    DeadlockMonitor::WaitRecord deadlockRecord(this);
+    if (checkDeadlock) {
+        deadlockMonitor.registerWaiter(&deadlockRecord);
+    }
+
+    // Don't go sleeping without bound in order to be able to report long waits or notice that
+    // the deadlock monitor has flagged this wait.
     Milliseconds waitTime = std::min(timeout, DeadlockTimeout);
     const uint64_t startOfTotalWaitTime = curTimeMicros64();
     uint64_t startOfCurrentWaitTime = startOfTotalWaitTime;
 
+    blockedLockerCount.fetchAndAdd(1);
+
     while (true) {
         // It is OK if this call wakes up spuriously, because we re-evaluate the remaining
         // wait time anyways.
@@ -751,23 +906,18 @@ LockResult LockerImpl<IsForMMAPV1>::lockComplete(ResourceId resId,
         const uint64_t elapsedTimeMicros = curTimeMicros - startOfCurrentWaitTime;
         startOfCurrentWaitTime = curTimeMicros;
 
-        globalStats.recordWaitTime(_id, resId, mode, elapsedTimeMicros);
+        globalStats.recordWaitTime(resId, mode, elapsedTimeMicros);
         _stats.recordWaitTime(resId, mode, elapsedTimeMicros);
 
         if (result == LOCK_OK)
             break;
 
-        if (checkDeadlock) {
-            DeadlockDetector wfg(globalLockManager, this);
-            if (wfg.check().hasCycle()) {
-                warning() << "Deadlock found: " << wfg.toString();
-
-                globalStats.recordDeadlock(resId, mode);
-                _stats.recordDeadlock(resId, mode);
+        if (checkDeadlock && deadlockRecord.deadlocked.load()) {
+            globalStats.recordDeadlock(resId, mode);
+            _stats.recordDeadlock(resId, mode);
 
-                result = LOCK_DEADLOCK;
-                break;
-            }
+            result = LOCK_DEADLOCK;
+            break;
         }
 
         // If infinite timeout was requested, just keep waiting
@@ -781,10 +931,30 @@ LockResult LockerImpl<IsForMMAPV1>::lockComplete(ResourceId resId,
                                               : Milliseconds(0);
 
         if (waitTime == Milliseconds(0)) {
+            // One last synchronous check, so a bounded wait that is actually deadlocked
+            // reports the deadlock rather than a timeout even if the monitor's periodic scan
+            // has not reached this waiter yet.
+            if (checkDeadlock) {
+                DeadlockDetector wfg(globalLockManager, this);
+                if (wfg.check().hasCycle()) {
+                    warning() << "Deadlock found: " << wfg.toString();
+
+                    globalStats.recordDeadlock(resId, mode);
+                    _stats.recordDeadlock(resId, mode);
+
+                    result = LOCK_DEADLOCK;
+                }
+            }
             break;
         }
     }
 
+    blockedLockerCount.fetchAndSubtract(1);
+
+    if (checkDeadlock) {
+        deadlockMonitor.unregisterWaiter(&deadlockRecord);
+    }
+
     // Cleanup the state, since this is an unused lock now
     if (result != LOCK_OK) {
         LockRequestsMap::Iterator it = _requests.find(resId);
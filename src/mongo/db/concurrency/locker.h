@@ -70,6 +70,13 @@ public:
      */
     static void setGlobalThrottling(class TicketHolder* reading, class TicketHolder* writing);
 
+    /**
+     * Returns true if any locker in the process is currently blocked waiting for a lock. This
+     * is a single atomic load, cheap enough to consult from per-document code such as query
+     * yield points, which use it to yield only when a conflicting operation is actually queued.
+     */
+    static bool hasContendedLocks();
+
     /**
      * State for reporting the number of active and queued reader and writer clients.
      */
@@ -31,12 +31,47 @@
 #define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kWrite
 
 #include "mongo/db/concurrency/write_conflict_exception.h"
+
+#include <algorithm>
+#include <vector>
+
 #include "mongo/db/server_parameters.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stacktrace.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
+namespace {
+
+// Per-namespace conflict tallies for the writeConflicts serverStatus section. The table is
+// capped so a workload that churns through namespaces cannot grow it without bound; conflicts
+// on namespaces past the cap are lumped into an untracked count. Only touched on the conflict
+// path, which has already paid for an exception and a snapshot abandon.
+const size_t kMaxTrackedNamespaces = 128;
+
+stdx::mutex conflictStatsMutex;
+StringMap<long long> conflictCounts;
+long long untrackedConflicts = 0;
+long long totalConflicts = 0;
+
+void recordConflict(StringData ns) {
+    stdx::lock_guard<stdx::mutex> lk(conflictStatsMutex);
+    totalConflicts++;
+    auto it = conflictCounts.find(ns);
+    if (it != conflictCounts.end()) {
+        it->second++;
+    } else if (conflictCounts.size() < kMaxTrackedNamespaces) {
+        conflictCounts[ns] = 1;
+    } else {
+        untrackedConflicts++;
+    }
+}
+
+}  // namespace
+
 AtomicBool WriteConflictException::trace(false);
 
 WriteConflictException::WriteConflictException()
@@ -47,19 +82,55 @@ WriteConflictException::WriteConflictException()
 }
 
 void WriteConflictException::logAndBackoff(int attempt, StringData operation, StringData ns) {
+    recordConflict(ns);
+
     LOG(1) << "Caught WriteConflictException doing " << operation << " on " << ns
            << ", attempt: " << attempt << " retrying";
 
-    // All numbers below chosen by guess and check against a few random benchmarks.
+    // The first few retries are free: most conflicts resolve as soon as the snapshot has been
+    // refreshed. After that, sleep a uniformly random slice of a window that doubles with each
+    // attempt, so concurrent retriers of the same document spread out instead of colliding
+    // again in lockstep. The window is capped at the previous fixed ceiling of 10ms.
     if (attempt < 4) {
-        // no-op
-    } else if (attempt < 10) {
-        sleepmillis(1);
-    } else if (attempt < 100) {
-        sleepmillis(5);
-    } else {
-        sleepmillis(10);
+        return;
+    }
+
+    const long long kMaxBackoffMicros = 10 * 1000;
+    const int shift = std::min(attempt - 4, 20);
+    const long long windowMicros =
+        std::min(kMaxBackoffMicros, static_cast<long long>(100) << shift);
+
+    thread_local PseudoRandom backoffRandom(SecureRandom::create()->nextInt64());
+    sleepmicros(1 + backoffRandom.nextInt64(windowMicros));
+}
+
+void WriteConflictException::appendConflictStats(BSONObjBuilder* builder) {
+    std::vector<std::pair<std::string, long long>> counts;
+    long long total;
+    long long untracked;
+    {
+        stdx::lock_guard<stdx::mutex> lk(conflictStatsMutex);
+        total = totalConflicts;
+        untracked = untrackedConflicts;
+        counts.assign(conflictCounts.begin(), conflictCounts.end());
+    }
+
+    builder->append("totalConflicts", total);
+    if (untracked) {
+        builder->append("untrackedConflicts", untracked);
+    }
+
+    std::sort(counts.begin(),
+              counts.end(),
+              [](const std::pair<std::string, long long>& lhs,
+                 const std::pair<std::string, long long>& rhs) { return lhs.second > rhs.second; });
+
+    const size_t kTopNamespaces = 10;
+    BSONObjBuilder nsBuilder(builder->subobjStart("namespaces"));
+    for (size_t i = 0; i < counts.size() && i < kTopNamespaces; i++) {
+        nsBuilder.append(counts[i].first, counts[i].second);
     }
+    nsBuilder.done();
 }
 
 namespace {
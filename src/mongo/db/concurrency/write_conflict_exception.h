@@ -48,13 +48,20 @@ public:
     WriteConflictException();
 
     /**
-     * Will log a message if sensible and will do an exponential backoff to make sure
-     * we don't hammer the same doc over and over.
+     * Will log a message if sensible and will do a randomized exponential backoff to make sure
+     * we don't hammer the same doc over and over. Also tallies the conflict against 'ns' for
+     * the writeConflicts serverStatus section.
      * @param attempt - what attempt is this, 1 based
      * @param operation - e.g. "update"
      */
     static void logAndBackoff(int attempt, StringData operation, StringData ns);
 
+    /**
+     * Appends the per-namespace conflict counts recorded by logAndBackoff, most conflicted
+     * namespaces first. Used by the writeConflicts serverStatus section.
+     */
+    static void appendConflictStats(BSONObjBuilder* builder);
+
     /**
      * If true, will call printStackTrace on every WriteConflictException created.
      * Can be set via setParameter named traceWriteConflictExceptions.
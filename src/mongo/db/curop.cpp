@@ -235,7 +235,7 @@ CurOp::CurOp(OperationContext* opCtx, CurOpStack* stack) : _stack(stack) {
 }
 
 ProgressMeter& CurOp::setMessage_inlock(const char* msg,
-                                        std::string name,
+                                        StringData name,
                                         unsigned long long progressMeterTotal,
                                         int secondsBetween) {
     if (progressMeterTotal) {
@@ -244,7 +244,7 @@ ProgressMeter& CurOp::setMessage_inlock(const char* msg,
             verify(!_progressMeter.isActive());
         }
         _progressMeter.reset(progressMeterTotal, secondsBetween);
-        _progressMeter.setName(name);
+        _progressMeter.setName(name.toString());
     } else {
         _progressMeter.finished();
     }
@@ -257,7 +257,9 @@ CurOp::~CurOp() {
 }
 
 void CurOp::setNS_inlock(StringData ns) {
-    _ns = ns.toString();
+    // Assign in place rather than through a temporary string so an existing allocation can be
+    // reused when the namespace changes over the life of the operation.
+    _ns.assign(ns.rawData(), ns.size());
 }
 
 void CurOp::ensureStarted() {
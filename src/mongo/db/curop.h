@@ -120,6 +120,11 @@ public:
 
     BSONObj execStats;  // Owned here.
 
+    // The plan cache key describing the query's shape, set during planning. Used to aggregate
+    // per-shape metrics when the operation completes; empty for operations with no planned
+    // query.
+    std::string queryShapeKey;
+
     // error handling
     ExceptionInfo exceptionInfo;
 
@@ -218,8 +223,12 @@ public:
 
     /**
      * Gets the name of the namespace on which the current operation operates.
+     *
+     * The returned reference is invalidated by setNS_inlock() and by destruction of this CurOp;
+     * callers that need the namespace beyond that must take their own copy. Returning a
+     * reference avoids a per-call string copy on the operation completion path.
      */
-    std::string getNS() const {
+    const std::string& getNS() const {
         return _ns;
     }
 
@@ -397,9 +406,13 @@ public:
      * While it is necessary to hold the lock while this method executes, the
      * "hit" and "finished" methods of ProgressMeter may be called safely from
      * the thread executing the operation without locking the Client.
+     *
+     * The progress meter name is only materialized into a string when a progress meter is
+     * actually requested (progressMeterTotal != 0), so callers that just set a message do not
+     * pay for an allocation.
      */
     ProgressMeter& setMessage_inlock(const char* msg,
-                                     std::string name = "Progress",
+                                     StringData name = "Progress"_sd,
                                      unsigned long long progressMeterTotal = 0,
                                      int secondsBetween = 3);
 
@@ -62,6 +62,66 @@ MONGO_EXPORT_SERVER_PARAMETER(
 
 constexpr int CursorManager::kNumPartitions;
 
+namespace {
+// How many records a shared scan participant passes between publications of its position.
+const size_t kSharedScanPublishInterval = 128;
+}  // namespace
+
+SharedScanParticipant::SharedScanParticipant(SharedScanRegistry* registry,
+                                             NamespaceString nss,
+                                             RecordId position)
+    : _registry(registry), _nss(std::move(nss)), _position(std::move(position)) {}
+
+SharedScanParticipant::~SharedScanParticipant() {
+    _registry->leave(this);
+}
+
+void SharedScanParticipant::updatePosition(const RecordId& id) {
+    if (++_callsSincePublish < kSharedScanPublishInterval) {
+        return;
+    }
+    _callsSincePublish = 0;
+    stdx::lock_guard<stdx::mutex> lk(_registry->_mutex);
+    _position = id;
+}
+
+// static
+SharedScanRegistry* SharedScanRegistry::get() {
+    static SharedScanRegistry registry;
+    return &registry;
+}
+
+std::unique_ptr<SharedScanParticipant> SharedScanRegistry::join(const NamespaceString& nss,
+                                                                RecordId* startPos) {
+    *startPos = RecordId();
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto& participants = _scansByNs[nss.ns()];
+    for (size_t i = 0; i < participants.size(); i++) {
+        if (participants[i]->_position > *startPos) {
+            *startPos = participants[i]->_position;
+        }
+    }
+
+    std::unique_ptr<SharedScanParticipant> participant(
+        new SharedScanParticipant(this, nss, *startPos));
+    participants.push_back(participant.get());
+    return participant;
+}
+
+void SharedScanRegistry::leave(SharedScanParticipant* participant) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _scansByNs.find(participant->_nss.ns());
+    invariant(it != _scansByNs.end());
+    auto& participants = it->second;
+    auto pos = std::find(participants.begin(), participants.end(), participant);
+    invariant(pos != participants.end());
+    participants.erase(pos);
+    if (participants.empty()) {
+        _scansByNs.erase(it);
+    }
+}
+
 namespace {
 uint32_t idFromCursorId(CursorId id) {
     uint64_t x = static_cast<uint64_t>(id);
@@ -591,7 +651,7 @@ ClientCursorPin CursorManager::registerCursor(OperationContext* opCtx,
 
     // Note we must hold the registration lock from now until insertion into '_cursorMap' to ensure
     // we don't insert two cursors with the same cursor id.
-    stdx::lock_guard<SimpleMutex> lock(_registrationLock);
+    stdx::lock_guard<InstrumentedMutex> lock(_registrationLock);
     CursorId cursorId = allocateCursorId_inlock();
     std::unique_ptr<ClientCursor, ClientCursor::Deleter> clientCursor(new ClientCursor(
         std::move(cursorParams), this, cursorId, opCtx->getLogicalSessionId(), now));
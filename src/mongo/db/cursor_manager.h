@@ -37,6 +37,10 @@
 #include "mongo/platform/unordered_map.h"
 #include "mongo/platform/unordered_set.h"
 #include "mongo/stdx/unordered_set.h"
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/instrumented_mutex.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/duration.h"
 
@@ -45,6 +49,82 @@ namespace mongo {
 class OperationContext;
 class PseudoRandom;
 class PlanExecutor;
+class SharedScanRegistry;
+
+/**
+ * One active scan's membership in the SharedScanRegistry. Destroying the handle deregisters the
+ * scan.
+ */
+class SharedScanParticipant {
+    MONGO_DISALLOW_COPYING(SharedScanParticipant);
+
+public:
+    ~SharedScanParticipant();
+
+    /**
+     * Publishes the position this scan has reached so that late-arriving scans can pick up
+     * there. Throttled internally; most calls return without taking the registry lock.
+     */
+    void updatePosition(const RecordId& id);
+
+private:
+    friend class SharedScanRegistry;
+
+    SharedScanParticipant(SharedScanRegistry* registry, NamespaceString nss, RecordId position);
+
+    SharedScanRegistry* const _registry;
+    const NamespaceString _nss;
+
+    // Throttles updatePosition(). Only touched by the owning scan.
+    size_t _callsSincePublish = 0;
+
+    // Guarded by the registry's mutex.
+    RecordId _position;
+};
+
+/**
+ * Coordinates concurrent full scans of the same namespace so that they read the same records at
+ * roughly the same time instead of each making its own pass over the data.
+ *
+ * A scan that can accept its results in any order registers as a participant and periodically
+ * publishes the position it has reached. A scan arriving while others are in flight starts at
+ * the most advanced published position, rides along to EOF, and then wraps around to cover the
+ * prefix it skipped. N concurrent scans thus make roughly one pass over the data between them
+ * rather than N cache-thrashing passes.
+ *
+ * The registry is a process-global singleton rather than a member of the per-collection
+ * CursorManager because plan stages can outlive their collection's catalog objects once killed,
+ * and participants deregister from their destructors, which must always be safe to run.
+ */
+class SharedScanRegistry {
+    MONGO_DISALLOW_COPYING(SharedScanRegistry);
+
+public:
+    SharedScanRegistry() = default;
+
+    /**
+     * The process-global registry.
+     */
+    static SharedScanRegistry* get();
+
+    /**
+     * Registers a scan of 'nss'. If other participants are already in flight, '*startPos' is
+     * set to the most advanced published position and the caller is expected to start there
+     * and wrap around at EOF; otherwise '*startPos' is left null. The scan remains a
+     * participant until the returned handle is destroyed.
+     */
+    std::unique_ptr<SharedScanParticipant> join(const NamespaceString& nss, RecordId* startPos);
+
+private:
+    friend class SharedScanParticipant;
+
+    void leave(SharedScanParticipant* participant);
+
+    stdx::mutex _mutex;
+
+    // Active participants bucketed by namespace. Guarded by '_mutex'.
+    stdx::unordered_map<std::string, std::vector<SharedScanParticipant*>> _scansByNs;
+};
 
 /**
  * A container which owns ClientCursor objects. This class is used to create, access, and delete
@@ -251,7 +331,7 @@ private:
     // - If you need to access multiple partitions within '_registeredPlanExecutors' or '_cursorMap'
     //   at once, you must acquire the mutexes for those partitions in ascending order, or use the
     //   partition helpers to acquire mutexes for all partitions.
-    mutable SimpleMutex _registrationLock;
+    mutable InstrumentedMutex _registrationLock{"CursorManagerRegistration"};
     std::unique_ptr<PseudoRandom> _random;
     Partitioned<unordered_set<PlanExecutor*>, kNumPartitions, PlanExecutorPartitioner>
         _registeredPlanExecutors;
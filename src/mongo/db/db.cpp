@@ -32,6 +32,7 @@
 
 #include "mongo/db/dbmain.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
 #include <boost/optional.hpp>
 #include <fstream>
@@ -55,6 +56,7 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/index_key_validate.h"
+#include "mongo/db/catalog/plan_cache_persistence.h"
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
@@ -109,6 +111,7 @@
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/startup_warnings_mongod.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats_collector.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/mmap_v1/mmap_v1_options.h"
 #include "mongo/db/storage/storage_engine.h"
@@ -461,13 +464,20 @@ void _initWireSpec() {
 
 MONGO_FP_DECLARE(shutdownAtStartup);
 
+// Granularity of the background-thread clock source that backs hot-path timing (operation
+// deadline checks and yield trackers). Finer granularity tightens deadline enforcement at the
+// cost of more frequent wakeups of the clock thread; precise per-operation latencies for the
+// profiler and slow-op log are taken from the precise clock regardless.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(fastClockSourceGranularityMillis, int, 10);
+
 ExitCode _initAndListen(int listenPort) {
     Client::initThread("initandlisten");
 
     _initWireSpec();
     auto globalServiceContext = checked_cast<ServiceContextMongoD*>(getGlobalServiceContext());
 
-    globalServiceContext->setFastClockSource(FastClockSourceFactory::create(Milliseconds(10)));
+    globalServiceContext->setFastClockSource(FastClockSourceFactory::create(
+        Milliseconds(std::max(1, fastClockSourceGranularityMillis))));
     globalServiceContext->setOpObserver(stdx::make_unique<OpObserverImpl>());
 
     DBDirectClientFactory::get(globalServiceContext)
@@ -708,6 +718,8 @@ ExitCode _initAndListen(int listenPort) {
             startTTLBackgroundJob();
         }
 
+        startStatsCollectorBackgroundJob();
+
         if (!replSettings.usingReplSets() && !replSettings.isSlave() &&
             storageGlobalParams.engine != "devnull") {
             Lock::GlobalWrite lk(startupOpCtx.get());
@@ -893,6 +905,11 @@ static void startupConfigActions(const std::vector<std::string>& args) {
 #endif
 }
 
+// Connections the replication executor's pool keeps warm to each peer so that heartbeats
+// and election messages do not wait behind connection setup (or a single in-flight request)
+// when the cluster is under load.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(replicationExecutorReservedConnections, int, 2);
+
 auto makeReplicationExecutor(ServiceContext* serviceContext) {
     ThreadPool::Options tpOptions;
     tpOptions.poolName = "replexec";
@@ -902,10 +919,17 @@ auto makeReplicationExecutor(ServiceContext* serviceContext) {
     };
     auto hookList = stdx::make_unique<rpc::EgressMetadataHookList>();
     hookList->addHook(stdx::make_unique<rpc::LogicalTimeMetadataHook>(serviceContext));
+    // This executor carries only replication-critical traffic (heartbeats and election
+    // messages); bulk traffic such as oplog fetching goes through the external state's
+    // task executor instead. Reserve warm connections here so that liveness messages are
+    // never queued behind connection establishment.
+    executor::ConnectionPool::Options connPoolOptions;
+    connPoolOptions.minConnections =
+        static_cast<size_t>(std::max(1, replicationExecutorReservedConnections));
     return stdx::make_unique<executor::ThreadPoolTaskExecutor>(
         stdx::make_unique<ThreadPool>(tpOptions),
         executor::makeNetworkInterface(
-            "NetworkInterfaceASIO-Replication", nullptr, std::move(hookList)));
+            "NetworkInterfaceASIO-Replication", nullptr, std::move(hookList), connPoolOptions));
 }
 
 MONGO_INITIALIZER_WITH_PREREQUISITES(CreateReplicationManager,
@@ -1077,6 +1101,12 @@ static void shutdownTask() {
         ShardingState::get(opCtx)->shutDown(opCtx);
     }
 
+    if (opCtx) {
+        // Persist the plan caches so that plan selection survives the restart without
+        // re-running multi-planning for every query shape.
+        plan_cache_persistence::dumpAllPlanCaches(opCtx);
+    }
+
     // We should always be able to acquire the global lock at shutdown.
     //
     // TODO: This call chain uses the locker directly, because we do not want to start an
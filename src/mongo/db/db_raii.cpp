@@ -37,6 +37,7 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/util/fail_point_service.h"
 
@@ -44,6 +45,11 @@ namespace mongo {
 
 namespace {
 MONGO_FP_DECLARE(setAutoGetCollectionWait);
+
+// When enabled, reads on secondaries execute against the last majority-committed snapshot
+// instead of conflicting with the ParallelBatchWriterMode lock, so oplog batch application no
+// longer stalls readers. Off by default, which preserves the blocking behavior.
+MONGO_EXPORT_SERVER_PARAMETER(allowSecondaryReadsDuringBatchApplication, bool, false);
 }  // namespace
 
 AutoGetDb::AutoGetDb(OperationContext* opCtx, StringData ns, LockMode mode)
@@ -126,6 +132,22 @@ AutoStatsTracker::~AutoStatsTracker() {
 AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
                                                    const NamespaceString& nss,
                                                    AutoGetCollection::ViewMode viewMode) {
+    // On secondaries, optionally read from the last majority-committed (batch-consistent)
+    // snapshot rather than waiting for oplog batch application to finish. This must be decided
+    // before the global lock is taken below. If no committed snapshot is available yet, fall
+    // back to conflicting with batch application as usual.
+    if (allowSecondaryReadsDuringBatchApplication.load() &&
+        opCtx->lockState()->shouldConflictWithSecondaryBatchApplication()) {
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+        if (replCoord->getReplicationMode() == repl::ReplicationCoordinator::modeReplSet &&
+            !replCoord->getMemberState().primary()) {
+            if (opCtx->recoveryUnit()->isReadingFromMajorityCommittedSnapshot() ||
+                opCtx->recoveryUnit()->setReadFromMajorityCommittedSnapshot().isOK()) {
+                _shouldNotConflictWithSecondaryBatchApplicationBlock.emplace(opCtx->lockState());
+            }
+        }
+    }
+
     _autoColl.emplace(opCtx, nss, MODE_IS, MODE_IS, viewMode);
 
     // Note: this can yield.
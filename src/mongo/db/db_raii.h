@@ -284,6 +284,12 @@ private:
     void _ensureMajorityCommittedSnapshotIsValid(const NamespaceString& nss,
                                                  OperationContext* opCtx);
 
+    // When set, this read does not conflict with secondary oplog batch application and instead
+    // executes against the last majority-committed snapshot. Declared before '_autoColl' so the
+    // locks are released before the previous conflict setting is restored.
+    boost::optional<Lock::ShouldNotConflictWithSecondaryBatchApplicationBlock>
+        _shouldNotConflictWithSecondaryBatchApplicationBlock;
+
     boost::optional<AutoGetCollection> _autoColl;
 };
 
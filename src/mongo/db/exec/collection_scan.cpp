@@ -31,8 +31,10 @@
 #include "mongo/db/exec/collection_scan.h"
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_zone_map.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/cursor_manager.h"
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
@@ -63,11 +65,25 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
       _filter(filter),
       _params(params),
       _isDead(false),
-      _wsidForFetch(_workingSet->allocate()) {
+      _wrapping(false),
+      _wsidForFetch(_workingSet->allocate()),
+      _filterProgram(MatchProgram::compile(filter)) {
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
+
+    // Zone-map skipping only makes sense for plain forward scans with a filter; tailable
+    // scans and bounded oplog scans manage their own positioning.
+    if (_filter && _params.collection && !_params.tailable &&
+        _params.direction == CollectionScanParams::FORWARD) {
+        const CollectionZoneMap* zoneMap = _params.collection->infoCache()->getZoneMap();
+        if (zoneMap->mightSkipFor(_filter)) {
+            _zoneMap = zoneMap;
+        }
+    }
 }
 
+CollectionScan::~CollectionScan() = default;
+
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     if (_isDead) {
         Status status(
@@ -129,10 +145,32 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
                 }
             }
 
-            return PlanStage::NEED_TIME;
-        }
+            if (_params.allowSharedScan && !_sharedScan && !_wrapping && _lastSeenId.isNull() &&
+                _params.start.isNull() && _params.direction == CollectionScanParams::FORWARD &&
+                !_params.collection->isCapped()) {
+                // Join any in-flight shared scan of this collection. If one exists, pick up at
+                // its published position and circle back at EOF for the prefix we skip here;
+                // the caller opted in to receiving its results in this rotated order.
+                RecordId joinPos;
+                _sharedScan =
+                    SharedScanRegistry::get()->join(_params.collection->ns(), &joinPos);
+                if (!joinPos.isNull()) {
+                    if (auto joinRecord = _cursor->seekExact(joinPos)) {
+                        // The record at the join position becomes our first result; fall
+                        // through to return it rather than NEED_TIME.
+                        _wrapStart = joinPos;
+                        record = joinRecord;
+                    } else {
+                        // The record at the published position is gone; scan normally.
+                        _cursor = _params.collection->getCursor(getOpCtx(), forward);
+                    }
+                }
+            }
 
-        if (_lastSeenId.isNull() && !_params.start.isNull()) {
+            if (!record) {
+                return PlanStage::NEED_TIME;
+            }
+        } else if (_lastSeenId.isNull() && !_params.start.isNull()) {
             record = _cursor->seekExact(_params.start);
         } else {
             // See if the record we're about to access is in memory. If not, pass a fetch
@@ -156,6 +194,17 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     }
 
     if (!record) {
+        if (!_wrapping && !_wrapStart.isNull()) {
+            // We joined a shared scan mid-collection and just finished its tail; circle back
+            // for the prefix we skipped. The next unit of work recreates the cursor at the
+            // start of the collection.
+            _sharedScan.reset();
+            _wrapping = true;
+            _lastSeenId = RecordId();
+            _cursor.reset();
+            return PlanStage::NEED_TIME;
+        }
+
         // We just hit EOF. If we are tailable and have already returned data, leave us in a
         // state to pick up where we left off on the next call to work(). Otherwise EOF is
         // permanent.
@@ -168,7 +217,21 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_wrapping && record->id >= _wrapStart) {
+        // The wrap-around pass has caught up with the position we originally joined at, so
+        // every record has now been visited exactly once.
+        _commonStats.isEOF = true;
+        return PlanStage::IS_EOF;
+    }
+
     _lastSeenId = record->id;
+    if (_sharedScan) {
+        _sharedScan->updatePosition(record->id);
+    }
+
+    if (shouldSkipRecord(record->id)) {
+        return PlanStage::NEED_TIME;
+    }
 
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
@@ -179,12 +242,160 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
     return returnIfMatches(member, id, out);
 }
 
+PlanStage::StageState CollectionScan::doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) {
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    *numOut = 0;
+
+    size_t unitsOfWork = 0;
+    while (unitsOfWork < max) {
+        // Anything outside the steady state (dead, EOF, cursor setup, seeking the start point,
+        // maxScan exhaustion) goes through doWork() one unit at a time; doWork() is final here,
+        // so the call binds statically.
+        const bool steadyState = !_isDead && !_commonStats.isEOF && _cursor &&
+            !(_lastSeenId.isNull() && !_params.start.isNull()) &&
+            (0 == _params.maxScan || _specificStats.docsTested < _params.maxScan);
+        if (!steadyState) {
+            ++unitsOfWork;
+            ++_commonStats.works;
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            StageState state = CollectionScan::doWork(&id);
+            if (PlanStage::ADVANCED == state) {
+                ++_commonStats.advanced;
+                out[(*numOut)++] = id;
+            } else if (PlanStage::NEED_TIME == state) {
+                ++_commonStats.needTime;
+            } else {
+                if (PlanStage::NEED_YIELD == state) {
+                    ++_commonStats.needYield;
+                }
+                out[*numOut] = id;
+                return state;
+            }
+            continue;
+        }
+
+        // Steady state: pull records and evaluate the filter directly on their BSON in a tight
+        // loop. Rejected documents never touch the WorkingSet; a member is allocated only once
+        // a record has passed the filter.
+        ++unitsOfWork;
+        ++_commonStats.works;
+
+        boost::optional<Record> record;
+        try {
+            // See if the record we're about to access is in memory. If not, pass a fetch
+            // request up.
+            if (auto fetcher = _cursor->fetcherForNext()) {
+                WorkingSetMember* member = _workingSet->get(_wsidForFetch);
+                member->setFetcher(fetcher.release());
+                ++_commonStats.needYield;
+                out[*numOut] = _wsidForFetch;
+                return PlanStage::NEED_YIELD;
+            }
+            record = _cursor->next();
+        } catch (const WriteConflictException&) {
+            ++_commonStats.needYield;
+            out[*numOut] = WorkingSet::INVALID_ID;
+            return PlanStage::NEED_YIELD;
+        }
+
+        if (!record) {
+            if (!_wrapping && !_wrapStart.isNull()) {
+                // Finished the tail of a joined shared scan; circle back for the skipped
+                // prefix. The next unit of work recreates the cursor via the doWork() path.
+                _sharedScan.reset();
+                _wrapping = true;
+                _lastSeenId = RecordId();
+                _cursor.reset();
+                ++_commonStats.needTime;
+                continue;
+            }
+
+            // We hit EOF; mirror doWork()'s handling of the tailable case.
+            if (_params.tailable && !_lastSeenId.isNull()) {
+                _cursor.reset();
+            } else {
+                _commonStats.isEOF = true;
+            }
+            out[*numOut] = WorkingSet::INVALID_ID;
+            return PlanStage::IS_EOF;
+        }
+
+        if (_wrapping && record->id >= _wrapStart) {
+            // The wrap-around pass has caught up with the join position; the scan is complete.
+            _commonStats.isEOF = true;
+            out[*numOut] = WorkingSet::INVALID_ID;
+            return PlanStage::IS_EOF;
+        }
+
+        _lastSeenId = record->id;
+        if (_sharedScan) {
+            _sharedScan->updatePosition(record->id);
+        }
+
+        if (shouldSkipRecord(record->id)) {
+            ++_commonStats.needTime;
+            continue;
+        }
+        ++_specificStats.docsTested;
+
+        if (_filter && !matchesFilter(record->data.toBson())) {
+            ++_commonStats.needTime;
+            continue;
+        }
+        if (_filter && _params.stopApplyingFilterAfterFirstMatch) {
+            _filter = nullptr;
+        }
+
+        WorkingSetID id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        member->recordId = record->id;
+        member->obj = {getOpCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson()};
+        _workingSet->transitionToRecordIdAndObj(id);
+
+        ++_commonStats.advanced;
+        out[(*numOut)++] = id;
+    }
+
+    out[*numOut] = WorkingSet::INVALID_ID;
+    return *numOut > 0 ? PlanStage::ADVANCED : PlanStage::NEED_TIME;
+}
+
+bool CollectionScan::shouldSkipRecord(const RecordId& id) {
+    if (!_zoneMap || !_filter) {
+        return false;
+    }
+    if (!_zoneSkipUntil.isNull()) {
+        if (id <= _zoneSkipUntil) {
+            return true;
+        }
+        _zoneSkipUntil = RecordId();
+    }
+    if (boost::optional<RecordId> bound = _zoneMap->skipUpperBound(id, _filter)) {
+        _zoneSkipUntil = *bound;
+        return true;
+    }
+    return false;
+}
+
+bool CollectionScan::matchesFilter(const BSONObj& obj) const {
+    if (_filterProgram) {
+        // The compiled program answers most documents without walking the expression tree; it
+        // punts back to the tree for documents whose shape needs full matcher semantics.
+        if (boost::optional<bool> matched = _filterProgram->tryMatch(obj)) {
+            return *matched;
+        }
+    }
+    return _filter->matchesBSON(obj);
+}
+
 PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID memberID,
                                                       WorkingSetID* out) {
     ++_specificStats.docsTested;
 
-    if (Filter::passes(member, _filter)) {
+    const bool passes = _filter && member->hasObj() ? matchesFilter(member->obj.value())
+                                                    : Filter::passes(member, _filter);
+    if (passes) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
         }
@@ -33,11 +33,14 @@
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/match_program.h"
 #include "mongo/db/record_id.h"
 
 namespace mongo {
 
+class CollectionZoneMap;
 class SeekableRecordCursor;
+class SharedScanParticipant;
 class WorkingSet;
 class OperationContext;
 
@@ -53,8 +56,10 @@ public:
                    const CollectionScanParams& params,
                    WorkingSet* workingSet,
                    const MatchExpression* filter);
+    ~CollectionScan();
 
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) final;
     bool isEOF() final;
 
     void doInvalidate(OperationContext* opCtx, const RecordId& dl, InvalidationType type) final;
@@ -80,6 +85,19 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Applies the filter to 'obj', preferring the compiled program over the expression tree.
+     * Must only be called while '_filter' is non-null.
+     */
+    bool matchesFilter(const BSONObj& obj) const;
+
+    /**
+     * Returns true when the record with 'id' may be skipped without materializing or filtering
+     * it, either because the collection's zone map proved its whole zone unmatchable or because
+     * a previously computed skip bound has not been reached yet.
+     */
+    bool shouldSkipRecord(const RecordId& id);
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
@@ -94,6 +112,31 @@ private:
 
     RecordId _lastSeenId;  // Null if nothing has been returned from _cursor yet.
 
+    // Non-null while this scan is registered with the SharedScanRegistry (leading or riding
+    // along with other scans of the same collection). Reset when the scan wraps around at EOF.
+    std::unique_ptr<SharedScanParticipant> _sharedScan;
+
+    // When non-null, the position this scan joined an in-flight shared scan at: the scan runs
+    // from there to EOF, then wraps around to the start of the collection and stops upon
+    // reaching this id again.
+    RecordId _wrapStart;
+
+    // True while scanning the skipped prefix after wrapping around at EOF.
+    bool _wrapping;
+
+    // A flattened form of '_filter', when the filter is a simple conjunction of comparisons.
+    // Null when the filter cannot be compiled, in which case '_filter' is evaluated directly.
+    std::unique_ptr<MatchProgram> _filterProgram;
+
+    // The collection's zone map, when this scan is eligible to consult it (forward,
+    // non-tailable, filtered scan whose filter touches a tracked field). Not owned; lives in
+    // the CollectionInfoCache, which outlives this stage.
+    const CollectionZoneMap* _zoneMap = nullptr;
+
+    // Last record id of a zone the zone map proved unmatchable; records up to and including it
+    // are skipped without being materialized or filtered. Null when not skipping.
+    RecordId _zoneSkipUntil;
+
     // We allocate a working set member with this id on construction of the stage. It gets used for
     // all fetch requests. This should only be used for passing up the Fetcher for a NEED_YIELD, and
     // should remain in the INVALID state.
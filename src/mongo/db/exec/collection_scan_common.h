@@ -59,6 +59,12 @@ struct CollectionScanParams {
 
     // If non-zero, how many documents will we look at?
     size_t maxScan = 0;
+
+    // If true, this scan may join an in-flight shared scan of the same collection, starting at
+    // that scan's position and wrapping around at EOF to cover the records before it. Results
+    // are then returned in rotated rather than natural order, so this must only be set when
+    // the caller does not care about document order.
+    bool allowSharedScan = false;
 };
 
 }  // namespace mongo
@@ -154,6 +154,99 @@ PlanStage::StageState CountStage::doWork(WorkingSetID* out) {
     return PlanStage::NEED_TIME;
 }
 
+PlanStage::StageState CountStage::doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) {
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    // This stage never returns working set members for its results.
+    *numOut = 0;
+
+    size_t unitsOfWork = 0;
+    while (unitsOfWork < max) {
+        if (_params.useRecordStoreCount || isEOF()) {
+            // The record store fast path and the EOF transition go through doWork() one unit at
+            // a time; doWork() is final here, so the call binds statically.
+            ++unitsOfWork;
+            ++_commonStats.works;
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            StageState state = CountStage::doWork(&id);
+            if (PlanStage::NEED_TIME == state) {
+                ++_commonStats.needTime;
+            } else {
+                if (PlanStage::NEED_YIELD == state) {
+                    ++_commonStats.needYield;
+                }
+                out[*numOut] = id;
+                return state;
+            }
+            continue;
+        }
+
+        invariant(child());
+
+        // Cap the batch at what the skip and limit still allow, so that we never draw results
+        // out of the child that an equivalent sequence of work() calls would not have.
+        size_t budget = max - unitsOfWork;
+        if (_params.limit > 0) {
+            budget = std::min(budget,
+                              static_cast<size_t>(_leftToSkip) +
+                                  static_cast<size_t>(_params.limit - _specificStats.nCounted));
+        }
+
+        _childBatch.resize(budget + 1);
+        size_t numResults = 0;
+        PlanStage::StageState state = child()->workBatch(_childBatch.data(), budget, &numResults);
+
+        for (size_t i = 0; i < numResults; i++) {
+            ++unitsOfWork;
+            ++_commonStats.works;
+            ++_commonStats.needTime;
+            if (_leftToSkip > 0) {
+                _leftToSkip--;
+                _specificStats.nSkipped++;
+            } else {
+                _specificStats.nCounted++;
+            }
+            // Count doesn't need the actual results, so we just discard the working set
+            // members that got returned from the child.
+            _ws->free(_childBatch[i]);
+        }
+
+        if (PlanStage::IS_EOF == state) {
+            ++_commonStats.works;
+            _commonStats.isEOF = true;
+            out[*numOut] = WorkingSet::INVALID_ID;
+            return PlanStage::IS_EOF;
+        } else if (PlanStage::DEAD == state) {
+            ++_commonStats.works;
+            out[*numOut] = WorkingSet::INVALID_ID;
+            return state;
+        } else if (PlanStage::FAILURE == state) {
+            ++_commonStats.works;
+            WorkingSetID id = _childBatch[numResults];
+            // If a stage fails, it may create a status WSM to indicate why it failed, in which
+            // case 'id' is valid. If ID is invalid, we create our own error message.
+            if (WorkingSet::INVALID_ID == id) {
+                const std::string errmsg = "count stage failed to read result from child";
+                Status status = Status(ErrorCodes::InternalError, errmsg);
+                id = WorkingSetCommon::allocateStatusMember(_ws, status);
+            }
+            out[*numOut] = id;
+            return state;
+        } else if (PlanStage::NEED_YIELD == state) {
+            ++_commonStats.works;
+            ++_commonStats.needYield;
+            out[*numOut] = _childBatch[numResults];
+            return PlanStage::NEED_YIELD;
+        }
+
+        // ADVANCED or NEED_TIME: the child's budget is spent, so charge the units it consumed
+        // without producing a result against our own budget as well.
+        unitsOfWork += budget - numResults;
+    }
+
+    out[*numOut] = WorkingSet::INVALID_ID;
+    return PlanStage::NEED_TIME;
+}
+
 unique_ptr<PlanStageStats> CountStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_COUNT);
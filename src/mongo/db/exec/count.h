@@ -79,6 +79,7 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) final;
 
     StageType stageType() const final {
         return STAGE_COUNT;
@@ -107,6 +108,10 @@ private:
     // The number of documents that we still need to skip.
     long long _leftToSkip;
 
+    // Results drained from the child by doWorkBatch(). Only holds data while a batch is being
+    // counted; kept as a member to reuse its allocation across batches.
+    std::vector<WorkingSetID> _childBatch;
+
     // The working set used to pass intermediate results between stages. Not owned
     // by us.
     WorkingSet* _ws;
@@ -142,6 +142,85 @@ PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState CountScan::doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) {
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    *numOut = 0;
+
+    size_t unitsOfWork = 0;
+    while (unitsOfWork < max) {
+        if (_commonStats.isEOF || !_cursor) {
+            // Cursor init and EOF go through doWork() one unit at a time; doWork() is final
+            // here, so the call binds statically.
+            ++unitsOfWork;
+            ++_commonStats.works;
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            StageState state = CountScan::doWork(&id);
+            if (PlanStage::ADVANCED == state) {
+                ++_commonStats.advanced;
+                out[(*numOut)++] = id;
+            } else if (PlanStage::NEED_TIME == state) {
+                ++_commonStats.needTime;
+            } else {
+                if (PlanStage::NEED_YIELD == state) {
+                    ++_commonStats.needYield;
+                }
+                out[*numOut] = id;
+                return state;
+            }
+            continue;
+        }
+
+        // Steady state: pull the remaining work budget's worth of entries out of the index in
+        // one crossing of the storage API. Count never looks at the keys, and only needs the
+        // RecordId when the index could contain duplicates.
+        const auto parts = _shouldDedup ? SortedDataInterface::Cursor::kWantLoc
+                                        : SortedDataInterface::Cursor::kJustExistance;
+        _batchBuffer.clear();
+        try {
+            _cursor->nextBatch(&_batchBuffer, max - unitsOfWork, parts);
+        } catch (const WriteConflictException&) {
+            // Entries read before the conflict are still valid; only surface the yield request
+            // if the conflict prevented any progress.
+            if (_batchBuffer.empty()) {
+                ++_commonStats.works;
+                ++_commonStats.needYield;
+                out[*numOut] = WorkingSet::INVALID_ID;
+                return PlanStage::NEED_YIELD;
+            }
+        }
+
+        if (_batchBuffer.empty()) {
+            // The cursor is exhausted; mirror doWork()'s EOF transition.
+            ++_commonStats.works;
+            ++_specificStats.keysExamined;
+            _commonStats.isEOF = true;
+            _cursor.reset();
+            out[*numOut] = WorkingSet::INVALID_ID;
+            return PlanStage::IS_EOF;
+        }
+
+        for (size_t i = 0; i < _batchBuffer.size(); i++) {
+            ++unitsOfWork;
+            ++_commonStats.works;
+            ++_specificStats.keysExamined;
+
+            if (_shouldDedup && !_returned.insert(_batchBuffer[i].loc).second) {
+                // *loc was already in _returned.
+                ++_commonStats.needTime;
+                continue;
+            }
+
+            WorkingSetID id = _workingSet->allocate();
+            _workingSet->transitionToRecordIdAndObj(id);
+            ++_commonStats.advanced;
+            out[(*numOut)++] = id;
+        }
+    }
+
+    out[*numOut] = WorkingSet::INVALID_ID;
+    return *numOut > 0 ? PlanStage::ADVANCED : PlanStage::NEED_TIME;
+}
+
 bool CountScan::isEOF() {
     return _commonStats.isEOF;
 }
@@ -70,6 +70,7 @@ public:
     CountScan(OperationContext* opCtx, const CountScanParams& params, WorkingSet* workingSet);
 
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) final;
     bool isEOF() final;
     void doSaveState() final;
     void doRestoreState() final;
@@ -97,6 +98,11 @@ private:
 
     std::unique_ptr<SortedDataInterface::Cursor> _cursor;
 
+    // Entries read ahead from '_cursor' by doWorkBatch(). Only holds data while a batch is being
+    // counted; it is drained before doWorkBatch() returns, so no entry is held across a yield.
+    // Kept as a member to reuse its allocation across batches.
+    std::vector<IndexKeyEntry> _batchBuffer;
+
     // Could our index have duplicates?  If so, we use _returned to dedup.
     bool _shouldDedup;
     unordered_set<RecordId, RecordId::Hasher> _returned;
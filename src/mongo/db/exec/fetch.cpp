@@ -46,6 +46,35 @@ using std::unique_ptr;
 using std::vector;
 using stdx::make_unique;
 
+namespace {
+
+/**
+ * A RecordFetcher that pages in several records during one yield by forwarding to the fetchers
+ * for each of them.
+ */
+class BatchedRecordFetcher : public RecordFetcher {
+public:
+    explicit BatchedRecordFetcher(vector<unique_ptr<RecordFetcher>> fetchers)
+        : _fetchers(std::move(fetchers)) {}
+
+    void setup(OperationContext* opCtx) final {
+        for (auto&& fetcher : _fetchers) {
+            fetcher->setup(opCtx);
+        }
+    }
+
+    void fetch() final {
+        for (auto&& fetcher : _fetchers) {
+            fetcher->fetch();
+        }
+    }
+
+private:
+    vector<unique_ptr<RecordFetcher>> _fetchers;
+};
+
+}  // namespace
+
 // static
 const char* FetchStage::kStageType = "FETCH";
 
@@ -58,7 +87,9 @@ FetchStage::FetchStage(OperationContext* opCtx,
       _collection(collection),
       _ws(ws),
       _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _filterProgram(MatchProgram::compile(filter)),
+      _idRetrying(WorkingSet::INVALID_ID),
+      _batchPos(0) {
     _children.emplace_back(child);
 }
 
@@ -71,6 +102,11 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (_batchPos < _batchBuffer.size()) {
+        // We are still holding results pulled from our child by doWorkBatch().
+        return false;
+    }
+
     return child()->isEOF();
 }
 
@@ -79,58 +115,23 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    // Either retry the last WSM we worked on or get a new one from our child.
+    // Either retry the last WSM we worked on, drain a result already pulled from our child by
+    // doWorkBatch(), or get a new one from our child.
     WorkingSetID id;
     StageState status;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        status = child()->work(&id);
-    } else {
+    if (_idRetrying != WorkingSet::INVALID_ID) {
         status = ADVANCED;
         id = _idRetrying;
         _idRetrying = WorkingSet::INVALID_ID;
+    } else if (_batchPos < _batchBuffer.size()) {
+        status = ADVANCED;
+        id = _batchBuffer[_batchPos++];
+    } else {
+        status = child()->work(&id);
     }
 
     if (PlanStage::ADVANCED == status) {
-        WorkingSetMember* member = _ws->get(id);
-
-        // If there's an obj there, there is no fetching to perform.
-        if (member->hasObj()) {
-            ++_specificStats.alreadyHasObj;
-        } else {
-            // We need a valid RecordId to fetch from and this is the only state that has one.
-            verify(WorkingSetMember::RID_AND_IDX == member->getState());
-            verify(member->hasRecordId());
-
-            try {
-                if (!_cursor)
-                    _cursor = _collection->getCursor(getOpCtx());
-
-                if (auto fetcher = _cursor->fetcherForId(member->recordId)) {
-                    // There's something to fetch. Hand the fetcher off to the WSM, and pass up
-                    // a fetch request.
-                    _idRetrying = id;
-                    member->setFetcher(fetcher.release());
-                    *out = id;
-                    return NEED_YIELD;
-                }
-
-                // The doc is already in memory, so go ahead and grab it. Now we have a RecordId
-                // as well as an unowned object
-                if (!WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor)) {
-                    _ws->free(id);
-                    return NEED_TIME;
-                }
-            } catch (const WriteConflictException&) {
-                // Ensure that the BSONObj underlying the WorkingSetMember is owned because it may
-                // be freed when we yield.
-                member->makeObjOwnedIfNeeded();
-                _idRetrying = id;
-                *out = WorkingSet::INVALID_ID;
-                return NEED_YIELD;
-            }
-        }
-
-        return returnIfMatches(member, id, out);
+        return fetchMember(id, out);
     } else if (PlanStage::FAILURE == status || PlanStage::DEAD == status) {
         *out = id;
         // If a stage fails, it may create a status WSM to indicate why it
@@ -150,6 +151,156 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) {
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    *numOut = 0;
+
+    for (size_t unitsOfWork = 0; unitsOfWork < max; ++unitsOfWork) {
+        ++_commonStats.works;
+
+        if (isEOF()) {
+            out[*numOut] = WorkingSet::INVALID_ID;
+            return PlanStage::IS_EOF;
+        }
+
+        // Either retry the last WSM we worked on, drain a result already pulled from our child,
+        // or refill the buffer with the child's next batch.
+        WorkingSetID id;
+        if (_idRetrying != WorkingSet::INVALID_ID) {
+            id = _idRetrying;
+            _idRetrying = WorkingSet::INVALID_ID;
+        } else if (_batchPos < _batchBuffer.size()) {
+            id = _batchBuffer[_batchPos++];
+        } else {
+            _batchBuffer.clear();
+            _batchPos = 0;
+            _batchBuffer.resize(max + 1);
+            size_t numChild = 0;
+            StageState childStatus = child()->workBatch(_batchBuffer.data(), max, &numChild);
+            WorkingSetID childId = _batchBuffer[numChild];
+            _batchBuffer.resize(numChild);
+
+            if (PlanStage::FAILURE == childStatus || PlanStage::DEAD == childStatus) {
+                out[*numOut] = childId;
+                // If a stage fails, it may create a status WSM to indicate why it
+                // failed, in which case 'childId' is valid.  If it is invalid, we
+                // create our own error message.
+                if (WorkingSet::INVALID_ID == childId) {
+                    mongoutils::str::stream ss;
+                    ss << "fetch stage failed to read in results from child";
+                    Status status(ErrorCodes::InternalError, ss);
+                    out[*numOut] = WorkingSetCommon::allocateStatusMember(_ws, status);
+                }
+                return childStatus;
+            } else if (PlanStage::NEED_YIELD == childStatus) {
+                // Anything already buffered is picked up after the yield.
+                ++_commonStats.needYield;
+                out[*numOut] = childId;
+                return childStatus;
+            } else if (_batchBuffer.empty()) {
+                if (PlanStage::IS_EOF == childStatus) {
+                    out[*numOut] = WorkingSet::INVALID_ID;
+                    return childStatus;
+                }
+                ++_commonStats.needTime;
+                continue;
+            }
+
+            id = _batchBuffer[_batchPos++];
+        }
+
+        StageState status = fetchMember(id, &out[*numOut]);
+        if (PlanStage::ADVANCED == status) {
+            ++_commonStats.advanced;
+            ++(*numOut);
+        } else if (PlanStage::NEED_TIME == status) {
+            ++_commonStats.needTime;
+        } else {
+            invariant(PlanStage::NEED_YIELD == status);
+            // fetchMember() stashed 'id' in '_idRetrying' and set the out-parameter the way a
+            // single work() call would have; anything left in '_batchBuffer' is picked up after
+            // the yield.
+            ++_commonStats.needYield;
+            if (WorkingSet::INVALID_ID != out[*numOut]) {
+                // The member is waiting on a page-in (rather than a write conflict). Overlap the
+                // other cold records we are already holding with the same yield.
+                addPrefetchCandidates(_ws->get(out[*numOut]));
+            }
+            return status;
+        }
+    }
+
+    out[*numOut] = WorkingSet::INVALID_ID;
+    return *numOut > 0 ? PlanStage::ADVANCED : PlanStage::NEED_TIME;
+}
+
+void FetchStage::addPrefetchCandidates(WorkingSetMember* member) {
+    vector<unique_ptr<RecordFetcher>> fetchers;
+    for (size_t i = _batchPos; i < _batchBuffer.size(); i++) {
+        WorkingSetMember* buffered = _ws->get(_batchBuffer[i]);
+        if (buffered->hasObj() || !buffered->hasRecordId()) {
+            continue;
+        }
+        if (auto fetcher = _cursor->fetcherForId(buffered->recordId)) {
+            fetchers.push_back(std::move(fetcher));
+        }
+    }
+
+    if (fetchers.empty()) {
+        return;
+    }
+
+    _specificStats.docsPrefetched += fetchers.size();
+
+    // The member's own fetcher runs first so its record is resident even if a later prefetch
+    // misbehaves.
+    fetchers.insert(fetchers.begin(), unique_ptr<RecordFetcher>(member->releaseFetcher()));
+    member->setFetcher(new BatchedRecordFetcher(std::move(fetchers)));
+}
+
+PlanStage::StageState FetchStage::fetchMember(WorkingSetID id, WorkingSetID* out) {
+    WorkingSetMember* member = _ws->get(id);
+
+    // If there's an obj there, there is no fetching to perform.
+    if (member->hasObj()) {
+        ++_specificStats.alreadyHasObj;
+    } else {
+        // We need a valid RecordId to fetch from and this is the only state that has one.
+        verify(WorkingSetMember::RID_AND_IDX == member->getState());
+        verify(member->hasRecordId());
+
+        try {
+            if (!_cursor)
+                _cursor = _collection->getCursor(getOpCtx());
+
+            if (auto fetcher = _cursor->fetcherForId(member->recordId)) {
+                // There's something to fetch. Hand the fetcher off to the WSM, and pass up
+                // a fetch request.
+                _idRetrying = id;
+                member->setFetcher(fetcher.release());
+                *out = id;
+                return NEED_YIELD;
+            }
+
+            // The doc is already in memory, so go ahead and grab it. Now we have a RecordId
+            // as well as an unowned object
+            if (!WorkingSetCommon::fetch(getOpCtx(), _ws, id, _cursor)) {
+                _ws->free(id);
+                return NEED_TIME;
+            }
+        } catch (const WriteConflictException&) {
+            // Ensure that the BSONObj underlying the WorkingSetMember is owned because it may
+            // be freed when we yield.
+            member->makeObjOwnedIfNeeded();
+            _idRetrying = id;
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+    }
+
+    return returnIfMatches(member, id, out);
+}
+
 void FetchStage::doSaveState() {
     if (_cursor)
         _cursor->saveUnpositioned();
@@ -180,6 +331,14 @@ void FetchStage::doInvalidate(OperationContext* opCtx, const RecordId& dl, Inval
             WorkingSetCommon::fetchAndInvalidateRecordId(opCtx, member, _collection);
         }
     }
+
+    // The same goes for anything still buffered by doWorkBatch().
+    for (size_t i = _batchPos; i < _batchBuffer.size(); i++) {
+        WorkingSetMember* member = _ws->get(_batchBuffer[i]);
+        if (member->hasRecordId() && (member->recordId == dl)) {
+            WorkingSetCommon::fetchAndInvalidateRecordId(opCtx, member, _collection);
+        }
+    }
 }
 
 PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
@@ -201,7 +360,9 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     // predicate.
     ++_specificStats.docsExamined;
 
-    if (Filter::passes(member, _filter)) {
+    const bool passes = _filter && member->hasObj() ? matchesFilter(member->obj.value())
+                                                    : Filter::passes(member, _filter);
+    if (passes) {
         *out = memberID;
         return PlanStage::ADVANCED;
     } else {
@@ -210,6 +371,15 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     }
 }
 
+bool FetchStage::matchesFilter(const BSONObj& obj) const {
+    if (_filterProgram) {
+        if (boost::optional<bool> matched = _filterProgram->tryMatch(obj)) {
+            return *matched;
+        }
+    }
+    return _filter->matchesBSON(obj);
+}
+
 unique_ptr<PlanStageStats> FetchStage::getStats() {
     _commonStats.isEOF = isEOF();
 
@@ -29,10 +29,12 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/match_program.h"
 #include "mongo/db/record_id.h"
 
 namespace mongo {
@@ -59,6 +61,7 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) final;
 
     void doSaveState() final;
     void doRestoreState() final;
@@ -83,6 +86,28 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Runs '_filter' against 'obj', preferring the flat '_filterProgram' over the tree walk.
+     * Must only be called when '_filter' is non-null.
+     */
+    bool matchesFilter(const BSONObj& obj) const;
+
+    /**
+     * Reads the record backing the member with id 'id' if it does not already have an object,
+     * then runs it through our filter. Returns ADVANCED with *out set to 'id' on a match,
+     * NEED_TIME otherwise, and NEED_YIELD (stashing 'id' in '_idRetrying') if the record must
+     * be paged in or the read hit a write conflict.
+     */
+    StageState fetchMember(WorkingSetID id, WorkingSetID* out);
+
+    /**
+     * Called when 'member' is about to be passed up with a fetch request. Piggybacks prefetches
+     * for any other buffered records that are also out of cache onto the same yield by
+     * replacing the member's fetcher with one that pages them all in, so a single yield brings
+     * in up to a whole batch's worth of cold documents.
+     */
+    void addPrefetchCandidates(WorkingSetMember* member);
+
     // Collection which is used by this stage. Used to resolve record ids retrieved by child
     // stages. The lifetime of the collection must supersede that of the stage.
     const Collection* _collection;
@@ -95,9 +120,19 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Compiled form of '_filter' for the simple-conjunction shapes MatchProgram supports;
+    // null otherwise. Holds pointers into '_filter', so it must not outlive it.
+    std::unique_ptr<MatchProgram> _filterProgram;
+
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // Ids pulled from our child by doWorkBatch() but not yet fetched, consumed in order starting
+    // at '_batchPos'. Like '_idRetrying', buffered members are force-fetched by doInvalidate()
+    // if the records they reference go away while we hold them.
+    std::vector<WorkingSetID> _batchBuffer;
+    size_t _batchPos;
+
     // Stats
     FetchStats _specificStats;
 };
@@ -99,16 +99,10 @@ struct StoredGeometry {
 }
 
 /**
- * Find and parse all geometry elements on the appropriate field path from the document.
+ * Parse all geometry elements found on the appropriate field path from the document.
  */
-static void extractGeometries(const BSONObj& doc,
-                              const string& path,
+static void extractGeometries(const BSONElementSet& geomElements,
                               std::vector<std::unique_ptr<StoredGeometry>>* geometries) {
-    BSONElementSet geomElements;
-    // NOTE: Annoyingly, we cannot just expand arrays b/c single 2d points are arrays, we need
-    // to manually expand all results to check if they are geometries
-    dps::extractAllElementsAlongPath(doc, path, geomElements, false /* expand arrays */);
-
     for (BSONElementSet::iterator it = geomElements.begin(); it != geomElements.end(); ++it) {
         const BSONElement& el = *it;
         unique_ptr<StoredGeometry> stored(StoredGeometry::parseFrom(el));
@@ -137,6 +131,39 @@ static void extractGeometries(const BSONObj& doc,
     }
 }
 
+/**
+ * Attaches the requested distance/point metadata to the member and converts the minimum
+ * distance to the units expected by the caller. Shared tail of computeGeoNearDistance().
+ */
+static StatusWith<double> reportGeoNearDistance(const GeoNearParams& nearParams,
+                                                WorkingSetMember* member,
+                                                double minDistance,
+                                                const BSONObj& minDistanceObj) {
+    CRS queryCRS = nearParams.nearQuery->centroid->crs;
+
+    if (minDistance < 0) {
+        // No distance to report
+        return StatusWith<double>(-1);
+    }
+
+    if (nearParams.addDistMeta) {
+        if (nearParams.nearQuery->unitsAreRadians) {
+            // Hack for nearSphere
+            // TODO: Remove nearSphere?
+            invariant(SPHERE == queryCRS);
+            member->addComputed(new GeoDistanceComputedData(minDistance / kRadiusOfEarthInMeters));
+        } else {
+            member->addComputed(new GeoDistanceComputedData(minDistance));
+        }
+    }
+
+    if (nearParams.addPointMeta) {
+        member->addComputed(new GeoNearPointComputedData(minDistanceObj));
+    }
+
+    return StatusWith<double>(minDistance);
+}
+
 static StatusWith<double> computeGeoNearDistance(const GeoNearParams& nearParams,
                                                  WorkingSetMember* member) {
     //
@@ -150,9 +177,35 @@ static StatusWith<double> computeGeoNearDistance(const GeoNearParams& nearParams
 
     CRS queryCRS = nearParams.nearQuery->centroid->crs;
 
+    BSONElementSet geomElements;
+    // NOTE: Annoyingly, we cannot just expand arrays b/c single 2d points are arrays, we need
+    // to manually expand all results to check if they are geometries
+    dps::extractAllElementsAlongPath(
+        member->obj.value(), nearParams.nearQuery->field, geomElements, false /* expand arrays */);
+
+    // Fast path for the overwhelmingly common candidate shape: a single stored geometry
+    // (usually the one indexed point). Parses into a stack container and skips the
+    // per-geometry heap bookkeeping of the general path below. Distances are computed per
+    // buffered document, so this runs for every candidate the annulus scans produce.
+    if (geomElements.size() == 1u && geomElements.begin()->isABSONObj()) {
+        const BSONElement& el = *geomElements.begin();
+        GeometryContainer geometry;
+        if (geometry.parseFromStorage(el, true).isOK()) {
+            if (!geometry.supportsProject(queryCRS)) {
+                // No distance to report (see the CRS notes on the general path).
+                return StatusWith<double>(-1);
+            }
+            geometry.projectInto(queryCRS);
+            double minDistance = geometry.minDistance(*nearParams.nearQuery->centroid);
+            return reportGeoNearDistance(nearParams, member, minDistance, el.Obj());
+        }
+        // The element may be an array of geometries or malformed; let the general path
+        // expand and warn as before.
+    }
+
     // Extract all the geometries out of this document for the near query
     std::vector<std::unique_ptr<StoredGeometry>> geometries;
-    extractGeometries(member->obj.value(), nearParams.nearQuery->field, &geometries);
+    extractGeometries(geomElements, &geometries);
 
     // Compute the minimum distance of all the geometries in the document
     double minDistance = -1;
@@ -180,27 +233,7 @@ static StatusWith<double> computeGeoNearDistance(const GeoNearParams& nearParams
         }
     }
 
-    if (minDistance < 0) {
-        // No distance to report
-        return StatusWith<double>(-1);
-    }
-
-    if (nearParams.addDistMeta) {
-        if (nearParams.nearQuery->unitsAreRadians) {
-            // Hack for nearSphere
-            // TODO: Remove nearSphere?
-            invariant(SPHERE == queryCRS);
-            member->addComputed(new GeoDistanceComputedData(minDistance / kRadiusOfEarthInMeters));
-        } else {
-            member->addComputed(new GeoDistanceComputedData(minDistance));
-        }
-    }
-
-    if (nearParams.addPointMeta) {
-        member->addComputed(new GeoNearPointComputedData(minDistanceObj));
-    }
-
-    return StatusWith<double>(minDistance);
+    return reportGeoNearDistance(nearParams, member, minDistance, minDistanceObj);
 }
 
 static R2Annulus geoNearDistanceBounds(const GeoNearExpression& query) {
@@ -30,6 +30,10 @@
 
 #include "mongo/db/exec/group.h"
 
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/collection.h"
@@ -71,6 +75,10 @@ Status getKey(
     return Status::OK();
 }
 
+bool isIdentifierChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
 }  // namespace
 
 // static
@@ -87,8 +95,162 @@ GroupStage::GroupStage(OperationContext* opCtx,
       _groupState(GroupState_Initializing),
       _reduceFunction(0),
       _keyFunction(0),
-      _groupMap(SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<int>()) {
+      _groupMap(SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<int>()),
+      _nativeMode(false) {
     _children.emplace_back(child);
+
+    // Execute the reduce step natively when the group spec is expressible without JavaScript:
+    // the key is extracted with a key pattern, the reduce function is a sequence of simple
+    // accumulations, and each accumulated field starts from a plain numeric initial value.
+    // Everything else runs through the scripting engine as before.
+    if (_request.keyFunctionCode.empty() && _request.reduceScope.isEmpty() &&
+        parseNativeReduce(_request.reduceCode, &_nativeOps, &_nativeFields)) {
+        _nativeMode = true;
+        for (size_t i = 0; i < _nativeFields.size(); i++) {
+            BSONElement init = _request.initial[_nativeFields[i]];
+            if (init.type() != NumberInt && init.type() != NumberDouble) {
+                // NumberLong and NumberDecimal initial values become wrapper objects in
+                // JavaScript, with very different "+=" semantics.  Leave those to the scripts.
+                _nativeMode = false;
+                break;
+            }
+            _nativeInitialValues.push_back(init.number());
+        }
+        if (!_nativeMode) {
+            _nativeOps.clear();
+            _nativeFields.clear();
+            _nativeInitialValues.clear();
+        }
+    }
+}
+
+// static
+bool GroupStage::parseNativeReduce(const std::string& reduceCode,
+                                   std::vector<NativeReduceOp>* ops,
+                                   std::vector<std::string>* fields) {
+    // Parse a whitespace-stripped copy of the source, so that statements can be matched
+    // without worrying about formatting.
+    std::string src;
+    src.reserve(reduceCode.size());
+    for (size_t i = 0; i < reduceCode.size(); i++) {
+        if (!std::isspace(static_cast<unsigned char>(reduceCode[i]))) {
+            src.push_back(reduceCode[i]);
+        }
+    }
+
+    size_t pos = 0;
+
+    auto literal = [&](StringData lit) {
+        if (src.compare(pos, lit.size(), lit.rawData(), lit.size()) != 0) {
+            return false;
+        }
+        pos += lit.size();
+        return true;
+    };
+
+    auto identifier = [&]() -> std::string {
+        size_t start = pos;
+        while (pos < src.size() && isIdentifierChar(src[pos])) {
+            pos++;
+        }
+        if (pos == start || std::isdigit(static_cast<unsigned char>(src[start]))) {
+            pos = start;
+            return std::string();
+        }
+        return src.substr(start, pos - start);
+    };
+
+    // Match "function [name] ( <docParam> , <aggParam> ) {", remembering the parameter names.
+    if (!literal("function")) {
+        return false;
+    }
+    identifier();  // An optional function name.
+    if (!literal("(")) {
+        return false;
+    }
+    const std::string docParam = identifier();
+    if (docParam.empty() || !literal(",")) {
+        return false;
+    }
+    const std::string aggParam = identifier();
+    if (aggParam.empty() || !literal(")") || !literal("{")) {
+        return false;
+    }
+    if (src.empty() || src.back() != '}') {
+        return false;
+    }
+    const size_t end = src.size() - 1;
+
+    // Match the body: one or more statements of the form "<aggParam>.field += <operand>;" or
+    // "<aggParam>.field++;", where <operand> is either a numeric literal or a (possibly
+    // dotted) path into <docParam>.  The trailing semicolon is optional on the last statement.
+    while (pos < end) {
+        if (!literal(aggParam) || !literal(".")) {
+            return false;
+        }
+        const std::string field = identifier();
+        if (field.empty() || pos > end) {
+            return false;
+        }
+
+        NativeReduceOp op;
+        op.constant = 0;
+        if (literal("++")) {
+            op.constant = 1;
+        } else if (literal("+=")) {
+            if (pos < end && std::isdigit(static_cast<unsigned char>(src[pos]))) {
+                size_t start = pos;
+                while (pos < end &&
+                       (std::isdigit(static_cast<unsigned char>(src[pos])) || src[pos] == '.')) {
+                    pos++;
+                }
+                char* parseEnd = NULL;
+                const std::string num = src.substr(start, pos - start);
+                op.constant = std::strtod(num.c_str(), &parseEnd);
+                if (parseEnd != num.c_str() + num.size()) {
+                    return false;
+                }
+            } else {
+                if (!literal(docParam) || !literal(".")) {
+                    return false;
+                }
+                std::string path = identifier();
+                if (path.empty()) {
+                    return false;
+                }
+                while (pos < end && src[pos] == '.') {
+                    pos++;
+                    const std::string component = identifier();
+                    if (component.empty()) {
+                        return false;
+                    }
+                    path += '.';
+                    path += component;
+                }
+                op.sourcePath = path;
+            }
+        } else {
+            return false;
+        }
+
+        if (!literal(";") && pos != end) {
+            return false;
+        }
+
+        op.fieldIndex = fields->size();
+        for (size_t i = 0; i < fields->size(); i++) {
+            if ((*fields)[i] == field) {
+                op.fieldIndex = i;
+                break;
+            }
+        }
+        if (op.fieldIndex == fields->size()) {
+            fields->push_back(field);
+        }
+        ops->push_back(op);
+    }
+
+    return pos == end && !ops->empty();
 }
 
 Status GroupStage::initGroupScripting() {
@@ -133,7 +295,171 @@ Status GroupStage::initGroupScripting() {
     return Status::OK();
 }
 
+StatusWith<bool> GroupStage::processObjectNative(const BSONObj& obj) {
+    // Evaluate every operand up front, so that no group state has changed yet if one of them
+    // forces a fallback to the scripting path.
+    std::vector<double>& operands = _nativeOperandScratch;
+    operands.resize(_nativeOps.size());
+    for (size_t i = 0; i < _nativeOps.size(); i++) {
+        const NativeReduceOp& op = _nativeOps[i];
+        if (op.sourcePath.empty()) {
+            operands[i] = op.constant;
+            continue;
+        }
+
+        BSONElement elt = dps::extractElementAtPath(obj, op.sourcePath);
+        switch (elt.type()) {
+            case NumberInt:
+            case NumberDouble:
+                operands[i] = elt.number();
+                break;
+            case Bool:
+                // JavaScript coerces booleans to 0 or 1 in "+=".
+                operands[i] = elt.boolean() ? 1 : 0;
+                break;
+            case jstNULL:
+                // JavaScript coerces null to 0 in "+=".
+                operands[i] = 0;
+                break;
+            case EOO:
+            case Undefined:
+                // A missing or undefined field accumulates as NaN, unless the path is dotted,
+                // where a missing intermediate object would make the script throw a TypeError.
+                // Fall back so that the user-visible error is produced faithfully.
+                if (op.sourcePath.find('.') != std::string::npos) {
+                    return false;
+                }
+                operands[i] = std::numeric_limits<double>::quiet_NaN();
+                break;
+            default:
+                // Strings concatenate, NumberLong and NumberDecimal are wrapper objects, dates
+                // stringify, and so on.  Leave all of those to the scripting engine.
+                return false;
+        }
+    }
+
+    BSONObj key = dps::extractElementsBasedOnTemplate(obj, _request.keyPattern, true).getOwned();
+
+    int& n = _groupMap[key];
+    if (n == 0) {
+        n = _groupMap.size();
+        if (n > 20000) {
+            return Status(ErrorCodes::BadValue, "group() can't handle more than 20000 unique keys");
+        }
+        NativeGroup group;
+        group.key = key;
+        group.values = _nativeInitialValues;
+        _nativeGroups.push_back(std::move(group));
+    }
+
+    NativeGroup& group = _nativeGroups[n - 1];
+    for (size_t i = 0; i < _nativeOps.size(); i++) {
+        group.values[_nativeOps[i].fieldIndex] += operands[i];
+    }
+
+    return true;
+}
+
+void GroupStage::appendNativeGroup(const NativeGroup& group, BSONObjBuilder* builder) const {
+    // Reproduce what the scripting path builds: a fresh object extended first with $key, then
+    // with $initial (overwriting in place), with the accumulated fields holding their final
+    // values.  Numbers coming back from a plain JavaScript object are always doubles, so
+    // top-level NumberInt values from the key or the initial object are appended as doubles.
+    auto appendCoerced = [&](BSONElement elt) {
+        if (elt.type() == NumberInt) {
+            builder->append(elt.fieldNameStringData(), elt.numberDouble());
+        } else {
+            builder->append(elt);
+        }
+    };
+
+    auto accumulatedIndex = [&](StringData field) -> int {
+        for (size_t i = 0; i < _nativeFields.size(); i++) {
+            if (field == _nativeFields[i]) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    };
+
+    BSONForEach(keyElt, group.key) {
+        StringData field = keyElt.fieldNameStringData();
+        int idx = accumulatedIndex(field);
+        if (idx >= 0) {
+            builder->append(field, group.values[idx]);
+        } else if (_request.initial.hasField(field)) {
+            // Object.extend($initial, true) overwrites the key's value but keeps its position.
+            appendCoerced(_request.initial[field]);
+        } else {
+            appendCoerced(keyElt);
+        }
+    }
+    BSONForEach(initElt, _request.initial) {
+        StringData field = initElt.fieldNameStringData();
+        if (group.key.hasField(field)) {
+            continue;
+        }
+        int idx = accumulatedIndex(field);
+        if (idx >= 0) {
+            builder->append(field, group.values[idx]);
+        } else {
+            appendCoerced(initElt);
+        }
+    }
+}
+
+BSONObj GroupStage::materializeNativeResults() const {
+    BSONArrayBuilder arrBuilder;
+    for (size_t i = 0; i < _nativeGroups.size(); i++) {
+        BSONObjBuilder groupBuilder(arrBuilder.subobjStart());
+        appendNativeGroup(_nativeGroups[i], &groupBuilder);
+    }
+    return arrBuilder.obj();
+}
+
+Status GroupStage::transitionToScripting() {
+    Status status = initGroupScripting();
+    if (!status.isOK()) {
+        return status;
+    }
+
+    // Seed "$arr" with the partial results accumulated so far, so that the scripts pick up
+    // exactly where the native reduce stopped.  _groupMap already holds the key => index
+    // mapping, and the reduce wrapper only consults $key when $arr[n] is null.
+    if (!_nativeGroups.empty()) {
+        _scope->setObject("$partials", materializeNativeResults(), true);
+        invariant(_scope->exec(
+            "for (var i in $partials) { $arr[Number(i)] = $partials[i]; } $partials = null;",
+            "group native seed",
+            false,
+            true,
+            false /*assertOnError*/,
+            2 * 1000));
+    }
+
+    _nativeGroups.clear();
+    _nativeMode = false;
+    return Status::OK();
+}
+
 Status GroupStage::processObject(const BSONObj& obj) {
+    if (_nativeMode) {
+        StatusWith<bool> handled = processObjectNative(obj);
+        if (!handled.isOK()) {
+            return handled.getStatus();
+        }
+        if (handled.getValue()) {
+            return Status::OK();
+        }
+
+        // The object holds a value whose coercion the native reduce cannot reproduce.  Hand
+        // the accumulated state over to the scripting path and reprocess the object there.
+        Status status = transitionToScripting();
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
     BSONObj key;
     Status getKeyStatus = getKey(obj, _request.keyPattern, _keyFunction, _scope.get(), &key);
     if (!getKeyStatus.isOK()) {
@@ -165,6 +491,20 @@ Status GroupStage::processObject(const BSONObj& obj) {
 }
 
 StatusWith<BSONObj> GroupStage::finalizeResults() {
+    if (_nativeMode) {
+        if (_request.finalize.empty()) {
+            _specificStats.nGroups = _groupMap.size();
+            _specificStats.nativeReduce = true;
+            return materializeNativeResults();
+        }
+        // The finalize function still runs in JavaScript, over the natively built results.
+        // This is one script invocation per group rather than one per document.
+        Status status = transitionToScripting();
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
     if (!_request.finalize.empty()) {
         try {
             _scope->exec("$finalize = " + _request.finalize,
@@ -207,12 +547,15 @@ PlanStage::StageState GroupStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    // On the first call to work(), call initGroupScripting().
+    // On the first call to work(), call initGroupScripting().  A native reduce needs no
+    // scripting machinery unless a document later forces a fallback.
     if (_groupState == GroupState_Initializing) {
-        Status status = initGroupScripting();
-        if (!status.isOK()) {
-            *out = WorkingSetCommon::allocateStatusMember(_ws, status);
-            return PlanStage::FAILURE;
+        if (!_nativeMode) {
+            Status status = initGroupScripting();
+            if (!status.isOK()) {
+                *out = WorkingSetCommon::allocateStatusMember(_ws, status);
+                return PlanStage::FAILURE;
+            }
         }
         _groupState = GroupState_ReadingFromChild;
         return PlanStage::NEED_TIME;
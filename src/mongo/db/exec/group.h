@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/namespace_string.h"
@@ -121,9 +124,57 @@ private:
         GroupState_Done
     };
 
+    // One "prev.<field> += ..." statement of a reduce function which this stage can execute
+    // natively, without invoking the scripting engine.  The value added to "targetField" is
+    // either the field of the input document at "sourcePath", or "constant" if "sourcePath" is
+    // empty (e.g. "prev.count += 1" or "prev.count++").
+    struct NativeReduceOp {
+        size_t fieldIndex;       // Index into _nativeFields of the field being accumulated.
+        std::string sourcePath;  // Dotted path into the input document.  Empty for constants.
+        double constant;         // The value to add when "sourcePath" is empty.
+    };
+
+    // Accumulator state for one group key when the reduce step is executing natively.  The
+    // values vector is parallel to _nativeFields.
+    struct NativeGroup {
+        BSONObj key;
+        std::vector<double> values;
+    };
+
+    /**
+     * Attempts to recognize 'reduceCode' as a function whose body is a sequence of simple
+     * accumulation statements, e.g.
+     *
+     *   function(doc, prev) { prev.total += doc.price; prev.count += 1; }
+     *
+     * On success, returns true and fills in 'ops' with one entry per statement and 'fields'
+     * with the distinct fields being accumulated into.  Returns false if the function does
+     * anything else, in which case the reduce step must run in JavaScript.
+     */
+    static bool parseNativeReduce(const std::string& reduceCode,
+                                  std::vector<NativeReduceOp>* ops,
+                                  std::vector<std::string>* fields);
+
     // Initializes _scope, _reduceFunction and _keyFunction using the global scripting engine.
     Status initGroupScripting();
 
+    // Accumulates 'obj' into _nativeGroups.  Returns false (without changing any state) if the
+    // object holds a value whose JavaScript coercion the native reduce cannot reproduce, in
+    // which case the caller must switch to the scripting path.
+    StatusWith<bool> processObjectNative(const BSONObj& obj);
+
+    // Abandons native execution: initializes the scripting machinery and seeds "$arr" with the
+    // partial results accumulated in _nativeGroups, so that the JavaScript reduce (and
+    // finalize) can take over exactly where the native reduce stopped.
+    Status transitionToScripting();
+
+    // Appends the result object for 'group' to 'builder', matching the field order and number
+    // coercions that a round trip through the scripting engine would have produced.
+    void appendNativeGroup(const NativeGroup& group, BSONObjBuilder* builder) const;
+
+    // Builds the results array from _nativeGroups.
+    BSONObj materializeNativeResults() const;
+
     // Updates _groupMap and _scope to account for the group key associated with this object.
     // Returns an error status if an error occurred, else Status::OK().
     Status processObject(const BSONObj& obj);
@@ -157,6 +208,26 @@ private:
     // Map from group key => group index.  The group index is used to index into "$arr", a
     // variable owned by _scope which contains the group data for this key.
     BSONObjIndexedMap<int> _groupMap;
+
+    // True while the reduce step is executing natively.  Set at construction time when the
+    // reduce function parses as a sequence of simple accumulations, and cleared if a document
+    // forces a fallback to the scripting path.
+    bool _nativeMode;
+
+    // The accumulation statements recognized in the reduce function, valid iff _nativeMode.
+    std::vector<NativeReduceOp> _nativeOps;
+
+    // The distinct fields accumulated into by _nativeOps.
+    std::vector<std::string> _nativeFields;
+
+    // The starting accumulator values from _request.initial, parallel to _nativeFields.
+    std::vector<double> _nativeInitialValues;
+
+    // Accumulator state per group, indexed by group index.  Only used while _nativeMode.
+    std::vector<NativeGroup> _nativeGroups;
+
+    // Per-document operand values, kept as a member to avoid reallocating per document.
+    std::vector<double> _nativeOperandScratch;
 };
 
 }  // namespace mongo
@@ -151,6 +151,11 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
         return PlanStage::NEED_YIELD;
     }
 
+    return processEntry(std::move(kv), out);
+}
+
+PlanStage::StageState IndexScan::processEntry(boost::optional<IndexKeyEntry> kv,
+                                              WorkingSetID* out) {
     if (kv) {
         // In debug mode, check that the cursor isn't lying to us.
         if (kDebugBuild && !_startKey.isEmpty()) {
@@ -236,6 +241,92 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState IndexScan::doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) {
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+    *numOut = 0;
+
+    size_t unitsOfWork = 0;
+    while (unitsOfWork < max) {
+        if (GETTING_NEXT != _scanState) {
+            // Initial positioning, bounds seeks and EOF go through doWork() one unit at a time;
+            // doWork() is final here, so the call binds statically.
+            ++unitsOfWork;
+            ++_commonStats.works;
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            StageState state = IndexScan::doWork(&id);
+            if (PlanStage::ADVANCED == state) {
+                ++_commonStats.advanced;
+                out[(*numOut)++] = id;
+            } else if (PlanStage::NEED_TIME == state) {
+                ++_commonStats.needTime;
+            } else {
+                if (PlanStage::NEED_YIELD == state) {
+                    ++_commonStats.needYield;
+                }
+                out[*numOut] = id;
+                return state;
+            }
+            continue;
+        }
+
+        // Steady state: read ahead up to the remaining work budget's worth of entries in one
+        // crossing of the storage API, then examine them without touching the cursor. The
+        // buffer is always drained or discarded before this method returns, so no entry is
+        // ever held across a yield.
+        _batchBuffer.clear();
+        try {
+            _indexCursor->nextBatch(&_batchBuffer, max - unitsOfWork);
+        } catch (const WriteConflictException&) {
+            // Entries read before the conflict are still valid; only surface the yield request
+            // if the conflict prevented any progress.
+            if (_batchBuffer.empty()) {
+                ++unitsOfWork;
+                ++_commonStats.works;
+                ++_commonStats.needYield;
+                out[*numOut] = WorkingSet::INVALID_ID;
+                return PlanStage::NEED_YIELD;
+            }
+        }
+
+        if (_batchBuffer.empty()) {
+            // Run the usual end-of-scan transition.
+            ++unitsOfWork;
+            ++_commonStats.works;
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            StageState state = processEntry(boost::none, &id);
+            invariant(PlanStage::IS_EOF == state);
+            out[*numOut] = id;
+            return state;
+        }
+
+        for (size_t i = 0; i < _batchBuffer.size(); i++) {
+            ++unitsOfWork;
+            ++_commonStats.works;
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            StageState state = processEntry(std::move(_batchBuffer[i]), &id);
+            if (PlanStage::ADVANCED == state) {
+                ++_commonStats.advanced;
+                out[(*numOut)++] = id;
+            } else if (PlanStage::NEED_TIME == state) {
+                ++_commonStats.needTime;
+                if (GETTING_NEXT != _scanState) {
+                    // The bounds checker requested a seek. The rest of the buffer precedes the
+                    // seek point, so discard it; the next unit performs the seek.
+                    break;
+                }
+            } else {
+                // The bounds checker or maxScan ended the scan; the rest of the buffer is past
+                // the end of the range.
+                out[*numOut] = id;
+                return state;
+            }
+        }
+    }
+
+    out[*numOut] = WorkingSet::INVALID_ID;
+    return *numOut > 0 ? PlanStage::ADVANCED : PlanStage::NEED_TIME;
+}
+
 bool IndexScan::isEOF() {
     return _commonStats.isEOF;
 }
@@ -96,6 +96,7 @@ public:
               const MatchExpression* filter);
 
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) final;
     bool isEOF() final;
     void doSaveState() final;
     void doRestoreState() final;
@@ -119,6 +120,13 @@ private:
      */
     boost::optional<IndexKeyEntry> initIndexScan();
 
+    /**
+     * Examines one entry read from the cursor (boost::none meaning the cursor is exhausted):
+     * checks the bounds, dedups, filters, and on success fills out a WSM. Shared by doWork()
+     * and the read-ahead loop in doWorkBatch().
+     */
+    StageState processEntry(boost::optional<IndexKeyEntry> kv, WorkingSetID* out);
+
     // The WorkingSet we fill with results.  Not owned by us.
     WorkingSet* const _workingSet;
 
@@ -130,6 +138,11 @@ private:
     // Keeps track of what work we need to do next.
     ScanState _scanState;
 
+    // Entries read ahead from '_indexCursor' by doWorkBatch(). Only holds data while a batch is
+    // being examined; it is drained or discarded before doWorkBatch() returns, so no entry is
+    // held across a yield. Kept as a member to reuse its allocation across batches.
+    std::vector<IndexKeyEntry> _batchBuffer;
+
     // Contains expressions only over fields in the index key.  We assume this is built
     // correctly by whomever creates this class.
     // The filter is not owned by us.
@@ -31,6 +31,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
@@ -55,8 +56,7 @@ MergeSortStage::MergeSortStage(OperationContext* opCtx,
       _ws(ws),
       _pattern(params.pattern),
       _collator(params.collator),
-      _dedup(params.dedup),
-      _merging(StageWithValueComparison(ws, params.pattern, params.collator)) {}
+      _dedup(params.dedup) {}
 
 void MergeSortStage::addChild(PlanStage* child) {
     _children.emplace_back(child);
@@ -115,12 +115,15 @@ PlanStage::StageState MergeSortStage::doWork(WorkingSetID* out) {
             }
 
             // Store the result in our list.
-            StageWithValue value;
+            _mergingData.emplace_front();
+            StageWithValue& value = _mergingData.front();
             value.id = id;
             value.stage = child;
             // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
             member->makeObjOwnedIfNeeded();
-            _mergingData.push_front(value);
+            // Extract the sort key once; every comparison this result participates in while it
+            // sits in the merge queue is then a single memcmp.
+            value.key.resetToKey(extractSortKey(member), Ordering::make(_pattern));
 
             // Insert the result (indirectly) into our priority queue.
             _merging.push(_mergingData.begin());
@@ -196,38 +199,28 @@ void MergeSortStage::doInvalidate(OperationContext* opCtx,
     }
 }
 
-// Is lhs less than rhs?  Note that priority_queue is a max heap by default so we invert
-// the return from the expected value.
-bool MergeSortStage::StageWithValueComparison::operator()(const MergingRef& lhs,
-                                                          const MergingRef& rhs) {
-    WorkingSetMember* lhsMember = _ws->get(lhs->id);
-    WorkingSetMember* rhsMember = _ws->get(rhs->id);
-
+BSONObj MergeSortStage::extractSortKey(WorkingSetMember* member) const {
+    BSONObjBuilder keyBob;
     BSONObjIterator it(_pattern);
     while (it.more()) {
         BSONElement patternElt = it.next();
-        string fn = patternElt.fieldName();
-
-        BSONElement lhsElt;
-        verify(lhsMember->getFieldDotted(fn, &lhsElt));
 
-        BSONElement rhsElt;
-        verify(rhsMember->getFieldDotted(fn, &rhsElt));
+        BSONElement elt;
+        verify(member->getFieldDotted(patternElt.fieldName(), &elt));
 
-        // false means don't compare field name.
-        int x = lhsElt.woCompare(rhsElt, false, _collator);
-        if (-1 == patternElt.number()) {
-            x = -x;
-        }
-        if (x != 0) {
-            return x > 0;
-        }
+        CollationIndexKey::collationAwareIndexKeyAppend(elt, _collator, &keyBob);
     }
+    return keyBob.obj();
+}
 
-    // A comparator for use with sort is required to model a strict weak ordering, so
-    // to satisfy irreflexivity we must return 'false' for elements that we consider
-    // equivalent under the pattern.
-    return false;
+// Is lhs less than rhs?  Note that priority_queue is a max heap by default so we invert
+// the return from the expected value.
+bool MergeSortStage::StageWithValueComparison::operator()(const MergingRef& lhs,
+                                                          const MergingRef& rhs) {
+    // The cached KeyStrings encode the pattern's directions and the collation, and compare
+    // equal only for results the pattern considers equivalent, so this models the same strict
+    // weak ordering the field-by-field comparison did.
+    return lhs->key.compare(rhs->key) > 0;
 }
 
 unique_ptr<PlanStageStats> MergeSortStage::getStats() {
@@ -36,6 +36,7 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace mongo {
 
@@ -79,6 +80,13 @@ public:
     static const char* kStageType;
 
 private:
+    /**
+     * Builds 'member's sort key in pattern order, applying the collation transformation to any
+     * collatable values, so the KeyString encoding of the result compares correctly without
+     * consulting the collator again.
+     */
+    BSONObj extractSortKey(WorkingSetMember* member) const;
+
     // Not owned by us.
     const Collection* _collection;
 
@@ -116,28 +124,25 @@ private:
     // priority_queue to remove the item from the list and quickly.
 
     struct StageWithValue {
-        StageWithValue() : id(WorkingSet::INVALID_ID), stage(NULL) {}
+        StageWithValue() : id(WorkingSet::INVALID_ID), stage(NULL), key(KeyString::kLatestVersion) {}
         WorkingSetID id;
         PlanStage* stage;
+        // The result's sort key, extracted once when the result arrives. The pattern's per-field
+        // directions and the collation transformation are baked into the encoding, so comparing
+        // two results is a single memcmp rather than a woCompare per pattern field.
+        KeyString key;
     };
 
     // We have a priority queue of these.
     typedef std::list<StageWithValue>::iterator MergingRef;
 
-    // The comparison function used in our priority queue.
+    // The comparison function used in our priority queue. Compares the cached KeyStrings, which
+    // already encode the sort pattern and collation.
     class StageWithValueComparison {
     public:
-        StageWithValueComparison(WorkingSet* ws, BSONObj pattern, const CollatorInterface* collator)
-            : _ws(ws), _pattern(pattern), _collator(collator) {}
-
         // Is lhs less than rhs?  Note that priority_queue is a max heap by default so we invert
         // the return from the expected value.
         bool operator()(const MergingRef& lhs, const MergingRef& rhs);
-
-    private:
-        WorkingSet* _ws;
-        BSONObj _pattern;
-        const CollatorInterface* _collator;
     };
 
     // The min heap of the results we're returning.
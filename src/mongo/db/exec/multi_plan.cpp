@@ -33,6 +33,7 @@
 #include "mongo/db/exec/multi_plan.h"
 
 #include <algorithm>
+#include <cmath>
 #include <math.h>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -45,6 +46,7 @@
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/storage/record_fetcher.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
@@ -58,6 +60,27 @@ using std::unique_ptr;
 using std::vector;
 using stdx::make_unique;
 
+namespace {
+
+// Reassess the candidates after each candidate has been worked this many more times during
+// the trial period. Losing plans get a few hundred works to prove themselves rather than
+// running to the end of the trial.
+const size_t kEvaluationCheckInterval = 256;
+
+// The leading candidate must have produced at least this many results before it can end the
+// trial early or sideline a rival; below this the productivity estimates are too noisy.
+const size_t kMinResultsForEarlyTermination = 20;
+
+// Number of standard errors by which the leader's productivity (results per work) must exceed
+// the runner-up's for the trial to end early. Three standard errors corresponds to roughly
+// 99.7% confidence under the normal approximation.
+const double kEarlyTerminationStdErrs = 3.0;
+
+// A candidate whose result count is this many times smaller than the leader's is sidelined.
+const size_t kDeprioritizeFactor = 10;
+
+}  // namespace
+
 // static
 const char* MultiPlanStage::kStageType = "MULTI_PLAN";
 
@@ -209,13 +232,23 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     size_t numWorks = getTrialPeriodWorks(getOpCtx(), _collection);
     size_t numResults = getTrialPeriodNumToReturn(*_query);
 
+    _deprioritized.assign(_candidates.size(), false);
+    const bool allowEarlyTermination = internalQueryPlanEvaluationEarlyTermination.load();
+
     // Work the plans, stopping when a plan hits EOF or returns some
-    // fixed number of results.
+    // fixed number of results. Periodically reassess the field: a statistically dominant
+    // leader ends the trial early, and obvious losers stop being worked.
     for (size_t ix = 0; ix < numWorks; ++ix) {
         bool moreToDo = workAllPlans(numResults, yieldPolicy);
         if (!moreToDo) {
             break;
         }
+
+        if (allowEarlyTermination && (ix + 1) % kEvaluationCheckInterval == 0) {
+            if (updatePlanPriorities(ix + 1)) {
+                break;
+            }
+        }
     }
 
     if (_failure) {
@@ -338,7 +371,7 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
 
     for (size_t ix = 0; ix < _candidates.size(); ++ix) {
         CandidatePlan& candidate = _candidates[ix];
-        if (candidate.failed) {
+        if (candidate.failed || (!_deprioritized.empty() && _deprioritized[ix])) {
             continue;
         }
 
@@ -406,6 +439,63 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
     return !doneWorking;
 }
 
+bool MultiPlanStage::updatePlanPriorities(size_t worksPerPlan) {
+    // Find the candidate with the most results so far and the best result count among its
+    // rivals. Sidelined candidates still count as rivals: their frozen result counts keep the
+    // dominance test honest.
+    int leaderIdx = kNoSuchPlan;
+    size_t leaderResults = 0;
+    size_t runnerUpResults = 0;
+    for (size_t ix = 0; ix < _candidates.size(); ++ix) {
+        if (_candidates[ix].failed) {
+            continue;
+        }
+        const size_t numResults = _candidates[ix].results.size();
+        if (kNoSuchPlan == leaderIdx || numResults > leaderResults) {
+            runnerUpResults = leaderResults;
+            leaderResults = numResults;
+            leaderIdx = ix;
+        } else if (numResults > runnerUpResults) {
+            runnerUpResults = numResults;
+        }
+    }
+
+    // With too small a sample the productivity estimates are meaningless.
+    if (kNoSuchPlan == leaderIdx || leaderResults < kMinResultsForEarlyTermination) {
+        return false;
+    }
+
+    // Model each work() call as a Bernoulli trial that either produces a result or not, and
+    // end the trial period once the gap between the leader's and the runner-up's observed
+    // productivity exceeds kEarlyTerminationStdErrs standard errors.
+    const double n = static_cast<double>(worksPerPlan);
+    const double p1 = static_cast<double>(leaderResults) / n;
+    const double p2 = static_cast<double>(runnerUpResults) / n;
+    const double stdErr = std::sqrt((p1 * (1 - p1) + p2 * (1 - p2)) / n);
+    if (p1 - p2 > kEarlyTerminationStdErrs * stdErr) {
+        LOG(2) << "Ending plan evaluation early after " << worksPerPlan
+               << " works: " << redact(Explain::getPlanSummary(_candidates[leaderIdx].root))
+               << " is statistically dominant (" << leaderResults << " vs " << runnerUpResults
+               << " results)";
+        return true;
+    }
+
+    // No dominant plan yet. Stop working candidates which have fallen an order of magnitude
+    // behind the leader; their stats are frozen but still participate in ranking.
+    for (size_t ix = 0; ix < _candidates.size(); ++ix) {
+        if (static_cast<int>(ix) == leaderIdx || _candidates[ix].failed || _deprioritized[ix]) {
+            continue;
+        }
+        if (_candidates[ix].results.size() * kDeprioritizeFactor < leaderResults) {
+            _deprioritized[ix] = true;
+            LOG(2) << "Deprioritizing losing plan after " << worksPerPlan
+                   << " works: " << redact(Explain::getPlanSummary(_candidates[ix].root));
+        }
+    }
+
+    return false;
+}
+
 namespace {
 
 void invalidateHelper(OperationContext* opCtx,
@@ -176,6 +176,17 @@ private:
      */
     Status tryYield(PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Reassesses the candidates after each plan has been worked 'worksPerPlan' times during
+     * the trial period.
+     *
+     * Returns true if the trial can end early because the leading candidate's productivity is
+     * statistically dominant over every rival's. Otherwise, sidelines candidates which have
+     * fallen so far behind the leader that working them further cannot change the outcome,
+     * and returns false.
+     */
+    bool updatePlanPriorities(size_t worksPerPlan);
+
     static const int kNoSuchPlan = -1;
 
     // Not owned here. Must be non-null.
@@ -194,6 +205,12 @@ private:
     // one-to-one with _candidates.
     std::vector<CandidatePlan> _candidates;
 
+    // Parallels _candidates. An entry is set to true when updatePlanPriorities() decides the
+    // corresponding candidate is an obvious loser; workAllPlans() then stops working it for
+    // the remainder of the trial period. Its stats are frozen but still participate in
+    // ranking. Only used during pickBestPlan().
+    std::vector<bool> _deprioritized;
+
     // index into _candidates, of the winner of the plan competition
     // uses -1 / kNoSuchPlan when best plan is not (yet) known
     int _bestPlanIdx;
@@ -56,6 +56,15 @@ PlanStage::StageState PlanStage::work(WorkingSetID* out) {
     return workResult;
 }
 
+PlanStage::StageState PlanStage::workBatch(WorkingSetID* out, size_t max, size_t* numOut) {
+    invariant(_opCtx);
+    return doWorkBatch(out, max, numOut);
+}
+
+PlanStage::StageState PlanStage::doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) {
+    return workBatchLoop([this](WorkingSetID* id) { return doWork(id); }, out, max, numOut);
+}
+
 void PlanStage::saveState() {
     ++_commonStats.yields;
     for (auto&& child : _children) {
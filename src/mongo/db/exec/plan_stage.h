@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "mongo/db/exec/plan_stats.h"
+#include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/invalidation_type.h"
 
@@ -188,6 +189,26 @@ public:
      */
     StageState work(WorkingSetID* out);
 
+    /**
+     * Performs up to 'max' units of work, appending the id of each ADVANCED result to 'out' and
+     * reporting the number appended via 'numOut'. Batching amortizes per-document virtual
+     * dispatch and stats bookkeeping over the batch; stages that buffer or transform documents
+     * override doWorkBatch() to also pull their children's output a batch at a time.
+     *
+     * 'out' must have room for max + 1 ids: out[0] through out[*numOut - 1] are ADVANCED
+     * results, and out[*numOut] always holds the id that a single work() call returning the
+     * terminating state would have set (INVALID_ID if there is none).
+     *
+     * Returns the state that ended the batch. IS_EOF, NEED_YIELD, DEAD and FAILURE end a batch
+     * immediately and mean the same as they do for work(); in particular, a stage receiving
+     * NEED_YIELD from a child still propagates it without performing further work, so yield
+     * requests are honored at batch boundaries rather than deferred. ADVANCED means the work
+     * budget was spent and at least one result was appended; NEED_TIME means the budget was
+     * spent without producing anything. The returned state says nothing about whether ids were
+     * appended, so callers must consume out[0..*numOut) before acting on the state.
+     */
+    StageState workBatch(WorkingSetID* out, size_t max, size_t* numOut);
+
     /**
      * Returns true if no more work can be done on the query / out of results.
      */
@@ -347,6 +368,52 @@ protected:
      */
     virtual StageState doWork(WorkingSetID* out) = 0;
 
+    /**
+     * Performs a batch of work.  See comment at workBatch() above.
+     *
+     * The default implementation loops over doWork() under a single timer, so every stage
+     * batches correctly without further code. Overrides must maintain '_commonStats' as the
+     * equivalent sequence of work() calls would have.
+     */
+    virtual StageState doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut);
+
+    /**
+     * Shared implementation of the doWorkBatch() contract: performs up to 'max' units of work by
+     * invoking 'workUnit' (a callable taking a WorkingSetID* and returning a StageState) under a
+     * single timer, maintaining '_commonStats' as the equivalent sequence of work() calls would.
+     * Leaf stages override doWorkBatch() to run this loop with a statically bound call to their
+     * own doWork(), keeping virtual dispatch out of the per-document path.
+     */
+    template <typename WorkUnit>
+    StageState workBatchLoop(WorkUnit workUnit, WorkingSetID* out, size_t max, size_t* numOut) {
+        ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+        *numOut = 0;
+
+        for (size_t unitsOfWork = 0; unitsOfWork < max; ++unitsOfWork) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            ++_commonStats.works;
+
+            StageState workResult = workUnit(&id);
+
+            if (StageState::ADVANCED == workResult) {
+                ++_commonStats.advanced;
+                out[(*numOut)++] = id;
+            } else if (StageState::NEED_TIME == workResult) {
+                ++_commonStats.needTime;
+            } else {
+                if (StageState::NEED_YIELD == workResult) {
+                    ++_commonStats.needYield;
+                }
+                // IS_EOF, NEED_YIELD, DEAD and FAILURE end the batch immediately.
+                out[*numOut] = id;
+                return workResult;
+            }
+        }
+
+        out[*numOut] = WorkingSet::INVALID_ID;
+        return *numOut > 0 ? StageState::ADVANCED : StageState::NEED_TIME;
+    }
+
     /**
      * Saves any stage-specific state required to resume where it was if the underlying data
      * changes.
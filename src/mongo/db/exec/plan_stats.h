@@ -340,7 +340,7 @@ struct EnsureSortedStats : public SpecificStats {
 };
 
 struct FetchStats : public SpecificStats {
-    FetchStats() : alreadyHasObj(0), forcedFetches(0), docsExamined(0) {}
+    FetchStats() : alreadyHasObj(0), forcedFetches(0), docsExamined(0), docsPrefetched(0) {}
 
     SpecificStats* clone() const final {
         FetchStats* specific = new FetchStats(*this);
@@ -355,10 +355,13 @@ struct FetchStats : public SpecificStats {
 
     // The total number of full documents touched by the fetch stage.
     size_t docsExamined;
+
+    // How many additional cold records were paged in alongside another record's fetch yield.
+    size_t docsPrefetched;
 };
 
 struct GroupStats : public SpecificStats {
-    GroupStats() : nGroups(0) {}
+    GroupStats() : nGroups(0), nativeReduce(false) {}
 
     SpecificStats* clone() const final {
         GroupStats* specific = new GroupStats(*this);
@@ -367,6 +370,9 @@ struct GroupStats : public SpecificStats {
 
     // The total number of groups.
     size_t nGroups;
+
+    // Whether the reduce step ran natively, without invoking the scripting engine.
+    bool nativeReduce;
 };
 
 struct IDHackStats : public SpecificStats {
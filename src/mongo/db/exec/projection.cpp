@@ -227,6 +227,50 @@ PlanStage::StageState ProjectionStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState ProjectionStage::doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) {
+    ScopedTimer timer(getClock(), &_commonStats.executionTimeMillis);
+
+    // Pull a whole batch from our child, then project each result in place. One virtual call
+    // fetches up to 'max' results, so per-document stage dispatch is amortized over the batch.
+    StageState status = child()->workBatch(out, max, numOut);
+
+    for (size_t i = 0; i < *numOut; i++) {
+        ++_commonStats.works;
+        WorkingSetMember* member = _ws->get(out[i]);
+        Status projStatus = transform(member);
+        if (!projStatus.isOK()) {
+            warning() << "Couldn't execute projection, status = " << redact(projStatus);
+            // Results before 'i' were projected and remain valid. Later results are still
+            // unprojected, so free them rather than handing them up.
+            for (size_t j = i; j < *numOut; j++) {
+                _ws->free(out[j]);
+            }
+            *numOut = i;
+            out[*numOut] = WorkingSetCommon::allocateStatusMember(_ws, projStatus);
+            return PlanStage::FAILURE;
+        }
+        ++_commonStats.advanced;
+    }
+
+    if (PlanStage::FAILURE == status || PlanStage::DEAD == status) {
+        ++_commonStats.works;
+        // If a stage fails, it may create a status WSM to indicate why it failed, in which case
+        // the id accompanying the state is valid.  If that id is invalid, we create our own
+        // error message.
+        if (WorkingSet::INVALID_ID == out[*numOut]) {
+            mongoutils::str::stream ss;
+            ss << "projection stage failed to read in results from child";
+            Status failStatus(ErrorCodes::InternalError, ss);
+            out[*numOut] = WorkingSetCommon::allocateStatusMember(_ws, failStatus);
+        }
+    } else if (PlanStage::NEED_YIELD == status) {
+        ++_commonStats.works;
+        ++_commonStats.needYield;
+    }
+
+    return status;
+}
+
 unique_ptr<PlanStageStats> ProjectionStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_PROJECTION);
@@ -88,6 +88,7 @@ public:
 
     bool isEOF() final;
     StageState doWork(WorkingSetID* out) final;
+    StageState doWorkBatch(WorkingSetID* out, size_t max, size_t* numOut) final;
 
     StageType stageType() const final {
         return STAGE_PROJECTION;
@@ -179,6 +179,21 @@ ProjectionExec::ProjectionExec(const BSONObj& spec,
             _arrayOpType = ARRAY_OP_POSITIONAL;
         }
     }
+
+    // Detect plain top-level inclusion lists, which transform() can apply with a single pass of
+    // verbatim element copies. Dotted paths require the recursive field-map machinery; the other
+    // special cases are all reflected in the flags checked here.
+    if (!_include && !_special && _matchers.empty() && _meta.empty() && !_hasReturnKey &&
+        _sortKeyMetaFields.empty() && ARRAY_OP_NORMAL == _arrayOpType) {
+        _fastInclusionOnly = true;
+        BSONObjIterator specIt(_source);
+        while (specIt.more()) {
+            if (mongoutils::str::contains(specIt.next().fieldName(), '.')) {
+                _fastInclusionOnly = false;
+                break;
+            }
+        }
+    }
 }
 
 ProjectionExec::~ProjectionExec() {
@@ -264,18 +279,24 @@ Status ProjectionExec::transform(WorkingSetMember* member) const {
 
     BSONObjBuilder bob;
     if (member->hasObj()) {
-        MatchDetails matchDetails;
+        if (_fastInclusionOnly) {
+            // Plain top-level inclusion list: one pass of verbatim element copies, skipping
+            // MatchDetails and the recursive field-map machinery.
+            transformFast(member->obj.value(), &bob);
+        } else {
+            MatchDetails matchDetails;
 
-        // If it's a positional projection we need a MatchDetails.
-        if (transformRequiresDetails()) {
-            matchDetails.requestElemMatchKey();
-            verify(NULL != _queryExpression);
-            verify(_queryExpression->matchesBSON(member->obj.value(), &matchDetails));
-        }
+            // If it's a positional projection we need a MatchDetails.
+            if (transformRequiresDetails()) {
+                matchDetails.requestElemMatchKey();
+                verify(NULL != _queryExpression);
+                verify(_queryExpression->matchesBSON(member->obj.value(), &matchDetails));
+            }
 
-        Status projStatus = transform(member->obj.value(), &bob, &matchDetails);
-        if (!projStatus.isOK()) {
-            return projStatus;
+            Status projStatus = transform(member->obj.value(), &bob, &matchDetails);
+            if (!projStatus.isOK()) {
+                return projStatus;
+            }
         }
     } else {
         invariant(!_include);
@@ -374,6 +395,24 @@ Status ProjectionExec::transform(WorkingSetMember* member) const {
     return Status::OK();
 }
 
+void ProjectionExec::transformFast(const BSONObj& in, BSONObjBuilder* bob) const {
+    BSONObjIterator it(in);
+    while (it.more()) {
+        BSONElement elt = it.next();
+
+        if (mongoutils::str::equals("_id", elt.fieldName())) {
+            if (_includeID) {
+                bob->append(elt);
+            }
+            continue;
+        }
+
+        if (_fields.end() != _fields.find(elt.fieldName())) {
+            bob->append(elt);
+        }
+    }
+}
+
 Status ProjectionExec::transform(const BSONObj& in,
                                  BSONObjBuilder* bob,
                                  const MatchDetails* details) const {
@@ -112,6 +112,14 @@ private:
                      BSONObjBuilder* bob,
                      const MatchDetails* details = NULL) const;
 
+    /**
+     * Single-pass fast path for plain top-level inclusion lists: copies the included elements
+     * (and _id, when included) verbatim from 'in' into 'bob'. Only called when
+     * '_fastInclusionOnly' was established by the constructor, which guarantees there are no
+     * matchers, meta-projections, array operators or dotted paths to consider.
+     */
+    void transformFast(const BSONObj& in, BSONObjBuilder* bob) const;
+
     /**
      * See transform(...) above.
      */
@@ -184,6 +192,10 @@ private:
     // that perform matching (e.g. elemMatch projection). If null, the collation is a simple binary
     // compare.
     const CollatorInterface* _collator = nullptr;
+
+    // True if this projection is a plain top-level inclusion list, making transform() eligible
+    // for the single-pass fast path.
+    bool _fastInclusionOnly = false;
 };
 
 }  // namespace mongo
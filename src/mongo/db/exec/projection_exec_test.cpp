@@ -189,6 +189,24 @@ BSONObj transformCovered(BSONObj projSpec, const IndexKeyDatum& ikd) {
     return wsm->obj.value();
 }
 
+//
+// inclusion fast path
+//
+
+TEST(ProjectionExecTest, TransformTopLevelInclusion) {
+    // Output fields are emitted in document order, not spec order, and _id is included by
+    // default; these invariants must hold on the single-pass fast path.
+    testTransform("{a: 1, c: 1}", "{}", "{c: 1, x: 10, a: 5}", true, "{c: 1, a: 5}");
+    testTransform("{a: 1, c: 1}", "{}", "{_id: 7, x: 10, a: 5}", true, "{_id: 7, a: 5}");
+    testTransform("{a: 1, _id: 0}", "{}", "{_id: 7, a: 5, b: 6}", true, "{a: 5}");
+
+    // Fields absent from the document are simply not emitted.
+    testTransform("{a: 1, c: 1}", "{}", "{b: 2}", true, "{}");
+
+    // Included values are copied verbatim, arrays and subdocuments included.
+    testTransform("{a: 1}", "{}", "{a: [1, {b: 2}], c: 3}", true, "{a: [1, {b: 2}]}");
+}
+
 //
 // position $
 //
@@ -139,4 +139,62 @@ TEST_F(QueuedDataStageTest, validateStats) {
     unique_ptr<PlanStageStats> allStats(mock->getStats());
     ASSERT_TRUE(stats->isEOF);
 }
+
+//
+// Test the default batching loop behind workBatch(): intervening NEED_TIMEs are absorbed, the
+// terminating state ends the batch, and stats reflect the equivalent sequence of work() calls.
+//
+TEST_F(QueuedDataStageTest, workBatchDrainsQueuedResults) {
+    WorkingSet ws;
+    auto mock = make_unique<QueuedDataStage>(getOpCtx(), &ws);
+
+    WorkingSetID first = ws.allocate();
+    WorkingSetID second = ws.allocate();
+    mock->pushBack(first);
+    mock->pushBack(PlanStage::NEED_TIME);
+    mock->pushBack(second);
+
+    // One slot beyond the batch size for the terminating id.
+    WorkingSetID out[4];
+    size_t numOut = 0;
+
+    ASSERT_EQUALS(PlanStage::IS_EOF, mock->workBatch(out, 3, &numOut));
+    ASSERT_EQUALS(numOut, 2U);
+    ASSERT_EQUALS(out[0], first);
+    ASSERT_EQUALS(out[1], second);
+    ASSERT_EQUALS(out[numOut], WorkingSet::INVALID_ID);
+
+    const CommonStats* stats = mock->getCommonStats();
+    ASSERT_EQUALS(stats->works, 4U);
+    ASSERT_EQUALS(stats->advanced, 2U);
+    ASSERT_EQUALS(stats->needTime, 1U);
+}
+
+//
+// Test that workBatch() returns ADVANCED when it produces results without hitting a
+// terminating state, and that the rest of the queue survives for the next call.
+//
+TEST_F(QueuedDataStageTest, workBatchStopsWhenBatchIsFull) {
+    WorkingSet ws;
+    auto mock = make_unique<QueuedDataStage>(getOpCtx(), &ws);
+
+    WorkingSetID first = ws.allocate();
+    WorkingSetID second = ws.allocate();
+    mock->pushBack(first);
+    mock->pushBack(second);
+
+    WorkingSetID out[2];
+    size_t numOut = 0;
+
+    ASSERT_EQUALS(PlanStage::ADVANCED, mock->workBatch(out, 1, &numOut));
+    ASSERT_EQUALS(numOut, 1U);
+    ASSERT_EQUALS(out[0], first);
+
+    ASSERT_EQUALS(PlanStage::ADVANCED, mock->workBatch(out, 1, &numOut));
+    ASSERT_EQUALS(numOut, 1U);
+    ASSERT_EQUALS(out[0], second);
+
+    ASSERT_EQUALS(PlanStage::IS_EOF, mock->workBatch(out, 1, &numOut));
+    ASSERT_EQUALS(numOut, 0U);
+}
 }
@@ -32,10 +32,13 @@
 
 #include "mongo/db/exec/shard_filter.h"
 
+#include <algorithm>
+
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/s/metadata_manager.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
@@ -50,16 +53,84 @@ using stdx::make_unique;
 // static
 const char* ShardFilterStage::kStageType = "SHARDING_FILTER";
 
+namespace {
+
+/**
+ * Encodes a shard key or chunk bound so that a memcmp of the encodings orders the same way as
+ * a woCompare of the originals. All encoded objects have the same (shard key) fields, so the
+ * field names KeyString drops cannot affect the order.
+ */
+std::string encodeShardKey(const BSONObj& key) {
+    KeyString keyString(KeyString::kLatestVersion, key, Ordering::make(BSONObj()));
+    return std::string(keyString.getBuffer(), keyString.getSize());
+}
+
+}  // namespace
+
 ShardFilterStage::ShardFilterStage(OperationContext* opCtx,
                                    ScopedCollectionMetadata metadata,
                                    WorkingSet* ws,
                                    PlanStage* child)
     : PlanStage(kStageType, opCtx), _ws(ws), _metadata(std::move(metadata)) {
     _children.emplace_back(child);
+
+    if (_metadata) {
+        _shardKeyPattern.emplace(_metadata->getKeyPattern());
+
+        // Flatten the chunk map into a sorted array of coalesced owned ranges. On heavily
+        // chunked collections this pays one pass over the map up front so that each document
+        // does a binary search over contiguous memory rather than a walk of the map.
+        BSONObj min, max;
+        for (const auto& entry : _metadata->getChunks()) {
+            const BSONObj& currMin = entry.first;
+            const BSONObj& currMax = entry.second.getMaxKey();
+
+            if (min.isEmpty()) {
+                min = currMin;
+                max = currMax;
+                continue;
+            }
+
+            if (SimpleBSONObjComparator::kInstance.evaluate(max == currMin)) {
+                max = currMax;
+                continue;
+            }
+
+            _ownedRanges.push_back({encodeShardKey(min), encodeShardKey(max)});
+            min = currMin;
+            max = currMax;
+        }
+
+        if (!min.isEmpty()) {
+            _ownedRanges.push_back({encodeShardKey(min), encodeShardKey(max)});
+        }
+    }
 }
 
 ShardFilterStage::~ShardFilterStage() {}
 
+bool ShardFilterStage::_keyBelongsToMe(const BSONObj& shardKey) const {
+    if (_ownedRanges.empty()) {
+        return false;
+    }
+
+    const std::string key = encodeShardKey(shardKey);
+
+    // Find the last range whose inclusive min is not greater than the key, then check the key
+    // against that range's exclusive max.
+    auto it = std::upper_bound(_ownedRanges.begin(),
+                               _ownedRanges.end(),
+                               key,
+                               [](const std::string& lhs, const OwnedRange& range) {
+                                   return lhs < range.minKey;
+                               });
+    if (it == _ownedRanges.begin()) {
+        return false;
+    }
+    --it;
+    return key < it->maxKey;
+}
+
 bool ShardFilterStage::isEOF() {
     return child()->isEOF();
 }
@@ -77,10 +148,9 @@ PlanStage::StageState ShardFilterStage::doWork(WorkingSetID* out) {
         // including pending documents from in-progress migrations and orphaned documents from
         // aborted migrations
         if (_metadata) {
-            ShardKeyPattern shardKeyPattern(_metadata->getKeyPattern());
             WorkingSetMember* member = _ws->get(*out);
             WorkingSetMatchableDocument matchable(member);
-            BSONObj shardKey = shardKeyPattern.extractShardKeyFromMatchable(matchable);
+            BSONObj shardKey = _shardKeyPattern->extractShardKeyFromMatchable(matchable);
 
             if (shardKey.isEmpty()) {
                 // We can't find a shard key for this document - this should never happen with
@@ -106,7 +176,7 @@ PlanStage::StageState ShardFilterStage::doWork(WorkingSetID* out) {
                           << "document may have been inserted manually into shard";
             }
 
-            if (!_metadata->keyBelongsToMe(shardKey)) {
+            if (!_keyBelongsToMe(shardKey)) {
                 _ws->free(*out);
                 ++_specificStats.chunkSkips;
                 return PlanStage::NEED_TIME;
@@ -28,8 +28,14 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/s/metadata_manager.h"
+#include "mongo/s/shard_key_pattern.h"
 
 namespace mongo {
 
@@ -90,6 +96,20 @@ public:
     static const char* kStageType;
 
 private:
+    // A single owned range of the shard-key space, bounds encoded as KeyStrings so that the
+    // per-document ownership check is a memcmp-based binary search.
+    struct OwnedRange {
+        std::string minKey;  // Inclusive.
+        std::string maxKey;  // Exclusive.
+    };
+
+    /**
+     * Returns whether 'shardKey' falls in one of '_ownedRanges'. Equivalent to
+     * CollectionMetadata::keyBelongsToMe(), but searches the flat array built at construction
+     * instead of the chunk map.
+     */
+    bool _keyBelongsToMe(const BSONObj& shardKey) const;
+
     WorkingSet* _ws;
 
     // Stats
@@ -98,6 +118,13 @@ private:
     // Note: it is important that this is the metadata from the time this stage is constructed.
     // See class comment for details.
     ScopedCollectionMetadata _metadata;
+
+    // Set when '_metadata' is, so the shard key pattern is not re-parsed for every document.
+    boost::optional<ShardKeyPattern> _shardKeyPattern;
+
+    // The ranges owned by this shard, coalesced and sorted by min key at construction. Empty
+    // when there is no metadata, or when the shard owns no chunks.
+    std::vector<OwnedRange> _ownedRanges;
 };
 
 }  // namespace mongo
@@ -41,6 +41,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 
@@ -51,6 +52,76 @@ using std::unique_ptr;
 using std::vector;
 using stdx::make_unique;
 
+namespace {
+
+/**
+ * An indirect reference to one buffered result: the location of its binary-comparable KeyString
+ * plus the index of the corresponding SortableDataItem. The sort permutes these references and
+ * never moves the items themselves.
+ */
+struct SortKeyRef {
+    const char* key;
+    size_t len;
+    size_t itemIndex;
+};
+
+// Below this many items a comparison sort beats another counting pass.
+const size_t kRadixSortCutoff = 32;
+
+bool sortKeyRefLess(const SortKeyRef& lhs, const SortKeyRef& rhs) {
+    const int cmp = memcmp(lhs.key, rhs.key, std::min(lhs.len, rhs.len));
+    if (0 != cmp) {
+        return cmp < 0;
+    }
+    return lhs.len < rhs.len;
+}
+
+/**
+ * MSB-first radix sort over KeyString bytes. All references in [items, items + n) must share
+ * the same first 'depth' bytes. Bucket 0 holds keys exhausted at this depth (a key sorts before
+ * any longer key it is a prefix of, matching KeyString::compare()); buckets 1..256 hold byte
+ * values 0..255. 'scratch' must have room for n entries.
+ */
+void radixSortKeys(SortKeyRef* items, size_t n, size_t depth, SortKeyRef* scratch) {
+    if (n < kRadixSortCutoff) {
+        std::sort(items, items + n, sortKeyRefLess);
+        return;
+    }
+
+    size_t counts[257] = {};
+    for (size_t i = 0; i < n; i++) {
+        const size_t bucket =
+            depth < items[i].len ? static_cast<unsigned char>(items[i].key[depth]) + 1 : 0;
+        counts[bucket]++;
+    }
+
+    size_t total = 0;
+    size_t offsets[257];
+    for (size_t bucket = 0; bucket < 257; bucket++) {
+        offsets[bucket] = total;
+        total += counts[bucket];
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        const size_t bucket =
+            depth < items[i].len ? static_cast<unsigned char>(items[i].key[depth]) + 1 : 0;
+        scratch[offsets[bucket]++] = items[i];
+    }
+    std::copy(scratch, scratch + n, items);
+
+    // Keys in bucket 0 ended at this depth and are therefore fully equal; only the byte-valued
+    // buckets need further refinement.
+    size_t start = counts[0];
+    for (size_t bucket = 1; bucket < 257; bucket++) {
+        if (counts[bucket] > 1) {
+            radixSortKeys(items + start, counts[bucket], depth + 1, scratch);
+        }
+        start += counts[bucket];
+    }
+}
+
+}  // namespace
+
 // static
 const char* SortStage::kStageType = "SORT";
 
@@ -76,6 +147,7 @@ SortStage::SortStage(OperationContext* opCtx,
       _ws(ws),
       _pattern(params.pattern),
       _limit(params.limit),
+      _sortKeyOrdering(Ordering::make(FindCommon::transformSortSpec(params.pattern))),
       _sorted(false),
       _resultIterator(_data.end()),
       _memUsage(0) {
@@ -263,8 +335,19 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
     if (_limit == 0) {
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
         member->makeObjOwnedIfNeeded();
-        _data.push_back(item);
-        _memUsage += member->getMemUsage();
+
+        // Render the (sortKey, recordId) pair as a binary-comparable KeyString once, so that
+        // sortBuffer() can order the buffer with plain byte comparisons instead of
+        // re-interpreting the BSON sort keys on every comparison.
+        SortableDataItem keyedItem = item;
+        const KeyString ks(
+            KeyString::kLatestVersion, keyedItem.sortKey, _sortKeyOrdering, keyedItem.recordId);
+        keyedItem.keyOffset = static_cast<size_t>(_keyBuffer.len());
+        keyedItem.keyLen = ks.getSize();
+        _keyBuffer.appendBuf(ks.getBuffer(), ks.getSize());
+
+        _data.push_back(keyedItem);
+        _memUsage += member->getMemUsage() + keyedItem.keyLen;
     } else if (_limit == 1) {
         if (_data.empty()) {
             member->makeObjOwnedIfNeeded();
@@ -325,8 +408,22 @@ void SortStage::addToBuffer(const SortableDataItem& item) {
 
 void SortStage::sortBuffer() {
     if (_limit == 0) {
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
-        std::sort(_data.begin(), _data.end(), cmp);
+        // Radix sort indirect references to the buffered items by their KeyString bytes; the
+        // items themselves are only permuted once at the end.
+        const char* keyBytes = _keyBuffer.buf();
+        vector<SortKeyRef> refs(_data.size());
+        for (size_t i = 0; i < _data.size(); i++) {
+            refs[i] = {keyBytes + _data[i].keyOffset, _data[i].keyLen, i};
+        }
+        vector<SortKeyRef> scratch(refs.size());
+        radixSortKeys(refs.data(), refs.size(), 0, scratch.data());
+
+        vector<SortableDataItem> sortedData;
+        sortedData.reserve(_data.size());
+        for (size_t i = 0; i < refs.size(); i++) {
+            sortedData.push_back(_data[refs[i].itemIndex]);
+        }
+        _data.swap(sortedData);
     } else if (_limit == 1) {
         // Buffer contains either 0 or 1 item so it is already in a sorted state.
         return;
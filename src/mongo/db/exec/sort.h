@@ -106,6 +106,10 @@ private:
     // Equal to 0 for no limit.
     size_t _limit;
 
+    // The sort pattern's directions, used to render the sort keys as binary-comparable
+    // KeyStrings on the full-sort path.
+    const Ordering _sortKeyOrdering;
+
     //
     // Data storage
     //
@@ -122,6 +126,10 @@ private:
         // RecordId to break sortKey ties.
         // See sorta.js.
         RecordId recordId;
+        // Where this item's binary-comparable KeyString rendering of (sortKey, recordId) lives
+        // in '_keyBuffer'. Only maintained on the full-sort (no limit) path.
+        size_t keyOffset = 0;
+        size_t keyLen = 0;
     };
 
     // Comparison object for data buffers (vector and set). Items are compared on (sortKey, loc).
@@ -167,6 +175,10 @@ private:
     typedef std::set<SortableDataItem, WorkingSetComparator> SortableDataItemSet;
     std::unique_ptr<SortableDataItemSet> _dataSet;
 
+    // Concatenated KeyString bytes for the items in '_data', addressed through each item's
+    // keyOffset/keyLen. Only used when there is no limit.
+    BufBuilder _keyBuffer;
+
     // Iterates through _data post-sort returning it.
     std::vector<SortableDataItem>::iterator _resultIterator;
 
@@ -215,7 +215,20 @@ Status SubplanStage::planSubqueries() {
 
             branchResult->cachedSolution.reset(rawCS);
         } else {
-            // No CachedSolution found. We'll have to plan from scratch.
+            // No CachedSolution found. The subplanner may still have recorded a winning index
+            // assignment for this branch's shape, which lets us skip planning it entirely.
+            if (PlanCache::shouldCacheQuery(*branchResult->canonicalQuery)) {
+                branchResult->branchCacheData =
+                    _collection->infoCache()->getPlanCache()->getBranchDecision(
+                        *branchResult->canonicalQuery);
+            }
+            if (branchResult->branchCacheData.get()) {
+                LOG(5) << "Subplanner: cached branch decision found for child " << i << " of "
+                       << _orExpression->numChildren();
+                continue;
+            }
+
+            // Nothing cached for this branch. We'll have to plan from scratch.
             LOG(5) << "Subplanner: planning child " << i << " of " << _orExpression->numChildren();
 
             // We don't set NO_TABLE_SCAN because peeking at the cache data will keep us from
@@ -305,6 +318,14 @@ Status SubplanStage::choosePlanForSubqueries(PlanYieldPolicy* yieldPolicy) {
             if (!tagStatus.isOK()) {
                 return tagStatus;
             }
+        } else if (branchResult->branchCacheData.get()) {
+            // The winning index assignment for this branch's shape was recorded by an earlier
+            // subplanned query.
+            Status tagStatus = tagOrChildAccordingToCache(
+                cacheData.get(), branchResult->branchCacheData.get(), orChild, _indexMap);
+            if (!tagStatus.isOK()) {
+                return tagStatus;
+            }
         } else if (1 == branchResult->solutions.size()) {
             QuerySolution* soln = branchResult->solutions.front().get();
             Status tagStatus = tagOrChildAccordingToCache(
@@ -312,6 +333,14 @@ Status SubplanStage::choosePlanForSubqueries(PlanYieldPolicy* yieldPolicy) {
             if (!tagStatus.isOK()) {
                 return tagStatus;
             }
+
+            // There was no plan ranking involved in this choice, so there is no risk in
+            // remembering it. Record the assignment so future subplanned queries skip planning
+            // this branch shape altogether.
+            if (PlanCache::shouldCacheQuery(*branchResult->canonicalQuery)) {
+                _collection->infoCache()->getPlanCache()->addBranchDecision(
+                    *branchResult->canonicalQuery, *soln->cacheData);
+            }
         } else {
             // N solutions, rank them.
 
@@ -552,7 +581,8 @@ unique_ptr<PlanStageStats> SubplanStage::getStats() {
 }
 
 bool SubplanStage::branchPlannedFromCache(size_t i) const {
-    return NULL != _branchResults[i]->cachedSolution.get();
+    return NULL != _branchResults[i]->cachedSolution.get() ||
+        NULL != _branchResults[i]->branchCacheData.get();
 }
 
 const SpecificStats* SubplanStage::getSpecificStats() const {
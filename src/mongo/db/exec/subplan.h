@@ -157,6 +157,10 @@ private:
         // composite solution.
         std::unique_ptr<CachedSolution> cachedSolution;
 
+        // The winning index assignment for this branch's shape, if one was recorded in the
+        // plan cache by an earlier subplanned query. Set only when 'cachedSolution' is not.
+        std::unique_ptr<SolutionCacheData> branchCacheData;
+
         // Query solutions resulting from planning the $or branch.
         std::vector<std::unique_ptr<QuerySolution>> solutions;
     };
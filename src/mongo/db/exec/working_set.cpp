@@ -28,10 +28,13 @@
 
 #include "mongo/db/exec/working_set.h"
 
+#include <new>
+
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/record_fetcher.h"
+#include "mongo/stdx/memory.h"
 
 namespace mongo {
 
@@ -46,7 +49,7 @@ WorkingSet::WorkingSet() : _freeList(INVALID_ID) {}
 
 WorkingSet::~WorkingSet() {
     for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
+        _data[i].member->~WorkingSetMember();
     }
 }
 
@@ -58,7 +61,8 @@ WorkingSetID WorkingSet::allocate() {
         WorkingSetID id = _data.size();
         _data.resize(_data.size() + 1);
         _data.back().nextFreeOrSelf = id;
-        _data.back().member = new WorkingSetMember();
+        _data.back().member =
+            new (_arena.allocate(sizeof(WorkingSetMember))) WorkingSetMember();
         return id;
     }
 
@@ -97,9 +101,10 @@ bool WorkingSet::isFlagged(WorkingSetID id) const {
 
 void WorkingSet::clear() {
     for (size_t i = 0; i < _data.size(); i++) {
-        delete _data[i].member;
+        _data[i].member->~WorkingSetMember();
     }
     _data.clear();
+    _arena.reset();
 
     // Since working set is now empty, the free list pointer should
     // point to nothing.
@@ -147,6 +152,7 @@ void WorkingSetMember::clear() {
 
     keyData.clear();
     obj.reset();
+    _elementOffsets.reset();
     _state = WorkingSetMember::INVALID;
 }
 
@@ -178,6 +184,16 @@ void WorkingSetMember::makeObjOwnedIfNeeded() {
     }
 }
 
+const BSONElementOffsetTable& WorkingSetMember::elementOffsets() const {
+    invariant(hasObj());
+    if (!_elementOffsets) {
+        _elementOffsets = stdx::make_unique<BSONElementOffsetTable>(obj.value());
+    } else if (!_elementOffsets->isFor(obj.value())) {
+        _elementOffsets->reset(obj.value());
+    }
+    return *_elementOffsets;
+}
+
 bool WorkingSetMember::hasComputed(const WorkingSetComputedDataType type) const {
     return _computed[type].get();
 }
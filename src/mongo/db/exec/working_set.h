@@ -31,11 +31,13 @@
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/bson/util/bson_offset_table.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/snapshot.h"
 #include "mongo/platform/unordered_set.h"
 #include "mongo/stdx/unordered_set.h"
+#include "mongo/util/bump_arena.h"
 
 namespace mongo {
 
@@ -147,7 +149,7 @@ private:
         // Free list link if freed. Points to self if in use.
         WorkingSetID nextFreeOrSelf;
 
-        // Owning pointer
+        // Owned by '_arena'; constructed with placement new and destroyed explicitly.
         WorkingSetMember* member;
     };
 
@@ -158,8 +160,15 @@ private:
     // Index into _data, forming a linked-list using MemberHolder::nextFreeOrSelf as the next
     // link. INVALID_ID is the list terminator since 0 is a valid index.
     // If _freeList == INVALID_ID, the free list is empty and all elements in _data are in use.
+    // Freed ids are pushed onto and popped off the head of the list, so recycling is LIFO and
+    // the most recently freed (cache-warm) member is handed out first.
     WorkingSetID _freeList;
 
+    // Backing storage for the members in '_data'. Members are allocated here as slots are
+    // created, packed together for locality, and released wholesale by clear() and the
+    // destructor rather than freed one by one.
+    BumpArena _arena;
+
     // An insert-only set of WorkingSetIDs that have been flagged for review.
     stdx::unordered_set<WorkingSetID> _flagged;
 
@@ -298,6 +307,14 @@ public:
      */
     void makeObjOwnedIfNeeded();
 
+    /**
+     * Returns an element offset table for 'obj', building it on first use and reusing it for
+     * later traversals of the same buffer. Stages that walk the document repeatedly (matcher,
+     * projection, key generation) should iterate via this table instead of BSONObjIterator so
+     * element sizes are computed only once per document. Must only be called when hasObj().
+     */
+    const BSONElementOffsetTable& elementOffsets() const;
+
     //
     // Computed data
     //
@@ -338,6 +355,10 @@ private:
 
     std::unique_ptr<WorkingSetComputedData> _computed[WSM_COMPUTED_NUM_TYPES];
 
+    // Lazily built by elementOffsets(); rebuilt whenever 'obj' is backed by a different
+    // buffer than the one the table was computed for.
+    mutable std::unique_ptr<BSONElementOffsetTable> _elementOffsets;
+
     std::unique_ptr<RecordFetcher> _fetcher;
 };
 
@@ -35,52 +35,60 @@
 #include "mongo/db/fts/stemmer.h"
 #include "mongo/db/fts/stop_words.h"
 #include "mongo/db/fts/tokenizer.h"
-#include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/stringutils.h"
 
 namespace mongo {
 namespace fts {
 
-using std::string;
-
 BasicFTSTokenizer::BasicFTSTokenizer(const FTSLanguage* language)
-    : _language(language), _stemmer(language), _stopWords(StopWords::getStopWords(language)) {}
+    : _language(language),
+      _stemmer(language),
+      _stopWords(StopWords::getStopWords(language)),
+      _tokenizer(language, "") {}
 
 void BasicFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
-    _document = document.toString();
-    _tokenizer = stdx::make_unique<Tokenizer>(_language, _document);
+    // assign() reuses the buffer's capacity when the tokenizer is reset once per field.
+    _document.assign(document.rawData(), document.size());
+    _tokenizer.reset(_document);
 }
 
 bool BasicFTSTokenizer::moveNext() {
     while (true) {
-        bool hasMore = _tokenizer->more();
+        bool hasMore = _tokenizer.more();
         if (!hasMore) {
-            _stem = "";
+            _stem.clear();
             return false;
         }
 
-        Token token = _tokenizer->next();
+        Token token = _tokenizer.next();
 
         // Do not return delimiters
         if (token.type != Token::TEXT) {
             continue;
         }
 
-        string word = tolowerString(token.data);
-
         // Stop words are case-sensitive so we need them to be lower cased to check
-        // against the stop word list
-        if ((_options & FTSTokenizer::kFilterStopWords) && _stopWords->isStopWord(word)) {
+        // against the stop word list. Lower case in place into the reusable buffer.
+        // Only ASCII letters are folded (see the class comment), so an explicit range
+        // check beats a locale-aware tolower() call per character.
+        _word.assign(token.data.rawData(), token.data.size());
+        for (char& c : _word) {
+            if (c >= 'A' && c <= 'Z')
+                c += 'a' - 'A';
+        }
+
+        if ((_options & FTSTokenizer::kFilterStopWords) && _stopWords->isStopWord(_word)) {
             continue;
         }
 
         if (_options & FTSTokenizer::kGenerateCaseSensitiveTokens) {
-            word = token.data.toString();
+            _word.assign(token.data.rawData(), token.data.size());
         }
 
-        _stem = _stemmer.stem(word).toString();
+        const StringData stem = _stemmer.stem(_word);
+        _stem.assign(stem.rawData(), stem.size());
         return true;
     }
 }
@@ -73,10 +73,13 @@ private:
     const Stemmer _stemmer;
     const StopWords* const _stopWords;
 
+    // Buffers reused across reset() and moveNext() calls so steady-state tokenization of a
+    // document performs no per-field or per-token allocations.
     std::string _document;
-    std::unique_ptr<Tokenizer> _tokenizer;
+    Tokenizer _tokenizer;
     Options _options;
 
+    std::string _word;
     std::string _stem;
 };
 
@@ -28,53 +28,29 @@
 *    it in the license file.
 */
 
+#include <cstring>
 #include <string>
 
 #include "mongo/db/fts/tokenizer.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/stringutils.h"
 
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define MONGO_FTS_TOKENIZER_HAVE_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
 namespace mongo {
 
 namespace fts {
 
-Tokenizer::Tokenizer(const FTSLanguage* language, StringData str) : _pos(0), _raw(str) {
-    _english = (language->str() == "english");
-    _skipWhitespace();
-}
-
-bool Tokenizer::more() const {
-    return _pos < _raw.size();
-}
-
-Token Tokenizer::next() {
-    if (_pos >= _raw.size())
-        return Token(Token::INVALID, "", 0);
-
-    unsigned start = _pos++;
-    Token::Type type = _type(_raw[start]);
-    if (type == Token::WHITESPACE)
-        invariant(false);
-
-    if (type == Token::TEXT)
-        while (_pos < _raw.size() && _type(_raw[_pos]) == type)
-            _pos++;
-
-    StringData ret = _raw.substr(start, _pos - start);
-    _skipWhitespace();
-    return Token(type, ret, start);
-}
-
-
-bool Tokenizer::_skipWhitespace() {
-    unsigned start = _pos;
-    while (_pos < _raw.size() && _type(_raw[_pos]) == Token::WHITESPACE)
-        _pos++;
-    return _pos > start;
-}
-
+namespace {
 
-Token::Type Tokenizer::_type(char c) const {
+/**
+ * Classifies a single character. This is the source of truth for the character class
+ * tables below; it is only evaluated when the tables are built.
+ */
+Token::Type classify(char c, bool english) {
     switch (c) {
         case ' ':
         case '\f':
@@ -84,7 +60,7 @@ Token::Type Tokenizer::_type(char c) const {
         case '\n':
             return Token::WHITESPACE;
         case '\'':
-            if (_english)
+            if (english)
                 return Token::TEXT;
             else
                 return Token::WHITESPACE;
@@ -134,5 +110,135 @@ Token::Type Tokenizer::_type(char c) const {
             return Token::TEXT;
     }
 }
+
+/**
+ * Precomputed character classes for one delimiter dialect (english treats '\'' as text).
+ * Tokenization is a per-byte hot loop for both text indexing and $text parsing, so the
+ * classification switch is folded into a single table load.
+ */
+struct CharClassTable {
+    explicit CharClassTable(bool english) {
+        for (int c = 0; c < 256; c++) {
+            types[c] = classify(static_cast<char>(c), english);
+        }
+        std::memset(delimBits, 0, sizeof(delimBits));
+        for (int c = 0; c < 0x80; c++) {
+            if (types[c] != Token::TEXT)
+                delimBits[c & 0x0F] |= 1 << (c >> 4);
+        }
+    }
+
+    Token::Type types[256];
+
+    // Nibble-indexed bitmasks consumed by the vectorized scanner: bit (c >> 4) of
+    // delimBits[c & 0xF] is set when ASCII character c ends a run of TEXT characters.
+    // Bytes >= 0x80 always classify as TEXT, so only seven bits per entry are needed
+    // and the scanner can zero the contribution of high bytes via their high nibble.
+    unsigned char delimBits[16];
+};
+
+const CharClassTable englishTable(true);
+const CharClassTable nonEnglishTable(false);
+
+const CharClassTable& tableFor(bool english) {
+    return english ? englishTable : nonEnglishTable;
+}
+
+size_t scanTextRunScalar(const char* data, size_t pos, size_t size, const CharClassTable& table) {
+    while (pos < size && table.types[static_cast<unsigned char>(data[pos])] == Token::TEXT)
+        pos++;
+    return pos;
+}
+
+#ifdef MONGO_FTS_TOKENIZER_HAVE_SSSE3
+
+/**
+ * Classifies 16 bytes at a time by splitting each byte into nibbles and probing the
+ * table's delimiter bitmasks with PSHUFB. A byte breaks the run iff
+ * delimBits[lo] & (1 << hi) is nonzero; high bytes (hi >= 8) shuffle a zero bit and so
+ * never break, matching the scalar table.
+ */
+__attribute__((target("ssse3"))) size_t scanTextRunSsse3(const char* data,
+                                                         size_t pos,
+                                                         size_t size,
+                                                         const CharClassTable& table) {
+    const __m128i delimLut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.delimBits));
+    const __m128i hiBitLut = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (pos + 16 <= size) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const __m128i lo = _mm_and_si128(bytes, nibbleMask);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask);
+        const __m128i delim =
+            _mm_and_si128(_mm_shuffle_epi8(delimLut, lo), _mm_shuffle_epi8(hiBitLut, hi));
+        // Lanes are 0xFF where the byte continues the TEXT run.
+        const int textMask = _mm_movemask_epi8(_mm_cmpeq_epi8(delim, zero));
+        if (textMask != 0xFFFF)
+            return pos + __builtin_ctz(~textMask & 0xFFFF);
+        pos += 16;
+    }
+    return scanTextRunScalar(data, pos, size, table);
+}
+
+#endif
+
+size_t scanTextRun(const char* data, size_t pos, size_t size, const CharClassTable& table) {
+#ifdef MONGO_FTS_TOKENIZER_HAVE_SSSE3
+    static const bool useSsse3 = __builtin_cpu_supports("ssse3");
+    if (useSsse3)
+        return scanTextRunSsse3(data, pos, size, table);
+#endif
+    return scanTextRunScalar(data, pos, size, table);
+}
+
+}  // namespace
+
+Tokenizer::Tokenizer(const FTSLanguage* language, StringData str) : _pos(0), _raw(str) {
+    _english = (language->str() == "english");
+    _skipWhitespace();
+}
+
+void Tokenizer::reset(StringData str) {
+    _pos = 0;
+    _raw = str;
+    _skipWhitespace();
+}
+
+bool Tokenizer::more() const {
+    return _pos < _raw.size();
+}
+
+Token Tokenizer::next() {
+    if (_pos >= _raw.size())
+        return Token(Token::INVALID, "", 0);
+
+    unsigned start = _pos++;
+    Token::Type type = _type(_raw[start]);
+    if (type == Token::WHITESPACE)
+        invariant(false);
+
+    if (type == Token::TEXT)
+        _pos = static_cast<unsigned>(
+            scanTextRun(_raw.rawData(), _pos, _raw.size(), tableFor(_english)));
+
+    StringData ret = _raw.substr(start, _pos - start);
+    _skipWhitespace();
+    return Token(type, ret, start);
+}
+
+
+bool Tokenizer::_skipWhitespace() {
+    unsigned start = _pos;
+    while (_pos < _raw.size() && _type(_raw[_pos]) == Token::WHITESPACE)
+        _pos++;
+    return _pos > start;
+}
+
+
+Token::Type Tokenizer::_type(char c) const {
+    return tableFor(_english).types[static_cast<unsigned char>(c)];
+}
 }
 }
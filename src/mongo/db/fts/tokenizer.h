@@ -59,6 +59,12 @@ class Tokenizer {
 public:
     Tokenizer(const FTSLanguage* language, StringData str);
 
+    /**
+     * Restarts tokenization over 'str', which must remain valid while tokens are consumed.
+     * Allows one Tokenizer to be reused across the fields of a document.
+     */
+    void reset(StringData str);
+
     bool more() const;
     Token next();
 
@@ -67,7 +73,7 @@ private:
     bool _skipWhitespace();
 
     unsigned _pos;
-    const StringData _raw;
+    StringData _raw;
     bool _english;
 };
 }
@@ -118,5 +118,27 @@ TEST(Tokenizer, Quote1French) {
     ASSERT_EQUALS("s", b.data.toString());
     ASSERT_EQUALS("car", c.data.toString());
 }
+
+// Tokens longer than one 16-byte block exercise the vectorized text-run scanner.
+TEST(Tokenizer, LongTokens) {
+    const std::string first(40, 'a');
+    const std::string second = "caf\xc3\xa9sinthemiddleofalongrunoftext";
+    Tokenizer i(&languageEnglishV2, first + " " + second + ".tail");
+
+    Token a = i.next();
+    Token b = i.next();
+    Token c = i.next();
+    Token d = i.next();
+
+    ASSERT_EQUALS(Token::TEXT, a.type);
+    ASSERT_EQUALS(first, a.data.toString());
+    ASSERT_EQUALS(Token::TEXT, b.type);
+    ASSERT_EQUALS(second, b.data.toString());
+    ASSERT_EQUALS(Token::DELIMITER, c.type);
+    ASSERT_EQUALS(".", c.data.toString());
+    ASSERT_EQUALS(Token::TEXT, d.type);
+    ASSERT_EQUALS("tail", d.data.toString());
+    ASSERT(!i.more());
+}
 }
 }
@@ -34,6 +34,7 @@
 
 #include "mongo/db/hasher.h"
 
+#include <third_party/murmurhash3/MurmurHash3.h>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/util/md5.hpp"
@@ -79,7 +80,32 @@ void Hasher::finish(HashDigest out) {
     md5_finish(&_md5State, out);
 }
 
-void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
+/**
+ * Version-1 accumulator: buffers the canonicalized bytes and hashes them in one shot with
+ * MurmurHash3. The seed selects a member of the hash family, mirroring how version 0 folds
+ * it into the MD5 stream.
+ */
+class Murmur3Hasher {
+    MONGO_DISALLOW_COPYING(Murmur3Hasher);
+
+public:
+    explicit Murmur3Hasher(HashSeed seed) : _seed(static_cast<uint32_t>(seed)) {}
+
+    void addData(const void* keyData, size_t numBytes) {
+        _buf.appendBuf(keyData, numBytes);
+    }
+
+    void finish(HashDigest out) {
+        MurmurHash3_x64_128(_buf.buf(), _buf.len(), _seed, out);
+    }
+
+private:
+    BufBuilder _buf;
+    uint32_t _seed;
+};
+
+template <typename HasherType>
+void recursiveHash(HasherType* h, const BSONElement& e, bool includeFieldName) {
     int canonicalType = endian::nativeToLittle(e.canonicalType());
     h->addData(&canonicalType, sizeof(canonicalType));
 
@@ -137,4 +163,21 @@ long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
     return digestView.read<LittleEndian<long long int>>();
 }
 
+long long int BSONElementHasher::hash64ForVersion(const BSONElement& e,
+                                                  HashSeed seed,
+                                                  int version) {
+    if (version == 0) {
+        return hash64(e, seed);
+    }
+    invariant(version == 1);
+
+    Murmur3Hasher h(seed);
+    recursiveHash(&h, e, false);
+    HashDigest d;
+    h.finish(d);
+    // As for version 0, only the first 8 of the 16 digest bytes form the key.
+    ConstDataView digestView(reinterpret_cast<const char*>(d));
+    return digestView.read<LittleEndian<long long int>>();
+}
+
 }  // namespace mongo
@@ -68,6 +68,19 @@ public:
      */
     static long long int hash64(const BSONElement& e, HashSeed seed);
 
+    /* Latest hashed-index hash version. Version 0 is the original MD5-based hash above;
+     * version 1 feeds the exact same canonicalized byte stream (so type squashing and
+     * missing/null behavior are unchanged) through MurmurHash3, which is roughly an order
+     * of magnitude cheaper per key. The version is recorded per index ("hashVersion" in the
+     * index spec), so existing version-0 indexes keep reading and writing MD5 hashes.
+     */
+    static const int LATEST_HASH_VERSION = 1;
+
+    /* Computes the 64-bit hash of "e" for the given hashed-index version. Version 0 is
+     * identical to hash64(). The caller is responsible for validating 'version'.
+     */
+    static long long int hash64ForVersion(const BSONElement& e, HashSeed seed, int version);
+
 private:
     BSONElementHasher();
 };
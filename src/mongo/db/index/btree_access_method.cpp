@@ -67,4 +67,11 @@ void BtreeAccessMethod::doGetKeys(const BSONObj& obj,
     _keyGenerator->getKeys(obj, keys, multikeyPaths);
 }
 
+void BtreeAccessMethod::doGetKeys(const BSONObj& obj,
+                                  IndexKeyVector* keys,
+                                  MultikeyPaths* multikeyPaths) const {
+    // The btree key generator emits vectors natively; no set is involved.
+    _keyGenerator->getKeys(obj, keys, multikeyPaths);
+}
+
 }  // namespace mongo
@@ -28,6 +28,9 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <array>
+#include <cstring>
+
 #include <boost/optional.hpp>
 
 #include "mongo/bson/bsonobjbuilder.h"
@@ -85,12 +88,44 @@ std::unique_ptr<BtreeKeyGenerator> BtreeKeyGenerator::make(IndexVersion indexVer
 void BtreeKeyGenerator::getKeys(const BSONObj& obj,
                                 BSONObjSet* keys,
                                 MultikeyPaths* multikeyPaths) const {
+    // Set output is the compatibility form; generation itself always runs through the vector.
+    IndexKeyVector keyVector;
+    getKeys(obj, &keyVector, multikeyPaths);
+    for (size_t i = 0; i < keyVector.size(); ++i) {
+        keys->insert(keyVector[i].getOwned());
+    }
+}
+
+void BtreeKeyGenerator::getKeys(const BSONObj& obj,
+                                IndexKeyVector* keys,
+                                MultikeyPaths* multikeyPaths) const {
+    const size_t sizeBefore = keys->size();
     // '_fieldNames' and '_fixed' are passed by value so that they can be mutated as part of the
     // getKeys call.  :|
     getKeysImpl(_fieldNames, _fixed, obj, keys, multikeyPaths);
-    if (keys->empty() && !_isSparse) {
+    if (keys->size() == sizeBefore && !_isSparse) {
         keys->insert(_nullKey);
     }
+    keys->sealDocument();
+}
+
+void BtreeKeyGenerator::getKeys(const std::vector<BSONObj>& objs,
+                                IndexKeyVector* keys,
+                                MultikeyPaths* multikeyPaths) const {
+    MultikeyPaths docMultikeyPaths;
+    for (const auto& obj : objs) {
+        docMultikeyPaths.clear();
+        getKeys(obj, keys, multikeyPaths ? &docMultikeyPaths : nullptr);
+        if (multikeyPaths) {
+            if (multikeyPaths->empty()) {
+                multikeyPaths->resize(docMultikeyPaths.size());
+            }
+            for (size_t i = 0; i < docMultikeyPaths.size(); ++i) {
+                (*multikeyPaths)[i].insert(docMultikeyPaths[i].begin(),
+                                           docMultikeyPaths[i].end());
+            }
+        }
+    }
 }
 
 static void assertParallelArrays(const char* first, const char* second) {
@@ -107,7 +142,7 @@ BtreeKeyGeneratorV0::BtreeKeyGeneratorV0(std::vector<const char*> fieldNames,
 void BtreeKeyGeneratorV0::getKeysImpl(std::vector<const char*> fieldNames,
                                       std::vector<BSONElement> fixed,
                                       const BSONObj& obj,
-                                      BSONObjSet* keys,
+                                      IndexKeyVector* keys,
                                       MultikeyPaths* multikeyPaths) const {
     if (_isIdIndex) {
         // we special case for speed
@@ -118,8 +153,9 @@ void BtreeKeyGeneratorV0::getKeysImpl(std::vector<const char*> fieldNames,
             int size = e.size() + 5 /* bson over head*/ - 3 /* remove _id string */;
             BSONObjBuilder b(size);
             b.appendAs(e, "");
-            keys->insert(b.obj());
-            invariant(keys->begin()->objsize() == size);
+            BSONObj key = b.obj();
+            invariant(key.objsize() == size);
+            keys->insert(key);
         }
         return;
     }
@@ -246,6 +282,17 @@ BtreeKeyGeneratorV1::BtreeKeyGeneratorV1(std::vector<const char*> fieldNames,
         invariant(pathLength > 0);
         _pathLengths.push_back(pathLength);
     }
+
+    // Resolve once whether this key pattern qualifies for the top-level fast path: every
+    // component must be a plain top-level field with no prior traversal state, and there must be
+    // no collator (collation-aware appends need the general machinery's string handling).
+    _canFastExtract = !_isIdIndex && !_collator && !fieldNames.empty() &&
+        fieldNames.size() <= kFastExtractMaxFields;
+    for (size_t i = 0; i < fieldNames.size() && _canFastExtract; ++i) {
+        if (_pathLengths[i] != 1 || *fieldNames[i] == '\0' || !fixed[i].eoo()) {
+            _canFastExtract = false;
+        }
+    }
 }
 
 BSONElement BtreeKeyGeneratorV1::extractNextElement(const BSONObj& obj,
@@ -283,7 +330,7 @@ BSONElement BtreeKeyGeneratorV1::extractNextElement(const BSONObj& obj,
 void BtreeKeyGeneratorV1::_getKeysArrEltFixed(std::vector<const char*>* fieldNames,
                                               std::vector<BSONElement>* fixed,
                                               const BSONElement& arrEntry,
-                                              BSONObjSet* keys,
+                                              IndexKeyVector* keys,
                                               unsigned numNotFound,
                                               const BSONElement& arrObjElt,
                                               const std::set<size_t>& arrIdxs,
@@ -307,10 +354,62 @@ void BtreeKeyGeneratorV1::_getKeysArrEltFixed(std::vector<const char*>* fieldNam
                          multikeyPaths);
 }
 
+bool BtreeKeyGeneratorV1::_tryTopLevelExtract(const BSONObj& obj,
+                                              IndexKeyVector* keys,
+                                              MultikeyPaths* multikeyPaths) const {
+    // One pass over the document, matching each element against the still-unfound components of
+    // the key pattern. Documents are scanned in full only when they are missing indexed fields.
+    std::array<BSONElement, kFastExtractMaxFields> found;
+    const size_t nFields = _fieldNames.size();
+    size_t numFound = 0;
+
+    BSONObjIterator it(obj);
+    while (it.more() && numFound < nFields) {
+        const BSONElement e = it.next();
+        const char* name = e.fieldName();
+        for (size_t i = 0; i < nFields; ++i) {
+            if (!found[i].eoo() || strcmp(name, _fieldNames[i]) != 0) {
+                continue;
+            }
+            if (e.type() == Array) {
+                // Arrays need the general expansion and multikey machinery.
+                return false;
+            }
+            found[i] = e;
+            ++numFound;
+            break;
+        }
+    }
+
+    if (_isSparse && numFound == 0) {
+        // Sparse indexes generate no key when every indexed field is missing.
+        if (multikeyPaths) {
+            multikeyPaths->resize(nFields);
+        }
+        return true;
+    }
+
+    BSONObjBuilder b(_sizeTracker);
+    for (size_t i = 0; i < nFields; ++i) {
+        if (found[i].eoo()) {
+            b.appendNull("");
+        } else {
+            b.appendAs(found[i], "");
+        }
+    }
+    keys->insert(b.obj());
+
+    // No arrays were encountered, so no path component can be multikey.
+    if (multikeyPaths) {
+        multikeyPaths->resize(nFields);
+    }
+    return true;
+}
+
 void BtreeKeyGeneratorV1::getKeysImpl(std::vector<const char*> fieldNames,
                                       std::vector<BSONElement> fixed,
                                       const BSONObj& obj,
-                                      BSONObjSet* keys,
+                                      IndexKeyVector* keys,
                                       MultikeyPaths* multikeyPaths) const {
     if (_isIdIndex) {
         // we special case for speed
@@ -320,15 +419,14 @@ void BtreeKeyGeneratorV1::getKeysImpl(std::vector<const char*> fieldNames,
         } else if (_collator) {
             BSONObjBuilder b;
             CollationIndexKey::collationAwareIndexKeyAppend(e, _collator, &b);
-
-            // Insert a copy so its buffer size fits the object size.
-            keys->insert(b.obj().copy());
+            keys->insert(b.obj());
         } else {
             int size = e.size() + 5 /* bson over head*/ - 3 /* remove _id string */;
             BSONObjBuilder b(size);
             b.appendAs(e, "");
-            keys->insert(b.obj());
-            invariant(keys->begin()->objsize() == size);
+            BSONObj key = b.obj();
+            invariant(key.objsize() == size);
+            keys->insert(key);
         }
 
         // The {_id: 1} index can never be multikey because the _id field isn't allowed to be an
@@ -339,6 +437,10 @@ void BtreeKeyGeneratorV1::getKeysImpl(std::vector<const char*> fieldNames,
         return;
     }
 
+    if (_canFastExtract && _tryTopLevelExtract(obj, keys, multikeyPaths)) {
+        return;
+    }
+
     if (multikeyPaths) {
         invariant(multikeyPaths->empty());
         multikeyPaths->resize(fieldNames.size());
@@ -351,7 +453,7 @@ void BtreeKeyGeneratorV1::getKeysImplWithArray(
     std::vector<const char*> fieldNames,
     std::vector<BSONElement> fixed,
     const BSONObj& obj,
-    BSONObjSet* keys,
+    IndexKeyVector* keys,
     unsigned numNotFound,
     const std::vector<PositionalPathInfo>& positionalInfo,
     MultikeyPaths* multikeyPaths) const {
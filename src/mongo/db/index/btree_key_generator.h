@@ -34,6 +34,7 @@
 
 #include "mongo/bson/bsonobj_comparator_interface.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index/index_key_vector.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/jsobj.h"
 
@@ -61,6 +62,22 @@ public:
 
     void getKeys(const BSONObj& obj, BSONObjSet* keys, MultikeyPaths* multikeyPaths) const;
 
+    /**
+     * Vector-output form of getKeys(): emits the document's keys into 'keys', sorted and
+     * deduplicated, without going through a node-based set. The generated keys are appended as
+     * a new document group; see IndexKeyVector.
+     */
+    void getKeys(const BSONObj& obj, IndexKeyVector* keys, MultikeyPaths* multikeyPaths) const;
+
+    /**
+     * Batch form: generates keys for each of 'objs' into 'keys', one sealed document group per
+     * input document, in order. If 'multikeyPaths' is non-null it receives the union of the
+     * per-document multikey path components.
+     */
+    void getKeys(const std::vector<BSONObj>& objs,
+                 IndexKeyVector* keys,
+                 MultikeyPaths* multikeyPaths) const;
+
 protected:
     // These are used by the getKeysImpl(s) below.
     std::vector<const char*> _fieldNames;
@@ -73,7 +90,7 @@ private:
     virtual void getKeysImpl(std::vector<const char*> fieldNames,
                              std::vector<BSONElement> fixed,
                              const BSONObj& obj,
-                             BSONObjSet* keys,
+                             IndexKeyVector* keys,
                              MultikeyPaths* multikeyPaths) const = 0;
 
     std::vector<BSONElement> _fixed;
@@ -98,7 +115,7 @@ private:
     void getKeysImpl(std::vector<const char*> fieldNames,
                      std::vector<BSONElement> fixed,
                      const BSONObj& obj,
-                     BSONObjSet* keys,
+                     IndexKeyVector* keys,
                      MultikeyPaths* multikeyPaths) const final;
 };
 
@@ -182,7 +199,7 @@ private:
     void getKeysImpl(std::vector<const char*> fieldNames,
                      std::vector<BSONElement> fixed,
                      const BSONObj& obj,
-                     BSONObjSet* keys,
+                     IndexKeyVector* keys,
                      MultikeyPaths* multikeyPaths) const final;
 
     /**
@@ -191,7 +208,7 @@ private:
     void getKeysImplWithArray(std::vector<const char*> fieldNames,
                               std::vector<BSONElement> fixed,
                               const BSONObj& obj,
-                              BSONObjSet* keys,
+                              IndexKeyVector* keys,
                               unsigned numNotFound,
                               const std::vector<PositionalPathInfo>& positionalInfo,
                               MultikeyPaths* multikeyPaths) const;
@@ -241,7 +258,7 @@ private:
     void _getKeysArrEltFixed(std::vector<const char*>* fieldNames,
                              std::vector<BSONElement>* fixed,
                              const BSONElement& arrEntry,
-                             BSONObjSet* keys,
+                             IndexKeyVector* keys,
                              unsigned numNotFound,
                              const BSONElement& arrObjElt,
                              const std::set<size_t>& arrIdxs,
@@ -249,12 +266,31 @@ private:
                              const std::vector<PositionalPathInfo>& positionalInfo,
                              MultikeyPaths* multikeyPaths) const;
 
+    // Upper bound on key pattern size for the top-level fast path; chosen to cover any legal
+    // compound index while keeping the per-call scratch buffer on the stack.
+    static const size_t kFastExtractMaxFields = 32;
+
+    /**
+     * Fast path for key patterns whose components are all plain top-level fields. Scans the
+     * document once, looking up each indexed field directly, and emits a single key when none of
+     * the extracted values is an array. Returns false without modifying any output when an array
+     * value is encountered, in which case the caller must fall back to the general
+     * positional/multikey machinery. Only called when '_canFastExtract' is set.
+     */
+    bool _tryTopLevelExtract(const BSONObj& obj,
+                             IndexKeyVector* keys,
+                             MultikeyPaths* multikeyPaths) const;
+
     const std::vector<PositionalPathInfo> _emptyPositionalInfo;
 
     // A vector with size equal to the number of elements in the index key pattern. Each element in
     // the vector is the number of path components in the indexed field.
     std::vector<size_t> _pathLengths;
 
+    // Resolved once at construction: true if every component of the key pattern is a plain
+    // top-level field and no collator is in use, making '_tryTopLevelExtract' applicable.
+    bool _canFastExtract = false;
+
     // Null if this key generator orders strings according to the simple binary compare. If
     // non-null, represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* _collator;
@@ -1160,4 +1160,100 @@ TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromNestedArray) {
         testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
 }
 
+std::unique_ptr<BtreeKeyGenerator> makeKeyGen(const BSONObj& kp) {
+    vector<const char*> fieldNames;
+    vector<BSONElement> fixed;
+    BSONObjIterator it(kp);
+    while (it.more()) {
+        fieldNames.push_back(it.next().fieldName());
+        fixed.push_back(BSONElement());
+    }
+    return std::unique_ptr<BtreeKeyGenerator>(
+        new BtreeKeyGeneratorV1(fieldNames, fixed, false, nullptr));
+}
+
+TEST(BtreeKeyGeneratorTest, VectorOutputIsSortedAndDeduplicated) {
+    auto keyGen = makeKeyGen(fromjson("{a: 1}"));
+    // The array produces the duplicate candidate key {'': 1} plus {'': 3} and {'': 2}.
+    BSONObj genKeysFrom = fromjson("{a: [3, 1, 2, 1]}");
+
+    IndexKeyVector keys;
+    keyGen->getKeys(genKeysFrom, &keys, nullptr);
+    ASSERT_EQUALS(keys.size(), 3U);
+    ASSERT_BSONOBJ_EQ(keys[0], fromjson("{'': 1}"));
+    ASSERT_BSONOBJ_EQ(keys[1], fromjson("{'': 2}"));
+    ASSERT_BSONOBJ_EQ(keys[2], fromjson("{'': 3}"));
+}
+
+TEST(BtreeKeyGeneratorTest, VectorOutputMatchesSetOutput) {
+    auto keyGen = makeKeyGen(fromjson("{a: 1, b: 1}"));
+    BSONObj genKeysFrom = fromjson("{a: [{c: 1}, 2, 2], b: 'x'}");
+
+    BSONObjSet setKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    keyGen->getKeys(genKeysFrom, &setKeys, nullptr);
+
+    IndexKeyVector vectorKeys;
+    keyGen->getKeys(genKeysFrom, &vectorKeys, nullptr);
+
+    ASSERT_EQUALS(setKeys.size(), vectorKeys.size());
+    size_t i = 0;
+    for (const auto& key : setKeys) {
+        ASSERT_BSONOBJ_EQ(key, vectorKeys[i++]);
+    }
+}
+
+TEST(BtreeKeyGeneratorTest, BatchGroupsKeysByDocument) {
+    auto keyGen = makeKeyGen(fromjson("{a: 1}"));
+    std::vector<BSONObj> docs{
+        fromjson("{a: [2, 1]}"), fromjson("{b: 1}"), fromjson("{a: 7}")};
+
+    IndexKeyVector keys;
+    MultikeyPaths multikeyPaths;
+    keyGen->getKeys(docs, &keys, &multikeyPaths);
+
+    ASSERT_EQUALS(keys.numDocs(), 3U);
+    ASSERT_EQUALS(keys.docBegin(0), 0U);
+    ASSERT_EQUALS(keys.docEnd(0), 2U);
+    ASSERT_BSONOBJ_EQ(keys[0], fromjson("{'': 1}"));
+    ASSERT_BSONOBJ_EQ(keys[1], fromjson("{'': 2}"));
+
+    // The second document has no 'a', so it contributes a single null key.
+    ASSERT_EQUALS(keys.docEnd(1) - keys.docBegin(1), 1U);
+    ASSERT_BSONOBJ_EQ(keys[keys.docBegin(1)], fromjson("{'': null}"));
+
+    ASSERT_EQUALS(keys.docEnd(2) - keys.docBegin(2), 1U);
+    ASSERT_BSONOBJ_EQ(keys[keys.docBegin(2)], fromjson("{'': 7}"));
+
+    // Only the first document was multikey.
+    ASSERT(multikeyPaths == MultikeyPaths{{0U}});
+}
+
+TEST(BtreeKeyGeneratorTest, TopLevelCompoundMissingFieldsGenerateNulls) {
+    BSONObj keyPattern = fromjson("{a: 1, b: -1}");
+    BSONObj genKeysFrom = fromjson("{b: 2, c: 3}");
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(fromjson("{'': null, '': 2}"));
+    MultikeyPaths expectedMultikeyPaths{std::set<size_t>{}, std::set<size_t>{}};
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
+TEST(BtreeKeyGeneratorTest, TopLevelSparseAllMissingGeneratesNoKeys) {
+    const bool sparse = true;
+    BSONObj keyPattern = fromjson("{a: 1, b: 1}");
+    BSONObj genKeysFrom = fromjson("{c: 1}");
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    MultikeyPaths expectedMultikeyPaths{std::set<size_t>{}, std::set<size_t>{}};
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, sparse));
+}
+
+TEST(BtreeKeyGeneratorTest, TopLevelCompoundArrayFallsBackToGeneralPath) {
+    BSONObj keyPattern = fromjson("{a: 1, b: 1}");
+    BSONObj genKeysFrom = fromjson("{a: [1, 2], b: 3}");
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(fromjson("{'': 1, '': 3}"));
+    expectedKeys.insert(fromjson("{'': 2, '': 3}"));
+    MultikeyPaths expectedMultikeyPaths{{0U}, std::set<size_t>{}};
+    ASSERT(testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths));
+}
+
 }  // namespace
@@ -375,8 +375,10 @@ void ExpressionKeysPrivate::getHashKeys(const BSONObj& obj,
 
 // static
 long long int ExpressionKeysPrivate::makeSingleHashKey(const BSONElement& e, HashSeed seed, int v) {
-    massert(16767, "Only HashVersion 0 has been defined", v == 0);
-    return BSONElementHasher::hash64(e, seed);
+    massert(16767,
+            "Only hashVersions 0 and 1 have been defined",
+            v == 0 || v == BSONElementHasher::LATEST_HASH_VERSION);
+    return BSONElementHasher::hash64ForVersion(e, seed, v);
 }
 
 // static
@@ -136,4 +136,40 @@ TEST(HashKeyGeneratorTest, NoCollation) {
     ASSERT(assertKeysetsEqual(expectedKeys, actualKeys));
 }
 
+TEST(HashKeyGeneratorTest, Version1UsesTheVersionedHash) {
+    BSONObj obj = fromjson("{a: 'string'}");
+    BSONObjSet actualKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    ExpressionKeysPrivate::getHashKeys(
+        obj, "a", kHashSeed, BSONElementHasher::LATEST_HASH_VERSION, false, nullptr, &actualKeys);
+
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(BSON("" << BSONElementHasher::hash64ForVersion(
+                                 obj["a"], kHashSeed, BSONElementHasher::LATEST_HASH_VERSION)));
+
+    ASSERT(assertKeysetsEqual(expectedKeys, actualKeys));
+}
+
+TEST(HashKeyGeneratorTest, Version1DiffersFromVersion0) {
+    BSONObj obj = fromjson("{a: 'string'}");
+    ASSERT_NOT_EQUALS(
+        BSONElementHasher::hash64(obj["a"], kHashSeed),
+        BSONElementHasher::hash64ForVersion(obj["a"], kHashSeed, BSONElementHasher::LATEST_HASH_VERSION));
+}
+
+TEST(HashKeyGeneratorTest, Version1SquashesNumericTypesLikeVersion0) {
+    // Type squashing happens during canonicalization, upstream of the hash function, so all
+    // numeric representations of the same value share a version-1 key.
+    BSONObj intObj = fromjson("{a: 4}");
+    BSONObj doubleObj = fromjson("{a: 4.1}");
+    ASSERT_EQUALS(
+        BSONElementHasher::hash64ForVersion(intObj["a"], kHashSeed, 1),
+        BSONElementHasher::hash64ForVersion(doubleObj["a"], kHashSeed, 1));
+}
+
+TEST(HashKeyGeneratorTest, Version1SeedSelectsDifferentHashes) {
+    BSONObj obj = fromjson("{a: 'string'}");
+    ASSERT_NOT_EQUALS(BSONElementHasher::hash64ForVersion(obj["a"], 0, 1),
+                      BSONElementHasher::hash64ForVersion(obj["a"], 0x5eed, 1));
+}
+
 }  // namespace
@@ -33,6 +33,7 @@
 #include "mongo/db/index/btree_access_method.h"
 
 #include <utility>
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/error_codes.h"
@@ -128,14 +129,14 @@ Status IndexAccessMethod::insert(OperationContext* opCtx,
                                  int64_t* numInserted) {
     invariant(numInserted);
     *numInserted = 0;
-    BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    IndexKeyVector keys;
     MultikeyPaths multikeyPaths;
     // Delegate to the subclass.
     getKeys(obj, options.getKeysMode, &keys, &multikeyPaths);
 
     Status ret = Status::OK();
-    for (BSONObjSet::const_iterator i = keys.begin(); i != keys.end(); ++i) {
-        Status status = _newInterface->insert(opCtx, *i, loc, options.dupsAllowed);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        Status status = _newInterface->insert(opCtx, keys[i], loc, options.dupsAllowed);
 
         // Everything's OK, carry on.
         if (status.isOK()) {
@@ -153,14 +154,14 @@ Status IndexAccessMethod::insert(OperationContext* opCtx,
             // A document might be indexed multiple times during a background index build
             // if it moves ahead of the collection scan cursor (e.g. via an update).
             if (!_btreeState->isReady(opCtx)) {
-                LOG(3) << "key " << *i << " already in index during background indexing (ok)";
+                LOG(3) << "key " << keys[i] << " already in index during background indexing (ok)";
                 continue;
             }
         }
 
         // Clean up after ourselves.
-        for (BSONObjSet::const_iterator j = keys.begin(); j != i; ++j) {
-            removeOneKey(opCtx, *j, loc, options.dupsAllowed);
+        for (size_t j = 0; j < i; ++j) {
+            removeOneKey(opCtx, keys[j], loc, options.dupsAllowed);
             *numInserted = 0;
         }
 
@@ -174,6 +175,93 @@ Status IndexAccessMethod::insert(OperationContext* opCtx,
     return ret;
 }
 
+Status IndexAccessMethod::insert(OperationContext* opCtx,
+                                 const std::vector<BsonRecord>& bsonRecords,
+                                 const InsertDeleteOptions& options,
+                                 int64_t* numInserted) {
+    invariant(numInserted);
+    *numInserted = 0;
+
+    // Generate the keys for every document up front, tagging each key with its record so the
+    // whole batch can be applied in key order. Multikey state is accumulated across the batch
+    // and written to the catalog once at the end.
+    IndexKeyVector keys;
+    std::vector<RecordId> keyLocs;
+    IndexKeyVector docKeys;
+    MultikeyPaths multikeyPaths;
+    MultikeyPaths batchMultikeyPaths;
+    bool becameMultikey = false;
+    for (const auto& bsonRecord : bsonRecords) {
+        invariant(bsonRecord.id != RecordId());
+        docKeys.clear();
+        multikeyPaths.clear();
+        getKeys(*bsonRecord.docPtr, options.getKeysMode, &docKeys, &multikeyPaths);
+
+        if (docKeys.size() > 1 || isMultikeyFromPaths(multikeyPaths)) {
+            becameMultikey = true;
+            if (batchMultikeyPaths.empty()) {
+                batchMultikeyPaths = multikeyPaths;
+            } else {
+                for (size_t i = 0; i < multikeyPaths.size() && i < batchMultikeyPaths.size();
+                     ++i) {
+                    batchMultikeyPaths[i].insert(multikeyPaths[i].begin(),
+                                                 multikeyPaths[i].end());
+                }
+            }
+        }
+
+        for (size_t j = 0; j < docKeys.size(); ++j) {
+            keys.insert(docKeys[j]);
+            keyLocs.push_back(bsonRecord.id);
+        }
+    }
+
+    // Inserting in key order means consecutive keys usually land on the same or an adjacent
+    // leaf, rather than each document's keys descending the tree from cold.
+    std::vector<size_t> order(keys.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    const Ordering ordering = Ordering::make(_descriptor->keyPattern());
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        const int cmp = keys[lhs].woCompare(keys[rhs], ordering, false);
+        if (cmp != 0) {
+            return cmp < 0;
+        }
+        return keyLocs[lhs] < keyLocs[rhs];
+    });
+
+    for (size_t idx : order) {
+        Status status = _newInterface->insert(opCtx, keys[idx], keyLocs[idx], options.dupsAllowed);
+
+        if (status.isOK()) {
+            ++*numInserted;
+            continue;
+        }
+
+        if (status.code() == ErrorCodes::KeyTooLong && ignoreKeyTooLong(opCtx)) {
+            continue;
+        }
+
+        if (status.code() == ErrorCodes::DuplicateKeyValue && !_btreeState->isReady(opCtx)) {
+            // A document might be indexed multiple times during a background index build if it
+            // moves ahead of the collection scan cursor (e.g. via an update).
+            LOG(3) << "key " << keys[idx] << " already in index during background indexing (ok)";
+            continue;
+        }
+
+        // Unlike the single-document form there is no per-key cleanup here: this path runs
+        // inside the caller's WriteUnitOfWork, whose rollback undoes the keys already applied.
+        return status;
+    }
+
+    if (becameMultikey) {
+        _btreeState->setMultikey(opCtx, batchMultikeyPaths);
+    }
+
+    return Status::OK();
+}
+
 void IndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                      const BSONObj& key,
                                      const RecordId& loc,
@@ -221,6 +309,54 @@ Status IndexAccessMethod::remove(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexAccessMethod::remove(OperationContext* opCtx,
+                                 const std::vector<BSONObj>& objs,
+                                 const std::vector<RecordId>& locs,
+                                 const InsertDeleteOptions& options,
+                                 int64_t* numDeleted) {
+    invariant(numDeleted);
+    invariant(objs.size() == locs.size());
+    *numDeleted = 0;
+
+    // Generate the keys for every document up front. Keys are generated into a per-document
+    // scratch vector (getKeys() may discard a single document's keys when relaxing constraints)
+    // and then accumulated into one flat arena for the whole batch. As with the single-document
+    // form, there's no need to compute multikey path information when removing.
+    IndexKeyVector keys;
+    std::vector<RecordId> keyLocs;
+    IndexKeyVector docKeys;
+    for (size_t i = 0; i < objs.size(); ++i) {
+        docKeys.clear();
+        getKeys(objs[i], options.getKeysMode, &docKeys, nullptr);
+        for (size_t j = 0; j < docKeys.size(); ++j) {
+            keys.insert(docKeys[j]);
+            keyLocs.push_back(locs[i]);
+        }
+    }
+
+    // Removing in key order turns the random B-tree descents of per-document removal into a
+    // near-sequential walk, so each leaf is touched at most once per batch.
+    std::vector<size_t> order(keys.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    const Ordering ordering = Ordering::make(_descriptor->keyPattern());
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        const int cmp = keys[lhs].woCompare(keys[rhs], ordering, false);
+        if (cmp != 0) {
+            return cmp < 0;
+        }
+        return keyLocs[lhs] < keyLocs[rhs];
+    });
+
+    for (size_t idx : order) {
+        removeOneKey(opCtx, keys[idx], keyLocs[idx], options.dupsAllowed);
+        ++*numDeleted;
+    }
+
+    return Status::OK();
+}
+
 Status IndexAccessMethod::initializeAsEmpty(OperationContext* opCtx) {
     return _newInterface->initAsEmpty(opCtx);
 }
@@ -540,34 +676,43 @@ Status IndexAccessMethod::commitBulk(OperationContext* opCtx,
     return Status::OK();
 }
 
+namespace {
+
+// Indexing errors that may be suppressed when getKeys runs with kRelaxConstraints.
+const stdx::unordered_set<int>& indexingErrorWhiteList() {
+    static const stdx::unordered_set<int> whiteList{ErrorCodes::CannotBuildIndexKeys,
+                                                    // Btree
+                                                    ErrorCodes::KeyTooLong,
+                                                    ErrorCodes::CannotIndexParallelArrays,
+                                                    // FTS
+                                                    16732,
+                                                    16733,
+                                                    16675,
+                                                    17261,
+                                                    17262,
+                                                    // Hash
+                                                    16766,
+                                                    // Haystack
+                                                    16775,
+                                                    16776,
+                                                    // 2dsphere geo
+                                                    16755,
+                                                    16756,
+                                                    // 2d geo
+                                                    16804,
+                                                    13067,
+                                                    13068,
+                                                    13026,
+                                                    13027};
+    return whiteList;
+}
+
+}  // namespace
+
 void IndexAccessMethod::getKeys(const BSONObj& obj,
                                 GetKeysMode mode,
                                 BSONObjSet* keys,
                                 MultikeyPaths* multikeyPaths) const {
-    static stdx::unordered_set<int> whiteList{ErrorCodes::CannotBuildIndexKeys,
-                                              // Btree
-                                              ErrorCodes::KeyTooLong,
-                                              ErrorCodes::CannotIndexParallelArrays,
-                                              // FTS
-                                              16732,
-                                              16733,
-                                              16675,
-                                              17261,
-                                              17262,
-                                              // Hash
-                                              16766,
-                                              // Haystack
-                                              16775,
-                                              16776,
-                                              // 2dsphere geo
-                                              16755,
-                                              16756,
-                                              // 2d geo
-                                              16804,
-                                              13067,
-                                              13068,
-                                              13026,
-                                              13027};
     try {
         doGetKeys(obj, keys, multikeyPaths);
     } catch (const UserException& ex) {
@@ -581,7 +726,7 @@ void IndexAccessMethod::getKeys(const BSONObj& obj,
             multikeyPaths->clear();
         }
         // Only suppress the errors in the whitelist.
-        if (whiteList.find(ex.getCode()) == whiteList.end()) {
+        if (indexingErrorWhiteList().find(ex.getCode()) == indexingErrorWhiteList().end()) {
             throw;
         }
         LOG(1) << "Ignoring indexing error for idempotency reasons: " << redact(ex)
@@ -589,6 +734,45 @@ void IndexAccessMethod::getKeys(const BSONObj& obj,
     }
 }
 
+void IndexAccessMethod::getKeys(const BSONObj& obj,
+                                GetKeysMode mode,
+                                IndexKeyVector* keys,
+                                MultikeyPaths* multikeyPaths) const {
+    try {
+        doGetKeys(obj, keys, multikeyPaths);
+    } catch (const UserException& ex) {
+        if (mode == GetKeysMode::kEnforceConstraints) {
+            throw;
+        }
+
+        // Suppress indexing errors when mode is kRelaxConstraints. Note this discards all keys
+        // in 'keys', so the vector must not span multiple documents here.
+        keys->clear();
+        if (multikeyPaths) {
+            multikeyPaths->clear();
+        }
+        // Only suppress the errors in the whitelist.
+        if (indexingErrorWhiteList().find(ex.getCode()) == indexingErrorWhiteList().end()) {
+            throw;
+        }
+        LOG(1) << "Ignoring indexing error for idempotency reasons: " << redact(ex)
+               << " when getting index keys of " << redact(obj);
+    }
+}
+
+void IndexAccessMethod::doGetKeys(const BSONObj& obj,
+                                  IndexKeyVector* keys,
+                                  MultikeyPaths* multikeyPaths) const {
+    // Bridge for index types whose key generators only emit sets; the result is copied over
+    // as one sealed document group.
+    BSONObjSet keySet = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    doGetKeys(obj, &keySet, multikeyPaths);
+    for (const auto& key : keySet) {
+        keys->insert(key);
+    }
+    keys->sealDocument();
+}
+
 }  // namespace mongo
 
 #include "mongo/db/sorter/sorter.cpp"
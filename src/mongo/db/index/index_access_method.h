@@ -34,10 +34,12 @@
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index/index_key_vector.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/sorted_data_interface.h"
 
 namespace mongo {
@@ -84,6 +86,19 @@ public:
                   const InsertDeleteOptions& options,
                   int64_t* numInserted);
 
+    /**
+     * Inserts the index keys for a batch of documents within the caller's write unit.
+     *
+     * Keys for all documents are generated up front and applied in index key order, so a large
+     * batch descends the B-tree near-sequentially instead of once per document key. Must be
+     * called inside a WriteUnitOfWork: on error, keys applied before the failure are undone by
+     * the enclosing unit's rollback rather than individually.
+     */
+    Status insert(OperationContext* opCtx,
+                  const std::vector<BsonRecord>& bsonRecords,
+                  const InsertDeleteOptions& options,
+                  int64_t* numInserted);
+
     /**
      * Analogous to above, but remove the records instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the document.
@@ -94,6 +109,21 @@ public:
                   const InsertDeleteOptions& options,
                   int64_t* numDeleted);
 
+    /**
+     * Removes the index keys for a batch of documents within the caller's write unit. 'objs' and
+     * 'locs' are parallel arrays mapping each document to its on-disk location.
+     *
+     * Keys for all documents are generated up front and removed in index key order, so the index
+     * is walked once near-sequentially instead of being probed at random points once per
+     * document. Callers deleting many documents at a time (e.g. expired-document sweeps) should
+     * prefer this over repeated single-document remove() calls.
+     */
+    Status remove(OperationContext* opCtx,
+                  const std::vector<BSONObj>& objs,
+                  const std::vector<RecordId>& locs,
+                  const InsertDeleteOptions& options,
+                  int64_t* numDeleted);
+
     /**
      * Checks whether the index entries for the document 'from', which is placed at location
      * 'loc' on disk, can be changed to the index entries for the doc 'to'. Provides a ticket
@@ -276,6 +306,16 @@ public:
                  BSONObjSet* keys,
                  MultikeyPaths* multikeyPaths) const;
 
+    /**
+     * Vector-output form of getKeys(), used by the write path: the document's keys are emitted
+     * into 'keys' sorted and deduplicated, without the per-key overhead of a node-based set.
+     * Error handling is identical to the set form.
+     */
+    void getKeys(const BSONObj& obj,
+                 GetKeysMode mode,
+                 IndexKeyVector* keys,
+                 MultikeyPaths* multikeyPaths) const;
+
     /**
      * Splits the sets 'left' and 'right' into two vectors, the first containing the elements that
      * only appeared in 'left', and the second containing only elements that appeared in 'right'.
@@ -301,6 +341,15 @@ protected:
                            BSONObjSet* keys,
                            MultikeyPaths* multikeyPaths) const = 0;
 
+    /**
+     * Vector-output form of doGetKeys(). The default implementation bridges through a
+     * BSONObjSet; index types whose key generators can emit vectors directly (currently btree)
+     * override it to skip the set entirely.
+     */
+    virtual void doGetKeys(const BSONObj& obj,
+                           IndexKeyVector* keys,
+                           MultikeyPaths* multikeyPaths) const;
+
     /**
      * Determines whether it's OK to ignore ErrorCodes::KeyTooLong for this OperationContext
      */
@@ -0,0 +1,58 @@
+/**
+*    Copyright (C) 2013 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*    As a special exception, the copyright holders give permission to link the
+*    code of portions of this program with the OpenSSL library under certain
+*    conditions as described in each individual source file and distribute
+*    linked combinations including the program with the OpenSSL library. You
+*    must comply with the GNU Affero General Public License in all respects for
+*    all of the code used other than as permitted herein. If you modify file(s)
+*    with this exception, you may extend this exception to your version of the
+*    file(s), but you are not obligated to do so. If you do not wish to do so,
+*    delete this exception statement from your version. If you delete this
+*    exception statement from all source files in the program, then also delete
+*    it in the license file.
+*/
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/index_key_vector.h"
+
+#include <algorithm>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+
+namespace mongo {
+
+void IndexKeyVector::sealDocument() {
+    const size_t docStart = _docBoundaries.empty() ? 0 : _docBoundaries.back();
+    const char* base = _arena.buf();
+
+    std::sort(_offsets.begin() + docStart, _offsets.end(), [base](int lhs, int rhs) {
+        return SimpleBSONObjComparator::kInstance.evaluate(BSONObj(base + lhs) <
+                                                           BSONObj(base + rhs));
+    });
+    auto newEnd =
+        std::unique(_offsets.begin() + docStart, _offsets.end(), [base](int lhs, int rhs) {
+            return SimpleBSONObjComparator::kInstance.evaluate(BSONObj(base + lhs) ==
+                                                               BSONObj(base + rhs));
+        });
+    _offsets.erase(newEnd, _offsets.end());
+
+    // Duplicate key bytes stay behind in the arena; they are rare and the arena is short-lived.
+    _docBoundaries.push_back(_offsets.size());
+}
+
+}  // namespace mongo
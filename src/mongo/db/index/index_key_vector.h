@@ -0,0 +1,117 @@
+/**
+*    Copyright (C) 2013 10gen Inc.
+*
+*    This program is free software: you can redistribute it and/or  modify
+*    it under the terms of the GNU Affero General Public License, version 3,
+*    as published by the Free Software Foundation.
+*
+*    This program is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU Affero General Public License for more details.
+*
+*    You should have received a copy of the GNU Affero General Public License
+*    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*    As a special exception, the copyright holders give permission to link the
+*    code of portions of this program with the OpenSSL library under certain
+*    conditions as described in each individual source file and distribute
+*    linked combinations including the program with the OpenSSL library. You
+*    must comply with the GNU Affero General Public License in all respects for
+*    all of the code used other than as permitted herein. If you modify file(s)
+*    with this exception, you may extend this exception to your version of the
+*    file(s), but you are not obligated to do so. If you do not wish to do so,
+*    delete this exception statement from your version. If you delete this
+*    exception statement from all source files in the program, then also delete
+*    it in the license file.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+/**
+ * Flat container for generated index keys: key bytes live contiguously in a single arena and
+ * the keys of each document are sorted and deduplicated in one pass once that document's
+ * generation completes. Key generators append into it freely (duplicates included) and call
+ * sealDocument() per document; this replaces inserting every candidate key into a node-based
+ * BSONObjSet on the write path.
+ *
+ * Keys are grouped by the document that produced them, so one container can hold the output
+ * of a whole batch of documents. Accessors return unowned views into the arena, valid until
+ * the next insert() or clear().
+ */
+class IndexKeyVector {
+    MONGO_DISALLOW_COPYING(IndexKeyVector);
+
+public:
+    IndexKeyVector() = default;
+
+    /**
+     * Copies 'key' into the arena. Duplicates are tolerated here and removed by the next
+     * sealDocument() call.
+     */
+    void insert(const BSONObj& key) {
+        _offsets.push_back(_arena.len());
+        _arena.appendBuf(key.objdata(), key.objsize());
+    }
+
+    /**
+     * Sorts and deduplicates the keys inserted since the previous seal and closes out the
+     * current document's group. Must be called once per document, after its keys have been
+     * generated.
+     */
+    void sealDocument();
+
+    void clear() {
+        _arena.reset();
+        _offsets.clear();
+        _docBoundaries.clear();
+    }
+
+    /**
+     * Total number of keys across all sealed documents (plus any unsealed tail).
+     */
+    size_t size() const {
+        return _offsets.size();
+    }
+
+    bool empty() const {
+        return _offsets.empty();
+    }
+
+    BSONObj operator[](size_t i) const {
+        return BSONObj(_arena.buf() + _offsets[i]);
+    }
+
+    /**
+     * Number of sealed documents.
+     */
+    size_t numDocs() const {
+        return _docBoundaries.size();
+    }
+
+    /**
+     * Key index range [docBegin(doc), docEnd(doc)) produced by the doc-th sealed document.
+     */
+    size_t docBegin(size_t doc) const {
+        return doc == 0 ? 0 : _docBoundaries[doc - 1];
+    }
+
+    size_t docEnd(size_t doc) const {
+        return _docBoundaries[doc];
+    }
+
+private:
+    BufBuilder _arena;
+    std::vector<int> _offsets;  // Byte offset of each key in '_arena', sorted per document.
+    std::vector<size_t> _docBoundaries;  // One-past-the-end key index of each sealed document.
+};
+
+}  // namespace mongo
@@ -32,6 +32,7 @@
 
 #include "mongo/db/initialize_server_global_state.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
 #include <iostream>
 #include <memory>
@@ -51,6 +52,8 @@
 #include "mongo/db/auth/internal_user_auth.h"
 #include "mongo/db/auth/security_key.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/logger/async_appender.h"
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event.h"
@@ -81,6 +84,16 @@ using std::cerr;
 using std::cout;
 using std::endl;
 
+// When enabled, log lines destined for the log file are encoded on the logging thread but
+// written by a dedicated writer thread, so a slow disk does not add latency to the operations
+// doing the logging. Set at startup because the appenders are wired up once, before threads
+// that log are launched.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(logFileAsyncWriteEnabled, bool, false);
+
+// The maximum number of encoded log lines held while the writer thread is behind; further
+// lines are dropped and accounted for in the log rather than stalling the logging thread.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(logFileAsyncWriteMaxQueuedLines, int, 10000);
+
 #ifndef _WIN32
 // support for exit value propagation with fork
 void launchSignal(int sig) {
@@ -286,13 +299,31 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
 
         LogManager* manager = logger::globalLogManager();
         manager->getGlobalDomain()->clearAppenders();
-        manager->getGlobalDomain()->attachAppender(
-            MessageLogDomain::AppenderAutoPtr(new RotatableFileAppender<MessageEventEphemeral>(
-                new MessageEventDetailsEncoder, writer.getValue())));
-        manager->getNamedDomain("javascriptOutput")
-            ->attachAppender(
+        if (logFileAsyncWriteEnabled) {
+            const size_t maxQueuedLines =
+                static_cast<size_t>(std::max(1, logFileAsyncWriteMaxQueuedLines));
+            manager->getGlobalDomain()->attachAppender(
+                MessageLogDomain::AppenderAutoPtr(new logger::AsyncAppender(
+                    new MessageEventDetailsEncoder,
+                    new RotatableFileAppender<std::string>(new logger::StringEventEncoder,
+                                                           writer.getValue()),
+                    maxQueuedLines)));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(MessageLogDomain::AppenderAutoPtr(
+                    new logger::AsyncAppender(
+                        new MessageEventDetailsEncoder,
+                        new RotatableFileAppender<std::string>(new logger::StringEventEncoder,
+                                                               writer.getValue()),
+                        maxQueuedLines)));
+        } else {
+            manager->getGlobalDomain()->attachAppender(
                 MessageLogDomain::AppenderAutoPtr(new RotatableFileAppender<MessageEventEphemeral>(
                     new MessageEventDetailsEncoder, writer.getValue())));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(MessageLogDomain::AppenderAutoPtr(
+                    new RotatableFileAppender<MessageEventEphemeral>(new MessageEventDetailsEncoder,
+                                                                     writer.getValue())));
+        }
 
         if (serverGlobalParams.logAppend && exists) {
             log() << "***** SERVER RESTARTED *****";
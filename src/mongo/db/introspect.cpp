@@ -32,6 +32,10 @@
 
 #include "mongo/db/introspect.h"
 
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/auth/authorization_manager.h"
 #include "mongo/db/auth/authorization_session.h"
@@ -41,13 +45,26 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/background.h"
+#include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
+// When enabled, profile entries are handed to a background writer thread instead of being
+// inserted into system.profile inside the profiled operation's execution path.
+MONGO_EXPORT_SERVER_PARAMETER(profileAsyncWriteEnabled, bool, false);
+
+// The maximum number of profile entries the background writer will hold; further entries are
+// discarded until the writer catches up.
+MONGO_EXPORT_SERVER_PARAMETER(profileAsyncWriteMaxQueuedEntries, int, 10000);
+
 using std::unique_ptr;
 using std::endl;
 using std::string;
@@ -79,42 +96,18 @@ void _appendUserInfo(const CurOp& c, BSONObjBuilder& builder, AuthorizationSessi
     builder.append("user", bestUser.getUser().empty() ? "" : bestUser.getFullName());
 }
 
-}  // namespace
-
-
-void profile(OperationContext* opCtx, NetworkOp op) {
-    // Initialize with 1kb at start in order to avoid realloc later
-    BufBuilder profileBufBuilder(1024);
-
-    BSONObjBuilder b(profileBufBuilder);
-
-    {
-        Locker::LockerInfo lockerInfo;
-        opCtx->lockState()->getLockerInfo(&lockerInfo);
-        CurOp::get(opCtx)->debug().append(*CurOp::get(opCtx), lockerInfo.stats, b);
-    }
-
-    b.appendDate("ts", jsTime());
-    b.append("client", opCtx->getClient()->clientAddress());
-
-    const auto& clientMetadata =
-        ClientMetadataIsMasterState::get(opCtx->getClient()).getClientMetadata();
-    if (clientMetadata) {
-        auto appName = clientMetadata.get().getApplicationName();
-        if (!appName.empty()) {
-            b.append("appName", appName);
-        }
-    }
-
-    AuthorizationSession* authSession = AuthorizationSession::get(opCtx->getClient());
-    _appendUserInfo(*CurOp::get(opCtx), b, authSession);
-
-    const BSONObj p = b.done();
-
-    const bool wasLocked = opCtx->lockState()->isLocked();
-
-    const string dbName(nsToDatabase(CurOp::get(opCtx)->getNS()));
-
+/**
+ * Inserts a fully-built profile entry into dbName's system.profile collection, creating the
+ * collection if it has gone away. 'ns' and 'op' describe the profiled operation and are only
+ * used in diagnostics. 'wasLocked' is whether the inserting thread already held locks when
+ * profiling began, which restricts when the profile collection may be created.
+ */
+void writeProfileEntry(OperationContext* opCtx,
+                       const string& dbName,
+                       const string& ns,
+                       NetworkOp op,
+                       const BSONObj& p,
+                       bool wasLocked) {
     try {
         bool acquireDbXLock = false;
         while (true) {
@@ -131,8 +124,7 @@ void profile(OperationContext* opCtx, NetworkOp op) {
             Database* const db = autoGetDb->getDb();
             if (!db) {
                 // Database disappeared
-                log() << "note: not profiling because db went away for "
-                      << CurOp::get(opCtx)->getNS();
+                log() << "note: not profiling because db went away for " << ns;
                 break;
             }
 
@@ -160,8 +152,134 @@ void profile(OperationContext* opCtx, NetworkOp op) {
         }
     } catch (const AssertionException& assertionEx) {
         warning() << "Caught Assertion while trying to profile " << networkOpToString(op)
-                  << " against " << CurOp::get(opCtx)->getNS() << ": " << redact(assertionEx);
+                  << " against " << ns << ": " << redact(assertionEx);
+    }
+}
+
+/**
+ * Drains queued profile entries into the per-database system.profile collections on its own
+ * thread, so the profiled operations do not pay for the insert or its lock acquisitions.
+ * Entries arriving while the queue is full are discarded; catching up on a backlog is never
+ * allowed to stall the operations being profiled.
+ */
+class ProfileWriter : public BackgroundJob {
+public:
+    struct Entry {
+        std::string dbName;
+        std::string ns;
+        NetworkOp op;
+        BSONObj doc;
+    };
+
+    ProfileWriter() : BackgroundJob(false /* selfDelete */) {}
+
+    virtual std::string name() const {
+        return "ProfileWriter";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        AuthorizationSession::get(cc())->grantInternalAuthorization();
+
+        while (!globalInShutdownDeprecated()) {
+            std::deque<Entry> batch;
+            {
+                stdx::unique_lock<stdx::mutex> lk(_mutex);
+                _condvar.wait_for(
+                    lk, Seconds(1).toSystemDuration(), [&] { return !_queue.empty(); });
+                batch.swap(_queue);
+            }
+
+            if (batch.empty()) {
+                continue;
+            }
+
+            const ServiceContext::UniqueOperationContext opCtx = cc().makeOperationContext();
+            for (const auto& entry : batch) {
+                writeProfileEntry(
+                    opCtx.get(), entry.dbName, entry.ns, entry.op, entry.doc, false);
+            }
+        }
     }
+
+    void enqueue(Entry entry) {
+        std::call_once(_started, [this] { go(); });
+
+        const size_t maxQueuedEntries =
+            static_cast<size_t>(std::max(1, profileAsyncWriteMaxQueuedEntries.load()));
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            if (_queue.size() >= maxQueuedEntries) {
+                _numDiscarded++;
+                RARELY warning() << "profiler discarding entries because the async writer "
+                                    "cannot keep up; "
+                                 << _numDiscarded << " discarded so far";
+                return;
+            }
+            _queue.push_back(std::move(entry));
+        }
+        _condvar.notify_one();
+    }
+
+private:
+    std::once_flag _started;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
+    std::deque<Entry> _queue;
+    long long _numDiscarded = 0;
+};
+
+ProfileWriter& getProfileWriter() {
+    static ProfileWriter* profileWriter = new ProfileWriter();
+    return *profileWriter;
+}
+
+}  // namespace
+
+
+void profile(OperationContext* opCtx, NetworkOp op) {
+    // Initialize with 1kb at start in order to avoid realloc later
+    BufBuilder profileBufBuilder(1024);
+
+    BSONObjBuilder b(profileBufBuilder);
+
+    {
+        Locker::LockerInfo lockerInfo;
+        opCtx->lockState()->getLockerInfo(&lockerInfo);
+        CurOp::get(opCtx)->debug().append(*CurOp::get(opCtx), lockerInfo.stats, b);
+    }
+
+    b.appendDate("ts", jsTime());
+    b.append("client", opCtx->getClient()->clientAddress());
+
+    const auto& clientMetadata =
+        ClientMetadataIsMasterState::get(opCtx->getClient()).getClientMetadata();
+    if (clientMetadata) {
+        auto appName = clientMetadata.get().getApplicationName();
+        if (!appName.empty()) {
+            b.append("appName", appName);
+        }
+    }
+
+    AuthorizationSession* authSession = AuthorizationSession::get(opCtx->getClient());
+    _appendUserInfo(*CurOp::get(opCtx), b, authSession);
+
+    const BSONObj p = b.done();
+
+    const string& ns = CurOp::get(opCtx)->getNS();
+    const string dbName(nsToDatabase(ns));
+
+    if (profileAsyncWriteEnabled.load()) {
+        // The entry itself is still assembled on this thread because it reads state (CurOp,
+        // the authorization session) that does not outlive the operation; only the insert and
+        // its lock acquisitions are moved off the execution path.
+        getProfileWriter().enqueue({dbName, ns, op, p.getOwned()});
+        return;
+    }
+
+    const bool wasLocked = opCtx->lockState()->isLocked();
+    writeProfileEntry(opCtx, dbName, ns, op, p, wasLocked);
 }
 
 
@@ -60,6 +60,17 @@ bool MatchExpression::matchesBSONElement(BSONElement elem, MatchDetails* details
     return matches(&matchableDoc, details);
 }
 
+void MatchExpression::matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const {
+    invariant(n <= 64);
+    uint64_t bitmap = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (matchesBSON(docs[i])) {
+            bitmap |= static_cast<uint64_t>(1) << i;
+        }
+    }
+    *resultBitmap = bitmap;
+}
+
 void MatchExpression::setCollator(const CollatorInterface* collator) {
     for (size_t i = 0; i < numChildren(); ++i) {
         getChild(i)->setCollator(collator);
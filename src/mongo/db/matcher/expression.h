@@ -195,6 +195,15 @@ public:
      */
     virtual bool matchesBSONElement(BSONElement elem, MatchDetails* details = nullptr) const;
 
+    /**
+     * Evaluates the predicate over a batch of up to 64 documents, setting bit i of
+     * '*resultBitmap' when 'docs[i]' matches; bits at or above 'n' are cleared. Equivalent to
+     * calling matchesBSON() on each document, but leaf predicates override this with a tight
+     * loop over the batch and logical nodes combine child bitmaps, which is considerably
+     * cheaper than n interleaved tree walks.
+     */
+    virtual void matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const;
+
     /**
      * Determines if the element satisfies the tree-predicate.
      * Not valid for all expressions (e.g. $where); in those cases, returns false.
@@ -109,6 +109,10 @@ public:
         return *_query;
     }
 
+    const BSONObj& getRawObj() const {
+        return _rawObj;
+    }
+
 private:
     // The original geo specification provided by the user.
     BSONObj _rawObj;
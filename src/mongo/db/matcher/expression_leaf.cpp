@@ -31,8 +31,10 @@
 #include "mongo/db/matcher/expression_leaf.h"
 
 #include <cmath>
+#include <limits>
 #include <pcrecpp.h>
 
+#include "mongo/base/simple_string_data_comparator.h"
 #include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
@@ -47,6 +49,33 @@
 
 namespace mongo {
 
+namespace {
+
+/**
+ * Batched evaluation for a leaf predicate over a top-level path. Each document is tokenized
+ * with a single getField() and 'pred' is applied directly to the element, keeping the
+ * predicate's constants hot across the loop. Array values take the ordinary tree walk so that
+ * leaf-array expansion semantics are preserved exactly.
+ */
+template <typename SingleElementPredicate>
+uint64_t evaluateBatchAtTopLevelPath(const MatchExpression& expr,
+                                     StringData path,
+                                     const BSONObj* docs,
+                                     size_t n,
+                                     SingleElementPredicate pred) {
+    uint64_t bitmap = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const BSONElement elt = docs[i].getField(path);
+        const bool matched = (elt.type() == Array) ? expr.matchesBSON(docs[i]) : pred(elt);
+        if (matched) {
+            bitmap |= static_cast<uint64_t>(1) << i;
+        }
+    }
+    return bitmap;
+}
+
+}  // namespace
+
 bool ComparisonMatchExpression::equivalent(const MatchExpression* other) const {
     if (other->matchType() != matchType())
         return false;
@@ -148,6 +177,21 @@ bool ComparisonMatchExpression::matchesSingleElement(const BSONElement& e,
     }
 }
 
+void ComparisonMatchExpression::matchesMany(const BSONObj* docs,
+                                            size_t n,
+                                            uint64_t* resultBitmap) const {
+    invariant(n <= 64);
+    if (path().find('.') != std::string::npos) {
+        // Dotted paths need the full path iterator; the generic loop handles them.
+        MatchExpression::matchesMany(docs, n, resultBitmap);
+        return;
+    }
+    *resultBitmap = evaluateBatchAtTopLevelPath(
+        *this, path(), docs, n, [this](const BSONElement& elt) {
+            return matchesSingleElement(elt);
+        });
+}
+
 void ComparisonMatchExpression::debugString(StringBuilder& debug, int level) const {
     _debugAddSpace(debug, level);
     debug << path() << " ";
@@ -265,10 +309,57 @@ Status RegexMatchExpression::init(StringData path, StringData regex, StringData
     _regex = regex.toString();
     _flags = options.toString();
     _re.reset(new pcrecpp::RE(_regex.c_str(), flags2options(_flags.c_str())));
+    _analyzeForLiteralPrefix();
 
     return setPath(path);
 }
 
+void RegexMatchExpression::_analyzeForLiteralPrefix() {
+    _literalPrefix.clear();
+    _prefixIsWholePattern = false;
+
+    // Only flags that cannot change which strings a literal prefix matches are safe. 'i' makes
+    // the comparison case-insensitive and 'm' lets '^' anchor mid-string; 's' only affects '.'.
+    for (size_t i = 0; i < _flags.size(); ++i) {
+        if (_flags[i] != 's') {
+            return;
+        }
+    }
+
+    if (_regex.empty() || _regex[0] != '^') {
+        return;
+    }
+
+    // A top-level alternation gives the anchor limited scope (/^a|b/ matches "xb"), so any '|'
+    // disqualifies the pattern rather than reasoning about grouping.
+    if (_regex.find('|') != std::string::npos) {
+        return;
+    }
+
+    std::string prefix;
+    size_t i = 1;
+    for (; i < _regex.size(); ++i) {
+        const char c = _regex[i];
+        if (strchr("\\^$.|?*+()[]{}", c)) {
+            break;
+        }
+        prefix.push_back(c);
+    }
+
+    if (i == _regex.size()) {
+        _prefixIsWholePattern = true;
+    } else if (_regex[i] == '*' || _regex[i] == '?' || _regex[i] == '{') {
+        // A quantifier that allows zero occurrences makes the preceding character optional, so
+        // it cannot be part of the mandatory prefix. '+' requires at least one occurrence and
+        // keeps it.
+        if (!prefix.empty()) {
+            prefix.erase(prefix.size() - 1);
+        }
+    }
+
+    _literalPrefix.swap(prefix);
+}
+
 bool RegexMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails* details) const {
     switch (e.type()) {
         case String:
@@ -276,7 +367,17 @@ bool RegexMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetai
             // String values stored in documents can contain embedded NUL bytes. We construct a
             // pcrecpp::StringPiece instance using the full length of the string to avoid truncating
             // 'data' early.
-            pcrecpp::StringPiece data(e.valuestr(), e.valuestrsize() - 1);
+            const size_t len = e.valuestrsize() - 1;
+            if (!_literalPrefix.empty()) {
+                if (len < _literalPrefix.size() ||
+                    memcmp(e.valuestr(), _literalPrefix.c_str(), _literalPrefix.size()) != 0) {
+                    return false;
+                }
+                if (_prefixIsWholePattern) {
+                    return true;
+                }
+            }
+            pcrecpp::StringPiece data(e.valuestr(), len);
             return _re->PartialMatch(data);
         }
         case RegEx:
@@ -433,6 +534,18 @@ bool TypeMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetail
     return e.type() == _type.bsonType;
 }
 
+void TypeMatchExpression::matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const {
+    invariant(n <= 64);
+    if (path().find('.') != std::string::npos) {
+        MatchExpression::matchesMany(docs, n, resultBitmap);
+        return;
+    }
+    *resultBitmap = evaluateBatchAtTopLevelPath(
+        *this, path(), docs, n, [this](const BSONElement& elt) {
+            return matchesSingleElement(elt);
+        });
+}
+
 void TypeMatchExpression::debugString(StringBuilder& debug, int level) const {
     _debugAddSpace(debug, level);
     debug << path() << " type: ";
@@ -482,6 +595,97 @@ Status InMatchExpression::init(StringData path) {
     return setPath(path);
 }
 
+// static
+bool InMatchExpression::isHashableType(BSONType type, const CollatorInterface* collator) {
+    switch (type) {
+        case MinKey:
+        case MaxKey:
+        case jstNULL:
+        case Undefined:
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case Bool:
+        case Date:
+        case bsonTimestamp:
+        case jstOID:
+            return true;
+        case String:
+        case Symbol:
+            // String equality depends on the collation.
+            return nullptr == collator;
+        default:
+            // Compound types and decimals keep using the ordered set.
+            return false;
+    }
+}
+
+size_t InMatchExpression::EqualityHasher::operator()(const BSONElement& elt) const {
+    switch (elt.type()) {
+        case MinKey:
+            return 111;
+        case MaxKey:
+            return 222;
+        case jstNULL:
+        case Undefined:
+            // Undefined cannot be stored as an equality, only probed. Sharing null's hash is
+            // harmless: equality is decided by woCompare on hash-equal candidates.
+            return 333;
+        case Bool:
+            return elt.boolean() ? 1 : 0;
+        case Date:
+            return std::hash<long long>()(elt.date().toMillisSinceEpoch());
+        case bsonTimestamp:
+            return std::hash<unsigned long long>()(elt.timestamp().asULL());
+        case NumberInt:
+        case NumberLong:
+            return std::hash<long long>()(elt.numberLong());
+        case NumberDouble: {
+            const double d = elt.numberDouble();
+            if (std::isnan(d)) {
+                // All NaNs compare equal to each other regardless of bit pattern.
+                return 444;
+            }
+            // Doubles that hold an exact integer must hash like the equal int or long.
+            if (d >= static_cast<double>(std::numeric_limits<long long>::min()) &&
+                d < 9223372036854775808.0 /* 2^63 */) {
+                const long long asInteger = static_cast<long long>(d);
+                if (static_cast<double>(asInteger) == d) {
+                    return std::hash<long long>()(asInteger);
+                }
+            }
+            // Non-integral doubles cannot equal any int or long; hash the bit pattern. (Zero is
+            // integral, so the -0.0 == 0.0 case is covered above.)
+            unsigned long long bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            return std::hash<unsigned long long>()(bits);
+        }
+        case String:
+        case Symbol:
+            // Strings and symbols compare equal when their contents match. Only hashed when
+            // there is no collator.
+            return SimpleStringDataComparator::kInstance.hash(
+                StringData(elt.valuestr(), elt.valuestrsize() - 1));
+        case jstOID:
+            return SimpleStringDataComparator::kInstance.hash(
+                StringData(elt.value(), OID::kOIDSize));
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+void InMatchExpression::_rebuildHashSet() {
+    _equalityHashSet.clear();
+    _allEqualitiesHashed = true;
+    for (auto&& elt : _originalEqualityVector) {
+        if (isHashableType(elt.type(), _collator)) {
+            _equalityHashSet.insert(elt);
+        } else {
+            _allEqualitiesHashed = false;
+        }
+    }
+}
+
 std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     auto next = stdx::make_unique<InMatchExpression>();
     next->init(path()).transitional_ignore();
@@ -492,6 +696,8 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasNull = _hasNull;
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
+    next->_equalityHashSet = _equalityHashSet;
+    next->_allEqualitiesHashed = _allEqualitiesHashed;
     next->_originalEqualityVector = _originalEqualityVector;
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
@@ -505,6 +711,22 @@ bool InMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails*
     if (_hasNull && e.eoo()) {
         return true;
     }
+    if (isHashableType(e.type(), _collator)) {
+        if (_equalityHashSet.find(e) != _equalityHashSet.end()) {
+            return true;
+        }
+        if (_allEqualitiesHashed) {
+            // The hash miss is definitive; only the regexes remain to be checked.
+            for (auto&& regex : _regexes) {
+                if (regex->matchesSingleElement(e, details)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        // Some equalities (decimals, compound values) are only in the ordered set, and may
+        // still compare equal to this element; fall through.
+    }
     if (_equalitySet.find(e) != _equalitySet.end()) {
         return true;
     }
@@ -598,6 +820,9 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
     BSONElementSet equalitiesWithNewComparator(
         _originalEqualityVector.begin(), _originalEqualityVector.end(), collator);
     _equalitySet = std::move(equalitiesWithNewComparator);
+
+    // The collator also determines which elements are hashable.
+    _rebuildHashSet();
 }
 
 Status InMatchExpression::addEquality(const BSONElement& elt) {
@@ -615,6 +840,11 @@ Status InMatchExpression::addEquality(const BSONElement& elt) {
         _hasEmptyArray = true;
     }
     _equalitySet.insert(elt);
+    if (isHashableType(elt.type(), _collator)) {
+        _equalityHashSet.insert(elt);
+    } else {
+        _allEqualitiesHashed = false;
+    }
     _originalEqualityVector.push_back(elt);
     return Status::OK();
 }
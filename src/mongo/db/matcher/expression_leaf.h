@@ -34,6 +34,7 @@
 #include "mongo/db/matcher/expression_path.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 
 namespace pcrecpp {
 class RE;
@@ -71,6 +72,8 @@ public:
 
     bool matchesSingleElement(const BSONElement&, MatchDetails* details = nullptr) const final;
 
+    void matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const final;
+
     virtual void debugString(StringBuilder& debug, int level = 0) const;
 
     /**
@@ -229,9 +232,21 @@ public:
     }
 
 private:
+    /**
+     * Extracts the literal prefix of an anchored pattern, if there is one. When the whole
+     * pattern is a literal (e.g. /^ERROR/), matchesSingleElement() decides with a memcmp and
+     * never enters pcre at all; when only a prefix is literal (e.g. /^ERROR.*timeout/), strings
+     * that do not start with the prefix are rejected without a pcre call. Called from init().
+     */
+    void _analyzeForLiteralPrefix();
+
     std::string _regex;
     std::string _flags;
     std::unique_ptr<pcrecpp::RE> _re;
+
+    // Literal prefix every matching string must start with, empty if none could be extracted.
+    std::string _literalPrefix;
+    bool _prefixIsWholePattern = false;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -341,7 +356,37 @@ public:
         return _hasEmptyArray;
     }
 
+    /**
+     * Returns whether elements of 'type' may be probed and stored in the hashed equality set.
+     * Types whose equality semantics depend on 'collator' (strings and symbols) are only
+     * hashable when there is no collator; compound types and decimals always take the ordered
+     * set path.
+     */
+    static bool isHashableType(BSONType type, const CollatorInterface* collator);
+
 private:
+    /**
+     * Hashes a BSONElement value so that any two elements that compare equal under
+     * woCompare-without-field-name hash alike; in particular, numeric values are normalized
+     * before hashing so ints, longs and doubles holding the same value collide. Must only be
+     * invoked for elements of hashable types.
+     */
+    struct EqualityHasher {
+        size_t operator()(const BSONElement& elt) const;
+    };
+
+    struct EqualityEq {
+        bool operator()(const BSONElement& lhs, const BSONElement& rhs) const {
+            return lhs.woCompare(rhs, false) == 0;
+        }
+    };
+
+    /**
+     * Rebuilds '_equalityHashSet' from '_originalEqualityVector'. Called when the collator
+     * changes, since that determines which elements are hashable.
+     */
+    void _rebuildHashSet();
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -355,6 +400,15 @@ private:
     // for this set.
     BSONElementSet _equalitySet;
 
+    // Hashed index over the hashable subset of '_equalitySet', so that membership tests for
+    // simple values cost one probe instead of O(log n) woCompare calls. Large $in lists of
+    // entity ids are the motivating case.
+    stdx::unordered_set<BSONElement, EqualityHasher, EqualityEq> _equalityHashSet;
+
+    // True if every element of '_equalitySet' is also present in '_equalityHashSet'. When set, a
+    // hash miss for a hashable probe is definitive and the ordered set need not be consulted.
+    bool _allEqualitiesHashed = true;
+
     // Original container of equality elements, including duplicates. Needed for re-computing
     // '_equalitySet' in case '_collator' changes after elements have been added.
     std::vector<BSONElement> _originalEqualityVector;
@@ -398,6 +452,8 @@ public:
 
     bool matchesSingleElement(const BSONElement&, MatchDetails* details = nullptr) const final;
 
+    void matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const final;
+
     void debugString(StringBuilder& debug, int level) const override;
 
     void serialize(BSONObjBuilder* out) const override;
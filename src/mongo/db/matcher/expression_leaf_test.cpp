@@ -83,6 +83,35 @@ TEST(ComparisonMatchExpression, StringMatchingRespectsCollation) {
                           NULL));
 }
 
+TEST(ComparisonMatchExpression, MatchesManyAgreesWithMatchesBSON) {
+    BSONObj operand = BSON("a" << 5);
+    GTMatchExpression gt;
+    ASSERT(gt.init("a", operand["a"]).isOK());
+
+    const BSONObj docs[] = {BSON("a" << 6),
+                            BSON("a" << 5),
+                            BSON("b" << 10),
+                            BSON("a" << BSON_ARRAY(1 << 7)),
+                            BSON("a" << 100)};
+    uint64_t bitmap = 0;
+    gt.matchesMany(docs, 5, &bitmap);
+    for (size_t i = 0; i < 5; ++i) {
+        ASSERT_EQUALS(gt.matchesBSON(docs[i]), static_cast<bool>(bitmap & (1ULL << i)));
+    }
+    ASSERT_EQUALS(0U, bitmap >> 5);
+}
+
+TEST(ComparisonMatchExpression, MatchesManyHandlesDottedPaths) {
+    BSONObj operand = BSON("a.b" << 1);
+    EqualityMatchExpression eq;
+    ASSERT(eq.init("a.b", operand["a.b"]).isOK());
+
+    const BSONObj docs[] = {BSON("a" << BSON("b" << 1)), BSON("a" << BSON("b" << 2))};
+    uint64_t bitmap = 0;
+    eq.matchesMany(docs, 2, &bitmap);
+    ASSERT_EQUALS(1ULL, bitmap);
+}
+
 TEST(EqOp, MatchesElement) {
     BSONObj operand = BSON("a" << 5);
     BSONObj match = BSON("a" << 5.0);
@@ -925,6 +954,77 @@ TEST(RegexMatchExpression, MatchesElementSimplePrefix) {
     ASSERT(!regex.matchesSingleElement(notMatch.firstElement()));
 }
 
+TEST(RegexMatchExpression, AnchoredLiteralPatternMatchesWithoutSuffix) {
+    // /^abc/ is decided entirely by the literal-prefix fast path.
+    RegexMatchExpression regex;
+    ASSERT(regex.init("", "^abc", "").isOK());
+    ASSERT(regex.matchesSingleElement(BSON("x"
+                                           << "abc")
+                                          .firstElement()));
+    ASSERT(regex.matchesSingleElement(BSON("x"
+                                           << "abcd")
+                                          .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("x"
+                                            << "xabc")
+                                           .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("x"
+                                            << "ab")
+                                           .firstElement()));
+}
+
+TEST(RegexMatchExpression, AnchoredPrefixWithRegexSuffix) {
+    RegexMatchExpression regex;
+    ASSERT(regex.init("", "^abc.*z", "").isOK());
+    ASSERT(regex.matchesSingleElement(BSON("x"
+                                           << "abcdz")
+                                          .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("x"
+                                            << "abcd")
+                                           .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("x"
+                                            << "zabcdz")
+                                           .firstElement()));
+}
+
+TEST(RegexMatchExpression, AnchoredPrefixStopsBeforeOptionalCharacter) {
+    // The 'c' in /^abc*/ is optional, so "ab" must still match.
+    RegexMatchExpression regex;
+    ASSERT(regex.init("", "^abc*", "").isOK());
+    ASSERT(regex.matchesSingleElement(BSON("x"
+                                           << "ab")
+                                          .firstElement()));
+    ASSERT(regex.matchesSingleElement(BSON("x"
+                                           << "abccc")
+                                          .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("x"
+                                            << "a")
+                                           .firstElement()));
+}
+
+TEST(RegexMatchExpression, AnchoredCaseInsensitivePattern) {
+    // 'i' disables the literal-prefix fast path; matching stays case-insensitive.
+    RegexMatchExpression regex;
+    ASSERT(regex.init("", "^abc", "i").isOK());
+    ASSERT(regex.matchesSingleElement(BSON("x"
+                                           << "ABCd")
+                                          .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("x"
+                                            << "xabc")
+                                           .firstElement()));
+}
+
+TEST(RegexMatchExpression, AnchoredAlternationKeepsPartialMatchSemantics) {
+    // The anchor in /^a|b/ only applies to the first branch, so "xb" matches.
+    RegexMatchExpression regex;
+    ASSERT(regex.init("", "^a|b", "").isOK());
+    ASSERT(regex.matchesSingleElement(BSON("x"
+                                           << "xb")
+                                          .firstElement()));
+    ASSERT(!regex.matchesSingleElement(BSON("x"
+                                            << "xc")
+                                           .firstElement()));
+}
+
 TEST(RegexMatchExpression, MatchesElementCaseSensitive) {
     BSONObj match = BSON("x"
                          << "abc");
@@ -1320,6 +1420,23 @@ TEST(ExistsMatchExpression, Equivalent) {
     ASSERT(!e1.equivalent(&e2));
 }
 
+TEST(TypeMatchExpression, MatchesManyAgreesWithMatchesBSON) {
+    TypeMatchExpression type;
+    ASSERT(type.init("a", String).isOK());
+
+    const BSONObj docs[] = {BSON("a"
+                                 << "abc"),
+                            BSON("a" << 5),
+                            BSON("b"
+                                 << "abc"),
+                            BSON("a" << BSON_ARRAY("x" << 1))};
+    uint64_t bitmap = 0;
+    type.matchesMany(docs, 4, &bitmap);
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_EQUALS(type.matchesBSON(docs[i]), static_cast<bool>(bitmap & (1ULL << i)));
+    }
+}
+
 TEST(TypeMatchExpression, MatchesElementStringType) {
     BSONObj match = BSON("a"
                          << "abc");
@@ -1704,6 +1821,53 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.getEqualities().count(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, LargeEqualityListMatchesAcrossNumericTypes) {
+    // Exercises the hashed equality set: numeric probes must hit regardless of whether the
+    // stored equality and the probe use the same numeric type.
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 1000; ++i) {
+        bab.append(i);
+    }
+    BSONArray operand = bab.arr();
+    InMatchExpression in;
+    for (BSONObjIterator it(operand); it.more();) {
+        in.addEquality(it.next()).transitional_ignore();
+    }
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 42)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 42.0)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 42LL)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 42.5)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 1000)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a"
+                                         << "42")["a"]));
+}
+
+TEST(InMatchExpression, NanEqualityMatchesNan) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    BSONObj operand = BSON_ARRAY(nan << 1);
+    InMatchExpression in;
+    in.addEquality(operand[0]).transitional_ignore();
+    in.addEquality(operand[1]).transitional_ignore();
+
+    ASSERT(in.matchesSingleElement(BSON("a" << nan)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << 1)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 2)["a"]));
+}
+
+TEST(InMatchExpression, MixedHashableAndUnhashableEqualitiesMatch) {
+    // Subdocuments are not hashed, so a hash miss must still consult the ordered set.
+    BSONObj operand = BSON_ARRAY(1 << BSON("b" << 1));
+    InMatchExpression in;
+    in.addEquality(operand[0]).transitional_ignore();
+    in.addEquality(operand[1]).transitional_ignore();
+
+    ASSERT(in.matchesSingleElement(BSON("a" << 1)["a"]));
+    ASSERT(in.matchesSingleElement(BSON("a" << BSON("b" << 1))["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << 2)["a"]));
+    ASSERT(!in.matchesSingleElement(BSON("a" << BSON("b" << 2))["a"]));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -30,6 +30,8 @@
 
 #include "mongo/db/matcher/expression_tree.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
@@ -80,7 +82,24 @@ bool ListOfMatchExpression::equivalent(const MatchExpression* other) const {
 
 // -----
 
+namespace {
+
+// How many documents to evaluate between reorderings of an adaptive $and's children.
+const uint32_t kAdaptiveReorderInterval = 256;
+
+// Bitmap with the low 'n' bits set, the identity for combining matchesMany() results.
+uint64_t lowBitsSet(size_t n) {
+    return (n == 64) ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << n) - 1;
+}
+
+}  // namespace
+
 bool AndMatchExpression::matches(const MatchableDocument* doc, MatchDetails* details) const {
+    // MatchDetails output can depend on which child fails first, so adaptive ordering is only
+    // used when no details were requested.
+    if (_adaptiveReordering && !details) {
+        return _matchesAdaptively(doc);
+    }
     for (size_t i = 0; i < numChildren(); i++) {
         if (!getChild(i)->matches(doc, details)) {
             if (details)
@@ -91,6 +110,71 @@ bool AndMatchExpression::matches(const MatchableDocument* doc, MatchDetails* det
     return true;
 }
 
+bool AndMatchExpression::_matchesAdaptively(const MatchableDocument* doc) const {
+    if (_evalOrder.size() != numChildren()) {
+        _evalOrder.clear();
+        for (size_t i = 0; i < numChildren(); ++i) {
+            ChildStats stats;
+            stats.childIndex = i;
+            _evalOrder.push_back(stats);
+        }
+        _docsSinceReorder = 0;
+    }
+
+    bool matched = true;
+    for (size_t i = 0; i < _evalOrder.size(); ++i) {
+        ChildStats& stats = _evalOrder[i];
+        stats.attempts++;
+        if (!getChild(stats.childIndex)->matches(doc, nullptr)) {
+            stats.failures++;
+            matched = false;
+            break;
+        }
+    }
+
+    if (++_docsSinceReorder >= kAdaptiveReorderInterval) {
+        _docsSinceReorder = 0;
+
+        // Evaluate the children with the highest observed per-attempt failure rate first, so
+        // the cheap, selective predicates short-circuit the expensive ones.
+        std::stable_sort(
+            _evalOrder.begin(), _evalOrder.end(), [](const ChildStats& lhs, const ChildStats& rhs) {
+                const double lhsRate =
+                    lhs.attempts ? static_cast<double>(lhs.failures) / lhs.attempts : 0.0;
+                const double rhsRate =
+                    rhs.attempts ? static_cast<double>(rhs.failures) / rhs.attempts : 0.0;
+                return lhsRate > rhsRate;
+            });
+
+        // Decay the history so the order can follow shifts in the data.
+        for (size_t i = 0; i < _evalOrder.size(); ++i) {
+            _evalOrder[i].attempts /= 2;
+            _evalOrder[i].failures /= 2;
+        }
+    }
+
+    return matched;
+}
+
+std::vector<size_t> AndMatchExpression::adaptiveEvaluationOrder() const {
+    std::vector<size_t> order;
+    for (size_t i = 0; i < _evalOrder.size(); ++i) {
+        order.push_back(_evalOrder[i].childIndex);
+    }
+    return order;
+}
+
+void AndMatchExpression::matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const {
+    invariant(n <= 64);
+    uint64_t bitmap = lowBitsSet(n);
+    for (size_t i = 0; i < numChildren() && bitmap; ++i) {
+        uint64_t childBitmap;
+        getChild(i)->matchesMany(docs, n, &childBitmap);
+        bitmap &= childBitmap;
+    }
+    *resultBitmap = bitmap;
+}
+
 bool AndMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails* details) const {
     for (size_t i = 0; i < numChildren(); i++) {
         if (!getChild(i)->matchesSingleElement(e, details)) {
@@ -130,6 +214,18 @@ bool OrMatchExpression::matches(const MatchableDocument* doc, MatchDetails* deta
     return false;
 }
 
+void OrMatchExpression::matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const {
+    invariant(n <= 64);
+    const uint64_t all = lowBitsSet(n);
+    uint64_t bitmap = 0;
+    for (size_t i = 0; i < numChildren() && bitmap != all; ++i) {
+        uint64_t childBitmap;
+        getChild(i)->matchesMany(docs, n, &childBitmap);
+        bitmap |= childBitmap;
+    }
+    *resultBitmap = bitmap;
+}
+
 bool OrMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails* details) const {
     for (size_t i = 0; i < numChildren(); i++) {
         if (getChild(i)->matchesSingleElement(e, details)) {
@@ -184,6 +280,13 @@ void NorMatchExpression::serialize(BSONObjBuilder* out) const {
 
 // -------
 
+void NotMatchExpression::matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const {
+    invariant(n <= 64);
+    uint64_t childBitmap;
+    _exp->matchesMany(docs, n, &childBitmap);
+    *resultBitmap = ~childBitmap & lowBitsSet(n);
+}
+
 void NotMatchExpression::debugString(StringBuilder& debug, int level) const {
     _debugAddSpace(debug, level);
     debug << "$not\n";
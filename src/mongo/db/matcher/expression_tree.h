@@ -111,6 +111,8 @@ public:
 
     bool matchesSingleElement(const BSONElement&, MatchDetails* details = nullptr) const final;
 
+    void matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const final;
+
     virtual std::unique_ptr<MatchExpression> shallowClone() const {
         std::unique_ptr<AndMatchExpression> self = stdx::make_unique<AndMatchExpression>();
         for (size_t i = 0; i < numChildren(); ++i) {
@@ -119,12 +121,51 @@ public:
         if (getTag()) {
             self->setTag(getTag()->clone());
         }
+        self->_adaptiveReordering = _adaptiveReordering;
         return std::move(self);
     }
 
     virtual void debugString(StringBuilder& debug, int level = 0) const;
 
     virtual void serialize(BSONObjBuilder* out) const;
+
+    /**
+     * Lets matches() track per-child pass rates and periodically evaluate the most selective
+     * children first, rather than always using parse order. The reordering state is mutated by
+     * matches(), so this must only be enabled on trees evaluated by a single thread at a time,
+     * such as a CanonicalQuery's filter — never on a shared tree like a collection validator.
+     *
+     * Only the runtime evaluation order changes; the children as seen through getChild() and
+     * serialization keep their original order. Clones inherit the setting.
+     */
+    void enableAdaptiveReordering() {
+        _adaptiveReordering = true;
+    }
+
+    bool adaptiveReorderingEnabled() const {
+        return _adaptiveReordering;
+    }
+
+    /**
+     * Returns the current runtime evaluation order as child indexes. For testing.
+     */
+    std::vector<size_t> adaptiveEvaluationOrder() const;
+
+private:
+    struct ChildStats {
+        size_t childIndex = 0;
+        uint32_t attempts = 0;
+        uint32_t failures = 0;
+    };
+
+    bool _matchesAdaptively(const MatchableDocument* doc) const;
+
+    bool _adaptiveReordering = false;
+
+    // Runtime evaluation order with observed pass rates, rebuilt lazily when the child list
+    // changes and resorted periodically. Only touched when '_adaptiveReordering' is set.
+    mutable std::vector<ChildStats> _evalOrder;
+    mutable uint32_t _docsSinceReorder = 0;
 };
 
 class OrMatchExpression : public ListOfMatchExpression {
@@ -136,6 +177,8 @@ public:
 
     bool matchesSingleElement(const BSONElement&, MatchDetails* details = nullptr) const final;
 
+    void matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const final;
+
     virtual std::unique_ptr<MatchExpression> shallowClone() const {
         std::unique_ptr<OrMatchExpression> self = stdx::make_unique<OrMatchExpression>();
         for (size_t i = 0; i < numChildren(); ++i) {
@@ -206,6 +249,8 @@ public:
         return !_exp->matchesSingleElement(elt, details);
     }
 
+    void matchesMany(const BSONObj* docs, size_t n, uint64_t* resultBitmap) const final;
+
     virtual void debugString(StringBuilder& debug, int level = 0) const;
 
     virtual void serialize(BSONObjBuilder* out) const;
@@ -229,6 +229,83 @@ TEST(AndOp, ElemMatchKey) {
     ASSERT_EQUALS("1", details.elemMatchKey());
 }
 
+TEST(AndOp, AdaptiveReorderingMovesSelectiveChildrenFirst) {
+    BSONObj baseOperand1 = BSON("$gt" << 0);    // Passes every document below.
+    BSONObj baseOperand2 = BSON("$gt" << 100);  // Fails every document below.
+
+    unique_ptr<ComparisonMatchExpression> sub1(new GTMatchExpression());
+    ASSERT(sub1->init("a", baseOperand1["$gt"]).isOK());
+
+    unique_ptr<ComparisonMatchExpression> sub2(new GTMatchExpression());
+    ASSERT(sub2->init("a", baseOperand2["$gt"]).isOK());
+
+    AndMatchExpression andOp;
+    andOp.add(sub1.release());
+    andOp.add(sub2.release());
+    andOp.enableAdaptiveReordering();
+
+    // Evaluate enough non-matching documents for the periodic reordering to kick in. The
+    // second child is the one doing all the filtering, so it should move to the front.
+    for (int i = 0; i < 1000; i++) {
+        ASSERT(!andOp.matchesBSON(BSON("a" << 5), NULL));
+    }
+    std::vector<size_t> order = andOp.adaptiveEvaluationOrder();
+    ASSERT_EQUALS(2U, order.size());
+    ASSERT_EQUALS(1U, order[0]);
+    ASSERT_EQUALS(0U, order[1]);
+
+    // Reordering must not change the verdicts.
+    ASSERT(andOp.matchesBSON(BSON("a" << 101), NULL));
+    ASSERT(!andOp.matchesBSON(BSON("a" << 5), NULL));
+    ASSERT(!andOp.matchesBSON(BSON("b" << 101), NULL));
+}
+
+TEST(AndOp, AdaptiveReorderingKeepsMatchDetailsBehavior) {
+    BSONObj baseOperand1 = BSON("a" << 1);
+    BSONObj baseOperand2 = BSON("b" << 2);
+
+    unique_ptr<ComparisonMatchExpression> sub1(new EqualityMatchExpression());
+    ASSERT(sub1->init("a", baseOperand1["a"]).isOK());
+
+    unique_ptr<ComparisonMatchExpression> sub2(new EqualityMatchExpression());
+    ASSERT(sub2->init("b", baseOperand2["b"]).isOK());
+
+    AndMatchExpression andOp;
+    andOp.add(sub1.release());
+    andOp.add(sub2.release());
+    andOp.enableAdaptiveReordering();
+
+    // Evaluations that request details always run in parse order.
+    MatchDetails details;
+    details.requestElemMatchKey();
+    ASSERT(andOp.matchesBSON(BSON("a" << BSON_ARRAY(1) << "b" << BSON_ARRAY(1 << 2)), &details));
+    ASSERT(details.hasElemMatchKey());
+    ASSERT_EQUALS("1", details.elemMatchKey());
+}
+
+TEST(AndOp, MatchesManyCombinesChildBitmaps) {
+    BSONObj baseOperand1 = BSON("$gt" << 1);
+    BSONObj baseOperand2 = BSON("$lt" << 10);
+
+    unique_ptr<ComparisonMatchExpression> sub1(new GTMatchExpression());
+    ASSERT(sub1->init("a", baseOperand1["$gt"]).isOK());
+
+    unique_ptr<ComparisonMatchExpression> sub2(new LTMatchExpression());
+    ASSERT(sub2->init("a", baseOperand2["$lt"]).isOK());
+
+    AndMatchExpression andOp;
+    andOp.add(sub1.release());
+    andOp.add(sub2.release());
+
+    const BSONObj docs[] = {
+        BSON("a" << 5), BSON("a" << 0), BSON("a" << 10), BSON("a" << 9), BSON("b" << 5)};
+    uint64_t bitmap = 0;
+    andOp.matchesMany(docs, 5, &bitmap);
+    for (size_t i = 0; i < 5; ++i) {
+        ASSERT_EQUALS(andOp.matchesBSON(docs[i]), static_cast<bool>(bitmap & (1ULL << i)));
+    }
+}
+
 /**
 TEST( AndOp, MatchesIndexKeyWithoutUnknown ) {
     BSONObj baseOperand1 = BSON( "$gt" << 1 );
@@ -389,6 +466,34 @@ TEST(OrOp, ElemMatchKey) {
     ASSERT(!details.hasElemMatchKey());
 }
 
+TEST(OrOp, MatchesManyCombinesChildBitmaps) {
+    BSONObj baseOperand1 = BSON("$lt" << 0);
+    BSONObj baseOperand2 = BSON("$gt" << 10);
+
+    unique_ptr<ComparisonMatchExpression> sub1(new LTMatchExpression());
+    ASSERT(sub1->init("a", baseOperand1["$lt"]).isOK());
+
+    unique_ptr<ComparisonMatchExpression> sub2(new GTMatchExpression());
+    ASSERT(sub2->init("a", baseOperand2["$gt"]).isOK());
+
+    OrMatchExpression orOp;
+    orOp.add(sub1.release());
+    orOp.add(sub2.release());
+
+    const BSONObj docs[] = {BSON("a" << -1), BSON("a" << 5), BSON("a" << 11), BSON("b" << 1)};
+    uint64_t bitmap = 0;
+    orOp.matchesMany(docs, 4, &bitmap);
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_EQUALS(orOp.matchesBSON(docs[i]), static_cast<bool>(bitmap & (1ULL << i)));
+    }
+
+    NotMatchExpression notOp;
+    ASSERT(notOp.init(orOp.shallowClone().release()).isOK());
+    uint64_t notBitmap = 0;
+    notOp.matchesMany(docs, 4, &notBitmap);
+    ASSERT_EQUALS(bitmap ^ notBitmap, 0xfULL);
+}
+
 /**
 TEST( OrOp, MatchesIndexKeyWithoutUnknown ) {
     BSONObj baseOperand1 = BSON( "$gt" << 5 );
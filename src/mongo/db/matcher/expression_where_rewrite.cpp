@@ -0,0 +1,343 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/expression_where_rewrite.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/matchable.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+
+namespace {
+
+enum class CompareOp { kEq, kNe, kLt, kLte, kGt, kGte };
+
+/**
+ * One side of the recognized comparison: either a dotted path into the document ("this.a.b")
+ * or a numeric literal.
+ */
+struct Operand {
+    bool isField = false;
+    std::vector<std::string> path;
+    double number = 0;
+};
+
+/**
+ * Parses the restricted grammar
+ *
+ *     [ 'return' ] operand op operand [ ';' ]
+ *     operand := 'this' ('.' identifier)+ | numeric literal
+ *     op      := '==' | '===' | '!=' | '!==' | '<' | '<=' | '>' | '>='
+ *
+ * with at least one field operand. Anything else fails and the clause stays on the
+ * JavaScript path.
+ */
+class WhereClauseParser {
+public:
+    explicit WhereClauseParser(StringData code) : _code(code) {}
+
+    bool parse(Operand* lhs, CompareOp* op, Operand* rhs) {
+        _skipWhitespace();
+        _consumeReturnKeyword();
+        if (!_parseOperand(lhs) || !_parseOp(op) || !_parseOperand(rhs)) {
+            return false;
+        }
+        _skipWhitespace();
+        if (_pos < _code.size() && _code[_pos] == ';') {
+            ++_pos;
+            _skipWhitespace();
+        }
+        return _pos == _code.size() && (lhs->isField || rhs->isField);
+    }
+
+private:
+    void _skipWhitespace() {
+        while (_pos < _code.size() && isspace(static_cast<unsigned char>(_code[_pos]))) {
+            ++_pos;
+        }
+    }
+
+    void _consumeReturnKeyword() {
+        const StringData keyword = "return";
+        if (_code.size() - _pos > keyword.size() &&
+            _code.substr(_pos, keyword.size()) == keyword &&
+            isspace(static_cast<unsigned char>(_code[_pos + keyword.size()]))) {
+            _pos += keyword.size();
+            _skipWhitespace();
+        }
+    }
+
+    bool _parseOperand(Operand* operand) {
+        _skipWhitespace();
+        const StringData fieldPrefix = "this.";
+        if (_code.substr(_pos).startsWith(fieldPrefix)) {
+            _pos += fieldPrefix.size() - 1;  // Leave the '.' for the segment loop.
+            while (_pos < _code.size() && _code[_pos] == '.') {
+                ++_pos;
+                std::string segment;
+                while (_pos < _code.size() && _isIdentifierChar(_code[_pos], segment.empty())) {
+                    segment.push_back(_code[_pos++]);
+                }
+                if (segment.empty()) {
+                    return false;
+                }
+                operand->path.push_back(std::move(segment));
+            }
+            operand->isField = !operand->path.empty();
+            return operand->isField;
+        }
+
+        // Numeric literal. strtod also accepts forms JavaScript does not ("nan", hex), so
+        // gate on the first character.
+        if (_pos >= _code.size() ||
+            (!isdigit(static_cast<unsigned char>(_code[_pos])) && _code[_pos] != '-' &&
+             _code[_pos] != '.')) {
+            return false;
+        }
+        const std::string rest = _code.substr(_pos).toString();
+        char* end = nullptr;
+        operand->number = strtod(rest.c_str(), &end);
+        if (end == rest.c_str()) {
+            return false;
+        }
+        _pos += end - rest.c_str();
+        operand->isField = false;
+        return true;
+    }
+
+    bool _parseOp(CompareOp* op) {
+        _skipWhitespace();
+        // Longest match first; '===' and '!==' agree with '==' and '!=' on the same-type
+        // operands the native comparison handles.
+        struct OpToken {
+            StringData token;
+            CompareOp op;
+        };
+        static const OpToken kOps[] = {{"===", CompareOp::kEq},
+                                       {"!==", CompareOp::kNe},
+                                       {"==", CompareOp::kEq},
+                                       {"!=", CompareOp::kNe},
+                                       {"<=", CompareOp::kLte},
+                                       {">=", CompareOp::kGte},
+                                       {"<", CompareOp::kLt},
+                                       {">", CompareOp::kGt}};
+        for (const auto& candidate : kOps) {
+            if (_code.substr(_pos).startsWith(candidate.token)) {
+                _pos += candidate.token.size();
+                *op = candidate.op;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool _isIdentifierChar(char c, bool first) {
+        if (isalpha(static_cast<unsigned char>(c)) || c == '_' || c == '$') {
+            return true;
+        }
+        return !first && isdigit(static_cast<unsigned char>(c));
+    }
+
+    StringData _code;
+    size_t _pos = 0;
+};
+
+/**
+ * An operand value in the subset of JavaScript the native comparison models: a (double)
+ * number or an ASCII string. Everything else is unsupported and defers to the engine.
+ */
+struct JsValue {
+    enum Kind { kNumber, kString, kUnsupported };
+
+    Kind kind = kUnsupported;
+    double number = 0;
+    StringData str;
+};
+
+JsValue resolveOperand(const BSONObj& obj, const Operand& operand) {
+    JsValue value;
+    if (!operand.isField) {
+        value.kind = JsValue::kNumber;
+        value.number = operand.number;
+        return value;
+    }
+
+    BSONElement elt = obj.getField(operand.path[0]);
+    for (size_t i = 1; i < operand.path.size(); ++i) {
+        if (elt.type() != Object) {
+            return value;  // Mirrors 'undefined' in JavaScript; defer to the engine.
+        }
+        elt = elt.Obj().getField(operand.path[i]);
+    }
+
+    switch (elt.type()) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+            // JavaScript numbers are doubles, so the comparison happens at double precision.
+            value.kind = JsValue::kNumber;
+            value.number = elt.numberDouble();
+            return value;
+        case String: {
+            // JavaScript compares UTF-16 code units; a byte comparison agrees only for pure
+            // ASCII, so anything else defers to the engine.
+            StringData str(elt.valuestr(), elt.valuestrsize() - 1);
+            for (size_t i = 0; i < str.size(); ++i) {
+                if (static_cast<unsigned char>(str[i]) >= 0x80) {
+                    return value;
+                }
+            }
+            value.kind = JsValue::kString;
+            value.str = str;
+            return value;
+        }
+        default:
+            return value;
+    }
+}
+
+/**
+ * $where expression whose clause was recognized as a single field comparison. Documents with
+ * supported operand types are compared in-process; the rest go through '_fallback', the
+ * ordinary JavaScript-backed expression. Serializes and compares like any $where.
+ */
+class NativeWhereMatchExpression final : public WhereMatchExpressionBase {
+public:
+    NativeWhereMatchExpression(WhereParams params,
+                               Operand lhs,
+                               CompareOp op,
+                               Operand rhs,
+                               std::unique_ptr<MatchExpression> fallback)
+        : WhereMatchExpressionBase(std::move(params)),
+          _lhs(std::move(lhs)),
+          _op(op),
+          _rhs(std::move(rhs)),
+          _fallback(std::move(fallback)) {}
+
+    bool matches(const MatchableDocument* doc, MatchDetails* details = nullptr) const final {
+        BSONObj obj = doc->toBSON();
+        if (boost::optional<bool> verdict = _tryNativeCompare(obj)) {
+            return *verdict;
+        }
+        return _fallback->matches(doc, details);
+    }
+
+    std::unique_ptr<MatchExpression> shallowClone() const final {
+        WhereParams params;
+        params.code = getCode();
+        params.scope = getScope();
+        auto clone = stdx::make_unique<NativeWhereMatchExpression>(
+            std::move(params), _lhs, _op, _rhs, _fallback->shallowClone());
+        if (getTag()) {
+            clone->setTag(getTag()->clone());
+        }
+        return std::move(clone);
+    }
+
+private:
+    boost::optional<bool> _tryNativeCompare(const BSONObj& obj) const {
+        const JsValue lhs = resolveOperand(obj, _lhs);
+        const JsValue rhs = resolveOperand(obj, _rhs);
+
+        if (lhs.kind == JsValue::kNumber && rhs.kind == JsValue::kNumber) {
+            // Double comparisons give JavaScript's NaN behavior for free: all relational
+            // operators and '==' are false, '!=' is true.
+            switch (_op) {
+                case CompareOp::kEq:
+                    return lhs.number == rhs.number;
+                case CompareOp::kNe:
+                    return lhs.number != rhs.number;
+                case CompareOp::kLt:
+                    return lhs.number < rhs.number;
+                case CompareOp::kLte:
+                    return lhs.number <= rhs.number;
+                case CompareOp::kGt:
+                    return lhs.number > rhs.number;
+                case CompareOp::kGte:
+                    return lhs.number >= rhs.number;
+            }
+        }
+
+        if (lhs.kind == JsValue::kString && rhs.kind == JsValue::kString) {
+            const int cmp = lhs.str.compare(rhs.str);
+            switch (_op) {
+                case CompareOp::kEq:
+                    return cmp == 0;
+                case CompareOp::kNe:
+                    return cmp != 0;
+                case CompareOp::kLt:
+                    return cmp < 0;
+                case CompareOp::kLte:
+                    return cmp <= 0;
+                case CompareOp::kGt:
+                    return cmp > 0;
+                case CompareOp::kGte:
+                    return cmp >= 0;
+            }
+        }
+
+        // Mixed or unsupported types: JavaScript coercion rules apply, so let the engine
+        // decide.
+        return boost::none;
+    }
+
+    Operand _lhs;
+    CompareOp _op;
+    Operand _rhs;
+    std::unique_ptr<MatchExpression> _fallback;
+};
+
+}  // namespace
+
+std::unique_ptr<MatchExpression> rewriteWhereToNative(
+    std::unique_ptr<MatchExpression> whereExpr,
+    const WhereMatchExpressionBase::WhereParams& params) {
+    Operand lhs;
+    Operand rhs;
+    CompareOp op;
+    WhereClauseParser parser(params.code);
+    if (!parser.parse(&lhs, &op, &rhs)) {
+        return whereExpr;
+    }
+
+    WhereMatchExpressionBase::WhereParams paramsCopy = params;
+    return stdx::make_unique<NativeWhereMatchExpression>(
+        std::move(paramsCopy), std::move(lhs), op, std::move(rhs), std::move(whereExpr));
+}
+
+}  // namespace mongo
@@ -0,0 +1,57 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_where_base.h"
+
+namespace mongo {
+
+/**
+ * Recognizes $where clauses that are a single JavaScript comparison between two document
+ * fields, or between a field and a numeric literal, such as
+ *
+ *     this.a > this.b
+ *     return this.price.total <= 100;
+ *
+ * and wraps 'whereExpr' in an expression that evaluates the comparison natively, without
+ * marshalling the document into the JavaScript engine. Documents whose operand types the
+ * native comparison cannot model with JavaScript semantics (missing fields, non-ASCII
+ * strings, mixed-type operands, and so on) are still handed to 'whereExpr'.
+ *
+ * Returns 'whereExpr' unchanged when the code is not in the recognized form. The result
+ * serializes and compares as a regular $where expression.
+ */
+std::unique_ptr<MatchExpression> rewriteWhereToNative(
+    std::unique_ptr<MatchExpression> whereExpr,
+    const WhereMatchExpressionBase::WhereParams& params);
+
+}  // namespace mongo
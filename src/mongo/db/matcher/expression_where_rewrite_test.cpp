@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/expression_where_rewrite.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Builds a rewrite of 'code' around a sentinel fallback that matches {marker: 1}, so tests
+ * can tell whether a document was decided natively or deferred to the fallback.
+ */
+std::unique_ptr<MatchExpression> rewrite(const std::string& code, bool* wasRewritten = nullptr) {
+    BSONObj operand = BSON("marker" << 1);
+    auto fallback = stdx::make_unique<EqualityMatchExpression>();
+    ASSERT_OK(fallback->init("marker", operand["marker"]));
+
+    const MatchExpression* raw = fallback.get();
+    WhereMatchExpressionBase::WhereParams params;
+    params.code = code;
+    auto result = rewriteWhereToNative(std::move(fallback), params);
+    if (wasRewritten) {
+        *wasRewritten = (result.get() != raw);
+    }
+    return result;
+}
+
+TEST(WhereRewrite, RewritesFieldToFieldComparison) {
+    bool wasRewritten = false;
+    auto expr = rewrite("this.a > this.b", &wasRewritten);
+    ASSERT_TRUE(wasRewritten);
+
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 2, b: 1}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{a: 1, b: 2}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{a: 1, b: 1}")));
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 'b', b: 'a'}")));
+}
+
+TEST(WhereRewrite, RewritesFieldToLiteralComparison) {
+    bool wasRewritten = false;
+    auto expr = rewrite("return this.a <= 10;", &wasRewritten);
+    ASSERT_TRUE(wasRewritten);
+
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 10}")));
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 9.5}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{a: 11}")));
+}
+
+TEST(WhereRewrite, RewritesDottedPaths) {
+    bool wasRewritten = false;
+    auto expr = rewrite("this.price.total == this.budget", &wasRewritten);
+    ASSERT_TRUE(wasRewritten);
+
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{price: {total: 5}, budget: 5}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{price: {total: 6}, budget: 5}")));
+}
+
+TEST(WhereRewrite, LeavesUnrecognizedCodeOnTheFallback) {
+    bool wasRewritten = true;
+    rewrite("function() { return this.a > frob(this.b); }", &wasRewritten);
+    ASSERT_FALSE(wasRewritten);
+
+    rewrite("this.a > this.b && this.c == 1", &wasRewritten);
+    ASSERT_FALSE(wasRewritten);
+
+    rewrite("1 < 2", &wasRewritten);
+    ASSERT_FALSE(wasRewritten);
+}
+
+TEST(WhereRewrite, DefersUnsupportedOperandTypesToTheFallback) {
+    auto expr = rewrite("this.a > this.b");
+
+    // Missing fields, arrays, objects and mixed types all go to the sentinel fallback, which
+    // matches only when 'marker' is 1.
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{b: 1, marker: 1}")));
+    ASSERT_FALSE(expr->matchesBSON(fromjson("{b: 1, marker: 0}")));
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: [2], b: 1, marker: 1}")));
+    ASSERT_TRUE(expr->matchesBSON(fromjson("{a: 'x', b: 1, marker: 1}")));
+}
+
+TEST(WhereRewrite, CloneKeepsNativeEvaluation) {
+    auto expr = rewrite("this.a < this.b");
+    auto clone = expr->shallowClone();
+    ASSERT_TRUE(clone->matchesBSON(fromjson("{a: 1, b: 2}")));
+    ASSERT_FALSE(clone->matchesBSON(fromjson("{a: 2, b: 1}")));
+    ASSERT_TRUE(expr->equivalent(clone.get()));
+}
+
+}  // namespace
+}  // namespace mongo
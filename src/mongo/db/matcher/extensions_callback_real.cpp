@@ -32,6 +32,7 @@
 
 #include "mongo/db/matcher/expression_text.h"
 #include "mongo/db/matcher/expression_where.h"
+#include "mongo/db/matcher/expression_where_rewrite.h"
 #include "mongo/db/namespace_string.h"
 
 namespace mongo {
@@ -59,12 +60,17 @@ StatusWithMatchExpression ExtensionsCallbackReal::parseWhere(BSONElement where)
         return whereParams.getStatus();
     }
 
+    const WhereMatchExpressionBase::WhereParams params = whereParams.getValue();
+
     auto exp = stdx::make_unique<WhereMatchExpression>(_opCtx, std::move(whereParams.getValue()));
     Status status = exp->init(_nss->db());
     if (!status.isOK()) {
         return status;
     }
-    return {std::move(exp)};
+
+    // Simple field comparisons are evaluated natively, with 'exp' kept for documents the
+    // native comparison cannot model.
+    return {rewriteWhereToNative(std::move(exp), params)};
 }
 
 }  // namespace mongo
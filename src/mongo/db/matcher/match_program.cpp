@@ -0,0 +1,232 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/match_program.h"
+
+#include <algorithm>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/path_internal.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Splits 'path' at the dots and appends the segments to 'segments'. Returns false if the path
+ * cannot be evaluated by straight-line field lookups: empty segments are malformed, and all-digit
+ * segments carry array index semantics which the program does not implement.
+ */
+bool splitPath(StringData path, std::vector<StringData>* segments) {
+    size_t start = 0;
+    while (true) {
+        const size_t dot = path.find('.', start);
+        const StringData segment =
+            dot == std::string::npos ? path.substr(start) : path.substr(start, dot - start);
+        if (segment.empty() || isAllDigits(segment)) {
+            return false;
+        }
+        segments->push_back(segment);
+        if (dot == std::string::npos) {
+            return true;
+        }
+        start = dot + 1;
+    }
+}
+
+/**
+ * Returns the comparison node for 'expr' if it is a predicate the program can evaluate, NULL
+ * otherwise.
+ */
+const ComparisonMatchExpression* asProgramComparison(const MatchExpression* expr) {
+    if (!ComparisonMatchExpression::isComparisonMatchExpression(expr)) {
+        return nullptr;
+    }
+    if (expr->path().empty()) {
+        return nullptr;
+    }
+    return static_cast<const ComparisonMatchExpression*>(expr);
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<MatchProgram> MatchProgram::compile(const MatchExpression* root) {
+    if (!root) {
+        return nullptr;
+    }
+
+    std::vector<const ComparisonMatchExpression*> comparisons;
+    if (MatchExpression::AND == root->matchType()) {
+        if (0 == root->numChildren()) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            const ComparisonMatchExpression* comparison = asProgramComparison(root->getChild(i));
+            if (!comparison) {
+                return nullptr;
+            }
+            comparisons.push_back(comparison);
+        }
+    } else if (const ComparisonMatchExpression* comparison = asProgramComparison(root)) {
+        comparisons.push_back(comparison);
+    } else {
+        return nullptr;
+    }
+
+    std::unique_ptr<MatchProgram> program(new MatchProgram());
+    for (size_t i = 0; i < comparisons.size(); ++i) {
+        Instruction instruction;
+        if (!splitPath(comparisons[i]->path(), &instruction.pathSegments)) {
+            return nullptr;
+        }
+        if (instruction.pathSegments.size() > kMaxPathDepth) {
+            return nullptr;
+        }
+        instruction.firstSegmentIndex = 0;  // Assigned below, once the segment list is final.
+        instruction.comparison = comparisons[i];
+        program->_instructions.push_back(std::move(instruction));
+    }
+
+    // Sort the predicates by path so that predicates over shared prefixes are adjacent and
+    // tryMatch() can reuse the previous predicate's resolution of the common prefix.
+    std::stable_sort(program->_instructions.begin(),
+                     program->_instructions.end(),
+                     [](const Instruction& lhs, const Instruction& rhs) {
+                         return std::lexicographical_compare(lhs.pathSegments.begin(),
+                                                             lhs.pathSegments.end(),
+                                                             rhs.pathSegments.begin(),
+                                                             rhs.pathSegments.end());
+                     });
+
+    for (size_t i = 0; i < program->_instructions.size(); ++i) {
+        program->_firstSegments.push_back(program->_instructions[i].pathSegments[0]);
+    }
+
+    std::sort(program->_firstSegments.begin(), program->_firstSegments.end());
+    program->_firstSegments.erase(
+        std::unique(program->_firstSegments.begin(), program->_firstSegments.end()),
+        program->_firstSegments.end());
+    if (program->_firstSegments.size() > kMaxTrackedFields) {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < program->_instructions.size(); ++i) {
+        Instruction& instruction = program->_instructions[i];
+        instruction.firstSegmentIndex =
+            std::lower_bound(program->_firstSegments.begin(),
+                             program->_firstSegments.end(),
+                             instruction.pathSegments[0]) -
+            program->_firstSegments.begin();
+    }
+
+    return program;
+}
+
+boost::optional<bool> MatchProgram::tryMatch(const BSONObj& obj) const {
+    // Tokenize the document: a single pass picks out the first occurrence of each top-level
+    // field the program reads. Fields that never appear are left as EOO, which is exactly the
+    // element the tree matcher presents to a leaf for a missing path.
+    BSONElement tokens[kMaxTrackedFields];
+    invariant(_firstSegments.size() <= kMaxTrackedFields);
+    size_t remaining = _firstSegments.size();
+    BSONObjIterator it(obj);
+    while (it.more() && remaining > 0) {
+        const BSONElement elt = it.next();
+        const StringData fieldName = elt.fieldNameStringData();
+        std::vector<StringData>::const_iterator pos =
+            std::lower_bound(_firstSegments.begin(), _firstSegments.end(), fieldName);
+        if (pos != _firstSegments.end() && *pos == fieldName) {
+            BSONElement& token = tokens[pos - _firstSegments.begin()];
+            if (token.eoo()) {
+                token = elt;
+                remaining--;
+            }
+        }
+    }
+
+    // The element chain resolved for the previous instruction: 'chain[i]' holds the element
+    // reached after walking path segment 'i'. Instructions are sorted by path, so predicates
+    // over a shared prefix are adjacent and reuse the prefix's resolution rather than
+    // re-walking the document.
+    BSONElement chain[kMaxPathDepth];
+    size_t chainLength = 0;
+    const Instruction* previous = nullptr;
+
+    for (size_t i = 0; i < _instructions.size(); ++i) {
+        const Instruction& instruction = _instructions[i];
+
+        size_t common = 0;
+        if (previous) {
+            const size_t limit = std::min(
+                {chainLength, instruction.pathSegments.size(), previous->pathSegments.size()});
+            while (common < limit &&
+                   instruction.pathSegments[common] == previous->pathSegments[common]) {
+                common++;
+            }
+        }
+        if (0 == common) {
+            chain[0] = tokens[instruction.firstSegmentIndex];
+            chainLength = 1;
+        } else {
+            chainLength = common;
+        }
+        previous = &instruction;
+
+        // Walk the unshared path segments through subdocuments. Arrays anywhere on the path
+        // need the matcher's traversal semantics, which the program does not implement.
+        BSONElement elt = chain[chainLength - 1];
+        for (size_t segment = chainLength; segment < instruction.pathSegments.size(); ++segment) {
+            if (Array == elt.type()) {
+                return boost::none;
+            }
+            if (Object != elt.type()) {
+                elt = BSONElement();
+                break;
+            }
+            elt = elt.Obj().getField(instruction.pathSegments[segment]);
+            chain[segment] = elt;
+            chainLength = segment + 1;
+        }
+        if (Array == elt.type()) {
+            return boost::none;
+        }
+
+        if (!instruction.comparison->matchesSingleElement(elt)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace mongo
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+class ComparisonMatchExpression;
+class MatchExpression;
+
+/**
+ * A flat, non-recursive form of a MatchExpression tree consisting solely of a top-level
+ * conjunction of comparison predicates ($eq, $lt, $lte, $gt, $gte).
+ *
+ * Evaluating a MatchExpression tree walks heap-allocated nodes through two virtual calls per
+ * predicate and constructs an ElementIterator for every path, which dominates the profile of
+ * low-selectivity collection scans. A MatchProgram instead reads the document in a single pass,
+ * picking out the top-level fields the predicates refer to, and then evaluates each predicate
+ * with a devirtualized call against the already-located element.
+ *
+ * The program deliberately implements only the straight-line subset of the matcher's semantics.
+ * Documents that store an array anywhere along a predicate's path require the full matcher's
+ * element traversal rules, and tryMatch() reports those so the caller can fall back to the tree.
+ *
+ * A MatchProgram holds unowned pointers into the MatchExpression tree it was compiled from, and
+ * must not outlive it.
+ */
+class MatchProgram {
+public:
+    /**
+     * Compiles 'root' into a MatchProgram. Returns null if the tree is not a conjunction of
+     * simple comparisons, or uses features the program cannot evaluate (dotted paths through
+     * numeric components, expressions other than comparisons, and so on). A null return is not
+     * an error; it just means the caller must evaluate the tree directly.
+     */
+    static std::unique_ptr<MatchProgram> compile(const MatchExpression* root);
+
+    /**
+     * Evaluates the program against 'obj'. Returns whether the document matches, or boost::none
+     * if the document stores an array along one of the predicate paths, in which case the caller
+     * must consult the original MatchExpression.
+     */
+    boost::optional<bool> tryMatch(const BSONObj& obj) const;
+
+    size_t numPredicates() const {
+        return _instructions.size();
+    }
+
+private:
+    struct Instruction {
+        // The predicate's path, pre-split at the dots. The first segment indexes into the
+        // tokens gathered by tryMatch()'s single pass over the document.
+        std::vector<StringData> pathSegments;
+        size_t firstSegmentIndex;
+
+        // The comparison to apply. matchesSingleElement() is final on this type, so the call
+        // does not dispatch virtually. Unowned.
+        const ComparisonMatchExpression* comparison;
+    };
+
+    // Programs reading more distinct top-level fields than this are not compiled; tryMatch()
+    // gathers the fields it reads into fixed stack storage of this size.
+    static const size_t kMaxTrackedFields = 16;
+
+    // Predicates with paths deeper than this are not compiled; tryMatch() keeps the resolved
+    // element chain of the previous predicate in fixed stack storage of this size so that
+    // predicates sharing a path prefix (sorted together at compile time) reuse its resolution
+    // instead of re-walking the document.
+    static const size_t kMaxPathDepth = 8;
+
+    MatchProgram() = default;
+
+    std::vector<Instruction> _instructions;
+
+    // Sorted, deduplicated first path segments of all instructions.
+    std::vector<StringData> _firstSegments;
+};
+
+}  // namespace mongo
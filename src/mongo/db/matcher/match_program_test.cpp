@@ -0,0 +1,187 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/match_program.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Keeps the filter's BSONObj alive alongside the parsed MatchExpression, since neither the
+ * expression nor a program compiled from it owns that memory.
+ */
+class CompiledFilter {
+public:
+    explicit CompiledFilter(const std::string& str, const CollatorInterface* collator = nullptr)
+        : _obj(fromjson(str)) {
+        StatusWithMatchExpression result =
+            MatchExpressionParser::parse(_obj, ExtensionsCallbackDisallowExtensions(), collator);
+        ASSERT_OK(result.getStatus());
+        _expr = std::move(result.getValue());
+        _program = MatchProgram::compile(_expr.get());
+    }
+
+    MatchProgram* program() const {
+        return _program.get();
+    }
+
+    const MatchExpression* expr() const {
+        return _expr.get();
+    }
+
+private:
+    BSONObj _obj;
+    std::unique_ptr<MatchExpression> _expr;
+    std::unique_ptr<MatchProgram> _program;
+};
+
+void assertMatches(const CompiledFilter& filter, const BSONObj& doc) {
+    const boost::optional<bool> result = filter.program()->tryMatch(doc);
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(*result);
+}
+
+void assertDoesNotMatch(const CompiledFilter& filter, const BSONObj& doc) {
+    const boost::optional<bool> result = filter.program()->tryMatch(doc);
+    ASSERT_TRUE(result);
+    ASSERT_FALSE(*result);
+}
+
+void assertPunts(const CompiledFilter& filter, const BSONObj& doc) {
+    ASSERT_FALSE(filter.program()->tryMatch(doc));
+}
+
+TEST(MatchProgramTest, CompilesConjunctionOfComparisons) {
+    CompiledFilter filter("{a: 1, b: {$gt: 2}, c: {$lte: 'abc'}}");
+    ASSERT_TRUE(filter.program());
+    ASSERT_EQUALS(3U, filter.program()->numPredicates());
+
+    assertMatches(filter, fromjson("{a: 1, b: 3, c: 'abb', d: 99}"));
+    assertDoesNotMatch(filter, fromjson("{a: 1, b: 2, c: 'abb'}"));
+    assertDoesNotMatch(filter, fromjson("{b: 3}"));
+}
+
+TEST(MatchProgramTest, CompilesSingleComparison) {
+    CompiledFilter filter("{a: {$gte: 5}}");
+    ASSERT_TRUE(filter.program());
+    assertMatches(filter, fromjson("{a: 5}"));
+    assertDoesNotMatch(filter, fromjson("{a: 4}"));
+}
+
+TEST(MatchProgramTest, RefusesUnsupportedExpressions) {
+    ASSERT_FALSE(CompiledFilter("{$or: [{a: 1}, {b: 1}]}").program());
+    ASSERT_FALSE(CompiledFilter("{a: {$in: [1, 2]}}").program());
+    ASSERT_FALSE(CompiledFilter("{a: {$ne: 1}}").program());
+    ASSERT_FALSE(CompiledFilter("{a: /foo/}").program());
+    ASSERT_FALSE(CompiledFilter("{a: {$exists: true}}").program());
+    ASSERT_FALSE(CompiledFilter("{a: 1, b: {$elemMatch: {c: 1}}}").program());
+    ASSERT_FALSE(CompiledFilter("{'a.0': 1}").program());
+    ASSERT_FALSE(CompiledFilter("{}").program());
+}
+
+TEST(MatchProgramTest, PuntsOnArrayValues) {
+    CompiledFilter filter("{a: 2}");
+    ASSERT_TRUE(filter.program());
+    assertPunts(filter, fromjson("{a: [1, 2, 3]}"));
+
+    // The tree matcher gives the answer for the shapes the program refuses.
+    ASSERT_TRUE(filter.expr()->matchesBSON(fromjson("{a: [1, 2, 3]}")));
+}
+
+TEST(MatchProgramTest, MissingFieldsMatchLikeTheTreeMatcher) {
+    CompiledFilter eqNull("{a: null}");
+    ASSERT_TRUE(eqNull.program());
+    assertMatches(eqNull, fromjson("{b: 1}"));
+    assertDoesNotMatch(eqNull, fromjson("{a: 1}"));
+
+    CompiledFilter gt("{a: {$gt: 0}}");
+    ASSERT_TRUE(gt.program());
+    assertDoesNotMatch(gt, fromjson("{b: 1}"));
+}
+
+TEST(MatchProgramTest, EvaluatesDottedPaths) {
+    CompiledFilter filter("{'a.b': 1, 'a.c.d': {$lt: 10}}");
+    ASSERT_TRUE(filter.program());
+
+    assertMatches(filter, fromjson("{a: {b: 1, c: {d: 5}}}"));
+    assertDoesNotMatch(filter, fromjson("{a: {b: 2, c: {d: 5}}}"));
+
+    // A scalar in the middle of the path behaves like a missing leaf, as in the tree matcher.
+    assertDoesNotMatch(filter, fromjson("{a: {b: 1, c: 7}}"));
+
+    // Arrays anywhere along the path punt to the tree matcher.
+    assertPunts(filter, fromjson("{a: [{b: 1, c: {d: 5}}]}"));
+}
+
+TEST(MatchProgramTest, SharedPathPrefixesResolveCorrectly) {
+    // Predicates are sorted by path and shared prefixes are resolved once; the answers must not
+    // depend on the order the predicates were written in.
+    CompiledFilter filter("{'a.b.d': {$lt: 9}, x: 3, 'a.b.c': 1, 'a.e': 2}");
+    ASSERT_TRUE(filter.program());
+
+    assertMatches(filter, fromjson("{a: {b: {c: 1, d: 5}, e: 2}, x: 3}"));
+    assertDoesNotMatch(filter, fromjson("{a: {b: {c: 1, d: 9}, e: 2}, x: 3}"));
+    assertDoesNotMatch(filter, fromjson("{a: {b: {c: 2, d: 5}, e: 2}, x: 3}"));
+    assertDoesNotMatch(filter, fromjson("{a: {e: 2}, x: 3}"));
+}
+
+TEST(MatchProgramTest, RefusesPathsDeeperThanTheChainStorage) {
+    ASSERT_FALSE(CompiledFilter("{'a.b.c.d.e.f.g.h.i': 1}").program());
+}
+
+TEST(MatchProgramTest, UsesTheExpressionsCollator) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    CompiledFilter filter("{a: 'foo'}", &collator);
+    ASSERT_TRUE(filter.program());
+    assertMatches(filter, fromjson("{a: 'bar'}"));
+}
+
+TEST(MatchProgramTest, AgreesWithTheTreeMatcherOnFirstFieldOccurrence) {
+    // Documents with repeated field names resolve to the first occurrence in both engines.
+    CompiledFilter filter("{a: 1}");
+    ASSERT_TRUE(filter.program());
+    BSONObjBuilder bob;
+    bob.append("a", 1);
+    bob.append("a", 2);
+    const BSONObj doc = bob.obj();
+    const boost::optional<bool> result = filter.program()->tryMatch(doc);
+    ASSERT_TRUE(result);
+    ASSERT_EQUALS(filter.expr()->matchesBSON(doc), *result);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,46 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/util/bump_arena.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Returns the bump arena attached to 'opCtx'. Command implementations and pipeline stages
+ * servicing the same operation share this arena, typically through ArenaBufBuilder, so that
+ * the many small builders created while answering one request cost no individual heap
+ * round-trips. The arena lives as long as the OperationContext; callers that want to reclaim
+ * memory mid-operation may reset() it, provided no arena-backed buffers are still in use.
+ */
+BumpArena& bumpArenaFor(OperationContext* opCtx);
+
+}  // namespace mongo
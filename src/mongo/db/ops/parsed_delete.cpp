@@ -127,4 +127,14 @@ std::unique_ptr<CanonicalQuery> ParsedDelete::releaseParsedQuery() {
     return std::move(_canonicalQuery);
 }
 
+Status ParsedDelete::reparseQueryIfNeeded() {
+    if (_canonicalQuery.get()) {
+        return Status::OK();
+    }
+    if (CanonicalQuery::isSimpleIdQuery(_request->getQuery())) {
+        return Status::OK();
+    }
+    return parseQueryToCQ();
+}
+
 }  // namespace mongo
@@ -104,6 +104,14 @@ public:
      */
     std::unique_ptr<CanonicalQuery> releaseParsedQuery();
 
+    /**
+     * Re-creates the canonical query after it has been released to a plan executor, so that a
+     * write conflict retry can build a fresh executor without re-parsing the rest of the
+     * request. A no-op when the canonical query is still held, or when one was never needed
+     * (simple _id queries).
+     */
+    Status reparseQueryIfNeeded();
+
 private:
     // Transactional context.  Not owned by us.
     OperationContext* _opCtx;
@@ -191,6 +191,13 @@ std::unique_ptr<CanonicalQuery> ParsedUpdate::releaseParsedQuery() {
     return std::move(_canonicalQuery);
 }
 
+Status ParsedUpdate::reparseQueryIfNeeded() {
+    if (_canonicalQuery.get()) {
+        return Status::OK();
+    }
+    return parseQuery();
+}
+
 const UpdateRequest* ParsedUpdate::getRequest() const {
     return _request;
 }
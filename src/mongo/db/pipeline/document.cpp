@@ -45,16 +45,18 @@ using std::vector;
 
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
-Position DocumentStorage::findField(StringData requested) const {
+Position DocumentStorage::findField(StringData requested, unsigned hash) const {
     int reqSize = requested.size();  // get size calculation out of the way if needed
 
     if (_numFields >= HASH_TAB_MIN) {  // hash lookup
-        const unsigned bucket = bucketForKey(requested);
+        const unsigned bucket = hash & _hashTabMask;
 
         Position pos = _hashTab[bucket];
         while (pos.found()) {
             const ValueElement& elem = getField(pos);
-            if (elem.nameLen == reqSize && memcmp(requested.rawData(), elem._name, reqSize) == 0) {
+            // Compare the cached hashes first so collision chains rarely touch name bytes.
+            if (elem.hash == hash && elem.nameLen == reqSize &&
+                memcmp(requested.rawData(), elem._name, reqSize) == 0) {
                 return pos;
             }
 
@@ -73,7 +75,7 @@ Position DocumentStorage::findField(StringData requested) const {
     return Position();
 }
 
-Value& DocumentStorage::appendField(StringData name) {
+Value& DocumentStorage::appendField(StringData name, unsigned hash) {
     Position pos = getNextPosition();
     const int nameSize = name.size();
 
@@ -94,6 +96,7 @@ Value& DocumentStorage::appendField(StringData name) {
     dest += sizeof(x)
     append(value);
     append(nextCollision);
+    append(hash);
     append(nameSize);
     name.copyTo(dest, true);
 // Padding for alignment handled above
@@ -119,7 +122,7 @@ void DocumentStorage::addFieldToHashTable(Position pos) {
     ValueElement& elem = getField(pos);
     elem.nextCollision = Position();
 
-    const unsigned bucket = bucketForKey(elem.nameSD());
+    const unsigned bucket = elem.hash & _hashTabMask;
 
     Position* posPtr = &_hashTab[bucket];
     while (posPtr->found()) {
@@ -182,7 +185,30 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
     _bufferEnd = _buffer + newSize;
 }
 
+void DocumentStorage::loadLazyFields() {
+    invariant(!_haveFields);
+    _haveFields = true;  // set first so the appendField calls below don't re-enter
+
+    BSONObjIterator it(_bson);
+    while (it.more()) {
+        BSONElement elem(it.next());
+        appendField(elem.fieldNameStringData()) = Value(elem);
+    }
+
+    // The Values above are deep copies, so the backing buffer is no longer needed.
+    _bson = BSONObj();
+}
+
 intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
+    if (!_haveFields) {
+        // Nothing has been materialized; clone by sharing the backing bson.
+        intrusive_ptr<DocumentStorage> out(new DocumentStorage(_bson));
+        out->_metaFields = _metaFields;
+        out->_textScore = _textScore;
+        out->_randVal = _randVal;
+        return out;
+    }
+
     intrusive_ptr<DocumentStorage> out(new DocumentStorage());
 
     // Make a copy of the buffer.
@@ -260,6 +286,10 @@ void Document::toBson(BSONObjBuilder* builder, size_t recursionLevel) const {
 }
 
 BSONObj Document::toBson() const {
+    // An untouched bson-backed document round-trips without being rebuilt.
+    if (_storage && !storage().isMaterialized())
+        return storage().backingBson();
+
     BSONObjBuilder bb;
     toBson(&bb);
     return bb.obj();
@@ -278,6 +308,18 @@ BSONObj Document::toBsonWithMetaData() const {
     return bb.obj();
 }
 
+Document Document::deferredFromBsonWithMetaData(const BSONObj& bson) {
+    // Metadata can only hide behind '$'-prefixed top-level names; scan just the names. If any
+    // are present (rare outside text and sampling queries), fall back to the eager conversion
+    // that knows how to strip them.
+    BSONObjIterator it(bson);
+    while (it.more()) {
+        if (it.next().fieldNameStringData()[0] == '$')
+            return fromBsonWithMetaData(bson);
+    }
+    return Document(new DocumentStorage(bson));
+}
+
 Document Document::fromBsonWithMetaData(const BSONObj& bson) {
     MutableDocument md;
 
@@ -373,6 +415,11 @@ size_t Document::getApproximateSize() const {
     size_t size = sizeof(DocumentStorage);
     size += storage().allocatedBytes();
 
+    // Don't force materialization just to account for memory; the backing bson's size is
+    // already included by allocatedBytes().
+    if (!storage().isMaterialized())
+        return size;
+
     for (DocumentStorageIterator it = storage().iterator(); !it.atEnd(); it.advance()) {
         size += it->val.getApproximateSize();
         size -= sizeof(Value);  // already accounted for above
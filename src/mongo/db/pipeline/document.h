@@ -210,6 +210,14 @@ public:
      */
     static Document fromBsonWithMetaData(const BSONObj& bson);
 
+    /**
+     * Like fromBsonWithMetaData, but when 'bson' carries no metadata fields the conversion is
+     * deferred: the returned Document keeps the (owned) BSONObj and materializes all fields on
+     * first access. Documents that are passed through a pipeline untouched are never parsed,
+     * and their toBson() returns the original buffer.
+     */
+    static Document deferredFromBsonWithMetaData(const BSONObj& bson);
+
     // Support BSONObjBuilder and BSONArrayBuilder "stream" API
     friend BSONObjBuilder& operator<<(BSONObjBuilderValueStream& builder, const Document& d);
 
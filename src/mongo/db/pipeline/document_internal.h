@@ -80,6 +80,7 @@ class ValueElement {
 public:
     Value val;
     Position nextCollision;  // Position of next field with same hashBucket
+    const unsigned hash;     // cached hashKey(name); never recomputed after append
     const int nameLen;       // doesn't include '\0'
     const char _name[1];     // pointer to start of name (use nameSD instead)
 
@@ -124,7 +125,8 @@ private:
 };
 // Real size is sizeof(ValueElement) + nameLen
 #pragma pack()
-MONGO_STATIC_ASSERT(sizeof(ValueElement) == (sizeof(Value) + sizeof(Position) + sizeof(int) + 1));
+MONGO_STATIC_ASSERT(sizeof(ValueElement) ==
+                    (sizeof(Value) + sizeof(Position) + sizeof(unsigned) + sizeof(int) + 1));
 
 // This is an internal class for Document. See FieldIterator for the public version.
 class DocumentStorageIterator {
@@ -187,10 +189,25 @@ public:
           _usedBytes(0),
           _numFields(0),
           _hashTabMask(0),
+          _haveFields(true),
           _metaFields(),
           _textScore(0),
           _randVal(0) {}
 
+    /**
+     * Constructs storage lazily backed by 'bson': no fields are materialized until the first
+     * lookup, iteration, or mutation, at which point all of them are loaded at once. Pipelines
+     * that pass a document through untouched never pay for the conversion, and toBson() of an
+     * untouched document returns the original buffer without rebuilding it.
+     *
+     * 'bson' must not contain metadata fields; callers with possibly-metadata-bearing objects
+     * should go through Document::deferredFromBsonWithMetaData.
+     */
+    explicit DocumentStorage(const BSONObj& bson) : DocumentStorage() {
+        _bson = bson.getOwned();
+        _haveFields = false;
+    }
+
     ~DocumentStorage();
 
     enum MetaType : char {
@@ -214,11 +231,15 @@ public:
 
     /// Returns the position of the next field to be inserted
     Position getNextPosition() const {
+        materializeIfNeeded();
         return Position(_usedBytes);
     }
 
     /// Returns the position of the named field (may be missing) or Position()
-    Position findField(StringData name) const;
+    Position findField(StringData name) const {
+        materializeIfNeeded();
+        return findField(name, hashKey(name));
+    }
 
     // Document uses these
     const ValueElement& getField(Position pos) const {
@@ -238,14 +259,19 @@ public:
         return *(_firstElement->plusBytes(pos.index));
     }
     Value& getField(StringData name) {
-        Position pos = findField(name);
+        materializeIfNeeded();
+        const unsigned hash = hashKey(name);
+        Position pos = findField(name, hash);
         if (!pos.found())
-            return appendField(name);  // TODO: find a way to avoid hashing name twice
+            return appendField(name, hash);
         return getField(pos).val;
     }
 
     /// Adds a new field with missing Value at the end of the document
-    Value& appendField(StringData name);
+    Value& appendField(StringData name) {
+        materializeIfNeeded();
+        return appendField(name, hashKey(name));
+    }
 
     /** Preallocates space for fields. Use this to attempt to prevent buffer growth.
      *  This is only valid to call before anything is added to the document.
@@ -254,19 +280,34 @@ public:
 
     /// This skips missing values
     DocumentStorageIterator iterator() const {
+        materializeIfNeeded();
         return DocumentStorageIterator(_firstElement, end(), false);
     }
 
     /// This includes missing values
     DocumentStorageIterator iteratorAll() const {
+        materializeIfNeeded();
         return DocumentStorageIterator(_firstElement, end(), true);
     }
 
+    /// False only for bson-backed storage whose fields have not yet been accessed.
+    bool isMaterialized() const {
+        return _haveFields;
+    }
+
+    /// Only meaningful while !isMaterialized(): the owned object backing this storage.
+    const BSONObj& backingBson() const {
+        return _bson;
+    }
+
     /// Shallow copy of this. Caller owns memory.
     boost::intrusive_ptr<DocumentStorage> clone() const;
 
     size_t allocatedBytes() const {
-        return !_buffer ? 0 : (_bufferEnd - _buffer + hashTabBytes());
+        size_t bytes = !_buffer ? 0 : (_bufferEnd - _buffer + hashTabBytes());
+        if (!_haveFields)
+            bytes += _bson.objsize();
+        return bytes;
     }
 
     /**
@@ -305,6 +346,20 @@ public:
     }
 
 private:
+    /// As findField/appendField above, but with the name hash computed exactly once by the
+    /// caller. Each ValueElement caches its hash, so lookups compare hashes before names and
+    /// rehash() never recomputes them.
+    Position findField(StringData name, unsigned hash) const;
+    Value& appendField(StringData name, unsigned hash);
+
+    /// Loads every field from _bson into the buffer; defined in document.cpp.
+    void loadLazyFields();
+
+    void materializeIfNeeded() const {
+        if (!_haveFields)
+            const_cast<DocumentStorage*>(this)->loadLazyFields();
+    }
+
     /// Same as lastElement->next() or firstElement() if empty.
     const ValueElement* end() const {
         return _firstElement ? _firstElement->plusBytes(_usedBytes) : nullptr;
@@ -341,10 +396,6 @@ private:
         return out;
     }
 
-    unsigned bucketForKey(StringData name) const {
-        return hashKey(name) & _hashTabMask;
-    }
-
     /// Adds all fields to the hash table
     void rehash() {
         hashTabInit();
@@ -382,6 +433,9 @@ private:
     unsigned _numFields;    // this includes removed fields
     unsigned _hashTabMask;  // equal to hashTabBuckets()-1 but used more often
 
+    bool _haveFields;  // see materializeIfNeeded()
+    BSONObj _bson;     // set (and owned) only while !_haveFields
+
     std::bitset<MetaType::NUM_FIELDS> _metaFields;
     double _textScore;
     double _randVal;
@@ -48,6 +48,17 @@ using std::vector;
 DocumentSource::DocumentSource(const intrusive_ptr<ExpressionContext>& pCtx)
     : pSource(NULL), pExpCtx(pCtx) {}
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSource::getNextBatch(DocumentBatch* batch) {
+    while (batch->docs.size() < batch->maxDocs) {
+        auto next = getNext();
+        if (!next.isAdvanced()) {
+            return next.getStatus();
+        }
+        batch->docs.push_back(next.releaseDocument());
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 namespace {
 // Used to keep track of which DocumentSources are registered under which name.
 static StringMap<Parser> parserMap;
@@ -228,6 +228,24 @@ public:
         Document _result;
     };
 
+    /**
+     * A batch of consecutive 'advanced' results, used with getNextBatch(). Callers reuse one
+     * DocumentBatch across calls, clearing 'docs' between batches, so the vector's capacity is
+     * only allocated once.
+     */
+    struct DocumentBatch {
+        static const size_t kDefaultMaxDocs = 128;
+
+        explicit DocumentBatch(size_t maxDocs = kDefaultMaxDocs) : maxDocs(maxDocs) {
+            docs.reserve(maxDocs);
+        }
+
+        // The maximum number of documents getNextBatch() may leave in 'docs'.
+        size_t maxDocs;
+
+        std::vector<Document> docs;
+    };
+
     virtual ~DocumentSource() {}
 
     /**
@@ -243,6 +261,19 @@ public:
      */
     virtual GetNextResult getNext() = 0;
 
+    /**
+     * Vectorized variant of getNext(). Appends up to 'batch->maxDocs' consecutive advanced
+     * results to 'batch->docs' and returns the status that ended the batch: kAdvanced if the
+     * batch filled up, otherwise the kPauseExecution or kEOF status that interrupted it. The
+     * base-class implementation adapts row-at-a-time stages by looping over getNext(); stages
+     * whose per-document work is cheap relative to a virtual call (e.g. $match and $project)
+     * override it to amortize the per-document dispatch over a whole batch.
+     *
+     * A kPauseExecution or kEOF return says nothing about whether documents were also appended;
+     * callers must consume 'batch->docs' before acting on the status.
+     */
+    virtual GetNextResult::ReturnStatus getNextBatch(DocumentBatch* batch);
+
     /**
      * Returns a struct containing information about any special constraints imposed on using this
      * stage.
@@ -31,6 +31,8 @@
 #include "mongo/db/pipeline/document_source_change_notification.h"
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/pipeline/document_source_check_resume_token.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
@@ -41,7 +43,9 @@
 #include "mongo/db/pipeline/resume_token.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/oplog_entry_gen.h"
+#include "mongo/db/repl/oplog_fanout_hub.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -75,7 +79,15 @@ constexpr StringData DocumentSourceChangeNotification::kInvalidateOpType;
 
 namespace {
 
+// When enabled, a new (non-resuming) $changeNotification is fed from the shared in-memory
+// oplog fan-out hub instead of tailing the oplog collection: the oplog write path decodes
+// each entry once and pushes it to every subscriber, so watcher cost no longer scales with
+// watcher count. Resuming watchers always read the oplog collection, since the resume
+// point predates their subscription.
+MONGO_EXPORT_SERVER_PARAMETER(enableChangeNotificationFanout, bool, true);
+
 static constexpr StringData kOplogMatchExplainName = "$_internalOplogMatch"_sd;
+static constexpr StringData kOplogFanoutExplainName = "$_internalOplogFanout"_sd;
 
 /**
  * A custom subclass of DocumentSourceMatch which does not serialize itself (since it came from an
@@ -116,6 +128,77 @@ private:
     DocumentSourceOplogMatch(BSONObj filter, const intrusive_ptr<ExpressionContext>& expCtx)
         : DocumentSourceMatch(std::move(filter), expCtx) {}
 };
+
+/**
+ * A push-based alternative to DocumentSourceOplogMatch: instead of tailing the oplog
+ * collection, pops already-decoded entries from a shared OplogFanoutHub subscription and
+ * applies the same oplog filter to them. Returns EOF when the queue is drained; the
+ * tailable, awaitData cursor wrapping the pipeline turns that into the usual getMore wait.
+ * Like DocumentSourceOplogMatch, it came from an alias and does not serialize itself
+ * except for explain.
+ */
+class DocumentSourceOplogFanout final : public DocumentSource {
+public:
+    static intrusive_ptr<DocumentSourceOplogFanout> create(
+        BSONObj filter,
+        std::shared_ptr<repl::OplogFanoutHub::Subscription> subscription,
+        const intrusive_ptr<ExpressionContext>& expCtx) {
+        return new DocumentSourceOplogFanout(std::move(filter), std::move(subscription), expCtx);
+    }
+
+    const char* getSourceName() const final {
+        // As with DocumentSourceOplogMatch, report the name of the alias this stage came
+        // from for error reporting purposes.
+        return "$changeNotification";
+    }
+
+    StageConstraints constraints() const final {
+        StageConstraints constraints;
+        constraints.requiredPosition = StageConstraints::PositionRequirement::kFirst;
+        constraints.isAllowedInsideFacetStage = false;
+        constraints.requiresInputDocSource = false;
+        return constraints;
+    }
+
+    GetNextResult getNext() final {
+        // Once the subscription has overflowed there may be a gap in its queue, so we can
+        // no longer promise a complete change stream. The client is expected to resume
+        // from its last seen token, which reads the oplog collection directly.
+        uassert(40576,
+                "$changeNotification fell behind the oplog and was invalidated; resume with "
+                "'resumeAfter' to continue",
+                !_subscription->isOverflowed());
+
+        while (auto entry = _subscription->tryPop()) {
+            if (_expression->matchesBSON(*entry)) {
+                return Document(std::move(*entry));
+            }
+        }
+        return GetNextResult::makeEOF();
+    }
+
+    Value serialize(optional<ExplainOptions::Verbosity> explain) const final {
+        if (explain) {
+            return Value(Document{{kOplogFanoutExplainName, Document{}}});
+        }
+        return Value();
+    }
+
+private:
+    DocumentSourceOplogFanout(BSONObj filter,
+                              std::shared_ptr<repl::OplogFanoutHub::Subscription> subscription,
+                              const intrusive_ptr<ExpressionContext>& expCtx)
+        : DocumentSource(expCtx),
+          _predicate(std::move(filter)),
+          _expression(uassertStatusOK(MatchExpressionParser::parse(
+              _predicate, ExtensionsCallbackNoop(), expCtx->getCollator()))),
+          _subscription(std::move(subscription)) {}
+
+    // The MatchExpression points into '_predicate', so the BSON must outlive it.
+    BSONObj _predicate;
+    std::unique_ptr<MatchExpression> _expression;
+    std::shared_ptr<repl::OplogFanoutHub::Subscription> _subscription;
+};
 }  // namespace
 
 BSONObj DocumentSourceChangeNotification::buildMatchFilter(const NamespaceString& nss,
@@ -186,10 +269,25 @@ list<intrusive_ptr<DocumentSource>> DocumentSourceChangeNotification::createFrom
             fullDocOption == "lookup"_sd || fullDocOption == "none"_sd);
     const bool shouldLookupPostImage = (fullDocOption == "lookup"_sd);
 
-    auto oplogMatch = DocumentSourceOplogMatch::create(
-        buildMatchFilter(expCtx->ns, startFrom, changeStreamIsResuming), expCtx);
+    intrusive_ptr<DocumentSource> sourceStage;
+    if (!changeStreamIsResuming && enableChangeNotificationFanout.load()) {
+        // Feed this watcher from the shared in-memory fan-out hub rather than tailing the
+        // oplog collection. The subscription only receives entries whose transactions
+        // commit after it exists, so entries committed before this point are treated as
+        // having happened before the watch started; the timestamp filter additionally
+        // drops anything at or before the commit point read above, exactly as the oplog
+        // tailing filter would.
+        auto subscription = repl::OplogFanoutHub::get(expCtx->opCtx).subscribe(expCtx->ns);
+        sourceStage = DocumentSourceOplogFanout::create(
+            buildMatchFilter(expCtx->ns, startFrom, false), std::move(subscription), expCtx);
+    } else {
+        // Resuming watchers need entries that predate their subscription, so they read the
+        // oplog collection through the usual cursor machinery.
+        sourceStage = DocumentSourceOplogMatch::create(
+            buildMatchFilter(expCtx->ns, startFrom, changeStreamIsResuming), expCtx);
+    }
     auto transformation = createTransformationStage(elem.embeddedObject(), expCtx);
-    list<intrusive_ptr<DocumentSource>> stages = {oplogMatch, transformation};
+    list<intrusive_ptr<DocumentSource>> stages = {sourceStage, transformation};
     if (resumeStage) {
         stages.push_back(resumeStage);
     }
@@ -44,6 +44,7 @@
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/value_comparator.h"
 #include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/repl/oplog_fanout_hub.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/unittest/unittest.h"
 
@@ -81,19 +82,23 @@ public:
         list<intrusive_ptr<DocumentSource>> result =
             DSChangeNotification::createFromBson(spec.firstElement(), getExpCtx());
 
-        auto match = dynamic_cast<DocumentSourceMatch*>(result.front().get());
-        ASSERT(match);
-        auto mock = DocumentSourceMock::create(D(entry.toBSON()));
-        match->setSource(mock.get());
+        // A new (non-resuming) $changeNotification is fed from the oplog fan-out hub, so
+        // deliver the entry the way the oplog write path would once its transaction
+        // commits. The source stage applies the oplog filter to the queued entry itself.
+        auto source = result.front().get();
+        ASSERT(source);
+        ASSERT_EQ(string(source->getSourceName()), DSChangeNotification::kStageName);
+        ASSERT_FALSE(source->constraints().requiresInputDocSource);
+        repl::OplogFanoutHub::get(getExpCtx()->opCtx).publish(entry.toBSON());
 
         // Check the oplog entry is transformed correctly.
         auto transform = result.back().get();
         ASSERT(transform);
         ASSERT_EQ(string(transform->getSourceName()), DSChangeNotification::kStageName);
-        transform->setSource(match);
+        transform->setSource(source);
 
         auto next = transform->getNext();
-        // Match stage should pass the doc down if expectedDoc is given.
+        // The source stage should pass the doc down if expectedDoc is given.
         ASSERT_EQ(next.isAdvanced(), static_cast<bool>(expectedDoc));
         if (expectedDoc) {
             ASSERT_DOCUMENT_EQ(next.releaseDocument(), *expectedDoc);
@@ -155,13 +160,30 @@ TEST_F(ChangeNotificationStageTest, StagesGeneratedCorrectly) {
         DSChangeNotification::createFromBson(spec.firstElement(), getExpCtx());
 
     ASSERT_EQUALS(result.size(), 2UL);
-    ASSERT_TRUE(dynamic_cast<DocumentSourceMatch*>(result.front().get()));
+    // The first stage is the fan-out hub source: it generates its own input, must be first
+    // in the pipeline, and reports the name of the alias it came from.
+    ASSERT_FALSE(result.front()->constraints().requiresInputDocSource);
+    ASSERT(result.front()->constraints().requiredPosition ==
+           DocumentSource::StageConstraints::PositionRequirement::kFirst);
     ASSERT_EQUALS(string(result.front()->getSourceName()), DSChangeNotification::kStageName);
     ASSERT_EQUALS(string(result.back()->getSourceName()), DSChangeNotification::kStageName);
 
     // TODO: Check explain result.
 }
 
+TEST_F(ChangeNotificationStageTest, DoesNotSeeEntriesPublishedBeforeTheWatchStarted) {
+    OplogEntry insert(optime, 1, OpTypeEnum::kInsert, nss, BSON("_id" << 1 << "x" << 1));
+    repl::OplogFanoutHub::get(getExpCtx()->opCtx).publish(insert.toBSON());
+
+    // The subscription is created during stage parsing, so the entry above is gone.
+    const auto spec = fromjson("{$changeNotification: {}}");
+    list<intrusive_ptr<DocumentSource>> result =
+        DSChangeNotification::createFromBson(spec.firstElement(), getExpCtx());
+
+    auto next = result.front()->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
 TEST_F(ChangeNotificationStageTest, TransformInsert) {
     OplogEntry insert(optime, 1, OpTypeEnum::kInsert, nss, BSON("_id" << 1 << "x" << 1));
     // Insert
@@ -86,7 +86,7 @@ void DocumentSourceCursor::loadBatch() {
                 } else if (_dependencies) {
                     _currentBatch.push_back(_dependencies->extractFields(resultObj));
                 } else {
-                    _currentBatch.push_back(Document::fromBsonWithMetaData(resultObj));
+                    _currentBatch.push_back(Document::deferredFromBsonWithMetaData(resultObj));
                 }
 
                 if (_limit) {
@@ -168,6 +168,13 @@ DocumentSource::GetNextResult DocumentSourceFacet::getNext() {
         return GetNextResult::makeEOF();
     }
 
+    // Note on parallelism: the facet pipelines are independent of each other, but they are
+    // deliberately drained serially on this thread. Every stage runs against the shared
+    // ExpressionContext and OperationContext (interrupt checks, CurOp, and storage access for
+    // stages like $lookup, which is legal inside $facet), and an OperationContext must not be
+    // used concurrently from multiple threads. Executing facets on a thread pool would
+    // require a Client and OperationContext per worker plus re-targeting each sub-pipeline's
+    // context, which the aggregation system does not currently support.
     vector<vector<Value>> results(_facets.size());
     bool allPipelinesEOF = false;
     while (!allPipelinesEOF) {
@@ -30,6 +30,8 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <set>
+
 #include "mongo/base/init.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
@@ -38,6 +40,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -196,19 +199,34 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
         return unwindResult();
     }
 
+    // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
+    // '_unwindSrc' would be non-null, and we would not have made it here.
+    invariant(!_matchSrc);
+
+    if (!wasConstructedWithPipelineSyntax()) {
+        const int joinBatchSize = internalDocumentSourceLookupJoinBatchSize.load();
+        if (joinBatchSize > 1) {
+            return batchedGetNext(joinBatchSize);
+        }
+    }
+
     auto nextInput = pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
     }
 
     auto inputDoc = nextInput.releaseDocument();
+    auto results = queryForInput(inputDoc);
+
+    MutableDocument output(std::move(inputDoc));
+    output.setNestedField(_as, Value(std::move(results)));
+    return output.freeze();
+}
+
+std::vector<Value> DocumentSourceLookUp::queryForInput(const Document& inputDoc) {
     copyVariablesToExpCtx(_variables, _variablesParseState, _fromExpCtx.get());
     resolveLetVariables(inputDoc, &_fromExpCtx->variables);
 
-    // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
-    // '_unwindSrc' would be non-null, and we would not have made it here.
-    invariant(!_matchSrc);
-
     if (!wasConstructedWithPipelineSyntax()) {
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
@@ -232,9 +250,135 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
         results.emplace_back(std::move(*result));
     }
 
-    MutableDocument output(std::move(inputDoc));
-    output.setNestedField(_as, Value(std::move(results)));
-    return output.freeze();
+    return results;
+}
+
+DocumentSource::GetNextResult DocumentSourceLookUp::batchedGetNext(int batchSize) {
+    if (_batchedOutputs.empty()) {
+        // Gather a batch of input documents. A pause or EOF ends the batch early; EOF and pause
+        // are only returned directly once all gathered inputs have been joined and emitted.
+        std::vector<Document> inputs;
+        bool sawPause = false;
+        while (static_cast<int>(inputs.size()) < batchSize) {
+            auto nextInput = pSource->getNext();
+            if (nextInput.isPaused()) {
+                sawPause = true;
+                break;
+            }
+            if (nextInput.isEOF()) {
+                break;
+            }
+            inputs.push_back(nextInput.releaseDocument());
+        }
+        if (inputs.empty()) {
+            return sawPause ? GetNextResult::makePauseExecution() : GetNextResult::makeEOF();
+        }
+
+        // Collect each input's join keys, mapping each key to the inputs that carry it. Inputs
+        // whose keys include regexes, arrays, or undefined keep the exact semantics of the
+        // per-document query path; missing keys are treated as null, matching
+        // makeMatchStageFromInput().
+        auto keyToInputs =
+            _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+        std::vector<bool> needsExactQuery(inputs.size(), false);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            std::vector<Value> keys;
+            bool exotic = false;
+            document_path_support::visitAllValuesAtPath(
+                inputs[i], *_localField, [&](const Value& val) {
+                    const BSONType type = val.getType();
+                    if (type == BSONType::RegEx || type == BSONType::Array ||
+                        type == BSONType::Undefined) {
+                        exotic = true;
+                    }
+                    keys.push_back(val);
+                });
+            if (exotic) {
+                needsExactQuery[i] = true;
+                continue;
+            }
+            if (keys.empty()) {
+                keys.push_back(Value(BSONNULL));
+            }
+            for (auto&& key : keys) {
+                keyToInputs[key].push_back(i);
+            }
+        }
+
+        std::vector<std::vector<Value>> results(inputs.size());
+        std::vector<int> objsizes(inputs.size(), 0);
+
+        if (!keyToInputs.empty()) {
+            copyVariablesToExpCtx(_variables, _variablesParseState, _fromExpCtx.get());
+
+            // Issue one query for the union of all join keys:
+            //   {$match: {<foreignFieldName>: {$in: [<key>, <key>, ...]}}}
+            BSONObjBuilder match;
+            {
+                BSONObjBuilder query(match.subobjStart("$match"));
+                BSONObjBuilder inObj(query.subobjStart(_foreignField->fullPath()));
+                BSONArrayBuilder inArray(inObj.subarrayStart("$in"));
+                for (auto&& entry : keyToInputs) {
+                    entry.first.addToBsonArray(&inArray);
+                }
+                inArray.doneFast();
+                inObj.doneFast();
+                query.doneFast();
+            }
+            // We've already allocated space for the trailing $match stage.
+            _resolvedPipeline.back() = match.obj();
+
+            auto pipeline = uassertStatusOK(_mongod->makePipeline(_resolvedPipeline, _fromExpCtx));
+
+            while (auto result = pipeline->getNext()) {
+                // Partition the foreign document back to every input sharing one of its keys.
+                // visitAllValuesAtPath() expands arrays, giving us the matcher's
+                // array-contains-element behavior.
+                std::set<size_t> targets;
+                bool sawValue = false;
+                document_path_support::visitAllValuesAtPath(
+                    *result, *_foreignField, [&](const Value& val) {
+                        sawValue = true;
+                        const Value joinVal = val.nullish() ? Value(BSONNULL) : val;
+                        auto it = keyToInputs.find(joinVal);
+                        if (it != keyToInputs.end()) {
+                            targets.insert(it->second.begin(), it->second.end());
+                        }
+                    });
+                if (!sawValue) {
+                    // The foreign field is missing entirely; it was matched by a null key.
+                    auto it = keyToInputs.find(Value(BSONNULL));
+                    if (it != keyToInputs.end()) {
+                        targets.insert(it->second.begin(), it->second.end());
+                    }
+                }
+
+                for (size_t target : targets) {
+                    objsizes[target] += result->getApproximateSize();
+                    uassert(4568,
+                            str::stream() << "Total size of documents in " << _fromNs.coll()
+                                          << " matching pipeline "
+                                          << getUserPipelineDefinition()
+                                          << " exceeds maximum document size",
+                            objsizes[target] <= BSONObjMaxInternalSize);
+                    results[target].emplace_back(*result);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (needsExactQuery[i]) {
+                results[i] = queryForInput(inputs[i]);
+            }
+            MutableDocument output(std::move(inputs[i]));
+            output.setNestedField(_as, Value(std::move(results[i])));
+            _batchedOutputs.push_back(output.freeze());
+        }
+    }
+
+    Document out = std::move(_batchedOutputs.front());
+    _batchedOutputs.pop_front();
+    return out;
 }
 
 DocumentSource::GetModPathsReturn DocumentSourceLookUp::getModifiedPaths() const {
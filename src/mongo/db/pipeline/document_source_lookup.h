@@ -29,6 +29,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -207,6 +208,22 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Runs the foreign sub-pipeline for a single input document and returns the matching
+     * foreign documents.
+     */
+    std::vector<Value> queryForInput(const Document& inputDoc);
+
+    /**
+     * Batched ("block hash join") execution, used with localField/foreignField syntax when the
+     * internalDocumentSourceLookupJoinBatchSize knob is greater than one: gathers up to
+     * 'batchSize' input documents, issues one $in query over the union of their join keys, and
+     * hash-partitions the foreign results back to the inputs. Inputs whose keys include
+     * regexes, arrays, or undefined fall back to queryForInput() so exact per-document query
+     * semantics are preserved.
+     */
+    GetNextResult batchedGetNext(int batchSize);
+
     /**
      * Copies 'vars' and 'vps' to the Variables and VariablesParseState objects in 'expCtx'. These
      * copies provide access to 'let' defined variables in sub-pipeline execution.
@@ -257,6 +274,9 @@ private:
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
+    // Outputs assembled by batchedGetNext() that have not yet been returned.
+    std::deque<Document> _batchedOutputs;
+
     // The following members are used to hold onto state across getNext() calls when '_unwindSrc' is
     // not null.
     long long _cursorIndex = 0;
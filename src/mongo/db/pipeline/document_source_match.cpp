@@ -97,6 +97,38 @@ DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
     return nextInput;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceMatch::getNextBatch(
+    DocumentBatch* batch) {
+    pExpCtx->checkForInterrupt();
+
+    // The user facing error should have been generated earlier.
+    massert(17309, "Should never call getNext on a $match stage with $text clause", !_isTextQuery);
+
+    while (batch->docs.size() < batch->maxDocs) {
+        _inputBatch.docs.clear();
+        _inputBatch.maxDocs = batch->maxDocs - batch->docs.size();
+        auto status = pSource->getNextBatch(&_inputBatch);
+
+        for (auto&& doc : _inputBatch.docs) {
+            // MatchExpression only takes BSON documents, so we have to make one. As an
+            // optimization, only serialize the fields we need to do the match.
+            BSONObj toMatch = _dependencies.needWholeDocument
+                ? doc.toBson()
+                : document_path_support::documentToBsonWithPaths(doc, _dependencies.fields);
+
+            if (_expression->matchesBSON(toMatch)) {
+                batch->docs.push_back(std::move(doc));
+            }
+        }
+        _inputBatch.docs.clear();
+
+        if (status != GetNextResult::ReturnStatus::kAdvanced) {
+            return status;
+        }
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceMatch::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
@@ -42,6 +42,7 @@ public:
     virtual ~DocumentSourceMatch() = default;
 
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(DocumentBatch* batch) final;
     boost::intrusive_ptr<DocumentSource> optimize() final;
     BSONObjSet getOutputSorts() final {
         return pSource ? pSource->getOutputSorts()
@@ -158,6 +159,9 @@ private:
 
     BSONObj _predicate;
     const bool _isTextQuery;
+
+    // Reused by getNextBatch() to pull batches of input documents without reallocating.
+    DocumentBatch _inputBatch;
 };
 
 }  // namespace mongo
@@ -340,6 +340,55 @@ TEST_F(DocumentSourceMatchTest, ShouldPropagatePauses) {
     ASSERT_TRUE(match->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceMatchTest, BatchInterfaceShouldFilterAndStopAtPauses) {
+    auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
+    auto mock = DocumentSourceMock::create({Document{{"a", 1}, {"_id", 0}},
+                                            Document{{"a", 2}},
+                                            Document{{"a", 1}, {"_id", 1}},
+                                            DocumentSource::GetNextResult::makePauseExecution(),
+                                            Document{{"a", 1}, {"_id", 2}}});
+    match->setSource(mock.get());
+
+    // The mock does not override getNextBatch(), so this also exercises the base-class adapter.
+    DocumentSource::DocumentBatch batch;
+    auto status = match->getNextBatch(&batch);
+    ASSERT(status == DocumentSource::GetNextResult::ReturnStatus::kPauseExecution);
+    ASSERT_EQUALS(batch.docs.size(), 2U);
+    ASSERT_DOCUMENT_EQ(batch.docs[0], (Document{{"a", 1}, {"_id", 0}}));
+    ASSERT_DOCUMENT_EQ(batch.docs[1], (Document{{"a", 1}, {"_id", 1}}));
+
+    batch.docs.clear();
+    status = match->getNextBatch(&batch);
+    ASSERT(status == DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_EQUALS(batch.docs.size(), 1U);
+    ASSERT_DOCUMENT_EQ(batch.docs[0], (Document{{"a", 1}, {"_id", 2}}));
+}
+
+TEST_F(DocumentSourceMatchTest, BatchInterfaceShouldReturnAdvancedWhenBatchFills) {
+    auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
+    auto mock = DocumentSourceMock::create(
+        {Document{{"a", 1}, {"_id", 0}}, Document{{"a", 1}, {"_id", 1}}, Document{{"a", 2}}});
+    match->setSource(mock.get());
+
+    DocumentSource::DocumentBatch batch(1);
+    auto status = match->getNextBatch(&batch);
+    ASSERT(status == DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQUALS(batch.docs.size(), 1U);
+    ASSERT_DOCUMENT_EQ(batch.docs[0], (Document{{"a", 1}, {"_id", 0}}));
+
+    batch.docs.clear();
+    status = match->getNextBatch(&batch);
+    ASSERT(status == DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQUALS(batch.docs.size(), 1U);
+    ASSERT_DOCUMENT_EQ(batch.docs[0], (Document{{"a", 1}, {"_id", 1}}));
+
+    // Only the non-matching {a: 2} document remains, so the next batch is empty and EOF.
+    batch.docs.clear();
+    status = match->getNextBatch(&batch);
+    ASSERT(status == DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_EQUALS(batch.docs.size(), 0U);
+}
+
 TEST_F(DocumentSourceMatchTest, ShouldCorrectlyJoinWithSubsequentMatch) {
     const auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
     const auto secondMatch = DocumentSourceMatch::create(BSON("b" << 1), getExpCtx());
@@ -65,6 +65,20 @@ DocumentSource::GetNextResult DocumentSourceSingleDocumentTransformation::getNex
     return _parsedTransform->applyTransformation(input.releaseDocument());
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceSingleDocumentTransformation::getNextBatch(
+    DocumentBatch* batch) {
+    pExpCtx->checkForInterrupt();
+
+    // Transform only the documents this call appends; 'batch' may already hold results from an
+    // upstream caller.
+    const size_t alreadyProduced = batch->docs.size();
+    auto status = pSource->getNextBatch(batch);
+    for (size_t i = alreadyProduced; i < batch->docs.size(); ++i) {
+        batch->docs[i] = _parsedTransform->applyTransformation(std::move(batch->docs[i]));
+    }
+    return status;
+}
+
 intrusive_ptr<DocumentSource> DocumentSourceSingleDocumentTransformation::optimize() {
     _parsedTransform->optimize();
     return this;
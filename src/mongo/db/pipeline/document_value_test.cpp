@@ -105,6 +105,32 @@ TEST(DocumentConstruction, FromInitializerList) {
     ASSERT_EQUALS("q", getNthField(document, 1).second.getString());
 }
 
+TEST(DocumentConstruction, DeferredFromBsonReturnsOriginalBufferUntouched) {
+    BSONObj bson = BSON("a" << 1 << "b"
+                            << "q");
+    Document document = mongo::Document::deferredFromBsonWithMetaData(bson);
+    // No field has been accessed, so toBson() should hand back the same buffer.
+    ASSERT_EQUALS(document.toBson().objdata(), bson.objdata());
+}
+
+TEST(DocumentConstruction, DeferredFromBsonMaterializesOnAccess) {
+    BSONObj bson = BSON("a" << 1 << "b"
+                            << "q");
+    Document document = mongo::Document::deferredFromBsonWithMetaData(bson);
+    ASSERT_EQUALS(2U, document.size());
+    ASSERT_EQUALS(1, document["a"].getInt());
+    ASSERT_EQUALS("q", document["b"].getString());
+    assertRoundTrips(document);
+}
+
+TEST(DocumentConstruction, DeferredFromBsonStripsMetadata) {
+    BSONObj bson = BSON("a" << 1 << "$textScore" << 2.5);
+    Document document = mongo::Document::deferredFromBsonWithMetaData(bson);
+    ASSERT_EQUALS(1U, document.size());
+    ASSERT_TRUE(document.hasTextScore());
+    ASSERT_EQUALS(2.5, document.getTextScore());
+}
+
 TEST(DocumentConstruction, FromEmptyDocumentClone) {
     Document document;
     ASSERT_EQUALS(0U, document.size());
@@ -44,9 +44,11 @@
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/variables.h"
 #include "mongo/db/query/datetime/date_time_support.h"
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/util/intrusive_counter.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/summation.h"
 
 namespace mongo {
 
@@ -256,6 +258,10 @@ public:
                                            BSONElement bsonExpr,
                                            const VariablesParseState& vps);
 
+    const ExpressionVector& getOperandList() const {
+        return vpOperand;
+    }
+
 protected:
     explicit ExpressionNary(const boost::intrusive_ptr<ExpressionContext>& expCtx)
         : Expression(expCtx) {}
@@ -636,6 +642,14 @@ public:
     bool isCommutative() const final {
         return true;
     }
+
+    /**
+     * The accumulation logic shared by evaluate() and compiled expression execution (see
+     * expression_bytecode.h). Invokes 'getOperand' once per operand index, in order, and may
+     * return before consuming every operand when a nullish value is encountered.
+     */
+    template <typename GetOperand>
+    static Value accumulateOperands(size_t n, const GetOperand& getOperand);
 };
 
 
@@ -779,6 +793,10 @@ public:
         const boost::intrusive_ptr<Expression>& exprLeft,
         const boost::intrusive_ptr<Expression>& exprRight);
 
+    CmpOp getOp() const {
+        return cmpOp;
+    }
+
 private:
     CmpOp cmpOp;
 };
@@ -991,6 +1009,11 @@ public:
 
     Value evaluate(const Document& root) const final;
     const char* getOpName() const final;
+
+    /**
+     * Divides the two already-evaluated operands, applying $divide's type semantics.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
 };
 
 
@@ -1329,6 +1352,14 @@ public:
     bool isCommutative() const final {
         return true;
     }
+
+    /**
+     * The accumulation logic shared by evaluate() and compiled expression execution (see
+     * expression_bytecode.h). Invokes 'getOperand' once per operand index, in order, and may
+     * return before consuming every operand when a nullish value is encountered.
+     */
+    template <typename GetOperand>
+    static Value accumulateOperands(size_t n, const GetOperand& getOperand);
 };
 
 
@@ -1668,6 +1699,11 @@ public:
 
     Value evaluate(const Document& root) const final;
     const char* getOpName() const final;
+
+    /**
+     * Subtracts the two already-evaluated operands, applying $subtract's type semantics.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
 };
 
 
@@ -1809,4 +1845,135 @@ private:
     ExpressionVector _inputs;
     ExpressionVector _defaults;
 };
+
+template <typename GetOperand>
+Value ExpressionAdd::accumulateOperands(size_t n, const GetOperand& getOperand) {
+    // We'll try to return the narrowest possible result value while avoiding overflow, loss
+    // of precision due to intermediate rounding or implicit use of decimal types. To do that,
+    // compute a compensated sum for non-decimal values and a separate decimal sum for decimal
+    // values, and track the current narrowest type.
+    DoubleDoubleSummation nonDecimalTotal;
+    Decimal128 decimalTotal;
+    BSONType totalType = NumberInt;
+    bool haveDate = false;
+
+    for (size_t i = 0; i < n; ++i) {
+        Value val = getOperand(i);
+
+        switch (val.getType()) {
+            case NumberDecimal:
+                decimalTotal = decimalTotal.add(val.getDecimal());
+                totalType = NumberDecimal;
+                break;
+            case NumberDouble:
+                nonDecimalTotal.addDouble(val.getDouble());
+                if (totalType != NumberDecimal)
+                    totalType = NumberDouble;
+                break;
+            case NumberLong:
+                nonDecimalTotal.addLong(val.getLong());
+                if (totalType == NumberInt)
+                    totalType = NumberLong;
+                break;
+            case NumberInt:
+                nonDecimalTotal.addDouble(val.getInt());
+                break;
+            case Date:
+                uassert(16612, "only one date allowed in an $add expression", !haveDate);
+                haveDate = true;
+                nonDecimalTotal.addLong(val.getDate().toMillisSinceEpoch());
+                break;
+            default:
+                uassert(16554,
+                        str::stream() << "$add only supports numeric or date types, not "
+                                      << typeName(val.getType()),
+                        val.nullish());
+                return Value(BSONNULL);
+        }
+    }
+
+    if (haveDate) {
+        int64_t longTotal;
+        if (totalType == NumberDecimal) {
+            longTotal = decimalTotal.add(nonDecimalTotal.getDecimal()).toLong();
+        } else {
+            uassert(ErrorCodes::Overflow, "date overflow in $add", nonDecimalTotal.fitsLong());
+            longTotal = nonDecimalTotal.getLong();
+        }
+        return Value(Date_t::fromMillisSinceEpoch(longTotal));
+    }
+    switch (totalType) {
+        case NumberDecimal:
+            return Value(decimalTotal.add(nonDecimalTotal.getDecimal()));
+        case NumberLong:
+            dassert(nonDecimalTotal.isInteger());
+            if (nonDecimalTotal.fitsLong())
+                return Value(nonDecimalTotal.getLong());
+        // Fallthrough.
+        case NumberInt:
+            if (nonDecimalTotal.fitsLong())
+                return Value::createIntOrLong(nonDecimalTotal.getLong());
+        // Fallthrough.
+        case NumberDouble:
+            return Value(nonDecimalTotal.getDouble());
+        default:
+            massert(16417, "$add resulted in a non-numeric type", false);
+    }
+}
+
+template <typename GetOperand>
+Value ExpressionMultiply::accumulateOperands(size_t n, const GetOperand& getOperand) {
+    /*
+      We'll try to return the narrowest possible result value.  To do that
+      without creating intermediate Values, do the arithmetic for double
+      and integral types in parallel, tracking the current narrowest
+      type.
+     */
+    double doubleProduct = 1;
+    long long longProduct = 1;
+    Decimal128 decimalProduct;  // This will be initialized on encountering the first decimal.
+
+    BSONType productType = NumberInt;
+
+    for (size_t i = 0; i < n; ++i) {
+        Value val = getOperand(i);
+
+        if (val.numeric()) {
+            BSONType oldProductType = productType;
+            productType = Value::getWidestNumeric(productType, val.getType());
+            if (productType == NumberDecimal) {
+                // On finding the first decimal, convert the partial product to decimal.
+                if (oldProductType != NumberDecimal) {
+                    decimalProduct = oldProductType == NumberDouble
+                        ? Decimal128(doubleProduct, Decimal128::kRoundTo15Digits)
+                        : Decimal128(static_cast<int64_t>(longProduct));
+                }
+                decimalProduct = decimalProduct.multiply(val.coerceToDecimal());
+            } else {
+                doubleProduct *= val.coerceToDouble();
+                if (mongoSignedMultiplyOverflow64(longProduct, val.coerceToLong(), &longProduct)) {
+                    // The 'longProduct' would have overflowed, so we're abandoning it.
+                    productType = NumberDouble;
+                }
+            }
+        } else if (val.nullish()) {
+            return Value(BSONNULL);
+        } else {
+            uasserted(16555,
+                      str::stream() << "$multiply only supports numeric types, not "
+                                    << typeName(val.getType()));
+        }
+    }
+
+    if (productType == NumberDouble)
+        return Value(doubleProduct);
+    else if (productType == NumberLong)
+        return Value(longProduct);
+    else if (productType == NumberInt)
+        return Value::createIntOrLong(longProduct);
+    else if (productType == NumberDecimal)
+        return Value(decimalProduct);
+    else
+        massert(16418, "$multiply resulted in a non-numeric type", false);
+}
 }
@@ -0,0 +1,340 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_bytecode.h"
+
+#include <limits>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+// Past this many registers we give up on flattening and embed the remaining subtrees as
+// fallback instructions; expressions this large are not worth compiling anyway.
+const size_t kMaxRegisters = std::numeric_limits<uint16_t>::max();
+}  // namespace
+
+/**
+ * Walks an Expression tree once, allocating registers and appending instructions. Each node is
+ * compiled "into" a destination register so that control-flow constructs ($cond, $and, ...) can
+ * have their branches produce results in a single place.
+ */
+class CompiledExpression::Compiler {
+public:
+    explicit Compiler(CompiledExpression* program) : _program(program) {}
+
+    uint16_t allocateRegister() {
+        invariant(_program->_numRegisters < kMaxRegisters);
+        return _program->_numRegisters++;
+    }
+
+    void compileNode(const boost::intrusive_ptr<Expression>& node, uint16_t dest);
+
+private:
+    Instruction& emit(OpCode op, uint16_t dest) {
+        _program->_instructions.push_back(Instruction());
+        Instruction& instruction = _program->_instructions.back();
+        instruction.op = op;
+        instruction.result = dest;
+        return instruction;
+    }
+
+    /**
+     * Emits a jump instruction with an unresolved target and returns its index for later
+     * patching via patchTarget().
+     */
+    size_t emitJump(OpCode op, uint16_t conditionReg) {
+        Instruction& instruction = emit(op, conditionReg);
+        instruction.lhs = conditionReg;
+        return _program->_instructions.size() - 1;
+    }
+
+    void patchTarget(size_t jumpIndex) {
+        _program->_instructions[jumpIndex].target =
+            static_cast<uint32_t>(_program->_instructions.size());
+    }
+
+    bool compileVariadicArithmetic(const Expression* node, uint16_t dest);
+
+    CompiledExpression* _program;
+};
+
+bool CompiledExpression::Compiler::compileVariadicArithmetic(const Expression* node,
+                                                             uint16_t dest) {
+    const bool isAdd = dynamic_cast<const ExpressionAdd*>(node);
+    const bool isMultiply = dynamic_cast<const ExpressionMultiply*>(node);
+    if (!isAdd && !isMultiply) {
+        return false;
+    }
+
+    const auto& operands = static_cast<const ExpressionNary*>(node)->getOperandList();
+    if (operands.size() > kMaxRegisters - _program->_numRegisters) {
+        return false;
+    }
+
+    // Evaluate the operands into consecutive registers, then combine them with one instruction.
+    const uint16_t firstOperand = _program->_numRegisters;
+    for (auto&& operand : operands) {
+        compileNode(operand, allocateRegister());
+    }
+
+    Instruction& instruction = emit(isAdd ? OpCode::kAdd : OpCode::kMultiply, dest);
+    instruction.lhs = firstOperand;
+    instruction.rhs = static_cast<uint16_t>(operands.size());
+    return true;
+}
+
+void CompiledExpression::Compiler::compileNode(const boost::intrusive_ptr<Expression>& node,
+                                               uint16_t dest) {
+    if (auto constant = dynamic_cast<ExpressionConstant*>(node.get())) {
+        emit(OpCode::kLoadConst, dest).constant = constant->getValue();
+        return;
+    }
+
+    if (auto andExpr = dynamic_cast<ExpressionAnd*>(node.get())) {
+        // Evaluate each operand in turn, jumping to the 'false' epilogue as soon as one is not
+        // truthy, mirroring the short-circuit in ExpressionAnd::evaluate().
+        std::vector<size_t> jumpsToFalse;
+        const uint16_t operandReg = allocateRegister();
+        for (auto&& operand : andExpr->getOperandList()) {
+            compileNode(operand, operandReg);
+            jumpsToFalse.push_back(emitJump(OpCode::kJumpIfNotTruthy, operandReg));
+        }
+        emit(OpCode::kLoadConst, dest).constant = Value(true);
+        size_t jumpToEnd = emitJump(OpCode::kJump, 0);
+        for (size_t jumpIndex : jumpsToFalse) {
+            patchTarget(jumpIndex);
+        }
+        emit(OpCode::kLoadConst, dest).constant = Value(false);
+        patchTarget(jumpToEnd);
+        return;
+    }
+
+    if (auto orExpr = dynamic_cast<ExpressionOr*>(node.get())) {
+        std::vector<size_t> jumpsToTrue;
+        const uint16_t operandReg = allocateRegister();
+        for (auto&& operand : orExpr->getOperandList()) {
+            compileNode(operand, operandReg);
+            // Fall through to the next operand only when this one is not truthy.
+            size_t jumpToNext = emitJump(OpCode::kJumpIfNotTruthy, operandReg);
+            jumpsToTrue.push_back(emitJump(OpCode::kJump, 0));
+            patchTarget(jumpToNext);
+        }
+        emit(OpCode::kLoadConst, dest).constant = Value(false);
+        size_t jumpToEnd = emitJump(OpCode::kJump, 0);
+        for (size_t jumpIndex : jumpsToTrue) {
+            patchTarget(jumpIndex);
+        }
+        emit(OpCode::kLoadConst, dest).constant = Value(true);
+        patchTarget(jumpToEnd);
+        return;
+    }
+
+    if (auto notExpr = dynamic_cast<ExpressionNot*>(node.get())) {
+        const uint16_t operandReg = allocateRegister();
+        compileNode(notExpr->getOperandList()[0], operandReg);
+        emit(OpCode::kNot, dest).lhs = operandReg;
+        return;
+    }
+
+    if (auto cond = dynamic_cast<ExpressionCond*>(node.get())) {
+        const auto& operands = cond->getOperandList();
+        const uint16_t conditionReg = allocateRegister();
+        compileNode(operands[0], conditionReg);
+        size_t jumpToElse = emitJump(OpCode::kJumpIfNotTruthy, conditionReg);
+        compileNode(operands[1], dest);
+        size_t jumpToEnd = emitJump(OpCode::kJump, 0);
+        patchTarget(jumpToElse);
+        compileNode(operands[2], dest);
+        patchTarget(jumpToEnd);
+        return;
+    }
+
+    if (auto ifNull = dynamic_cast<ExpressionIfNull*>(node.get())) {
+        const auto& operands = ifNull->getOperandList();
+        compileNode(operands[0], dest);
+        size_t jumpToEnd = emitJump(OpCode::kJumpIfNotNullish, dest);
+        compileNode(operands[1], dest);
+        patchTarget(jumpToEnd);
+        return;
+    }
+
+    if (auto compare = dynamic_cast<ExpressionCompare*>(node.get())) {
+        const auto& operands = compare->getOperandList();
+        const uint16_t lhsReg = allocateRegister();
+        const uint16_t rhsReg = allocateRegister();
+        compileNode(operands[0], lhsReg);
+        compileNode(operands[1], rhsReg);
+        Instruction& instruction = emit(OpCode::kCompare, dest);
+        instruction.lhs = lhsReg;
+        instruction.rhs = rhsReg;
+        instruction.cmpOp = compare->getOp();
+        return;
+    }
+
+    if (compileVariadicArithmetic(node.get(), dest)) {
+        return;
+    }
+
+    if (auto subtract = dynamic_cast<ExpressionSubtract*>(node.get())) {
+        const auto& operands = subtract->getOperandList();
+        const uint16_t lhsReg = allocateRegister();
+        const uint16_t rhsReg = allocateRegister();
+        compileNode(operands[0], lhsReg);
+        compileNode(operands[1], rhsReg);
+        Instruction& instruction = emit(OpCode::kSubtract, dest);
+        instruction.lhs = lhsReg;
+        instruction.rhs = rhsReg;
+        return;
+    }
+
+    if (auto divide = dynamic_cast<ExpressionDivide*>(node.get())) {
+        const auto& operands = divide->getOperandList();
+        const uint16_t lhsReg = allocateRegister();
+        const uint16_t rhsReg = allocateRegister();
+        compileNode(operands[0], lhsReg);
+        compileNode(operands[1], rhsReg);
+        Instruction& instruction = emit(OpCode::kDivide, dest);
+        instruction.lhs = lhsReg;
+        instruction.rhs = rhsReg;
+        return;
+    }
+
+    // Anything else (field paths, $let, $map, date operators, ...) is evaluated through the
+    // regular virtual interface as a single instruction.
+    emit(OpCode::kEvalTree, dest).tree = node;
+    ++_program->_numFallbacks;
+}
+
+CompiledExpression CompiledExpression::compile(const boost::intrusive_ptr<Expression>& expression,
+                                               const ValueComparator& comparator) {
+    invariant(expression);
+    CompiledExpression program;
+    program._comparator = comparator;
+
+    Compiler compiler(&program);
+    program._resultRegister = compiler.allocateRegister();
+    compiler.compileNode(expression, program._resultRegister);
+    return program;
+}
+
+Value CompiledExpression::evaluate(const Document& root) const {
+    invariant(!_instructions.empty());
+    if (_registers.size() < _numRegisters) {
+        _registers.resize(_numRegisters);
+    }
+
+    size_t pc = 0;
+    const size_t numInstructions = _instructions.size();
+    while (pc < numInstructions) {
+        const Instruction& instruction = _instructions[pc];
+        switch (instruction.op) {
+            case OpCode::kLoadConst:
+                _registers[instruction.result] = instruction.constant;
+                ++pc;
+                break;
+            case OpCode::kEvalTree:
+                _registers[instruction.result] = instruction.tree->evaluate(root);
+                ++pc;
+                break;
+            case OpCode::kJump:
+                pc = instruction.target;
+                break;
+            case OpCode::kJumpIfNotTruthy:
+                pc = _registers[instruction.lhs].coerceToBool() ? pc + 1 : instruction.target;
+                break;
+            case OpCode::kJumpIfNotNullish:
+                pc = _registers[instruction.lhs].nullish() ? pc + 1 : instruction.target;
+                break;
+            case OpCode::kNot:
+                _registers[instruction.result] =
+                    Value(!_registers[instruction.lhs].coerceToBool());
+                ++pc;
+                break;
+            case OpCode::kCompare: {
+                int cmp = _comparator.compare(_registers[instruction.lhs],
+                                              _registers[instruction.rhs]);
+                Value result;
+                switch (instruction.cmpOp) {
+                    case ExpressionCompare::EQ:
+                        result = Value(cmp == 0);
+                        break;
+                    case ExpressionCompare::NE:
+                        result = Value(cmp != 0);
+                        break;
+                    case ExpressionCompare::GT:
+                        result = Value(cmp > 0);
+                        break;
+                    case ExpressionCompare::GTE:
+                        result = Value(cmp >= 0);
+                        break;
+                    case ExpressionCompare::LT:
+                        result = Value(cmp < 0);
+                        break;
+                    case ExpressionCompare::LTE:
+                        result = Value(cmp <= 0);
+                        break;
+                    case ExpressionCompare::CMP:
+                        result = Value(cmp == 0 ? 0 : (cmp < 0 ? -1 : 1));
+                        break;
+                }
+                _registers[instruction.result] = std::move(result);
+                ++pc;
+                break;
+            }
+            case OpCode::kAdd:
+                _registers[instruction.result] = ExpressionAdd::accumulateOperands(
+                    instruction.rhs,
+                    [&](size_t i) { return _registers[instruction.lhs + i]; });
+                ++pc;
+                break;
+            case OpCode::kMultiply:
+                _registers[instruction.result] = ExpressionMultiply::accumulateOperands(
+                    instruction.rhs,
+                    [&](size_t i) { return _registers[instruction.lhs + i]; });
+                ++pc;
+                break;
+            case OpCode::kSubtract:
+                _registers[instruction.result] = ExpressionSubtract::apply(
+                    _registers[instruction.lhs], _registers[instruction.rhs]);
+                ++pc;
+                break;
+            case OpCode::kDivide:
+                _registers[instruction.result] = ExpressionDivide::apply(
+                    _registers[instruction.lhs], _registers[instruction.rhs]);
+                ++pc;
+                break;
+        }
+    }
+    return _registers[_resultRegister];
+}
+
+}  // namespace mongo
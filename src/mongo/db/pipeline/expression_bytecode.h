@@ -0,0 +1,123 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/db/pipeline/value_comparator.h"
+
+namespace mongo {
+
+/**
+ * A flat, register-based compilation of an Expression tree. Rather than walking an intrusive_ptr
+ * tree with a virtual evaluate() call per node, a CompiledExpression executes a linear instruction
+ * sequence in a tight loop with operands held in a flat register file, so per-document evaluation
+ * performs no heap allocation and no virtual dispatch for the compiled node types.
+ *
+ * The compiler handles constants, boolean logic ($and, $or, $not), conditionals ($cond, $ifNull),
+ * comparisons and arithmetic ($add, $subtract, $multiply, $divide). Any other node is embedded as
+ * a single fallback instruction that evaluates that subtree through the usual virtual interface,
+ * so every expression tree can be compiled and execution always agrees with Expression::evaluate.
+ *
+ * Compile after the expression has been optimized, since optimization rewrites the tree (e.g.
+ * constant folding) and the compiled program will not observe later changes to it.
+ *
+ * evaluate() reuses an internal register file, so a CompiledExpression must not be used
+ * concurrently from multiple threads.
+ */
+class CompiledExpression {
+public:
+    /**
+     * Compiles 'expression'. The returned program keeps references to any subtrees it evaluates
+     * through the fallback instruction, so 'expression' must outlive it.
+     */
+    static CompiledExpression compile(const boost::intrusive_ptr<Expression>& expression,
+                                      const ValueComparator& comparator);
+
+    CompiledExpression() = default;
+
+    Value evaluate(const Document& root) const;
+
+    /**
+     * True if the program contains instructions that evaluate a subtree through the virtual
+     * Expression interface (anything without a dedicated opcode, including field paths). Exposed
+     * for testing and diagnostics.
+     */
+    bool hasFallbackInstructions() const {
+        return _numFallbacks > 0;
+    }
+
+    size_t numInstructions() const {
+        return _instructions.size();
+    }
+
+private:
+    enum class OpCode : uint8_t {
+        kLoadConst,       // registers[result] = constant
+        kEvalTree,        // registers[result] = tree->evaluate(root)
+        kJump,            // pc = target
+        kJumpIfNotTruthy, // pc = registers[lhs] coerces to false ? target : pc + 1
+        kJumpIfNotNullish,// pc = registers[lhs] is nullish ? pc + 1 : target
+        kNot,             // registers[result] = !coerceToBool(registers[lhs])
+        kCompare,         // registers[result] = cmp(registers[lhs], registers[rhs])
+        kAdd,             // registers[result] = sum of registers[lhs .. lhs + rhs)
+        kMultiply,        // registers[result] = product of registers[lhs .. lhs + rhs)
+        kSubtract,        // registers[result] = registers[lhs] - registers[rhs]
+        kDivide,          // registers[result] = registers[lhs] / registers[rhs]
+    };
+
+    struct Instruction {
+        OpCode op;
+        ExpressionCompare::CmpOp cmpOp = ExpressionCompare::EQ;  // Only used by kCompare.
+        uint16_t result = 0;
+        uint16_t lhs = 0;
+        uint16_t rhs = 0;    // Second operand register, or the operand count for kAdd/kMultiply.
+        uint32_t target = 0; // Jump destination, for the jump opcodes.
+        Value constant;                        // Only used by kLoadConst.
+        boost::intrusive_ptr<Expression> tree; // Only used by kEvalTree.
+    };
+
+    class Compiler;
+
+    std::vector<Instruction> _instructions;
+    ValueComparator _comparator;
+    uint16_t _numRegisters = 0;
+    uint16_t _resultRegister = 0;
+    size_t _numFallbacks = 0;
+
+    // Scratch space for evaluate(), sized to '_numRegisters' on first use and reused across
+    // documents. This is what makes evaluation allocation-free but not thread-safe.
+    mutable std::vector<Value> _registers;
+};
+
+}  // namespace mongo
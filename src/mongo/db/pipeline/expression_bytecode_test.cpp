@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_bytecode.h"
+
+#include <boost/intrusive_ptr.hpp>
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using boost::intrusive_ptr;
+
+/**
+ * Parses 'specification' and compiles it with 'expCtx's value comparator. Does not optimize the
+ * parsed tree first, so that constant subexpressions reach the compiler instead of being folded.
+ */
+CompiledExpression compileExpression(const BSONObj& specification,
+                                     const intrusive_ptr<ExpressionContextForTest>& expCtx) {
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto expression = Expression::parseExpression(expCtx, specification, vps);
+    return CompiledExpression::compile(expression, expCtx->getValueComparator());
+}
+
+/**
+ * Asserts that the compiled form of 'specification' and tree evaluation agree on 'input'.
+ */
+void assertCompiledAgreesWithTree(const BSONObj& specification, const Document& input) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto expression = Expression::parseExpression(expCtx, specification, vps)->optimize();
+    auto compiled = CompiledExpression::compile(expression, expCtx->getValueComparator());
+    ASSERT_VALUE_EQ(compiled.evaluate(input), expression->evaluate(input));
+}
+
+TEST(CompiledExpressionTest, CompilesArithmeticWithoutFallbacks) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto compiled = compileExpression(
+        BSON("$subtract" << BSON_ARRAY(BSON("$multiply" << BSON_ARRAY(2 << 3 << 4)) << 5)),
+        expCtx);
+    ASSERT_FALSE(compiled.hasFallbackInstructions());
+    ASSERT_VALUE_EQ(compiled.evaluate(Document()), Value(19));
+}
+
+TEST(CompiledExpressionTest, ArithmeticAgreesWithTreeEvaluation) {
+    assertCompiledAgreesWithTree(BSON("$add" << BSON_ARRAY("$a"
+                                                           << "$b"
+                                                           << 1)),
+                                 Document{{"a", 1}, {"b", 2.5}});
+    assertCompiledAgreesWithTree(BSON("$divide" << BSON_ARRAY("$a" << 4)), Document{{"a", 10}});
+    assertCompiledAgreesWithTree(BSON("$subtract" << BSON_ARRAY("$a"
+                                                                << "$b")),
+                                 Document{{"a", 7LL}, {"b", 3}});
+    // Nullish operands.
+    assertCompiledAgreesWithTree(BSON("$add" << BSON_ARRAY("$missing" << 1)), Document());
+    assertCompiledAgreesWithTree(BSON("$multiply" << BSON_ARRAY(BSONNULL << 2)), Document());
+}
+
+TEST(CompiledExpressionTest, BooleanLogicShortCircuits) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    // The second $and operand would throw if evaluated; $and must stop at the first false.
+    auto compiled = compileExpression(
+        BSON("$and" << BSON_ARRAY(false << BSON("$divide" << BSON_ARRAY(1 << 0)))), expCtx);
+    ASSERT_VALUE_EQ(compiled.evaluate(Document()), Value(false));
+
+    compiled = compileExpression(
+        BSON("$or" << BSON_ARRAY(true << BSON("$divide" << BSON_ARRAY(1 << 0)))), expCtx);
+    ASSERT_VALUE_EQ(compiled.evaluate(Document()), Value(true));
+}
+
+TEST(CompiledExpressionTest, ConditionalsSelectTheCorrectBranch) {
+    assertCompiledAgreesWithTree(BSON("$cond" << BSON_ARRAY(BSON("$gt" << BSON_ARRAY("$a" << 5))
+                                                            << "big"
+                                                            << "small")),
+                                 Document{{"a", 10}});
+    assertCompiledAgreesWithTree(BSON("$cond" << BSON_ARRAY(BSON("$gt" << BSON_ARRAY("$a" << 5))
+                                                            << "big"
+                                                            << "small")),
+                                 Document{{"a", 1}});
+    assertCompiledAgreesWithTree(BSON("$ifNull" << BSON_ARRAY("$missing"
+                                                              << "fallback")),
+                                 Document());
+    assertCompiledAgreesWithTree(BSON("$ifNull" << BSON_ARRAY("$a"
+                                                              << "fallback")),
+                                 Document{{"a", 42}});
+}
+
+TEST(CompiledExpressionTest, ComparisonsRespectTheCollation) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    expCtx->setCollator(
+        stdx::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+
+    auto compiled = compileExpression(BSON("$eq" << BSON_ARRAY("$a"
+                                                               << "FOO")),
+                                      expCtx);
+    ASSERT_VALUE_EQ(compiled.evaluate(Document{{"a", "foo"_sd}}), Value(true));
+    ASSERT_VALUE_EQ(compiled.evaluate(Document{{"a", "bar"_sd}}), Value(false));
+}
+
+TEST(CompiledExpressionTest, UnsupportedNodesFallBackToTreeEvaluation) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto compiled = compileExpression(
+        BSON("$add" << BSON_ARRAY(BSON("$strLenBytes" << BSON_ARRAY("$a")) << 1)), expCtx);
+    ASSERT_TRUE(compiled.hasFallbackInstructions());
+    ASSERT_VALUE_EQ(compiled.evaluate(Document{{"a", "abc"_sd}}), Value(4));
+}
+
+TEST(CompiledExpressionTest, ThrowsTheSameErrorsAsTreeEvaluation) {
+    intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto compiled = compileExpression(BSON("$divide" << BSON_ARRAY("$a" << 0)), expCtx);
+    ASSERT_THROWS_CODE(compiled.evaluate(Document{{"a", 1}}), UserException, 16608);
+}
+
+}  // namespace
+}  // namespace mongo
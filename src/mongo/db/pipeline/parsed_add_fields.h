@@ -81,7 +81,7 @@ public:
      * Optimizes any computed expressions.
      */
     void optimize() final {
-        _root->optimize();
+        _root->optimize(_expCtx->getValueComparator());
     }
 
     DocumentSource::GetDepsReturn addDependencies(DepsTracker* deps) const final {
@@ -45,12 +45,14 @@ using std::unique_ptr;
 
 InclusionNode::InclusionNode(std::string pathToNode) : _pathToNode(std::move(pathToNode)) {}
 
-void InclusionNode::optimize() {
+void InclusionNode::optimize(const ValueComparator& comparator) {
     for (auto&& expressionIt : _expressions) {
         _expressions[expressionIt.first] = expressionIt.second->optimize();
+        _compiledExpressions[expressionIt.first] =
+            CompiledExpression::compile(_expressions[expressionIt.first], comparator);
     }
     for (auto&& childPair : _children) {
-        childPair.second->optimize();
+        childPair.second->optimize(comparator);
     }
 }
 
@@ -148,9 +150,14 @@ void InclusionNode::addComputedFields(MutableDocument* outputDoc, const Document
             outputDoc->setField(field,
                                 childIt->second->addComputedFields(outputDoc->peek()[field], root));
         } else {
-            auto expressionIt = _expressions.find(field);
-            invariant(expressionIt != _expressions.end());
-            outputDoc->setField(field, expressionIt->second->evaluate(root));
+            auto compiledIt = _compiledExpressions.find(field);
+            if (compiledIt != _compiledExpressions.end()) {
+                outputDoc->setField(field, compiledIt->second.evaluate(root));
+            } else {
+                auto expressionIt = _expressions.find(field);
+                invariant(expressionIt != _expressions.end());
+                outputDoc->setField(field, expressionIt->second->evaluate(root));
+            }
         }
     }
 }
@@ -31,6 +31,7 @@
 #include <memory>
 
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_bytecode.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/parsed_aggregation_projection.h"
 #include "mongo/stdx/memory.h"
@@ -55,9 +56,9 @@ public:
     InclusionNode(std::string pathToNode = "");
 
     /**
-     * Optimize any computed expressions.
+     * Optimize any computed expressions and compile them to bytecode for evaluation.
      */
-    void optimize();
+    void optimize(const ValueComparator& comparator);
 
     /**
      * Serialize this projection.
@@ -169,6 +170,10 @@ private:
     std::vector<std::string> _orderToProcessAdditionsAndChildren;
 
     StringMap<boost::intrusive_ptr<Expression>> _expressions;
+
+    // Bytecode compilations of '_expressions', built by optimize() and preferred over tree
+    // evaluation when present.
+    StringMap<CompiledExpression> _compiledExpressions;
     stdx::unordered_set<std::string> _inclusions;
 
     // TODO use StringMap once SERVER-23700 is resolved.
@@ -212,7 +217,7 @@ public:
      * Optimize any computed expressions.
      */
     void optimize() final {
-        _root->optimize();
+        _root->optimize(_expCtx->getValueComparator());
     }
 
     DocumentSource::GetDepsReturn addDependencies(DepsTracker* deps) const final {
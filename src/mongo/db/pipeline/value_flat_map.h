@@ -0,0 +1,205 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/pipeline/value_comparator.h"
+
+namespace mongo {
+
+/**
+ * An open-addressing hash map from Value to T, respecting a ValueComparator's equivalence
+ * classes. Entries live in one flat array probed linearly, so a lookup is a hash, an index,
+ * and (almost always) a single cache line, instead of the per-node allocation and pointer
+ * chase of ValueUnorderedMap. Each entry caches its 32-bit hash so probes compare hashes
+ * before falling back to full Value equality, and growth rehashes without recomputing them.
+ *
+ * Supports only the operations the aggregation stages need: operator[], iteration, size,
+ * and clear. There is no erase, so no tombstone handling. Iterators and references are
+ * invalidated by operator[] (which may grow the table) but remain valid while the map is
+ * only being read. The comparator must outlive the map.
+ */
+template <typename T>
+class ValueFlatMap {
+public:
+    using value_type = std::pair<Value, T>;
+
+private:
+    struct Entry {
+        uint32_t hash = 0;
+        bool used = false;
+        value_type data;
+    };
+
+    template <typename EntryPtr, typename ValueTypeRef, typename ValueTypePtr>
+    class IteratorImpl {
+    public:
+        IteratorImpl() : _it(nullptr), _end(nullptr) {}
+
+        IteratorImpl(EntryPtr it, EntryPtr end) : _it(it), _end(end) {
+            _skipUnused();
+        }
+
+        /// Allows converting iterator to const_iterator.
+        template <typename P, typename R, typename Q>
+        IteratorImpl(const IteratorImpl<P, R, Q>& other,
+                     typename std::enable_if<std::is_convertible<P, EntryPtr>::value>::type* = 0)
+            : _it(other._it), _end(other._end) {}
+
+        ValueTypeRef operator*() const {
+            return _it->data;
+        }
+        ValueTypePtr operator->() const {
+            return &_it->data;
+        }
+
+        IteratorImpl& operator++() {
+            ++_it;
+            _skipUnused();
+            return *this;
+        }
+
+        bool operator==(const IteratorImpl& other) const {
+            return _it == other._it;
+        }
+        bool operator!=(const IteratorImpl& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        template <typename P, typename R, typename Q>
+        friend class IteratorImpl;
+
+        void _skipUnused() {
+            while (_it != _end && !_it->used)
+                ++_it;
+        }
+
+        EntryPtr _it;
+        EntryPtr _end;
+    };
+
+public:
+    using iterator = IteratorImpl<Entry*, value_type&, value_type*>;
+    using const_iterator = IteratorImpl<const Entry*, const value_type&, const value_type*>;
+
+    explicit ValueFlatMap(const ValueComparator& comparator)
+        : _hasher(comparator.getHasher()), _equalTo(comparator.getEqualTo()) {}
+
+    /**
+     * Returns the mapped value for 'key', default-constructing it on first access.
+     */
+    T& operator[](const Value& key) {
+        if (_table.empty())
+            _table.resize(kInitialBuckets);
+
+        const uint32_t hash = static_cast<uint32_t>(_hasher(key));
+        Entry* entry = _find(hash, key);
+        if (!entry->used) {
+            // Keep the load factor under 3/4 so probe sequences stay short.
+            if ((_size + 1) * 4 > _table.size() * 3) {
+                _grow();
+                entry = _find(hash, key);
+            }
+            entry->used = true;
+            entry->hash = hash;
+            entry->data.first = key;
+            ++_size;
+        }
+        return entry->data.second;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void clear() {
+        _table.clear();
+        _table.shrink_to_fit();
+        _size = 0;
+    }
+
+    iterator begin() {
+        return iterator(_table.data(), _table.data() + _table.size());
+    }
+    iterator end() {
+        return iterator(_table.data() + _table.size(), _table.data() + _table.size());
+    }
+    const_iterator begin() const {
+        return const_iterator(_table.data(), _table.data() + _table.size());
+    }
+    const_iterator end() const {
+        return const_iterator(_table.data() + _table.size(), _table.data() + _table.size());
+    }
+
+private:
+    static const size_t kInitialBuckets = 16;  // must be a power of two
+
+    /// Returns the entry holding 'key', or the empty slot where it would be inserted.
+    Entry* _find(uint32_t hash, const Value& key) {
+        const size_t mask = _table.size() - 1;
+        size_t i = hash & mask;
+        while (true) {
+            Entry& entry = _table[i];
+            if (!entry.used ||
+                (entry.hash == hash && _equalTo(entry.data.first, key)))
+                return &entry;
+            i = (i + 1) & mask;
+        }
+    }
+
+    void _grow() {
+        std::vector<Entry> oldTable(_table.size() * 2);
+        oldTable.swap(_table);
+        const size_t mask = _table.size() - 1;
+        for (auto&& entry : oldTable) {
+            if (!entry.used)
+                continue;
+            size_t i = entry.hash & mask;
+            while (_table[i].used)
+                i = (i + 1) & mask;
+            _table[i].used = true;
+            _table[i].hash = entry.hash;
+            _table[i].data = std::move(entry.data);
+        }
+    }
+
+    ValueComparator::Hasher _hasher;
+    ValueComparator::EqualTo _equalTo;
+    std::vector<Entry> _table;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/value_flat_map.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(ValueFlatMap, InsertFindAndGrowth) {
+    ValueComparator comparator;
+    ValueFlatMap<int> map(comparator);
+    ASSERT_TRUE(map.empty());
+
+    // Enough keys to force several growths past the initial table size.
+    const int kKeys = 1000;
+    for (int i = 0; i < kKeys; i++) {
+        map[Value(i)] = i * 2;
+    }
+    ASSERT_EQUALS(map.size(), static_cast<size_t>(kKeys));
+
+    for (int i = 0; i < kKeys; i++) {
+        ASSERT_EQUALS(map[Value(i)], i * 2);
+    }
+    ASSERT_EQUALS(map.size(), static_cast<size_t>(kKeys));
+}
+
+TEST(ValueFlatMap, IterationVisitsEachEntryOnce) {
+    ValueComparator comparator;
+    ValueFlatMap<int> map(comparator);
+    for (int i = 0; i < 25; i++) {
+        map[Value(i)] = 1;
+    }
+
+    int visited = 0;
+    for (auto&& entry : map) {
+        visited += entry.second;
+    }
+    ASSERT_EQUALS(visited, 25);
+}
+
+TEST(ValueFlatMap, ClearReleasesEntries) {
+    ValueComparator comparator;
+    ValueFlatMap<int> map(comparator);
+    map[Value(1)] = 1;
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_TRUE(map.begin() == map.end());
+    map[Value(1)] = 2;
+    ASSERT_EQUALS(map[Value(1)], 2);
+}
+
+TEST(ValueFlatMap, RespectsComparatorEquivalenceClasses) {
+    CollatorInterfaceMock toLowerCollator(CollatorInterfaceMock::MockType::kToLowerString);
+    ValueComparator comparator(&toLowerCollator);
+    ValueFlatMap<int> map(comparator);
+
+    map[Value("foo"_sd)] = 1;
+    map[Value("FOO"_sd)] += 1;
+    ASSERT_EQUALS(map.size(), 1u);
+    ASSERT_EQUALS(map[Value("Foo"_sd)], 2);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -244,10 +244,12 @@ public:
     }
 
     void putRefCountable(boost::intrusive_ptr<const RefCountable> ptr) {
-        genericRCPtr = ptr.get();
+        // Take over the reference owned by 'ptr' rather than adding one here and releasing one
+        // when 'ptr' goes out of scope. This spares every heap-backed Value construction (e.g.
+        // any string over the inline limit) a pair of atomic refcount operations.
+        genericRCPtr = ptr.detach();
 
         if (genericRCPtr) {
-            intrusive_ptr_add_ref(genericRCPtr);
             refCounter = true;
         }
         DEV verifyRefCountingIfShould();
@@ -34,16 +34,71 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_array.h"
+#include "mongo/db/matcher/expression_tree.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/lru_key_value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
+
+/**
+ * An immutable, shared product of parsing a filter. 'filter' owns the BSON buffer that the
+ * leaves of 'tree' -- and of any clones made of 'tree' -- point into, so an entry must stay
+ * alive for as long as any such clone does. CanonicalQuery anchors the entry it was cloned
+ * from for exactly this reason.
+ */
+class ParsedFilterCacheEntry {
+public:
+    ParsedFilterCacheEntry(BSONObj filter, std::unique_ptr<MatchExpression> tree)
+        : filter(std::move(filter)), tree(std::move(tree)) {}
+
+    const BSONObj filter;
+    const std::unique_ptr<MatchExpression> tree;
+};
+
 namespace {
 
+typedef std::shared_ptr<const ParsedFilterCacheEntry> ParsedFilterCacheValue;
+
+// Protects 'parseCache()'. The critical sections are a hash lookup and a shared_ptr copy, so
+// this mutex is held for far less time than a filter parse takes.
+stdx::mutex parseCacheMutex;
+
+/**
+ * Process-wide cache of parsed filters, keyed by the filter's exact BSON bytes. Leaked on
+ * shutdown, like other function-local static caches, to avoid destruction-order problems.
+ */
+LRUKeyValue<std::string, ParsedFilterCacheValue>& parseCache() {
+    static LRUKeyValue<std::string, ParsedFilterCacheValue>* cache =
+        new LRUKeyValue<std::string, ParsedFilterCacheValue>(
+            static_cast<size_t>(internalQueryFilterParseCacheSize.load()));
+    return *cache;
+}
+
+/**
+ * Returns true if a parse of this tree may be cached and cloned into later operations.
+ * $where and $text capture per-operation state (a JS scope / resolved namespace) at parse
+ * time, so trees containing them are never cached.
+ */
+bool isCacheableParse(const MatchExpression* tree) {
+    if (MatchExpression::WHERE == tree->matchType() ||
+        MatchExpression::TEXT == tree->matchType()) {
+        return false;
+    }
+    for (size_t i = 0; i < tree->numChildren(); ++i) {
+        if (!isCacheableParse(tree->getChild(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * Comparator for MatchExpression nodes.  Returns an integer less than, equal to, or greater
  * than zero if 'lhs' is less than, equal to, or greater than 'rhs', respectively.
@@ -132,16 +187,50 @@ StatusWith<std::unique_ptr<CanonicalQuery>> CanonicalQuery::canonicalize(
         collator = std::move(statusWithCollator.getValue());
     }
 
-    // Make MatchExpression.
-    StatusWithMatchExpression statusWithMatcher =
-        MatchExpressionParser::parse(qr->getFilter(), extensionsCallback, collator.get());
-    if (!statusWithMatcher.isOK()) {
-        return statusWithMatcher.getStatus();
+    // Make MatchExpression. Repeated queries commonly carry byte-identical filters, and
+    // parsing is a pure function of the filter bytes once collations and per-operation
+    // operators ($where, $text) are excluded, so consult the parse cache before parsing.
+    const bool useParseCache = !collator && internalQueryFilterParseCacheSize.load() > 0;
+    std::unique_ptr<MatchExpression> me;
+    std::shared_ptr<const ParsedFilterCacheEntry> parseCacheEntry;
+    std::string parseCacheKey;
+    if (useParseCache) {
+        parseCacheKey.assign(qr->getFilter().objdata(), qr->getFilter().objsize());
+        stdx::lock_guard<stdx::mutex> lk(parseCacheMutex);
+        ParsedFilterCacheValue* cached;
+        if (parseCache().get(parseCacheKey, &cached).isOK()) {
+            parseCacheEntry = *cached;
+        }
+    }
+
+    if (parseCacheEntry) {
+        me = parseCacheEntry->tree->shallowClone();
+    } else {
+        StatusWithMatchExpression statusWithMatcher =
+            MatchExpressionParser::parse(qr->getFilter(), extensionsCallback, collator.get());
+        if (!statusWithMatcher.isOK()) {
+            return statusWithMatcher.getStatus();
+        }
+        me = std::move(statusWithMatcher.getValue());
+
+        if (useParseCache && isCacheableParse(me.get())) {
+            // Cache a parse made against an owned copy of the filter, so the cached tree
+            // stays valid after this query's buffers are gone. The extra parse is paid once
+            // per filter; every later byte-identical query skips parsing entirely.
+            BSONObj ownedFilter = qr->getFilter().getOwned();
+            StatusWithMatchExpression ownedParse =
+                MatchExpressionParser::parse(ownedFilter, extensionsCallback, nullptr);
+            invariant(ownedParse.isOK());
+            auto entry = std::make_shared<const ParsedFilterCacheEntry>(
+                std::move(ownedFilter), std::move(ownedParse.getValue()));
+            stdx::lock_guard<stdx::mutex> lk(parseCacheMutex);
+            parseCache().add(parseCacheKey, new ParsedFilterCacheValue(std::move(entry)));
+        }
     }
-    std::unique_ptr<MatchExpression> me = std::move(statusWithMatcher.getValue());
 
     // Make the CQ we'll hopefully return.
     std::unique_ptr<CanonicalQuery> cq(new CanonicalQuery());
+    cq->_parseCacheEntry = std::move(parseCacheEntry);
 
     Status initStatus =
         cq->init(std::move(qr), extensionsCallback, me.release(), std::move(collator));
@@ -202,6 +291,15 @@ Status CanonicalQuery::init(std::unique_ptr<QueryRequest> qr,
 
     sortTree(root);
     _root.reset(root);
+
+    // Let a top-level conjunction adapt its evaluation order to observed selectivity at
+    // execution time. The canonical query's tree (and any clones placed in plan stages) is
+    // only ever evaluated by the operation running the query, so the mutable ordering state
+    // is safe here; shared trees such as collection validators never enable this.
+    if (MatchExpression::AND == root->matchType()) {
+        static_cast<AndMatchExpression*>(root)->enableAdaptiveReordering();
+    }
+
     Status validStatus = isValid(root, *_qr);
     if (!validStatus.isOK()) {
         return validStatus;
@@ -40,6 +40,7 @@
 namespace mongo {
 
 class OperationContext;
+class ParsedFilterCacheEntry;
 
 class CanonicalQuery {
 public:
@@ -190,9 +191,14 @@ private:
 
     std::unique_ptr<QueryRequest> _qr;
 
-    // _root points into _qr->getFilter()
+    // _root points into _qr->getFilter(), except when canonicalize() found the filter in the
+    // parse cache; then _root is a clone of the cached tree and points into the filter bytes
+    // owned by '_parseCacheEntry', which must therefore outlive '_root'.
     std::unique_ptr<MatchExpression> _root;
 
+    // Non-null only when '_root' was cloned from a cached parse. See above.
+    std::shared_ptr<const ParsedFilterCacheEntry> _parseCacheEntry;
+
     std::unique_ptr<ParsedProjection> _proj;
 
     std::unique_ptr<CollatorInterface> _collator;
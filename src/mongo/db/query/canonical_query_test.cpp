@@ -479,6 +479,19 @@ TEST(CanonicalQueryTest, IsIsolatedReturnsFalseWithIsolated) {
     ASSERT_FALSE(cq->isIsolated());
 }
 
+TEST(CanonicalQueryTest, RepeatedFilterParsesEquivalentlyThroughParseCache) {
+    // The first canonicalization seeds the process-wide parse cache; the second is served from
+    // it. The query built from the cached parse must be equivalent to a freshly parsed one and
+    // must remain usable after the query that seeded the cache is destroyed.
+    unique_ptr<CanonicalQuery> seed = canonicalize("{a: {$gte: 5}, b: {$in: [1, 2, 3]}}");
+    unique_ptr<CanonicalQuery> cached = canonicalize("{a: {$gte: 5}, b: {$in: [1, 2, 3]}}");
+    ASSERT_TRUE(seed->root()->equivalent(cached->root()));
+
+    seed.reset();
+    ASSERT_TRUE(cached->root()->matchesBSON(fromjson("{a: 7, b: 2}")));
+    ASSERT_FALSE(cached->root()->matchesBSON(fromjson("{a: 1, b: 2}")));
+}
+
 TEST(CanonicalQueryTest, IsIsolatedReturnsFalseWithAtomic) {
     unique_ptr<CanonicalQuery> cq = canonicalize("{$atomic: 0, x: 3}");
     ASSERT_FALSE(cq->isIsolated());
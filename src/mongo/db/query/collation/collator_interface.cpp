@@ -34,6 +34,15 @@
 
 namespace mongo {
 
+void CollatorInterface::compareBatch(const StringData* lefts,
+                                     const StringData* rights,
+                                     int* results,
+                                     size_t count) const {
+    for (size_t i = 0; i < count; i++) {
+        results[i] = compare(lefts[i], rights[i]);
+    }
+}
+
 void CollatorInterface::hash_combine(size_t& seed, StringData stringToHash) const {
     auto comparisonKey = getComparisonKey(stringToHash);
     SimpleStringDataComparator::kInstance.hash_combine(seed, comparisonKey.getKeyData());
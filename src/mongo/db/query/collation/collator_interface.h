@@ -101,6 +101,17 @@ public:
      */
     virtual int compare(StringData left, StringData right) const = 0;
 
+    /**
+     * Compares 'count' left/right pairs, writing each three-way result into 'results'. The
+     * default implementation loops over compare(); collators with a cheaper batched path may
+     * override. Batch callers (key generation, sort) amortize virtual dispatch across a run
+     * of comparisons instead of paying it per pair.
+     */
+    virtual void compareBatch(const StringData* lefts,
+                              const StringData* rights,
+                              int* results,
+                              size_t count) const;
+
     /**
      * Hashes the string such that strings which are equal under this collation also have equal
      * hashes.
@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "mongo/base/string_data.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mongo {
+namespace simple_collation {
+
+/**
+ * Three-way comparison with simple-collation (codepoint order) semantics, identical to
+ * StringData::compare but explicitly vectorized: 16-byte blocks are tested for equality with
+ * a single SSE2 compare, and only the first differing block is examined byte-wise. Intended
+ * for inner loops (key generation, sort) where both operands are hot in cache and the libc
+ * memcmp call overhead shows up.
+ */
+inline int compareStrings(StringData left, StringData right) {
+    const size_t commonLen = std::min(left.size(), right.size());
+    const char* l = left.rawData();
+    const char* r = right.rawData();
+    size_t i = 0;
+#if defined(__SSE2__)
+    while (i + 16 <= commonLen) {
+        const __m128i lv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l + i));
+        const __m128i rv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i));
+        const unsigned eq = _mm_movemask_epi8(_mm_cmpeq_epi8(lv, rv));
+        if (eq != 0xffff) {
+            const size_t diff = i + __builtin_ctz(~eq);
+            return static_cast<unsigned char>(l[diff]) < static_cast<unsigned char>(r[diff])
+                ? -1
+                : 1;
+        }
+        i += 16;
+    }
+#endif
+    if (i < commonLen) {
+        if (int res = memcmp(l + i, r + i, commonLen - i))
+            return res > 0 ? 1 : -1;
+    }
+    if (left.size() == right.size())
+        return 0;
+    return left.size() < right.size() ? -1 : 1;
+}
+
+/**
+ * Batch form of compareStrings: writes the three-way result for each of 'count' pairs into
+ * 'results'. Mirrors CollatorInterface::compareBatch so callers can use one shape for both
+ * the simple and non-simple collation paths.
+ */
+inline void compareStringsBatch(const StringData* lefts,
+                                const StringData* rights,
+                                int* results,
+                                size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        results[i] = compareStrings(lefts[i], rights[i]);
+    }
+}
+
+}  // namespace simple_collation
+}  // namespace mongo
@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/query/collation/simple_collation_compare.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+
+int sign(int x) {
+    return (x > 0) - (x < 0);
+}
+
+TEST(SimpleCollationCompare, AgreesWithStringDataCompare) {
+    std::vector<std::string> cases = {
+        "",
+        "a",
+        "b",
+        "ab",
+        "abc",
+        "abd",
+        std::string(100, 'z'),
+        std::string(100, 'z') + "a",
+        std::string(100, 'z') + "b",
+        "exactly sixteen!",
+        "exactly sixteen!x",
+        std::string("emb\0edded", 9),
+        std::string("emb\0eddee", 9),
+        "\xff\xfe",
+        "\x01\x02",
+    };
+    for (size_t i = 0; i < cases.size(); i++) {
+        for (size_t j = 0; j < cases.size(); j++) {
+            StringData l(cases[i]);
+            StringData r(cases[j]);
+            ASSERT_EQUALS(sign(simple_collation::compareStrings(l, r)), sign(l.compare(r)))
+                << "comparing '" << l << "' and '" << r << "'";
+        }
+    }
+}
+
+TEST(SimpleCollationCompare, BatchMatchesScalar) {
+    std::vector<StringData> lefts = {"a", "same", "longer string here", ""};
+    std::vector<StringData> rights = {"b", "same", "longer string herf", "x"};
+    int results[4];
+    simple_collation::compareStringsBatch(lefts.data(), rights.data(), results, 4);
+    for (size_t i = 0; i < 4; i++) {
+        ASSERT_EQUALS(results[i], simple_collation::compareStrings(lefts[i], rights[i]));
+    }
+}
+
+}  // namespace
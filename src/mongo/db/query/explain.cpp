@@ -390,6 +390,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsExamined);
             bob->appendNumber("alreadyHasObj", spec->alreadyHasObj);
+            bob->appendNumber("docsPrefetched", spec->docsPrefetched);
         }
     } else if (STAGE_GEO_NEAR_2D == stats.stageType || STAGE_GEO_NEAR_2DSPHERE == stats.stageType) {
         NearStats* spec = static_cast<NearStats*>(stats.specific.get());
@@ -416,6 +417,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         GroupStats* spec = static_cast<GroupStats*>(stats.specific.get());
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("nGroups", spec->nGroups);
+            bob->appendBool("nativeReduce", spec->nativeReduce);
         }
     } else if (STAGE_IDHACK == stats.stageType) {
         IDHackStats* spec = static_cast<IDHackStats*>(stats.specific.get());
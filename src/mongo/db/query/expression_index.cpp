@@ -37,6 +37,8 @@
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/query/expression_index_knobs.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2region.h"
 #include "third_party/s2/s2regioncoverer.h"
@@ -51,6 +53,12 @@ BSONObj ExpressionMapping::hash(const BSONElement& value) {
     return bob.obj();
 }
 
+BSONObj ExpressionMapping::hash(const BSONElement& value, int seed, int hashVersion) {
+    BSONObjBuilder bob;
+    bob.append("", BSONElementHasher::hash64ForVersion(value, seed, hashVersion));
+    return bob.obj();
+}
+
 // For debugging only
 static std::string toCoveringString(const GeoHashConverter& hashConverter,
                                     const set<GeoHash>& covering) {
@@ -133,6 +141,69 @@ void ExpressionMapping::cover2dsphere(const S2Region& region,
     S2CellIdsToIntervalsWithParents(cover, indexingParams, oilOut);
 }
 
+namespace {
+
+// Upper bound on the number of distinct (geometry, index parameters) entries we remember.
+// Cached intervals are refcounted views of small BSON objects, so even a full cache stays
+// modest in size relative to the plan cache.
+const std::size_t kS2CoveringCacheSize = 5000;
+
+using S2CoveringCache = LRUCache<std::string, std::vector<Interval>>;
+
+stdx::mutex s2CoveringCacheMutex;
+
+S2CoveringCache& s2CoveringCache() {
+    static S2CoveringCache cache(kS2CoveringCacheSize);
+    return cache;
+}
+
+// The derived bounds depend on the geometry, the per-index S2 parameters, and the covering
+// knobs, all of which can differ between lookups, so they all participate in the key. The
+// knobs in particular are runtime-settable; folding their current values into the key means a
+// knob change naturally stops matching the old entries rather than serving stale coverings.
+std::string makeS2CoveringCacheKey(const BSONObj& geometrySpec,
+                                   const S2IndexingParams& indexParams) {
+    StringBuilder key;
+    key.append(StringData(geometrySpec.objdata(), geometrySpec.objsize()));
+    key << indexParams.indexVersion << '/' << indexParams.coarsestIndexedLevel << '/'
+        << internalQueryS2GeoFinestLevel.load() << '/' << internalQueryS2GeoCoarsestLevel.load()
+        << '/' << internalQueryS2GeoMaxCells.load();
+    return key.str();
+}
+
+}  // namespace
+
+void ExpressionMapping::cover2dsphereCached(const BSONObj& geometrySpec,
+                                            const S2Region& region,
+                                            const S2IndexingParams& indexParams,
+                                            OrderedIntervalList* oilOut) {
+    if (geometrySpec.isEmpty()) {
+        cover2dsphere(region, indexParams, oilOut);
+        return;
+    }
+
+    const std::string key = makeS2CoveringCacheKey(geometrySpec, indexParams);
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(s2CoveringCacheMutex);
+        S2CoveringCache::iterator it = s2CoveringCache().find(key);
+        if (it != s2CoveringCache().end()) {
+            oilOut->intervals.insert(
+                oilOut->intervals.end(), it->second.begin(), it->second.end());
+            return;
+        }
+    }
+
+    // Compute outside the lock; covering generation is the expensive part we are amortizing.
+    OrderedIntervalList computed;
+    cover2dsphere(region, indexParams, &computed);
+    oilOut->intervals.insert(
+        oilOut->intervals.end(), computed.intervals.begin(), computed.intervals.end());
+
+    stdx::lock_guard<stdx::mutex> lk(s2CoveringCacheMutex);
+    s2CoveringCache().add(key, std::move(computed.intervals));
+}
+
 namespace {
 bool compareIntervals(const Interval& a, const Interval& b) {
     return a.precedes(b);
@@ -50,6 +50,12 @@ class ExpressionMapping {
 public:
     static BSONObj hash(const BSONElement& value);
 
+    /**
+     * As above, but for the given hashed-index version and seed. The parameterless form is
+     * equivalent to version 0 with the default seed.
+     */
+    static BSONObj hash(const BSONElement& value, int seed, int hashVersion);
+
     static std::vector<GeoHash> get2dCovering(const R2Region& region,
                                               const BSONObj& indexInfoObj,
                                               int maxCoveringCells);
@@ -77,6 +83,20 @@ public:
     static void cover2dsphere(const S2Region& region,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
+
+    /**
+     * As cover2dsphere(), but consults a process-wide LRU cache keyed by the raw geometry
+     * specification plus the indexing parameters and covering knobs. Workloads that issue the
+     * same query shapes repeatedly skip the covering computation entirely on a hit. When
+     * 'geometrySpec' is empty the cache is bypassed.
+     *
+     * Cached intervals share ownership of their backing BSON, so hits only copy refcounted
+     * handles.
+     */
+    static void cover2dsphereCached(const BSONObj& geometrySpec,
+                                    const S2Region& region,
+                                    const S2IndexingParams& indexParams,
+                                    OrderedIntervalList* oilOut);
 };
 
 }  // namespace mongo
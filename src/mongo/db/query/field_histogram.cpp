@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/field_histogram.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+namespace {
+
+// Orders single-element sample objects by value, ignoring field names.
+bool valueLess(const BSONObj& lhs, const BSONObj& rhs) {
+    return lhs.firstElement().woCompare(rhs.firstElement(), false) < 0;
+}
+
+}  // namespace
+
+const size_t FieldHistogram::kMaxBuckets = 64;
+
+FieldHistogram FieldHistogram::make(std::vector<BSONObj> sample) {
+    FieldHistogram histogram;
+    histogram._sampleSize = sample.size();
+    if (sample.empty()) {
+        return histogram;
+    }
+
+    std::sort(sample.begin(), sample.end(), valueLess);
+
+    if (sample.size() <= kMaxBuckets) {
+        histogram._bounds = std::move(sample);
+        return histogram;
+    }
+
+    // Keep kMaxBuckets boundaries at evenly spaced quantiles.  Equal heights fall out of
+    // taking every (n / kMaxBuckets)'th element of the sorted sample: heavily repeated values
+    // occupy proportionally many boundaries.
+    histogram._bounds.reserve(kMaxBuckets);
+    for (size_t i = 0; i < kMaxBuckets; ++i) {
+        histogram._bounds.push_back(sample[(i * sample.size()) / kMaxBuckets]);
+    }
+    return histogram;
+}
+
+double FieldHistogram::estimateSelectivity(const BSONElement& start,
+                                           bool startInclusive,
+                                           const BSONElement& end,
+                                           bool endInclusive) const {
+    if (_bounds.empty()) {
+        return 1.0;
+    }
+
+    // Index of the first boundary inside the interval.
+    size_t lo = std::distance(_bounds.begin(),
+                              std::partition_point(_bounds.begin(),
+                                                   _bounds.end(),
+                                                   [&start, startInclusive](const BSONObj& bound) {
+                                                       int cmp = bound.firstElement().woCompare(
+                                                           start, false);
+                                                       return startInclusive ? cmp < 0 : cmp <= 0;
+                                                   }));
+
+    // Index one past the last boundary inside the interval.
+    size_t hi = std::distance(_bounds.begin(),
+                              std::partition_point(_bounds.begin(),
+                                                   _bounds.end(),
+                                                   [&end, endInclusive](const BSONObj& bound) {
+                                                       int cmp =
+                                                           bound.firstElement().woCompare(end,
+                                                                                          false);
+                                                       return endInclusive ? cmp <= 0 : cmp < 0;
+                                                   }));
+
+    if (hi <= lo) {
+        // No boundary landed inside the interval.  The interval may still match documents that
+        // fell between boundaries, so report one bucket's worth rather than zero; with zero, a
+        // wildly non-selective rival could tie with a near-perfect index.
+        return 1.0 / (_bounds.size() + 1);
+    }
+
+    return static_cast<double>(hi - lo) / _bounds.size();
+}
+
+CollectionStatsStore* CollectionStatsStore::get() {
+    static CollectionStatsStore* store = new CollectionStatsStore();
+    return store;
+}
+
+void CollectionStatsStore::update(StringData ns,
+                                  std::shared_ptr<const FieldHistogramMap> histograms) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!histograms || histograms->empty()) {
+        _statsByNs.erase(ns.toString());
+        return;
+    }
+    _statsByNs[ns.toString()] = std::move(histograms);
+}
+
+std::shared_ptr<const FieldHistogramMap> CollectionStatsStore::getStats(StringData ns) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    StringMap<std::shared_ptr<const FieldHistogramMap>>::const_iterator it = _statsByNs.find(ns);
+    if (it == _statsByNs.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void CollectionStatsStore::clear(StringData ns) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _statsByNs.erase(ns.toString());
+}
+
+}  // namespace mongo
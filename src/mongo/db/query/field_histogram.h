@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * An equi-height histogram over sampled values of a single field.
+ *
+ * Built from a random sample of documents by the background statistics sampler, and consulted
+ * by the planner to estimate what fraction of a collection falls inside an index bounds
+ * interval.  Estimates are approximate: they are only as good as the sample, and multikey
+ * (array) values are counted once per document rather than once per array element.  That is
+ * good enough for the planner's purpose, which is ranking candidate plans rather than
+ * computing exact cardinalities.
+ */
+class FieldHistogram {
+public:
+    /**
+     * Number of bucket boundaries retained from the sample.  More boundaries give finer
+     * selectivity resolution at a small memory cost per indexed field.
+     */
+    static const size_t kMaxBuckets;
+
+    /**
+     * Builds a histogram from an unsorted sample.  Each element of 'sample' must be a
+     * single-element BSONObj owning its storage; field names are ignored when ordering
+     * values.  An empty sample produces a histogram whose estimates are always 1.
+     */
+    static FieldHistogram make(std::vector<BSONObj> sample);
+
+    /**
+     * Constructs an empty histogram, whose estimates are always 1.  Use make() to build a
+     * useful one from a sample.
+     */
+    FieldHistogram() = default;
+
+    /**
+     * Estimates the fraction of values falling between 'start' and 'end', which must be
+     * ordered per BSONElement::woCompare() with field names ignored.  Returns a value in
+     * [0, 1].  Point predicates are expressed as start == end with both bounds inclusive.
+     */
+    double estimateSelectivity(const BSONElement& start,
+                               bool startInclusive,
+                               const BSONElement& end,
+                               bool endInclusive) const;
+
+    /**
+     * Number of sampled values this histogram was built from.
+     */
+    size_t sampleSize() const {
+        return _sampleSize;
+    }
+
+private:
+    // Bucket boundaries taken at evenly spaced quantiles of the sorted sample.  Each is a
+    // single-element BSONObj owning its storage.
+    std::vector<BSONObj> _bounds;
+
+    size_t _sampleSize = 0;
+};
+
+typedef StringMap<FieldHistogram> FieldHistogramMap;
+
+/**
+ * Process-global registry of sampled field statistics, keyed by namespace.
+ *
+ * The background statistics sampler replaces a namespace's histogram map wholesale after each
+ * sampling pass; the planner reads a snapshot via getStats().  Snapshots are shared_ptrs to
+ * immutable maps, so readers are never invalidated by a concurrent refresh.
+ */
+class CollectionStatsStore {
+public:
+    static CollectionStatsStore* get();
+
+    /**
+     * Replaces the histograms for 'ns'.  Passing an empty map is equivalent to clear().
+     */
+    void update(StringData ns, std::shared_ptr<const FieldHistogramMap> histograms);
+
+    /**
+     * Returns the current histograms for 'ns', or nullptr if none have been collected.
+     */
+    std::shared_ptr<const FieldHistogramMap> getStats(StringData ns) const;
+
+    /**
+     * Discards any histograms for 'ns'.  Called when the collection is found to be gone.
+     */
+    void clear(StringData ns);
+
+private:
+    mutable stdx::mutex _mutex;
+    StringMap<std::shared_ptr<const FieldHistogramMap>> _statsByNs;
+};
+
+}  // namespace mongo
@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/field_histogram.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+
+BSONObj sampleValue(int value) {
+    BSONObjBuilder bob;
+    bob.append("", value);
+    return bob.obj();
+}
+
+TEST(FieldHistogramTest, EmptyHistogramEstimatesOne) {
+    FieldHistogram histogram;
+    BSONObj lo = sampleValue(0);
+    BSONObj hi = sampleValue(100);
+    ASSERT_EQUALS(
+        1.0, histogram.estimateSelectivity(lo.firstElement(), true, hi.firstElement(), true));
+}
+
+TEST(FieldHistogramTest, UniformSampleEstimatesRangeFraction) {
+    std::vector<BSONObj> sample;
+    for (int i = 0; i < 1000; ++i) {
+        sample.push_back(sampleValue(i));
+    }
+    FieldHistogram histogram = FieldHistogram::make(std::move(sample));
+    ASSERT_EQUALS(1000U, histogram.sampleSize());
+
+    // A tenth of the domain should estimate near 0.1.
+    BSONObj lo = sampleValue(100);
+    BSONObj hi = sampleValue(200);
+    double estimate =
+        histogram.estimateSelectivity(lo.firstElement(), true, hi.firstElement(), false);
+    ASSERT_APPROX_EQUAL(0.1, estimate, 0.05);
+
+    // The full domain should estimate near 1.
+    BSONObj min = sampleValue(0);
+    BSONObj max = sampleValue(999);
+    ASSERT_APPROX_EQUAL(
+        1.0,
+        histogram.estimateSelectivity(min.firstElement(), true, max.firstElement(), true),
+        0.05);
+}
+
+TEST(FieldHistogramTest, IntervalOutsideSampleEstimatesNearZeroButNotZero) {
+    std::vector<BSONObj> sample;
+    for (int i = 0; i < 1000; ++i) {
+        sample.push_back(sampleValue(i));
+    }
+    FieldHistogram histogram = FieldHistogram::make(std::move(sample));
+
+    BSONObj lo = sampleValue(5000);
+    BSONObj hi = sampleValue(6000);
+    double estimate =
+        histogram.estimateSelectivity(lo.firstElement(), true, hi.firstElement(), true);
+    ASSERT_GREATER_THAN(estimate, 0.0);
+    ASSERT_LESS_THAN(estimate, 0.05);
+}
+
+TEST(FieldHistogramTest, HeavilyRepeatedValueDominatesPointEstimate) {
+    std::vector<BSONObj> sample;
+    for (int i = 0; i < 900; ++i) {
+        sample.push_back(sampleValue(5));
+    }
+    for (int i = 0; i < 100; ++i) {
+        sample.push_back(sampleValue(1000 + i));
+    }
+    FieldHistogram histogram = FieldHistogram::make(std::move(sample));
+
+    BSONObj point = sampleValue(5);
+    double estimate =
+        histogram.estimateSelectivity(point.firstElement(), true, point.firstElement(), true);
+    ASSERT_GREATER_THAN(estimate, 0.5);
+}
+
+TEST(CollectionStatsStoreTest, UpdateGetAndClear) {
+    CollectionStatsStore* store = CollectionStatsStore::get();
+    const char* ns = "field_histogram_test.coll";
+
+    ASSERT_FALSE(store->getStats(ns));
+
+    std::vector<BSONObj> sample;
+    for (int i = 0; i < 100; ++i) {
+        sample.push_back(sampleValue(i));
+    }
+    auto histograms = std::make_shared<FieldHistogramMap>();
+    (*histograms)["a"] = FieldHistogram::make(std::move(sample));
+    store->update(ns, histograms);
+
+    std::shared_ptr<const FieldHistogramMap> stats = store->getStats(ns);
+    ASSERT_TRUE(stats);
+    ASSERT_EQUALS(1U, stats->size());
+    ASSERT_EQUALS(100U, stats->find("a")->second.sampleSize());
+
+    store->clear(ns);
+    ASSERT_FALSE(store->getStats(ns));
+}
+
+}  // namespace
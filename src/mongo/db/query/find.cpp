@@ -406,10 +406,9 @@ Message getMore(OperationContext* opCtx,
         exec->reattachToOperationContext(opCtx);
         exec->restoreState();
 
-        auto planSummary = Explain::getPlanSummary(exec);
         {
             stdx::lock_guard<Client> lk(*opCtx->getClient());
-            curOp.setPlanSummary_inlock(planSummary);
+            curOp.setPlanSummary_inlock(cc->getPlanSummary());
 
             // Ensure that the original query object is available in the slow query log, profiler
             // and currentOp. Upconvert _query to resemble a getMore command, and set the original
@@ -39,12 +39,15 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
 #include "mongo/client/dbclientinterface.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/count.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/eof.h"
+#include "mongo/db/exec/fetch.h"
 #include "mongo/db/exec/group.h"
 #include "mongo/db/exec/idhack.h"
+#include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/multi_plan.h"
 #include "mongo/db/exec/oplogstart.h"
 #include "mongo/db/exec/projection.h"
@@ -54,6 +57,7 @@
 #include "mongo/db/exec/update.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_names.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
@@ -229,6 +233,49 @@ struct PrepareExecutionResult {
     unique_ptr<PlanStage> root;
 };
 
+/**
+ * Returns the entry in 'plannerParams.indices' describing a single-field unique btree index that
+ * can answer 'query' with a point lookup, or NULL if there is no such index. Queries answerable
+ * this way have exactly one plan, so they can skip QueryPlanner::plan() entirely, much like the
+ * idhack path does for _id queries.
+ */
+const IndexEntry* getSingleFieldUniqueIndexForQuery(const CanonicalQuery& query,
+                                                    const QueryPlannerParams& plannerParams) {
+    // Index filters may deliberately exclude the unique index; defer to the planner.
+    if (plannerParams.indexFiltersApplied) {
+        return NULL;
+    }
+
+    const QueryRequest& qr = query.getQueryRequest();
+    if (!qr.getSort().isEmpty() || !qr.getHint().isEmpty() || !qr.getMin().isEmpty() ||
+        !qr.getMax().isEmpty() || qr.getSkip() || qr.getMaxScan() || qr.showRecordId() ||
+        qr.returnKey() || qr.isSnapshot() || qr.isTailable() || NULL != query.getProj()) {
+        return NULL;
+    }
+
+    if (MatchExpression::EQ != query.root()->matchType()) {
+        return NULL;
+    }
+    const EqualityMatchExpression* eq = static_cast<const EqualityMatchExpression*>(query.root());
+
+    for (size_t i = 0; i < plannerParams.indices.size(); ++i) {
+        const IndexEntry& index = plannerParams.indices[i];
+        if (!index.unique || index.multikey || index.sparse || NULL != index.filterExpr ||
+            INDEX_BTREE != index.type || 1 != index.keyPattern.nFields()) {
+            continue;
+        }
+        if (eq->path() != index.keyPattern.firstElementFieldName()) {
+            continue;
+        }
+        if (!CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+            continue;
+        }
+        return &index;
+    }
+
+    return NULL;
+}
+
 /**
  * Build an execution tree for the query described in 'canonicalQuery'.
  *
@@ -266,6 +313,11 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
     plannerParams.options = plannerOptions;
     fillOutPlannerParams(opCtx, collection, canonicalQuery.get(), &plannerParams);
 
+    // Record the query's shape so that metrics aggregated when the operation completes are
+    // keyed consistently with the plan cache.
+    CurOp::get(opCtx)->debug().queryShapeKey =
+        collection->infoCache()->getPlanCache()->computeKey(*canonicalQuery);
+
     // If the canonical query does not have a user-specified collation, set it from the collection
     // default.
     if (canonicalQuery->getQueryRequest().getCollation().isEmpty() &&
@@ -335,6 +387,49 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         }
     }
 
+    // If the query is an equality against a single-field unique index, there is only one
+    // reasonable plan: a point index scan plus fetch. Dispatch to it directly, skipping the plan
+    // cache and the planner.
+    if (const IndexEntry* uniqueIndex =
+            getSingleFieldUniqueIndexForQuery(*canonicalQuery, plannerParams)) {
+        const EqualityMatchExpression* eq =
+            static_cast<const EqualityMatchExpression*>(canonicalQuery->root());
+
+        OrderedIntervalList oil(eq->path().toString());
+        IndexBoundsBuilder::BoundsTightness tightness;
+        IndexBoundsBuilder::translateEquality(eq->getData(), *uniqueIndex, false, &oil, &tightness);
+
+        // Null and array equalities require a filter on the fetched document; leave those to the
+        // planner.
+        if (IndexBoundsBuilder::EXACT == tightness) {
+            LOG(2) << "Using unique index point lookup: "
+                   << redact(canonicalQuery->toStringShort());
+
+            IndexScanParams params;
+            params.descriptor =
+                collection->getIndexCatalog()->findIndexByName(opCtx, uniqueIndex->name);
+            invariant(params.descriptor);
+            params.bounds.fields.push_back(oil);
+            params.direction = 1;
+            params.doNotDedup = true;
+
+            root = make_unique<FetchStage>(
+                opCtx, ws, new IndexScan(opCtx, params, ws, nullptr), nullptr, collection);
+
+            // Might have to filter out orphaned docs.
+            if (plannerParams.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
+                root = make_unique<ShardFilterStage>(
+                    opCtx,
+                    CollectionShardingState::get(opCtx, canonicalQuery->nss())->getMetadata(),
+                    ws,
+                    root.release());
+            }
+
+            return PrepareExecutionResult(
+                std::move(canonicalQuery), std::move(querySolution), std::move(root));
+        }
+    }
+
     // Try to look up a cached solution for the query.
     CachedSolution* rawCS;
     if (PlanCache::shouldCacheQuery(*canonicalQuery) &&
@@ -550,10 +550,44 @@ void IndexBoundsBuilder::translate(const MatchExpression* expr,
         // Create our various intervals.
 
         IndexBoundsBuilder::BoundsTightness tightness;
-        for (auto&& equality : ime->getEqualities()) {
-            translateEquality(equality, index, isHashed, oilOut, &tightness);
-            if (tightness != IndexBoundsBuilder::EXACT) {
-                *tightnessOut = tightness;
+        if (!index.collator && !isHashed) {
+            // Fast path for plain equalities: synthesize every point bound into one shared
+            // buffer rather than allocating a BSONObj per element. Each interval's handle on
+            // the arena shares its storage, so a large $in list costs a single allocation.
+            // Array equalities still need the multi-interval logic in translateEquality().
+            BSONObjBuilder arenaBob;
+            for (auto&& equality : ime->getEqualities()) {
+                if (Array == equality.type()) {
+                    continue;
+                }
+                arenaBob.appendAs(equality, "");
+                if (equality.isNull()) {
+                    // A null index key does not always match a null query value; see the
+                    // equivalent case in translateEquality().
+                    *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
+                }
+            }
+            const BSONObj arena = arenaBob.obj();
+            BSONObjIterator pointIt(arena);
+            while (pointIt.more()) {
+                oilOut->intervals.push_back(makeSharedPointInterval(arena, pointIt.next()));
+            }
+
+            for (auto&& equality : ime->getEqualities()) {
+                if (Array != equality.type()) {
+                    continue;
+                }
+                translateEquality(equality, index, isHashed, oilOut, &tightness);
+                if (tightness != IndexBoundsBuilder::EXACT) {
+                    *tightnessOut = tightness;
+                }
+            }
+        } else {
+            for (auto&& equality : ime->getEqualities()) {
+                translateEquality(equality, index, isHashed, oilOut, &tightness);
+                if (tightness != IndexBoundsBuilder::EXACT) {
+                    *tightnessOut = tightness;
+                }
             }
         }
 
@@ -588,7 +622,7 @@ void IndexBoundsBuilder::translate(const MatchExpression* expr,
             const S2Region& region = gme->getGeoExpression().getGeometry().getS2Region();
             S2IndexingParams indexParams;
             ExpressionParams::initialize2dsphereParams(index.infoObj, index.collator, &indexParams);
-            ExpressionMapping::cover2dsphere(region, indexParams, oilOut);
+            ExpressionMapping::cover2dsphereCached(gme->getRawObj(), region, indexParams, oilOut);
             *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
         } else if (mongoutils::str::equals("2d", elt.valuestrsafe())) {
             verify(gme->getGeoExpression().getGeometry().hasR2Region());
@@ -743,6 +777,17 @@ Interval IndexBoundsBuilder::makePointInterval(const BSONObj& obj) {
     return ret;
 }
 
+// static
+Interval IndexBoundsBuilder::makeSharedPointInterval(const BSONObj& arena, const BSONElement& pt) {
+    dassert(arena.isOwned());
+    Interval ret;
+    // Shares the arena's refcounted buffer; no per-interval copy of the value.
+    ret._intervalData = arena;
+    ret.startInclusive = ret.endInclusive = true;
+    ret.start = ret.end = pt;
+    return ret;
+}
+
 // static
 Interval IndexBoundsBuilder::makePointInterval(const string& str) {
     BSONObjBuilder bob;
@@ -817,7 +862,15 @@ void IndexBoundsBuilder::translateEquality(const BSONElement& data,
     if (Array != data.type()) {
         BSONObj dataObj = objFromElement(data, index.collator);
         if (isHashed) {
-            dataObj = ExpressionMapping::hash(dataObj.firstElement());
+            const int hashVersion = index.infoObj["hashVersion"].numberInt();
+            if (hashVersion == 0) {
+                // Version-0 bounds have always hashed with the default seed, even for the
+                // (deprecated) nonzero-seed indexes; preserve that.
+                dataObj = ExpressionMapping::hash(dataObj.firstElement());
+            } else {
+                dataObj = ExpressionMapping::hash(
+                    dataObj.firstElement(), index.infoObj["seed"].numberInt(), hashVersion);
+            }
         }
 
         verify(dataObj.isOwned());
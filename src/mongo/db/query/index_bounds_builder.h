@@ -125,6 +125,14 @@ public:
     static Interval makePointInterval(const std::string& str);
     static Interval makePointInterval(double d);
 
+    /**
+     * Make a point interval over 'pt', which must point into the owned object 'arena'.  The
+     * interval shares ownership of 'arena' rather than copying the value into a buffer of its
+     * own, so many point intervals (e.g. from a large $in list) can be carved out of a single
+     * allocation.
+     */
+    static Interval makeSharedPointInterval(const BSONObj& arena, const BSONElement& pt);
+
     /**
      * Wraps 'elt' in a BSONObj with an empty field name and returns the result. If 'elt' is a
      * string, and 'collator' is non-null, the result contains the collator-generated comparison key
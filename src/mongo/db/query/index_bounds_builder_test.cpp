@@ -557,6 +557,29 @@ TEST(IndexBoundsBuilderTest, TranslateInArray) {
     ASSERT_EQUALS(tightness, IndexBoundsBuilder::INEXACT_FETCH);
 }
 
+TEST(IndexBoundsBuilderTest, TranslateInSharesOneBufferAcrossPointIntervals) {
+    IndexEntry testIndex = IndexEntry(BSONObj());
+    BSONObj obj = fromjson("{a: {$in: [1, 2, 3, 4]}}");
+    unique_ptr<MatchExpression> expr(parseMatchExpression(obj));
+    BSONElement elt = obj.firstElement();
+    OrderedIntervalList oil;
+    IndexBoundsBuilder::BoundsTightness tightness;
+    IndexBoundsBuilder::translate(expr.get(), elt, testIndex, &oil, &tightness);
+    ASSERT_EQUALS(oil.name, "a");
+    ASSERT_EQUALS(oil.intervals.size(), 4U);
+    for (size_t i = 0; i < oil.intervals.size(); ++i) {
+        ASSERT_EQUALS(Interval::INTERVAL_EQUALS,
+                      oil.intervals[i].compare(Interval(
+                          BSON("" << static_cast<int>(i + 1) << "" << static_cast<int>(i + 1)),
+                          true,
+                          true)));
+        // All the point intervals are carved out of the same arena buffer.
+        ASSERT_EQUALS(oil.intervals[i]._intervalData.objdata(),
+                      oil.intervals[0]._intervalData.objdata());
+    }
+    ASSERT_EQUALS(tightness, IndexBoundsBuilder::EXACT);
+}
+
 TEST(IndexBoundsBuilderTest, TranslateLteBinData) {
     IndexEntry testIndex = IndexEntry(BSONObj());
     BSONObj obj = fromjson(
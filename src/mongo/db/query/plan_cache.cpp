@@ -45,6 +45,7 @@
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_solution.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -385,6 +386,11 @@ PlanCacheEntry::PlanCacheEntry(const std::vector<QuerySolution*>& solutions,
     }
 }
 
+PlanCacheEntry::PlanCacheEntry(std::vector<SolutionCacheData*> data, PlanRankingDecision* why)
+    : plannerData(std::move(data)), decision(why) {
+    invariant(why);
+}
+
 PlanCacheEntry::~PlanCacheEntry() {
     for (size_t i = 0; i < feedback.size(); ++i) {
         delete feedback[i];
@@ -530,12 +536,29 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
-PlanCache::PlanCache() : _cache(internalQueryCacheSize.load()) {}
+const size_t PlanCache::kNumPartitions = 16;
+
+PlanCache::PlanCache() : PlanCache("") {}
 
-PlanCache::PlanCache(const std::string& ns) : _cache(internalQueryCacheSize.load()), _ns(ns) {}
+PlanCache::PlanCache(const std::string& ns)
+    : _branchDecisions(internalQueryCacheSize.load()), _ns(ns) {
+    // The configured cache size is divided evenly among the partitions, rounding up so the
+    // total capacity is never below the knob's value.
+    const size_t totalSize = static_cast<size_t>(internalQueryCacheSize.load());
+    const size_t partitionSize = (totalSize + kNumPartitions - 1) / kNumPartitions;
+
+    _partitions.reserve(kNumPartitions);
+    for (size_t i = 0; i < kNumPartitions; ++i) {
+        _partitions.push_back(stdx::make_unique<Partition>(partitionSize));
+    }
+}
 
 PlanCache::~PlanCache() {}
 
+PlanCache::Partition& PlanCache::partitionFor(const PlanCacheKey& key) const {
+    return *_partitions[std::hash<PlanCacheKey>()(key) % kNumPartitions];
+}
+
 /**
  * Traverses expression tree pre-order.
  * Appends an encoding of each node's match type and path name
@@ -709,9 +732,262 @@ Status PlanCache::add(const CanonicalQuery& query,
     }
     entry->projection = projBuilder.obj();
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(computeKey(query), entry);
+    PlanCacheKey key = computeKey(query);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(key, entry);
+
+    if (NULL != evictedEntry.get()) {
+        LOG(1) << _ns << ": plan cache maximum size exceeded - "
+               << "removed least recently used entry " << redact(evictedEntry->toString());
+    }
+
+    return Status::OK();
+}
+
+namespace {
+
+/**
+ * Appends the serialized form of 'tree' to 'bob'. Index assignments are recorded by index
+ * name and resolved against the live index catalog on reload.
+ */
+void indexTreeToBSON(const PlanCacheIndexTree* tree, BSONObjBuilder* bob) {
+    if (tree->entry) {
+        bob->append("index", tree->entry->name);
+    }
+    bob->appendNumber("indexPos", static_cast<long long>(tree->index_pos));
+    bob->appendBool("canCombineBounds", tree->canCombineBounds);
+
+    if (!tree->orPushdowns.empty()) {
+        BSONArrayBuilder pushdowns(bob->subarrayStart("orPushdowns"));
+        for (const auto& orPushdown : tree->orPushdowns) {
+            BSONObjBuilder pushdownBob(pushdowns.subobjStart());
+            pushdownBob.append("indexName", orPushdown.indexName);
+            pushdownBob.appendNumber("position", static_cast<long long>(orPushdown.position));
+            pushdownBob.appendBool("canCombineBounds", orPushdown.canCombineBounds);
+            BSONArrayBuilder route(pushdownBob.subarrayStart("route"));
+            for (size_t step : orPushdown.route) {
+                route.append(static_cast<long long>(step));
+            }
+        }
+    }
+
+    if (!tree->children.empty()) {
+        BSONArrayBuilder children(bob->subarrayStart("children"));
+        for (const PlanCacheIndexTree* child : tree->children) {
+            BSONObjBuilder childBob(children.subobjStart());
+            indexTreeToBSON(child, &childBob);
+        }
+    }
+}
+
+StatusWith<std::unique_ptr<PlanCacheIndexTree>> indexTreeFromBSON(
+    const BSONObj& obj, const std::vector<IndexEntry>& indexEntries) {
+    auto tree = stdx::make_unique<PlanCacheIndexTree>();
+
+    BSONElement indexElt = obj["index"];
+    if (!indexElt.eoo()) {
+        if (indexElt.type() != String) {
+            return Status(ErrorCodes::BadValue,
+                          "index tree 'index' field must be a string");
+        }
+        const IndexEntry* found = nullptr;
+        for (const auto& indexEntry : indexEntries) {
+            if (indexEntry.name == indexElt.valueStringData()) {
+                found = &indexEntry;
+                break;
+            }
+        }
+        if (!found) {
+            return Status(ErrorCodes::NoSuchKey,
+                          str::stream() << "index " << indexElt.String()
+                                        << " no longer exists");
+        }
+        tree->setIndexEntry(*found);
+    }
+
+    tree->index_pos = static_cast<size_t>(obj["indexPos"].numberLong());
+    tree->canCombineBounds = obj["canCombineBounds"].trueValue();
+
+    BSONElement pushdownsElt = obj["orPushdowns"];
+    if (!pushdownsElt.eoo()) {
+        if (pushdownsElt.type() != Array) {
+            return Status(ErrorCodes::BadValue, "'orPushdowns' must be an array");
+        }
+        for (auto&& pushdownElt : pushdownsElt.Obj()) {
+            if (!pushdownElt.isABSONObj()) {
+                return Status(ErrorCodes::BadValue, "'orPushdowns' elements must be objects");
+            }
+            BSONObj pushdownObj = pushdownElt.Obj();
+            PlanCacheIndexTree::OrPushdown orPushdown;
+            orPushdown.indexName = pushdownObj["indexName"].str();
+            orPushdown.position = static_cast<size_t>(pushdownObj["position"].numberLong());
+            orPushdown.canCombineBounds = pushdownObj["canCombineBounds"].trueValue();
+            BSONElement routeElt = pushdownObj["route"];
+            if (routeElt.type() == Array) {
+                for (auto&& step : routeElt.Obj()) {
+                    orPushdown.route.push_back(static_cast<size_t>(step.numberLong()));
+                }
+            }
+            tree->orPushdowns.push_back(std::move(orPushdown));
+        }
+    }
+
+    BSONElement childrenElt = obj["children"];
+    if (!childrenElt.eoo()) {
+        if (childrenElt.type() != Array) {
+            return Status(ErrorCodes::BadValue, "'children' must be an array");
+        }
+        for (auto&& childElt : childrenElt.Obj()) {
+            if (!childElt.isABSONObj()) {
+                return Status(ErrorCodes::BadValue, "'children' elements must be objects");
+            }
+            auto childStatus = indexTreeFromBSON(childElt.Obj(), indexEntries);
+            if (!childStatus.isOK()) {
+                return childStatus.getStatus();
+            }
+            tree->children.push_back(childStatus.getValue().release());
+        }
+    }
+
+    return std::move(tree);
+}
+
+BSONObj solutionCacheDataToBSON(const SolutionCacheData& scd) {
+    BSONObjBuilder bob;
+    bob.append("solnType", static_cast<int>(scd.solnType));
+    bob.append("wholeIXSolnDir", scd.wholeIXSolnDir);
+    bob.appendBool("indexFilterApplied", scd.indexFilterApplied);
+    if (scd.tree) {
+        BSONObjBuilder treeBob(bob.subobjStart("tree"));
+        indexTreeToBSON(scd.tree.get(), &treeBob);
+    }
+    return bob.obj();
+}
+
+StatusWith<std::unique_ptr<SolutionCacheData>> solutionCacheDataFromBSON(
+    const BSONObj& obj, const std::vector<IndexEntry>& indexEntries) {
+    const int solnType = obj["solnType"].numberInt();
+    if (solnType < SolutionCacheData::WHOLE_IXSCAN_SOLN ||
+        solnType > SolutionCacheData::USE_INDEX_TAGS_SOLN) {
+        return Status(ErrorCodes::BadValue, "unrecognized 'solnType'");
+    }
+
+    auto scd = stdx::make_unique<SolutionCacheData>();
+    scd->solnType = static_cast<SolutionCacheData::SolutionType>(solnType);
+    scd->wholeIXSolnDir = obj["wholeIXSolnDir"].numberInt();
+    scd->indexFilterApplied = obj["indexFilterApplied"].trueValue();
+
+    BSONElement treeElt = obj["tree"];
+    if (!treeElt.eoo()) {
+        if (!treeElt.isABSONObj()) {
+            return Status(ErrorCodes::BadValue, "'tree' must be an object");
+        }
+        auto treeStatus = indexTreeFromBSON(treeElt.Obj(), indexEntries);
+        if (!treeStatus.isOK()) {
+            return treeStatus.getStatus();
+        }
+        scd->tree = std::move(treeStatus.getValue());
+    } else if (SolutionCacheData::COLLSCAN_SOLN != scd->solnType) {
+        return Status(ErrorCodes::BadValue, "missing 'tree' for an indexed solution");
+    }
+
+    return std::move(scd);
+}
+
+}  // namespace
+
+std::vector<BSONObj> PlanCache::serializeEntries() const {
+    std::vector<BSONObj> serialized;
+    typedef std::list<std::pair<PlanCacheKey, PlanCacheEntry*>>::const_iterator ConstIterator;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        for (ConstIterator i = partition->cache.begin(); i != partition->cache.end(); i++) {
+            const PlanCacheEntry* entry = i->second;
+            invariant(!entry->decision->stats.empty());
+
+            BSONObjBuilder bob;
+            bob.append("query", entry->query);
+            bob.append("sort", entry->sort);
+            bob.append("projection", entry->projection);
+            bob.append("collation", entry->collation);
+            bob.appendNumber("works",
+                             static_cast<long long>(entry->decision->stats[0]->common.works));
+            {
+                BSONArrayBuilder scores(bob.subarrayStart("scores"));
+                for (double score : entry->decision->scores) {
+                    scores.append(score);
+                }
+            }
+            {
+                BSONArrayBuilder plans(bob.subarrayStart("plannerData"));
+                for (const SolutionCacheData* scd : entry->plannerData) {
+                    plans.append(solutionCacheDataToBSON(*scd));
+                }
+            }
+            serialized.push_back(bob.obj());
+        }
+    }
+    return serialized;
+}
 
+Status PlanCache::loadSerializedEntry(const PlanCacheKey& key,
+                                      const BSONObj& serialized,
+                                      const std::vector<IndexEntry>& indexEntries) {
+    BSONElement plansElt = serialized["plannerData"];
+    if (plansElt.type() != Array) {
+        return Status(ErrorCodes::BadValue,
+                      "serialized plan cache entry is missing 'plannerData'");
+    }
+
+    OwnedPointerVector<SolutionCacheData> solutions;
+    for (auto&& planElt : plansElt.Obj()) {
+        if (!planElt.isABSONObj()) {
+            return Status(ErrorCodes::BadValue, "'plannerData' elements must be objects");
+        }
+        auto scdStatus = solutionCacheDataFromBSON(planElt.Obj(), indexEntries);
+        if (!scdStatus.isOK()) {
+            return scdStatus.getStatus();
+        }
+        solutions.push_back(scdStatus.getValue().release());
+    }
+    if (solutions.empty()) {
+        return Status(ErrorCodes::BadValue,
+                      "serialized plan cache entry must contain at least one plan");
+    }
+
+    // Synthesize a ranking decision carrying the works value the original multi-plan trial
+    // recorded. CachedPlanStage reads it (through CachedSolution::decisionWorks) as its
+    // replanning threshold, so it must survive the round trip.
+    auto why = stdx::make_unique<PlanRankingDecision>();
+    CommonStats commonStats("MULTI_PLAN");
+    commonStats.works = static_cast<size_t>(serialized["works"].numberLong());
+    why->stats.push_back(stdx::make_unique<PlanStageStats>(commonStats, STAGE_MULTI_PLAN));
+    BSONElement scoresElt = serialized["scores"];
+    if (scoresElt.type() == Array) {
+        for (auto&& scoreElt : scoresElt.Obj()) {
+            why->scores.push_back(scoreElt.numberDouble());
+        }
+    }
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        why->candidateOrder.push_back(i);
+    }
+
+    auto entry = stdx::make_unique<PlanCacheEntry>(solutions.release(), why.release());
+    entry->query = serialized["query"].isABSONObj() ? serialized["query"].Obj().getOwned()
+                                                    : BSONObj();
+    entry->sort = serialized["sort"].isABSONObj() ? serialized["sort"].Obj().getOwned()
+                                                  : BSONObj();
+    entry->projection = serialized["projection"].isABSONObj()
+        ? serialized["projection"].Obj().getOwned()
+        : BSONObj();
+    entry->collation = serialized["collation"].isABSONObj()
+        ? serialized["collation"].Obj().getOwned()
+        : BSONObj();
+
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(key, entry.release());
     if (NULL != evictedEntry.get()) {
         LOG(1) << _ns << ": plan cache maximum size exceeded - "
                << "removed least recently used entry " << redact(evictedEntry->toString());
@@ -724,9 +1000,10 @@ Status PlanCache::get(const CanonicalQuery& query, CachedSolution** crOut) const
     PlanCacheKey key = computeKey(query);
     verify(crOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -744,9 +1021,10 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
     std::unique_ptr<PlanCacheEntryFeedback> autoFeedback(feedback);
     PlanCacheKey ck = computeKey(cq);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = partitionFor(ck);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(ck, &entry);
+    Status cacheStatus = partition.cache.get(ck, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -761,13 +1039,44 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    PlanCacheKey key = computeKey(canonicalQuery);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    return partition.cache.remove(key);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        partition->cache.clear();
+    }
+    stdx::lock_guard<stdx::mutex> branchLock(_branchDecisionsMutex);
+    _branchDecisions.clear();
+}
+
+void PlanCache::addBranchDecision(const CanonicalQuery& query, const SolutionCacheData& cacheData) {
+    invariant(SolutionCacheData::USE_INDEX_TAGS_SOLN == cacheData.solnType);
+    const PlanCacheKey key = computeKey(query);
+
+    stdx::lock_guard<stdx::mutex> lk(_branchDecisionsMutex);
+    std::unique_ptr<SolutionCacheData> evictedDecision =
+        _branchDecisions.add(key, cacheData.clone());
+    if (evictedDecision.get()) {
+        LOG(1) << _ns << ": subplan branch cache maximum size exceeded - "
+               << "removed least recently used entry";
+    }
+}
+
+std::unique_ptr<SolutionCacheData> PlanCache::getBranchDecision(const CanonicalQuery& query) const {
+    const PlanCacheKey key = computeKey(query);
+
+    stdx::lock_guard<stdx::mutex> lk(_branchDecisionsMutex);
+    SolutionCacheData* cacheData;
+    Status status = _branchDecisions.get(key, &cacheData);
+    if (!status.isOK()) {
+        return nullptr;
+    }
+    return std::unique_ptr<SolutionCacheData>(cacheData->clone());
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -782,9 +1091,10 @@ Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOu
     PlanCacheKey key = computeKey(query);
     verify(entryOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(key, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -796,25 +1106,33 @@ Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOu
 }
 
 std::vector<PlanCacheEntry*> PlanCache::getAllEntries() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     std::vector<PlanCacheEntry*> entries;
     typedef std::list<std::pair<PlanCacheKey, PlanCacheEntry*>>::const_iterator ConstIterator;
-    for (ConstIterator i = _cache.begin(); i != _cache.end(); i++) {
-        PlanCacheEntry* entry = i->second;
-        entries.push_back(entry->clone());
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        for (ConstIterator i = partition->cache.begin(); i != partition->cache.end(); i++) {
+            PlanCacheEntry* entry = i->second;
+            entries.push_back(entry->clone());
+        }
     }
 
     return entries;
 }
 
 bool PlanCache::contains(const CanonicalQuery& cq) const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.hasKey(computeKey(cq));
+    PlanCacheKey key = computeKey(cq);
+    Partition& partition = partitionFor(key);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    return partition.cache.hasKey(key);
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t total = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        total += partition->cache.size();
+    }
+    return total;
 }
 
 void PlanCache::notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries) {
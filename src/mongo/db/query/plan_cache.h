@@ -29,7 +29,9 @@
 #pragma once
 
 #include <boost/optional/optional.hpp>
+#include <memory>
 #include <set>
+#include <vector>
 
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/query/canonical_query.h"
@@ -239,6 +241,13 @@ public:
      */
     PlanCacheEntry(const std::vector<QuerySolution*>& solutions, PlanRankingDecision* why);
 
+    /**
+     * Create a PlanCacheEntry directly from planner data, without the solutions it was
+     * originally derived from. Used when reloading entries that were serialized before a
+     * restart. Takes ownership of both the SolutionCacheData pointers and 'why'.
+     */
+    PlanCacheEntry(std::vector<SolutionCacheData*> data, PlanRankingDecision* why);
+
     ~PlanCacheEntry();
 
     /**
@@ -410,15 +419,79 @@ public:
      */
     void notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries);
 
+    /**
+     * Serializes every entry into a BSON document suitable for reloading into a fresh cache
+     * via loadSerializedEntry() after a restart. Each document is self-contained: it carries
+     * the entry's exemplar query (so the caller can recompute its cache key), the winning
+     * plans' index assignments by index name, and enough of the ranking decision to preserve
+     * the replanning works threshold.
+     */
+    std::vector<BSONObj> serializeEntries() const;
+
+    /**
+     * Recreates the entry serialized in 'serialized' and adds it to the cache under 'key'.
+     * Index assignments are resolved by name against 'indexEntries'.
+     *
+     * Returns a non-OK status, and adds nothing, if the document is malformed or references
+     * an index that no longer exists.
+     */
+    Status loadSerializedEntry(const PlanCacheKey& key,
+                               const BSONObj& serialized,
+                               const std::vector<IndexEntry>& indexEntries);
+
+    /**
+     * Records the winning index assignment for a single $or branch, keyed by the branch's
+     * shape.  Used by the SubplanStage so that later subplanned queries can assemble a
+     * composite plan without planning the branch again.  'cacheData' must describe an
+     * indexed (USE_INDEX_TAGS_SOLN) solution; the cache stores a copy.
+     */
+    void addBranchDecision(const CanonicalQuery& query, const SolutionCacheData& cacheData);
+
+    /**
+     * Looks up a branch decision previously recorded via addBranchDecision().  Returns
+     * nullptr on a miss.  The caller owns the returned copy.
+     */
+    std::unique_ptr<SolutionCacheData> getBranchDecision(const CanonicalQuery& query) const;
+
 private:
     void encodeKeyForMatch(const MatchExpression* tree, StringBuilder* keyBuilder) const;
     void encodeKeyForSort(const BSONObj& sortObj, StringBuilder* keyBuilder) const;
     void encodeKeyForProj(const BSONObj& projObj, StringBuilder* keyBuilder) const;
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry> _cache;
+    /**
+     * One shard of the cache. Entries are assigned to a partition by hashing their
+     * PlanCacheKey, so lookups for distinct query shapes rarely contend on the same mutex.
+     * A cache hit takes only the one partition's lock; the previous design funnelled every
+     * get() through a single cache-wide mutex.
+     */
+    struct Partition {
+        Partition(size_t maxSize) : cache(maxSize) {}
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry> cache;
+
+        // Protects 'cache'.
+        mutable stdx::mutex mutex;
+    };
+
+    static const size_t kNumPartitions;
+
+    /**
+     * Returns the partition responsible for 'key'.
+     */
+    Partition& partitionFor(const PlanCacheKey& key) const;
+
+    // The partitioned LRU store. The vector is sized once in the constructor and never
+    // resized, so accessing distinct partitions concurrently is safe without further
+    // synchronization.
+    std::vector<std::unique_ptr<Partition>> _partitions;
+
+    // Winning index assignments for individual $or branches, maintained by the SubplanStage.
+    // Kept apart from the main entry table because branch decisions carry no ranking
+    // statistics and must never satisfy top-level cached-plan lookups.
+    LRUKeyValue<PlanCacheKey, SolutionCacheData> _branchDecisions;
 
-    // Protects _cache.
-    mutable stdx::mutex _cacheMutex;
+    // Protects '_branchDecisions'.
+    mutable stdx::mutex _branchDecisionsMutex;
 
     // Full namespace of collection.
     std::string _ns;
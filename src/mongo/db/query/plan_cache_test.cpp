@@ -423,6 +423,66 @@ TEST(PlanCacheTest, AddValidSolution) {
     ASSERT_EQUALS(planCache.size(), 1U);
 }
 
+TEST(PlanCacheTest, SerializedEntryRoundTrips) {
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+
+    std::vector<IndexEntry> indexEntries;
+    indexEntries.push_back(IndexEntry(BSON("a" << 1), "a_1"));
+
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    qs.cacheData->tree->setIndexEntry(indexEntries[0]);
+    std::vector<QuerySolution*> solns;
+    solns.push_back(&qs);
+    ASSERT_OK(planCache.add(*cq, solns, createDecision(1U)));
+
+    std::vector<BSONObj> serialized = planCache.serializeEntries();
+    ASSERT_EQUALS(serialized.size(), 1U);
+
+    // The reloaded entry must be retrievable under the same key and describe the same plan.
+    PlanCache reloadedCache;
+    const PlanCacheKey key = reloadedCache.computeKey(*cq);
+    ASSERT_OK(reloadedCache.loadSerializedEntry(key, serialized[0], indexEntries));
+    ASSERT_TRUE(reloadedCache.contains(*cq));
+
+    CachedSolution* rawCachedSoln;
+    ASSERT_OK(reloadedCache.get(*cq, &rawCachedSoln));
+    unique_ptr<CachedSolution> cachedSoln(rawCachedSoln);
+    ASSERT_EQUALS(cachedSoln->plannerData.size(), 1U);
+    ASSERT_EQUALS(cachedSoln->plannerData[0]->toString(), qs.cacheData->toString());
+
+    // An entry referencing an index that no longer exists must be rejected.
+    PlanCache emptyIndexCache;
+    ASSERT_NOT_OK(
+        emptyIndexCache.loadSerializedEntry(key, serialized[0], std::vector<IndexEntry>()));
+    ASSERT_FALSE(emptyIndexCache.contains(*cq));
+}
+
+TEST(PlanCacheTest, BranchDecisionRoundTrip) {
+    PlanCache planCache;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+
+    SolutionCacheData cacheData;
+    cacheData.solnType = SolutionCacheData::USE_INDEX_TAGS_SOLN;
+    cacheData.tree.reset(new PlanCacheIndexTree());
+    cacheData.tree->setIndexEntry(IndexEntry(BSON("a" << 1), "a_1"));
+
+    // Branch decisions are looked up by shape and returned as copies.
+    ASSERT_FALSE(planCache.getBranchDecision(*cq));
+    planCache.addBranchDecision(*cq, cacheData);
+    std::unique_ptr<SolutionCacheData> found = planCache.getBranchDecision(*cq);
+    ASSERT_TRUE(found);
+    ASSERT_EQUALS(found->toString(), cacheData.toString());
+
+    // Branch decisions must not satisfy regular cached-plan lookups, and clear() must drop
+    // them along with the main entries.
+    ASSERT_FALSE(planCache.contains(*cq));
+    planCache.clear();
+    ASSERT_FALSE(planCache.getBranchDecision(*cq));
+}
+
 /**
  * Each test in the CachePlanSelectionTest suite goes through
  * the following flow:
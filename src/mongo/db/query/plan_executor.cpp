@@ -71,6 +71,10 @@ namespace {
 MONGO_FP_DECLARE(planExecutorAlwaysFails);
 }  // namespace
 
+// How many units of work to ask of the root stage at a time when the caller is discarding the
+// results. The time-based yield policy is still consulted between batches.
+const size_t kDiscardResultsBatchSize = 64;
+
 /**
  * Retrieves the first stage of a given type from the plan tree, or NULL
  * if no such stage is found.
@@ -433,7 +437,9 @@ bool PlanExecutor::waitForInserts() {
     return yieldResult;
 }
 
-PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut, RecordId* dlOut) {
+PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
+                                                  RecordId* dlOut,
+                                                  bool discardResults) {
     if (MONGO_FAIL_POINT(planExecutorAlwaysFails)) {
         Status status(ErrorCodes::OperationFailed,
                       str::stream() << "PlanExecutor hit planExecutorAlwaysFails fail point");
@@ -470,6 +476,12 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
     // Incremented on every writeConflict, reset to 0 on any successful call to _root->work.
     size_t writeConflictsInARow = 0;
 
+    // Holds the ids handed back by each batch of work when results are being discarded.
+    std::vector<WorkingSetID> discardBatch;
+    if (discardResults) {
+        discardBatch.resize(kDiscardResultsBatchSize + 1);
+    }
+
     for (;;) {
         // These are the conditions which can cause us to yield:
         //   1) The yield policy's timer elapsed, or
@@ -497,7 +509,24 @@ PlanExecutor::ExecState PlanExecutor::getNextImpl(Snapshotted<BSONObj>* objOut,
         fetcher.reset();
 
         WorkingSetID id = WorkingSet::INVALID_ID;
-        PlanStage::StageState code = _root->work(&id);
+        PlanStage::StageState code;
+        if (!discardResults) {
+            code = _root->work(&id);
+        } else {
+            // The caller doesn't want the results, so drive the tree a batch at a time and
+            // free whatever comes back. Stages with batched implementations can then fill the
+            // whole batch in one storage engine crossing.
+            size_t numResults = 0;
+            code = _root->workBatch(discardBatch.data(), kDiscardResultsBatchSize, &numResults);
+            for (size_t i = 0; i < numResults; i++) {
+                _workingSet->free(discardBatch[i]);
+            }
+            id = discardBatch[numResults];
+            if (PlanStage::ADVANCED == code) {
+                // The batch's results were already consumed above; just ask for more.
+                code = PlanStage::NEED_TIME;
+            }
+        }
 
         if (code != PlanStage::NEED_YIELD)
             writeConflictsInARow = 0;
@@ -621,10 +650,10 @@ void PlanExecutor::dispose(OperationContext* opCtx, CursorManager* cursorManager
 
 Status PlanExecutor::executePlan() {
     invariant(_currentState == kUsable);
-    BSONObj obj;
+    Snapshotted<BSONObj> obj;
     PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
     while (PlanExecutor::ADVANCED == state) {
-        state = this->getNext(&obj, NULL);
+        state = this->getNextImpl(&obj, NULL, true /* discardResults */);
     }
 
     if (PlanExecutor::DEAD == state || PlanExecutor::FAILURE == state) {
@@ -634,7 +663,7 @@ Status PlanExecutor::executePlan() {
         }
 
         return Status(ErrorCodes::OperationFailed,
-                      str::stream() << "Exec error: " << WorkingSetCommon::toStatusString(obj)
+                      str::stream() << "Exec error: " << WorkingSetCommon::toStatusString(obj.value())
                                     << ", state: "
                                     << PlanExecutor::statestr(state));
     }
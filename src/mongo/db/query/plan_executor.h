@@ -452,7 +452,13 @@ private:
     // returns true immediately.
     bool waitForInserts();
 
-    ExecState getNextImpl(Snapshotted<BSONObj>* objOut, RecordId* dlOut);
+    // When 'discardResults' is true the caller is running the plan only for its side effects:
+    // the root stage is driven a batch of work at a time and every result it produces is freed
+    // without being returned, so ADVANCED is never surfaced to the caller. Stages with batched
+    // implementations can then fill a whole batch in one storage engine crossing.
+    ExecState getNextImpl(Snapshotted<BSONObj>* objOut,
+                          RecordId* dlOut,
+                          bool discardResults = false);
 
     /**
      * New PlanExecutor instances are created with the static make() methods above.
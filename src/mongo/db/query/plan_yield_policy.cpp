@@ -30,6 +30,7 @@
 
 #include "mongo/db/query/plan_yield_policy.h"
 
+#include "mongo/db/concurrency/locker.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/operation_context.h"
@@ -41,6 +42,16 @@
 
 namespace mongo {
 
+namespace {
+
+// When yielding only on contention, at most this many elapsed yield intervals may be skipped
+// in a row. Yield points are also where the operation checks for interrupt and refreshes its
+// storage snapshot, so they cannot be deferred indefinitely no matter how idle the lock
+// manager looks.
+const int kMaxSkippedYieldIntervals = 10;
+
+}  // namespace
+
 PlanYieldPolicy::PlanYieldPolicy(PlanExecutor* exec, PlanExecutor::YieldPolicy policy)
     : _policy(policy),
       _forceYield(false),
@@ -64,10 +75,25 @@ bool PlanYieldPolicy::shouldYield() {
     invariant(!_planYielding->getOpCtx()->lockState()->inAWriteUnitOfWork());
     if (_forceYield)
         return true;
-    return _elapsedTracker.intervalHasElapsed();
+    if (!_elapsedTracker.intervalHasElapsed())
+        return false;
+
+    if (!internalQueryExecYieldOnlyOnContention.load())
+        return true;
+
+    // Demand-driven yielding: give up locks only when some operation is actually blocked
+    // waiting for one, so uncontended scans are spared the save/restore round trip. Skipping is
+    // bounded so interrupt checking and snapshot refresh still happen on an idle server.
+    if (Locker::hasContendedLocks() || _skippedYieldIntervals >= kMaxSkippedYieldIntervals)
+        return true;
+
+    _skippedYieldIntervals++;
+    _elapsedTracker.resetLastTime();
+    return false;
 }
 
 void PlanYieldPolicy::resetTimer() {
+    _skippedYieldIntervals = 0;
     _elapsedTracker.resetLastTime();
 }
 
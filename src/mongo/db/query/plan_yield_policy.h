@@ -116,6 +116,10 @@ private:
     bool _forceYield;
     ElapsedTracker _elapsedTracker;
 
+    // Number of elapsed yield intervals in a row that were skipped because no operation was
+    // waiting for a lock. Only consulted when internalQueryExecYieldOnlyOnContention is set.
+    int _skippedYieldIntervals = 0;
+
     // The plan executor which this yield policy is responsible for yielding. Must
     // not outlive the plan executor.
     PlanExecutor* const _planYielding;
@@ -171,6 +171,15 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
         }
     }
 
+    // A forward scan whose query implies no order may ride along with another in-flight scan
+    // of the same collection rather than making its own pass over the data. Anything that
+    // implies an order or a starting point (a sort, a hint, tailable cursors, oplog scans,
+    // snapshot reads) keeps the plain scan.
+    if (!tailable && sortObj.isEmpty() && query.getQueryRequest().getHint().isEmpty() &&
+        !query.getQueryRequest().isSnapshot() && !query.nss().isOplog()) {
+        csn->allowSharedScan = true;
+    }
+
     return std::move(csn);
 }
 
@@ -30,11 +30,13 @@
 
 #include "mongo/db/query/planner_analysis.h"
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/query/field_histogram.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
@@ -290,8 +292,84 @@ void geoSkipValidationOn(const std::set<StringData>& twoDSphereFields,
     }
 }
 
+/**
+ * Returns the leftmost index scan in the tree rooted at 'node', i.e. the scan that produces
+ * the solution's initial stream of results, or NULL if the solution has none.
+ */
+const IndexScanNode* findLeadingIndexScan(const QuerySolutionNode* node) {
+    if (STAGE_IXSCAN == node->getType()) {
+        return static_cast<const IndexScanNode*>(node);
+    }
+    for (size_t i = 0; i < node->children.size(); ++i) {
+        if (const IndexScanNode* scan = findLeadingIndexScan(node->children[i])) {
+            return scan;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Estimates the fraction of the collection scanned by 'soln's leading index scan, using the
+ * sampled histograms in 'stats'.  Solutions with no index scan, or whose leading scanned
+ * field has no histogram, get the pessimistic estimate 1.
+ */
+double estimateSolutionSelectivity(const QuerySolution& soln, const FieldHistogramMap& stats) {
+    const IndexScanNode* scan = findLeadingIndexScan(soln.root.get());
+    if (NULL == scan || scan->bounds.isSimpleRange || scan->bounds.fields.empty()) {
+        return 1.0;
+    }
+
+    const OrderedIntervalList& leadingField = scan->bounds.fields[0];
+    FieldHistogramMap::const_iterator it = stats.find(leadingField.name);
+    if (it == stats.end()) {
+        return 1.0;
+    }
+
+    double estimate = 0;
+    for (size_t i = 0; i < leadingField.intervals.size(); ++i) {
+        const Interval& interval = leadingField.intervals[i];
+        estimate += it->second.estimateSelectivity(
+            interval.start, interval.startInclusive, interval.end, interval.endInclusive);
+    }
+    return std::min(estimate, 1.0);
+}
+
 }  // namespace
 
+// static
+void QueryPlannerAnalysis::rankSolutionsByStats(const CanonicalQuery& query,
+                                                std::vector<QuerySolution*>* solutions) {
+    if (solutions->size() < 2) {
+        return;
+    }
+
+    std::shared_ptr<const FieldHistogramMap> stats =
+        CollectionStatsStore::get()->getStats(query.nss().ns());
+    if (!stats) {
+        return;
+    }
+
+    std::vector<std::pair<double, QuerySolution*>> ranked;
+    ranked.reserve(solutions->size());
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        double estimate = estimateSolutionSelectivity(*(*solutions)[i], *stats);
+        LOG(5) << "Planner: estimated selectivity " << estimate << " for solution " << i;
+        ranked.push_back(std::make_pair(estimate, (*solutions)[i]));
+    }
+
+    // Stable so equally estimated solutions keep their enumeration order.
+    std::stable_sort(ranked.begin(),
+                     ranked.end(),
+                     [](const std::pair<double, QuerySolution*>& lhs,
+                        const std::pair<double, QuerySolution*>& rhs) {
+                         return lhs.first < rhs.first;
+                     });
+
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        (*solutions)[i] = ranked[i].second;
+    }
+}
+
 // static
 void QueryPlannerAnalysis::analyzeGeo(const QueryPlannerParams& params,
                                       QuerySolutionNode* solnRoot) {
@@ -60,6 +60,15 @@ public:
      */
     static BSONObj getSortPattern(const BSONObj& indexKeyPattern);
 
+    /**
+     * Reorders 'solutions' from most to least selective using the sampled field histograms
+     * for the collection, when any have been collected (see CollectionStatsStore).  Candidate
+     * plans are trialed in this order, so placing likely winners first lets the trial period
+     * settle -- and terminate early -- sooner.  A no-op when no statistics are available.
+     */
+    static void rankSolutionsByStats(const CanonicalQuery& query,
+                                     std::vector<QuerySolution*>* solutions);
+
     /**
      * In brief: performs sort and covering analysis.
      *
@@ -48,6 +48,10 @@ extern AtomicDouble internalQueryPlanEvaluationCollFraction;
 // Stop working plans once a plan returns this many results.
 extern AtomicInt32 internalQueryPlanEvaluationMaxResults;
 
+// Do we end the trial period early once one candidate plan is statistically dominant, and
+// stop working candidates which have fallen hopelessly behind the leader?
+extern AtomicBool internalQueryPlanEvaluationEarlyTermination;
+
 // Do we give a big ranking bonus to intersection plans?
 extern AtomicBool internalQueryForceIntersectionPlans;
 
@@ -64,6 +68,10 @@ extern AtomicBool internalQueryPlannerEnableHashIntersection;
 // How many entries in the cache?
 extern AtomicInt32 internalQueryCacheSize;
 
+// How many parsed filters does CanonicalQuery::canonicalize() cache so that repeated queries
+// with byte-identical filters skip match expression parsing? Set to zero to disable.
+extern AtomicInt32 internalQueryFilterParseCacheSize;
+
 // How many feedback entries do we collect before possibly evicting from the cache based on bad
 // performance?
 extern AtomicInt32 internalQueryCacheFeedbacksStored;
@@ -107,6 +115,17 @@ extern AtomicInt32 internalQueryExecYieldIterations;
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern AtomicInt32 internalQueryExecYieldPeriodMS;
 
+// If enabled, elapsed yield intervals only actually yield when some operation is blocked
+// waiting on a lock, so uncontended scans keep their locks and cursors. A bounded number of
+// intervals can be skipped in a row, since yields are also where interrupt is checked and the
+// storage snapshot is refreshed.
+extern AtomicBool internalQueryExecYieldOnlyOnContention;
+
+// If enabled, a distinct command with no filter and no collation over a suitable single-field
+// btree index is answered by a tight loop over the index that skips between distinct values
+// with storage-layer seeks, bypassing the stage and executor machinery.
+extern AtomicBool internalQueryExecTightLoopDistinct;
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
@@ -117,4 +136,9 @@ extern AtomicInt32 internalInsertMaxBatchSize;
 
 extern AtomicInt32 internalDocumentSourceCursorBatchSizeBytes;
 
+// The number of input documents a $lookup using localField/foreignField syntax joins with one
+// batched $in query against the foreign collection. Values of 0 or 1 keep the
+// one-query-per-document behavior.
+extern AtomicInt32 internalDocumentSourceLookupJoinBatchSize;
+
 }  // namespace mongo
@@ -1059,6 +1059,11 @@ Status QueryPlanner::plan(const CanonicalQuery& query,
         }
     }
 
+    // If the background statistics sampler has histograms for this collection, put the
+    // candidates the histograms favor at the front so the multi-plan trial evaluates them
+    // first.
+    QueryPlannerAnalysis::rankSolutionsByStats(query, out);
+
     return Status::OK();
 }
 
@@ -224,7 +224,8 @@ CollectionScanNode::CollectionScanNode()
     : _sort(SimpleBSONObjComparator::kInstance.makeBSONObjSet()),
       tailable(false),
       direction(1),
-      maxScan(0) {}
+      maxScan(0),
+      allowSharedScan(false) {}
 
 void CollectionScanNode::appendToString(mongoutils::str::stream* ss, int indent) const {
     addIndent(ss, indent);
@@ -247,6 +248,7 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     copy->tailable = this->tailable;
     copy->direction = this->direction;
     copy->maxScan = this->maxScan;
+    copy->allowSharedScan = this->allowSharedScan;
 
     return copy;
 }
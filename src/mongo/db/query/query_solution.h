@@ -293,6 +293,10 @@ struct CollectionScanNode : public QuerySolutionNode {
 
     // maxScan option to .find() limits how many docs we look at.
     int maxScan;
+
+    // True if the scan may join an in-flight shared scan of the same collection and return its
+    // results in rotated order. Only set when the query doesn't care about document order.
+    bool allowSharedScan;
 };
 
 struct AndHashNode : public QuerySolutionNode {
@@ -548,7 +548,9 @@ Status BackgroundSync::_enqueueDocuments(Fetcher::Documents::const_iterator begi
             LOG(2) << "bgsync buffer has " << _oplogBuffer->getSize() << " bytes";
         }
 
-        // Buffer docs for later application.
+        // Buffer docs for later application. The documents share ownership with the network
+        // message they arrived in (see Fetcher's batch parsing), so this buffers refcounted
+        // handles; the entry bytes are never copied between fetch and apply.
         _oplogBuffer->pushAllNonBlocking(opCtx.get(), begin, end);
 
         // Update last fetched info.
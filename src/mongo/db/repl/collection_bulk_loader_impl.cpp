@@ -43,6 +43,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/collection_bulk_loader_impl.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -134,6 +135,15 @@ Status CollectionBulkLoaderImpl::init(const std::vector<BSONObj>& secondaryIndex
                 _idIndexBlock.reset();
             }
 
+            // Stream documents through the storage engine's bulk-load path when it offers one.
+            // The collection was just created for this load, so it is empty and we are its only
+            // writer; on any failure the whole collection is dropped, which matches the loader's
+            // non-transactional contract.
+            _recordStoreLoader = coll->getRecordStore()->getBulkLoader(_opCtx.get());
+            if (_recordStoreLoader) {
+                LOG(2) << "Using storage engine bulk loader for ns: " << _nss.ns();
+            }
+
             return Status::OK();
         });
 }
@@ -144,6 +154,46 @@ Status CollectionBulkLoaderImpl::insertDocuments(const std::vector<BSONObj>::con
     return _runTaskReleaseResourcesOnFailure([&]() -> Status {
         UnreplicatedWritesBlock uwb(_opCtx.get());
 
+        if (_recordStoreLoader) {
+            // Append the batch through the bulk loader, then feed the assigned RecordIds to the
+            // index builders. The record writes are outside any WriteUnitOfWork by design.
+            std::vector<RecordId> locs;
+            locs.reserve(std::distance(begin, end));
+            for (auto iter = begin; iter != end; ++iter) {
+                const auto res = _recordStoreLoader->addRecord(iter->objdata(), iter->objsize());
+                if (!res.isOK()) {
+                    return res.getStatus();
+                }
+                locs.push_back(res.getValue());
+            }
+
+            if (!_idIndexBlock && !_secondaryIndexesBlock) {
+                return Status::OK();
+            }
+
+            return writeConflictRetry(
+                _opCtx.get(), "CollectionBulkLoaderImpl::insertDocuments", _nss.ns(), [&] {
+                    WriteUnitOfWork wunit(_opCtx.get());
+                    size_t i = 0;
+                    for (auto iter = begin; iter != end; ++iter, ++i) {
+                        if (_idIndexBlock) {
+                            const auto status = _idIndexBlock->insert(*iter, locs[i]);
+                            if (!status.isOK()) {
+                                return status;
+                            }
+                        }
+                        if (_secondaryIndexesBlock) {
+                            const auto status = _secondaryIndexesBlock->insert(*iter, locs[i]);
+                            if (!status.isOK()) {
+                                return status;
+                            }
+                        }
+                    }
+                    wunit.commit();
+                    return Status::OK();
+                });
+        }
+
         for (auto iter = begin; iter != end; ++iter) {
             std::vector<MultiIndexBlock*> indexers;
             if (_idIndexBlock) {
@@ -195,6 +245,16 @@ Status CollectionBulkLoaderImpl::commit() {
         LOG(2) << "Creating indexes for ns: " << _nss.ns();
         UnreplicatedWritesBlock uwb(_opCtx.get());
 
+        // Complete the record store bulk load before touching the indexes; the index commit
+        // below (and any duplicate-key deletes) must see the loaded records.
+        if (_recordStoreLoader) {
+            const auto status = _recordStoreLoader->finalize();
+            if (!status.isOK()) {
+                return status;
+            }
+            _recordStoreLoader.reset();
+        }
+
         // Commit before deleting dups, so the dups will be removed from secondary indexes when
         // deleted.
         if (_secondaryIndexesBlock) {
@@ -256,6 +316,10 @@ Status CollectionBulkLoaderImpl::commit() {
 
 void CollectionBulkLoaderImpl::_releaseResources() {
     invariant(&cc() == _opCtx->getClient());
+
+    // Discards any unfinalized bulk load; the collection is dropped by the caller on failure.
+    _recordStoreLoader.reset();
+
     if (_secondaryIndexesBlock) {
         // A valid Client is required to drop unfinished indexes.
         Client::initThreadIfNotAlready();
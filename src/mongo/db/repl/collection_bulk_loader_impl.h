@@ -40,6 +40,9 @@
 #include "mongo/db/repl/storage_interface.h"
 
 namespace mongo {
+
+class RecordStoreBulkLoader;
+
 namespace repl {
 
 /**
@@ -88,6 +91,9 @@ private:
     NamespaceString _nss;
     std::unique_ptr<MultiIndexBlock> _idIndexBlock;
     std::unique_ptr<MultiIndexBlock> _secondaryIndexesBlock;
+    // Storage-engine bulk-load path for the record store; null when the engine has no optimized
+    // path or the collection is capped, in which case documents go through insertDocument().
+    std::unique_ptr<RecordStoreBulkLoader> _recordStoreLoader;
     BSONObj _idIndexSpec;
     Stats _stats;
 };
@@ -68,6 +68,12 @@ MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionCountAttempts, int, 3);
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListIndexesAttempts, int, 3);
 // The number of attempts for the find command, which gets the data.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionFindAttempts, int, 3);
+// The number of times the clone query for a collection may be resumed from the last cloned _id
+// after losing its cursor, instead of failing the entire initial sync attempt. When enabled, the
+// clone query scans in _id order so the last cloned _id is a valid resume token; this requires an
+// _id index on the sync source. A value of 0 (the default) disables resuming and an interrupted
+// clone fails the attempt as before.
+MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionResumeAttempts, int, 0);
 }  // namespace
 
 // Failpoint which causes initial sync to hang when it has cloned 'numDocsToClone' documents to
@@ -225,6 +231,9 @@ void CollectionCloner::_cancelRemainingWork_inlock() {
     if (_findFetcher) {
         _findFetcher->shutdown();
     }
+    if (_retiredFindFetcher) {
+        _retiredFindFetcher->shutdown();
+    }
     _dbWorkTaskRunner.cancel();
 }
 
@@ -396,6 +405,23 @@ void CollectionCloner::_findCallback(const StatusWith<Fetcher::QueryResponse>& f
                                      BSONObjBuilder* getMoreBob,
                                      std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
     if (!fetchResult.isOK()) {
+        {
+            stdx::lock_guard<stdx::mutex> lock(_mutex);
+            if (_resumeAttemptsLeft > 0 && _state == State::kRunning &&
+                ErrorCodes::CallbackCanceled != fetchResult.getStatus()) {
+                --_resumeAttemptsLeft;
+                warning() << "Lost cursor while cloning collection '" << _sourceNss.ns()
+                          << "' due to '" << redact(fetchResult.getStatus())
+                          << "'; resuming collection clone after _id: " << redact(_lastDocId);
+                auto resumeStatus = _scheduleFindFetcher_inlock(onCompletionGuard);
+                if (resumeStatus.isOK()) {
+                    return;
+                }
+                warning() << "Failed to resume clone of collection '" << _sourceNss.ns() << "': "
+                          << redact(resumeStatus);
+            }
+        }
+
         // Wait for active inserts to complete.
         waitForDbWorker();
 
@@ -415,6 +441,12 @@ void CollectionCloner::_findCallback(const StatusWith<Fetcher::QueryResponse>& f
     if (batchData.documents.size() > 0) {
         LockGuard lk(_mutex);
         _documents.insert(_documents.end(), batchData.documents.begin(), batchData.documents.end());
+        if (numInitialSyncCollectionResumeAttempts.load() > 0) {
+            auto idElement = batchData.documents.back()["_id"];
+            if (!idElement.eoo()) {
+                _lastDocId = idElement.wrap();
+            }
+        }
     } else if (!batchData.first) {
         warning() << "No documents returned in batch; ns: " << _sourceNss
                   << ", cursorId:" << batchData.cursorId << ", isLastBatch:" << lastBatch;
@@ -497,11 +529,44 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
 
     _collLoader = std::move(status.getValue());
 
+    _lastDocId = BSONObj();
+    _resumeAttemptsLeft = numInitialSyncCollectionResumeAttempts.load();
+
+    Status scheduleStatus = _scheduleFindFetcher_inlock(onCompletionGuard);
+    if (!scheduleStatus.isOK()) {
+        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, scheduleStatus);
+        return;
+    }
+}
+
+Status CollectionCloner::_scheduleFindFetcher_inlock(
+    std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    BSONObjBuilder cmdBob;
+    cmdBob.append("find", _sourceNss.coll());
+    if (!_lastDocId.isEmpty()) {
+        // Resume after the last document that was buffered for insertion. This is correct only
+        // because the clone query below is sorted by _id.
+        cmdBob.append("filter", BSON("_id" << BSON("$gt" << _lastDocId.firstElement())));
+    }
+    if (numInitialSyncCollectionResumeAttempts.load() > 0) {
+        // Scan in _id order so the last cloned _id is a valid resume token.
+        cmdBob.append("sort", BSON("_id" << 1));
+    }
+    cmdBob.append("noCursorTimeout", true);
+    cmdBob.append("batchSize", _batchSize);
+
+    // When resuming, the interrupted fetcher is invoking this method from its own callback and
+    // cannot be destroyed yet, so it is retired instead. The fetcher it replaces, if any, has
+    // already delivered its final callback and is safe to destroy.
+    if (_findFetcher) {
+        _retiredFindFetcher = std::move(_findFetcher);
+    }
+
     _findFetcher = stdx::make_unique<Fetcher>(
         _executor,
         _source,
         _sourceNss.db().toString(),
-        BSON("find" << _sourceNss.coll() << "noCursorTimeout" << true << "batchSize" << _batchSize),
+        cmdBob.obj(),
         stdx::bind(&CollectionCloner::_findCallback,
                    this,
                    stdx::placeholders::_1,
@@ -518,9 +583,9 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
     Status scheduleStatus = _findFetcher->schedule();
     if (!scheduleStatus.isOK()) {
         _findFetcher.reset();
-        onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, scheduleStatus);
-        return;
+        return scheduleStatus;
     }
+    return Status::OK();
 }
 
 void CollectionCloner::_insertDocumentsCallback(
@@ -180,6 +180,12 @@ private:
                        BSONObjBuilder* getMoreBob,
                        std::shared_ptr<OnCompletionGuard> onCompletionGuard);
 
+    /**
+     * Creates and schedules the fetcher for the clone query. When '_lastDocId' is non-empty the
+     * query resumes after that document instead of scanning the collection from the beginning.
+     */
+    Status _scheduleFindFetcher_inlock(std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
     /**
      * Request storage interface to create collection.
      *
@@ -232,6 +238,12 @@ private:
     RemoteCommandRetryScheduler _countScheduler;  // (S)
     Fetcher _listIndexesFetcher;                  // (S)
     std::unique_ptr<Fetcher> _findFetcher;        // (M)
+    std::unique_ptr<Fetcher> _retiredFindFetcher;  // (M) Interrupted find fetcher; a Fetcher may
+                                                   // not be destroyed from its own callback, so it
+                                                   // is retired here while a resumed query runs.
+    BSONObj _lastDocId;        // (M) Wrapped '_id' of the last document buffered for insertion.
+                               // Used to resume the clone query after a transient error.
+    int _resumeAttemptsLeft = 0;  // (M) Remaining resume attempts for the clone query.
     std::vector<BSONObj> _indexSpecs;             // (M)
     BSONObj _idIndexSpec;                         // (M)
     std::vector<BSONObj> _documents;              // (M) Documents read from fetcher to insert.
@@ -68,6 +68,10 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(collectionClonerBatchSize, int, defaultBat
 // The number of attempts for the listCollections commands.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListCollectionsAttempts, int, 3);
 
+// The number of collection cloners a database cloner keeps in flight concurrently. The default of
+// 1 preserves the historical behavior of cloning one collection at a time.
+MONGO_EXPORT_SERVER_PARAMETER(initialSyncMaxParallelCollectionClones, int, 1);
+
 /**
  * Default listCollections predicate.
  */
@@ -377,20 +381,39 @@ void DatabaseCloner::_listCollectionsCallback(const StatusWith<Fetcher::QueryRes
         }
     }
 
-    // Start first collection cloner.
+    // Start the initial window of collection cloners.
     _currentCollectionClonerIter = _collectionCloners.begin();
 
-    LOG(1) << "    cloning collection " << _currentCollectionClonerIter->getSourceNamespace();
-
-    Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-    if (!startStatus.isOK()) {
-        LOG(1) << "    failed to start collection cloning on "
-               << _currentCollectionClonerIter->getSourceNamespace() << ": " << redact(startStatus);
+    Status startStatus = _startCollectionCloners_inlock();
+    if (!startStatus.isOK() && _startedCollectionCloners == 0) {
         _finishCallback_inlock(lk, startStatus);
         return;
     }
 }
 
+Status DatabaseCloner::_startCollectionCloners_inlock() {
+    const size_t maxInFlight =
+        static_cast<size_t>(std::max(1, initialSyncMaxParallelCollectionClones.load()));
+    while (_currentCollectionClonerIter != _collectionCloners.end() &&
+           _startedCollectionCloners - _stats.clonedCollections < maxInFlight) {
+        LOG(1) << "    cloning collection " << _currentCollectionClonerIter->getSourceNamespace();
+
+        Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
+        if (!startStatus.isOK()) {
+            LOG(1) << "    failed to start collection cloning on "
+                   << _currentCollectionClonerIter->getSourceNamespace() << ": "
+                   << redact(startStatus);
+            if (_startCollectionClonerStatus.isOK()) {
+                _startCollectionClonerStatus = startStatus;
+            }
+            return startStatus;
+        }
+        ++_startedCollectionCloners;
+        ++_currentCollectionClonerIter;
+    }
+    return Status::OK();
+}
+
 void DatabaseCloner::_collectionClonerCallback(const Status& status, const NamespaceString& nss) {
     auto newStatus = status;
 
@@ -411,17 +434,19 @@ void DatabaseCloner::_collectionClonerCallback(const Status& status, const Names
     lk.unlock();
     _collectionWork(newStatus, nss);
     lk.lock();
-    _currentCollectionClonerIter++;
 
-    if (_currentCollectionClonerIter != _collectionCloners.end()) {
-        Status startStatus = _startCollectionCloner(*_currentCollectionClonerIter);
-        if (!startStatus.isOK()) {
-            LOG(1) << "    failed to start collection cloning on "
-                   << _currentCollectionClonerIter->getSourceNamespace() << ": "
-                   << redact(startStatus);
-            _finishCallback_inlock(lk, startStatus);
-            return;
-        }
+    // Refill the window of in-flight collection cloners unless an earlier start attempt failed.
+    if (_startCollectionClonerStatus.isOK()) {
+        _startCollectionCloners_inlock().ignore();
+    }
+
+    // Other collection cloners are still in flight; the last one to finish reports the result.
+    if (_startedCollectionCloners != _stats.clonedCollections) {
+        return;
+    }
+
+    if (!_startCollectionClonerStatus.isOK()) {
+        _finishCallback_inlock(lk, _startCollectionClonerStatus);
         return;
     }
 
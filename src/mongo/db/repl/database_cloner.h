@@ -190,6 +190,12 @@ private:
      */
     void _collectionClonerCallback(const Status& status, const NamespaceString& nss);
 
+    /**
+     * Starts collection cloners until 'initialSyncMaxParallelCollectionClones' of them are in
+     * flight or all of them have been started. Returns the first scheduling error encountered.
+     */
+    Status _startCollectionCloners_inlock();
+
     /**
      * Reports completion status.
      * Sets cloner to inactive.
@@ -233,7 +239,9 @@ private:
     std::vector<BSONObj> _collectionInfos;                               // (M)
     std::vector<NamespaceString> _collectionNamespaces;                  // (M)
     std::list<CollectionCloner> _collectionCloners;                      // (M)
-    std::list<CollectionCloner>::iterator _currentCollectionClonerIter;  // (M)
+    std::list<CollectionCloner>::iterator _currentCollectionClonerIter;  // (M) next cloner to start
+    size_t _startedCollectionCloners = 0;                                // (M)
+    Status _startCollectionClonerStatus = Status::OK();                  // (M) first start failure
     std::vector<std::pair<Status, NamespaceString>> _failedNamespaces;   // (M)
     CollectionCloner::ScheduleDbWorkFn
         _scheduleDbWorkFn;  // (RT) Function for scheduling database work using the executor.
@@ -61,6 +61,11 @@ using UniqueLock = stdx::unique_lock<stdx::mutex>;
 // The number of attempts for the listDatabases commands.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListDatabasesAttempts, int, 3);
 
+// The number of database cloners kept in flight concurrently during initial sync. The default of
+// 1 preserves the historical behavior of cloning one database at a time. Regardless of this
+// setting, the 'admin' database is always cloned by itself first.
+MONGO_EXPORT_SERVER_PARAMETER(initialSyncMaxParallelDatabaseClones, int, 1);
+
 }  // namespace
 
 
@@ -344,7 +349,7 @@ void DatabasesCloner::_onListDatabaseFinish(const CommandCallbackArgs& cbd) {
         const auto onDbFinish = [this, dbName](const Status& status) {
             _onEachDBCloneFinish(status, dbName);
         };
-        Status startStatus = Status::OK();
+        Status createStatus = Status::OK();
         try {
             dbCloner.reset(new DatabaseCloner(
                 _exec,
@@ -359,17 +364,13 @@ void DatabasesCloner::_onListDatabaseFinish(const CommandCallbackArgs& cbd) {
             if (_scheduleDbWorkFn) {
                 dbCloner->setScheduleDbWorkFn_forTest(_scheduleDbWorkFn);
             }
-            // Start first database cloner.
-            if (_databaseCloners.empty()) {
-                startStatus = dbCloner->startup();
-            }
         } catch (...) {
-            startStatus = exceptionToStatus();
+            createStatus = exceptionToStatus();
         }
 
-        if (!startStatus.isOK()) {
+        if (!createStatus.isOK()) {
             std::string err = str::stream() << "could not create cloner for database: " << dbName
-                                            << " due to: " << startStatus.toString();
+                                            << " due to: " << createStatus.toString();
             _setStatus_inlock({ErrorCodes::InitialSyncFailure, err});
             error() << err;
             break;  // exit for_each loop
@@ -384,9 +385,43 @@ void DatabasesCloner::_onListDatabaseFinish(const CommandCallbackArgs& cbd) {
         } else {
             _fail_inlock(&lk, _status);
         }
+        return;
+    }
+
+    // Start the initial window of database cloners.
+    auto startStatus = _startDatabaseCloners_inlock();
+    if (!startStatus.isOK()) {
+        std::string err = str::stream() << "could not start database cloner due to: "
+                                        << startStatus.toString();
+        _setStatus_inlock({ErrorCodes::InitialSyncFailure, err});
+        error() << err;
+        _fail_inlock(&lk, _status);
     }
 }
 
+Status DatabasesCloner::_startDatabaseCloners_inlock() {
+    size_t maxInFlight =
+        static_cast<size_t>(std::max(1, initialSyncMaxParallelDatabaseClones.load()));
+    // The 'admin' database, sorted to the front of the list, is cloned (and validated) by itself
+    // before any other database so that users can authenticate against a consistent admin db
+    // while initial sync is occurring.
+    if (_databaseClonersStarted == 0 &&
+        StringData(_databaseCloners.front()->getDBName()).equalCaseInsensitive("admin")) {
+        maxInFlight = 1;
+    }
+
+    while (_databaseClonersStarted < _databaseCloners.size() &&
+           _databaseClonersStarted - _stats.databasesCloned < maxInFlight) {
+        auto&& dbCloner = _databaseCloners[_databaseClonersStarted];
+        auto startStatus = dbCloner->startup();
+        if (!startStatus.isOK()) {
+            return startStatus;
+        }
+        ++_databaseClonersStarted;
+    }
+    return Status::OK();
+}
+
 std::vector<std::shared_ptr<DatabaseCloner>> DatabasesCloner::_getDatabaseCloners() const {
     LockGuard lock(_mutex);
     return _databaseCloners;
@@ -399,6 +434,13 @@ RemoteCommandRetryScheduler* DatabasesCloner::_getListDatabasesScheduler() const
 
 void DatabasesCloner::_onEachDBCloneFinish(const Status& status, const std::string& name) {
     UniqueLock lk(_mutex);
+
+    // When database cloners run concurrently, one of them may already have reported the final
+    // result (and cleared the finish callback) while others were still in flight.
+    if (_state == State::kComplete || !_finishFn) {
+        return;
+    }
+
     if (!status.isOK()) {
         warning() << "database '" << name << "' (" << (_stats.databasesCloned + 1) << " of "
                   << _databaseCloners.size() << ") clone failed due to " << status.toString();
@@ -434,9 +476,8 @@ void DatabasesCloner::_onEachDBCloneFinish(const Status& status, const std::stri
         return;
     }
 
-    // Start next database cloner.
-    auto&& dbCloner = _databaseCloners[_stats.databasesCloned];
-    auto startStatus = dbCloner->startup();
+    // Start the next database cloner(s).
+    auto startStatus = _startDatabaseCloners_inlock();
     if (!startStatus.isOK()) {
         warning() << "failed to schedule database '" << name << "' ("
                   << (_stats.databasesCloned + 1) << " of " << _databaseCloners.size()
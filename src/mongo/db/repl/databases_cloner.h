@@ -144,6 +144,14 @@ private:
     /** Called each time a database clone is finished */
     void _onEachDBCloneFinish(const Status& status, const std::string& name);
 
+    /**
+     * Starts database cloners until 'initialSyncMaxParallelDatabaseClones' of them are in flight
+     * or all of them have been started. The 'admin' database, when present, is always cloned by
+     * itself before any other database so that it can be validated first. Returns the first
+     * scheduling error encountered.
+     */
+    Status _startDatabaseCloners_inlock();
+
     //  Callbacks
 
     void _onListDatabaseFinish(const CommandCallbackArgs& cbd);
@@ -186,7 +194,8 @@ private:
 
     std::unique_ptr<RemoteCommandRetryScheduler> _listDBsScheduler;  // (M) scheduler for listDBs.
     std::vector<std::shared_ptr<DatabaseCloner>> _databaseCloners;   // (M) database cloners by name
-    Stats _stats;                                                    // (M)
+    size_t _databaseClonersStarted = 0;  // (M) number of database cloners started so far.
+    Stats _stats;                        // (M)
 
     // State transitions:
     // PreStart --> Running --> ShuttingDown --> Complete
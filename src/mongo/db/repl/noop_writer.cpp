@@ -50,6 +50,12 @@ namespace {
 
 MONGO_EXPORT_SERVER_PARAMETER(writePeriodicNoops, bool, true);
 
+// Once the replica set has been idle (no optime changes other than the noop writer's own) for
+// this long, periodic noop writes are suppressed until user writes resume, so fully idle sets
+// stop generating baseline oplog and journal traffic. A value of 0 (the default) disables the
+// suppression and noops are written every interval as before.
+MONGO_EXPORT_SERVER_PARAMETER(periodicNoopIdleWindowSecs, int, 0);
+
 const auto kMsgObj = BSON("msg"
                           << "periodic noop");
 
@@ -127,6 +133,9 @@ NoopWriter::~NoopWriter() {
 Status NoopWriter::startWritingPeriodicNoops(OpTime lastKnownOpTime) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     _lastKnownOpTime = lastKnownOpTime;
+    // Treat starting to write noops as activity so a new primary keeps writing noops for at
+    // least one full idle window.
+    _lastActivityTime = Date_t::now();
 
     invariant(!_noopRunner);
     _noopRunner = stdx::make_unique<PeriodicNoopRunner>(
@@ -162,8 +171,13 @@ void NoopWriter::_writeNoop(OperationContext* opCtx) {
     if (lastAppliedOpTime != _lastKnownOpTime) {
         LOG(1) << "Not scheduling a noop write. Last known OpTime: " << _lastKnownOpTime
                << " != last primary OpTime: " << lastAppliedOpTime;
+        _lastActivityTime = Date_t::now();
     } else {
-        if (writePeriodicNoops.load()) {
+        const auto idleWindowSecs = periodicNoopIdleWindowSecs.load();
+        if (idleWindowSecs > 0 && Date_t::now() - _lastActivityTime >= Seconds(idleWindowSecs)) {
+            LOG(1) << "Skipping noop write. No writes to this replica set in over "
+                   << Seconds(idleWindowSecs);
+        } else if (writePeriodicNoops.load()) {
             const auto logLevel = Command::testCommandsEnabled ? 0 : 1;
             LOG(logLevel)
                 << "Writing noop to oplog as there has been no writes to this replica set in over "
@@ -68,6 +68,13 @@ private:
      */
     OpTime _lastKnownOpTime;
 
+    /**
+     * The last time the noop writer observed an optime change it did not cause itself. Used to
+     * suppress noop writes once the replica set has been idle for longer than the configured
+     * idle window.
+     */
+    Date_t _lastActivityTime;
+
     /**
      * Protects member data of this class during start and stop. There is no need to synchronize
      * access once its running because its run by a one thread only.
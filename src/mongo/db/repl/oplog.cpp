@@ -74,6 +74,7 @@
 #include "mongo/db/ops/update_lifecycle_impl.h"
 #include "mongo/db/repl/apply_ops.h"
 #include "mongo/db/repl/bgsync.h"
+#include "mongo/db/repl/oplog_fanout_hub.h"
 #include "mongo/db/repl/oplogreader.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/repl_client_info.h"
@@ -334,7 +335,9 @@ OplogDocWriter _logOpWriter(OperationContext* opCtx,
                             Date_t wallTime,
                             StmtId statementId,
                             const Timestamp& prevTs) {
-    BSONObjBuilder b(256);
+    // 256 covers the fixed-size fields; o2 is caller-provided and can be large, so size the
+    // frame exactly up front rather than paying grow-and-copy cycles while appending it.
+    BSONObjBuilder b(256 + (o2 ? o2->objsize() : 0));
 
     b.append("ts", optime.getTimestamp());
     if (optime.getTerm() != -1)
@@ -450,6 +453,26 @@ void _logOpsInner(OperationContext* opCtx,
     // instead we do a single copy to the destination in the record store.
     checkOplogInsert(oplogCollection->insertDocumentsForOplog(opCtx, writers, nWriters));
 
+    // Hand the new entries to any in-memory $changeNotification subscribers once they
+    // commit. The entries only exist as DocWriters here, so materialize them to owned BSON
+    // only when someone is actually listening.
+    auto& fanoutHub = OplogFanoutHub::get(opCtx);
+    if (fanoutHub.hasSubscribers()) {
+        std::vector<BSONObj> entries;
+        entries.reserve(nWriters);
+        for (size_t i = 0; i < nWriters; i++) {
+            const size_t size = writers[i]->documentSize();
+            SharedBuffer buffer = SharedBuffer::allocate(size);
+            writers[i]->writeDocument(buffer.get());
+            entries.emplace_back(ConstSharedBuffer(std::move(buffer)));
+        }
+        opCtx->recoveryUnit()->onCommit([&fanoutHub, entries = std::move(entries) ] {
+            for (auto&& entry : entries) {
+                fanoutHub.publish(entry);
+            }
+        });
+    }
+
     // Set replCoord last optime only after we're sure the WUOW didn't abort and roll back.
     opCtx->recoveryUnit()->onCommit([opCtx, replCoord, finalOpTime] {
         replCoord->setMyLastAppliedOpTimeForward(finalOpTime);
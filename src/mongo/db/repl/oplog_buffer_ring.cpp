@@ -0,0 +1,262 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_buffer_ring.h"
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+std::size_t getDocumentSize(const BSONObj& o) {
+    // SERVER-9808 Avoid Fortify complaint about implicit signed->unsigned conversion
+    return static_cast<std::size_t>(o.objsize());
+}
+
+std::size_t roundUpToPowerOfTwo(std::size_t n) {
+    std::size_t result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}  // namespace
+
+const std::size_t OplogBufferRing::kDefaultMaxSizeBytes = 256 * 1024 * 1024;
+const std::size_t OplogBufferRing::kDefaultSlotCount = 1 << 19;
+
+OplogBufferRing::OplogBufferRing(std::size_t maxSizeBytes, std::size_t slotCount)
+    : _maxSizeBytes(maxSizeBytes),
+      _slotCount(roundUpToPowerOfTwo(slotCount)),
+      _slotMask(_slotCount - 1),
+      _slots(_slotCount) {
+    invariant(slotCount > 0);
+}
+
+void OplogBufferRing::startup(OperationContext*) {}
+
+void OplogBufferRing::shutdown(OperationContext* opCtx) {
+    clear(opCtx);
+}
+
+void OplogBufferRing::pushEvenIfFull(OperationContext*, const Value& value) {
+    _waitForFreeSlot();
+    _pushOne(value);
+}
+
+void OplogBufferRing::push(OperationContext* opCtx, const Value& value) {
+    waitForSpace(opCtx, getDocumentSize(value));
+    _pushOne(value);
+}
+
+void OplogBufferRing::pushAllNonBlocking(OperationContext*,
+                                         Batch::const_iterator begin,
+                                         Batch::const_iterator end) {
+    if (begin == end) {
+        return;
+    }
+
+    // Write every entry into its slot, then publish the whole batch with a single store of
+    // _tail, so the consumer transitions from seeing none of the batch to seeing all of it.
+    // Like OplogBufferBlockingQueue::pushAllNonBlocking, this ignores the byte budget.
+    uint64_t tail = _tail.load();
+    long long batchBytes = 0;
+    for (auto it = begin; it != end; ++it) {
+        while (tail - _head.load() >= _slotCount) {
+            // Out of slots mid-batch; publish what has been written so the consumer can drain.
+            _sizeBytes.addAndFetch(batchBytes);
+            _tail.store(tail);
+            batchBytes = 0;
+            _notifyConsumerIfParked();
+            _waitForFreeSlot();
+        }
+        _slots[tail & _slotMask] = *it;
+        batchBytes += getDocumentSize(*it);
+        tail++;
+    }
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_lastPushedMutex);
+        _lastPushed = *(end - 1);
+    }
+    _sizeBytes.addAndFetch(batchBytes);
+    _tail.store(tail);
+    _notifyConsumerIfParked();
+}
+
+void OplogBufferRing::waitForSpace(OperationContext*, std::size_t size) {
+    if (_hasSpaceFor(size)) {
+        return;
+    }
+    stdx::unique_lock<stdx::mutex> lk(_parkMutex);
+    _producerParked.store(true);
+    while (!_hasSpaceFor(size)) {
+        _notFullCV.wait(lk);
+    }
+    _producerParked.store(false);
+}
+
+bool OplogBufferRing::isEmpty() const {
+    return _head.load() == _tail.load();
+}
+
+std::size_t OplogBufferRing::getMaxSize() const {
+    return _maxSizeBytes;
+}
+
+std::size_t OplogBufferRing::getSize() const {
+    const long long size = _sizeBytes.load();
+    return size > 0 ? static_cast<std::size_t>(size) : 0;
+}
+
+std::size_t OplogBufferRing::getCount() const {
+    // Load _head first: the consumer only retires entries the producer has already published,
+    // so this order cannot observe a head ahead of the tail read afterwards.
+    const uint64_t head = _head.load();
+    const uint64_t tail = _tail.load();
+    return static_cast<std::size_t>(tail - head);
+}
+
+void OplogBufferRing::clear(OperationContext*) {
+    uint64_t head = _head.load();
+    const uint64_t tail = _tail.load();
+    while (head != tail) {
+        Value& slot = _slots[head & _slotMask];
+        _sizeBytes.subtractAndFetch(getDocumentSize(slot));
+        slot = Value();
+        head++;
+    }
+    _head.store(head);
+    {
+        stdx::lock_guard<stdx::mutex> lk(_lastPushedMutex);
+        _lastPushed = Value();
+    }
+    _notifyProducerIfParked();
+}
+
+bool OplogBufferRing::tryPop(OperationContext*, Value* value) {
+    const uint64_t head = _head.load();
+    if (head == _tail.load()) {
+        return false;
+    }
+    Value& slot = _slots[head & _slotMask];
+    *value = std::move(slot);
+    slot = Value();
+    _sizeBytes.subtractAndFetch(getDocumentSize(*value));
+    _head.store(head + 1);
+    _notifyProducerIfParked();
+    return true;
+}
+
+bool OplogBufferRing::waitForData(Seconds waitDuration) {
+    if (!isEmpty()) {
+        return true;
+    }
+    stdx::unique_lock<stdx::mutex> lk(_parkMutex);
+    _consumerParked.store(true);
+    _notEmptyCV.wait_for(
+        lk, waitDuration.toSystemDuration(), [this]() { return !isEmpty(); });
+    _consumerParked.store(false);
+    return !isEmpty();
+}
+
+bool OplogBufferRing::peek(OperationContext*, Value* value) {
+    const uint64_t head = _head.load();
+    if (head == _tail.load()) {
+        return false;
+    }
+    *value = _slots[head & _slotMask];
+    return true;
+}
+
+boost::optional<OplogBuffer::Value> OplogBufferRing::lastObjectPushed(OperationContext*) const {
+    if (isEmpty()) {
+        return boost::none;
+    }
+    stdx::lock_guard<stdx::mutex> lk(_lastPushedMutex);
+    return _lastPushed;
+}
+
+bool OplogBufferRing::_hasSpaceFor(std::size_t size) const {
+    const std::size_t count = getCount();
+    if (count == 0) {
+        return true;
+    }
+    if (count >= _slotCount) {
+        return false;
+    }
+    return getSize() + size <= _maxSizeBytes;
+}
+
+void OplogBufferRing::_waitForFreeSlot() {
+    if (getCount() < _slotCount) {
+        return;
+    }
+    stdx::unique_lock<stdx::mutex> lk(_parkMutex);
+    _producerParked.store(true);
+    while (getCount() >= _slotCount) {
+        _notFullCV.wait(lk);
+    }
+    _producerParked.store(false);
+}
+
+void OplogBufferRing::_pushOne(const Value& value) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_lastPushedMutex);
+        _lastPushed = value;
+    }
+    const uint64_t tail = _tail.load();
+    _slots[tail & _slotMask] = value;
+    _sizeBytes.addAndFetch(getDocumentSize(value));
+    _tail.store(tail + 1);
+    _notifyConsumerIfParked();
+}
+
+void OplogBufferRing::_notifyConsumerIfParked() {
+    // The flag is set before the parked side rechecks its condition and the notification takes
+    // the parking mutex, so a wakeup between the recheck and the wait cannot be lost.
+    if (_consumerParked.load()) {
+        stdx::lock_guard<stdx::mutex> lk(_parkMutex);
+        _notEmptyCV.notify_one();
+    }
+}
+
+void OplogBufferRing::_notifyProducerIfParked() {
+    if (_producerParked.load()) {
+        stdx::lock_guard<stdx::mutex> lk(_parkMutex);
+        _notFullCV.notify_one();
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
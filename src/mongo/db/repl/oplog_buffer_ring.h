@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Oplog buffer backed by a bounded single-producer/single-consumer ring of BSONObj slots.
+ *
+ * Unlike OplogBufferBlockingQueue, which takes a mutex on every push and pop, the steady-state
+ * path here is lock free: the producer publishes entries by advancing an atomic tail index and
+ * the consumer retires them by advancing an atomic head index. The parking mutex and condition
+ * variables are touched only on the empty/full transitions, where one side must block anyway.
+ *
+ * Relies on the OplogBuffer contract that there is at most one pusher and one popper. The buffer
+ * is bounded both by a byte budget (like OplogBufferBlockingQueue) and by the slot count of the
+ * ring; push() and waitForSpace() block on whichever limit is hit first. pushEvenIfFull() ignores
+ * the byte budget but, because the ring is a fixed array, must still wait for a free slot in the
+ * (unrealistic with the default configuration) case where all slots are occupied.
+ */
+class OplogBufferRing final : public OplogBuffer {
+public:
+    /**
+     * Default byte budget, matching OplogBufferBlockingQueue's 256MB limit.
+     */
+    static const std::size_t kDefaultMaxSizeBytes;
+
+    /**
+     * Default number of slots in the ring. Chosen so that the byte budget binds first unless the
+     * average entry is smaller than kDefaultMaxSizeBytes / kDefaultSlotCount bytes.
+     */
+    static const std::size_t kDefaultSlotCount;
+
+    explicit OplogBufferRing(std::size_t maxSizeBytes = kDefaultMaxSizeBytes,
+                             std::size_t slotCount = kDefaultSlotCount);
+
+    void startup(OperationContext* opCtx) override;
+    void shutdown(OperationContext* opCtx) override;
+    void pushEvenIfFull(OperationContext* opCtx, const Value& value) override;
+    void push(OperationContext* opCtx, const Value& value) override;
+    void pushAllNonBlocking(OperationContext* opCtx,
+                            Batch::const_iterator begin,
+                            Batch::const_iterator end) override;
+    void waitForSpace(OperationContext* opCtx, std::size_t size) override;
+    bool isEmpty() const override;
+    std::size_t getMaxSize() const override;
+    std::size_t getSize() const override;
+    std::size_t getCount() const override;
+    void clear(OperationContext* opCtx) override;
+    bool tryPop(OperationContext* opCtx, Value* value) override;
+    bool waitForData(Seconds waitDuration) override;
+    bool peek(OperationContext* opCtx, Value* value) override;
+    boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
+
+private:
+    /**
+     * Returns true if "size" more bytes and one more slot fit within the buffer's limits. An
+     * empty buffer always has space so that a single entry larger than the byte budget cannot
+     * wedge the producer.
+     */
+    bool _hasSpaceFor(std::size_t size) const;
+
+    /**
+     * Blocks the producer until at least one ring slot is free, ignoring the byte budget.
+     */
+    void _waitForFreeSlot();
+
+    /**
+     * Writes "value" into the slot at the current tail and publishes it to the consumer. The
+     * caller must have established that a slot is free.
+     */
+    void _pushOne(const Value& value);
+
+    /**
+     * Wakes the consumer if it is parked waiting for data.
+     */
+    void _notifyConsumerIfParked();
+
+    /**
+     * Wakes the producer if it is parked waiting for space.
+     */
+    void _notifyProducerIfParked();
+
+    const std::size_t _maxSizeBytes;
+    const std::size_t _slotCount;
+    const std::size_t _slotMask;
+
+    // Slot "i" of the logical stream lives at _slots[i & _slotMask]. The producer writes a slot
+    // before publishing it via _tail; the consumer clears a slot before retiring it via _head,
+    // so the two sides never touch the same slot concurrently.
+    std::vector<Value> _slots;
+
+    // Index of the next slot the consumer will pop. Written only by the consumer.
+    AtomicUInt64 _head{0};
+
+    // Index of the next slot the producer will fill. Written only by the producer.
+    AtomicUInt64 _tail{0};
+
+    // Total objsize() of the entries currently in the buffer.
+    AtomicInt64 _sizeBytes{0};
+
+    // Copy of the most recently pushed entry, maintained by the producer so lastObjectPushed()
+    // does not have to read a slot the consumer may be concurrently retiring. BSONObj copies
+    // share the underlying buffer, so this is a refcount bump, not a memcpy.
+    mutable stdx::mutex _lastPushedMutex;
+    Value _lastPushed;
+
+    // Parking lot, used only when one side finds the buffer empty (consumer) or full (producer).
+    AtomicBool _consumerParked{false};
+    AtomicBool _producerParked{false};
+    mutable stdx::mutex _parkMutex;
+    stdx::condition_variable _notEmptyCV;
+    stdx::condition_variable _notFullCV;
+};
+
+}  // namespace repl
+}  // namespace mongo
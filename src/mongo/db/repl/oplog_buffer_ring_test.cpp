@@ -0,0 +1,237 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <boost/optional/optional_io.hpp>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_ring.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+BSONObj makeEntry(int i) {
+    return BSON("ts" << i);
+}
+
+TEST(OplogBufferRingTest, PushAndPopMaintainCountAndSize) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getSize());
+
+    const auto entry1 = makeEntry(1);
+    const auto entry2 = makeEntry(2);
+    buffer.push(nullptr, entry1);
+    buffer.push(nullptr, entry2);
+
+    ASSERT_FALSE(buffer.isEmpty());
+    ASSERT_EQUALS(2U, buffer.getCount());
+    ASSERT_EQUALS(std::size_t(entry1.objsize() + entry2.objsize()), buffer.getSize());
+
+    BSONObj popped;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &popped));
+    ASSERT_BSONOBJ_EQ(entry1, popped);
+    ASSERT_TRUE(buffer.tryPop(nullptr, &popped));
+    ASSERT_BSONOBJ_EQ(entry2, popped);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, TryPopAndPeekOnEmptyBufferReturnFalse) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+
+    BSONObj value;
+    ASSERT_FALSE(buffer.tryPop(nullptr, &value));
+    ASSERT_FALSE(buffer.peek(nullptr, &value));
+    ASSERT_EQUALS(boost::none, buffer.lastObjectPushed(nullptr));
+
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, PeekDoesNotRemoveEntry) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+
+    const auto entry = makeEntry(1);
+    buffer.push(nullptr, entry);
+
+    BSONObj peeked;
+    ASSERT_TRUE(buffer.peek(nullptr, &peeked));
+    ASSERT_BSONOBJ_EQ(entry, peeked);
+    ASSERT_EQUALS(1U, buffer.getCount());
+
+    BSONObj popped;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &popped));
+    ASSERT_BSONOBJ_EQ(entry, popped);
+
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, PushAllNonBlockingPreservesOrderAndLastObjectPushed) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+
+    OplogBuffer::Batch batch;
+    for (int i = 0; i < 10; i++) {
+        batch.push_back(makeEntry(i));
+    }
+    buffer.pushAllNonBlocking(nullptr, batch.cbegin(), batch.cend());
+
+    ASSERT_EQUALS(10U, buffer.getCount());
+    ASSERT_BSONOBJ_EQ(batch.back(), *buffer.lastObjectPushed(nullptr));
+
+    for (int i = 0; i < 10; i++) {
+        BSONObj popped;
+        ASSERT_TRUE(buffer.tryPop(nullptr, &popped));
+        ASSERT_BSONOBJ_EQ(batch[i], popped);
+    }
+    ASSERT_TRUE(buffer.isEmpty());
+
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, ClearEmptiesBuffer) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+
+    for (int i = 0; i < 5; i++) {
+        buffer.push(nullptr, makeEntry(i));
+    }
+    buffer.clear(nullptr);
+
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(boost::none, buffer.lastObjectPushed(nullptr));
+
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, WaitForDataTimesOutOnEmptyBuffer) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+
+    ASSERT_FALSE(buffer.waitForData(Seconds(0)));
+
+    buffer.push(nullptr, makeEntry(1));
+    ASSERT_TRUE(buffer.waitForData(Seconds(0)));
+
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, WaitForDataReturnsTrueWhenProducerPushes) {
+    OplogBufferRing buffer;
+    buffer.startup(nullptr);
+
+    stdx::thread producer([&buffer]() { buffer.push(nullptr, makeEntry(1)); });
+    ASSERT_TRUE(buffer.waitForData(Seconds(30)));
+    producer.join();
+
+    BSONObj popped;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &popped));
+    ASSERT_BSONOBJ_EQ(makeEntry(1), popped);
+
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, PushBlocksOnFullBufferUntilConsumerPops) {
+    // A byte budget big enough for one small entry but not two forces the second push to wait.
+    const auto entry = makeEntry(1);
+    OplogBufferRing buffer(static_cast<std::size_t>(entry.objsize()) + 1, 16);
+    buffer.startup(nullptr);
+
+    buffer.push(nullptr, entry);
+
+    stdx::thread producer([&buffer, &entry]() { buffer.push(nullptr, entry); });
+
+    // Drain until the blocked producer's entry comes through.
+    BSONObj popped;
+    while (!buffer.tryPop(nullptr, &popped)) {
+        sleepmillis(1);
+    }
+    producer.join();
+
+    ASSERT_TRUE(buffer.tryPop(nullptr, &popped));
+    ASSERT_BSONOBJ_EQ(entry, popped);
+
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, PushEvenIfFullIgnoresByteBudget) {
+    const auto entry = makeEntry(1);
+    OplogBufferRing buffer(1U, 16);
+    buffer.startup(nullptr);
+
+    buffer.pushEvenIfFull(nullptr, entry);
+    buffer.pushEvenIfFull(nullptr, entry);
+
+    ASSERT_EQUALS(2U, buffer.getCount());
+    ASSERT_GREATER_THAN(buffer.getSize(), buffer.getMaxSize());
+
+    buffer.clear(nullptr);
+    buffer.shutdown(nullptr);
+}
+
+TEST(OplogBufferRingTest, ConcurrentProducerAndConsumerSeeAllEntriesInOrder) {
+    const int kNumEntries = 50000;
+
+    // A small ring forces frequent wrap-around and regular full/empty parking.
+    OplogBufferRing buffer(64 * 1024, 128);
+    buffer.startup(nullptr);
+
+    stdx::thread producer([&buffer]() {
+        for (int i = 0; i < kNumEntries; i++) {
+            buffer.push(nullptr, makeEntry(i));
+        }
+    });
+
+    for (int i = 0; i < kNumEntries; i++) {
+        BSONObj popped;
+        while (!buffer.tryPop(nullptr, &popped)) {
+            buffer.waitForData(Seconds(30));
+        }
+        ASSERT_EQUALS(i, popped["ts"].numberInt());
+    }
+    producer.join();
+
+    ASSERT_TRUE(buffer.isEmpty());
+    buffer.shutdown(nullptr);
+}
+
+}  // namespace
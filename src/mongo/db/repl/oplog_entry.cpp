@@ -88,6 +88,10 @@ StatusWith<OplogEntry> OplogEntry::parse(const BSONObj& object) {
 
 OplogEntry::OplogEntry(BSONObj rawInput)
     : raw(std::move(rawInput)), _commandType(OplogEntry::CommandType::kNotCommand) {
+    // On the fetch-to-apply path this is a no-op: entries popped from the oplog buffer already
+    // share ownership of the network message they were received in, so taking ownership here
+    // bumps a refcount rather than copying the entry bytes. Only callers handing in a view of
+    // some larger unowned buffer pay for a copy.
     raw = raw.getOwned();
 
     parseProtected(IDLParserErrorContext("OplogEntryBase"), raw);
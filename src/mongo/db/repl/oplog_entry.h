@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/repl/oplog_entry_gen.h"
@@ -93,6 +95,13 @@ public:
     // This member is not parsed from the BSON and is instead populated by fillWriterVectors.
     bool isForCappedCollection = false;
 
+    // These members are not parsed from the BSON and are instead populated on the batcher thread
+    // so that the batch-distribution hashing in fillWriterVectors stays off the apply path. The
+    // _id hash is computed without collation awareness and must only be used for collections
+    // without a default collator.
+    boost::optional<uint32_t> preComputedNsHash;
+    boost::optional<size_t> preComputedRawIdHash;
+
     /**
      * Returns if the oplog entry is for a command operation.
      */
@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_fanout_hub.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace repl {
+
+namespace {
+
+const auto getOplogFanoutHub = ServiceContext::declareDecoration<OplogFanoutHub>();
+
+}  // namespace
+
+const size_t OplogFanoutHub::Subscription::kMaxQueueDepth;
+
+OplogFanoutHub::Subscription::Subscription(NamespaceString nss, Timestamp subscribedAfter)
+    : _nss(std::move(nss)), _subscribedAfter(subscribedAfter) {}
+
+boost::optional<BSONObj> OplogFanoutHub::Subscription::tryPop() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_queue.empty()) {
+        return boost::none;
+    }
+    BSONObj entry = std::move(_queue.front());
+    _queue.pop_front();
+    return entry;
+}
+
+bool OplogFanoutHub::Subscription::isOverflowed() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _overflowed;
+}
+
+void OplogFanoutHub::Subscription::_push(const BSONObj& entry) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_overflowed) {
+        return;
+    }
+    if (_queue.size() >= kMaxQueueDepth) {
+        _overflowed = true;
+        return;
+    }
+    _queue.push_back(entry);
+}
+
+OplogFanoutHub& OplogFanoutHub::get(ServiceContext* service) {
+    return getOplogFanoutHub(service);
+}
+
+OplogFanoutHub& OplogFanoutHub::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+uint64_t OplogFanoutHub::_namespaceBloomBit(StringData ns) {
+    // One bit out of 64 per namespace. False positives only cost a subscriber walk that
+    // finds no match; false negatives are impossible because the filter is rebuilt from
+    // the full subscription list whenever it changes.
+    size_t hash = 0;
+    for (char c : ns) {
+        hash = hash * 131 + static_cast<unsigned char>(c);
+    }
+    return 1ULL << (hash % 64);
+}
+
+std::shared_ptr<OplogFanoutHub::Subscription> OplogFanoutHub::subscribe(
+    const NamespaceString& nss) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto subscription = std::make_shared<Subscription>(nss, _lastPublished);
+    _subscriptions.emplace_back(subscription);
+    _compact();
+    return subscription;
+}
+
+void OplogFanoutHub::publish(const BSONObj& oplogEntry) {
+    BSONElement nsElem = oplogEntry["ns"];
+    BSONElement opElem = oplogEntry["op"];
+    if (nsElem.type() != String || opElem.type() != String) {
+        return;
+    }
+
+    // Command entries bypass the bloom filter: a rename or dropDatabase affects
+    // collections other than the one in its "ns" field.
+    const bool isCommand = (opElem.valueStringData() == "c"_sd);
+    if (!isCommand &&
+        !(_namespaceBloom.load() & _namespaceBloomBit(nsElem.valueStringData()))) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _lastPublished = oplogEntry["ts"].timestamp();
+        return;
+    }
+
+    // Share one owned copy of the entry across all subscriber queues.
+    BSONObj owned = oplogEntry.getOwned();
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _lastPublished = owned["ts"].timestamp();
+    bool sawExpired = false;
+    for (auto&& weakSubscription : _subscriptions) {
+        auto subscription = weakSubscription.lock();
+        if (!subscription) {
+            sawExpired = true;
+            continue;
+        }
+        if (isCommand || subscription->nss().ns() == nsElem.valueStringData()) {
+            subscription->_push(owned);
+        }
+    }
+    if (sawExpired) {
+        _compact();
+    }
+}
+
+void OplogFanoutHub::_compact() {
+    uint64_t bloom = 0;
+    auto it = _subscriptions.begin();
+    while (it != _subscriptions.end()) {
+        if (auto subscription = it->lock()) {
+            bloom |= _namespaceBloomBit(subscription->nss().ns());
+            ++it;
+        } else {
+            it = _subscriptions.erase(it);
+        }
+    }
+    _namespaceBloom.store(bloom);
+    _subscriberCount.store(static_cast<long long>(_subscriptions.size()));
+}
+
+}  // namespace repl
+}  // namespace mongo
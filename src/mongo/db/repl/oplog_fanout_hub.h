@@ -0,0 +1,187 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+namespace repl {
+
+/**
+ * Shared in-memory fan-out of committed oplog entries to $changeNotification subscribers.
+ *
+ * Without the hub, every watcher independently tails the oplog collection through the full
+ * query machinery, so each committed write is re-read from the storage engine once per
+ * watcher. The hub lets the oplog write path decode each entry once and hand a shared,
+ * owned copy to every interested subscriber's queue, making the per-write cost independent
+ * of the number of watchers.
+ *
+ * The hub is entirely best-effort from the producer's point of view: while there are no
+ * subscribers, publish() is never called (producers gate on hasSubscribers(), which is a
+ * single relaxed atomic load), and a subscriber that falls too far behind has its queue
+ * marked as overflowed rather than blocking the producer. A consumer that observes
+ * overflow is expected to re-establish its watch through the resume path, which reads the
+ * oplog collection directly.
+ *
+ * A subscription only sees entries whose storage transaction commits after subscribe()
+ * returns; earlier entries are considered "before the watch started".
+ */
+class OplogFanoutHub {
+    MONGO_DISALLOW_COPYING(OplogFanoutHub);
+
+public:
+    /**
+     * A single subscriber's bounded queue of oplog entries. Obtained from subscribe() and
+     * shared between the hub and the consuming stage; the hub drops its reference lazily
+     * once the consumer releases the last shared_ptr.
+     */
+    class Subscription {
+        MONGO_DISALLOW_COPYING(Subscription);
+
+    public:
+        // Maximum number of entries queued per subscriber before the queue overflows. At
+        // this depth the consumer is thousands of getMore round trips behind, so resuming
+        // from the oplog collection is cheaper than holding more memory here.
+        static const size_t kMaxQueueDepth = 10000;
+
+        Subscription(NamespaceString nss, Timestamp subscribedAfter);
+
+        /**
+         * Removes and returns the oldest queued entry, or boost::none if the queue is
+         * empty. Entries returned are owned BSON.
+         */
+        boost::optional<BSONObj> tryPop();
+
+        /**
+         * Returns true if the producer dropped an entry because this queue was full. Once
+         * set, the flag stays set; the subscription's contents can no longer be trusted to
+         * be gap-free and the consumer must resume from the oplog collection.
+         */
+        bool isOverflowed() const;
+
+        /**
+         * Timestamp of the last entry the hub had published when this subscription was
+         * created. Entries at or before this timestamp are never delivered here.
+         */
+        Timestamp subscribedAfter() const {
+            return _subscribedAfter;
+        }
+
+        const NamespaceString& nss() const {
+            return _nss;
+        }
+
+    private:
+        friend class OplogFanoutHub;
+
+        // Called by the hub with an owned BSONObj; sets the overflow flag instead of
+        // growing past kMaxQueueDepth.
+        void _push(const BSONObj& entry);
+
+        const NamespaceString _nss;
+        const Timestamp _subscribedAfter;
+
+        mutable stdx::mutex _mutex;
+        std::deque<BSONObj> _queue;
+        bool _overflowed = false;
+    };
+
+    OplogFanoutHub() = default;
+
+    static OplogFanoutHub& get(ServiceContext* service);
+    static OplogFanoutHub& get(OperationContext* opCtx);
+
+    /**
+     * Registers interest in oplog entries for 'nss'. Entries published after this call
+     * returns will be delivered to the returned subscription; command entries (op == "c")
+     * are delivered to all subscribers since renames and drops name their target
+     * collection inside the "o" field.
+     */
+    std::shared_ptr<Subscription> subscribe(const NamespaceString& nss);
+
+    /**
+     * Returns true if any subscription may be alive. Cheap enough for the oplog write path
+     * to call once per batch; may briefly return true after the last subscriber goes away.
+     */
+    bool hasSubscribers() const {
+        return _subscriberCount.load() > 0;
+    }
+
+    /**
+     * Delivers one committed oplog entry to every matching subscriber. Must be called with
+     * an entry whose storage transaction has committed, in commit order per producer
+     * thread. Copies the entry to owned BSON at most once regardless of subscriber count.
+     */
+    void publish(const BSONObj& oplogEntry);
+
+private:
+    // Returns the bloom filter bit for a namespace, used to skip the subscriber walk for
+    // entries that cannot match any subscription.
+    static uint64_t _namespaceBloomBit(StringData ns);
+
+    // Drops expired subscriptions and recomputes the namespace bloom filter and the
+    // subscriber count. Caller must hold '_mutex'.
+    void _compact();
+
+    mutable stdx::mutex _mutex;
+
+    // Weak references so an abandoned cursor cannot pin its queue forever; expired entries
+    // are compacted during subscribe() and publish().
+    std::vector<std::weak_ptr<Subscription>> _subscriptions;
+
+    // Timestamp of the last published entry; used to stamp new subscriptions.
+    Timestamp _lastPublished;
+
+    // Number of live subscriptions, maintained alongside '_subscriptions' but readable
+    // without the mutex so the write path can gate cheaply.
+    AtomicInt64 _subscriberCount{0};
+
+    // Bitwise OR of the bloom bits of all subscribed namespaces. A CRUD entry whose
+    // namespace bit is absent cannot match any subscriber, so publish() returns without
+    // taking any subscription locks.
+    AtomicUInt64 _namespaceBloom{0};
+};
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_fanout_hub.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+BSONObj makeEntry(Timestamp ts, StringData op, StringData ns) {
+    return BSON("ts" << ts << "h" << 1LL << "v" << 2 << "op" << op << "ns" << ns << "o"
+                     << BSON("_id" << 1));
+}
+
+TEST(OplogFanoutHub, HasNoSubscribersInitially) {
+    OplogFanoutHub hub;
+    ASSERT_FALSE(hub.hasSubscribers());
+
+    auto subscription = hub.subscribe(NamespaceString("test.foo"));
+    ASSERT_TRUE(hub.hasSubscribers());
+}
+
+TEST(OplogFanoutHub, ExpiredSubscriptionsAreCompacted) {
+    OplogFanoutHub hub;
+    auto subscription = hub.subscribe(NamespaceString("test.foo"));
+    ASSERT_TRUE(hub.hasSubscribers());
+
+    // The hub holds only a weak reference, so releasing the subscription expires it; the
+    // next publish that walks the subscriber list drops it and updates the count.
+    subscription.reset();
+    hub.publish(makeEntry(Timestamp(1, 1), "i", "test.foo"));
+    ASSERT_FALSE(hub.hasSubscribers());
+}
+
+TEST(OplogFanoutHub, DeliversMatchingNamespaceOnly) {
+    OplogFanoutHub hub;
+    auto fooSubscription = hub.subscribe(NamespaceString("test.foo"));
+    auto barSubscription = hub.subscribe(NamespaceString("test.bar"));
+
+    hub.publish(makeEntry(Timestamp(1, 1), "i", "test.foo"));
+
+    auto entry = fooSubscription->tryPop();
+    ASSERT_TRUE(static_cast<bool>(entry));
+    ASSERT_EQUALS("test.foo", (*entry)["ns"].str());
+    ASSERT_FALSE(static_cast<bool>(fooSubscription->tryPop()));
+    ASSERT_FALSE(static_cast<bool>(barSubscription->tryPop()));
+}
+
+TEST(OplogFanoutHub, DeliversCommandEntriesToAllSubscribers) {
+    OplogFanoutHub hub;
+    auto fooSubscription = hub.subscribe(NamespaceString("test.foo"));
+    auto barSubscription = hub.subscribe(NamespaceString("test.bar"));
+
+    // A rename names its target inside "o", so command entries bypass namespace filtering.
+    hub.publish(BSON("ts" << Timestamp(1, 1) << "h" << 1LL << "v" << 2 << "op"
+                          << "c"
+                          << "ns"
+                          << "test.$cmd"
+                          << "o"
+                          << BSON("drop"
+                                  << "foo")));
+
+    ASSERT_TRUE(static_cast<bool>(fooSubscription->tryPop()));
+    ASSERT_TRUE(static_cast<bool>(barSubscription->tryPop()));
+}
+
+TEST(OplogFanoutHub, DeliversEntriesInPublishOrder) {
+    OplogFanoutHub hub;
+    auto subscription = hub.subscribe(NamespaceString("test.foo"));
+
+    for (int i = 1; i <= 3; i++) {
+        hub.publish(makeEntry(Timestamp(1, i), "i", "test.foo"));
+    }
+    for (int i = 1; i <= 3; i++) {
+        auto entry = subscription->tryPop();
+        ASSERT_TRUE(static_cast<bool>(entry));
+        ASSERT_EQUALS(Timestamp(1, i), (*entry)["ts"].timestamp());
+    }
+    ASSERT_FALSE(static_cast<bool>(subscription->tryPop()));
+}
+
+TEST(OplogFanoutHub, NewSubscriptionRecordsLastPublishedTimestamp) {
+    OplogFanoutHub hub;
+    auto earlier = hub.subscribe(NamespaceString("test.other"));
+    ASSERT_EQUALS(Timestamp(), earlier->subscribedAfter());
+
+    hub.publish(makeEntry(Timestamp(5, 1), "i", "test.foo"));
+
+    auto subscription = hub.subscribe(NamespaceString("test.foo"));
+    ASSERT_EQUALS(Timestamp(5, 1), subscription->subscribedAfter());
+}
+
+TEST(OplogFanoutHub, OverflowSetsFlagInsteadOfGrowing) {
+    OplogFanoutHub hub;
+    auto subscription = hub.subscribe(NamespaceString("test.foo"));
+
+    for (size_t i = 0; i <= OplogFanoutHub::Subscription::kMaxQueueDepth; i++) {
+        hub.publish(makeEntry(Timestamp(1, static_cast<int>(i + 1)), "i", "test.foo"));
+    }
+    ASSERT_TRUE(subscription->isOverflowed());
+
+    // The queued entries before the overflow are still there, but the flag stays set.
+    size_t popped = 0;
+    while (subscription->tryPop()) {
+        popped++;
+    }
+    ASSERT_EQUALS(OplogFanoutHub::Subscription::kMaxQueueDepth, popped);
+    ASSERT_TRUE(subscription->isOverflowed());
+}
+
+TEST(OplogFanoutHub, PublishedEntriesAreOwned) {
+    OplogFanoutHub hub;
+    auto subscription = hub.subscribe(NamespaceString("test.foo"));
+
+    {
+        BSONObj transient = makeEntry(Timestamp(1, 1), "i", "test.foo");
+        hub.publish(transient);
+    }
+
+    auto entry = subscription->tryPop();
+    ASSERT_TRUE(static_cast<bool>(entry));
+    ASSERT_TRUE(entry->isOwned());
+    ASSERT_EQUALS(Timestamp(1, 1), (*entry)["ts"].timestamp());
+}
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
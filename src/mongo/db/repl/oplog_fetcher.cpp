@@ -32,10 +32,13 @@
 
 #include "mongo/db/repl/oplog_fetcher.h"
 
+#include <algorithm>
+
 #include "mongo/base/counter.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/timer_stats.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
 #include "mongo/util/assert_util.h"
@@ -52,6 +55,17 @@ MONGO_FP_DECLARE(stopReplProducer);
 
 namespace {
 
+// When positive, getMore batch sizes are adapted so that each batch holds roughly this many
+// milliseconds' worth of oplog at the rate entries have been arriving, instead of always
+// requesting the fixed maximum. This keeps batches small and frequent under light load and
+// prevents giant batches from building up under heavy load. A value of 0 (the default)
+// disables the adaptation and preserves the fixed batch size.
+MONGO_EXPORT_SERVER_PARAMETER(oplogFetcherTargetBatchTimeMillis, int, 0);
+
+// Lower bound on adaptive getMore batch sizes so a momentary lull in traffic cannot drive the
+// batch size towards zero and force a getMore round trip per handful of entries.
+const int kMinAdaptiveBatchSize = 100;
+
 // The number and time spent reading batches off the network
 TimerStats getmoreReplStats;
 ServerStatusMetricField<TimerStats> displayBatchesRecieved("repl.network.getmores",
@@ -383,6 +397,22 @@ StatusWith<BSONObj> OplogFetcher::_onSuccessfulBatch(const Fetcher::QueryRespons
     const auto& documents = queryResponse.documents;
     auto firstDocToApply = documents.cbegin();
 
+    // Update the arrival-rate estimate used for adaptive batch sizing. These members are only
+    // accessed from fetcher callbacks, which never run concurrently, so no synchronization is
+    // needed.
+    auto batchArrival = Date_t::now();
+    if (_lastBatchArrival != Date_t()) {
+        auto intervalMs = durationCount<Milliseconds>(batchArrival - _lastBatchArrival);
+        if (intervalMs > 0) {
+            double instantaneousOpsPerMilli = static_cast<double>(documents.size()) / intervalMs;
+            // Exponentially weighted moving average to smooth out per-batch jitter.
+            _opsPerMilli = _opsPerMilli == 0.0
+                ? instantaneousOpsPerMilli
+                : 0.7 * _opsPerMilli + 0.3 * instantaneousOpsPerMilli;
+        }
+    }
+    _lastBatchArrival = batchArrival;
+
     if (!documents.empty()) {
         LOG(2) << "oplog fetcher read " << documents.size()
                << " operations from remote oplog starting at " << documents.front()["ts"]
@@ -491,7 +521,16 @@ StatusWith<BSONObj> OplogFetcher::_onSuccessfulBatch(const Fetcher::QueryRespons
                                     queryResponse.cursorId,
                                     lastCommittedWithCurrentTerm,
                                     _awaitDataTimeout,
-                                    _batchSize);
+                                    _getGetMoreBatchSize());
+}
+
+int OplogFetcher::_getGetMoreBatchSize() const {
+    const auto targetMillis = oplogFetcherTargetBatchTimeMillis.load();
+    if (targetMillis <= 0 || _opsPerMilli == 0.0) {
+        return _batchSize;
+    }
+    auto adaptiveBatchSize = static_cast<int>(_opsPerMilli * targetMillis);
+    return std::min(std::max(adaptiveBatchSize, kMinAdaptiveBatchSize), _batchSize);
 }
 }  // namespace repl
 }  // namespace mongo
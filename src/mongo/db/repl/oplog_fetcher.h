@@ -155,6 +155,13 @@ private:
      */
     StatusWith<BSONObj> _onSuccessfulBatch(const Fetcher::QueryResponse& queryResponse) override;
 
+    /**
+     * Returns the batch size to use for the next getMore. When adaptive batch sizing is enabled
+     * (see 'oplogFetcherTargetBatchTimeMillis'), the size is chosen so the batch holds roughly the
+     * target amount of oplog at the observed arrival rate, capped at the configured batch size.
+     */
+    int _getGetMoreBatchSize() const;
+
     // The metadata object sent with the Fetcher queries.
     const BSONObj _metadataObject;
 
@@ -171,6 +178,12 @@ private:
     const EnqueueDocumentsFn _enqueueDocumentsFn;
     const Milliseconds _awaitDataTimeout;
     const int _batchSize;
+
+    // Smoothed estimate of the rate at which oplog entries arrive from the sync source and the
+    // arrival time of the previous batch. Only accessed from fetcher callbacks, which never run
+    // concurrently, so no synchronization is required.
+    double _opsPerMilli = 0.0;
+    Date_t _lastBatchArrival;
 };
 
 }  // namespace repl
@@ -52,6 +52,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/prefetch.h"
@@ -60,6 +61,7 @@
 #include "mongo/db/repl/initial_syncer.h"
 #include "mongo/db/repl/multiapplier.h"
 #include "mongo/db/repl/oplog.h"
+#include "mongo/db/repl/oplog_fanout_hub.h"
 #include "mongo/db/repl/oplogreader.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/repl_set_config.h"
@@ -137,6 +139,12 @@ public:
     }
 } exportedBatchLimitOperationsParam;
 
+// If set, the batcher thread warms the storage engine cache for the upcoming batch while the
+// previous one is still applying, by reading each CRUD op's target document through the _id
+// index. Only meaningful for storage engines with their own cache (i.e. not MMAPv1, which has
+// its own prefetcher in multiApply).
+MONGO_EXPORT_SERVER_PARAMETER(replPrefetchNextBatch, bool, false);
+
 // The oplog entries applied
 Counter64 opsAppliedStats;
 ServerStatusMetricField<Counter64> displayOpsApplied("repl.apply.ops", &opsAppliedStats);
@@ -607,6 +615,27 @@ private:
     StringMap<CollectionProperties> _cache;
 };
 
+/**
+ * Pre-computes the hashes fillWriterVectors needs for an op. Called on the batcher thread so the
+ * BSON walk and hashing happen while the previous batch is still being applied, instead of on
+ * the apply path. The _id hash is computed without collation awareness; fillWriterVectors only
+ * uses it for collections without a default collator.
+ */
+void precomputeHashesForWriterVectors(OplogEntry* op) {
+    op->preComputedNsHash = StringMapTraits::hash(op->getNamespace().ns());
+
+    if (!op->isCrudOpType()) {
+        return;
+    }
+    const BSONElement idElement = op->getIdElement();
+    if (idElement.eoo()) {
+        return;
+    }
+    const BSONElementComparator elementHasher(BSONElementComparator::FieldNamesMode::kIgnore,
+                                              nullptr);
+    op->preComputedRawIdHash = elementHasher.hash(idElement);
+}
+
 // This only modifies the isForCappedCollection field on each op. It does not alter the ops vector
 // in any other way.
 void fillWriterVectors(OperationContext* opCtx,
@@ -619,22 +648,36 @@ void fillWriterVectors(OperationContext* opCtx,
     CachedCollectionProperties collPropertiesCache;
 
     for (auto&& op : *ops) {
-        StringMapTraits::HashedKey hashedNs(op.getNamespace().ns());
+        StringMapTraits::HashedKey hashedNs = op.preComputedNsHash
+            ? StringMapTraits::HashedKey(op.getNamespace().ns(), *op.preComputedNsHash)
+            : StringMapTraits::HashedKey(op.getNamespace().ns());
         uint32_t hash = hashedNs.hash();
 
         if (op.isCrudOpType()) {
             auto collProperties = collPropertiesCache.getCollectionProperties(opCtx, hashedNs);
 
             // For doc locking engines, include the _id of the document in the hash so we get
-            // parallelism even if all writes are to a single collection.
+            // parallelism even if all writes are to a single collection: apply parallelism then
+            // scales with the number of distinct documents in the batch rather than the number
+            // of collections.
+            //
+            // No separate conflict detection is needed for ops touching the same document.
+            // Two ops with the same (namespace, _id) produce the same hash, land in the same
+            // writer vector, and are applied there in oplog order; only ops for different
+            // documents can ever be applied concurrently.
             //
             // For capped collections, this is illegal, since capped collections must preserve
             // insertion order.
             if (supportsDocLocking && !collProperties.isCapped) {
-                BSONElement id = op.getIdElement();
-                BSONElementComparator elementHasher(BSONElementComparator::FieldNamesMode::kIgnore,
-                                                    collProperties.collator);
-                const size_t idHash = elementHasher.hash(id);
+                size_t idHash;
+                if (op.preComputedRawIdHash && !collProperties.collator) {
+                    idHash = *op.preComputedRawIdHash;
+                } else {
+                    BSONElement id = op.getIdElement();
+                    BSONElementComparator elementHasher(
+                        BSONElementComparator::FieldNamesMode::kIgnore, collProperties.collator);
+                    idHash = elementHasher.hash(id);
+                }
                 MurmurHash3_x86_32(&idHash, sizeof(idHash), hash, &hash);
             }
 
@@ -717,11 +760,13 @@ public:
 
     OpQueue getNextBatch(Seconds maxWaitTime) {
         stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _consumerWaiting.store(true);
         if (_ops.empty() && !_ops.mustShutdown()) {
             // We intentionally don't care about whether this returns due to signaling or timeout
             // since we do the same thing either way: return whatever is in _ops.
             (void)_cv.wait_for(lk, maxWaitTime.toSystemDuration());
         }
+        _consumerWaiting.store(false);
 
         OpQueue ops = std::move(_ops);
         _ops = {};
@@ -735,6 +780,10 @@ private:
         Client::initThread("ReplBatcher");
         const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
         OperationContext& opCtx = *opCtxPtr;
+
+        // Prefetch reads of the next batch must not block behind the ParallelBatchWriterMode
+        // lock held while the previous batch applies; that overlap is the whole point.
+        opCtx.lockState()->setShouldConflictWithSecondaryBatchApplication(false);
         const auto replCoord = ReplicationCoordinator::get(&opCtx);
         const auto fastClockSource = opCtx.getServiceContext()->getFastClockSource();
         const auto oplogMaxSize = fassertStatusOK(40301,
@@ -763,6 +812,11 @@ private:
                 continue;  // Don't emit empty batches.
             }
 
+            if (replPrefetchNextBatch.load() && !ops.mustShutdown() &&
+                !getGlobalServiceContext()->getGlobalStorageEngine()->isMmapV1()) {
+                _prefetchOps(&opCtx, ops);
+            }
+
             stdx::unique_lock<stdx::mutex> lk(_mutex);
             // Block until the previous batch has been taken.
             _cv.wait(lk, [&] { return _ops.empty(); });
@@ -775,8 +829,45 @@ private:
         }
     }
 
+    /**
+     * Reads each CRUD op's target document through the _id index, pulling the index and
+     * document pages into the storage engine cache before the batch is handed to the appliers.
+     * Runs on the batcher thread while the previous batch applies, and backs off as soon as
+     * the applier comes asking for the next batch. Purely advisory: all errors are ignored.
+     */
+    void _prefetchOps(OperationContext* opCtx, const OpQueue& ops) {
+        for (const auto& op : ops.getBatch()) {
+            if (_consumerWaiting.load()) {
+                break;  // The previous batch has finished; don't delay handing this one over.
+            }
+            if (!op.isCrudOpType()) {
+                continue;
+            }
+            const BSONElement idElement = op.getIdElement();
+            if (idElement.eoo()) {
+                continue;
+            }
+            try {
+                const NamespaceString& nss = op.getNamespace();
+                AutoGetCollectionForRead autoColl(opCtx, nss);
+                if (!autoColl.getCollection()) {
+                    continue;
+                }
+                BSONObj unusedResult;
+                Helpers::findById(
+                    opCtx, autoColl.getDb(), nss.ns(), idElement.wrap(), unusedResult);
+            } catch (const DBException& e) {
+                LOG(2) << "ignoring exception while prefetching next oplog batch: " << redact(e);
+            }
+            opCtx->recoveryUnit()->abandonSnapshot();
+        }
+    }
+
     SyncTail* const _syncTail;
 
+    // Set while the applier is inside getNextBatch() waiting for a batch.
+    AtomicBool _consumerWaiting{false};
+
     stdx::mutex _mutex;  // Guards _ops.
     stdx::condition_variable _cv;
     OpQueue _ops;
@@ -954,7 +1045,9 @@ bool SyncTail::tryPopAndWaitForMore(OperationContext* opCtx,
         return true;
     }
 
-    // We are going to apply this Op.
+    // We are going to apply this Op. Pre-compute the writer-vector hashes here, on the batcher
+    // thread, so fillWriterVectors does not redo the work per op on the apply path.
+    precomputeHashesForWriterVectors(&entry);
     _networkQueue->consume(opCtx);
 
     // Go back for more ops, unless we've hit the limit.
@@ -1366,6 +1459,16 @@ StatusWith<OpTime> multiApply(OperationContext* opCtx,
         }
     }
 
+    // Hand the applied batch to any in-memory $changeNotification subscribers. The batch
+    // and its database writes are fully durable at this point, so the entries are safe to
+    // surface to watchers.
+    auto& fanoutHub = OplogFanoutHub::get(opCtx);
+    if (fanoutHub.hasSubscribers()) {
+        for (auto&& op : ops) {
+            fanoutHub.publish(op.raw);
+        }
+    }
+
     // We have now written all database writes and updated the oplog to match.
     return ops.back().getOpTime();
 }
@@ -137,6 +137,10 @@ public:
             invariant(!_batch.empty());
             return _batch.back();
         }
+        OplogEntry& back() {
+            invariant(!_batch.empty());
+            return _batch.back();
+        }
         const std::vector<OplogEntry>& getBatch() const {
             return _batch;
         }
@@ -32,6 +32,7 @@
 
 #include "mongo/db/s/migration_destination_manager.h"
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -63,6 +64,8 @@
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/queue.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -668,6 +671,11 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx,
         MONGO_FAIL_POINT_PAUSE_WHILE_SET(migrateThreadHangAtStep2);
     }
 
+    // The last opTime applied locally during the initial clone.  Written by the inserter thread
+    // in step 3 (which performs all the clone writes) and read by the migrate thread after the
+    // inserter thread has been joined.
+    repl::OpTime lastOpApplied;
+
     {
         // 3. Initial bulk clone
         setState(CLONE);
@@ -676,79 +684,135 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx,
 
         _chunkMarkedPending = true;  // no lock needed, only the migrate thread looks.
 
-        while (true) {
-            BSONObj res;
-            if (!conn->runCommand("admin",
-                                  migrateCloneRequest,
-                                  res)) {  // gets array of objects to copy, in disk order
-                setStateFail(str::stream() << "_migrateClone failed: " << redact(res.toString()));
-                conn.done();
-                return;
-            }
+        // Fetching and applying the clone batches is pipelined: the migrate thread keeps issuing
+        // _migrateClone requests to the donor while the inserter thread applies the previously
+        // fetched batch, overlapping the network round trip with the local writes.  The queue is
+        // bounded so the donor stays at most two batches ahead of the writes.
+        BlockingQueue<BSONObj> batches(2);
 
-            BSONObj arr = res["objects"].Obj();
-            int thisTime = 0;
+        stdx::thread inserterThread([&] {
+            Client::initThread("chunkInserter");
+            auto inserterOpCtx = getGlobalServiceContext()->makeOperationContext(&cc());
 
-            BSONObjIterator i(arr);
-            while (i.more()) {
-                opCtx->checkForInterrupt();
+            if (getGlobalAuthorizationManager()->isAuthEnabled()) {
+                AuthorizationSession::get(inserterOpCtx->getClient())->grantInternalAuthorization();
+            }
 
-                if (getState() == ABORT) {
-                    log() << "Migration aborted while copying documents";
+            while (true) {
+                BSONObj arr = batches.blockingPop();
+                if (arr.isEmpty()) {
+                    // Empty sentinel pushed by the migrate thread once there are no more batches.
                     return;
                 }
 
-                BSONObj docToClone = i.next().Obj();
-                {
-                    OldClientWriteContext cx(opCtx, _nss.ns());
-
-                    BSONObj localDoc;
-                    if (willOverrideLocalId(opCtx,
-                                            _nss,
-                                            min,
-                                            max,
-                                            shardKeyPattern,
-                                            cx.db(),
-                                            docToClone,
-                                            &localDoc)) {
-                        string errMsg = str::stream() << "cannot migrate chunk, local document "
-                                                      << redact(localDoc)
-                                                      << " has same _id as cloned "
-                                                      << "remote document " << redact(docToClone);
-
-                        warning() << errMsg;
-
-                        // Exception will abort migration cleanly
-                        uasserted(16976, errMsg);
+                if (getState() == FAIL || getState() == ABORT) {
+                    // Keep draining the queue so the migrate thread never blocks on a full queue.
+                    continue;
+                }
+
+                try {
+                    BSONObjIterator i(arr);
+                    while (i.more()) {
+                        inserterOpCtx->checkForInterrupt();
+
+                        if (getState() == ABORT) {
+                            // Stop applying, but keep consuming batches from the queue so the
+                            // migrate thread never blocks on a full queue.
+                            log() << "Migration aborted while copying documents";
+                            break;
+                        }
+
+                        BSONObj docToClone = i.next().Obj();
+                        {
+                            OldClientWriteContext cx(inserterOpCtx.get(), _nss.ns());
+
+                            BSONObj localDoc;
+                            if (willOverrideLocalId(inserterOpCtx.get(),
+                                                    _nss,
+                                                    min,
+                                                    max,
+                                                    shardKeyPattern,
+                                                    cx.db(),
+                                                    docToClone,
+                                                    &localDoc)) {
+                                string errMsg = str::stream()
+                                    << "cannot migrate chunk, local document " << redact(localDoc)
+                                    << " has same _id as cloned "
+                                    << "remote document " << redact(docToClone);
+
+                                warning() << errMsg;
+
+                                // Exception will abort migration cleanly
+                                uasserted(16976, errMsg);
+                            }
+
+                            Helpers::upsert(inserterOpCtx.get(), _nss.ns(), docToClone, true);
+                        }
+
+                        lastOpApplied =
+                            repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
+
+                        {
+                            stdx::lock_guard<stdx::mutex> statsLock(_mutex);
+                            _numCloned++;
+                            _clonedBytes += docToClone.objsize();
+                        }
+
+                        if (writeConcern.shouldWaitForOtherNodes()) {
+                            repl::ReplicationCoordinator::StatusAndDuration replStatus =
+                                repl::getGlobalReplicationCoordinator()->awaitReplication(
+                                    inserterOpCtx.get(), lastOpApplied, writeConcern);
+                            if (replStatus.status.code() == ErrorCodes::WriteConcernFailed) {
+                                warning() << "secondaryThrottle on, but doc insert timed out; "
+                                             "continuing";
+                            } else {
+                                massertStatusOK(replStatus.status);
+                            }
+                        }
                     }
+                } catch (const DBException& e) {
+                    setStateFail(str::stream() << "error applying cloned documents: "
+                                               << redact(e.toString()));
+                }
+            }
+        });
 
-                    Helpers::upsert(opCtx, _nss.ns(), docToClone, true);
+        {
+            // Join the inserter thread even if fetching throws, so its captures never dangle.
+            auto inserterJoinGuard = MakeGuard([&] {
+                batches.push(BSONObj());
+                inserterThread.join();
+            });
+
+            while (true) {
+                opCtx->checkForInterrupt();
+
+                if (getState() == FAIL || getState() == ABORT) {
+                    break;
                 }
-                thisTime++;
 
-                {
-                    stdx::lock_guard<stdx::mutex> statsLock(_mutex);
-                    _numCloned++;
-                    _clonedBytes += docToClone.objsize();
+                BSONObj res;
+                if (!conn->runCommand("admin",
+                                      migrateCloneRequest,
+                                      res)) {  // gets array of objects to copy, in disk order
+                    setStateFail(str::stream() << "_migrateClone failed: "
+                                               << redact(res.toString()));
+                    conn.done();
+                    break;
                 }
 
-                if (writeConcern.shouldWaitForOtherNodes()) {
-                    repl::ReplicationCoordinator::StatusAndDuration replStatus =
-                        repl::getGlobalReplicationCoordinator()->awaitReplication(
-                            opCtx,
-                            repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp(),
-                            writeConcern);
-                    if (replStatus.status.code() == ErrorCodes::WriteConcernFailed) {
-                        warning() << "secondaryThrottle on, but doc insert timed out; "
-                                     "continuing";
-                    } else {
-                        massertStatusOK(replStatus.status);
-                    }
+                // The batch is handed off to the inserter thread and outlives 'res'.
+                BSONObj arr = res["objects"].Obj().getOwned();
+                if (arr.isEmpty()) {
+                    break;
                 }
+
+                batches.push(arr);
             }
+        }
 
-            if (thisTime == 0)
-                break;
+        if (getState() == FAIL || getState() == ABORT) {
+            return;
         }
 
         timing.done(3);
@@ -756,8 +820,10 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx,
     }
 
     // If running on a replicated system, we'll need to flush the docs we cloned to the
-    // secondaries
-    repl::OpTime lastOpApplied = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+    // secondaries.  Writes made on the migrate thread before the clone (e.g. collection and index
+    // creation) may carry a later opTime than the last clone write, so take the later of the two.
+    lastOpApplied =
+        std::max(lastOpApplied, repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp());
 
     const BSONObj xferModsRequest = createTransferModsRequest(_nss, *_sessionId);
 
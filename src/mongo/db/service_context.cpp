@@ -137,8 +137,14 @@ ServiceContext::ServiceContext()
       _preciseClockSource(stdx::make_unique<SystemClockSource>()) {}
 
 ServiceContext::~ServiceContext() {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
-    invariant(_clients.empty());
+    for (auto&& bucket : _clientBuckets) {
+        stdx::lock_guard<stdx::mutex> lk(bucket.mutex);
+        invariant(bucket.clients.empty());
+    }
+}
+
+ServiceContext::ClientBucket& ServiceContext::_bucketFor(const Client* client) {
+    return _clientBuckets[std::hash<const Client*>()(client) % kNumClientBuckets];
 }
 
 ServiceContext::UniqueClient ServiceContext::makeClient(std::string desc,
@@ -161,8 +167,9 @@ ServiceContext::UniqueClient ServiceContext::makeClient(std::string desc,
         throw;
     }
     {
-        stdx::lock_guard<stdx::mutex> lk(_mutex);
-        invariant(_clients.insert(client.get()).second);
+        ClientBucket& bucket = _bucketFor(client.get());
+        stdx::lock_guard<stdx::mutex> lk(bucket.mutex);
+        invariant(bucket.clients.insert(client.get()).second);
     }
     return UniqueClient(client.release());
 }
@@ -228,8 +235,9 @@ void ServiceContext::setServiceExecutor(std::unique_ptr<transport::ServiceExecut
 void ServiceContext::ClientDeleter::operator()(Client* client) const {
     ServiceContext* const service = client->getServiceContext();
     {
-        stdx::lock_guard<stdx::mutex> lk(service->_mutex);
-        invariant(service->_clients.erase(client));
+        ClientBucket& bucket = service->_bucketFor(client);
+        stdx::lock_guard<stdx::mutex> lk(bucket.mutex);
+        invariant(bucket.clients.erase(client));
     }
     try {
         for (const auto& observer : service->_clientObservers) {
@@ -288,11 +296,20 @@ void ServiceContext::registerClientObserver(std::unique_ptr<ClientObserver> obse
 }
 
 ServiceContext::LockedClientsCursor::LockedClientsCursor(ServiceContext* service)
-    : _lock(service->_mutex), _curr(service->_clients.cbegin()), _end(service->_clients.cend()) {}
+    : _service(service), _bucketLock(service->_clientBuckets[0].mutex) {
+    _curr = service->_clientBuckets[0].clients.cbegin();
+    _end = service->_clientBuckets[0].clients.cend();
+}
 
 Client* ServiceContext::LockedClientsCursor::next() {
-    if (_curr == _end)
-        return nullptr;
+    while (_curr == _end) {
+        if (_bucketIndex + 1 == kNumClientBuckets)
+            return nullptr;
+        ClientBucket& bucket = _service->_clientBuckets[++_bucketIndex];
+        _bucketLock = stdx::unique_lock<stdx::mutex>(bucket.mutex);
+        _curr = bucket.clients.cbegin();
+        _end = bucket.clients.cend();
+    }
     Client* result = *_curr;
     ++_curr;
     return result;
@@ -322,13 +339,12 @@ void appendStorageEngineList(BSONObjBuilder* result) {
 }
 
 void ServiceContext::setKillAllOperations() {
-    stdx::lock_guard<stdx::mutex> clientLock(_mutex);
-
-    // Ensure that all newly created operation contexts will immediately be in the interrupted state
+    // Ensure that all newly created operation contexts will immediately be in the interrupted
+    // state, before visiting the operations that already exist.
     _globalKill.store(true);
 
     // Interrupt all active operations
-    for (auto&& client : _clients) {
+    for (LockedClientsCursor cursor(this); Client* client = cursor.next();) {
         stdx::lock_guard<Client> lk(*client);
         auto opCtxToKill = client->getOperationContext();
         if (opCtxToKill) {
@@ -337,6 +353,7 @@ void ServiceContext::setKillAllOperations() {
     }
 
     // Notify any listeners who need to reach to the server shutting down
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
     for (const auto listener : _killOpListeners) {
         try {
             listener->interruptAll();
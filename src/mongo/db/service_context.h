@@ -164,8 +164,11 @@ public:
     class LockedClientsCursor {
     public:
         /**
-         * Constructs a cursor for enumerating the clients of "service", blocking "service" from
-         * creating or destroying Client objects until this instance is destroyed.
+         * Constructs a cursor for enumerating the clients of "service". Client registrations
+         * are striped over several independently locked buckets; the cursor holds the lock of
+         * the bucket it is currently positioned in, so the most recently returned Client is
+         * guaranteed live until the cursor advances past its bucket or is destroyed, but
+         * clients in other buckets may be created or destroyed during the enumeration.
          */
         explicit LockedClientsCursor(ServiceContext* service);
 
@@ -175,7 +178,9 @@ public:
         Client* next();
 
     private:
-        stdx::unique_lock<stdx::mutex> _lock;
+        ServiceContext* const _service;
+        size_t _bucketIndex = 0;
+        stdx::unique_lock<stdx::mutex> _bucketLock;
         ClientSet::const_iterator _curr;
         ClientSet::const_iterator _end;
     };
@@ -509,7 +514,21 @@ private:
      * Vector of registered observers.
      */
     std::vector<std::unique_ptr<ClientObserver>> _clientObservers;
-    ClientSet _clients;
+
+    /**
+     * Live clients, striped over independently locked buckets keyed by client pointer so
+     * connection setup and teardown on different threads do not contend on a single mutex, and
+     * so enumerating cursors stall at most one stripe of registrations at a time.
+     */
+    struct ClientBucket {
+        stdx::mutex mutex;
+        ClientSet clients;
+    };
+
+    static const size_t kNumClientBuckets = 16;
+    ClientBucket _clientBuckets[kNumClientBuckets];
+
+    ClientBucket& _bucketFor(const Client* client);
 
     std::unique_ptr<TickSource> _tickSource;
 
@@ -64,6 +64,7 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_shape_metrics.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/rpc/factory.h"
 #include "mongo/rpc/metadata.h"
@@ -1124,6 +1125,10 @@ DbResponse ServiceEntryPointMongod::handleRequest(OperationContext* opCtx, const
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
             currentOp.getReadWriteType());
 
+    if (!debug.queryShapeKey.empty()) {
+        QueryShapeMetrics::get()->record(currentOp.getNS(), debug.queryShapeKey, debug);
+    }
+
     const bool shouldSample = serverGlobalParams.sampleRate == 1.0
         ? true
         : c.getPrng().nextCanonicalDouble() < serverGlobalParams.sampleRate;
@@ -30,15 +30,26 @@
 
 #include "mongo/db/sessions_collection.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/logical_session_id.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+// The number of statements to pack into each bulk command sent to the sessions collection.
+MONGO_EXPORT_SERVER_PARAMETER(sessionsCollectionBatchSize, int, 1000);
+
+// Milliseconds to pause between consecutive bulk commands within a single refresh or removal
+// pass. The default of zero sends batches back-to-back; setting a pacing delay spreads the
+// periodic session writes over the refresh interval instead of issuing them as one burst.
+MONGO_EXPORT_SERVER_PARAMETER(sessionsCollectionBatchPacingMillis, int, 0);
+
 namespace {
 
 BSONObj lsidQuery(const LogicalSessionId& lsid) {
@@ -75,6 +86,8 @@ Status runBulkCmd(StringData label,
                   SendBatchFn&& sendBatch,
                   const Container& items) {
     int i = 0;
+    const int batchSize = std::max(1, sessionsCollectionBatchSize.load());
+    const Milliseconds batchPacing{sessionsCollectionBatchPacingMillis.load()};
     BufBuilder buf;
 
     boost::optional<BSONObjBuilder> batchBuilder;
@@ -97,12 +110,16 @@ Status runBulkCmd(StringData label,
     for (const auto& item : items) {
         addLine(&(entries.get()), item);
 
-        if (++i >= 1000) {
+        if (++i >= batchSize) {
             auto res = sendLocalBatch();
             if (!res.isOK()) {
                 return res;
             }
 
+            if (batchPacing > Milliseconds::zero()) {
+                sleepFor(batchPacing);
+            }
+
             setupBatchBuilder();
             i = 0;
         }
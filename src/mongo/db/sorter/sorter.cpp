@@ -79,6 +79,17 @@ inline std::string myErrnoWithDescription() {
     return sb.str();
 }
 
+// FNV-1a over the on-disk block payload. Cheap and dependency-free; spill files never outlive
+// the process, so the algorithm only has to match between the writer and the reader.
+inline uint32_t blockChecksum(const char* data, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 template <typename Data, typename Comparator>
 void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs) {
 #if defined(MONGO_CONFIG_DEBUG_BUILD) && !defined(_MSC_VER)
@@ -200,6 +211,10 @@ private:
         if (_done)
             return;
 
+        uint32_t expectedChecksum;
+        read(&expectedChecksum, sizeof(expectedChecksum));
+        massert(40698, "file too short?", !_done);
+
         // negative size means compressed
         const bool compressed = rawSize < 0;
         int32_t blockSize = std::abs(rawSize);
@@ -208,6 +223,11 @@ private:
         read(_buffer.get(), blockSize);
         massert(16816, "file too short?", !_done);
 
+        massert(40699,
+                str::stream() << "checksum mismatch in external sort file \"" << _fileName
+                              << "\"; the file was corrupted while spilled",
+                blockChecksum(_buffer.get(), blockSize) == expectedChecksum);
+
         auto encryptionHooks = EncryptionHooks::get(getGlobalServiceContext());
         if (encryptionHooks->enabled()) {
             std::unique_ptr<char[]> out(new char[blockSize]);
@@ -412,28 +432,41 @@ public:
         verify(_opts.limit == 0);
     }
 
+    ~NoLimitSorter() {
+        joinSpillWorker();
+    }
+
     void add(const Key& key, const Value& val) {
         _data.push_back(std::make_pair(key, val));
 
         _memUsed += key.memUsageForSorter();
         _memUsed += val.memUsageForSorter();
 
-        if (_memUsed > _opts.maxMemoryUsageBytes)
+        // When runs are spilled on the worker thread, one run may be in flight while we keep
+        // accumulating the next; spilling at half the budget keeps the sum of both near the
+        // configured limit.
+        const size_t spillThreshold =
+            _opts.extSortAllowed ? _opts.maxMemoryUsageBytes / 2 : _opts.maxMemoryUsageBytes;
+        if (_memUsed > spillThreshold)
             spill();
     }
 
     Iterator* done() {
-        if (_iters.empty()) {
+        if (!_spillWorker.joinable()) {
             sort();
             return new InMemIterator<Key, Value>(_data);
         }
 
         spill();
+        joinSpillWorker();
+        if (_spillException)
+            std::rethrow_exception(_spillException);
         return Iterator::merge(_iters, _opts, _comp);
     }
 
     // TEMP these are here for compatibility. Will be replaced with a general stats API
     int numFiles() const {
+        stdx::lock_guard<stdx::mutex> lk(_spillMutex);
         return _iters.size();
     }
     size_t memUsed() const {
@@ -479,24 +512,94 @@ private:
                           << " Pass allowDiskUse:true to opt in.");
         }
 
-        sort();
-
-        SortedFileWriter<Key, Value> writer(_opts, _settings);
-        for (; !_data.empty(); _data.pop_front()) {
-            writer.addAlreadySorted(_data.front().first, _data.front().second);
+        if (!_spillWorker.joinable())
+            _spillWorker = stdx::thread([this] { spillLoop(); });
+
+        {
+            stdx::unique_lock<stdx::mutex> lk(_spillMutex);
+            // Hand the run off once the worker is idle, so at most one run is being sorted
+            // and written while we accumulate the next one.
+            _spillCv.wait(lk, [this] {
+                return (_pendingSpills.empty() && !_spillInProgress) || _spillException;
+            });
+            if (_spillException)
+                std::rethrow_exception(_spillException);
+            _pendingSpills.push_back(std::move(_data));
         }
+        _spillCv.notify_all();
 
-        _iters.push_back(std::shared_ptr<Iterator>(writer.done()));
-
+        _data.clear();
         _memUsed = 0;
     }
 
+    /// Body of the spill worker thread: sorts and writes runs queued by spill().
+    void spillLoop() {
+        while (true) {
+            std::deque<Data> run;
+            {
+                stdx::unique_lock<stdx::mutex> lk(_spillMutex);
+                _spillCv.wait(lk, [this] { return !_pendingSpills.empty() || _spillDone; });
+                if (_pendingSpills.empty())
+                    return;
+                run = std::move(_pendingSpills.front());
+                _pendingSpills.pop_front();
+                _spillInProgress = true;
+            }
+
+            try {
+                STLComparator less(_comp);
+                std::stable_sort(run.begin(), run.end(), less);
+
+                SortedFileWriter<Key, Value> writer(_opts, _settings);
+                for (; !run.empty(); run.pop_front()) {
+                    writer.addAlreadySorted(run.front().first, run.front().second);
+                }
+
+                std::shared_ptr<Iterator> iter(writer.done());
+                stdx::lock_guard<stdx::mutex> lk(_spillMutex);
+                _iters.push_back(iter);
+                _spillInProgress = false;
+            } catch (...) {
+                stdx::lock_guard<stdx::mutex> lk(_spillMutex);
+                if (!_spillException)
+                    _spillException = std::current_exception();
+                _spillInProgress = false;
+                // Keep consuming (and discarding) runs so the producer doesn't block
+                // forever; it rethrows the captured exception on its next spill() or done().
+            }
+            _spillCv.notify_all();
+        }
+    }
+
+    /// Signals the spill worker to exit and joins it. Safe to call repeatedly.
+    void joinSpillWorker() {
+        if (!_spillWorker.joinable())
+            return;
+        {
+            stdx::lock_guard<stdx::mutex> lk(_spillMutex);
+            _spillDone = true;
+        }
+        _spillCv.notify_all();
+        _spillWorker.join();
+    }
+
     const Comparator _comp;
     const Settings _settings;
     SortOptions _opts;
     size_t _memUsed;
-    std::deque<Data> _data;                         // the "current" data
+    std::deque<Data> _data;  // the "current" data
+
+    // Background run spilling: spill() moves the filled run onto _pendingSpills and continues
+    // accumulating while the worker thread sorts it, writes it, and appends the resulting file
+    // iterator to _iters. All five members below are guarded by _spillMutex.
+    mutable stdx::mutex _spillMutex;
+    stdx::condition_variable _spillCv;
+    std::deque<std::deque<Data>> _pendingSpills;
     std::vector<std::shared_ptr<Iterator>> _iters;  // data that has already been spilled
+    std::exception_ptr _spillException;
+    bool _spillInProgress = false;
+    bool _spillDone = false;
+    stdx::thread _spillWorker;
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -613,9 +716,23 @@ public:
         _memUsed -= _data.front().first.memUsageForSorter();
         _memUsed -= _data.front().second.memUsageForSorter();
 
-        std::pop_heap(_data.begin(), _data.end(), less);
-        _data.back() = contender;
-        std::push_heap(_data.begin(), _data.end(), less);
+        // Replace the worst pair (the root of the heap) with the contender and sift it down to
+        // its final position. This makes a single top-down pass rather than the two passes (one
+        // down, one back up) that std::pop_heap followed by std::push_heap would perform.
+        const size_t size = _data.size();
+        size_t hole = 0;
+        while (true) {
+            size_t child = 2 * hole + 1;
+            if (child >= size)
+                break;
+            if (child + 1 < size && less(_data[child], _data[child + 1]))
+                child += 1;  // The right child is worse.
+            if (!less(contender, _data[child]))
+                break;
+            _data[hole] = std::move(_data[child]);
+            hole = child;
+        }
+        _data[hole] = std::move(contender);
 
         if (_memUsed > _opts.maxMemoryUsageBytes)
             spill();
@@ -835,6 +952,13 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts, const Se
 
     // throw on failure
     _file.exceptions(std::ios::failbit | std::ios::badbit | std::ios::eofbit);
+
+    _writer = stdx::thread([this] { writeLoop(); });
+}
+
+template <typename Key, typename Value>
+SortedFileWriter<Key, Value>::~SortedFileWriter() {
+    joinWriter();
 }
 
 template <typename Key, typename Value>
@@ -848,22 +972,83 @@ void SortedFileWriter<Key, Value>::addAlreadySorted(const Key& key, const Value&
 
 template <typename Key, typename Value>
 void SortedFileWriter<Key, Value>::spill() {
-    namespace str = mongoutils::str;
+    const int32_t size = _buffer.len();
+    if (size == 0)
+        return;
+
+    {
+        stdx::unique_lock<stdx::mutex> lk(_writerMutex);
+        // Double buffering: let the writer fall at most kMaxPendingBlocks behind before
+        // applying backpressure.
+        _writerCv.wait(
+            lk, [this] { return _pending.size() < kMaxPendingBlocks || _writerException; });
+        if (_writerException) {
+            auto exception = _writerException;
+            lk.unlock();
+            std::rethrow_exception(exception);
+        }
+        _pending.push_back(PendingBlock{_buffer.release(), size});
+    }
+    _writerCv.notify_all();
 
-    int32_t size = _buffer.len();
-    char* outBuffer = _buffer.buf();
+    _buffer = BufBuilder();
+}
 
-    if (size == 0)
+template <typename Key, typename Value>
+void SortedFileWriter<Key, Value>::writeLoop() {
+    while (true) {
+        PendingBlock block{SharedBuffer(), 0};
+        {
+            stdx::unique_lock<stdx::mutex> lk(_writerMutex);
+            _writerCv.wait(lk, [this] { return !_pending.empty() || _writerDone; });
+            if (_pending.empty())
+                return;
+            block = std::move(_pending.front());
+            _pending.pop_front();
+        }
+        // Unblock a spill() waiting for queue space before doing the slow work.
+        _writerCv.notify_all();
+
+        try {
+            writeBlock(block.data.get(), block.len);
+        } catch (...) {
+            stdx::lock_guard<stdx::mutex> lk(_writerMutex);
+            if (!_writerException)
+                _writerException = std::current_exception();
+            // Keep consuming (and discarding) blocks so the producer doesn't block forever;
+            // it will rethrow the captured exception on its next spill() or done().
+        }
+        _writerCv.notify_all();
+    }
+}
+
+template <typename Key, typename Value>
+void SortedFileWriter<Key, Value>::joinWriter() {
+    if (!_writer.joinable())
         return;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_writerMutex);
+        _writerDone = true;
+    }
+    _writerCv.notify_all();
+    _writer.join();
+}
+
+template <typename Key, typename Value>
+void SortedFileWriter<Key, Value>::writeBlock(const char* data, int32_t inputSize) {
+    namespace str = mongoutils::str;
+
+    int32_t size = inputSize;
+    const char* outBuffer = data;
 
     std::string compressed;
     snappy::Compress(outBuffer, size, &compressed);
     verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress = compressed.size() < size_t(inputSize / 10 * 9);
     if (shouldCompress) {
         size = compressed.size();
-        outBuffer = const_cast<char*>(compressed.data());
+        outBuffer = compressed.data();
     }
 
     std::unique_ptr<char[]> out;
@@ -884,10 +1069,15 @@ void SortedFileWriter<Key, Value>::spill() {
         size = resultLen;
     }
 
+    // Checksum the payload exactly as it will land on disk so the reader can verify it
+    // before decryption and decompression.
+    const uint32_t checksum = sorter::blockChecksum(outBuffer, size);
+
     // negative size means compressed
     size = shouldCompress ? -size : size;
     try {
         _file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        _file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
         _file.write(outBuffer, std::abs(size));
 
     } catch (const std::exception&) {
@@ -895,13 +1085,14 @@ void SortedFileWriter<Key, Value>::spill() {
                     str::stream() << "error writing to file \"" << _fileName << "\": "
                                   << sorter::myErrnoWithDescription());
     }
-
-    _buffer.reset();
 }
 
 template <typename Key, typename Value>
 SortIteratorInterface<Key, Value>* SortedFileWriter<Key, Value>::done() {
     spill();
+    joinWriter();
+    if (_writerException)
+        std::rethrow_exception(_writerException);
     _file.close();
     return new sorter::FileIterator<Key, Value>(_fileName, _settings, _fileDeleter);
 }
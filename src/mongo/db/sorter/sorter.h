@@ -29,6 +29,7 @@
 #pragma once
 
 #include <deque>
+#include <exception>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -37,6 +38,9 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/util/builder.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 
 /**
  * This is the public API for the Sorter (both in-memory and external)
@@ -192,6 +196,7 @@ public:
         Settings;
 
     explicit SortedFileWriter(const SortOptions& opts, const Settings& settings = Settings());
+    ~SortedFileWriter();
 
     void addAlreadySorted(const Key&, const Value&);
     Iterator* done();  /// Can't add more data after calling done()
@@ -199,11 +204,37 @@ public:
 private:
     void spill();
 
+    /// Body of the background writer thread; consumes blocks queued by spill().
+    void writeLoop();
+
+    /// Compresses (and optionally encrypts) one block and appends it to the file.
+    void writeBlock(const char* data, int32_t size);
+
+    /// Signals the writer thread to exit and joins it. Safe to call repeatedly.
+    void joinWriter();
+
     const Settings _settings;
     std::string _fileName;
     std::shared_ptr<sorter::FileDeleter> _fileDeleter;  // Must outlive _file
     std::ofstream _file;
     BufBuilder _buffer;
+
+    struct PendingBlock {
+        SharedBuffer data;
+        int32_t len;
+    };
+
+    // Double-buffered asynchronous writeback: spill() hands filled buffers to the writer
+    // thread and keeps accumulating while the previous block is compressed and written. If
+    // the writer falls more than kMaxPendingBlocks behind, spill() blocks. Errors raised on
+    // the writer thread are captured and rethrown on the next spill() or done().
+    static const size_t kMaxPendingBlocks = 2;
+    stdx::mutex _writerMutex;
+    stdx::condition_variable _writerCv;
+    std::deque<PendingBlock> _pending;
+    std::exception_ptr _writerException;
+    bool _writerDone = false;
+    stdx::thread _writer;
 };
 }
 
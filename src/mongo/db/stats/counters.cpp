@@ -41,41 +41,63 @@ namespace mongo {
 
 using std::endl;
 
+constexpr size_t StripedCounter64::kNumStripes;
+
+size_t StripedCounter64::stripeForCurrentThread() {
+    static AtomicUInt32 nextStripe;
+    static const thread_local size_t stripe = nextStripe.fetchAndAdd(1) % kNumStripes;
+    return stripe;
+}
+
+long long StripedCounter64::sum() const {
+    long long total = 0;
+    for (size_t i = 0; i < kNumStripes; i++) {
+        total += _stripes[i].loadRelaxed();
+    }
+    return total;
+}
+
+void StripedCounter64::reset() {
+    for (size_t i = 0; i < kNumStripes; i++) {
+        _stripes[i].store(0);
+    }
+}
+
 OpCounters::OpCounters() {}
 
 void OpCounters::gotInserts(int n) {
     RARELY _checkWrap();
-    _insert.fetchAndAdd(n);
+    _insert.increment(n);
 }
 
 void OpCounters::gotInsert() {
     RARELY _checkWrap();
-    _insert.fetchAndAdd(1);
+    _insert.increment(1);
 }
 
 void OpCounters::gotQuery() {
     RARELY _checkWrap();
-    _query.fetchAndAdd(1);
+    _query.increment(1);
 }
 
 void OpCounters::gotUpdate() {
     RARELY _checkWrap();
-    _update.fetchAndAdd(1);
+    _update.increment(1);
 }
 
 void OpCounters::gotDelete() {
     RARELY _checkWrap();
-    _delete.fetchAndAdd(1);
+    _delete.increment(1);
 }
 
 void OpCounters::gotGetMore() {
     RARELY _checkWrap();
-    _getmore.fetchAndAdd(1);
+    _getmore.increment(1);
 }
 
 void OpCounters::gotCommand() {
     RARELY _checkWrap();
-    _command.fetchAndAdd(1);
+    _command.increment(1);
 }
 
 void OpCounters::gotOp(int op, bool isCommand) {
@@ -107,96 +129,77 @@ void OpCounters::gotOp(int op, bool isCommand) {
 }
 
 void OpCounters::_checkWrap() {
-    const unsigned MAX = 1 << 30;
+    const long long MAX = 1 << 30;
 
-    bool wrap = _insert.loadRelaxed() > MAX || _query.loadRelaxed() > MAX ||
-        _update.loadRelaxed() > MAX || _delete.loadRelaxed() > MAX ||
-        _getmore.loadRelaxed() > MAX || _command.loadRelaxed() > MAX;
+    bool wrap = _insert.sum() > MAX || _query.sum() > MAX || _update.sum() > MAX ||
+        _delete.sum() > MAX || _getmore.sum() > MAX || _command.sum() > MAX;
 
     if (wrap) {
-        _insert.store(0);
-        _query.store(0);
-        _update.store(0);
-        _delete.store(0);
-        _getmore.store(0);
-        _command.store(0);
+        _insert.reset();
+        _query.reset();
+        _update.reset();
+        _delete.reset();
+        _getmore.reset();
+        _command.reset();
     }
 }
 
 BSONObj OpCounters::getObj() const {
     BSONObjBuilder b;
-    b.append("insert", _insert.loadRelaxed());
-    b.append("query", _query.loadRelaxed());
-    b.append("update", _update.loadRelaxed());
-    b.append("delete", _delete.loadRelaxed());
-    b.append("getmore", _getmore.loadRelaxed());
-    b.append("command", _command.loadRelaxed());
+    b.appendNumber("insert", _insert.sum());
+    b.appendNumber("query", _query.sum());
+    b.appendNumber("update", _update.sum());
+    b.appendNumber("delete", _delete.sum());
+    b.appendNumber("getmore", _getmore.sum());
+    b.appendNumber("command", _command.sum());
     return b.obj();
 }
 
 void NetworkCounter::hitPhysicalIn(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _physicalBytesIn.loadRelaxed() > MAX;
-
-    if (overflow) {
-        _physicalBytesIn.store(bytes);
-    } else {
-        _physicalBytesIn.fetchAndAdd(bytes);
-    }
+    _physicalBytesIn.increment(bytes);
 }
 
 void NetworkCounter::hitPhysicalOut(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _physicalBytesOut.loadRelaxed() > MAX;
-
-    if (overflow) {
-        _physicalBytesOut.store(bytes);
-    } else {
-        _physicalBytesOut.fetchAndAdd(bytes);
-    }
+    _physicalBytesOut.increment(bytes);
 }
 
 void NetworkCounter::hitLogicalIn(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
+    static const int64_t MAX = 1LL << 60;
+
+    auto& together = _together[StripedCounter64::stripeForCurrentThread()];
 
     // don't care about the race as its just a counter
-    const bool overflow = _together.logicalBytesIn.loadRelaxed() > MAX;
+    const bool overflow = together.logicalBytesIn.loadRelaxed() > MAX;
 
     if (overflow) {
-        _together.logicalBytesIn.store(bytes);
+        together.logicalBytesIn.store(bytes);
         // The requests field only gets incremented here (and not in hitPhysical) because the
         // hitLogical and hitPhysical are each called for each operation. Incrementing it in both
         // functions would double-count the number of operations.
-        _together.requests.store(1);
+        together.requests.store(1);
     } else {
-        _together.logicalBytesIn.fetchAndAdd(bytes);
-        _together.requests.fetchAndAdd(1);
+        together.logicalBytesIn.fetchAndAdd(bytes);
+        together.requests.fetchAndAdd(1);
     }
 }
 
 void NetworkCounter::hitLogicalOut(long long bytes) {
-    static const int64_t MAX = 1ULL << 60;
-
-    // don't care about the race as its just a counter
-    const bool overflow = _logicalBytesOut.loadRelaxed() > MAX;
-
-    if (overflow) {
-        _logicalBytesOut.store(bytes);
-    } else {
-        _logicalBytesOut.fetchAndAdd(bytes);
-    }
+    _logicalBytesOut.increment(bytes);
 }
 
 void NetworkCounter::append(BSONObjBuilder& b) {
-    b.append("bytesIn", static_cast<long long>(_together.logicalBytesIn.loadRelaxed()));
-    b.append("bytesOut", static_cast<long long>(_logicalBytesOut.loadRelaxed()));
-    b.append("physicalBytesIn", static_cast<long long>(_physicalBytesIn.loadRelaxed()));
-    b.append("physicalBytesOut", static_cast<long long>(_physicalBytesOut.loadRelaxed()));
-    b.append("numRequests", static_cast<long long>(_together.requests.loadRelaxed()));
+    long long logicalBytesIn = 0;
+    long long requests = 0;
+    for (size_t i = 0; i < StripedCounter64::kNumStripes; i++) {
+        logicalBytesIn += _together[i].logicalBytesIn.loadRelaxed();
+        requests += _together[i].requests.loadRelaxed();
+    }
+
+    b.append("bytesIn", logicalBytesIn);
+    b.append("bytesOut", _logicalBytesOut.sum());
+    b.append("physicalBytesIn", _physicalBytesIn.sum());
+    b.append("physicalBytesOut", _physicalBytesOut.sum());
+    b.append("numRequests", requests);
 }
 
 
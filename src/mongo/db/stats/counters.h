@@ -39,6 +39,56 @@
 
 namespace mongo {
 
+/**
+ * A single logical 64-bit counter whose value is striped across several cacheline-aligned
+ * slots, so that concurrent writers on different cores do not ping-pong one cache line
+ * between them. Each thread is assigned a stripe round-robin the first time it touches any
+ * striped counter and keeps it for its lifetime; readers aggregate across all stripes.
+ *
+ * Sums are not point-in-time snapshots, which is acceptable for monitoring counters.
+ */
+class StripedCounter64 {
+public:
+    // Enough stripes for current server core counts; machines with more concurrently
+    // incrementing threads than this merely share stripes, which is a throughput matter,
+    // not a correctness one.
+    static constexpr size_t kNumStripes = 16;
+
+    /**
+     * Returns the stripe index assigned to the calling thread. Exposed so that counters with
+     * custom stripe contents (see NetworkCounter) can share the thread-to-stripe mapping.
+     */
+    static size_t stripeForCurrentThread();
+
+    void increment(long long n) {
+        // Writers only touch their own stripe, so the overflow pre-check costs a relaxed
+        // load of a cache line this core already owns. The reset race is benign; these are
+        // monitoring counters.
+        auto& stripe = _stripes[stripeForCurrentThread()];
+        if (stripe.loadRelaxed() > kOverflowMax) {
+            stripe.store(n);
+        } else {
+            stripe.fetchAndAdd(n);
+        }
+    }
+
+    /**
+     * Returns the aggregate of all stripes. Reads one cache line per stripe; intended for
+     * serverStatus-frequency callers, not per-operation paths.
+     */
+    long long sum() const;
+
+    /**
+     * Resets every stripe to zero. Racing increments may survive in other stripes.
+     */
+    void reset();
+
+private:
+    static const int64_t kOverflowMax = 1LL << 60;
+
+    CacheAligned<AtomicInt64> _stripes[kNumStripes];
+};
+
 /**
  * for storing operation counters
  * note: not thread safe.  ok with that for speed
@@ -58,35 +108,36 @@ public:
 
     BSONObj getObj() const;
 
-    // thse are used by snmp, and other things, do not remove
-    const AtomicUInt32* getInsert() const {
-        return &_insert;
+    // these are used by snmp, and other things, do not remove. They aggregate the stripes on
+    // each call, so pollers see a total rather than a pointer into a single atomic.
+    long long getInsert() const {
+        return _insert.sum();
     }
-    const AtomicUInt32* getQuery() const {
-        return &_query;
+    long long getQuery() const {
+        return _query.sum();
     }
-    const AtomicUInt32* getUpdate() const {
-        return &_update;
+    long long getUpdate() const {
+        return _update.sum();
     }
-    const AtomicUInt32* getDelete() const {
-        return &_delete;
+    long long getDelete() const {
+        return _delete.sum();
     }
-    const AtomicUInt32* getGetMore() const {
-        return &_getmore;
+    long long getGetMore() const {
+        return _getmore.sum();
     }
-    const AtomicUInt32* getCommand() const {
-        return &_command;
+    long long getCommand() const {
+        return _command.sum();
     }
 
 private:
     void _checkWrap();
 
-    CacheAligned<AtomicUInt32> _insert;
-    CacheAligned<AtomicUInt32> _query;
-    CacheAligned<AtomicUInt32> _update;
-    CacheAligned<AtomicUInt32> _delete;
-    CacheAligned<AtomicUInt32> _getmore;
-    CacheAligned<AtomicUInt32> _command;
+    StripedCounter64 _insert;
+    StripedCounter64 _query;
+    StripedCounter64 _update;
+    StripedCounter64 _delete;
+    StripedCounter64 _getmore;
+    StripedCounter64 _command;
 };
 
 extern OpCounters globalOpCounters;
@@ -106,20 +157,20 @@ public:
     void append(BSONObjBuilder& b);
 
 private:
-    CacheAligned<AtomicInt64> _physicalBytesIn{0};
-    CacheAligned<AtomicInt64> _physicalBytesOut{0};
+    StripedCounter64 _physicalBytesIn;
+    StripedCounter64 _physicalBytesOut;
 
-    // These two counters are always incremented at the same time, so
-    // we place them on the same cache line.
+    // These two counters are always incremented at the same time, so each stripe keeps its
+    // pair on the same cache line.
     struct Together {
         AtomicInt64 logicalBytesIn{0};
         AtomicInt64 requests{0};
     };
-    CacheAligned<Together> _together{};
-    static_assert(sizeof(decltype(_together)) <= stdx::hardware_constructive_interference_size,
+    CacheAligned<Together> _together[StripedCounter64::kNumStripes];
+    static_assert(sizeof(CacheAligned<Together>) <= stdx::hardware_constructive_interference_size,
                   "cache line spill");
 
-    CacheAligned<AtomicInt64> _logicalBytesOut{0};
+    StripedCounter64 _logicalBytesOut;
 };
 
 extern NetworkCounter networkCounter;
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/counters.h"
+
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(StripedCounter64, SumAggregatesIncrementsFromManyThreads) {
+    StripedCounter64 counter;
+
+    const int kThreads = 8;
+    const int kIncrementsPerThread = 10000;
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; i++) {
+        threads.emplace_back([&counter] {
+            for (int j = 0; j < kIncrementsPerThread; j++) {
+                counter.increment(1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQUALS(static_cast<long long>(kThreads) * kIncrementsPerThread, counter.sum());
+}
+
+TEST(StripedCounter64, ResetZeroesAllStripes) {
+    StripedCounter64 counter;
+
+    // Touch stripes from several threads so the value is spread out before the reset.
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&counter] { counter.increment(5); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    counter.reset();
+    ASSERT_EQUALS(0LL, counter.sum());
+}
+
+TEST(OpCounters, GetObjReportsAggregatedTotals) {
+    OpCounters counters;
+
+    counters.gotInserts(3);
+    counters.gotInsert();
+    counters.gotQuery();
+    counters.gotUpdate();
+    counters.gotDelete();
+    counters.gotGetMore();
+    counters.gotCommand();
+
+    BSONObj obj = counters.getObj();
+    ASSERT_EQUALS(4LL, obj["insert"].numberLong());
+    ASSERT_EQUALS(1LL, obj["query"].numberLong());
+    ASSERT_EQUALS(1LL, obj["update"].numberLong());
+    ASSERT_EQUALS(1LL, obj["delete"].numberLong());
+    ASSERT_EQUALS(1LL, obj["getmore"].numberLong());
+    ASSERT_EQUALS(1LL, obj["command"].numberLong());
+}
+
+}  // namespace
+}  // namespace mongo
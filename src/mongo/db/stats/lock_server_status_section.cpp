@@ -49,6 +49,12 @@ public:
         return true;
     }
 
+    // Walks every registered Client under its lock, which gets expensive with many
+    // connections.
+    virtual bool supportsSectionCache() const {
+        return true;
+    }
+
     virtual BSONObj generateSection(OperationContext* opCtx,
                                     const BSONElement& configElement) const {
         std::valarray<int> clientStatusCounts(5);
@@ -110,6 +116,11 @@ public:
         return true;
     }
 
+    // Aggregates lock statistics across all lockers.
+    virtual bool supportsSectionCache() const {
+        return true;
+    }
+
     virtual BSONObj generateSection(OperationContext* opCtx,
                                     const BSONElement& configElement) const {
         BSONObjBuilder ret;
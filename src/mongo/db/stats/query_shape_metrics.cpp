@@ -0,0 +1,169 @@
+/**
+ * Copyright (C) 2017 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_metrics.h"
+
+#include <vector>
+
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+namespace {
+
+// Returns the index of the power-of-two latency bucket for 'micros'.
+size_t latencyBucket(long long micros) {
+    size_t bucket = 0;
+    unsigned long long value = static_cast<unsigned long long>(std::max(micros, 0LL));
+    while (value >>= 1) {
+        bucket++;
+    }
+    return std::min(bucket, QueryShapeMetrics::kNumLatencyBuckets - 1);
+}
+
+std::string makeTableKey(StringData ns, StringData shapeKey) {
+    std::string key;
+    key.reserve(ns.size() + 1 + shapeKey.size());
+    key.append(ns.rawData(), ns.size());
+    key.push_back('#');
+    key.append(shapeKey.rawData(), shapeKey.size());
+    return key;
+}
+
+}  // namespace
+
+const size_t QueryShapeMetrics::kMaxTrackedShapes = 10000;
+
+QueryShapeMetrics* QueryShapeMetrics::get() {
+    static QueryShapeMetrics* metrics = new QueryShapeMetrics();
+    return metrics;
+}
+
+void QueryShapeMetrics::record(StringData ns, StringData shapeKey, const OpDebug& debug) {
+    std::shared_ptr<ShapeMetrics> metrics;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        const std::string key = makeTableKey(ns, shapeKey);
+        StringMap<std::shared_ptr<ShapeMetrics>>::const_iterator it = _shapes.find(key);
+        if (it != _shapes.end()) {
+            metrics = it->second;
+        } else {
+            if (_shapes.size() >= kMaxTrackedShapes) {
+                _overflowCount.addAndFetch(1);
+                return;
+            }
+            metrics = std::make_shared<ShapeMetrics>(ns.toString(), shapeKey.toString());
+            _shapes[key] = metrics;
+        }
+    }
+
+    metrics->count.addAndFetch(1);
+    metrics->totalMicros.addAndFetch(debug.executionTimeMicros);
+    metrics->latencyBuckets[latencyBucket(debug.executionTimeMicros)].addAndFetch(1);
+    if (debug.docsExamined >= 0) {
+        metrics->docsExamined.addAndFetch(debug.docsExamined);
+    }
+    if (debug.keysExamined >= 0) {
+        metrics->keysExamined.addAndFetch(debug.keysExamined);
+    }
+    if (debug.nreturned >= 0) {
+        metrics->nreturned.addAndFetch(debug.nreturned);
+    }
+}
+
+void QueryShapeMetrics::append(BSONObjBuilder* builder) const {
+    std::vector<std::shared_ptr<ShapeMetrics>> snapshot;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        snapshot.reserve(_shapes.size());
+        for (StringMap<std::shared_ptr<ShapeMetrics>>::const_iterator it = _shapes.begin();
+             it != _shapes.end();
+             ++it) {
+            snapshot.push_back(it->second);
+        }
+    }
+
+    builder->appendNumber("numShapes", static_cast<long long>(snapshot.size()));
+    builder->appendNumber("overflowedOps", _overflowCount.load());
+
+    BSONArrayBuilder shapesBuilder(builder->subarrayStart("shapes"));
+    for (const auto& metrics : snapshot) {
+        BSONObjBuilder shapeBuilder(shapesBuilder.subobjStart());
+        shapeBuilder.append("ns", metrics->ns);
+        shapeBuilder.append("shape", metrics->shape);
+        shapeBuilder.appendNumber("count", metrics->count.load());
+        shapeBuilder.appendNumber("totalLatencyMicros", metrics->totalMicros.load());
+        shapeBuilder.appendNumber("docsExamined", metrics->docsExamined.load());
+        shapeBuilder.appendNumber("keysExamined", metrics->keysExamined.load());
+        shapeBuilder.appendNumber("nreturned", metrics->nreturned.load());
+
+        // Only emit occupied buckets; most shapes cluster in a handful of them.
+        BSONObjBuilder histogramBuilder(shapeBuilder.subobjStart("latencyMicrosHistogram"));
+        for (size_t i = 0; i < kNumLatencyBuckets; ++i) {
+            const long long bucketCount = metrics->latencyBuckets[i].load();
+            if (bucketCount > 0) {
+                histogramBuilder.appendNumber(std::to_string(1LL << i), bucketCount);
+            }
+        }
+        histogramBuilder.doneFast();
+        shapeBuilder.doneFast();
+    }
+    shapesBuilder.doneFast();
+}
+
+void QueryShapeMetrics::reset() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _shapes.clear();
+    _overflowCount.store(0);
+}
+
+namespace {
+
+class QueryShapesServerStatusSection final : public ServerStatusSection {
+public:
+    QueryShapesServerStatusSection() : ServerStatusSection("queryShapes") {}
+
+    bool includeByDefault() const {
+        // The table can be large; report it only when explicitly requested.
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const {
+        BSONObjBuilder builder;
+        QueryShapeMetrics::get()->append(&builder);
+        return builder.obj();
+    }
+} queryShapesServerStatusSection;
+
+}  // namespace
+
+}  // namespace mongo
@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2017 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OpDebug;
+
+/**
+ * Process-global table aggregating operation metrics per query shape.
+ *
+ * Shapes are identified by the plan cache key computed during planning (see
+ * OpDebug::queryShapeKey), so the grouping matches the plan cache's notion of "same query".
+ * Entries are created under a mutex the first time a shape is seen; after that the record
+ * path only increments atomic counters, so steady-state aggregation never serializes
+ * operations against each other.
+ *
+ * Exposed through the 'queryShapes' serverStatus section.
+ */
+class QueryShapeMetrics {
+public:
+    /**
+     * Upper bound on tracked shapes.  Operations for shapes beyond this are counted in a
+     * single overflow counter rather than evicting existing entries.
+     */
+    static const size_t kMaxTrackedShapes;
+
+    /**
+     * Number of power-of-two latency buckets; the last bucket is a catch-all for anything
+     * at or above 2^(kNumLatencyBuckets - 1) microseconds.
+     */
+    static const size_t kNumLatencyBuckets = 32;
+
+    static QueryShapeMetrics* get();
+
+    /**
+     * Folds a completed operation into the entry for ('ns', 'shapeKey').  Reads the latency
+     * and examined-documents counters out of 'debug'; fields that the operation never set
+     * (left at -1) are ignored.
+     */
+    void record(StringData ns, StringData shapeKey, const OpDebug& debug);
+
+    /**
+     * Appends one document per tracked shape to 'builder', plus table-level counters.
+     */
+    void append(BSONObjBuilder* builder) const;
+
+    /**
+     * Drops all tracked shapes.  Used by tests.
+     */
+    void reset();
+
+private:
+    struct ShapeMetrics {
+        ShapeMetrics(std::string ns, std::string shape)
+            : ns(std::move(ns)), shape(std::move(shape)) {}
+
+        const std::string ns;
+        const std::string shape;
+
+        AtomicInt64 count;
+        AtomicInt64 totalMicros;
+        AtomicInt64 docsExamined;
+        AtomicInt64 keysExamined;
+        AtomicInt64 nreturned;
+
+        // latencyBuckets[i] counts operations with latency in [2^i, 2^(i+1)) microseconds.
+        std::array<AtomicInt64, kNumLatencyBuckets> latencyBuckets;
+    };
+
+    // Protects the table itself; the ShapeMetrics counters are updated without it.
+    mutable stdx::mutex _mutex;
+    StringMap<std::shared_ptr<ShapeMetrics>> _shapes;
+
+    // Operations discarded because the table was full.
+    AtomicInt64 _overflowCount;
+};
+
+}  // namespace mongo
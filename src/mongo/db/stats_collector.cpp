@@ -0,0 +1,255 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats_collector.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/field_histogram.h"
+#include "mongo/db/repl/replication_coordinator_global.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/exit.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+
+namespace dps = ::mongo::dotted_path_support;
+
+Counter64 statsSamplerPasses;
+
+ServerStatusMetricField<Counter64> statsSamplerPassesDisplay("fieldStats.passes",
+                                                             &statsSamplerPasses);
+
+MONGO_EXPORT_SERVER_PARAMETER(statsSamplerEnabled, bool, true);
+MONGO_EXPORT_SERVER_PARAMETER(statsSamplerSleepSecs, int, 300);  // used for testing
+
+namespace {
+
+// Documents sampled per collection per pass.  Large enough for stable histograms, small enough
+// that a pass over many collections stays cheap.
+const size_t kSampleSize = 1000;
+
+// Fields with fewer sampled values than this produce histograms too noisy to rank plans by.
+const size_t kMinSamplesPerField = 10;
+
+}  // namespace
+
+/**
+ * Periodically refreshes the planner's per-field histograms by sampling each collection's
+ * record store at random and extracting the values of indexed fields.
+ */
+class StatsSampler : public BackgroundJob {
+public:
+    StatsSampler() {}
+    virtual ~StatsSampler() {}
+
+    virtual std::string name() const {
+        return "FieldStatsSampler";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+        AuthorizationSession::get(cc())->grantInternalAuthorization();
+
+        while (!globalInShutdownDeprecated()) {
+            {
+                MONGO_IDLE_THREAD_BLOCK;
+                sleepsecs(statsSamplerSleepSecs.load());
+            }
+
+            LOG(3) << "thread awake";
+
+            if (!statsSamplerEnabled.load()) {
+                LOG(1) << "disabled";
+                continue;
+            }
+
+            try {
+                doSamplingPass();
+            } catch (const WriteConflictException& e) {
+                LOG(1) << "got WriteConflictException";
+            }
+        }
+    }
+
+private:
+    void doSamplingPass() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext& opCtx = *opCtxPtr;
+
+        // If part of replSet but not in a readable state (e.g. during initial sync), skip.
+        if (repl::getGlobalReplicationCoordinator()->getReplicationMode() ==
+                repl::ReplicationCoordinator::modeReplSet &&
+            !repl::getGlobalReplicationCoordinator()->getMemberState().readable())
+            return;
+
+        StorageEngine* storageEngine = getGlobalServiceContext()->getGlobalStorageEngine();
+        if (!storageEngine) {
+            return;
+        }
+
+        statsSamplerPasses.increment();
+
+        // Snapshot the list of open collections, then sample each one under its own lock so
+        // no global lock is held while scanning.
+        std::vector<std::string> collectionNames;
+        {
+            Lock::GlobalLock globalLock(&opCtx, MODE_IS, UINT_MAX);
+
+            std::vector<std::string> dbNames;
+            storageEngine->listDatabases(&dbNames);
+
+            for (const std::string& dbName : dbNames) {
+                Lock::DBLock dbLock(&opCtx, dbName, MODE_IS);
+                Database* db = dbHolder().get(&opCtx, dbName);
+                if (!db) {
+                    continue;
+                }
+                for (Collection* coll : *db) {
+                    collectionNames.push_back(coll->ns().ns());
+                }
+            }
+        }
+
+        for (const std::string& collectionNS : collectionNames) {
+            if (globalInShutdownDeprecated()) {
+                return;
+            }
+            sampleCollection(&opCtx, NamespaceString(collectionNS));
+        }
+    }
+
+    void sampleCollection(OperationContext* opCtx, const NamespaceString& nss) {
+        // Statistics only pay off for user data that the query planner multi-plans over.
+        if (nss.isSystem() || nss.isLocal()) {
+            return;
+        }
+
+        AutoGetCollection autoGetCollection(opCtx, nss, MODE_IS);
+        Collection* coll = autoGetCollection.getCollection();
+        if (!coll) {
+            // The collection was dropped since we listed it.
+            CollectionStatsStore::get()->clear(nss.ns());
+            return;
+        }
+
+        // Histograms are kept for every field named in an index key pattern.  Plugin fields
+        // ("text", "2dsphere", "hashed", ...) have non-numeric key pattern values and are
+        // skipped; range estimates over them are meaningless.
+        std::set<std::string> fields;
+        IndexCatalog::IndexIterator ii = coll->getIndexCatalog()->getIndexIterator(opCtx, false);
+        while (ii.more()) {
+            const IndexDescriptor* desc = ii.next();
+            BSONObjIterator keyIt(desc->keyPattern());
+            while (keyIt.more()) {
+                BSONElement elt = keyIt.next();
+                if (elt.isNumber()) {
+                    fields.insert(elt.fieldName());
+                }
+            }
+        }
+        if (fields.empty()) {
+            CollectionStatsStore::get()->clear(nss.ns());
+            return;
+        }
+
+        std::unique_ptr<RecordCursor> cursor = coll->getRecordStore()->getRandomCursor(opCtx);
+        if (!cursor) {
+            // The storage engine does not support random sampling.
+            return;
+        }
+
+        StringMap<std::vector<BSONObj>> samples;
+        for (size_t i = 0; i < kSampleSize; i++) {
+            boost::optional<Record> record = cursor->next();
+            if (!record) {
+                break;
+            }
+            BSONObj doc = record->data.toBson();
+            for (const std::string& field : fields) {
+                BSONElement elt = dps::extractElementAtPath(doc, field);
+                if (elt.eoo()) {
+                    continue;
+                }
+                // Copy the value out; 'doc' points into the storage engine's buffer.
+                BSONObjBuilder bob;
+                bob.appendAs(elt, "");
+                samples[field].push_back(bob.obj());
+            }
+        }
+
+        auto histograms = std::make_shared<FieldHistogramMap>();
+        for (StringMap<std::vector<BSONObj>>::iterator it = samples.begin(); it != samples.end();
+             ++it) {
+            if (it->second.size() < kMinSamplesPerField) {
+                continue;
+            }
+            (*histograms)[it->first] = FieldHistogram::make(std::move(it->second));
+        }
+
+        LOG(2) << "refreshed field statistics for " << nss.ns() << ": " << histograms->size()
+               << " histogram(s)";
+        CollectionStatsStore::get()->update(nss.ns(), std::move(histograms));
+    }
+};
+
+namespace {
+StatsSampler* statsSampler;
+}  // namespace
+
+void startStatsCollectorBackgroundJob() {
+    statsSampler = new StatsSampler();
+    statsSampler->go();
+}
+
+}  // namespace mongo
@@ -99,8 +99,8 @@ public:
     virtual void cleanShutdown(){};
 
     virtual bool hasIdent(OperationContext* opCtx, StringData ident) const {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
         return _dataMap.find(ident) != _dataMap.end();
-        ;
     }
 
     std::vector<std::string> getAllIdents(OperationContext* opCtx) const;
@@ -33,6 +33,8 @@
 
 #include "mongo/db/storage/ephemeral_for_test/ephemeral_for_test_record_store.h"
 
+#include <vector>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
@@ -401,10 +403,13 @@ StatusWith<RecordId> EphemeralForTestRecordStore::insertRecord(OperationContext*
         return StatusWith<RecordId>(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
     }
 
-    stdx::lock_guard<stdx::mutex> lock(_data->recordsMutex);
+    // Materialize the record before taking the lock so the allocation and copy don't extend
+    // the critical section.
     EphemeralForTestRecord rec(len);
     memcpy(rec.data.get(), data, len);
 
+    stdx::lock_guard<stdx::mutex> lock(_data->recordsMutex);
+
     RecordId loc;
     if (_data->isOplog) {
         StatusWith<RecordId> status = extractAndCheckLocForOplog(data, len);
@@ -428,8 +433,9 @@ Status EphemeralForTestRecordStore::insertRecordsWithDocWriter(OperationContext*
                                                                const DocWriter* const* docs,
                                                                size_t nDocs,
                                                                RecordId* idsOut) {
-    stdx::lock_guard<stdx::mutex> lock(_data->recordsMutex);
-
+    // Materialize all the records up front so the writers run outside the critical section.
+    std::vector<EphemeralForTestRecord> recs;
+    recs.reserve(nDocs);
     for (size_t i = 0; i < nDocs; i++) {
         const int len = docs[i]->documentSize();
         if (_isCapped && len > _cappedMaxSize) {
@@ -438,12 +444,18 @@ Status EphemeralForTestRecordStore::insertRecordsWithDocWriter(OperationContext*
             return Status(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
         }
 
-        EphemeralForTestRecord rec(len);
-        docs[i]->writeDocument(rec.data.get());
+        recs.push_back(EphemeralForTestRecord(len));
+        docs[i]->writeDocument(recs.back().data.get());
+    }
+
+    stdx::lock_guard<stdx::mutex> lock(_data->recordsMutex);
+
+    for (size_t i = 0; i < nDocs; i++) {
+        EphemeralForTestRecord& rec = recs[i];
 
         RecordId loc;
         if (_data->isOplog) {
-            StatusWith<RecordId> status = extractAndCheckLocForOplog(rec.data.get(), len);
+            StatusWith<RecordId> status = extractAndCheckLocForOplog(rec.data.get(), rec.size);
             if (!status.isOK())
                 return status.getStatus();
             loc = status.getValue();
@@ -452,7 +464,7 @@ Status EphemeralForTestRecordStore::insertRecordsWithDocWriter(OperationContext*
         }
 
         opCtx->recoveryUnit()->registerChange(new InsertChange(opCtx, _data, loc));
-        _data->dataSize += len;
+        _data->dataSize += rec.size;
         _data->records[loc] = rec;
 
         cappedDeleteAsNeeded_inlock(opCtx);
@@ -470,6 +482,11 @@ Status EphemeralForTestRecordStore::updateRecord(OperationContext* opCtx,
                                                  int len,
                                                  bool enforceQuota,
                                                  UpdateNotifier* notifier) {
+    // Materialize the new record before taking the lock so the allocation and copy don't extend
+    // the critical section.
+    EphemeralForTestRecord newRecord(len);
+    memcpy(newRecord.data.get(), data, len);
+
     stdx::unique_lock<stdx::mutex> lock(_data->recordsMutex);
     EphemeralForTestRecord* oldRecord = recordFor(loc);
     int oldLen = oldRecord->size;
@@ -486,11 +503,9 @@ Status EphemeralForTestRecordStore::updateRecord(OperationContext* opCtx,
             return callbackStatus;
         }
         lock.lock();
+        oldRecord = recordFor(loc);
     }
 
-    EphemeralForTestRecord newRecord(len);
-    memcpy(newRecord.data.get(), data, len);
-
     opCtx->recoveryUnit()->registerChange(new RemoveChange(opCtx, _data, loc, *oldRecord));
     _data->dataSize += len - oldLen;
     *oldRecord = newRecord;
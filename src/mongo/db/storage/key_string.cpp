@@ -1688,10 +1688,13 @@ Decimal128 adjustDecimalExponent(TypeBits::Reader* typeBits, Decimal128 num) {
 
 }  // namespace
 
-BSONObj KeyString::toBson(const char* buffer, size_t len, Ordering ord, const TypeBits& typeBits) {
-    BSONObjBuilder builder;
+static void toBsonFields(const char* buffer,
+                         size_t len,
+                         Ordering ord,
+                         const KeyString::TypeBits& typeBits,
+                         BSONObjBuilder* builder) {
     BufReader reader(buffer, len);
-    TypeBits::Reader typeBitsReader(typeBits);
+    KeyString::TypeBits::Reader typeBitsReader(typeBits);
     for (int i = 0; reader.remaining(); i++) {
         const bool invert = (ord.get(i) == -1);
         uint8_t ctype = readType<uint8_t>(&reader, invert);
@@ -1705,11 +1708,23 @@ BSONObj KeyString::toBson(const char* buffer, size_t len, Ordering ord, const Ty
 
         if (ctype == kEnd)
             break;
-        toBsonValue(ctype, &reader, &typeBitsReader, invert, typeBits.version, &(builder << ""));
+        toBsonValue(ctype, &reader, &typeBitsReader, invert, typeBits.version, &(*builder << ""));
     }
+}
+
+BSONObj KeyString::toBson(const char* buffer, size_t len, Ordering ord, const TypeBits& typeBits) {
+    BSONObjBuilder builder;
+    toBsonFields(buffer, len, ord, typeBits, &builder);
     return builder.obj();
 }
 
+BSONObj KeyString::toBsonInto(
+    const char* buffer, size_t len, Ordering ord, const TypeBits& typeBits, BufBuilder* out) {
+    BSONObjBuilder builder(*out);
+    toBsonFields(buffer, len, ord, typeBits, &builder);
+    return builder.done();
+}
+
 BSONObj KeyString::toBson(StringData data, Ordering ord, const TypeBits& typeBits) {
     return toBson(data.rawData(), data.size(), ord, typeBits);
 }
@@ -300,6 +300,15 @@ public:
     static BSONObj toBson(StringData data, Ordering ord, const TypeBits& types);
     static BSONObj toBson(const char* buffer, size_t len, Ordering ord, const TypeBits& types);
 
+    /**
+     * As toBson(), but transcodes the decoded fields directly into 'out' and returns an unowned
+     * BSONObj view of the appended bytes. Lets callers that hold a reusable scratch or output
+     * buffer rehydrate keys without a per-key allocation. The view is invalidated by any further
+     * use of 'out'.
+     */
+    static BSONObj toBsonInto(
+        const char* buffer, size_t len, Ordering ord, const TypeBits& types, BufBuilder* out);
+
     /**
      * Decodes a RecordId from the end of a buffer.
      */
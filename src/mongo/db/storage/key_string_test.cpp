@@ -173,6 +173,26 @@ TEST_F(KeyStringTest, ActualBytesDouble) {
     ASSERT_EQUALS(hexFlipped, toHex(ks.getBuffer(), ks.getSize()));
 }
 
+TEST_F(KeyStringTest, ToBsonIntoMatchesToBson) {
+    const BSONObj orig = BSON("" << 5.5 << ""
+                                 << "abc"
+                                 << "" << BSON_ARRAY(1 << 2));
+    const KeyString ks(version, orig, ALL_ASCENDING);
+
+    BufBuilder buf;
+    // A non-empty buffer verifies that the decoded object is appended rather than assumed to
+    // start at offset zero.
+    buf.appendChar('x');
+    const BSONObj view = KeyString::toBsonInto(
+        ks.getBuffer(), ks.getSize(), ALL_ASCENDING, ks.getTypeBits(), &buf);
+
+    ASSERT(!view.isOwned());
+    ASSERT_BSONOBJ_EQ(view,
+                      KeyString::toBson(ks.getBuffer(), ks.getSize(), ALL_ASCENDING,
+                                        ks.getTypeBits()));
+    ASSERT(view.binaryEqual(orig));
+}
+
 TEST_F(KeyStringTest, AllTypesSimple) {
     ROUNDTRIP(version, BSON("" << 5.5));
     ROUNDTRIP(version,
@@ -111,6 +111,23 @@ public:
     const Entry _entry;
 };
 
+class KVCatalog::EvictCachedMetaDataChange : public RecoveryUnit::Change {
+public:
+    EvictCachedMetaDataChange(KVCatalog* catalog, StringData ns)
+        : _catalog(catalog), _ns(ns.toString()) {}
+
+    virtual void commit() {}
+    virtual void rollback() {
+        // The catalog record reverts to its committed contents; drop whatever this
+        // transaction cached (or allowed a reader to cache) for the namespace.
+        stdx::lock_guard<stdx::mutex> lk(_catalog->_identsLock);
+        _catalog->_mdCache.erase(_ns);
+    }
+
+    KVCatalog* const _catalog;
+    const std::string _ns;
+};
+
 bool KVCatalog::FeatureTracker::isFeatureDocument(BSONObj obj) {
     BSONElement firstElem = obj.firstElement();
     if (firstElem.fieldNameStringData() == kIsFeatureDocumentFieldName) {
@@ -351,6 +368,7 @@ Status KVCatalog::newCollection(OperationContext* opCtx,
     }
 
     opCtx->recoveryUnit()->registerChange(new AddIdentChange(this, ns));
+    opCtx->recoveryUnit()->registerChange(new EvictCachedMetaDataChange(this, ns));
 
     BSONObj obj;
     {
@@ -415,6 +433,14 @@ BSONObj KVCatalog::_findEntry(OperationContext* opCtx, StringData ns, RecordId*
 
 const BSONCollectionCatalogEntry::MetaData KVCatalog::getMetaData(OperationContext* opCtx,
                                                                   StringData ns) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_identsLock);
+        MetaDataCache::const_iterator it = _mdCache.find(ns.toString());
+        if (it != _mdCache.end()) {
+            return *it->second;
+        }
+    }
+
     BSONObj obj = _findEntry(opCtx, ns);
     LOG(3) << " fetched CCE metadata: " << obj;
     BSONCollectionCatalogEntry::MetaData md;
@@ -422,6 +448,10 @@ const BSONCollectionCatalogEntry::MetaData KVCatalog::getMetaData(OperationConte
     if (mdElement.isABSONObj()) {
         LOG(3) << "returning metadata: " << mdElement;
         md.parse(mdElement.Obj());
+
+        stdx::lock_guard<stdx::mutex> lk(_identsLock);
+        _mdCache[ns.toString()] =
+            std::make_shared<const BSONCollectionCatalogEntry::MetaData>(md);
     }
     return md;
 }
@@ -463,6 +493,12 @@ void KVCatalog::putMetaData(OperationContext* opCtx,
     LOG(3) << "recording new metadata: " << obj;
     Status status = _rs->updateRecord(opCtx, loc, obj.objdata(), obj.objsize(), false, NULL);
     fassert(28521, status.isOK());
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_identsLock);
+        _mdCache[ns.toString()] = std::make_shared<const BSONCollectionCatalogEntry::MetaData>(md);
+    }
+    opCtx->recoveryUnit()->registerChange(new EvictCachedMetaDataChange(this, ns));
 }
 
 Status KVCatalog::renameCollection(OperationContext* opCtx,
@@ -496,9 +532,13 @@ Status KVCatalog::renameCollection(OperationContext* opCtx,
 
     opCtx->recoveryUnit()->registerChange(new RemoveIdentChange(this, fromNS, fromIt->second));
     opCtx->recoveryUnit()->registerChange(new AddIdentChange(this, toNS));
+    opCtx->recoveryUnit()->registerChange(new EvictCachedMetaDataChange(this, fromNS));
+    opCtx->recoveryUnit()->registerChange(new EvictCachedMetaDataChange(this, toNS));
 
     _idents.erase(fromIt);
     _idents[toNS.toString()] = Entry(old["ident"].String(), loc);
+    _mdCache.erase(fromNS.toString());
+    _mdCache.erase(toNS.toString());
 
     return Status::OK();
 }
@@ -513,10 +553,12 @@ Status KVCatalog::dropCollection(OperationContext* opCtx, StringData ns) {
     }
 
     opCtx->recoveryUnit()->registerChange(new RemoveIdentChange(this, ns, it->second));
+    opCtx->recoveryUnit()->registerChange(new EvictCachedMetaDataChange(this, ns));
 
     LOG(1) << "deleting metadata for " << ns << " @ " << it->second.storedLoc;
     _rs->deleteRecord(opCtx, it->second.storedLoc);
     _idents.erase(it);
+    _mdCache.erase(ns.toString());
 
     return Status::OK();
 }
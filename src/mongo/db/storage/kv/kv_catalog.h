@@ -100,6 +100,7 @@ public:
 private:
     class AddIdentChange;
     class RemoveIdentChange;
+    class EvictCachedMetaDataChange;
 
     BSONObj _findEntry(OperationContext* opCtx, StringData ns, RecordId* out = NULL) const;
 
@@ -132,6 +133,16 @@ private:
     NSToIdentMap _idents;
     mutable stdx::mutex _identsLock;
 
+    // Decoded copies of each namespace's "md" subdocument, so getMetaData() does not have to
+    // re-read and re-parse the catalog record on every lookup. Guarded by '_identsLock'.
+    // putMetaData() writes through, and every path that changes or may roll back a catalog
+    // record evicts the affected namespaces; callers already serialize metadata writes against
+    // reads of the same namespace with collection locks, so the cache cannot publish one
+    // transaction's uncommitted metadata to a reader that could not otherwise observe it.
+    typedef std::map<std::string, std::shared_ptr<const BSONCollectionCatalogEntry::MetaData>>
+        MetaDataCache;
+    MetaDataCache _mdCache;
+
     // Manages the feature document that may be present in the KVCatalog. '_featureTracker' is
     // guaranteed to be non-null after KVCatalog::init() is called.
     std::unique_ptr<FeatureTracker> _featureTracker;
@@ -270,6 +270,34 @@ public:
     }
 };
 
+/**
+ * Streams records into an empty record store, bypassing per-record transaction overhead.
+ * Obtained via RecordStore::getBulkLoader().
+ *
+ * Bulk loading is not transactional: records appended through a loader are not rolled back by
+ * the recovery unit, so it is only suitable for flows like initial sync and restore where the
+ * entire record store is discarded on failure. The caller must be the only user of the record
+ * store until finalize() returns.
+ */
+class RecordStoreBulkLoader {
+public:
+    virtual ~RecordStoreBulkLoader() {}
+
+    /**
+     * Appends a record and returns the RecordId assigned to it. Ids are assigned in increasing
+     * order.
+     */
+    virtual StatusWith<RecordId> addRecord(const char* data, int len) = 0;
+
+    /**
+     * Completes the load, making all appended records visible to new transactions and updating
+     * the record store's size metadata. Records appended after a failed finalize() or without a
+     * finalize() call are in an undefined state; the caller is expected to discard the record
+     * store.
+     */
+    virtual Status finalize() = 0;
+};
+
 /**
  * A RecordStore provides an abstraction used for storing documents in a collection,
  * or entries in an index. In storage engines implementing the KVEngine, record stores
@@ -457,6 +485,18 @@ public:
                                                      const char* damageSource,
                                                      const mutablebson::DamageVector& damages) = 0;
 
+    /**
+     * Returns a loader that streams records into this record store without per-record
+     * transaction overhead, or nullptr if this record store cannot be bulk loaded (the engine
+     * has no optimized path, the store is non-empty, or it is capped). Callers receiving
+     * nullptr must fall back to insertRecord().
+     *
+     * See RecordStoreBulkLoader for the restrictions on use.
+     */
+    virtual std::unique_ptr<RecordStoreBulkLoader> getBulkLoader(OperationContext* opCtx) {
+        return nullptr;
+    }
+
     /**
      * Returns a new cursor over this record store.
      *
@@ -511,6 +551,28 @@ public:
      */
     virtual Status truncate(OperationContext* opCtx) = 0;
 
+    /**
+     * Removes all Records in the inclusive range ['minRecordId', 'maxRecordId'] in a single
+     * storage engine operation, without returning the removed documents. A null 'minRecordId'
+     * ('maxRecordId') leaves the range unbounded below (above).
+     *
+     * The removed records are not read back, so this performs no index maintenance and is not
+     * replicated; it is only suitable for unindexed, unreplicated maintenance work. Callers
+     * that track collection statistics must supply the (negative) adjustments to apply to the
+     * fast count and data size via 'hintNumRecordsDiff' and 'hintDataSizeDiff'.
+     *
+     * Returns ErrorCodes::CommandNotSupported if the engine cannot remove a range more cheaply
+     * than deleting record-at-a-time.
+     */
+    virtual Status rangeTruncate(OperationContext* opCtx,
+                                 const RecordId& minRecordId = RecordId(),
+                                 const RecordId& maxRecordId = RecordId(),
+                                 int64_t hintDataSizeDiff = 0,
+                                 int64_t hintNumRecordsDiff = 0) {
+        return Status(ErrorCodes::CommandNotSupported,
+                      "this storage engine does not support rangeTruncate");
+    }
+
     /**
      * Truncate documents newer than the document at 'end' from the capped
      * collection.  The collection cannot be completely emptied using this
@@ -109,6 +109,52 @@ TEST(RecordStoreTestHarness, InsertMultipleRecords) {
     }
 }
 
+// Insert a batch of records through the vectored API in one unit of work and verify that ids
+// are assigned in increasing order and every document is retrievable.
+TEST(RecordStoreTestHarness, InsertRecordsVectored) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 10;
+    std::vector<string> data;
+    for (int i = 0; i < nToInsert; i++) {
+        stringstream ss;
+        ss << "record " << i;
+        data.push_back(ss.str());
+    }
+
+    std::vector<Record> records;
+    for (int i = 0; i < nToInsert; i++) {
+        Record record;
+        record.data = RecordData(data[i].c_str(), data[i].size() + 1);
+        records.push_back(record);
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(rs->insertRecords(opCtx.get(), &records, false));
+            uow.commit();
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQUALS(nToInsert, rs->numRecords(opCtx.get()));
+
+        RecordId prevId;
+        for (int i = 0; i < nToInsert; i++) {
+            ASSERT_GREATER_THAN(records[i].id, prevId);
+            prevId = records[i].id;
+
+            RecordData rd;
+            ASSERT_TRUE(rs->findRecord(opCtx.get(), records[i].id, &rd));
+            ASSERT_EQUALS(data[i], rd.data());
+        }
+    }
+}
+
 // Insert a record using a DocWriter and verify the number of entries
 // in the collection is 1.
 TEST(RecordStoreTestHarness, InsertRecordUsingDocWriter) {
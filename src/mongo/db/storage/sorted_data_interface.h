@@ -29,6 +29,7 @@
 #include <boost/optional/optional.hpp>
 #include <boost/optional/optional_io.hpp>
 #include <memory>
+#include <vector>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
@@ -262,6 +263,31 @@ public:
          */
         virtual boost::optional<IndexKeyEntry> next(RequestedInfo parts = kKeyAndLoc) = 0;
 
+        /**
+         * Moves forward up to 'n' times, appending each entry passed to 'out', and returns the
+         * number of entries appended. Appending fewer than 'n' entries means there is no more
+         * data (or the end position was hit). Equivalent to calling next() 'n' times, but
+         * implementations may cross into the storage engine once for the whole batch, so
+         * callers scanning many consecutive entries should prefer it.
+         *
+         * Unlike next(), any keys appended to 'out' are owned and remain valid after further
+         * cursor movement.
+         */
+        virtual size_t nextBatch(std::vector<IndexKeyEntry>* out,
+                                 size_t n,
+                                 RequestedInfo parts = kKeyAndLoc) {
+            size_t numAppended = 0;
+            for (; numAppended < n; numAppended++) {
+                auto entry = next(parts);
+                if (!entry)
+                    break;
+                if (!entry->key.isOwned())
+                    entry->key = entry->key.getOwned();
+                out->push_back(std::move(*entry));
+            }
+            return numAppended;
+        }
+
         //
         // Seeking
         //
@@ -166,5 +166,43 @@ TEST(SortedDataInterface, ExhaustCursorReversed) {
     }
 }
 
+// Exhaust a forward cursor with nextBatch() and verify it returns the same entries as repeated
+// calls to next(), stopping short when the index runs out of data.
+TEST(SortedDataInterface, ExhaustCursorWithNextBatch) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(harnessHelper->newSortedDataInterface(false));
+
+    int nToInsert = 10;
+    for (int i = 0; i < nToInsert; i++) {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            BSONObj key = BSON("" << i);
+            RecordId loc(42, i * 2);
+            ASSERT_OK(sorted->insert(opCtx.get(), key, loc, true));
+            uow.commit();
+        }
+    }
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        const std::unique_ptr<SortedDataInterface::Cursor> cursor(sorted->newCursor(opCtx.get()));
+
+        ASSERT_EQ(cursor->seek(kMinBSONKey, true), IndexKeyEntry(BSON("" << 0), RecordId(42, 0)));
+
+        // Ask for more entries than remain; the batch stops at the end of the index.
+        std::vector<IndexKeyEntry> entries;
+        ASSERT_EQUALS(static_cast<size_t>(nToInsert - 1),
+                      cursor->nextBatch(&entries, nToInsert + 5));
+        for (int i = 1; i < nToInsert; i++) {
+            ASSERT_EQ(entries[i - 1], IndexKeyEntry(BSON("" << i), RecordId(42, i * 2)));
+        }
+
+        // Cursor at EOF should remain at EOF when advanced
+        ASSERT_EQUALS(0U, cursor->nextBatch(&entries, 1));
+        ASSERT(!cursor->next());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -57,6 +57,7 @@
 #include "mongo/util/hex.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/time_support.h"
 
 #define TRACING_ENABLED 0
 
@@ -433,6 +434,13 @@ Status WiredTigerIndex::touch(OperationContext* opCtx) const {
 
 
 long long WiredTigerIndex::getSpaceUsedBytes(OperationContext* opCtx) const {
+    // Serve repeat callers from the cache; collStats polls this for every index and reading
+    // the statistics table each time is too expensive for frequent monitoring.
+    const int64_t kSpaceUsedCacheMicros = 10 * 1000 * 1000;
+    if (static_cast<int64_t>(curTimeMicros64()) < _cachedSpaceUsedBytesExpiryMicros.load()) {
+        return _cachedSpaceUsedBytes.load();
+    }
+
     auto ru = WiredTigerRecoveryUnit::get(opCtx);
     WiredTigerSession* session = ru->getSession(opCtx);
 
@@ -457,18 +465,28 @@ long long WiredTigerIndex::getSpaceUsedBytes(OperationContext* opCtx) const {
         auto removes = getStats(WT_STAT_DSRC_CURSOR_REMOVE);
         auto insertBytes = getStats(WT_STAT_DSRC_CURSOR_INSERT_BYTES);
 
-        if (inserts == 0 || removes >= inserts)
-            return 0;
+        long long spaceUsed = 0;
+        if (inserts > 0 && removes < inserts) {
+            // Rough approximation of index size as average entry size times number of entries.
+            // May be off if key sizes change significantly over the life time of the collection,
+            // but is the best we can do currrently with the statistics available.
+            auto bytesPerEntry = (insertBytes + inserts - 1) / inserts;  // round up
+            auto numEntries = inserts - removes;
+            spaceUsed = numEntries * bytesPerEntry;
+        }
 
-        // Rough approximation of index size as average entry size times number of entries.
-        // May be off if key sizes change significantly over the life time of the collection,
-        // but is the best we can do currrently with the statistics available.
-        auto bytesPerEntry = (insertBytes + inserts - 1) / inserts;  // round up
-        auto numEntries = inserts - removes;
-        return numEntries * bytesPerEntry;
+        _cachedSpaceUsedBytes.store(spaceUsed);
+        _cachedSpaceUsedBytesExpiryMicros.store(static_cast<int64_t>(curTimeMicros64()) +
+                                                kSpaceUsedCacheMicros);
+        return spaceUsed;
     }
 
-    return static_cast<long long>(WiredTigerUtil::getIdentSize(session->getSession(), _uri));
+    const long long spaceUsed =
+        static_cast<long long>(WiredTigerUtil::getIdentSize(session->getSession(), _uri));
+    _cachedSpaceUsedBytes.store(spaceUsed);
+    _cachedSpaceUsedBytesExpiryMicros.store(static_cast<int64_t>(curTimeMicros64()) +
+                                            kSpaceUsedCacheMicros);
+    return spaceUsed;
 }
 
 bool WiredTigerIndex::isDup(WT_CURSOR* c, const BSONObj& key, const RecordId& id) {
@@ -741,6 +759,25 @@ public:
         return curr(parts);
     }
 
+    size_t nextBatch(std::vector<IndexKeyEntry>* out, size_t n, RequestedInfo parts) override {
+        // Same as calling next() 'n' times, but the loop stays inside the storage layer. The
+        // keys built by curr() are always owned, so buffering them is safe.
+        size_t numAppended = 0;
+        for (; numAppended < n; numAppended++) {
+            if (_eof)
+                break;
+
+            if (!_lastMoveWasRestore)
+                advanceWTCursor();
+            updatePosition(true);
+            auto entry = curr(parts);
+            if (!entry)
+                break;
+            out->push_back(std::move(*entry));
+        }
+        return numAppended;
+    }
+
     void setEndPosition(const BSONObj& key, bool inclusive) override {
         TRACE_CURSOR << "setEndPosition inclusive: " << inclusive << ' ' << key;
         if (key.isEmpty()) {
@@ -878,7 +915,13 @@ protected:
 
         BSONObj bson;
         if (TRACING_ENABLED || (parts & kWantKey)) {
-            bson = KeyString::toBson(_key.getBuffer(), _key.getSize(), _idx.ordering(), _typeBits);
+            // Decode into a reusable per-cursor buffer and hand out an unowned view. Entries are
+            // only valid until the next advance, and callers that retain keys already copy them
+            // (see the isOwned() checks in the index scan stages), so this saves an allocation
+            // per visited key.
+            _keyBsonBuffer.reset();
+            bson = KeyString::toBsonInto(
+                _key.getBuffer(), _key.getSize(), _idx.ordering(), _typeBits, &_keyBsonBuffer);
 
             TRACE_CURSOR << " returning " << bson << ' ' << _id;
         }
@@ -1018,6 +1061,10 @@ protected:
     RecordId _id;
     bool _eof = true;
 
+    // Scratch space for rehydrating '_key' into BSON in curr(); reused across positions so that
+    // returning a key does not allocate. Views handed out from it are unowned.
+    mutable BufBuilder _keyBsonBuffer;
+
     // This differs from _eof in that it always reflects the result of the most recent call to
     // reposition _cursor.
     bool _cursorAtEof = false;
@@ -1129,6 +1176,12 @@ Status WiredTigerIndexUnique::_insert(WT_CURSOR* c,
     WiredTigerItem valueItem(value.getBuffer(), value.getSize());
     setKey(c, keyItem.Get());
     c->set_value(c, valueItem.Get());
+
+    // The cursor is opened with overwrite=false, so this insert doubles as the duplicate probe:
+    // the common no-duplicate case costs exactly one B-tree traversal, and only a genuine
+    // collision pays for the search and value-list merge below. Don't add a separate existence
+    // check (or a filter in front of one) ahead of this call — there is no pre-insert search
+    // here to skip.
     int ret = WT_OP_CHECK(c->insert(c));
 
     if (ret != WT_DUPLICATE_KEY) {
@@ -36,6 +36,7 @@
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/sorted_data_interface.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -162,6 +163,11 @@ protected:
     std::string _collectionNamespace;
     std::string _indexName;
     KVPrefix _prefix;
+
+    // Cached result of getSpaceUsedBytes() and its expiry time; computing it walks a
+    // WiredTiger statistics cursor, which is too expensive for frequent collStats polling.
+    mutable AtomicInt64 _cachedSpaceUsedBytes;
+    mutable AtomicInt64 _cachedSpaceUsedBytesExpiryMicros;
 };
 
 
@@ -80,6 +80,7 @@
 #include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 #if !defined(__has_feature)
 #define __has_feature(x) 0
@@ -92,6 +93,29 @@ using std::string;
 
 namespace dps = ::mongo::dotted_path_support;
 
+// When either target is positive the checkpoint thread polls once a second and checkpoints as
+// soon as dirty cache bytes, or journal bytes written since the last checkpoint, exceed the
+// target, rather than letting work pile up for the fixed cadence. The fixed cadence still acts
+// as an upper bound between checkpoints. 0 (the default) keeps the fixed schedule only.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCheckpointDirtyTargetMB, long long, 0);
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCheckpointJournalTargetMB, long long, 0);
+
+namespace {
+
+// Counters reported under wiredTiger.checkpoint in serverStatus.
+struct CheckpointStats {
+    AtomicInt64 checkpoints;
+    AtomicInt64 scheduledTriggers;
+    AtomicInt64 dirtyBytesTriggers;
+    AtomicInt64 journalBytesTriggers;
+    AtomicInt64 lastDurationMillis;
+    AtomicInt64 totalDurationMillis;
+    AtomicInt64 lastBytesWritten;
+    AtomicInt64 totalBytesWritten;
+} checkpointStats;
+
+}  // namespace
+
 class WiredTigerKVEngine::WiredTigerJournalFlusher : public BackgroundJob {
 public:
     explicit WiredTigerJournalFlusher(WiredTigerSessionCache* sessionCache)
@@ -136,6 +160,131 @@ private:
     AtomicBool _shuttingDown{false};
 };
 
+// Seconds between background compaction slices; zero (the default) disables the compactor.
+// Each slice compacts a single table and gives up after wiredTigerBackgroundCompactSliceSecs
+// if it cannot make progress, so the exclusive block-manager work stays time-boxed.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerBackgroundCompactIntervalSecs, int, 0);
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerBackgroundCompactSliceSecs, int, 15);
+
+class WiredTigerKVEngine::WiredTigerCompactionThread : public BackgroundJob {
+public:
+    explicit WiredTigerCompactionThread(WiredTigerSessionCache* sessionCache)
+        : BackgroundJob(false /* deleteSelf */), _sessionCache(sessionCache) {}
+
+    virtual string name() const {
+        return "WTCompactionThread";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+
+        LOG(1) << "starting " << name() << " thread";
+
+        WiredTigerSession session(_sessionCache->conn());
+        Timer sinceLastSlice;
+        bool firstSlice = true;
+
+        while (!_shuttingDown.load()) {
+            {
+                MONGO_IDLE_THREAD_BLOCK;
+                sleepsecs(1);
+            }
+
+            const int intervalSecs = wiredTigerBackgroundCompactIntervalSecs.load();
+            if (intervalSecs <= 0 || _sessionCache->isEphemeral()) {
+                continue;
+            }
+            if (!firstSlice && sinceLastSlice.seconds() < intervalSecs) {
+                continue;
+            }
+            if (_cacheUnderPressure(&session)) {
+                // Eviction is already working hard; compaction would dirty more of the cache.
+                // Try again next interval.
+                sinceLastSlice.reset();
+                continue;
+            }
+
+            _compactNextTable(&session);
+            firstSlice = false;
+            sinceLastSlice.reset();
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        wait();
+    }
+
+private:
+    /**
+     * Returns true while more than kMaxDirtyCachePercent of the cache is dirty, a sign that
+     * eviction (and therefore the workload) is already saturating the cache.
+     */
+    bool _cacheUnderPressure(WiredTigerSession* session) {
+        const int kMaxDirtyCachePercent = 20;
+        auto dirty = WiredTigerUtil::getStatisticsValueAs<long long>(
+            session->getSession(), "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+        auto max = WiredTigerUtil::getStatisticsValueAs<long long>(
+            session->getSession(), "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_MAX);
+        if (!dirty.isOK() || !max.isOK() || max.getValue() <= 0) {
+            return false;
+        }
+        return dirty.getValue() * 100 > max.getValue() * kMaxDirtyCachePercent;
+    }
+
+    /**
+     * Compacts the next table in round-robin order, reloading the table list from the metadata
+     * when the previous pass is exhausted. Busy or concurrently dropped tables are skipped.
+     */
+    void _compactNextTable(WiredTigerSession* session) {
+        if (_uris.empty()) {
+            _loadTableURIs(session);
+            if (_uris.empty()) {
+                return;
+            }
+        }
+
+        const std::string uri = _uris.back();
+        _uris.pop_back();
+
+        WT_SESSION* s = session->getSession();
+        const std::string config =
+            str::stream() << "timeout=" << std::max(1, wiredTigerBackgroundCompactSliceSecs.load());
+        Timer t;
+        int ret = s->compact(s, uri.c_str(), config.c_str());
+        if (ret == EBUSY || ret == ENOENT || ret == WT_NOTFOUND) {
+            // Busy tables get another chance on a later pass; dropped tables are gone.
+            LOG(2) << "background compaction of " << uri << " skipped: " << wiredtiger_strerror(ret);
+            return;
+        }
+        invariantWTOK(ret);
+        LOG(1) << "background compaction of " << uri << " took " << t.millis() << "ms";
+    }
+
+    void _loadTableURIs(WiredTigerSession* session) {
+        WT_SESSION* s = session->getSession();
+        WT_CURSOR* c = NULL;
+        if (s->open_cursor(s, "metadata:", NULL, NULL, &c) != 0) {
+            return;
+        }
+        while (c->next(c) == 0) {
+            const char* raw;
+            c->get_key(c, &raw);
+            StringData key(raw);
+            if (!key.startsWith("table:") || key == "table:sizeStorer") {
+                continue;
+            }
+            _uris.push_back(key.toString());
+        }
+        invariantWTOK(c->close(c));
+    }
+
+    WiredTigerSessionCache* _sessionCache;
+    std::vector<std::string> _uris;
+    AtomicBool _shuttingDown{false};
+};
+
 class WiredTigerKVEngine::WiredTigerCheckpointThread : public BackgroundJob {
 public:
     explicit WiredTigerCheckpointThread(WiredTigerSessionCache* sessionCache)
@@ -153,13 +302,47 @@ public:
 
         LOG(1) << "starting " << name() << " thread";
 
+        // Dedicated session, used only to read connection statistics for the adaptive
+        // trigger and the serverStatus counters.
+        WiredTigerSession statsSession(_sessionCache->conn());
+
+        Timer sinceLastCheckpoint;
+        long long journalBytesAtLastCheckpoint =
+            _connStat(&statsSession, WT_STAT_CONN_LOG_BYTES_WRITTEN);
+
         while (!_shuttingDown.load()) {
+            const long long dirtyTargetMB = wiredTigerCheckpointDirtyTargetMB.load();
+            const long long journalTargetMB = wiredTigerCheckpointJournalTargetMB.load();
+            const bool adaptive = dirtyTargetMB > 0 || journalTargetMB > 0;
+
             {
                 stdx::unique_lock<stdx::mutex> lock(_mutex);
                 MONGO_IDLE_THREAD_BLOCK;
+                // In adaptive mode, poll once a second; the fixed cadence is only an upper
+                // bound between checkpoints.
                 _condvar.wait_for(lock,
                                   stdx::chrono::seconds(static_cast<std::int64_t>(
-                                      wiredTigerGlobalOptions.checkpointDelaySecs)));
+                                      adaptive ? 1 : wiredTigerGlobalOptions.checkpointDelaySecs)));
+            }
+
+            AtomicInt64* triggerCounter = &checkpointStats.scheduledTriggers;
+            if (adaptive && !_shuttingDown.load() &&
+                sinceLastCheckpoint.seconds() <
+                    static_cast<long long>(wiredTigerGlobalOptions.checkpointDelaySecs)) {
+                const long long dirtyBytes =
+                    _connStat(&statsSession, WT_STAT_CONN_CACHE_BYTES_DIRTY);
+                const long long journalBytes =
+                    _connStat(&statsSession, WT_STAT_CONN_LOG_BYTES_WRITTEN);
+                if (dirtyTargetMB > 0 && dirtyBytes >= dirtyTargetMB * 1024 * 1024) {
+                    triggerCounter = &checkpointStats.dirtyBytesTriggers;
+                } else if (journalTargetMB > 0 && journalBytes >= journalBytesAtLastCheckpoint &&
+                           journalBytes - journalBytesAtLastCheckpoint >=
+                               journalTargetMB * 1024 * 1024) {
+                    triggerCounter = &checkpointStats.journalBytesTriggers;
+                } else {
+                    // Neither target reached and the cadence has not elapsed yet.
+                    continue;
+                }
             }
 
             const SnapshotName stableTimestamp(_stableTimestamp.load());
@@ -167,6 +350,10 @@ public:
             const bool keepOldBehavior = true;
 
             try {
+                const long long bytesBefore =
+                    _connStat(&statsSession, WT_STAT_CONN_BLOCK_BYTE_WRITE);
+                Timer checkpointTimer;
+
                 if (keepOldBehavior) {
                     const bool forceCheckpoint = true;
                     const bool stableCheckpoint = false;
@@ -200,6 +387,23 @@ public:
                         _sessionCache->waitUntilDurable(forceCheckpoint, stableCheckpoint);
                     }
                 }
+
+                const long long durationMillis = checkpointTimer.millis();
+                const long long bytesAfter =
+                    _connStat(&statsSession, WT_STAT_CONN_BLOCK_BYTE_WRITE);
+
+                checkpointStats.checkpoints.fetchAndAdd(1);
+                triggerCounter->fetchAndAdd(1);
+                checkpointStats.lastDurationMillis.store(durationMillis);
+                checkpointStats.totalDurationMillis.fetchAndAdd(durationMillis);
+                if (bytesBefore >= 0 && bytesAfter >= bytesBefore) {
+                    checkpointStats.lastBytesWritten.store(bytesAfter - bytesBefore);
+                    checkpointStats.totalBytesWritten.fetchAndAdd(bytesAfter - bytesBefore);
+                }
+
+                sinceLastCheckpoint.reset();
+                journalBytesAtLastCheckpoint =
+                    _connStat(&statsSession, WT_STAT_CONN_LOG_BYTES_WRITTEN);
             } catch (const UserException& exc) {
                 invariant(exc.getCode() == ErrorCodes::ShutdownInProgress);
             }
@@ -245,6 +449,13 @@ public:
     }
 
 private:
+    // Reads a connection-level statistic, returning -1 if it is unavailable.
+    static long long _connStat(WiredTigerSession* session, int statisticsKey) {
+        auto result = WiredTigerUtil::getStatisticsValueAs<long long>(
+            session->getSession(), "statistics:", "statistics=(fast)", statisticsKey);
+        return result.isOK() ? result.getValue() : -1;
+    }
+
     WiredTigerSessionCache* _sessionCache;
 
     // _mutex/_condvar used to notify when _shuttingDown is flipped.
@@ -307,6 +518,123 @@ stdx::function<bool(StringData)> initRsOplogBackgroundThreadCallback = [](String
 };
 }  // namespace
 
+// When enabled, a background controller resizes the concurrent transaction tickets from the
+// queueing each holder observed over the last interval (additive increase, multiplicative
+// decrease) instead of relying on the fixed defaults. The manual
+// wiredTigerConcurrent*Transactions parameters still work and act as a new starting point for
+// the controller.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerAdaptiveConcurrentTransactions, bool, false);
+
+class WiredTigerKVEngine::WiredTigerTicketController : public BackgroundJob {
+public:
+    explicit WiredTigerTicketController(WiredTigerSessionCache* sessionCache)
+        : BackgroundJob(false /* deleteSelf */), _sessionCache(sessionCache) {}
+
+    virtual string name() const {
+        return "WTTicketController";
+    }
+
+    virtual void run() {
+        Client::initThread(name().c_str());
+
+        LOG(1) << "starting " << name() << " thread";
+
+        WiredTigerSession session(_sessionCache->conn());
+        long long lastReadQueued = openReadTransaction.totalTimeQueuedMicros();
+        long long lastWriteQueued = openWriteTransaction.totalTimeQueuedMicros();
+
+        while (!_shuttingDown.load()) {
+            {
+                MONGO_IDLE_THREAD_BLOCK;
+                sleepsecs(1);
+            }
+
+            // Sample unconditionally so the deltas stay per-interval even while disabled.
+            const long long readQueued = openReadTransaction.totalTimeQueuedMicros();
+            const long long writeQueued = openWriteTransaction.totalTimeQueuedMicros();
+            const long long readDelta = readQueued - lastReadQueued;
+            const long long writeDelta = writeQueued - lastWriteQueued;
+            lastReadQueued = readQueued;
+            lastWriteQueued = writeQueued;
+
+            if (!wiredTigerAdaptiveConcurrentTransactions.load()) {
+                continue;
+            }
+
+            // Growing concurrency while eviction is behind would only deepen the backlog, so
+            // additive increase is suppressed under cache pressure; shrinking stays allowed.
+            const bool cachePressed = _dirtyCacheAboveThreshold(&session);
+
+            _adjust(&openReadTransaction, readDelta, cachePressed);
+            _adjust(&openWriteTransaction, writeDelta, cachePressed);
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        wait();
+    }
+
+private:
+    bool _dirtyCacheAboveThreshold(WiredTigerSession* session) {
+        const int kMaxDirtyCachePercent = 20;
+        auto dirty = WiredTigerUtil::getStatisticsValueAs<long long>(session->getSession(),
+                                                                     "statistics:",
+                                                                     "statistics=(fast)",
+                                                                     WT_STAT_CONN_CACHE_BYTES_DIRTY);
+        auto max = WiredTigerUtil::getStatisticsValueAs<long long>(session->getSession(),
+                                                                   "statistics:",
+                                                                   "statistics=(fast)",
+                                                                   WT_STAT_CONN_CACHE_BYTES_MAX);
+        if (!dirty.isOK() || !max.isOK() || max.getValue() <= 0) {
+            return false;
+        }
+        return dirty.getValue() * 100 > max.getValue() * kMaxDirtyCachePercent;
+    }
+
+    /**
+     * One AIMD step for a single holder: grow additively while requests spent meaningful time
+     * queued during the last interval, shrink multiplicatively while the pool sat mostly idle.
+     * The historical fixed size of 128 is the floor, so internal operations (replication in
+     * particular) always find at least the concurrency older releases provided.
+     */
+    void _adjust(TicketHolder* holder, long long queuedMicrosDelta, bool cachePressed) {
+        const int kMinTickets = 128;
+        const int kMaxTickets = 1024;
+        const int kAdditiveStep = 16;
+        // More than this much total blocked-time per one-second interval counts as queueing.
+        const long long kWaitBudgetMicros = 5 * 1000;
+
+        const int outof = holder->outof();
+        int target = outof;
+        if (queuedMicrosDelta > kWaitBudgetMicros && holder->queued() > 0) {
+            if (cachePressed) {
+                return;
+            }
+            target = std::min(kMaxTickets, outof + kAdditiveStep);
+        } else if (queuedMicrosDelta == 0 && holder->used() * 2 < outof) {
+            // Shrinking by a quarter while fewer than half the tickets are out can never
+            // block on outstanding tickets.
+            target = std::max(kMinTickets, outof * 3 / 4);
+        }
+
+        if (target == outof) {
+            return;
+        }
+
+        Status status = holder->resize(target);
+        if (!status.isOK()) {
+            LOG(1) << "adaptive ticket resize to " << target << " failed: " << status;
+            return;
+        }
+        LOG(2) << "adaptive ticket resize: " << outof << " -> " << target;
+    }
+
+    WiredTigerSessionCache* _sessionCache;
+    AtomicBool _shuttingDown{false};
+};
+
 WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
                                        const std::string& path,
                                        ClockSource* cs,
@@ -415,6 +743,12 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     if (!_readOnly && !_ephemeral) {
         _checkpointThread = stdx::make_unique<WiredTigerCheckpointThread>(_sessionCache.get());
         _checkpointThread->go();
+
+        _compactionThread = stdx::make_unique<WiredTigerCompactionThread>(_sessionCache.get());
+        _compactionThread->go();
+
+        _ticketController = stdx::make_unique<WiredTigerTicketController>(_sessionCache.get());
+        _ticketController->go();
     }
 
     _sizeStorerUri = "table:sizeStorer";
@@ -458,6 +792,82 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.done();
     }
     bb.done();
+
+    BSONObjBuilder cb(b.subobjStart("checkpoint"));
+    cb.append("checkpoints", checkpointStats.checkpoints.load());
+    cb.append("scheduledTriggers", checkpointStats.scheduledTriggers.load());
+    cb.append("dirtyBytesTriggers", checkpointStats.dirtyBytesTriggers.load());
+    cb.append("journalBytesTriggers", checkpointStats.journalBytesTriggers.load());
+    cb.append("lastDurationMillis", checkpointStats.lastDurationMillis.load());
+    cb.append("totalDurationMillis", checkpointStats.totalDurationMillis.load());
+    cb.append("lastBytesWritten", checkpointStats.lastBytesWritten.load());
+    cb.append("totalBytesWritten", checkpointStats.totalBytesWritten.load());
+    cb.done();
+}
+
+void WiredTigerKVEngine::_registerIdentNamespace(StringData ident, StringData ns) {
+    stdx::lock_guard<stdx::mutex> lk(_identCacheStatsMutex);
+    _identCacheStats[ident.toString()].ns = ns.toString();
+}
+
+void WiredTigerKVEngine::appendCachePressureStats(WT_SESSION* session, BSONObjBuilder* bob) {
+    // Number of tables re-sampled per call. serverStatus (and FTDC, which runs it about once a
+    // second) drives the sampling, so a small fixed batch keeps the statistics cursor traffic
+    // negligible while still cycling through every table regularly.
+    const size_t kTablesPerSample = 10;
+
+    stdx::lock_guard<stdx::mutex> lk(_identCacheStatsMutex);
+
+    auto it = _identCacheStats.upper_bound(_lastSampledIdent);
+    for (size_t i = 0; i < kTablesPerSample && !_identCacheStats.empty(); i++) {
+        if (it == _identCacheStats.end()) {
+            it = _identCacheStats.begin();
+        }
+
+        const std::string uri = "statistics:" + _uri(it->first);
+        auto read = WiredTigerUtil::getStatisticsValueAs<long long>(
+            session, uri, "statistics=(fast)", WT_STAT_DSRC_CACHE_READ);
+        auto written = WiredTigerUtil::getStatisticsValueAs<long long>(
+            session, uri, "statistics=(fast)", WT_STAT_DSRC_CACHE_WRITE);
+        auto evictedClean = WiredTigerUtil::getStatisticsValueAs<long long>(
+            session, uri, "statistics=(fast)", WT_STAT_DSRC_CACHE_EVICTION_CLEAN);
+        auto evictedDirty = WiredTigerUtil::getStatisticsValueAs<long long>(
+            session, uri, "statistics=(fast)", WT_STAT_DSRC_CACHE_EVICTION_DIRTY);
+        auto bytesInUse = WiredTigerUtil::getStatisticsValueAs<long long>(
+            session, uri, "statistics=(fast)", WT_STAT_DSRC_CACHE_BYTES_INUSE);
+
+        // A table that cannot be read (e.g. queued for drop) keeps its previous sample.
+        if (read.isOK() && written.isOK() && evictedClean.isOK() && evictedDirty.isOK() &&
+            bytesInUse.isOK()) {
+            IdentCacheStats& stats = it->second;
+            stats.pagesRead = read.getValue();
+            stats.pagesWritten = written.getValue();
+            stats.pagesEvicted = evictedClean.getValue() + evictedDirty.getValue();
+            stats.bytesInCache = bytesInUse.getValue();
+        }
+
+        _lastSampledIdent = it->first;
+        ++it;
+    }
+
+    // Sum per namespace; a collection's tables and its index tables share one entry.
+    std::map<StringData, IdentCacheStats> byNs;
+    for (auto&& entry : _identCacheStats) {
+        IdentCacheStats& sum = byNs[entry.second.ns];
+        sum.pagesRead += entry.second.pagesRead;
+        sum.pagesWritten += entry.second.pagesWritten;
+        sum.pagesEvicted += entry.second.pagesEvicted;
+        sum.bytesInCache += entry.second.bytesInCache;
+    }
+
+    BSONObjBuilder section(bob->subobjStart("cachePressure"));
+    for (auto&& nsEntry : byNs) {
+        BSONObjBuilder nsBob(section.subobjStart(nsEntry.first));
+        nsBob.append("pages read into cache", nsEntry.second.pagesRead);
+        nsBob.append("pages written from cache", nsEntry.second.pagesWritten);
+        nsBob.append("pages evicted", nsEntry.second.pagesEvicted);
+        nsBob.append("bytes currently in cache", nsEntry.second.bytesInCache);
+    }
 }
 
 void WiredTigerKVEngine::cleanShutdown() {
@@ -470,6 +880,10 @@ void WiredTigerKVEngine::cleanShutdown() {
             _journalFlusher->shutdown();
         if (_checkpointThread)
             _checkpointThread->shutdown();
+        if (_compactionThread)
+            _compactionThread->shutdown();
+        if (_ticketController)
+            _ticketController->shutdown();
         _sizeStorer.reset();
         _sessionCache->shuttingDown();
 
@@ -718,6 +1132,8 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     }
     ret->postConstructorInit(opCtx);
 
+    _registerIdentNamespace(ident, ns);
+
     return std::move(ret);
 }
 
@@ -765,12 +1181,17 @@ SortedDataInterface* WiredTigerKVEngine::getGroupedSortedDataInterface(Operation
                                                                        StringData ident,
                                                                        const IndexDescriptor* desc,
                                                                        KVPrefix prefix) {
+    _registerIdentNamespace(ident, desc->parentNS());
     if (desc->unique())
         return new WiredTigerIndexUnique(opCtx, _uri(ident), desc, prefix, _readOnly);
     return new WiredTigerIndexStandard(opCtx, _uri(ident), desc, prefix, _readOnly);
 }
 
 Status WiredTigerKVEngine::dropIdent(OperationContext* opCtx, StringData ident) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_identCacheStatsMutex);
+        _identCacheStats.erase(ident.toString());
+    }
     _drop(ident);
     return Status::OK();
 }
@@ -806,22 +1227,26 @@ bool WiredTigerKVEngine::_drop(StringData ident) {
 }
 
 std::list<WiredTigerCachedCursor> WiredTigerKVEngine::filterCursorsWithQueuedDrops(
-    std::list<WiredTigerCachedCursor>* cache) {
+    WiredTigerSession::CursorCache* cache) {
     std::list<WiredTigerCachedCursor> toDrop;
 
     stdx::lock_guard<stdx::mutex> lk(_identToDropMutex);
     if (_identToDrop.empty())
         return toDrop;
 
-    for (auto i = cache->begin(); i != cache->end();) {
-        if (!i->_cursor ||
-            std::find(_identToDrop.begin(), _identToDrop.end(), std::string(i->_cursor->uri)) ==
-                _identToDrop.end()) {
-            ++i;
-            continue;
+    for (auto& entry : *cache) {
+        auto& cursors = entry.second.cursors;
+        for (auto i = cursors.begin(); i != cursors.end();) {
+            if (!i->_cursor ||
+                std::find(_identToDrop.begin(),
+                          _identToDrop.end(),
+                          std::string(i->_cursor->uri)) == _identToDrop.end()) {
+                ++i;
+                continue;
+            }
+            toDrop.push_back(*i);
+            i = cursors.erase(i);
         }
-        toDrop.push_back(*i);
-        i = cache->erase(i);
     }
 
     return toDrop;
@@ -32,6 +32,7 @@
 #pragma once
 
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -176,7 +177,7 @@ public:
     }
     void dropSomeQueuedIdents();
     std::list<WiredTigerCachedCursor> filterCursorsWithQueuedDrops(
-        std::list<WiredTigerCachedCursor>* cache);
+        WiredTigerSession::CursorCache* cache);
     bool haveDropsQueued() const;
 
     void syncSizeInfo(bool sync) const;
@@ -198,9 +199,21 @@ public:
 
     static void appendGlobalStats(BSONObjBuilder& b);
 
+    /**
+     * Appends per-table cache statistics (pages read into and written from cache, pages
+     * evicted, bytes currently in cache) summed per collection namespace; index tables are
+     * attributed to their parent collection. Only a few tables are re-sampled on each call, so
+     * the reported numbers for the rest come from their most recent sample; this keeps the
+     * cost of walking statistics cursors well below the cost of the serverStatus command that
+     * drives it.
+     */
+    void appendCachePressureStats(WT_SESSION* session, BSONObjBuilder* bob);
+
 private:
     class WiredTigerJournalFlusher;
     class WiredTigerCheckpointThread;
+    class WiredTigerCompactionThread;
+    class WiredTigerTicketController;
 
     Status _salvageIfNeeded(const char* uri);
     void _checkIdentPath(StringData ident);
@@ -210,6 +223,8 @@ private:
     std::string _uri(StringData ident) const;
     bool _drop(StringData ident);
 
+    void _registerIdentNamespace(StringData ident, StringData ns);
+
     WT_CONNECTION* _conn;
     WT_EVENT_HANDLER _eventHandler;
     std::unique_ptr<WiredTigerSessionCache> _sessionCache;
@@ -226,6 +241,8 @@ private:
     bool _readOnly;
     std::unique_ptr<WiredTigerJournalFlusher> _journalFlusher;  // Depends on _sizeStorer
     std::unique_ptr<WiredTigerCheckpointThread> _checkpointThread;
+    std::unique_ptr<WiredTigerCompactionThread> _compactionThread;
+    std::unique_ptr<WiredTigerTicketController> _ticketController;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -236,6 +253,20 @@ private:
 
     mutable Date_t _previousCheckedDropsQueued;
 
+    // Maps each opened ident to the collection namespace its table stores data for and the
+    // cache statistics from the table's most recent sample. Maintained for
+    // appendCachePressureStats().
+    struct IdentCacheStats {
+        std::string ns;
+        long long pagesRead = 0;
+        long long pagesWritten = 0;
+        long long pagesEvicted = 0;
+        long long bytesInCache = 0;
+    };
+    mutable stdx::mutex _identCacheStatsMutex;
+    std::map<std::string, IdentCacheStats> _identCacheStats;
+    std::string _lastSampledIdent;
+
     std::unique_ptr<WiredTigerSession> _backupSession;
 };
 }
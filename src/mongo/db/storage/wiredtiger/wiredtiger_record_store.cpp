@@ -137,6 +137,7 @@ public:
 
         stdx::lock_guard<stdx::mutex> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_totalBytes.store(0);
     }
 
     void rollback() final {}
@@ -184,8 +185,7 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
     while (!_isDead) {
         {
             MONGO_IDLE_THREAD_BLOCK;
-            stdx::lock_guard<stdx::mutex> lk(_mutex);
-            if (hasExcessStones_inlock()) {
+            if (hasExcessStones()) {
                 break;
             }
         }
@@ -193,20 +193,30 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
     }
 }
 
-boost::optional<WiredTigerRecordStore::OplogStones::Stone>
-WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
+std::vector<WiredTigerRecordStore::OplogStones::Stone>
+WiredTigerRecordStore::OplogStones::peekOldestStonesIfNeeded() const {
+    std::vector<Stone> batch;
 
-    if (!hasExcessStones_inlock()) {
-        return {};
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    int64_t totalBytes = _totalBytes.load();
+    for (const auto& stone : _stones) {
+        if (totalBytes <= _rs->cappedMaxSize()) {
+            break;
+        }
+        batch.push_back(stone);
+        totalBytes -= stone.bytes;
     }
 
-    return _stones.front();
+    return batch;
 }
 
-void WiredTigerRecordStore::OplogStones::popOldestStone() {
+void WiredTigerRecordStore::OplogStones::popOldestStones(size_t count) {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
-    _stones.pop_front();
+    invariant(count <= _stones.size());
+    for (size_t i = 0; i < count; i++) {
+        _totalBytes.fetchAndAdd(-_stones.front().bytes);
+        _stones.pop_front();
+    }
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRecord) {
@@ -232,6 +242,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRec
     LOG(2) << "create new oplogStone, current stones:" << _stones.size();
     OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), lastRecord};
     _stones.push_back(stone);
+    _totalBytes.fetchAndAdd(stone.bytes);
 
     _pokeReclaimThreadIfNeeded();
 }
@@ -271,6 +282,7 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // Remove the stones corresponding to the records that were deleted.
     int64_t offset = _stones.size() - numStonesToRemove;
     _stones.erase(_stones.begin() + offset, _stones.end());
+    _totalBytes.fetchAndAdd(-bytesInStonesToRemove);
 
     // Account for any remaining records from a partially truncated stone in the stone currently
     // being filled.
@@ -334,6 +346,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationCon
 
             OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), record->id};
             _stones.push_back(stone);
+            _totalBytes.fetchAndAdd(stone.bytes);
         }
 
         numRecords++;
@@ -419,6 +432,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
         log() << "Placing a marker at optime " << Timestamp(lastRecord.repr()).toStringPretty();
         OplogStones::Stone stone = {estRecordsPerStone, estBytesPerStone, lastRecord};
         _stones.push_back(stone);
+        _totalBytes.fetchAndAdd(stone.bytes);
     }
 
     // Account for the partially filled chunk.
@@ -427,7 +441,7 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
 }
 
 void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
-    if (hasExcessStones_inlock()) {
+    if (hasExcessStones()) {
         _oplogReclaimCv.notify_one();
     }
 }
@@ -761,6 +775,15 @@ int64_t WiredTigerRecordStore::storageSize(OperationContext* opCtx,
     if (_isEphemeral) {
         return dataSize(opCtx);
     }
+
+    // Serve non-verbose callers from the cache; reading the statistics table per call is too
+    // expensive for monitoring that polls every collection.
+    const int64_t kStorageSizeCacheMicros = 10 * 1000 * 1000;
+    if (infoLevel == 0 &&
+        static_cast<int64_t>(curTimeMicros64()) < _cachedStorageSizeExpiryMicros.load()) {
+        return _cachedStorageSize.load();
+    }
+
     WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSession(opCtx);
     StatusWith<int64_t> result =
         WiredTigerUtil::getStatisticsValueAs<int64_t>(session->getSession(),
@@ -773,8 +796,12 @@ int64_t WiredTigerRecordStore::storageSize(OperationContext* opCtx,
 
     if (size == 0 && _isCapped) {
         // Many things assume an empty capped collection still takes up space.
-        return 1;
+        size = 1;
     }
+
+    _cachedStorageSize.store(size);
+    _cachedStorageSizeExpiryMicros.store(static_cast<int64_t>(curTimeMicros64()) +
+                                         kStorageSizeCacheMicros);
     return size;
 }
 
@@ -1050,12 +1077,27 @@ bool WiredTigerRecordStore::yieldAndAwaitOplogDeletionRequest(OperationContext*
 }
 
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
-    while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
-        invariant(stone->lastRecord.isNormal());
+    while (true) {
+        // Truncate all currently excess stones as one range so we pay for a single truncate and
+        // transaction commit per wakeup instead of one per stone.
+        auto stones = _oplogStones->peekOldestStonesIfNeeded();
+        if (stones.empty()) {
+            break;
+        }
+
+        int64_t recordsToRemove = 0;
+        int64_t bytesToRemove = 0;
+        for (const auto& stone : stones) {
+            invariant(stone.lastRecord.isNormal());
+            recordsToRemove += stone.records;
+            bytesToRemove += stone.bytes;
+        }
+        const RecordId lastRecord = stones.back().lastRecord;
 
         LOG(1) << "Truncating the oplog between " << _oplogStones->firstRecord << " and "
-               << stone->lastRecord << " to remove approximately " << stone->records
-               << " records totaling to " << stone->bytes << " bytes";
+               << lastRecord << " to remove approximately " << recordsToRemove
+               << " records totaling to " << bytesToRemove << " bytes across " << stones.size()
+               << " stones";
 
         WiredTigerRecoveryUnit* ru = WiredTigerRecoveryUnit::get(opCtx);
         WT_SESSION* session = ru->getSession(opCtx)->getSession();
@@ -1069,19 +1111,19 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
 
             WiredTigerCursor endwrap(_uri, _tableId, true, opCtx);
             WT_CURSOR* end = endwrap.get();
-            setKey(end, stone->lastRecord);
+            setKey(end, lastRecord);
 
             invariantWTOK(session->truncate(session, nullptr, start, end, nullptr));
-            _changeNumRecords(opCtx, -stone->records);
-            _increaseDataSize(opCtx, -stone->bytes);
+            _changeNumRecords(opCtx, -recordsToRemove);
+            _increaseDataSize(opCtx, -bytesToRemove);
 
             wuow.commit();
 
-            // Remove the stone after a successful truncation.
-            _oplogStones->popOldestStone();
+            // Remove the stones after a successful truncation.
+            _oplogStones->popOldestStones(stones.size());
 
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
-            _oplogStones->firstRecord = stone->lastRecord;
+            _oplogStones->firstRecord = lastRecord;
         } catch (const WriteConflictException& wce) {
             LOG(1) << "Caught WriteConflictException while truncating oplog entries, retrying";
         }
@@ -1176,6 +1218,90 @@ StatusWith<RecordId> WiredTigerRecordStore::insertRecord(OperationContext* opCtx
     return StatusWith<RecordId>(record.id);
 }
 
+/**
+ * Streams records through a WiredTiger bulk cursor. Bulk cursors write leaf pages directly in
+ * key order with no page reconciliation churn, but require an empty table, exclusive access and
+ * operate outside any transaction, so this is only handed out by getBulkLoader() under those
+ * conditions.
+ */
+class WiredTigerRecordStore::BulkLoader : public RecordStoreBulkLoader {
+public:
+    BulkLoader(WiredTigerRecordStore* rs, UniqueWiredTigerSession session, WT_CURSOR* cursor)
+        : _rs(rs), _session(std::move(session)), _cursor(cursor) {}
+
+    ~BulkLoader() {
+        if (_cursor) {
+            // Finalize was never called; the caller is discarding the table.
+            _cursor->close(_cursor);
+        }
+    }
+
+    StatusWith<RecordId> addRecord(const char* data, int len) final {
+        invariant(_cursor);
+        const RecordId id = _rs->_nextId();
+        _rs->setKey(_cursor, id);
+        WiredTigerItem value(data, len);
+        _cursor->set_value(_cursor, value.Get());
+        int ret = WT_OP_CHECK(_cursor->insert(_cursor));
+        if (ret)
+            return wtRCToStatus(ret, "WiredTigerRecordStore::BulkLoader::addRecord");
+        _numRecords++;
+        _dataSize += len;
+        return StatusWith<RecordId>(id);
+    }
+
+    Status finalize() final {
+        invariant(_cursor);
+        // Closing the bulk cursor completes the load and makes the data visible to new
+        // transactions.
+        int ret = _cursor->close(_cursor);
+        _cursor = nullptr;
+        if (ret)
+            return wtRCToStatus(ret, "WiredTigerRecordStore::BulkLoader::finalize");
+
+        // Bulk writes bypass the transactional size bookkeeping, so account for them here.
+        // Passing a null OperationContext skips the rollback handler, which is correct because
+        // the load cannot be rolled back.
+        _rs->_numRecords.fetchAndAdd(_numRecords);
+        _rs->_increaseDataSize(nullptr, _dataSize);
+        return Status::OK();
+    }
+
+private:
+    WiredTigerRecordStore* _rs;  // not owned
+    UniqueWiredTigerSession _session;
+    WT_CURSOR* _cursor;
+    int64_t _numRecords = 0;
+    int64_t _dataSize = 0;
+};
+
+std::unique_ptr<RecordStoreBulkLoader> WiredTigerRecordStore::getBulkLoader(
+    OperationContext* opCtx) {
+    // Capped collections and the oplog depend on per-insert hooks (capped deletes, visibility),
+    // and bulk cursors require an empty table.
+    if (_isCapped || _useOplogHack || numRecords(opCtx) > 0 || dataSize(opCtx) > 0)
+        return nullptr;
+
+    // Open cursors can cause bulk open_cursor to fail with EBUSY.
+    WiredTigerSession* outerSession = WiredTigerRecoveryUnit::get(opCtx)->getSession(opCtx);
+    outerSession->closeAllCursors(_uri);
+
+    // Use a dedicated session so we don't hijack an existing transaction, and fail quickly
+    // rather than wait on a checkpoint.
+    UniqueWiredTigerSession session =
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getSession();
+    WT_SESSION* s = session->getSession();
+    WT_CURSOR* cursor;
+    int err = s->open_cursor(s, _uri.c_str(), NULL, "bulk,checkpoint_wait=false", &cursor);
+    if (err) {
+        warning() << "failed to create WiredTiger bulk cursor: " << wiredtiger_strerror(err);
+        warning() << "falling back to normal inserts for " << _uri;
+        return nullptr;
+    }
+
+    return stdx::make_unique<BulkLoader>(this, std::move(session), cursor);
+}
+
 void WiredTigerRecordStore::_dealtWithCappedId(SortedRecordIds::iterator it, bool didCommit) {
     invariant(it->isNormal());
     stdx::lock_guard<stdx::mutex> lk(_uncommittedRecordIdsMutex);
@@ -1370,6 +1496,43 @@ Status WiredTigerRecordStore::truncate(OperationContext* opCtx) {
     return Status::OK();
 }
 
+Status WiredTigerRecordStore::rangeTruncate(OperationContext* opCtx,
+                                            const RecordId& minRecordId,
+                                            const RecordId& maxRecordId,
+                                            int64_t hintDataSizeDiff,
+                                            int64_t hintNumRecordsDiff) {
+    WiredTigerCursor startWrap(_uri, _tableId, true, opCtx);
+    WT_CURSOR* start = startWrap.get();
+    if (minRecordId.isNull()) {
+        // Position the cursor on the first record so that the prefix, if any, bounds the
+        // truncate to this record store.
+        int ret = WT_READ_CHECK(start->next(start));
+        if (ret == WT_NOTFOUND) {
+            // Empty record stores don't have anything to truncate.
+            return Status::OK();
+        }
+        invariantWTOK(ret);
+    } else {
+        // WT_SESSION::truncate() does not require its bounding cursors to reference existing
+        // records; setting the key is sufficient.
+        setKey(start, minRecordId);
+    }
+
+    WiredTigerCursor stopWrap(_uri, _tableId, true, opCtx);
+    WT_CURSOR* stop = NULL;
+    if (!maxRecordId.isNull()) {
+        stop = stopWrap.get();
+        setKey(stop, maxRecordId);
+    }
+
+    WT_SESSION* session = WiredTigerRecoveryUnit::get(opCtx)->getSession(opCtx)->getSession();
+    invariantWTOK(WT_OP_CHECK(session->truncate(session, NULL, start, stop, NULL)));
+    _changeNumRecords(opCtx, hintNumRecordsDiff);
+    _increaseDataSize(opCtx, hintDataSizeDiff);
+
+    return Status::OK();
+}
+
 Status WiredTigerRecordStore::compact(OperationContext* opCtx,
                                       RecordStoreCompactAdaptor* adaptor,
                                       const CompactOptions* options,
@@ -169,6 +169,13 @@ public:
                                                      const char* damageSource,
                                                      const mutablebson::DamageVector& damages);
 
+    /**
+     * Maps to a WiredTiger bulk cursor: appended records go straight to leaf pages with no
+     * reconciliation churn. Returns nullptr for capped collections and the oplog, when the
+     * table is non-empty, or when the bulk cursor cannot be opened.
+     */
+    std::unique_ptr<RecordStoreBulkLoader> getBulkLoader(OperationContext* opCtx) final;
+
     virtual std::unique_ptr<SeekableRecordCursor> getCursor(OperationContext* opCtx,
                                                             bool forward) const = 0;
 
@@ -181,6 +188,12 @@ public:
 
     virtual Status truncate(OperationContext* opCtx);
 
+    virtual Status rangeTruncate(OperationContext* opCtx,
+                                 const RecordId& minRecordId = RecordId(),
+                                 const RecordId& maxRecordId = RecordId(),
+                                 int64_t hintDataSizeDiff = 0,
+                                 int64_t hintNumRecordsDiff = 0);
+
     virtual bool compactSupported() const {
         return !_isEphemeral;
     }
@@ -292,6 +305,7 @@ protected:
 
 private:
     class RandomCursor;
+    class BulkLoader;
 
     class CappedInsertChange;
     class NumRecordsChange;
@@ -347,6 +361,13 @@ private:
     AtomicInt64 _dataSize;
     AtomicInt64 _numRecords;
 
+    // Cached result of storageSize() and its expiry time. Refreshing the value walks a
+    // WiredTiger statistics cursor, so monitoring that polls collStats frequently across many
+    // collections reuses the last value for a few seconds. A verbose collStats (infoLevel > 0)
+    // always reads fresh statistics.
+    mutable AtomicInt64 _cachedStorageSize;
+    mutable AtomicInt64 _cachedStorageSizeExpiryMicros;
+
     WiredTigerSizeStorer* _sizeStorer;  // not owned, can be NULL
     int _sizeStorerCounter;
 
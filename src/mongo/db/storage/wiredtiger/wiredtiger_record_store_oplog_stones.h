@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <boost/optional.hpp>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
@@ -57,21 +59,19 @@ public:
 
     void kill();
 
-    bool hasExcessStones_inlock() const {
-        int64_t total_bytes = 0;
-        for (std::deque<OplogStones::Stone>::const_iterator it = _stones.begin();
-             it != _stones.end();
-             ++it) {
-            total_bytes += it->bytes;
-        }
-        return total_bytes > _rs->cappedMaxSize();
+    bool hasExcessStones() const {
+        return _totalBytes.load() > _rs->cappedMaxSize();
     }
 
     void awaitHasExcessStonesOrDead();
 
-    boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
+    /**
+     * Returns the oldest stones whose records can be truncated in one batch without bringing the
+     * oplog below its maximum size, in oldest-to-newest order. Empty if nothing needs reclaiming.
+     */
+    std::vector<OplogStones::Stone> peekOldestStonesIfNeeded() const;
 
-    void popOldestStone();
+    void popOldestStones(size_t count);
 
     void createNewStoneIfNeeded(RecordId lastRecord);
 
@@ -143,6 +143,11 @@ private:
     AtomicInt64 _currentRecords;  // Number of records in the stone being filled.
     AtomicInt64 _currentBytes;    // Number of bytes in the stone being filled.
 
+    // Total number of bytes covered by the stones in '_stones'. Maintained alongside the deque
+    // but readable without '_mutex', so the insert path and reclaim-thread wakeup checks don't
+    // have to take the lock and walk the deque.
+    AtomicInt64 _totalBytes;
+
     mutable stdx::mutex _mutex;  // Protects against concurrent access to the deque of oplog stones.
     std::deque<OplogStones::Stone> _stones;  // front = oldest, back = newest.
 };
@@ -36,7 +36,10 @@
 
 #include "mongo/base/init.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/concurrency/locker.h"
+#include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/stdx/condition_variable.h"
@@ -56,6 +59,12 @@ AtomicUInt64 nextSnapshotId{1};
 logger::LogSeverity kSlowTransactionSeverity = logger::LogSeverity::Debug(1);
 }  // namespace
 
+// When positive, read-only operations that open a snapshot within this many microseconds of
+// each other share one named WiredTiger snapshot instead of each setting up their own,
+// amortizing transaction-table setup across the reads in the window. Such reads may observe
+// data up to this much stale. 0 (the default) disables sharing.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerSharedSnapshotWindowMicros, long long, 0);
+
 WiredTigerRecoveryUnit::WiredTigerRecoveryUnit(WiredTigerSessionCache* sc)
     : _sessionCache(sc),
       _inUnitOfWork(false),
@@ -118,6 +127,9 @@ void WiredTigerRecoveryUnit::_abort() {
 void WiredTigerRecoveryUnit::beginUnitOfWork(OperationContext* opCtx) {
     invariant(!_areWriteUnitOfWorksBanned);
     invariant(!_inUnitOfWork);
+    // Writes must not build on a shared read snapshot; write operations hold a write lock
+    // before opening their snapshot and so never take the shared path.
+    invariant(!_isSharedSnapshot);
     _inUnitOfWork = true;
 }
 
@@ -206,6 +218,7 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
         LOG(3) << "WT rollback_transaction for snapshot id " << _mySnapshotId;
     }
     _active = false;
+    _isSharedSnapshot = false;
     _mySnapshotId = nextSnapshotId.fetchAndAdd(1);
     _oplogReadTill = RecordId();
 }
@@ -247,7 +260,18 @@ void WiredTigerRecoveryUnit::_txnOpen(OperationContext* opCtx) {
         _majorityCommittedSnapshot =
             _sessionCache->snapshotManager().beginTransactionOnCommittedSnapshot(s);
     } else {
-        invariantWTOK(s->begin_transaction(s, NULL));
+        // Read-only operations can join a shared named snapshot rather than setting up their
+        // own. Anything that might write — a unit of work is open, or the operation holds a
+        // write lock — must get a fresh snapshot, as must anyone if sharing fails.
+        const long long window = wiredTigerSharedSnapshotWindowMicros.load();
+        if (window > 0 && !_inUnitOfWork && opCtx && opCtx->lockState() &&
+            !opCtx->lockState()->isWriteLocked()) {
+            _isSharedSnapshot =
+                _sessionCache->snapshotManager().beginTransactionOnSharedSnapshot(s, window);
+        }
+        if (!_isSharedSnapshot) {
+            invariantWTOK(s->begin_transaction(s, NULL));
+        }
     }
 
     LOG(3) << "WT begin_transaction for snapshot id " << _mySnapshotId;
@@ -135,6 +135,8 @@ private:
     RecordId _oplogReadTill;
     bool _readFromMajorityCommittedSnapshot = false;
     SnapshotName _majorityCommittedSnapshot = SnapshotName::min();
+    // True while the open transaction runs on the shared read snapshot rather than its own.
+    bool _isSharedSnapshot = false;
     std::unique_ptr<Timer> _timer;
 
     typedef std::vector<std::unique_ptr<Change>> Changes;
@@ -54,6 +54,12 @@ bool WiredTigerServerStatusSection::includeByDefault() const {
     return true;
 }
 
+// Exporting the statistics table walks every cursor in a WiredTiger session and is one of
+// the most expensive sections to generate.
+bool WiredTigerServerStatusSection::supportsSectionCache() const {
+    return true;
+}
+
 BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
                                                        const BSONElement& configElement) const {
     // The session does not open a transaction here as one is not needed and opening one would
@@ -76,6 +82,10 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
 
     WiredTigerKVEngine::appendGlobalStats(bob);
 
+    // Per-namespace cache statistics, sampled a few tables at a time. FTDC captures this
+    // section, so the per-collection numbers end up in diagnostic data as well.
+    _engine->appendCachePressureStats(s, &bob);
+
     return bob.obj();
 }
 
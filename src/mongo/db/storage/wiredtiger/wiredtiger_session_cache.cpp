@@ -38,6 +38,7 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/db/mongod_options.h"
 #include "mongo/db/repl/repl_settings.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -48,6 +49,22 @@
 
 namespace mongo {
 
+namespace {
+
+// Process-wide cursor invalidation generations, striped by a hash of the table URI. DDL
+// operations bump the stripe for their table; each cursor pool remembers the generation it last
+// validated against, so detecting a stale pool is a single integer compare. Unrelated tables may
+// share a stripe; a collision only costs a spurious cursor reopen.
+const size_t kTableGenStripes = 64;
+AtomicUInt64 tableGenStripes[kTableGenStripes];
+
+AtomicUInt64& tableInvalidationGen(const std::string& uri) {
+    static const std::hash<std::string> hasher{};
+    return tableGenStripes[hasher(uri) % kTableGenStripes];
+}
+
+}  // namespace
+
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch),
       _cursorEpoch(cursorEpoch),
@@ -79,15 +96,22 @@ WiredTigerSession::~WiredTigerSession() {
 }
 
 WT_CURSOR* WiredTigerSession::getCursor(const std::string& uri, uint64_t id, bool forRecordStore) {
-    // Find the most recently used cursor
-    for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        if (i->_id == id) {
-            WT_CURSOR* c = i->_cursor;
-            _cursors.erase(i);
-            _cursorsOut++;
-            _cursorsCached--;
-            return c;
-        }
+    CursorPool& pool = _cursors[id];
+
+    const uint64_t currentGen = tableInvalidationGen(uri).loadRelaxed();
+    if (pool.invalGen != currentGen) {
+        // The table saw a DDL operation since these cursors were cached; they cannot be reused.
+        _closePool(&pool);
+        pool.invalGen = currentGen;
+    }
+
+    if (!pool.cursors.empty()) {
+        // Take the most recently used cursor
+        WT_CURSOR* c = pool.cursors.back()._cursor;
+        pool.cursors.pop_back();
+        _cursorsOut++;
+        _cursorsCached--;
+        return c;
     }
 
     WT_CURSOR* c = NULL;
@@ -105,10 +129,21 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
     invariant(cursor);
     _cursorsOut--;
 
+    CursorPool& pool = _cursors[id];
+    if (pool.invalGen != tableInvalidationGen(cursor->uri).loadRelaxed()) {
+        // The table saw a DDL operation while this cursor was checked out. Close the cursor (and
+        // anything still pooled for the table) rather than cache a cursor against a dropped or
+        // repaired ident. The pool's generation is refreshed by the next getCursor() call.
+        _closePool(&pool);
+        invariantWTOK(cursor->close(cursor));
+        return;
+    }
+
     invariantWTOK(cursor->reset(cursor));
 
-    // Cursors are pushed to the front of the list and removed from the back
-    _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor));
+    // Cursors are appended to their table's pool and reused from the back, so each pool is
+    // ordered oldest-first.
+    pool.cursors.push_back(WiredTigerCachedCursor(id, _cursorGen++, cursor));
     _cursorsCached++;
 
     // "Old" is defined as not used in the last N**2 operations, if we have N cursors cached.
@@ -116,23 +151,51 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
     // across all of them (i.e., each cursor has 1/N chance of used for each operation).  We
     // would like to cache N cursors in that case, so any given cursor could go N**2 operations
     // in between use.
-    while (_cursorGen - _cursors.back()._gen > 10000) {
-        cursor = _cursors.back()._cursor;
-        _cursors.pop_back();
+    for (auto i = _cursors.begin(); i != _cursors.end();) {
+        std::vector<WiredTigerCachedCursor>& cursors = i->second.cursors;
+        size_t expired = 0;
+        while (expired < cursors.size() && _cursorGen - cursors[expired]._gen > 10000) {
+            WT_CURSOR* old = cursors[expired]._cursor;
+            invariantWTOK(old->close(old));
+            _cursorsCached--;
+            expired++;
+        }
+        if (expired)
+            cursors.erase(cursors.begin(), cursors.begin() + expired);
+        if (cursors.empty() && i->first != id)
+            i = _cursors.erase(i);
+        else
+            ++i;
+    }
+}
+
+void WiredTigerSession::_closePool(CursorPool* pool) {
+    for (auto& entry : pool->cursors) {
+        WT_CURSOR* cursor = entry._cursor;
+        if (cursor)
+            invariantWTOK(cursor->close(cursor));
         _cursorsCached--;
-        invariantWTOK(cursor->close(cursor));
     }
+    pool->cursors.clear();
 }
 
 void WiredTigerSession::closeAllCursors(const std::string& uri) {
     invariant(_session);
 
     for (auto i = _cursors.begin(); i != _cursors.end();) {
-        WT_CURSOR* cursor = i->_cursor;
-        if (cursor && uri == cursor->uri) {
-            invariantWTOK(cursor->close(cursor));
+        std::vector<WiredTigerCachedCursor>& cursors = i->second.cursors;
+        for (auto j = cursors.begin(); j != cursors.end();) {
+            WT_CURSOR* cursor = j->_cursor;
+            if (cursor && uri == cursor->uri) {
+                invariantWTOK(cursor->close(cursor));
+                _cursorsCached--;
+                j = cursors.erase(j);
+            } else
+                ++j;
+        }
+        if (cursors.empty())
             i = _cursors.erase(i);
-        } else
+        else
             ++i;
     }
 }
@@ -159,6 +222,11 @@ uint64_t WiredTigerSession::genTableId() {
     return nextTableId.fetchAndAdd(1);
 }
 
+// static
+void WiredTigerSession::bumpTableGeneration(const std::string& uri) {
+    tableInvalidationGen(uri).fetchAndAdd(1);
+}
+
 // -----------------------
 
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
@@ -171,7 +239,29 @@ WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
 }
 
+// When positive, journaled durability waiters hand their journal flush to a dedicated
+// group-commit thread that batches concurrent waiters into a single log flush. A flush is
+// issued once wiredTigerGroupCommitMaxWaiters waiters have gathered or the oldest waiter has
+// waited this many microseconds, whichever comes first. Zero (the default) keeps flushing on
+// the waiter's own thread.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerGroupCommitWindowMicros, long long, 0);
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerGroupCommitMaxWaiters, int, 16);
+
 void WiredTigerSessionCache::shuttingDown() {
+    // Stop the group-commit thread, if it ever started, before setting the shutdown flag; any
+    // waiter it strands falls back to flushing on its own thread.
+    stdx::thread groupCommitThread;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_groupCommitMutex);
+        _groupCommitShutdown = true;
+        groupCommitThread.swap(_groupCommitThread);
+        _groupCommitFlusherCv.notify_one();
+        _groupCommitWaitersCv.notify_all();
+    }
+    if (groupCommitThread.joinable()) {
+        groupCommitThread.join();
+    }
+
     uint32_t actual = _shuttingDown.load();
     uint32_t expected;
 
@@ -237,6 +327,15 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
         return;
     }
 
+    // When group commit is enabled, journal flushes are issued by a dedicated thread that
+    // batches concurrent waiters into one flush.
+    if (_engine && _engine->isDurable() && wiredTigerGroupCommitWindowMicros.load() > 0) {
+        if (_waitUntilDurableGrouped()) {
+            return;
+        }
+        // Group commit is shutting down; flush on this thread instead.
+    }
+
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -268,10 +367,86 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
     _journalListener->onDurable(token);
 }
 
+bool WiredTigerSessionCache::_waitUntilDurableGrouped() {
+    stdx::unique_lock<stdx::mutex> lk(_groupCommitMutex);
+    if (_groupCommitShutdown) {
+        return false;
+    }
+    if (!_groupCommitThread.joinable()) {
+        _groupCommitThread = stdx::thread([this] { _groupCommitLoop(); });
+    }
+
+    // The next flush the thread issues begins after our commit, so it covers us.
+    const uint64_t myGen = _groupCommitGen + 1;
+    _groupCommitNewWaiters++;
+    _groupCommitFlusherCv.notify_one();
+    _groupCommitWaitersCv.wait(
+        lk, [&] { return _groupCommitFlushedGen >= myGen || _groupCommitShutdown; });
+    return _groupCommitFlushedGen >= myGen;
+}
+
+void WiredTigerSessionCache::_groupCommitLoop() {
+    stdx::unique_lock<stdx::mutex> lk(_groupCommitMutex);
+    if (_groupCommitShutdown) {
+        return;
+    }
+    UniqueWiredTigerSession session = getSession();
+    WT_SESSION* s = session->getSession();
+
+    while (true) {
+        _groupCommitFlusherCv.wait(
+            lk, [&] { return _groupCommitNewWaiters > 0 || _groupCommitShutdown; });
+        if (_groupCommitShutdown) {
+            return;
+        }
+
+        // Give later arrivals a chance to join this flush, bounded by the configured window
+        // and batch size; both knobs are re-read so they can be tuned at runtime.
+        const auto deadline = stdx::chrono::steady_clock::now() +
+            stdx::chrono::microseconds(wiredTigerGroupCommitWindowMicros.load());
+        const int maxWaiters = std::max(1, wiredTigerGroupCommitMaxWaiters.load());
+        while (_groupCommitNewWaiters < maxWaiters && !_groupCommitShutdown &&
+               _groupCommitFlusherCv.wait_until(lk, deadline) != stdx::cv_status::timeout) {
+        }
+        if (_groupCommitShutdown) {
+            return;
+        }
+
+        const uint64_t gen = ++_groupCommitGen;
+        _groupCommitNewWaiters = 0;
+        lk.unlock();
+
+        {
+            // Take the journal listener token before flushing so the durable optime reported
+            // covers exactly what this flush makes durable.
+            stdx::lock_guard<stdx::mutex> jlk(_journalListenerMutex);
+            JournalListener::Token token = _journalListener->getToken();
+            invariantWTOK(s->log_flush(s, "sync=on"));
+            _journalListener->onDurable(token);
+        }
+        LOG(4) << "flushed journal (group commit, generation " << gen << ")";
+
+        lk.lock();
+        _groupCommitFlushedGen = gen;
+        _groupCommitWaitersCv.notify_all();
+    }
+}
+
+WiredTigerSessionCache::SessionCacheBucket& WiredTigerSessionCache::_bucketForCurrentThread() {
+    static const std::hash<stdx::thread::id> hasher{};
+    return _sessionBuckets[hasher(stdx::this_thread::get_id()) % kSessionCacheBuckets];
+}
+
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    // Invalidate pooled cursors in sessions that are checked out to operations; cached sessions
+    // below have theirs closed directly.
+    WiredTigerSession::bumpTableGeneration(uri);
+
+    for (auto& bucket : _sessionBuckets) {
+        stdx::lock_guard<InstrumentedMutex> lock(bucket.mutex);
+        for (auto& session : bucket.sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -279,20 +454,28 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (auto& bucket : _sessionBuckets) {
+        stdx::lock_guard<InstrumentedMutex> lock(bucket.mutex);
+        for (auto& session : bucket.sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch before sweeping the buckets. Any release that re-checked the epoch
+    // under its bucket lock before the bump is collected by the sweep below; any release that
+    // re-checks after the bump sees the new epoch and frees its session directly.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (auto& bucket : _sessionBuckets) {
+        SessionCache bucketSwap;
+        {
+            stdx::lock_guard<InstrumentedMutex> lock(bucket.mutex);
+            bucket.sessions.swap(bucketSwap);
+        }
+        swap.insert(swap.end(), bucketSwap.begin(), bucketSwap.end());
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -309,20 +492,27 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    SessionCacheBucket& home = _bucketForCurrentThread();
+    const size_t homeIndex = &home - &_sessionBuckets[0];
+
+    // Try the calling thread's home bucket first, then steal from the other buckets so an
+    // imbalanced thread-to-bucket mapping doesn't make us open more sessions than we need.
+    for (size_t offset = 0; offset < kSessionCacheBuckets; offset++) {
+        SessionCacheBucket& bucket =
+            _sessionBuckets[(homeIndex + offset) % kSessionCacheBuckets];
+        stdx::lock_guard<InstrumentedMutex> lock(bucket.mutex);
+        if (!bucket.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = bucket.sessions.back();
+            bucket.sessions.pop_back();
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
-    // Outside of the cache partition lock, but on release will be put back on the cache
+    // Outside of the cache partition locks, but on release will be put back on the cache
     return UniqueWiredTigerSession(
-        new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
+        new WiredTigerSession(_conn, this, _epoch.loadRelaxed(), _cursorEpoch.loadRelaxed()));
 }
 
 void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
@@ -356,18 +546,19 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     }
 
     // If the cursor epoch has moved on, close all cursors in the session.
-    uint64_t cursorEpoch = _cursorEpoch.load();
+    uint64_t cursorEpoch = _cursorEpoch.loadRelaxed();
     if (session->_getCursorEpoch() != cursorEpoch)
         session->closeCursorsForQueuedDrops(_engine);
 
     bool returnedToCache = false;
-    uint64_t currentEpoch = _epoch.load();
+    uint64_t currentEpoch = _epoch.loadRelaxed();
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        SessionCacheBucket& bucket = _bucketForCurrentThread();
+        stdx::lock_guard<InstrumentedMutex> lock(bucket.mutex);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            bucket.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
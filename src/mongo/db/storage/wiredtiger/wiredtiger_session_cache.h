@@ -33,13 +33,19 @@
 
 #include <list>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/instrumented_mutex.h"
+#include "mongo/stdx/new.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
@@ -58,12 +64,25 @@ public:
 };
 
 /**
- * This is a structure that caches 1 cursor for each uri.
+ * This is a structure that caches a pool of cursors for each table.
  * The idea is that there is a pool of these somewhere.
  * NOT THREADSAFE
  */
 class WiredTigerSession {
 public:
+    /**
+     * Cached cursors for a single table, together with the table invalidation generation the
+     * pool was last validated against. Checking a pool for staleness after a DDL operation is a
+     * single integer compare.
+     */
+    struct CursorPool {
+        uint64_t invalGen = 0;
+        std::vector<WiredTigerCachedCursor> cursors;
+    };
+
+    // Maps each table id to its pool of idle cursors.
+    typedef stdx::unordered_map<uint64_t, CursorPool> CursorCache;
+
     /**
      * Creates a new WT session on the specified connection.
      *
@@ -106,6 +125,13 @@ public:
 
     static uint64_t genTableId();
 
+    /**
+     * Advances the invalidation generation for 'uri'. Cursor pools validated against an older
+     * generation close their cursors instead of reusing them, so even sessions that are checked
+     * out to operations discard cursors for the table the next time they touch its pool.
+     */
+    static void bumpTableGeneration(const std::string& uri);
+
     /**
      * For "metadata:" cursors. Guaranteed never to collide with genTableId() ids.
      */
@@ -114,8 +140,10 @@ public:
 private:
     friend class WiredTigerSessionCache;
 
-    // The cursor cache is a list of pairs that contain an ID and cursor
-    typedef std::list<WiredTigerCachedCursor> CursorCache;
+    /**
+     * Closes every cursor in 'pool' and empties it. Leaves the pool's generation unchanged.
+     */
+    void _closePool(CursorPool* pool);
 
     // Used internally by WiredTigerSessionCache
     uint64_t _getEpoch() const {
@@ -221,9 +249,24 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // The cached idle sessions are sharded across independently locked buckets so that the
+    // operation start/finish path does not serialize on a single mutex. Each thread hashes to a
+    // home bucket for both get and release; getSession() steals from the other buckets before
+    // creating a new session. The buckets are padded apart to avoid false sharing between their
+    // locks.
+    enum { kSessionCacheBuckets = 8 };
+    struct alignas(stdx::hardware_destructive_interference_size) SessionCacheBucket {
+        InstrumentedMutex mutex{"WTSessionCacheBucket"};
+        SessionCache sessions;
+    };
+    SessionCacheBucket _sessionBuckets[kSessionCacheBuckets];
+
+    /**
+     * Returns the bucket the calling thread hashes to.
+     */
+    SessionCacheBucket& _bucketForCurrentThread();
 
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
@@ -240,6 +283,31 @@ private:
     // Protects _journalListener.
     stdx::mutex _journalListenerMutex;
 
+    /**
+     * Waits for the dedicated group-commit thread to flush the journal past all commits that
+     * happened before this call. Starts the thread on first use. Returns false if group commit
+     * is shutting down, in which case the caller must flush on its own thread.
+     */
+    bool _waitUntilDurableGrouped();
+
+    /**
+     * Body of the group-commit thread: repeatedly gathers a batch of durability waiters,
+     * issues a single log flush on their behalf and wakes the whole batch.
+     */
+    void _groupCommitLoop();
+
+    // Group commit state, all guarded by _groupCommitMutex. A waiter arriving while generation
+    // 'n' is the latest flushed one is covered by flush 'n + 1', since that flush begins after
+    // the waiter's commit.
+    stdx::mutex _groupCommitMutex;
+    stdx::condition_variable _groupCommitFlusherCv;
+    stdx::condition_variable _groupCommitWaitersCv;
+    stdx::thread _groupCommitThread;
+    uint64_t _groupCommitGen = 0;
+    uint64_t _groupCommitFlushedGen = 0;
+    int _groupCommitNewWaiters = 0;
+    bool _groupCommitShutdown = false;
+
     /**
      * Returns a session to the cache for later reuse. If closeAll was called between getting this
      * session and releasing it, the session is directly released. This method is thread safe.
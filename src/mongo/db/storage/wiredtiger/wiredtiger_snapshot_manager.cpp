@@ -74,6 +74,8 @@ void WiredTigerSnapshotManager::cleanupUnneededSnapshots() {
 void WiredTigerSnapshotManager::dropAllSnapshots() {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _committedSnapshot = boost::none;
+    _sharedSnapshotName = boost::none;
+    _sharedSnapshotsToDrop.clear();
     invariantWTOK(_session->snapshot(_session, "drop=(all)"));
 }
 
@@ -81,6 +83,8 @@ void WiredTigerSnapshotManager::shutdown() {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     if (!_session)
         return;
+    _sharedSnapshotName = boost::none;
+    _sharedSnapshotsToDrop.clear();
     invariantWTOK(_session->close(_session, NULL));
     _session = nullptr;
 }
@@ -106,4 +110,44 @@ SnapshotName WiredTigerSnapshotManager::beginTransactionOnCommittedSnapshot(
     return *_committedSnapshot;
 }
 
+bool WiredTigerSnapshotManager::beginTransactionOnSharedSnapshot(WT_SESSION* session,
+                                                                 long long windowMicros) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+
+    if (!_session)
+        return false;  // Shutting down.
+
+    const long long now = _sharedSnapshotTimer.micros();
+    if (!_sharedSnapshotName || now - _sharedSnapshotCreatedMicros >= windowMicros) {
+        const uint64_t name = _nextSharedSnapshotName--;
+        const std::string config = str::stream() << "name=" << name;
+        int ret = _session->snapshot(_session, config.c_str());
+        if (ret != 0) {
+            LOG(1) << "failed to create shared snapshot: " << wiredtiger_strerror(ret);
+            return false;
+        }
+
+        if (_sharedSnapshotName) {
+            _sharedSnapshotsToDrop.push_back(*_sharedSnapshotName);
+        }
+        _sharedSnapshotName = name;
+        _sharedSnapshotCreatedMicros = now;
+
+        // Reap superseded shared snapshots. WiredTiger refuses to drop a snapshot that still
+        // has transactions running on it, so keep any that fail and retry at the next refresh.
+        for (auto it = _sharedSnapshotsToDrop.begin(); it != _sharedSnapshotsToDrop.end();) {
+            const std::string dropConfig = str::stream() << "drop=(names=[" << *it << "])";
+            if (_session->snapshot(_session, dropConfig.c_str()) == 0) {
+                it = _sharedSnapshotsToDrop.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    StringBuilder config;
+    config << "snapshot=" << *_sharedSnapshotName;
+    return session->begin_transaction(session, config.str().c_str()) == 0;
+}
+
 }  // namespace mongo
@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <limits>
+#include <vector>
+
 #include <boost/optional.hpp>
 #include <wiredtiger.h>
 
@@ -36,6 +39,7 @@
 #include "mongo/db/storage/snapshot_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -83,9 +87,35 @@ public:
      */
     boost::optional<SnapshotName> getMinSnapshotForNextCommittedRead() const;
 
+    /**
+     * Starts a transaction on 'session' against a shared named snapshot that is refreshed at
+     * most once every 'windowMicros' microseconds, so point reads arriving within the same
+     * window amortize the cost of snapshot setup inside WiredTiger's transaction table.
+     *
+     * Reads on the shared snapshot may observe data up to 'windowMicros' stale relative to a
+     * fresh snapshot, so callers must only use this for read-only operations that tolerate
+     * that staleness.
+     *
+     * Returns false without starting a transaction if the shared snapshot could not be
+     * created or joined; the caller should fall back to an ordinary begin_transaction.
+     */
+    bool beginTransactionOnSharedSnapshot(WT_SESSION* session, long long windowMicros);
+
 private:
     mutable stdx::mutex _mutex;  // Guards all members.
     boost::optional<SnapshotName> _committedSnapshot;
-    WT_SESSION* _session;  // only used for dropping snapshots.
+    WT_SESSION* _session;  // only used for creating and dropping named snapshots.
+
+    // State for beginTransactionOnSharedSnapshot(). Shared snapshot names are allocated
+    // downward from the top of the id space so they always sort above the timestamp-derived
+    // names used for committed snapshots; cleanupUnneededSnapshots() drops names below the
+    // committed snapshot and must never reap a live shared snapshot.
+    boost::optional<uint64_t> _sharedSnapshotName;
+    long long _sharedSnapshotCreatedMicros = 0;
+    uint64_t _nextSharedSnapshotName = std::numeric_limits<uint64_t>::max();
+    // Superseded shared snapshots that could not be dropped yet because transactions may still
+    // be running on them; retried at each refresh.
+    std::vector<uint64_t> _sharedSnapshotsToDrop;
+    Timer _sharedSnapshotTimer;
 };
 }
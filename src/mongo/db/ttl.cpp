@@ -37,6 +37,7 @@
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
+#include "mongo/db/background.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog_entry.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
@@ -50,10 +51,12 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/matcher/extensions_callback_disallow_extensions.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/op_observer.h"
 #include "mongo/db/ops/insert.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator_global.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
@@ -72,6 +75,16 @@ ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocume
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorEnabled, bool, true);
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorSleepSecs, int, 60);  // used for testing
 
+// When positive, expired documents are deleted in groups of up to this many per storage
+// transaction rather than one transaction per document. Zero preserves the original
+// one-document-at-a-time behavior.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorBatchSize, int, 0);
+
+// When enabled, a collection whose TTL index contains only already-expired keys is emptied
+// with a single truncate instead of per-document deletes. Intended for time-series retention
+// schemes that write to one collection per time period and let whole periods age out.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorTruncateFullyExpired, bool, false);
+
 class TTLMonitor : public BackgroundJob {
 public:
     TTLMonitor() {}
@@ -188,6 +201,11 @@ private:
 
         LOG(1) << "ns: " << collectionNSS << " key: " << key << " name: " << name;
 
+        if (ttlMonitorTruncateFullyExpired.load() &&
+            _truncateIfFullyExpired(opCtx, collectionNSS, name)) {
+            return;
+        }
+
         AutoGetCollection autoGetCollection(opCtx, collectionNSS, MODE_IX);
         Collection* collection = autoGetCollection.getCollection();
         if (!collection) {
@@ -246,32 +264,247 @@ private:
             opCtx, std::move(qr), ExtensionsCallbackDisallowExtensions());
         invariantOK(canonicalQuery.getStatus());
 
-        DeleteStageParams params;
-        params.isMulti = true;
-        params.canonicalQuery = canonicalQuery.getValue().get();
-
-        auto exec =
-            InternalPlanner::deleteWithIndexScan(opCtx,
-                                                 collection,
-                                                 params,
-                                                 desc,
-                                                 startKey,
-                                                 endKey,
-                                                 BoundInclusion::kIncludeBothStartAndEndKeys,
-                                                 PlanExecutor::YIELD_AUTO,
-                                                 direction);
-
-        Status result = exec->executePlan();
-        if (!result.isOK()) {
-            error() << "ttl query execution for index " << idx
-                    << " failed with status: " << redact(result);
-            return;
-        }
+        long long numDeleted = 0;
+        const int batchSize = ttlMonitorBatchSize.load();
+        if (batchSize > 0) {
+            numDeleted = _deleteExpiredBatched(opCtx,
+                                               collection,
+                                               desc,
+                                               *canonicalQuery.getValue(),
+                                               startKey,
+                                               endKey,
+                                               direction,
+                                               batchSize);
+        } else {
+            DeleteStageParams params;
+            params.isMulti = true;
+            params.canonicalQuery = canonicalQuery.getValue().get();
+
+            auto exec = InternalPlanner::deleteWithIndexScan(
+                opCtx,
+                collection,
+                params,
+                desc,
+                startKey,
+                endKey,
+                BoundInclusion::kIncludeBothStartAndEndKeys,
+                PlanExecutor::YIELD_AUTO,
+                direction);
+
+            Status result = exec->executePlan();
+            if (!result.isOK()) {
+                error() << "ttl query execution for index " << idx
+                        << " failed with status: " << redact(result);
+                return;
+            }
 
-        const long long numDeleted = DeleteStage::getNumDeleted(*exec);
+            numDeleted = DeleteStage::getNumDeleted(*exec);
+        }
         ttlDeletedDocuments.increment(numDeleted);
         LOG(1) << "deleted: " << numDeleted;
     }
+
+    /**
+     * Returns true if the TTL index named 'indexName' exists, indexes every document (it is
+     * neither sparse nor partial), and both its smallest and largest keys are dates that have
+     * already expired. The keys of a single-field index are totally ordered and dates sort
+     * contiguously, so expired extremes imply that every indexed key -- and therefore every
+     * document -- is expired.
+     */
+    bool _allIndexKeysExpired(OperationContext* opCtx,
+                              Collection* collection,
+                              StringData indexName) {
+        IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, indexName);
+        if (!desc) {
+            return false;
+        }
+        if (desc->isSparse() || desc->isPartial()) {
+            // Some documents may have no index entry at all; the extremes prove nothing
+            // about them.
+            return false;
+        }
+        const BSONObj key = desc->keyPattern();
+        if (key.nFields() != 1) {
+            return false;
+        }
+        BSONElement secondsExpireElt = desc->infoObj()[secondsExpireField];
+        if (!secondsExpireElt.isNumber()) {
+            return false;
+        }
+        const Date_t expirationTime = Date_t::now() - Seconds(secondsExpireElt.numberLong());
+
+        const BSONObj minKey = BSON("" << MINKEY);
+        const BSONObj maxKey = BSON("" << MAXKEY);
+        const bool ascending = key.firstElement().number() >= 0;
+
+        // Read one key from each end of the index. The scan direction and bounds are given in
+        // traversal order, so they flip together for a descending key.
+        for (int end = 0; end < 2; end++) {
+            const bool lowToHigh = (end == 0) == ascending;
+            auto exec = InternalPlanner::indexScan(opCtx,
+                                                   collection,
+                                                   desc,
+                                                   lowToHigh ? minKey : maxKey,
+                                                   lowToHigh ? maxKey : minKey,
+                                                   BoundInclusion::kIncludeBothStartAndEndKeys,
+                                                   PlanExecutor::NO_YIELD,
+                                                   lowToHigh ? InternalPlanner::FORWARD
+                                                             : InternalPlanner::BACKWARD);
+            BSONObj keyObj;
+            if (PlanExecutor::ADVANCED != exec->getNext(&keyObj, nullptr)) {
+                // Empty index (or a scan error); there is nothing to truncate.
+                return false;
+            }
+            BSONElement elt = keyObj.firstElement();
+            if (elt.type() != Date || elt.date() > expirationTime) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Fast path for per-period retention collections: once every key in the TTL index has
+     * expired, the whole collection is due for deletion, and a single truncate -- replicated
+     * the same way as the emptyCapped command -- replaces the per-document deletes. Returns
+     * true if the collection was truncated.
+     */
+    bool _truncateIfFullyExpired(OperationContext* opCtx,
+                                 const NamespaceString& collectionNSS,
+                                 StringData indexName) {
+        if (collectionNSS.isSystem() || NamespaceString::virtualized(collectionNSS.ns())) {
+            return false;
+        }
+
+        // Pre-check under an intent lock so the common not-yet-expired case never pays for
+        // the exclusive lock the truncate itself requires.
+        {
+            AutoGetCollection autoGetCollection(opCtx, collectionNSS, MODE_IS);
+            Collection* collection = autoGetCollection.getCollection();
+            if (!collection || !_allIndexKeysExpired(opCtx, collection, indexName)) {
+                return false;
+            }
+        }
+
+        AutoGetDb autoDb(opCtx, collectionNSS.db(), MODE_X);
+        Database* db = autoDb.getDb();
+        if (!db) {
+            return false;
+        }
+        Collection* collection = db->getCollection(opCtx, collectionNSS);
+        if (!collection) {
+            return false;
+        }
+        if (!repl::getGlobalReplicationCoordinator()->canAcceptWritesFor(opCtx, collectionNSS)) {
+            return false;
+        }
+        // Writes may have arrived between the pre-check and acquiring the exclusive lock.
+        if (!_allIndexKeysExpired(opCtx, collection, indexName)) {
+            return false;
+        }
+
+        BackgroundOperation::assertNoBgOpInProgForNs(collectionNSS.ns());
+
+        const long long numRecords = collection->numRecords(opCtx);
+        writeConflictRetry(opCtx, "ttl truncate", collectionNSS.ns(), [&] {
+            WriteUnitOfWork wuow(opCtx);
+            uassertStatusOK(collection->truncate(opCtx));
+            getGlobalServiceContext()->getOpObserver()->onEmptyCapped(
+                opCtx, collection->ns(), collection->uuid());
+            wuow.commit();
+        });
+
+        ttlDeletedDocuments.increment(numRecords);
+        LOG(1) << "truncated fully expired collection " << collectionNSS << ", removing "
+               << numRecords << " documents";
+        return true;
+    }
+
+    /**
+     * Deletes expired documents in groups of up to 'batchSize' per WriteUnitOfWork, amortizing
+     * the per-transaction journal and commit overhead across the group. Each delete is still
+     * replicated as its own oplog entry so secondaries apply the pass unchanged; only the
+     * storage engine transaction is batched.
+     *
+     * Returns the number of documents deleted.
+     */
+    long long _deleteExpiredBatched(OperationContext* opCtx,
+                                    Collection* collection,
+                                    const IndexDescriptor* desc,
+                                    const CanonicalQuery& query,
+                                    const BSONObj& startKey,
+                                    const BSONObj& endKey,
+                                    InternalPlanner::Direction direction,
+                                    int batchSize) {
+        long long numDeleted = 0;
+        bool moreExpired = true;
+        while (moreExpired) {
+            opCtx->checkForInterrupt();
+
+            // Gather the next batch of candidates. The scan does not yield; 'batchSize' bounds
+            // how long its snapshot stays open. Deleted documents vanish from the index, so
+            // restarting the scan from 'startKey' each batch resumes where the last one left
+            // off.
+            std::vector<RecordId> batch;
+            {
+                auto exec =
+                    InternalPlanner::indexScan(opCtx,
+                                               collection,
+                                               desc,
+                                               startKey,
+                                               endKey,
+                                               BoundInclusion::kIncludeBothStartAndEndKeys,
+                                               PlanExecutor::NO_YIELD,
+                                               direction);
+
+                BSONObj keyObj;
+                RecordId rid;
+                PlanExecutor::ExecState state = PlanExecutor::IS_EOF;
+                while (batch.size() < static_cast<size_t>(batchSize) &&
+                       PlanExecutor::ADVANCED == (state = exec->getNext(&keyObj, &rid))) {
+                    batch.push_back(rid);
+                }
+                if (batch.size() < static_cast<size_t>(batchSize) &&
+                    PlanExecutor::IS_EOF != state) {
+                    error() << "ttl index scan for " << desc->indexName() << " on "
+                            << collection->ns() << " died with state "
+                            << PlanExecutor::statestr(state);
+                    break;
+                }
+            }
+            if (batch.empty()) {
+                break;
+            }
+
+            long long deletedInBatch = 0;
+            writeConflictRetry(opCtx, "ttl batched delete", collection->ns().ns(), [&] {
+                deletedInBatch = 0;
+                WriteUnitOfWork wuow(opCtx);
+                for (const RecordId& rid : batch) {
+                    Snapshotted<BSONObj> doc;
+                    if (!collection->findDoc(opCtx, rid, &doc)) {
+                        // Deleted by a concurrent operation since the scan.
+                        continue;
+                    }
+                    // The document may have been updated since the scan's snapshot; only
+                    // delete it if it is still expired.
+                    if (!query.root()->matchesBSON(doc.value())) {
+                        continue;
+                    }
+                    OpDebug* const nullOpDebug = nullptr;
+                    collection->deleteDocument(opCtx, kUninitializedStmtId, rid, nullOpDebug);
+                    deletedInBatch++;
+                }
+                wuow.commit();
+            });
+            numDeleted += deletedInBatch;
+
+            // A full batch of candidates that yielded no deletes means we are not making
+            // progress; leave the remainder for the next pass rather than spinning.
+            moreExpired = batch.size() == static_cast<size_t>(batchSize) && deletedInBatch > 0;
+        }
+        return numDeleted;
+    }
 };
 
 namespace {
@@ -56,6 +56,7 @@
 #include "mongo/db/update/pull_node.h"
 #include "mongo/db/update/pullall_node.h"
 #include "mongo/db/update/rename_node.h"
+#include "mongo/db/update/set_from_expression_node.h"
 #include "mongo/db/update/set_node.h"
 #include "mongo/db/update/unset_node.h"
 #include "mongo/platform/unordered_map.h"
@@ -121,6 +122,10 @@ void init(NameMap* nameMap) {
     ModifierEntry* entrySet = new ModifierEntry("$set", MOD_SET);
     nameMap->insert(make_pair(StringData(entrySet->name), entrySet));
 
+    ModifierEntry* entrySetFromExpression =
+        new ModifierEntry("$setFromExpression", MOD_SET_FROM_EXPRESSION);
+    nameMap->insert(make_pair(StringData(entrySetFromExpression->name), entrySetFromExpression));
+
     ModifierEntry* entrySetOnInsert = new ModifierEntry("$setOnInsert", MOD_SET_ON_INSERT);
     nameMap->insert(make_pair(StringData(entrySetOnInsert->name), entrySetOnInsert));
 
@@ -216,6 +221,8 @@ std::unique_ptr<UpdateLeafNode> makeUpdateLeafNode(ModifierType modType) {
             return stdx::make_unique<RenameNode>();
         case MOD_SET:
             return stdx::make_unique<SetNode>();
+        case MOD_SET_FROM_EXPRESSION:
+            return stdx::make_unique<SetFromExpressionNode>();
         case MOD_SET_ON_INSERT:
             return stdx::make_unique<SetNode>(UpdateNode::Context::kInsertOnly);
         case MOD_UNSET:
@@ -49,6 +49,7 @@ enum ModifierType {
     MOD_PUSH,
     MOD_PUSH_ALL,
     MOD_SET,
+    MOD_SET_FROM_EXPRESSION,
     MOD_SET_ON_INSERT,
     MOD_RENAME,
     MOD_UNSET,
@@ -0,0 +1,102 @@
+/**
+ * Copyright (C) 2017 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/set_from_expression_node.h"
+
+#include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/query/collation/collator_interface.h"
+
+namespace mongo {
+
+Status SetFromExpressionNode::init(BSONElement modExpr, const CollatorInterface* collator) {
+    invariant(modExpr.ok());
+
+    _rawExpr = modExpr;
+
+    return parseExpression(collator);
+}
+
+void SetFromExpressionNode::setCollator(const CollatorInterface* collator) {
+    // Comparisons inside the expression (e.g. $eq, $cond) must respect the operation's
+    // collation, so the expression is reparsed against a context holding the collator.
+    uassertStatusOK(parseExpression(collator));
+}
+
+Status SetFromExpressionNode::parseExpression(const CollatorInterface* collator) try {
+    // The namespace and operation context on this ExpressionContext are never used:
+    // expression parsing and evaluation need only the collator and the variable state.
+    AggregationRequest request(NamespaceString("local.$cmd.update"), {});
+    _expCtx = new ExpressionContext(nullptr,
+                                    request,
+                                    CollatorInterface::cloneCollator(collator),
+                                    StringMap<ExpressionContext::ResolvedNamespace>());
+    _expression =
+        Expression::parseOperand(_expCtx, _rawExpr, _expCtx->variablesParseState)->optimize();
+    return Status::OK();
+} catch (const DBException& ex) {
+    return ex.toStatus();
+}
+
+BSONObj SetFromExpressionNode::evaluateToWrappedBson(const mutablebson::Element& element) const {
+    // Serialize the document's current state, so earlier modifiers in the same update are
+    // visible to the expression, and evaluate over it. For elements not yet attached to
+    // the document (new paths), this is the unmodified subtree, which is what we want.
+    const BSONObj current = element.getDocument().getObject();
+    Value result = _expression->evaluate(Document(current));
+    if (result.missing()) {
+        // Align with computed projections, which turn missing into null rather than
+        // leaving a field in an undefined state.
+        result = Value(BSONNULL);
+    }
+    BSONObjBuilder bob;
+    result.addToBsonObj(&bob, StringData());
+    return bob.obj();
+}
+
+bool SetFromExpressionNode::updateExistingElement(mutablebson::Element* element) const {
+    const BSONObj wrapped = evaluateToWrappedBson(*element);
+    const BSONElement val = wrapped.firstElement();
+
+    // If 'element' is deserialized, then element.getValue() will be EOO, which will never
+    // equal 'val'.
+    if (element->getValue().binaryEqualValues(val)) {
+        return false;
+    }
+    invariantOK(element->setValueBSONElement(val));
+    return true;
+}
+
+void SetFromExpressionNode::setValueForNewElement(mutablebson::Element* element) const {
+    const BSONObj wrapped = evaluateToWrappedBson(*element);
+    invariantOK(element->setValueBSONElement(wrapped.firstElement()));
+}
+
+}  // namespace mongo
@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2017 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/update/path_creating_node.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+
+/**
+ * Represents the application of a $setFromExpression to the value at the end of a path.
+ *
+ * $setFromExpression behaves like $set, except that its argument is an aggregation
+ * expression evaluated over the current state of the matched document:
+ *
+ *     {$setFromExpression: {total: {$add: ["$price", "$tax"]}}}
+ *
+ * This lets clients issue computed updates server-side instead of falling back to a
+ * read-modify-write round trip. The computed value, not the expression, is what gets
+ * logged for replication, so secondaries apply an ordinary $set.
+ */
+class SetFromExpressionNode : public PathCreatingNode {
+public:
+    Status init(BSONElement modExpr, const CollatorInterface* collator) final;
+
+    std::unique_ptr<UpdateNode> clone() const final {
+        return stdx::make_unique<SetFromExpressionNode>(*this);
+    }
+
+    void setCollator(const CollatorInterface* collator) final;
+
+protected:
+    bool updateExistingElement(mutablebson::Element* element) const final;
+    void setValueForNewElement(mutablebson::Element* element) const final;
+
+private:
+    Status parseExpression(const CollatorInterface* collator);
+
+    /**
+     * Evaluates the expression over the document owning 'element' and returns the result
+     * wrapped in a single-element BSONObj with an empty field name. An expression that
+     * evaluates to missing produces null, like a computed projection would.
+     */
+    BSONObj evaluateToWrappedBson(const mutablebson::Element& element) const;
+
+    // The raw expression operand, pointing into the update specification. Kept so the
+    // expression can be reparsed when a collator is attached.
+    BSONElement _rawExpr;
+
+    boost::intrusive_ptr<ExpressionContext> _expCtx;
+    boost::intrusive_ptr<Expression> _expression;
+};
+
+}  // namespace mongo
@@ -0,0 +1,151 @@
+/**
+ * Copyright (C) 2017 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/set_from_expression_node.h"
+
+#include "mongo/bson/mutable/algorithm.h"
+#include "mongo/bson/mutable/mutable_bson_test_utils.h"
+#include "mongo/db/json.h"
+#include "mongo/db/update/update_node_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using SetFromExpressionNodeTest = UpdateNodeTest;
+using mongo::mutablebson::Document;
+using mongo::mutablebson::Element;
+
+TEST(SetFromExpressionNodeTest, InitSucceedsForValidExpression) {
+    auto update = fromjson("{$setFromExpression: {a: {$add: ['$a', '$b']}}}");
+    const CollatorInterface* collator = nullptr;
+    SetFromExpressionNode node;
+    ASSERT_OK(node.init(update["$setFromExpression"]["a"], collator));
+}
+
+TEST(SetFromExpressionNodeTest, InitFailsForUnknownExpression) {
+    auto update = fromjson("{$setFromExpression: {a: {$noSuchExpression: 1}}}");
+    const CollatorInterface* collator = nullptr;
+    SetFromExpressionNode node;
+    ASSERT_NOT_OK(node.init(update["$setFromExpression"]["a"], collator));
+}
+
+TEST_F(SetFromExpressionNodeTest, ApplyComputedValueToExistingField) {
+    auto update = fromjson("{$setFromExpression: {total: {$add: ['$price', '$tax']}}}");
+    const CollatorInterface* collator = nullptr;
+    SetFromExpressionNode node;
+    ASSERT_OK(node.init(update["$setFromExpression"]["total"], collator));
+
+    Document doc(fromjson("{price: 10, tax: 2, total: 0}"));
+    setPathTaken("total");
+    addIndexedPath("total");
+    auto result = node.apply(getApplyParams(doc.root()["total"]));
+    ASSERT_FALSE(result.noop);
+    ASSERT_TRUE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{price: 10, tax: 2, total: 12}"), doc);
+    ASSERT_EQUALS(fromjson("{$set: {total: 12}}"), getLogDoc());
+}
+
+TEST_F(SetFromExpressionNodeTest, ApplyNoOpWhenValueUnchanged) {
+    auto update = fromjson("{$setFromExpression: {total: {$add: ['$price', '$tax']}}}");
+    const CollatorInterface* collator = nullptr;
+    SetFromExpressionNode node;
+    ASSERT_OK(node.init(update["$setFromExpression"]["total"], collator));
+
+    Document doc(fromjson("{price: 10, tax: 2, total: 12}"));
+    setPathTaken("total");
+    addIndexedPath("total");
+    auto result = node.apply(getApplyParams(doc.root()["total"]));
+    ASSERT_TRUE(result.noop);
+    ASSERT_FALSE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{price: 10, tax: 2, total: 12}"), doc);
+    ASSERT_EQUALS(fromjson("{}"), getLogDoc());
+}
+
+TEST_F(SetFromExpressionNodeTest, ApplyCreatesNewField) {
+    auto update = fromjson("{$setFromExpression: {total: {$multiply: ['$price', 2]}}}");
+    const CollatorInterface* collator = nullptr;
+    SetFromExpressionNode node;
+    ASSERT_OK(node.init(update["$setFromExpression"]["total"], collator));
+
+    Document doc(fromjson("{price: 21}"));
+    setPathToCreate("total");
+    addIndexedPath("total");
+    auto result = node.apply(getApplyParams(doc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_TRUE(result.indexesAffected);
+    ASSERT_EQUALS(fromjson("{price: 21, total: 42}"), doc);
+    ASSERT_EQUALS(fromjson("{$set: {total: 42}}"), getLogDoc());
+}
+
+TEST_F(SetFromExpressionNodeTest, ApplyFieldPathOverDottedTarget) {
+    auto update = fromjson("{$setFromExpression: {'stats.sum': {$add: ['$a', '$stats.sum']}}}");
+    const CollatorInterface* collator = nullptr;
+    SetFromExpressionNode node;
+    ASSERT_OK(node.init(update["$setFromExpression"]["stats.sum"], collator));
+
+    Document doc(fromjson("{a: 5, stats: {sum: 7}}"));
+    setPathTaken("stats.sum");
+    auto result = node.apply(getApplyParams(doc.root()["stats"]["sum"]));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(fromjson("{a: 5, stats: {sum: 12}}"), doc);
+    ASSERT_EQUALS(fromjson("{$set: {'stats.sum': 12}}"), getLogDoc());
+}
+
+TEST_F(SetFromExpressionNodeTest, MissingEvaluationResultBecomesNull) {
+    auto update = fromjson("{$setFromExpression: {a: '$noSuchField'}}");
+    const CollatorInterface* collator = nullptr;
+    SetFromExpressionNode node;
+    ASSERT_OK(node.init(update["$setFromExpression"]["a"], collator));
+
+    Document doc(fromjson("{a: 1}"));
+    setPathTaken("a");
+    auto result = node.apply(getApplyParams(doc.root()["a"]));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(fromjson("{a: null}"), doc);
+    ASSERT_EQUALS(fromjson("{$set: {a: null}}"), getLogDoc());
+}
+
+TEST_F(SetFromExpressionNodeTest, ConstantOperandBehavesLikeSet) {
+    auto update = fromjson("{$setFromExpression: {a: 5}}");
+    const CollatorInterface* collator = nullptr;
+    SetFromExpressionNode node;
+    ASSERT_OK(node.init(update["$setFromExpression"]["a"], collator));
+
+    Document doc(fromjson("{a: 1}"));
+    setPathTaken("a");
+    auto result = node.apply(getApplyParams(doc.root()["a"]));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(fromjson("{a: 5}"), doc);
+    ASSERT_EQUALS(fromjson("{$set: {a: 5}}"), getLogDoc());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -213,7 +213,14 @@ inline Status UpdateDriver::addAndParse(const modifiertable::ModifierType type,
     }
 
     unique_ptr<ModifierInterface> mod(modifiertable::makeUpdateMod(type));
-    dassert(mod.get());
+    if (!mod) {
+        // Some modifiers (e.g. $setFromExpression) exist only in the UpdateNode
+        // implementation and cannot be applied by this legacy path.
+        return Status(ErrorCodes::InvalidOptions,
+                      str::stream() << "The featureCompatibilityVersion must be 3.6 to use the "
+                                       "requested update modifier. See "
+                                       "http://dochub.mongodb.org/core/3.6-feature-compatibility.");
+    }
 
     bool positional = false;
     Status status = mod->init(elem, _modOptions, &positional);
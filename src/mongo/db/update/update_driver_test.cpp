@@ -35,6 +35,7 @@
 #include "mongo/base/simple_string_data_comparator.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonelement_comparator.h"
+#include "mongo/bson/mutable/damage_vector.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/bson/mutable/mutable_bson_test_utils.h"
 #include "mongo/db/field_ref.h"
@@ -178,6 +179,96 @@ TEST(Collator, SetCollationUpdatesModifierInterfaces) {
     ASSERT_TRUE(modified);
 }
 
+//
+// Tests that in-place-compatible updates surface damage events, since the update stage routes
+// those through RecordStore::updateWithDamages instead of rewriting the whole document.
+//
+
+TEST(InPlace, SetOnFixedWidthFieldEmitsDamages) {
+    UpdateDriver::Options opts;
+    UpdateDriver driver(opts);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    ASSERT_OK(driver.parse(fromjson("{$set: {b: 3.0}}"), arrayFilters));
+
+    const bool validateForStorage = true;
+    const FieldRefSet emptyImmutablePaths;
+    bool modified = false;
+    Document doc(fromjson("{_id: 0, a: 1, b: 2.0}"), Document::kInPlaceEnabled);
+    ASSERT_OK(driver.update(
+        StringData(), BSONObj(), &doc, validateForStorage, emptyImmutablePaths, nullptr, &modified));
+    ASSERT_TRUE(modified);
+
+    mutablebson::DamageVector damages;
+    const char* source = nullptr;
+    ASSERT_TRUE(doc.getInPlaceUpdates(&damages, &source));
+    ASSERT_EQUALS(1U, damages.size());
+    ASSERT_EQUALS(static_cast<size_t>(sizeof(double)), static_cast<size_t>(damages[0].size));
+}
+
+TEST(InPlace, IncOnFixedWidthFieldEmitsDamages) {
+    UpdateDriver::Options opts;
+    UpdateDriver driver(opts);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    ASSERT_OK(driver.parse(fromjson("{$inc: {a: 1}}"), arrayFilters));
+
+    const bool validateForStorage = true;
+    const FieldRefSet emptyImmutablePaths;
+    bool modified = false;
+    Document doc(fromjson("{_id: 0, a: 5}"), Document::kInPlaceEnabled);
+    ASSERT_OK(driver.update(
+        StringData(), BSONObj(), &doc, validateForStorage, emptyImmutablePaths, nullptr, &modified));
+    ASSERT_TRUE(modified);
+
+    mutablebson::DamageVector damages;
+    const char* source = nullptr;
+    ASSERT_TRUE(doc.getInPlaceUpdates(&damages, &source));
+    ASSERT_EQUALS(1U, damages.size());
+    ASSERT_EQUALS(static_cast<size_t>(sizeof(int32_t)), static_cast<size_t>(damages[0].size));
+}
+
+TEST(InPlace, SizeChangingUpdateDoesNotEmitDamages) {
+    UpdateDriver::Options opts;
+    UpdateDriver driver(opts);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    ASSERT_OK(driver.parse(fromjson("{$set: {a: 'a longer string value'}}"), arrayFilters));
+
+    const bool validateForStorage = true;
+    const FieldRefSet emptyImmutablePaths;
+    bool modified = false;
+    Document doc(fromjson("{_id: 0, a: 'short'}"), Document::kInPlaceEnabled);
+    ASSERT_OK(driver.update(
+        StringData(), BSONObj(), &doc, validateForStorage, emptyImmutablePaths, nullptr, &modified));
+    ASSERT_TRUE(modified);
+
+    mutablebson::DamageVector damages;
+    const char* source = nullptr;
+    ASSERT_FALSE(doc.getInPlaceUpdates(&damages, &source));
+}
+
+TEST(InPlace, UpdateOfIndexedFieldDisablesInPlace) {
+    UpdateDriver::Options opts;
+    UpdateDriver driver(opts);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    ASSERT_OK(driver.parse(fromjson("{$inc: {a: 1}}"), arrayFilters));
+
+    UpdateIndexData indexedFields;
+    indexedFields.addPath("a");
+    driver.refreshIndexKeys(&indexedFields);
+
+    const bool validateForStorage = true;
+    const FieldRefSet emptyImmutablePaths;
+    bool modified = false;
+    Document doc(fromjson("{_id: 0, a: 5}"), Document::kInPlaceEnabled);
+    ASSERT_OK(driver.update(
+        StringData(), BSONObj(), &doc, validateForStorage, emptyImmutablePaths, nullptr, &modified));
+    ASSERT_TRUE(modified);
+
+    // Index maintenance needs the document rewritten through the normal update path.
+    mutablebson::DamageVector damages;
+    const char* source = nullptr;
+    ASSERT_FALSE(doc.getInPlaceUpdates(&damages, &source));
+}
+
 //
 // Tests of creating a base for an upsert from a query document
 // $or, $and, $all get special handling, as does the _id field
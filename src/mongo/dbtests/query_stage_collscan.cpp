@@ -399,6 +399,63 @@ public:
     }
 };
 
+//
+// A scan that opts in to shared scanning joins an in-flight scan mid-collection, wraps around
+// at EOF, and still returns every document exactly once.
+//
+class QueryStageCollscanSharedScan : public QueryStageCollectionScanBase {
+public:
+    void run() {
+        // Grow the collection well past the shared scan position publication interval.
+        DBDirectClient client(&_opCtx);
+        const int totalObj = 300;
+        for (int i = numObj(); i < totalObj; ++i) {
+            client.insert(nss.ns(), BSON("foo" << i));
+        }
+
+        AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+
+        CollectionScanParams params;
+        params.collection = ctx.getCollection();
+        params.direction = CollectionScanParams::FORWARD;
+        params.tailable = false;
+        params.allowSharedScan = true;
+
+        // Drive the first scan deep enough into the collection to have published a position.
+        WorkingSet wsA;
+        unique_ptr<CollectionScan> scanA(new CollectionScan(&_opCtx, params, &wsA, NULL));
+        int advancedA = 0;
+        while (advancedA < 200) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED == scanA->work(&id)) {
+                ++advancedA;
+            }
+        }
+
+        // A second shared scan should pick up at the first scan's position rather than the
+        // start of the collection, then circle back for the prefix it skipped.
+        WorkingSet wsB;
+        unique_ptr<CollectionScan> scanB(new CollectionScan(&_opCtx, params, &wsB, NULL));
+        std::set<int> seen;
+        bool first = true;
+        while (!scanB->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED != scanB->work(&id)) {
+                continue;
+            }
+            WorkingSetMember* member = wsB.get(id);
+            const int foo = member->obj.value()["foo"].numberInt();
+            if (first) {
+                // Joined mid-collection, so the results arrive in rotated order.
+                ASSERT_NOT_EQUALS(0, foo);
+                first = false;
+            }
+            ASSERT(seen.insert(foo).second);
+        }
+        ASSERT_EQUALS(static_cast<size_t>(totalObj), seen.size());
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("QueryStageCollectionScan") {}
@@ -413,6 +470,7 @@ public:
         add<QueryStageCollscanObjectsInOrderBackward>();
         add<QueryStageCollscanInvalidateUpcomingObject>();
         add<QueryStageCollscanInvalidateUpcomingObjectBackward>();
+        add<QueryStageCollscanSharedScan>();
     }
 };
 
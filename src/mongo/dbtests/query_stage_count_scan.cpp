@@ -552,6 +552,49 @@ public:
     }
 };
 
+//
+// Check that the batched work path counts the same entries as work(), including dups
+//
+class QueryStageCountScanWorkBatch : public CountBase {
+public:
+    void run() {
+        OldClientWriteContext ctx(&_opCtx, ns());
+
+        // Insert some docs, including one whose two in-range keys must be counted only once
+        for (int i = 0; i < 10; ++i) {
+            insert(BSON("a" << i));
+        }
+        insert(BSON("a" << BSON_ARRAY(3 << 4)));
+        addIndex(BSON("a" << 1));
+
+        // Set up the count stage
+        CountScanParams params;
+        params.descriptor = getIndex(ctx.db(), BSON("a" << 1));
+        verify(params.descriptor);
+        params.startKey = BSON("a" << 0);
+        params.startKeyInclusive = true;
+        params.endKey = BSON("a" << 9);
+        params.endKeyInclusive = true;
+
+        WorkingSet ws;
+        CountScan count(&_opCtx, params, &ws);
+
+        // Drive the count with a batch size small enough to need several batches
+        const size_t kBatchSize = 4;
+        std::vector<WorkingSetID> out(kBatchSize + 1);
+        int numCounted = 0;
+        PlanStage::StageState state;
+        do {
+            size_t numResults = 0;
+            state = count.workBatch(out.data(), kBatchSize, &numResults);
+            numCounted += numResults;
+        } while (PlanStage::IS_EOF != state);
+
+        // Ten plain docs plus the multikey doc counted once
+        ASSERT_EQUALS(11, numCounted);
+    }
+};
+
 //
 // Iteration is properly terminated when the end location is an unused key
 //
@@ -656,6 +699,7 @@ public:
         add<QueryStageCountScanInsertNewDocsDuringYield>();
         add<QueryStageCountScanBecomesMultiKeyDuringYield>();
         add<QueryStageCountScanUnusedKeys>();
+        add<QueryStageCountScanWorkBatch>();
     }
 };
 
@@ -154,7 +154,8 @@ public:
 
         // This query should result in a plan cache entry for the first $or branch, because
         // there are two competing indices. The second branch has only one relevant index, so
-        // its winning plan should not be cached.
+        // its winning plan is not multi-planned, but the subplanner records the index
+        // assignment in the branch decision cache.
         BSONObj query = fromjson("{$or: [{a: 1, b: 3}, {c: 1}]}");
 
         Collection* collection = ctx.getCollection();
@@ -182,15 +183,16 @@ public:
         ASSERT_FALSE(subplan->branchPlannedFromCache(0));
         ASSERT_FALSE(subplan->branchPlannedFromCache(1));
 
-        // If we repeat the same query, the plan for the first branch should have come from
-        // the cache.
+        // If we repeat the same query, the plan for both branches should have come from the
+        // cache: the first from the plan cache proper and the second from the branch decision
+        // cache.
         ws.clear();
         subplan.reset(new SubplanStage(&_opCtx, collection, &ws, plannerParams, cq.get()));
 
         ASSERT_OK(subplan->pickBestPlan(&yieldPolicy));
 
         ASSERT_TRUE(subplan->branchPlannedFromCache(0));
-        ASSERT_FALSE(subplan->branchPlannedFromCache(1));
+        ASSERT_TRUE(subplan->branchPlannedFromCache(1));
     }
 };
 
@@ -210,9 +212,9 @@ public:
             insert(BSON("a" << 1 << "b" << i << "c" << i));
         }
 
-        // Running this query should not create any cache entries. For the first branch, it's
-        // because there are no matching results. For the second branch it's because there is only
-        // one relevant index.
+        // Running this query should not create a plan cache entry for the first branch, because
+        // there are no matching results. The second branch has only one relevant index, so its
+        // assignment lands in the branch decision cache.
         BSONObj query = fromjson("{$or: [{a: 1, b: 15}, {c: 1}]}");
 
         Collection* collection = ctx.getCollection();
@@ -240,16 +242,16 @@ public:
         ASSERT_FALSE(subplan->branchPlannedFromCache(0));
         ASSERT_FALSE(subplan->branchPlannedFromCache(1));
 
-        // If we run the query again, it should again be the case that neither branch gets planned
-        // from the cache (because the first call to pickBestPlan() refrained from creating any
-        // cache entries).
+        // If we run the query again, the first branch must again be planned from scratch (the
+        // first call to pickBestPlan() refrained from creating a plan cache entry for it), while
+        // the second is assembled from the branch decision cache.
         ws.clear();
         subplan.reset(new SubplanStage(&_opCtx, collection, &ws, plannerParams, cq.get()));
 
         ASSERT_OK(subplan->pickBestPlan(&yieldPolicy));
 
         ASSERT_FALSE(subplan->branchPlannedFromCache(0));
-        ASSERT_FALSE(subplan->branchPlannedFromCache(1));
+        ASSERT_TRUE(subplan->branchPlannedFromCache(1));
     }
 };
 
@@ -269,9 +271,10 @@ public:
             insert(BSON("a" << 1 << "e" << 1 << "d" << 1));
         }
 
-        // Running this query should not create any cache entries. For the first branch, it's
-        // because plans using the {a: 1, b: 1} and {a: 1, c: 1} indices should tie during plan
-        // ranking. For the second branch it's because there is only one relevant index.
+        // Running this query should not create a plan cache entry for the first branch, because
+        // plans using the {a: 1, b: 1} and {a: 1, c: 1} indices should tie during plan ranking.
+        // The second branch has only one relevant index, so its assignment lands in the branch
+        // decision cache.
         BSONObj query = fromjson("{$or: [{a: 1, e: 1}, {d: 1}]}");
 
         Collection* collection = ctx.getCollection();
@@ -299,16 +302,16 @@ public:
         ASSERT_FALSE(subplan->branchPlannedFromCache(0));
         ASSERT_FALSE(subplan->branchPlannedFromCache(1));
 
-        // If we run the query again, it should again be the case that neither branch gets planned
-        // from the cache (because the first call to pickBestPlan() refrained from creating any
-        // cache entries).
+        // If we run the query again, the first branch must again be planned from scratch (the
+        // first call to pickBestPlan() refrained from creating a plan cache entry for it), while
+        // the second is assembled from the branch decision cache.
         ws.clear();
         subplan.reset(new SubplanStage(&_opCtx, collection, &ws, plannerParams, cq.get()));
 
         ASSERT_OK(subplan->pickBestPlan(&yieldPolicy));
 
         ASSERT_FALSE(subplan->branchPlannedFromCache(0));
-        ASSERT_FALSE(subplan->branchPlannedFromCache(1));
+        ASSERT_TRUE(subplan->branchPlannedFromCache(1));
     }
 };
 
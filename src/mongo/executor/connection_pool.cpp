@@ -126,6 +126,8 @@ private:
 
     void addToReady(stdx::unique_lock<stdx::mutex>& lk, OwnedConnection conn);
 
+    size_t targetConnectionsInLock();
+
     void fulfillRequests(stdx::unique_lock<stdx::mutex>& lk);
 
     void spawnConnections(stdx::unique_lock<stdx::mutex>& lk);
@@ -160,6 +162,13 @@ private:
 
     size_t _created;
 
+    // Peak concurrent demand (checked-out connections plus waiting requests) seen
+    // during the current and previous peakDemandWindow periods. Only maintained when
+    // Options::peakDemandWindow is non-zero.
+    size_t _curWindowPeakDemand;
+    size_t _prevWindowPeakDemand;
+    Date_t _demandWindowStart;
+
     /**
      * The current state of the pool
      *
@@ -281,6 +290,8 @@ ConnectionPool::SpecificPool::SpecificPool(ConnectionPool* parent, const HostAnd
       _inFulfillRequests(false),
       _inSpawnConnections(false),
       _created(0),
+      _curWindowPeakDemand(0),
+      _prevWindowPeakDemand(0),
       _state(State::kRunning) {}
 
 ConnectionPool::SpecificPool::~SpecificPool() {
@@ -355,9 +366,13 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
     if (needsRefreshTP <= now) {
         // If we need to refresh this connection
 
-        if (_readyPool.size() + _processingPool.size() + _checkedOutPool.size() >=
-            _parent->_options.minConnections) {
-            // If we already have minConnections, just let the connection lapse
+        // When peak demand tracking is enabled, keep enough warm connections to cover
+        // the recent peak rather than letting the pool shrink back to minConnections.
+        auto keepTarget = (_parent->_options.peakDemandWindow > Milliseconds(0))
+            ? targetConnectionsInLock()
+            : _parent->_options.minConnections;
+        if (_readyPool.size() + _processingPool.size() + _checkedOutPool.size() >= keepTarget) {
+            // If we already have enough connections, just let the connection lapse
             log() << "Ending idle connection to host " << _hostAndPort
                   << " because the pool meets constraints; " << openConnections(lk)
                   << " connections to that host remain open";
@@ -418,6 +433,31 @@ void ConnectionPool::SpecificPool::returnConnection(ConnectionInterface* connPtr
     updateStateInLock();
 }
 
+// Computes the number of connections the pool should maintain. This is the current
+// demand clamped between minConnections and maxConnections and, if peak demand
+// tracking is enabled, covers the peak demand seen over the last two window periods.
+size_t ConnectionPool::SpecificPool::targetConnectionsInLock() {
+    size_t demand = _requests.size() + _checkedOutPool.size();
+
+    const auto window = _parent->_options.peakDemandWindow;
+    if (window > Milliseconds(0)) {
+        auto now = _parent->_factory->now();
+        if (now >= _demandWindowStart + window) {
+            // Rotate the windows. If more than two whole windows have passed then the
+            // previous window's peak is stale as well.
+            _prevWindowPeakDemand =
+                (now >= _demandWindowStart + window * 2) ? 0 : _curWindowPeakDemand;
+            _curWindowPeakDemand = 0;
+            _demandWindowStart = now;
+        }
+        _curWindowPeakDemand = std::max(_curWindowPeakDemand, demand);
+        demand = std::max(demand, std::max(_curWindowPeakDemand, _prevWindowPeakDemand));
+    }
+
+    return std::max(_parent->_options.minConnections,
+                    std::min(demand, _parent->_options.maxConnections));
+}
+
 // Adds a live connection to the ready pool
 void ConnectionPool::SpecificPool::addToReady(stdx::unique_lock<stdx::mutex>& lk,
                                               OwnedConnection conn) {
@@ -564,12 +604,9 @@ void ConnectionPool::SpecificPool::spawnConnections(stdx::unique_lock<stdx::mute
     _inSpawnConnections = true;
     auto guard = MakeGuard([&] { _inSpawnConnections = false; });
 
-    // We want minConnections <= outstanding requests <= maxConnections
-    auto target = [&] {
-        return std::max(
-            _parent->_options.minConnections,
-            std::min(_requests.size() + _checkedOutPool.size(), _parent->_options.maxConnections));
-    };
+    // We want minConnections <= outstanding requests <= maxConnections, covering the
+    // recent peak demand when peak tracking is enabled.
+    auto target = [&] { return targetConnectionsInLock(); };
 
     // While all of our inflight connections are less than our target
     while ((_readyPool.size() + _processingPool.size() + _checkedOutPool.size() < target()) &&
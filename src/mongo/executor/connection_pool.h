@@ -117,6 +117,16 @@ public:
          * out connections or new requests
          */
         Milliseconds hostTimeout = kDefaultHostTimeout;
+
+        /**
+         * Amount of time over which to remember the peak number of simultaneously
+         * checked-out connections and waiting requests per host. While non-zero, the
+         * pool maintains enough warm connections to cover that recent peak instead of
+         * shrinking back to minConnections between bursts, so traffic spikes after a
+         * lull don't pay connection setup latency in-line. Zero (the default)
+         * disables peak tracking.
+         */
+        Milliseconds peakDemandWindow{0};
     };
 
     explicit ConnectionPool(std::unique_ptr<DependentTypeFactoryInterface> impl,
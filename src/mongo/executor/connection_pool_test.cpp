@@ -28,6 +28,7 @@
 #include "mongo/platform/basic.h"
 
 #include <algorithm>
+#include <array>
 #include <random>
 #include <stack>
 
@@ -916,6 +917,108 @@ TEST_F(ConnectionPoolTest, minPoolRespected) {
 }
 
 
+/**
+ * Verify that when peak demand tracking is enabled, the pool re-spawns enough
+ * connections to cover the recent peak demand rather than just the current demand,
+ * and that peaks older than two windows are forgotten.
+ */
+TEST_F(ConnectionPoolTest, peakDemandRespected) {
+    ConnectionPool::Options options;
+    options.minConnections = 1;
+    options.maxConnections = 5;
+    options.refreshRequirement = Milliseconds(5000);
+    options.refreshTimeout = Milliseconds(5000);
+    options.peakDemandWindow = Milliseconds(10000);
+    ConnectionPool pool(stdx::make_unique<PoolImpl>(), "test pool", options);
+
+    auto now = Date_t::now();
+
+    PoolImpl::setNow(now);
+
+    std::array<ConnectionPool::ConnectionHandle, 3> conns;
+
+    // Check out three connections simultaneously to establish a demand peak of 3
+    for (auto& conn : conns) {
+        ConnectionImpl::pushSetup(Status::OK());
+        pool.get(HostAndPort(),
+                 Milliseconds(1000),
+                 [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                     ASSERT(swConn.isOK());
+                     conn = std::move(swConn.getValue());
+                 });
+        ASSERT(conn);
+    }
+
+    // Return them all, then drop them so the pool is empty
+    for (auto& conn : conns) {
+        doneWith(conn);
+        conn.reset();
+    }
+    pool.dropConnections(HostAndPort());
+
+    bool reachedA = false;
+    bool reachedB = false;
+    bool reachedC = false;
+
+    ConnectionImpl::pushSetup([&]() {
+        reachedA = true;
+        return Status::OK();
+    });
+    ConnectionImpl::pushSetup([&]() {
+        reachedB = true;
+        return Status::OK();
+    });
+    ConnectionImpl::pushSetup([&]() {
+        reachedC = true;
+        return Status::OK();
+    });
+
+    // A single request inside the window should spawn back up to the peak of 3
+    PoolImpl::setNow(now + Milliseconds(2000));
+    pool.get(HostAndPort(),
+             Milliseconds(1000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 conns[0] = std::move(swConn.getValue());
+             });
+
+    ASSERT(reachedA);
+    ASSERT(reachedB);
+    ASSERT(reachedC);
+
+    doneWith(conns[0]);
+    conns[0].reset();
+    pool.dropConnections(HostAndPort());
+
+    reachedA = false;
+    reachedB = false;
+
+    ConnectionImpl::pushSetup([&]() {
+        reachedA = true;
+        return Status::OK();
+    });
+    ConnectionImpl::pushSetup([&]() {
+        reachedB = true;
+        return Status::OK();
+    });
+
+    // More than two windows later the peak has aged out, so a single request
+    // should only spawn a single connection
+    PoolImpl::setNow(now + Milliseconds(25000));
+    pool.get(HostAndPort(),
+             Milliseconds(1000),
+             [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                 ASSERT(swConn.isOK());
+                 conns[0] = std::move(swConn.getValue());
+             });
+
+    ASSERT(reachedA);
+    ASSERT(!reachedB);
+
+    doneWith(conns[0]);
+    conns[0].reset();
+}
+
 /**
  * Verify that the hostTimeout is respected. This implies that an idle
  * hostAndPort drops it's connections.
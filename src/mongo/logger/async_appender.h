@@ -0,0 +1,192 @@
+/*    Copyright 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <sstream>
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/logger/appender.h"
+#include "mongo/logger/encoder.h"
+#include "mongo/logger/message_event.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+namespace logger {
+
+/**
+ * Encoder for pre-encoded log lines: writes the string through unchanged. Allows the
+ * stream-writing appenders, which are templated on the event type, to act as the downstream
+ * sink of an AsyncAppender (e.g. RotatableFileAppender<std::string>).
+ */
+class StringEventEncoder : public Encoder<std::string> {
+public:
+    virtual std::ostream& encode(const std::string& event, std::ostream& os) {
+        return os << event;
+    }
+};
+
+/**
+ * Appender that decouples log formatting and writing from the logging thread.
+ *
+ * append() copies the event's fields -- a MessageEventEphemeral does not own the storage
+ * behind its strings, so they are captured by value -- and returns without formatting
+ * anything. A dedicated writer thread encodes queued events and hands the encoded lines to
+ * the downstream appender, so both ostream formatting and a slow disk or console stall the
+ * writer thread rather than the operation that logged. The queue is bounded; when the writer
+ * cannot keep up, append() drops the event and the writer later emits one line recording how
+ * many were dropped, rather than blocking. Destroying the appender drains the queue.
+ */
+class AsyncAppender : public Appender<MessageEventEphemeral> {
+    MONGO_DISALLOW_COPYING(AsyncAppender);
+
+public:
+    typedef Encoder<MessageEventEphemeral> EventEncoder;
+
+    /**
+     * Constructs an appender whose writer thread encodes events with "encoder" and hands the
+     * encoded lines to "downstream". Takes ownership of both. At most "maxQueuedEvents"
+     * events are held while the writer is behind.
+     */
+    AsyncAppender(EventEncoder* encoder,
+                  Appender<std::string>* downstream,
+                  size_t maxQueuedEvents = 10000)
+        : _encoder(encoder),
+          _downstream(downstream),
+          _maxQueuedEvents(maxQueuedEvents),
+          _writer([this] { _writeLoop(); }) {}
+
+    virtual ~AsyncAppender() {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _shutdown = true;
+        }
+        _condvar.notify_one();
+        _writer.join();
+    }
+
+    virtual Status append(const MessageEventEphemeral& event) {
+        CapturedEvent captured(event);
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            if (_queue.size() >= _maxQueuedEvents) {
+                ++_numDropped;
+                return Status::OK();
+            }
+            _queue.push_back(std::move(captured));
+        }
+        _condvar.notify_one();
+        return Status::OK();
+    }
+
+private:
+    /**
+     * Owned copy of a MessageEventEphemeral's fields, safe to hold after append() returns.
+     */
+    struct CapturedEvent {
+        explicit CapturedEvent(const MessageEventEphemeral& event)
+            : date(event.getDate()),
+              severity(event.getSeverity()),
+              component(event.getComponent()),
+              contextName(event.getContextName().toString()),
+              message(event.getMessage().toString()),
+              isTruncatable(event.isTruncatable()) {}
+
+        Date_t date;
+        LogSeverity severity;
+        LogComponent component;
+        std::string contextName;
+        std::string message;
+        bool isTruncatable;
+    };
+
+    void _encodeAndWrite(const CapturedEvent& captured) {
+        MessageEventEphemeral event(
+            captured.date, captured.severity, captured.component, captured.contextName,
+            captured.message);
+        event.setIsTruncatable(captured.isTruncatable);
+        std::ostringstream os;
+        _encoder->encode(event, os);
+        // A failing downstream must not wedge the writer thread; subsequent lines may still
+        // succeed (e.g. after log rotation).
+        _downstream->append(os.str()).transitional_ignore();
+    }
+
+    void _writeLoop() {
+        std::deque<CapturedEvent> batch;
+        for (;;) {
+            bool shutdown;
+            size_t numDropped;
+            {
+                stdx::unique_lock<stdx::mutex> lk(_mutex);
+                _condvar.wait(lk, [&] { return _shutdown || !_queue.empty(); });
+                batch.swap(_queue);
+                numDropped = _numDropped;
+                _numDropped = 0;
+                shutdown = _shutdown;
+            }
+
+            for (const CapturedEvent& captured : batch) {
+                _encodeAndWrite(captured);
+            }
+            batch.clear();
+
+            if (numDropped > 0) {
+                std::ostringstream os;
+                os << "AsyncAppender dropped " << numDropped
+                   << " log lines because the writer could not keep up\n";
+                _downstream->append(os.str()).transitional_ignore();
+            }
+
+            if (shutdown) {
+                // The queue was swapped out after _shutdown was set, and no further append()
+                // calls are permitted once destruction has begun, so everything is written.
+                return;
+            }
+        }
+    }
+
+    std::unique_ptr<EventEncoder> _encoder;
+    std::unique_ptr<Appender<std::string>> _downstream;
+    const size_t _maxQueuedEvents;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _condvar;
+    std::deque<CapturedEvent> _queue;
+    size_t _numDropped = 0;
+    bool _shutdown = false;
+
+    stdx::thread _writer;
+};
+
+}  // namespace logger
+}  // namespace mongo
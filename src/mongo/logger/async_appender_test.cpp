@@ -0,0 +1,114 @@
+/*    Copyright 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mongo/logger/async_appender.h"
+#include "mongo/logger/message_event_utf8_encoder.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace logger {
+namespace {
+
+/**
+ * Downstream appender that records every line it is handed.
+ */
+class CapturingAppender : public Appender<std::string> {
+public:
+    virtual Status append(const std::string& event) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _lines.push_back(event);
+        return Status::OK();
+    }
+
+    std::vector<std::string> lines() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        return _lines;
+    }
+
+private:
+    stdx::mutex _mutex;
+    std::vector<std::string> _lines;
+};
+
+MessageEventEphemeral makeEvent(StringData message) {
+    return MessageEventEphemeral(Date_t::now(), LogSeverity::Log(), "test"_sd, message);
+}
+
+TEST(AsyncAppenderTest, DeliversAllLinesInOrderAfterDrain) {
+    CapturingAppender* downstream = new CapturingAppender;
+    std::vector<std::string> expected;
+    {
+        AsyncAppender appender(new MessageEventUnadornedEncoder, downstream);
+        for (int i = 0; i < 1000; i++) {
+            std::ostringstream os;
+            os << "line " << i;
+            expected.push_back(os.str() + "\n");
+            // The message's storage dies with this loop iteration; the appender must have
+            // captured it by value.
+            std::string transient = os.str();
+            ASSERT_OK(appender.append(makeEvent(transient)));
+        }
+        // Destruction drains the queue before the downstream appender goes away.
+    }
+    ASSERT_TRUE(downstream->lines() == expected);
+}
+
+TEST(AsyncAppenderTest, DropsAreBoundedAndAccountedFor) {
+    CapturingAppender* downstream = new CapturingAppender;
+    const int kNumLines = 1000;
+    {
+        AsyncAppender appender(new MessageEventUnadornedEncoder, downstream, 1);
+        for (int i = 0; i < kNumLines; i++) {
+            ASSERT_OK(appender.append(makeEvent("x"_sd)));
+        }
+    }
+    // Every line was either delivered or reported as dropped by a marker line; none grew the
+    // queue beyond its bound of one.
+    long long delivered = 0;
+    long long reportedDropped = 0;
+    for (const std::string& line : downstream->lines()) {
+        if (line == "x\n") {
+            delivered++;
+        } else {
+            long long n = 0;
+            ASSERT_EQUALS(1, sscanf(line.c_str(), "AsyncAppender dropped %lld", &n));
+            reportedDropped += n;
+        }
+    }
+    ASSERT_EQUALS(kNumLines, delivered + reportedDropped);
+}
+
+}  // namespace
+}  // namespace logger
+}  // namespace mongo
@@ -79,7 +79,7 @@ LogstreamBuilder::LogstreamBuilder(MessageLogDomain* domain,
                                    LogComponent component,
                                    bool shouldCache)
     : _domain(domain),
-      _contextName(contextName.toString()),
+      _contextName(contextName),
       _severity(std::move(severity)),
       _component(std::move(component)),
       _tee(nullptr),
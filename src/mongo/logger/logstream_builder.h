@@ -62,7 +62,10 @@ public:
     /**
      * Construct a LogstreamBuilder that writes to "domain" on destruction.
      *
-     * "contextName" is a short name of the thread or other context.
+     * "contextName" is a short name of the thread or other context, and must name storage
+     * that outlives the builder; every caller passes the thread name, which lives for the
+     * life of the thread. It is held unmaterialized so that constructing a builder does not
+     * allocate.
      * "severity" is the logging severity of the message.
      */
     LogstreamBuilder(MessageLogDomain* domain, StringData contextName, LogSeverity severity);
@@ -224,7 +227,7 @@ private:
     void makeStream();
 
     MessageLogDomain* _domain;
-    std::string _contextName;
+    StringData _contextName;
     LogSeverity _severity;
     LogComponent _component;
     std::string _baseMessage;
@@ -75,22 +75,33 @@ void readRequestMetadata(OperationContext* opCtx, const BSONObj& metadataObj) {
         }
     }
 
+    // This runs for every command, so sections that are absent from the request are left
+    // as their default-constructed decorations rather than being re-read and re-assigned
+    // defaults.
     if (readPreferenceElem) {
         ReadPreferenceSetting::get(opCtx) =
             uassertStatusOK(ReadPreferenceSetting::fromInnerBSON(readPreferenceElem));
     }
 
-    AuditMetadata::get(opCtx) = uassertStatusOK(AuditMetadata::readFromMetadata(auditElem));
+    if (auditElem) {
+        AuditMetadata::get(opCtx) = uassertStatusOK(AuditMetadata::readFromMetadata(auditElem));
+    }
 
-    uassertStatusOK(ClientMetadataIsMasterState::readFromMetadata(opCtx, clientElem));
+    if (clientElem) {
+        uassertStatusOK(ClientMetadataIsMasterState::readFromMetadata(opCtx, clientElem));
+    }
 
-    ConfigServerMetadata::get(opCtx) =
-        uassertStatusOK(ConfigServerMetadata::readFromMetadata(configSvrElem));
+    if (configSvrElem) {
+        ConfigServerMetadata::get(opCtx) =
+            uassertStatusOK(ConfigServerMetadata::readFromMetadata(configSvrElem));
+    }
 
-    TrackingMetadata::get(opCtx) =
-        uassertStatusOK(TrackingMetadata::readFromMetadata(trackingElem));
+    if (trackingElem) {
+        TrackingMetadata::get(opCtx) =
+            uassertStatusOK(TrackingMetadata::readFromMetadata(trackingElem));
+    }
 
-    auto logicalClock = LogicalClock::get(opCtx);
+    auto logicalClock = logicalTimeElem ? LogicalClock::get(opCtx) : nullptr;
     if (logicalClock) {
         auto logicalTimeMetadata =
             uassertStatusOK(rpc::LogicalTimeMetadata::readFromMetadata(logicalTimeElem));
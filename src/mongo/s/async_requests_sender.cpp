@@ -147,18 +147,22 @@ boost::optional<AsyncRequestsSender::Response> AsyncRequestsSender::_ready() {
             remote.done = true;
             if (remote.swResponse->isOK()) {
                 invariant(remote.shardHostAndPort);
-                return Response(std::move(remote.shardId),
-                                std::move(remote.swResponse->getValue()),
-                                std::move(*remote.shardHostAndPort));
+                Response response(std::move(remote.shardId),
+                                  std::move(remote.swResponse->getValue()),
+                                  std::move(*remote.shardHostAndPort));
+                response.elapsed = remote.elapsed;
+                return response;
             } else {
                 // If _interruptStatus is set, promote CallbackCanceled errors to it.
                 if (!_interruptStatus.isOK() &&
                     ErrorCodes::CallbackCanceled == remote.swResponse->getStatus().code()) {
                     remote.swResponse = _interruptStatus;
                 }
-                return Response(std::move(remote.shardId),
-                                std::move(remote.swResponse->getStatus()),
-                                std::move(remote.shardHostAndPort));
+                Response response(std::move(remote.shardId),
+                                  std::move(remote.swResponse->getStatus()),
+                                  std::move(remote.shardHostAndPort));
+                response.elapsed = remote.elapsed;
+                return response;
             }
         }
     }
@@ -168,6 +172,13 @@ boost::optional<AsyncRequestsSender::Response> AsyncRequestsSender::_ready() {
 
 void AsyncRequestsSender::_scheduleRequests_inlock() {
     invariant(!_stopRetrying);
+
+    // Hosts resolved so far in this scheduling pass, by shard. Sub-requests to the same shard are
+    // coalesced onto the host selected for the first of them, so fan-outs with several
+    // sub-requests per shard only pay for targeting once per shard. The cache is per-pass, so a
+    // retry in a later pass re-targets and can fail over to another host.
+    std::map<ShardId, HostAndPort> resolvedTargets;
+
     // Schedule remote work on hosts for which we have not sent a request or need to retry.
     for (size_t i = 0; i < _remotes.size(); ++i) {
         auto& remote = _remotes[i];
@@ -207,7 +218,7 @@ void AsyncRequestsSender::_scheduleRequests_inlock() {
 
         // If the remote does not have a response or pending request, schedule remote work for it.
         if (!remote.swResponse && !remote.cbHandle.isValid()) {
-            auto scheduleStatus = _scheduleRequest_inlock(i);
+            auto scheduleStatus = _scheduleRequest_inlock(i, &resolvedTargets);
             if (!scheduleStatus.isOK()) {
                 remote.swResponse = std::move(scheduleStatus);
                 // Signal the notification indicating the remote had an error (we need to do this
@@ -221,15 +232,22 @@ void AsyncRequestsSender::_scheduleRequests_inlock() {
     }
 }
 
-Status AsyncRequestsSender::_scheduleRequest_inlock(size_t remoteIndex) {
+Status AsyncRequestsSender::_scheduleRequest_inlock(
+    size_t remoteIndex, std::map<ShardId, HostAndPort>* resolvedTargets) {
     auto& remote = _remotes[remoteIndex];
 
     invariant(!remote.cbHandle.isValid());
     invariant(!remote.swResponse);
 
-    Status resolveStatus = remote.resolveShardIdToHostAndPort(_readPreference);
-    if (!resolveStatus.isOK()) {
-        return resolveStatus;
+    auto resolvedIt = resolvedTargets->find(remote.shardId);
+    if (resolvedIt != resolvedTargets->end()) {
+        remote.shardHostAndPort = resolvedIt->second;
+    } else {
+        Status resolveStatus = remote.resolveShardIdToHostAndPort(_readPreference);
+        if (!resolveStatus.isOK()) {
+            return resolveStatus;
+        }
+        resolvedTargets->emplace(remote.shardId, *remote.shardHostAndPort);
     }
 
     executor::RemoteCommandRequest request(
@@ -244,6 +262,7 @@ Status AsyncRequestsSender::_scheduleRequest_inlock(size_t remoteIndex) {
     }
 
     remote.cbHandle = callbackStatus.getValue();
+    remote.requestStartTime = _executor->now();
     return Status::OK();
 }
 
@@ -258,6 +277,8 @@ void AsyncRequestsSender::_handleResponse(
     // 'remote'.
     remote.cbHandle = executor::TaskExecutor::CallbackHandle();
 
+    remote.elapsed = _executor->now() - remote.requestStartTime;
+
     // Store the response or error.
     if (cbData.response.status.isOK()) {
         remote.swResponse = std::move(cbData.response);
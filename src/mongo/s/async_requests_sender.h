@@ -29,6 +29,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <map>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
@@ -115,6 +116,11 @@ public:
         // The exact host on which the remote command was run. Is unset if the shard could not be
         // found or no shard hosts matching the readPreference could be found.
         boost::optional<HostAndPort> shardHostAndPort;
+
+        // Time elapsed between scheduling the request on the executor and receiving its response.
+        // Includes executor queueing time, unlike the network round-trip time reported in
+        // 'swResponse'. Is unset if the request could not be scheduled.
+        boost::optional<Milliseconds> elapsed;
     };
 
     /**
@@ -195,6 +201,13 @@ private:
         // The number of times we've retried sending the command to this remote.
         int retryCount = 0;
 
+        // The executor time at which the outstanding request was scheduled. Used to compute the
+        // per-shard latency exposed in the Response.
+        Date_t requestStartTime;
+
+        // Time elapsed between scheduling the most recent request and receiving its response.
+        boost::optional<Milliseconds> elapsed;
+
         // The callback handle to an outstanding request for this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -223,6 +236,7 @@ private:
      * response if so.
      *
      * For each remote without a response or pending request, schedules the remote request.
+     * Requests targeted at the same shard share a single host resolution per scheduling pass.
      *
      * On failure to schedule a request, signals the notification.
      */
@@ -232,11 +246,14 @@ private:
      * Helper to schedule a command to a remote.
      *
      * The 'remoteIndex' gives the position of the remote node from which we are retrieving the
-     * batch in '_remotes'.
+     * batch in '_remotes'.  'resolvedTargets' caches the host selected for each shard during the
+     * current scheduling pass, so that concurrent sub-requests to the same shard are coalesced
+     * onto one host without repeating targeter work.
      *
      * Returns success if the command was scheduled successfully.
      */
-    Status _scheduleRequest_inlock(size_t remoteIndex);
+    Status _scheduleRequest_inlock(size_t remoteIndex,
+                                   std::map<ShardId, HostAndPort>* resolvedTargets);
 
     /**
      * The callback for a remote command.
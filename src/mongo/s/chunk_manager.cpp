@@ -32,11 +32,13 @@
 
 #include "mongo/s/chunk_manager.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/query_planner.h"
@@ -49,6 +51,16 @@ namespace {
 // Used to generate sequence numbers to assign to each newly created ChunkManager
 AtomicUInt32 nextCMSequenceNumber(0);
 
+/**
+ * Encodes a shard key (or chunk boundary) as a binary-comparable KeyString. Chunk boundaries all
+ * carry the shard key pattern's field names, so ignoring field names in the encoding preserves
+ * the ordering of the BSONObj-indexed chunk map.
+ */
+std::string encodeShardKeyForTargeting(const BSONObj& shardKey) {
+    const KeyString encoded(KeyString::Version::V1, shardKey, Ordering::make(BSONObj()));
+    return std::string(encoded.getBuffer(), encoded.getSize());
+}
+
 void checkAllElementsAreOfType(BSONType type, const BSONObj& o) {
     for (const auto&& element : o) {
         uassert(ErrorCodes::ConflictingOperationInProgress,
@@ -72,6 +84,24 @@ ChunkManager::ChunkManager(NamespaceString nss,
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
       _chunkMapViews(_constructChunkMapViews(collectionVersion.epoch(), _chunkMap)),
+      _chunkVector(_constructChunkVector(_chunkMap)),
+      _collectionVersion(collectionVersion) {}
+
+ChunkManager::ChunkManager(NamespaceString nss,
+                           KeyPattern shardKeyPattern,
+                           std::unique_ptr<CollatorInterface> defaultCollator,
+                           bool unique,
+                           ChunkMap chunkMap,
+                           ChunkMapViews chunkMapViews,
+                           ChunkVersion collectionVersion)
+    : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
+      _nss(std::move(nss)),
+      _shardKeyPattern(shardKeyPattern),
+      _defaultCollator(std::move(defaultCollator)),
+      _unique(unique),
+      _chunkMap(std::move(chunkMap)),
+      _chunkMapViews(std::move(chunkMapViews)),
+      _chunkVector(_constructChunkVector(_chunkMap)),
       _collectionVersion(collectionVersion) {}
 
 std::shared_ptr<Chunk> ChunkManager::findIntersectingChunk(const BSONObj& shardKey,
@@ -87,10 +117,19 @@ std::shared_ptr<Chunk> ChunkManager::findIntersectingChunk(const BSONObj& shardK
         }
     }
 
-    const auto it = _chunkMap.upper_bound(shardKey);
+    // Find the first chunk whose max boundary is greater than the shard key using the
+    // pre-encoded boundaries, so each probe of the binary search is a memcmp rather than a
+    // BSONObj comparison.
+    const auto encodedShardKey = encodeShardKeyForTargeting(shardKey);
+    const auto it = std::upper_bound(_chunkVector.begin(),
+                                     _chunkVector.end(),
+                                     encodedShardKey,
+                                     [](const std::string& lhs, const ChunkVector::value_type& rhs) {
+                                         return lhs < rhs.first;
+                                     });
     uassert(ErrorCodes::ShardKeyNotFound,
             str::stream() << "Cannot target single shard using key " << shardKey,
-            it != _chunkMap.end() && it->second->containsKey(shardKey));
+            it != _chunkVector.end() && it->second->containsKey(shardKey));
 
     return it->second;
 }
@@ -161,21 +200,21 @@ void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
     // For now, we satisfy that assumption by adding a shard with no matches rather than returning
     // an empty set of shards.
     if (shardIds->empty()) {
-        shardIds->insert(_chunkMapViews.chunkRangeMap.begin()->second.shardId);
+        shardIds->insert(_chunkMapViews.chunkRangeMap->begin()->second.shardId);
     }
 }
 
 void ChunkManager::getShardIdsForRange(const BSONObj& min,
                                        const BSONObj& max,
                                        std::set<ShardId>* shardIds) const {
-    auto it = _chunkMapViews.chunkRangeMap.upper_bound(min);
-    auto end = _chunkMapViews.chunkRangeMap.upper_bound(max);
+    auto it = _chunkMapViews.chunkRangeMap->upper_bound(min);
+    auto end = _chunkMapViews.chunkRangeMap->upper_bound(max);
 
     // The chunk range map must always cover the entire key space
-    invariant(it != _chunkMapViews.chunkRangeMap.end());
+    invariant(it != _chunkMapViews.chunkRangeMap->end());
 
     // We need to include the last chunk
-    if (end != _chunkMapViews.chunkRangeMap.cend()) {
+    if (end != _chunkMapViews.chunkRangeMap->cend()) {
         ++end;
     }
 
@@ -416,7 +455,19 @@ ChunkManager::ChunkMapViews ChunkManager::_constructChunkMapViews(const OID& epo
         checkAllElementsAreOfType(MaxKey, chunkRangeMap.rbegin()->first);
     }
 
-    return {std::move(chunkRangeMap), std::move(shardVersions)};
+    return {std::make_shared<const ChunkRangeMap>(std::move(chunkRangeMap)),
+            std::move(shardVersions)};
+}
+
+ChunkManager::ChunkVector ChunkManager::_constructChunkVector(const ChunkMap& chunkMap) {
+    ChunkVector chunkVector;
+    chunkVector.reserve(chunkMap.size());
+
+    for (const auto& entry : chunkMap) {
+        chunkVector.emplace_back(encodeShardKeyForTargeting(entry.first), entry.second);
+    }
+
+    return chunkVector;
 }
 
 std::shared_ptr<ChunkManager> ChunkManager::makeNew(
@@ -442,6 +493,14 @@ std::shared_ptr<ChunkManager> ChunkManager::makeUpdated(
     const auto startingCollectionVersion = getVersion();
     auto chunkMap = _chunkMap;
 
+    // The chunk range map only depends on which shard owns each part of the key space, so it can
+    // be shared with the updated routing table as long as every changed chunk resides on the same
+    // shard as the chunks it replaces -- the common case of chunks splitting in place. A chunk
+    // migrating between shards or covering previously unknown key space forces a full rebuild of
+    // the views below.
+    bool shardAssignmentsChanged = false;
+    ShardVersionMap shardVersions = _chunkMapViews.shardVersions;
+
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
         const auto& chunkVersion = chunk.getVersion();
@@ -464,11 +523,34 @@ std::shared_ptr<ChunkManager> ChunkManager::makeUpdated(
         // not overlap max
         const auto high = chunkMap.upper_bound(chunk.getMax());
 
+        if (!shardAssignmentsChanged) {
+            if (low == high) {
+                shardAssignmentsChanged = true;
+            } else {
+                for (auto it = low; it != high; ++it) {
+                    if (it->second->getShardId() != chunk.getShard()) {
+                        shardAssignmentsChanged = true;
+                        break;
+                    }
+                }
+            }
+        }
+
         // Erase all chunks from the map, which overlap the chunk we got from the persistent store
         chunkMap.erase(low, high);
 
         // Insert only the chunk itself
         chunkMap.insert(std::make_pair(chunk.getMax(), std::make_shared<Chunk>(chunk)));
+
+        if (!shardAssignmentsChanged) {
+            // Changed chunks arrive in increasing version order, so this can only raise the
+            // shard's maximum version.
+            auto shardVersionIt = shardVersions.find(chunk.getShard());
+            invariant(shardVersionIt != shardVersions.end());
+            if (chunkVersion > shardVersionIt->second) {
+                shardVersionIt->second = chunkVersion;
+            }
+        }
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -482,6 +564,19 @@ std::shared_ptr<ChunkManager> ChunkManager::makeUpdated(
         return shared_from_this();
     }
 
+    if (!shardAssignmentsChanged) {
+        // Chunks only split in place, so the chunk range map is unchanged and can be shared with
+        // the new routing table instead of being reconstructed from the entire chunk map.
+        return std::shared_ptr<ChunkManager>(
+            new ChunkManager(_nss,
+                             KeyPattern(getShardKeyPattern().getKeyPattern()),
+                             CollatorInterface::cloneCollator(getDefaultCollator()),
+                             isUnique(),
+                             std::move(chunkMap),
+                             ChunkMapViews{_chunkMapViews.chunkRangeMap, std::move(shardVersions)},
+                             collectionVersion));
+    }
+
     return std::shared_ptr<ChunkManager>(
         new ChunkManager(_nss,
                          KeyPattern(getShardKeyPattern().getKeyPattern()),
@@ -255,14 +255,21 @@ private:
 
     using ChunkRangeMap = BSONObjIndexedMap<ShardAndChunkRange>;
 
+    // Flat vector of (KeyString-encoded chunk max boundary, chunk) pairs, sorted by the encoded
+    // boundary. Lets findIntersectingChunk locate the owning chunk with a binary search over
+    // binary-comparable keys instead of per-probe BSONObj comparisons.
+    using ChunkVector = std::vector<std::pair<std::string, std::shared_ptr<Chunk>>>;
+
     /**
      * Contains different transformations of the chunk map for efficient querying
      */
     struct ChunkMapViews {
         // Transformation of the chunk map containing what range of keys reside on which shard. The
         // index is the max key of the respective range and the union of all ranges in a such
-        // constructed map must cover the complete space from [MinKey, MaxKey).
-        const ChunkRangeMap chunkRangeMap;
+        // constructed map must cover the complete space from [MinKey, MaxKey). Shared between
+        // routing table versions whenever the shard assignment of the key space is unchanged
+        // (e.g. chunks only split in place), since the merged ranges are identical in that case.
+        const std::shared_ptr<const ChunkRangeMap> chunkRangeMap;
 
         // Map from shard id to the maximum chunk version for that shard. If a shard contains no
         // chunks, it won't be present in this map.
@@ -274,11 +281,29 @@ private:
      */
     static ChunkMapViews _constructChunkMapViews(const OID& epoch, const ChunkMap& chunkMap);
 
+    /**
+     * Does a single pass over the chunkMap and constructs the sorted vector of KeyString-encoded
+     * chunk boundaries used for shard key targeting.
+     */
+    static ChunkVector _constructChunkVector(const ChunkMap& chunkMap);
+
+    ChunkManager(NamespaceString nss,
+                 KeyPattern shardKeyPattern,
+                 std::unique_ptr<CollatorInterface> defaultCollator,
+                 bool unique,
+                 ChunkMap chunkMap,
+                 ChunkVersion collectionVersion);
+
+    /**
+     * Constructs an instance from pre-built chunk map views, so that an updated routing table can
+     * share the views of its predecessor instead of reconstructing them.
+     */
     ChunkManager(NamespaceString nss,
                  KeyPattern shardKeyPattern,
                  std::unique_ptr<CollatorInterface> defaultCollator,
                  bool unique,
                  ChunkMap chunkMap,
+                 ChunkMapViews chunkMapViews,
                  ChunkVersion collectionVersion);
 
     // The shard versioning mechanism hinges on keeping track of the number of times we reload
@@ -304,6 +329,9 @@ private:
     // Different transformations of the chunk map for efficient querying
     const ChunkMapViews _chunkMapViews;
 
+    // Sorted vector of KeyString-encoded chunk max boundaries, used for shard key targeting
+    const ChunkVector _chunkVector;
+
     // Max version across all chunks
     const ChunkVersion _collectionVersion;
 
@@ -265,6 +265,7 @@ Status ChunkManagerTargeter::init(OperationContext* opCtx) {
     }
 
     _routingInfo = std::move(routingInfoStatus.getValue());
+    _lastTargetedChunk.reset();
 
     return Status::OK();
 }
@@ -555,7 +556,19 @@ Status ChunkManagerTargeter::targetQuery(
 std::unique_ptr<ShardEndpoint> ChunkManagerTargeter::targetShardKey(const BSONObj& shardKey,
                                                                     const BSONObj& collation,
                                                                     long long estDataSize) const {
-    auto chunk = _routingInfo->cm()->findIntersectingChunk(shardKey, collation);
+    // Try the most recently targeted chunk before searching the chunk map, so that a run of
+    // writes landing on the same chunk resolves with two boundary comparisons per document.  The
+    // cached chunk is only consulted for the simple collation, where targeting is purely
+    // positional.
+    std::shared_ptr<Chunk> chunk;
+    if (_lastTargetedChunk &&
+        SimpleBSONObjComparator::kInstance.evaluate(collation == CollationSpec::kSimpleSpec) &&
+        _lastTargetedChunk->containsKey(shardKey)) {
+        chunk = _lastTargetedChunk;
+    } else {
+        chunk = _routingInfo->cm()->findIntersectingChunk(shardKey, collation);
+        _lastTargetedChunk = chunk;
+    }
 
     // Track autosplit stats for sharded collections
     // Note: this is only best effort accounting and is not accurate.
@@ -41,6 +41,7 @@
 
 namespace mongo {
 
+class Chunk;
 class ChunkManager;
 class OperationContext;
 class Shard;
@@ -165,6 +166,13 @@ private:
     // The latest loaded routing cache entry
     boost::optional<CachedCollectionRoutingInfo> _routingInfo;
 
+    // The chunk most recently targeted through an exact shard key. Consecutive writes in a batch
+    // tend to fall on the same chunk (bulk ingestion typically presents sorted or clustered shard
+    // keys), in which case a pair of boundary comparisons replaces the chunk map search. Only
+    // valid for the routing info it was populated from; cleared whenever '_routingInfo' is
+    // reloaded.
+    mutable std::shared_ptr<Chunk> _lastTargetedChunk;
+
     // Map of shard->remote shard version reported from stale errors
     ShardVersionMap _remoteShardVersions;
 };
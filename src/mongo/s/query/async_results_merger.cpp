@@ -36,6 +36,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/s/client/shard_registry.h"
@@ -50,13 +51,25 @@ namespace {
 // Maximum number of retries for network and replication notMaster errors (per host).
 const int kMaxNumFailedHostRetryAttempts = 3;
 
+/**
+ * Encodes a document's $sortKey value as a binary-comparable KeyString. The encoding incorporates
+ * the sort directions, so a byte comparison of two encoded keys is equivalent to a woCompare of
+ * the sort keys under the sort pattern. No collator is needed, since mongod has already mapped
+ * strings to their ICU comparison keys as part of the $sortKey meta projection.
+ */
+std::string encodeSortKey(const BSONObj& sortKey, const Ordering& ordering) {
+    const KeyString encoded(KeyString::Version::V1, sortKey, ordering);
+    return std::string(encoded.getBuffer(), encoded.getSize());
+}
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(executor::TaskExecutor* executor,
                                        ClusterClientCursorParams* params)
     : _executor(executor),
       _params(params),
-      _mergeQueue(MergingComparator(_remotes, _params->sort)) {
+      _sortKeyOrdering(Ordering::make(_params->sort)),
+      _mergeQueue(MergingComparator(_remotes)) {
     size_t remoteIndex = 0;
     for (const auto& remote : _params->remotes) {
         _remotes.emplace_back(remote.hostAndPort, remote.cursorResponse.getCursorId());
@@ -199,6 +212,7 @@ ClusterQueryResult AsyncResultsMerger::nextReadySorted() {
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
+    _remotes[smallestRemote].sortKeyBuffer.pop();
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
@@ -422,6 +436,8 @@ void AsyncResultsMerger::handleBatchResponse(
             // Clear the results buffer and cursor id.
             std::queue<ClusterQueryResult> emptyBuffer;
             std::swap(remote.docBuffer, emptyBuffer);
+            std::queue<std::string> emptyKeyBuffer;
+            std::swap(remote.sortKeyBuffer, emptyKeyBuffer);
             remote.cursorId = 0;
         }
 
@@ -482,6 +498,11 @@ bool AsyncResultsMerger::addBatchToBuffer(size_t remoteIndex, const std::vector<
 
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
+        if (!_params->sort.isEmpty()) {
+            remote.sortKeyBuffer.push(
+                encodeSortKey(obj[ClusterClientCursorParams::kSortKeyField].Obj(),
+                              _sortKeyOrdering));
+        }
         ++remote.fetchedCount;
     }
 
@@ -608,15 +629,9 @@ std::shared_ptr<Shard> AsyncResultsMerger::RemoteCursorData::getShard() {
 //
 
 bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
-
-    BSONObj leftDocKey = (*leftDoc.getResult())[ClusterClientCursorParams::kSortKeyField].Obj();
-    BSONObj rightDocKey = (*rightDoc.getResult())[ClusterClientCursorParams::kSortKeyField].Obj();
-
-    // This does not need to sort with a collator, since mongod has already mapped strings to their
-    // ICU comparison keys as part of the $sortKey meta projection.
-    return leftDocKey.woCompare(rightDocKey, _sort, false /*considerFieldName*/) > 0;
+    // The sort keys were KeyString-encoded with the sort directions when the batches were
+    // buffered, so a plain byte comparison respects the sort pattern.
+    return _remotes[lhs].sortKeyBuffer.front() > _remotes[rhs].sortKeyBuffer.front();
 }
 
 }  // namespace mongo
@@ -35,6 +35,7 @@
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/query/cluster_client_cursor_params.h"
@@ -214,6 +215,11 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // KeyString-encoded sort keys parallel to 'docBuffer'. Used only if there is a sort, so
+        // that each merge comparison is a byte comparison of pre-encoded keys rather than a
+        // BSONObj comparison of the $sortKey fields.
+        std::queue<std::string> sortKeyBuffer;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -228,15 +234,12 @@ private:
 
     class MergingComparator {
     public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes, const BSONObj& sort)
-            : _remotes(remotes), _sort(sort) {}
+        MergingComparator(const std::vector<RemoteCursorData>& remotes) : _remotes(remotes) {}
 
         bool operator()(const size_t& lhs, const size_t& rhs);
 
     private:
         const std::vector<RemoteCursorData>& _remotes;
-
-        const BSONObj& _sort;
     };
 
     enum LifecycleState { kAlive, kKillStarted, kKillComplete };
@@ -331,6 +334,10 @@ private:
     // ok to run on secondaries.
     BSONObj _metadataObj;
 
+    // The sort directions from the sort pattern, used to KeyString-encode the $sortKey values of
+    // buffered results. Meaningful only if there is a sort.
+    const Ordering _sortKeyOrdering;
+
     // Must be acquired before accessing any data members (other than _params, which is read-only).
     // Must also be held when calling any of the '_inlock()' helper functions.
     stdx::mutex _mutex;
@@ -28,11 +28,13 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
 
 #include "mongo/db/cursor_id.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/query/cluster_client_cursor.h"
 #include "mongo/stdx/mutex.h"
@@ -370,6 +372,7 @@ public:
 
 private:
     class CursorEntry;
+    struct Partition;
     using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
 
     /**
@@ -392,23 +395,26 @@ private:
                        CursorState cursorState);
 
     /**
-     * Returns a pointer to the CursorEntry for the given cursor.  If the given cursor is not
-     * registered, returns null.
+     * Returns a pointer to the CursorEntry for the given cursor in the given partition.  If the
+     * given cursor is not registered, returns null.
      *
-     * Not thread-safe.
+     * Not thread-safe; the partition's mutex must be held.
      */
-    CursorEntry* getEntry_inlock(const NamespaceString& nss, CursorId cursorId);
+    CursorEntry* getEntry_inlock(Partition& partition,
+                                 const NamespaceString& nss,
+                                 CursorId cursorId);
 
     /**
-     * De-registers the given cursor, and returns an owned pointer to the underlying
-     * ClusterClientCursor object.
+     * De-registers the given cursor from the given partition, and returns an owned pointer to the
+     * underlying ClusterClientCursor object.
      *
      * If the given cursor is pinned, returns an error Status with code CursorInUse.  If the given
      * cursor is not registered, returns an error Status with code CursorNotFound.
      *
-     * Not thread-safe.
+     * Not thread-safe; the partition's mutex must be held.
      */
-    StatusWith<std::unique_ptr<ClusterClientCursor>> detachCursor_inlock(const NamespaceString& nss,
+    StatusWith<std::unique_ptr<ClusterClientCursor>> detachCursor_inlock(Partition& partition,
+                                                                         const NamespaceString& nss,
                                                                          CursorId cursorId);
 
     /**
@@ -521,36 +527,70 @@ private:
         CursorEntryMap entryMap;
     };
 
+    /**
+     * The cursor state is divided into partitions, each independently synchronized by its own
+     * mutex, so that cursor operations on different namespaces do not contend on a single manager
+     * mutex.  A namespace belongs to the partition given by the hash of the namespace, and the
+     * cursor id prefixes allocated within a partition are constrained so that the partition index
+     * is recoverable from a cursor id alone (see _getPartitionForCursorId()).  This mirrors the
+     * partitioning of the shard-side CursorManager.
+     */
+    struct Partition {
+        // Synchronizes access to all partition state below.
+        mutable stdx::mutex mutex;
+
+        // Map from cursor id prefix to associated namespace.  Exists only to provide namespace
+        // lookup for (deprecated) getNamespaceForCursorId() method.
+        //
+        // A CursorId is a 64-bit type, made up of a 32-bit prefix and a 32-bit suffix.  When the
+        // first cursor on a given namespace is registered, it is given a CursorId with a prefix
+        // that is unique to that namespace, and an arbitrary suffix.  Cursors subsequently
+        // registered on that namespace will all share the same prefix.
+        //
+        // Entries are added when the first cursor on the given namespace is registered, and
+        // removed when the last cursor on the given namespace is destroyed.
+        stdx::unordered_map<uint32_t, NamespaceString> cursorIdPrefixToNamespaceMap;
+
+        // Map from namespace to the CursorEntryContainer for that namespace.
+        //
+        // Entries are added when the first cursor on the given namespace is registered, and
+        // removed when the last cursor on the given namespace is destroyed.
+        stdx::unordered_map<NamespaceString, CursorEntryContainer, NamespaceString::Hasher>
+            namespaceToContainerMap;
+    };
+
+    // The number of partitions.  Must be a power of two, and must fit in the low bits of a cursor
+    // id prefix.
+    static constexpr size_t kNumPartitions = 16;
+
+    /**
+     * Returns the partition to which the given namespace belongs.
+     */
+    Partition& _getPartition(const NamespaceString& nss);
+    const Partition& _getPartition(const NamespaceString& nss) const;
+
+    /**
+     * Returns the partition to which the given cursor id belongs, recovered from the partition
+     * index encoded in the low bits of the cursor id prefix.
+     */
+    const Partition& _getPartitionForCursorId(CursorId cursorId) const;
+
     // Clock source.  Used when the 'last active' time for a cursor needs to be set/updated.  May be
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
-    mutable stdx::mutex _mutex;
-
-    bool _inShutdown{false};
+    // Set by shutdown() before it kills all registered cursors.  Checked while holding a partition
+    // mutex, so that a registration racing with shutdown either observes the flag or completes
+    // before the shutdown kill pass locks that partition.
+    AtomicWord<bool> _inShutdown{false};
 
-    // Randomness source.  Used for cursor id generation.
+    // Randomness source.  Used for cursor id generation.  Guarded by '_randomMutex', which is a
+    // leaf lock and may be taken while holding a partition mutex.
+    mutable stdx::mutex _randomMutex;
     PseudoRandom _pseudoRandom;
 
-    // Map from cursor id prefix to associated namespace.  Exists only to provide namespace lookup
-    // for (deprecated) getNamespaceForCursorId() method.
-    //
-    // A CursorId is a 64-bit type, made up of a 32-bit prefix and a 32-bit suffix.  When the first
-    // cursor on a given namespace is registered, it is given a CursorId with a prefix that is
-    // unique to that namespace, and an arbitrary suffix.  Cursors subsequently registered on that
-    // namespace will all share the same prefix.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    stdx::unordered_map<uint32_t, NamespaceString> _cursorIdPrefixToNamespaceMap;
-
-    // Map from namespace to the CursorEntryContainer for that namespace.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    stdx::unordered_map<NamespaceString, CursorEntryContainer, NamespaceString::Hasher>
-        _namespaceToContainerMap;
+    // The partitioned cursor state.
+    std::array<Partition, kNumPartitions> _partitions;
 
     size_t _cursorsTimedOut = 0;
 };
@@ -74,8 +74,31 @@ static const int kPerDocumentOverheadBytesUpperBound = 10;
 /**
  * Given the QueryRequest 'qr' being executed by mongos, returns a copy of the query which is
  * suitable for forwarding to the targeted hosts.
+ *
+ * If 'singleShard' is true, the query is known to target exactly one shard (always the case for
+ * unsharded collections), so the skip and limit are left for that shard to apply and no sort-key
+ * meta-projection is requested, since no merging happens on mongos.
  */
-StatusWith<std::unique_ptr<QueryRequest>> transformQueryForShards(const QueryRequest& qr) {
+StatusWith<std::unique_ptr<QueryRequest>> transformQueryForShards(const QueryRequest& qr,
+                                                                  bool singleShard) {
+    if (singleShard) {
+        auto newQR = stdx::make_unique<QueryRequest>(qr);
+
+        // !wantMore and ntoreturn mean the same as !wantMore and limit, so perform the conversion.
+        if (!qr.wantMore() && qr.getNToReturn()) {
+            newQR->setLimit(*qr.getNToReturn());
+            newQR->setNToReturn(boost::none);
+        }
+
+        // Even if the client sends us singleBatch=true (wantMore=false), we may need to retrieve
+        // multiple batches from the shard in order to return the single requested batch to the
+        // client.  Therefore, we must always send singleBatch=false (wantMore=true) to the shard.
+        newQR->setWantMore(true);
+
+        invariantOK(newQR->validate());
+        return std::move(newQR);
+    }
+
     // If there is a limit, we forward the sum of the limit and the skip.
     boost::optional<long long> newLimit;
     if (qr.getLimit()) {
@@ -181,15 +204,22 @@ StatusWith<CursorId> runQueryWithoutRetrying(OperationContext* opCtx,
         }
     }
 
+    // A query that targets exactly one shard (always the case for unsharded collections) can have
+    // its skip, limit and sort applied entirely by that shard, so mongos streams the results back
+    // without skip/limit stages or the sort-key machinery needed for merge sorting across shards.
+    const bool singleShard = (shards.size() == 1u);
+
     // Construct the query and parameters.
 
     ClusterClientCursorParams params(
         query.nss(),
         AuthorizationSession::get(opCtx->getClient())->getAuthenticatedUserNames(),
         readPref);
-    params.limit = query.getQueryRequest().getLimit();
+    if (!singleShard) {
+        params.limit = query.getQueryRequest().getLimit();
+        params.skip = query.getQueryRequest().getSkip();
+    }
     params.batchSize = query.getQueryRequest().getEffectiveBatchSize();
-    params.skip = query.getQueryRequest().getSkip();
     params.isTailable = query.getQueryRequest().isTailable();
     params.isAwaitData = query.getQueryRequest().isAwaitData();
     params.isAllowPartialResults = query.getQueryRequest().isAllowPartialResults();
@@ -204,14 +234,14 @@ StatusWith<CursorId> runQueryWithoutRetrying(OperationContext* opCtx,
     // $natural sort is actually a hint to use a collection scan, and shouldn't be treated like a
     // sort on mongos. Including a $natural anywhere in the sort spec results in the whole sort
     // being considered a hint to use a collection scan.
-    if (!query.getQueryRequest().getSort().hasField("$natural")) {
+    if (!singleShard && !query.getQueryRequest().getSort().hasField("$natural")) {
         params.sort = FindCommon::transformSortSpec(query.getQueryRequest().getSort());
     }
 
     // Tailable cursors can't have a sort, which should have already been validated.
     invariant(params.sort.isEmpty() || !params.isTailable);
 
-    const auto qrToForward = transformQueryForShards(query.getQueryRequest());
+    const auto qrToForward = transformQueryForShards(query.getQueryRequest(), singleShard);
     if (!qrToForward.isOK()) {
         return qrToForward.getStatus();
     }
@@ -32,6 +32,7 @@
 
 #include "mongo/s/server.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 
 #include "mongo/base/init.h"
@@ -60,6 +61,7 @@
 #include "mongo/db/logical_time_validator.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_noop.h"
 #include "mongo/db/startup_warnings_common.h"
@@ -69,6 +71,7 @@
 #include "mongo/rpc/metadata/egress_metadata_hook_list.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog/sharding_catalog_client.h"
+#include "mongo/s/catalog/type_collection.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/client/shard_connection.h"
 #include "mongo/s/client/shard_factory.h"
@@ -287,6 +290,60 @@ static Status initializeSharding(OperationContext* opCtx) {
     return Status::OK();
 }
 
+// Limits how many sharded collections have their routing information loaded into the catalog
+// cache before mongos starts accepting traffic, so a freshly restarted router does not pay the
+// full refresh latency on the first query per namespace. A value of 0 (the default) disables the
+// warm-up.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(warmupRoutingTableNamespaces, int, 0);
+
+// Granularity of the background-thread clock source that backs hot-path timing such as
+// operation deadline checks. Finer granularity tightens deadline enforcement at the cost of
+// more frequent wakeups of the clock thread.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(fastClockSourceGranularityMillis, int, 10);
+
+/**
+ * Best-effort pre-load of routing information for up to 'warmupRoutingTableNamespaces' sharded
+ * collections. Failures only generate warnings, since the cache can always be populated lazily.
+ */
+static void preWarmRoutingTableCache(OperationContext* opCtx) {
+    const int limit = warmupRoutingTableNamespaces;
+    if (limit <= 0) {
+        return;
+    }
+
+    std::vector<CollectionType> collections;
+    auto status = Grid::get(opCtx)->catalogClient()->getCollections(
+        opCtx, nullptr, &collections, nullptr);
+    if (!status.isOK()) {
+        warning() << "Failed to load the list of sharded collections for routing table warm-up"
+                  << causedBy(redact(status));
+        return;
+    }
+
+    int numWarmedUp = 0;
+    for (const auto& coll : collections) {
+        if (coll.getDropped()) {
+            continue;
+        }
+
+        if (numWarmedUp >= limit) {
+            break;
+        }
+
+        auto routingInfoStatus =
+            Grid::get(opCtx)->catalogCache()->getCollectionRoutingInfo(opCtx, coll.getNs());
+        if (!routingInfoStatus.isOK()) {
+            warning() << "Failed to warm up routing information for collection " << coll.getNs()
+                      << causedBy(redact(routingInfoStatus.getStatus()));
+            continue;
+        }
+
+        numWarmedUp++;
+    }
+
+    log() << "Pre-loaded routing information for " << numWarmedUp << " collection(s)";
+}
+
 static void _initWireSpec() {
     WireSpec& spec = WireSpec::instance();
     // connect to version supporting Write Concern only
@@ -367,6 +424,8 @@ static ExitCode runMongosServer() {
             .transitional_ignore();
     }
 
+    preWarmRoutingTableCache(opCtx.get());
+
     startMongoSFTDC();
 
     Status status = getGlobalAuthorizationManager()->initialize(NULL);
@@ -462,7 +521,8 @@ static int _main() {
 
     startSignalProcessingThread();
 
-    getGlobalServiceContext()->setFastClockSource(FastClockSourceFactory::create(Milliseconds{10}));
+    getGlobalServiceContext()->setFastClockSource(FastClockSourceFactory::create(
+        Milliseconds{std::max(1, fastClockSourceGranularityMillis)}));
 
     auto shardingContext = Grid::get(getGlobalServiceContext());
 
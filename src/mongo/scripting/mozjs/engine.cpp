@@ -49,6 +49,7 @@ namespace mongo {
 namespace {
 
 MONGO_EXPORT_SERVER_PARAMETER(disableJavaScriptJIT, bool, false);
+MONGO_EXPORT_SERVER_PARAMETER(enableJavaScriptBytecodeCache, bool, true);
 MONGO_EXPORT_SERVER_PARAMETER(javascriptProtection, bool, false);
 MONGO_EXPORT_SERVER_PARAMETER(jsHeapLimitMB, int, 1100);
 
@@ -131,6 +132,10 @@ bool MozJSScriptEngine::isJITEnabled() const {
     return !disableJavaScriptJIT.load();
 }
 
+bool MozJSScriptEngine::isBytecodeCacheEnabled() const {
+    return enableJavaScriptBytecodeCache.load();
+}
+
 void MozJSScriptEngine::enableJavaScriptProtection(bool value) {
     javascriptProtection.store(value);
 }
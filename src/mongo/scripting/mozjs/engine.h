@@ -66,6 +66,12 @@ public:
     void enableJIT(bool value) override;
     bool isJITEnabled() const override;
 
+    /**
+     * Whether compiled scripts may be shared between scopes through the process-wide
+     * XDR bytecode cache (the enableJavaScriptBytecodeCache server parameter).
+     */
+    bool isBytecodeCacheEnabled() const;
+
     void enableJavaScriptProtection(bool value) override;
     bool isJavaScriptProtectionEnabled() const override;
 
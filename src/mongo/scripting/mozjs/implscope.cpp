@@ -32,9 +32,12 @@
 
 #include "mongo/scripting/mozjs/implscope.h"
 
+#include <deque>
 #include <js/CharacterEncoding.h>
 #include <jscustomallocator.h>
 #include <jsfriendapi.h>
+#include <memory>
+#include <vector>
 
 #include "mongo/base/error_codes.h"
 #include "mongo/db/operation_context.h"
@@ -46,6 +49,7 @@
 #include "mongo/scripting/mozjs/valuewriter.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
 
@@ -97,6 +101,50 @@ bool gFirstRuntimeCreated = false;
 bool closeToMaxMemory() {
     return mongo::sm::get_total_bytes() > (kInterruptGCThreshold * mongo::sm::get_max_bytes());
 }
+
+/**
+ * Sources larger than this are not cached; the decode savings stop being interesting
+ * relative to the memory pinned by the cache.
+ */
+const size_t kMaxCachedSourceSize = 64 * 1024;
+
+/**
+ * A process-wide cache of XDR-encoded script bytecode keyed by filename and source.
+ * Compiled JSScripts are tied to the runtime that produced them, but their XDR encoding
+ * is not, so a pooled scope on any thread can decode a cached script instead of
+ * reparsing the source. mapReduce and $where workloads compile the same handful of
+ * sources into every scope they churn through, which is exactly the hit pattern here.
+ */
+class ScriptBytecodeCache {
+public:
+    std::shared_ptr<const std::vector<uint8_t>> find(const std::string& key) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto it = _cache.find(key);
+        return it == _cache.end() ? nullptr : it->second;
+    }
+
+    void put(const std::string& key, std::shared_ptr<const std::vector<uint8_t>> bytecode) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_cache.count(key))
+            return;
+        if (_insertionOrder.size() >= kMaxEntries) {
+            _cache.erase(_insertionOrder.front());
+            _insertionOrder.pop_front();
+        }
+        _insertionOrder.push_back(key);
+        _cache[key] = std::move(bytecode);
+    }
+
+private:
+    static const size_t kMaxEntries = 128;
+
+    stdx::mutex _mutex;
+    std::deque<std::string> _insertionOrder;  // protected by _mutex
+    stdx::unordered_map<std::string, std::shared_ptr<const std::vector<uint8_t>>>
+        _cache;  // protected by _mutex
+};
+
+ScriptBytecodeCache scriptBytecodeCache;
 }  // namespace
 
 thread_local MozJSImplScope::ASANHandles* kCurrentASANHandles = nullptr;
@@ -572,6 +620,43 @@ void MozJSImplScope::newFunction(StringData raw, JS::MutableHandleValue out) {
     _MozJSCreateFunction(raw, std::move(out));
 }
 
+bool MozJSImplScope::_compileWithBytecodeCache(const std::string& cacheKey,
+                                               StringData code,
+                                               JS::CompileOptions& co,
+                                               JS::MutableHandleScript script) {
+    const bool useCache =
+        _engine->isBytecodeCacheEnabled() && (code.size() <= kMaxCachedSourceSize);
+
+    if (useCache) {
+        if (auto bytecode = scriptBytecodeCache.find(cacheKey)) {
+            script.set(JS_DecodeScript(
+                _context, bytecode->data(), static_cast<uint32_t>(bytecode->size())));
+            if (script)
+                return true;
+            // A failed decode (e.g. an allocation failure) just means a fresh compile.
+            JS_ClearPendingException(_context);
+        }
+    }
+
+    if (!JS::Compile(_context, co, code.rawData(), code.size(), script))
+        return false;
+
+    if (useCache) {
+        uint32_t length = 0;
+        if (void* data = JS_EncodeScript(_context, script, &length)) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            scriptBytecodeCache.put(
+                cacheKey, std::make_shared<const std::vector<uint8_t>>(bytes, bytes + length));
+            JS_free(_context, data);
+        } else {
+            // Not every script can be encoded; failing to cache is not an error.
+            JS_ClearPendingException(_context);
+        }
+    }
+
+    return true;
+}
+
 void MozJSImplScope::_MozJSCreateFunction(StringData raw, JS::MutableHandleValue fun) {
     std::string code = str::stream()
         << "(" << parseJSFunctionOrExpression(_context, StringData(raw)) << ")";
@@ -579,7 +664,13 @@ void MozJSImplScope::_MozJSCreateFunction(StringData raw, JS::MutableHandleValue
     JS::CompileOptions co(_context);
     setCompileOptions(&co);
 
-    _checkErrorState(JS::Evaluate(_context, co, code.c_str(), code.length(), fun));
+    // Compiling and executing (rather than JS::Evaluate) lets function creation go
+    // through the bytecode cache; mapReduce and $where compile the same function
+    // sources into every scope they use.
+    JS::RootedScript script(_context);
+    bool success = _compileWithBytecodeCache(str::stream() << "function\n" << code, code, co, &script);
+    success = success && JS_ExecuteScript(_context, script, fun);
+    _checkErrorState(success);
     uassert(10232,
             "not a function",
             fun.isObject() && JS_ObjectIsFunction(_context, fun.toObjectOrNull()));
@@ -728,7 +819,9 @@ bool MozJSImplScope::exec(StringData code,
     co.setFileAndLine(name.c_str(), 1);
     JS::RootedScript script(_context);
 
-    bool success = JS::Compile(_context, co, code.rawData(), code.size(), &script);
+    // The filename is baked into the compiled script, so it participates in the key.
+    bool success =
+        _compileWithBytecodeCache(str::stream() << "exec\n" << name << '\n' << code, code, co, &script);
 
     if (_checkErrorState(success, reportError, assertOnError))
         return false;
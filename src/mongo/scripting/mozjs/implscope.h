@@ -352,6 +352,16 @@ private:
 
     void _MozJSCreateFunction(StringData raw, JS::MutableHandleValue fun);
 
+    /**
+     * Compiles 'code' into 'script', consulting and populating the process-wide XDR
+     * bytecode cache under 'cacheKey'. Returns false, with a pending exception on the
+     * context, if compilation fails.
+     */
+    bool _compileWithBytecodeCache(const std::string& cacheKey,
+                                   StringData code,
+                                   JS::CompileOptions& co,
+                                   JS::MutableHandleScript script);
+
     /**
      * This structure exists exclusively to construct the runtime and context
      * ahead of the various global prototypes in the ImplScope construction.
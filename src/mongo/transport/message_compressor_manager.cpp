@@ -36,7 +36,9 @@
 #include "mongo/base/data_type_endian.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/transport/message_compressor_registry.h"
+#include "mongo/transport/message_compressor_zlib_stream.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/message.h"
@@ -81,6 +83,17 @@ MessageCompressorManager::MessageCompressorManager()
 MessageCompressorManager::MessageCompressorManager(MessageCompressorRegistry* factory)
     : _registry{factory} {}
 
+MessageCompressorManager::MessageCompressorManager(MessageCompressorManager&&) = default;
+MessageCompressorManager& MessageCompressorManager::operator=(MessageCompressorManager&&) = default;
+MessageCompressorManager::~MessageCompressorManager() = default;
+
+ZlibStreamCompressorContext* MessageCompressorManager::_getZlibStreamContext() {
+    if (!_zlibStreamContext) {
+        _zlibStreamContext = stdx::make_unique<ZlibStreamCompressorContext>();
+    }
+    return _zlibStreamContext.get();
+}
+
 StatusWith<Message> MessageCompressorManager::compressMessage(const Message& msg) {
     if (_negotiated.size() == 0) {
         return {msg};
@@ -114,7 +127,15 @@ StatusWith<Message> MessageCompressorManager::compressMessage(const Message& msg
     compressionHeader.serialize(&output);
     ConstDataRange input(inputHeader.data(), inputHeader.data() + inputHeader.dataLen());
 
-    auto sws = compressor->compressData(input, output);
+    // The stateful zlibStream compressor operates on this session's compression context;
+    // the other compressors are stateless and shared between sessions.
+    StatusWith<std::size_t> sws(0);
+    if (compressor->getId() == static_cast<MessageCompressorId>(MessageCompressor::kZlibStream)) {
+        sws = static_cast<ZlibStreamMessageCompressor*>(compressor)->compressData(
+            _getZlibStreamContext(), input, output);
+    } else {
+        sws = compressor->compressData(input, output);
+    }
 
     if (!sws.isOK())
         return sws.getStatus();
@@ -148,7 +169,14 @@ StatusWith<Message> MessageCompressorManager::decompressMessage(const Message& m
 
     DataRangeCursor output(outMessage.data(), outMessage.data() + outMessage.dataLen());
 
-    auto sws = compressor->decompressData(input, output);
+    StatusWith<std::size_t> sws(0);
+    if (compressionHeader.compressorId ==
+        static_cast<MessageCompressorId>(MessageCompressor::kZlibStream)) {
+        sws = static_cast<ZlibStreamMessageCompressor*>(compressor)->decompressData(
+            _getZlibStreamContext(), input, output);
+    } else {
+        sws = compressor->decompressData(input, output);
+    }
 
     if (!sws.isOK())
         return sws.getStatus();
@@ -166,7 +194,10 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
     LOG(3) << "Starting client-side compression negotiation";
 
     // We're about to update the compressor list with the negotiation result from the server.
+    // Renegotiation also restarts any per-session compression streams; both sides of the
+    // connection take part in the exchange, so they restart their streams together.
     _negotiated.clear();
+    _zlibStreamContext.reset();
 
     auto& compressorList = _registry->getCompressorNames();
     if (compressorList.size() == 0)
@@ -228,8 +259,9 @@ void MessageCompressorManager::serverNegotiate(const BSONObj& input, BSONObjBuil
     }
 
     // If compression has already been negotiated, then this is a renegotiation, so we should
-    // reset the state of the manager.
+    // reset the state of the manager, including any per-session compression streams.
     _negotiated.clear();
+    _zlibStreamContext.reset();
 
     // First we go through all the compressor names that the client has requested support for
     BSONObj theirObj = elem.Obj();
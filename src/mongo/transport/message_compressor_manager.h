@@ -33,6 +33,7 @@
 #include "mongo/transport/message_compressor_base.h"
 #include "mongo/transport/session.h"
 
+#include <memory>
 #include <vector>
 
 namespace mongo {
@@ -41,6 +42,7 @@ class BSONObj;
 class BSONObjBuilder;
 class Message;
 class MessageCompressorRegistry;
+class ZlibStreamCompressorContext;
 
 class MessageCompressorManager {
     MONGO_DISALLOW_COPYING(MessageCompressorManager);
@@ -57,8 +59,9 @@ public:
      */
     explicit MessageCompressorManager(MessageCompressorRegistry* factory);
 
-    MessageCompressorManager(MessageCompressorManager&&) = default;
-    MessageCompressorManager& operator=(MessageCompressorManager&&) = default;
+    MessageCompressorManager(MessageCompressorManager&&);
+    MessageCompressorManager& operator=(MessageCompressorManager&&);
+    ~MessageCompressorManager();
 
     /*
      * Called by a client constructing an isMaster request. This function will append the result
@@ -117,8 +120,16 @@ public:
     static MessageCompressorManager& forSession(const transport::SessionHandle& session);
 
 private:
+    /*
+     * Returns this session's zlibStream compression context, creating it on first use. The
+     * stateful zlibStream compressor keeps its deflate/inflate streams here because this
+     * manager is a per-session object while the compressors in the registry are shared.
+     */
+    ZlibStreamCompressorContext* _getZlibStreamContext();
+
     std::vector<MessageCompressorBase*> _negotiated;
     MessageCompressorRegistry* _registry;
+    std::unique_ptr<ZlibStreamCompressorContext> _zlibStreamContext;
 };
 
 }  // namespace mongo
@@ -35,6 +35,7 @@
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/transport/message_compressor_zlib_stream.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/net/message.h"
 
@@ -189,5 +190,74 @@ TEST(ZlibMessageCompressor, Fidelity) {
     checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>());
 }
 
+TEST(ZlibStreamMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZlibStreamMessageCompressor>());
+}
+
+TEST(ZlibStreamMessageCompressor, ReusesWindowAcrossMessages) {
+    MessageCompressorRegistry registry;
+    auto compressor = stdx::make_unique<ZlibStreamMessageCompressor>();
+    const auto compressorName = compressor->getName();
+
+    std::vector<std::string> compressorList = {compressorName};
+    registry.setSupportedCompressors(std::move(compressorList));
+    registry.registerImplementation(std::move(compressor));
+    registry.finalizeSupportedCompressors().transitional_ignore();
+
+    MessageCompressorManager clientManager(&registry);
+    MessageCompressorManager serverManager(&registry);
+
+    BSONObjBuilder clientOutput;
+    clientManager.clientBegin(&clientOutput);
+    auto clientObj = clientOutput.done();
+
+    BSONObjBuilder serverOutput;
+    serverManager.serverNegotiate(clientObj, &serverOutput);
+    auto serverObj = serverOutput.done();
+    checkNegotiationResult(serverObj, {compressorName});
+    clientManager.clientFinish(serverObj);
+
+    // Build a message with a command-like skeleton that would repeat across an IoT-style
+    // workload.
+    std::string data;
+    for (int i = 0; i < 16; i++) {
+        data += "{ insert: \"telemetry\", documents: [ { sensor: \"abc\", value: 1 } ] }";
+    }
+    const auto bufferSize = MsgData::MsgDataHeaderSize + data.size();
+    auto buf = SharedBuffer::allocate(bufferSize);
+    MsgData::View testView(buf.get());
+    testView.setId(123456);
+    testView.setResponseToMsgId(654321);
+    testView.setOperation(dbQuery);
+    testView.setLen(bufferSize);
+    memcpy(testView.data(), data.data(), data.size());
+    Message testMessage{buf};
+
+    // Compress the same message twice. The second copy should be dramatically smaller
+    // because the compression window from the first message persists on the session.
+    auto swm = clientManager.compressMessage(testMessage);
+    ASSERT_OK(swm.getStatus());
+    auto firstCompressed = std::move(swm.getValue());
+
+    swm = clientManager.compressMessage(testMessage);
+    ASSERT_OK(swm.getStatus());
+    auto secondCompressed = std::move(swm.getValue());
+
+    ASSERT_LT(secondCompressed.dataSize(), firstCompressed.dataSize());
+
+    // The peer must see the stream in order; both messages must decompress back to the
+    // original.
+    for (auto compressedMsg : {&firstCompressed, &secondCompressed}) {
+        swm = serverManager.decompressMessage(*compressedMsg);
+        ASSERT_OK(swm.getStatus());
+        auto decompressedMsg = std::move(swm.getValue());
+        const auto decompressedMsgView = decompressedMsg.singleData();
+        ASSERT_EQ(decompressedMsgView.getLen(), testMessage.singleData().getLen());
+        ASSERT_EQ(
+            memcmp(decompressedMsgView.data(), testMessage.singleData().data(), data.size()), 0);
+    }
+}
+
 }  // namespace mongo
 }  // namespace
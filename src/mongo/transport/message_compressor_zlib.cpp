@@ -31,15 +31,31 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/init.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/util/log.h"
 
 #include <zlib.h>
 
 namespace mongo {
 
-ZlibMessageCompressor::ZlibMessageCompressor() : MessageCompressorBase(MessageCompressor::kZlib) {}
+// The zlib compression level used for network messages. Valid values are -1 (zlib's default,
+// currently equivalent to level 6) through 9; higher levels produce smaller messages at a
+// higher CPU cost, which can be a good trade on bandwidth-limited links.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(networkMessageCompressorZlibLevel,
+                                      int,
+                                      Z_DEFAULT_COMPRESSION);
+
+ZlibMessageCompressor::ZlibMessageCompressor() : MessageCompressorBase(MessageCompressor::kZlib) {
+    _level = networkMessageCompressorZlibLevel;
+    if (_level < Z_DEFAULT_COMPRESSION || _level > Z_BEST_COMPRESSION) {
+        warning() << "Ignoring invalid networkMessageCompressorZlibLevel value " << _level
+                  << ", using the zlib default level";
+        _level = Z_DEFAULT_COMPRESSION;
+    }
+}
 
 std::size_t ZlibMessageCompressor::getMaxCompressedSize(size_t inputSize) {
     return ::compressBound(inputSize);
@@ -52,7 +68,7 @@ StatusWith<std::size_t> ZlibMessageCompressor::compressData(ConstDataRange input
                           reinterpret_cast<uLongf*>(&outLength),
                           reinterpret_cast<const Bytef*>(input.data()),
                           input.length(),
-                          Z_DEFAULT_COMPRESSION);
+                          _level);
 
     if (ret != Z_OK) {
         return Status{ErrorCodes::BadValue, "Could not compress input"};
@@ -38,6 +38,10 @@ public:
     StatusWith<std::size_t> compressData(ConstDataRange input, DataRange output) override;
 
     StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
+
+private:
+    // The zlib compression level used for outbound messages, fixed at startup.
+    int _level;
 };
 
 
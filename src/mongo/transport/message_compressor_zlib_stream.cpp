@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/message_compressor_zlib_stream.h"
+
+#include "mongo/base/init.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_registry.h"
+
+namespace mongo {
+
+ZlibStreamCompressorContext::~ZlibStreamCompressorContext() {
+    if (_deflateInitialized) {
+        ::deflateEnd(&_deflateStream);
+    }
+    if (_inflateInitialized) {
+        ::inflateEnd(&_inflateStream);
+    }
+}
+
+ZlibStreamMessageCompressor::ZlibStreamMessageCompressor()
+    : MessageCompressorBase(MessageCompressor::kZlibStream) {}
+
+std::size_t ZlibStreamMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    // compressBound covers the worst case of deflate falling back to stored blocks; the
+    // extra bytes cover the empty block emitted by Z_SYNC_FLUSH at the end of each message.
+    return ::compressBound(inputSize) + 16;
+}
+
+StatusWith<std::size_t> ZlibStreamMessageCompressor::compressData(ConstDataRange input,
+                                                                  DataRange output) {
+    return Status{ErrorCodes::InternalError,
+                  "zlibStream compression requires a per-session context"};
+}
+
+StatusWith<std::size_t> ZlibStreamMessageCompressor::decompressData(ConstDataRange input,
+                                                                    DataRange output) {
+    return Status{ErrorCodes::InternalError,
+                  "zlibStream decompression requires a per-session context"};
+}
+
+StatusWith<std::size_t> ZlibStreamMessageCompressor::compressData(
+    ZlibStreamCompressorContext* context, ConstDataRange input, DataRange output) {
+    auto& stream = context->_deflateStream;
+    if (!context->_deflateInitialized) {
+        if (::deflateInit(&stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+            return Status{ErrorCodes::InternalError,
+                          "Could not initialize zlibStream compression stream"};
+        }
+        context->_deflateInitialized = true;
+    }
+
+    stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(input.data()));
+    stream.avail_in = input.length();
+    stream.next_out = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(output.data()));
+    stream.avail_out = output.length();
+
+    // Z_SYNC_FLUSH pushes all pending output and ends the message on a byte boundary while
+    // keeping the compression window for the next message on this session.
+    int ret = ::deflate(&stream, Z_SYNC_FLUSH);
+    if (ret != Z_OK || stream.avail_in != 0 || stream.avail_out == 0) {
+        return Status{ErrorCodes::BadValue, "Could not compress input"};
+    }
+
+    std::size_t outLength = output.length() - stream.avail_out;
+    counterHitCompress(input.length(), outLength);
+    return {outLength};
+}
+
+StatusWith<std::size_t> ZlibStreamMessageCompressor::decompressData(
+    ZlibStreamCompressorContext* context, ConstDataRange input, DataRange output) {
+    auto& stream = context->_inflateStream;
+    if (!context->_inflateInitialized) {
+        if (::inflateInit(&stream) != Z_OK) {
+            return Status{ErrorCodes::InternalError,
+                          "Could not initialize zlibStream decompression stream"};
+        }
+        context->_inflateInitialized = true;
+    }
+
+    stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(input.data()));
+    stream.avail_in = input.length();
+    stream.next_out = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(output.data()));
+    stream.avail_out = output.length();
+
+    int ret = ::inflate(&stream, Z_SYNC_FLUSH);
+    if (ret != Z_OK || stream.avail_in != 0) {
+        return Status{ErrorCodes::BadValue, "Compressed message was invalid or corrupted"};
+    }
+
+    std::size_t outLength = output.length() - stream.avail_out;
+    counterHitDecompress(input.length(), outLength);
+    return {outLength};
+}
+
+MONGO_INITIALIZER_GENERAL(ZlibStreamMessageCompressorInit,
+                          ("EndStartupOptionHandling"),
+                          ("AllCompressorsRegistered"))
+(InitializerContext* context) {
+    auto& compressorRegistry = MessageCompressorRegistry::get();
+    compressorRegistry.registerImplementation(stdx::make_unique<ZlibStreamMessageCompressor>());
+    return Status::OK();
+}
+}  // namespace mongo
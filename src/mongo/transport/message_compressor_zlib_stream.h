@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/transport/message_compressor_base.h"
+
+#include <zlib.h>
+
+namespace mongo {
+
+/*
+ * Holds the per-session deflate and inflate streams for the zlibStream compressor.
+ *
+ * Unlike the other compressors, zlibStream carries its compression window from one message
+ * to the next, so a stream of near-identical commands costs only its varying bytes on the
+ * wire after the first message. A context must therefore only ever see a single session's
+ * messages, in order; the MessageCompressorManager (which is itself a per-session object)
+ * owns one. Any compression or decompression error leaves the streams out of sync with the
+ * peer, so the resulting error Status must terminate the session - which is how compressor
+ * errors are already handled by the transport layer.
+ */
+class ZlibStreamCompressorContext {
+    MONGO_DISALLOW_COPYING(ZlibStreamCompressorContext);
+
+public:
+    ZlibStreamCompressorContext() = default;
+    ~ZlibStreamCompressorContext();
+
+private:
+    friend class ZlibStreamMessageCompressor;
+
+    z_stream _deflateStream{};
+    z_stream _inflateStream{};
+    bool _deflateInitialized = false;
+    bool _inflateInitialized = false;
+};
+
+class ZlibStreamMessageCompressor final : public MessageCompressorBase {
+public:
+    ZlibStreamMessageCompressor();
+
+    std::size_t getMaxCompressedSize(size_t inputSize) override;
+
+    /*
+     * zlibStream is stateful, so the context-free interface methods cannot be used. They
+     * always return an error; the MessageCompressorManager calls the overloads below with
+     * its per-session context instead.
+     */
+    StatusWith<std::size_t> compressData(ConstDataRange input, DataRange output) override;
+    StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
+
+    StatusWith<std::size_t> compressData(ZlibStreamCompressorContext* context,
+                                         ConstDataRange input,
+                                         DataRange output);
+    StatusWith<std::size_t> decompressData(ZlibStreamCompressorContext* context,
+                                           ConstDataRange input,
+                                           DataRange output);
+};
+
+}  // namespace mongo
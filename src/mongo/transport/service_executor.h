@@ -48,6 +48,12 @@ public:
     enum ScheduleFlags {
         EmptyFlags = 0,
         DeferredTask = 1,
+
+        // Indicates that the executor may run the task inline on the current thread without
+        // unwinding the stack first, subject to an executor-specific recursion limit. This
+        // avoids a cross-thread handoff for short continuations of work already running on an
+        // executor thread.
+        MayRecurse = 1 << 1,
     };
 
     /*
@@ -58,8 +64,8 @@ public:
     /*
      * Schedules a task with the ServiceExecutor and returns immediately.
      *
-     * This is guaranteed to unwind the stack before running the task, although the task may be
-     * run later in the same thread.
+     * Unless the task is scheduled with the MayRecurse flag, this is guaranteed to unwind the
+     * stack before running the task, although the task may be run later in the same thread.
      *
      * If defer is true, then the executor may defer execution of this Task until an available
      * thread is available.
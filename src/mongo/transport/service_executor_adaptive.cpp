@@ -70,10 +70,21 @@ MONGO_EXPORT_SERVER_PARAMETER(adaptiveServiceExecutorMaxQueueLatencyMicros, int,
 // doing actual work.
 MONGO_EXPORT_SERVER_PARAMETER(adaptiveServiceExecutorIdlePctThreshold, int, 60);
 
+// Tasks scheduled with the MayRecurse flag may be run inline on the scheduling thread instead
+// of being posted to the io_context, up to this many levels deep. This avoids a cross-thread
+// handoff between sourcing a message and processing it. A value of 0 (the default) disables
+// inline execution.
+MONGO_EXPORT_SERVER_PARAMETER(adaptiveServiceExecutorRecursionLimit, int, 0);
+
 thread_local TickSource::Tick ticksSpentExecuting = 0;
 thread_local TickSource::Tick ticksSpentScheduled = 0;
 thread_local int tasksExecuted = 0;
 
+// The depth of executor tasks currently running on this thread. Non-zero only inside a task
+// run by a worker thread, so it doubles as a check that inline execution stays on executor
+// threads.
+thread_local int recursionDepth = 0;
+
 constexpr auto kTotalScheduled = "totalScheduled"_sd;
 constexpr auto kTotalExecuted = "totalExecuted"_sd;
 constexpr auto kQueueDepth = "queueDepth"_sd;
@@ -125,6 +136,10 @@ struct ServerParameterOptions : public ServiceExecutorAdaptive::Options {
     int idlePctThreshold() const final {
         return adaptiveServiceExecutorIdlePctThreshold.load();
     }
+
+    int recursionLimit() const final {
+        return adaptiveServiceExecutorRecursionLimit.load();
+    }
 };
 
 
@@ -177,13 +192,15 @@ Status ServiceExecutorAdaptive::schedule(ServiceExecutorAdaptive::Task task, Sch
     auto scheduleTime = _tickSource->getTicks();
     auto pending = _tasksPending.addAndFetch(1);
 
-    _ioContext->post([ this, task = std::move(task), scheduleTime ] {
+    auto wrappedTask = [ this, task = std::move(task), scheduleTime ] {
         _tasksPending.subtractAndFetch(1);
         auto start = _tickSource->getTicks();
         ticksSpentScheduled += (start - scheduleTime);
         _tasksExecuting.addAndFetch(1);
+        ++recursionDepth;
 
         const auto guard = MakeGuard([this, start] {
+            --recursionDepth;
             _tasksExecuting.subtractAndFetch(1);
             ++tasksExecuted;
             auto thisSpentExecuting = _tickSource->getTicks() - start;
@@ -192,7 +209,18 @@ Status ServiceExecutorAdaptive::schedule(ServiceExecutorAdaptive::Task task, Sch
         });
 
         task();
-    });
+    };
+
+    // If this task may recurse and we're already running a task on a worker thread, then run it
+    // inline rather than posting it to the io_context. This avoids handing short continuations
+    // of in-progress work off to another thread.
+    if ((flags & MayRecurse) && (recursionDepth > 0) &&
+        (recursionDepth < _config->recursionLimit())) {
+        wrappedTask();
+        return Status::OK();
+    }
+
+    _ioContext->post(std::move(wrappedTask));
 
     _lastScheduleTimer.reset();
     _totalScheduled.addAndFetch(1);
@@ -74,6 +74,10 @@ public:
         // Threads that spend less than this threshold doing work during their workerThreadRunTime
         // period will exit
         virtual int idlePctThreshold() const = 0;
+
+        // Tasks scheduled with the MayRecurse flag may be run inline on the scheduling thread,
+        // up to this many levels deep. A value of 0 disables inline execution entirely.
+        virtual int recursionLimit() const = 0;
     };
 
     explicit ServiceExecutorAdaptive(ServiceContext* ctx, std::shared_ptr<asio::io_context> ioCtx);
@@ -68,6 +68,16 @@ struct TestOptions : public ServiceExecutorAdaptive::Options {
     int idlePctThreshold() const final {
         return 0;
     }
+
+    int recursionLimit() const override {
+        return 0;
+    }
+};
+
+struct RecursionOptions : public TestOptions {
+    int recursionLimit() const final {
+        return 10;
+    }
 };
 
 class ServiceExecutorAdaptiveFixture : public unittest::Test {
@@ -103,8 +113,9 @@ protected:
     }
 
     ServiceExecutorAdaptive::Options* config;
-    std::unique_ptr<ServiceExecutorAdaptive> makeAndStartExecutor() {
-        auto configOwned = stdx::make_unique<TestOptions>();
+    std::unique_ptr<ServiceExecutorAdaptive> makeAndStartExecutor(
+        std::unique_ptr<ServiceExecutorAdaptive::Options> configOwned =
+            stdx::make_unique<TestOptions>()) {
         config = configOwned.get();
         auto exec = stdx::make_unique<ServiceExecutorAdaptive>(
             getGlobalServiceContext(), asioIoCtx, std::move(configOwned));
@@ -245,5 +256,41 @@ TEST_F(ServiceExecutorAdaptiveFixture, TestDeferredTasks) {
     waitForCallback(0);
 }
 
+/*
+ * This tests that tasks scheduled with the MayRecurse flag from an executor thread get run
+ * inline on that thread, before the call to schedule() returns.
+ */
+TEST_F(ServiceExecutorAdaptiveFixture, TestRecursion) {
+    auto exec = makeAndStartExecutor(stdx::make_unique<RecursionOptions>());
+    auto guard = MakeGuard([&] { ASSERT_OK(exec->shutdown()); });
+
+    stdx::thread::id outerThread;
+    stdx::thread::id innerThread;
+    bool innerRanBeforeScheduleReturned = false;
+
+    waitFor = 1;
+    log() << "Scheduling task that schedules a recursable task";
+    ASSERT_OK(exec->schedule(
+        [&, this] {
+            outerThread = stdx::this_thread::get_id();
+
+            bool innerDone = false;
+            ASSERT_OK(exec->schedule(
+                [&] {
+                    innerThread = stdx::this_thread::get_id();
+                    innerDone = true;
+                },
+                ServiceExecutor::MayRecurse));
+            innerRanBeforeScheduleReturned = innerDone;
+
+            notifyCallback();
+        },
+        ServiceExecutor::EmptyFlags));
+
+    waitForCallback(0);
+    ASSERT_TRUE(innerRanBeforeScheduleReturned);
+    ASSERT(outerThread == innerThread);
+}
+
 }  // namespace
 }  // namespace mongo
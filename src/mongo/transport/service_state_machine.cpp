@@ -224,8 +224,9 @@ void ServiceStateMachine::_sourceCallback(Status status) {
 
         // If this callback doesn't own the ThreadGuard, then we're being called recursively,
         // and the executor shouldn't start a new thread to process the message - it can use this
-        // one just after this returns.
-        auto flags = guard.isOwner() ? ServiceExecutor::EmptyFlags : ServiceExecutor::DeferredTask;
+        // one just after this returns. If it does own the guard, the executor may run
+        // processMessage() inline on this thread rather than handing it off to another one.
+        auto flags = guard.isOwner() ? ServiceExecutor::MayRecurse : ServiceExecutor::DeferredTask;
         return scheduleNext(flags);
     } else if (ErrorCodes::isInterruption(status.code()) ||
                ErrorCodes::isNetworkError(status.code())) {
@@ -283,7 +284,17 @@ void ServiceStateMachine::_sinkCallback(Status status) {
         // If this callback doesn't own the ThreadGuard, then we're being called recursively,
         // and the executor shouldn't start a new thread to process the message - it can use this
         // one just after this returns.
-        auto flags = guard.isOwner() ? ServiceExecutor::EmptyFlags : ServiceExecutor::DeferredTask;
+        ServiceExecutor::ScheduleFlags flags;
+        if (!guard.isOwner()) {
+            flags = ServiceExecutor::DeferredTask;
+        } else if (inExhaust) {
+            // In exhaust mode the next step processes the synthesized getMore for this cursor
+            // rather than waiting on the network, so let the executor run it inline instead of
+            // paying a cross-thread handoff for every streamed batch.
+            flags = ServiceExecutor::MayRecurse;
+        } else {
+            flags = ServiceExecutor::EmptyFlags;
+        }
         return scheduleNext(flags);
     }
 }
@@ -93,7 +93,7 @@ void TransportLayerASIO::ASIOSourceTicket::_headerCallback(const std::error_code
     if (!session)
         return;
 
-    MSGHEADER::View headerView(_buffer.get());
+    MSGHEADER::ConstView headerView = _header.constView();
     auto msgLen = static_cast<size_t>(headerView.getMessageLength());
     if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
         LOG(0) << "recv(): message msgLen " << msgLen << " is invalid. "
@@ -102,12 +102,16 @@ void TransportLayerASIO::ASIOSourceTicket::_headerCallback(const std::error_code
         return;
     }
 
+    // Now that the full message length is known the buffer can be allocated at its final size
+    // and the rest of the message read directly into it, with no realloc or copy.
+    _buffer = SharedBuffer::allocate(msgLen);
+    memcpy(_buffer.get(), _header.constView().view2ptr(), kHeaderSize);
+
     if (msgLen == size) {
         finishFill(Status::OK());
         return;
     }
 
-    _buffer.realloc(msgLen);
     MsgData::View msgView(_buffer.get());
 
     session->read(isSync(),
@@ -120,11 +124,8 @@ void TransportLayerASIO::ASIOSourceTicket::fillImpl() {
     if (!session)
         return;
 
-    const auto initBufSize = kHeaderSize;
-    _buffer = SharedBuffer::allocate(initBufSize);
-
     session->read(isSync(),
-                  asio::buffer(_buffer.get(), initBufSize),
+                  asio::buffer(_header.view().view2ptr(), kHeaderSize),
                   [this](const std::error_code& ec, size_t size) { _headerCallback(ec, size); });
 }
 
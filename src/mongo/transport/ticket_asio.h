@@ -83,6 +83,10 @@ private:
     void _headerCallback(const std::error_code& ec, size_t size);
     void _bodyCallback(const std::error_code& ec, size_t size);
 
+    // The header is read into this fixed-size member so the message buffer can be allocated
+    // exactly once, at its full size, instead of being allocated at header size and then
+    // realloc'd (and copied) once the length is known.
+    MSGHEADER::Value _header;
     SharedBuffer _buffer;
     Message* _target;
 };
@@ -36,6 +36,11 @@
 
 #include <array>
 
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define MONGO_BASE64_HAVE_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
 namespace mongo {
 
 using std::begin;
@@ -76,86 +81,240 @@ private:
         "0123456789+/"};
     std::array<unsigned char, 256> decode;
 } alphabet;
-}  // namespace
-
-void base64::encode(stringstream& ss, const char* data, int size) {
-    for (int i = 0; i < size; i += 3) {
-        int left = size - i;
-        const unsigned char* start = (const unsigned char*)data + i;
-
-        // byte 0
-        ss << alphabet.e(start[0] >> 2);
 
-        // byte 1
-        unsigned char temp = (start[0] << 4);
-        if (left == 1) {
-            ss << alphabet.e(temp);
+// Encodes the input a byte at a time through the alphabet table, writing exactly
+// 4 * ((size + 2) / 3) characters at out.
+void encodeScalar(char* out, const unsigned char* data, size_t size) {
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        const unsigned char* start = data + i;
+        *out++ = alphabet.e(start[0] >> 2);
+        *out++ = alphabet.e((start[0] << 4) | ((start[1] >> 4) & 0xF));
+        *out++ = alphabet.e(((start[1] & 0xF) << 2) | ((start[2] >> 6) & 0x3));
+        *out++ = alphabet.e(start[2] & 0x3f);
+    }
+    switch (size - i) {
+        case 1:
+            *out++ = alphabet.e(data[i] >> 2);
+            *out++ = alphabet.e(data[i] << 4);
+            *out++ = '=';
+            *out++ = '=';
             break;
-        }
-        temp |= ((start[1] >> 4) & 0xF);
-        ss << alphabet.e(temp);
-
-        // byte 2
-        temp = (start[1] & 0xF) << 2;
-        if (left == 2) {
-            ss << alphabet.e(temp);
+        case 2:
+            *out++ = alphabet.e(data[i] >> 2);
+            *out++ = alphabet.e((data[i] << 4) | ((data[i + 1] >> 4) & 0xF));
+            *out++ = alphabet.e((data[i + 1] & 0xF) << 2);
+            *out++ = '=';
+            break;
+        default:
             break;
-        }
-        temp |= ((start[2] >> 6) & 0x3);
-        ss << alphabet.e(temp);
-
-        // byte 3
-        ss << alphabet.e(start[2] & 0x3f);
     }
+}
 
-    int mod = size % 3;
-    if (mod == 1) {
-        ss << "==";
-    } else if (mod == 2) {
-        ss << "=";
+#ifdef MONGO_BASE64_HAVE_SSSE3
+
+// Vectorized encode using the pshufb kernel of Mula and Lemire ("Faster Base64 encoding
+// and decoding using AVX2 instructions"). Each round turns 12 input bytes into 16 output
+// characters; the remainder is handled by encodeScalar.
+__attribute__((target("ssse3"))) void encodeSsse3(char* out,
+                                                 const unsigned char* data,
+                                                 size_t size) {
+    size_t i = 0;
+    // Each round loads 16 bytes (using 12), so stop while a full load stays in bounds.
+    while (i + 16 <= size) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+
+        // Spread each 3-byte group across a 32-bit lane, duplicating the bytes that
+        // contribute to two output characters.
+        const __m128i shuffled = _mm_shuffle_epi8(
+            input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+        // Isolate the four 6-bit indices of each lane into separate bytes.
+        const __m128i t0 = _mm_and_si128(shuffled, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(shuffled, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(t1, t3);
+
+        // Translate indices to ASCII by adding a per-range offset selected with pshufb.
+        __m128i offsetKey = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        offsetKey = _mm_or_si128(offsetKey, _mm_and_si128(less, _mm_set1_epi8(13)));
+        const __m128i offsets = _mm_setr_epi8('a' - 26,
+                                              '0' - 52,
+                                              '0' - 52,
+                                              '0' - 52,
+                                              '0' - 52,
+                                              '0' - 52,
+                                              '0' - 52,
+                                              '0' - 52,
+                                              '0' - 52,
+                                              '0' - 52,
+                                              '0' - 52,
+                                              '+' - 62,
+                                              '/' - 63,
+                                              'A',
+                                              0,
+                                              0);
+        const __m128i result = _mm_add_epi8(_mm_shuffle_epi8(offsets, offsetKey), indices);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+        out += 16;
+        i += 12;
     }
+    encodeScalar(out, data + i, size - i);
 }
 
+// Vectorized decode of full 16-character blocks containing neither padding nor invalid
+// characters. Validity is established with pshufb bitmask lookups (same paper as above)
+// and any suspect block is left to the scalar path so error reporting is unchanged.
+// Returns the number of input characters consumed (a multiple of 16) and sets *outLen to
+// the number of bytes produced; out must have room for 16 bytes per block even though
+// only 12 are produced.
+__attribute__((target("ssse3"))) size_t decodeBlocksSsse3(char* out,
+                                                          const unsigned char* data,
+                                                          size_t numBlockChars,
+                                                          size_t* outLen) {
+    // The lower nibble of each character selects a bitmask of valid character classes;
+    // the higher nibble selects the class bit and the ASCII-to-index shift.
+    const __m128i maskLut = _mm_setr_epi8(0xa8 - 256,
+                                          0xf8 - 256,
+                                          0xf8 - 256,
+                                          0xf8 - 256,
+                                          0xf8 - 256,
+                                          0xf8 - 256,
+                                          0xf8 - 256,
+                                          0xf8 - 256,
+                                          0xf8 - 256,
+                                          0xf8 - 256,
+                                          0xf0 - 256,
+                                          0x54,
+                                          0x50,
+                                          0x50,
+                                          0x50,
+                                          0x54);
+    const __m128i bitPosLut = _mm_setr_epi8(
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 - 256, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i shiftLut =
+        _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    size_t i = 0;
+    size_t produced = 0;
+    while (i + 16 <= numBlockChars) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i higherNibble = _mm_and_si128(_mm_srli_epi32(input, 4), _mm_set1_epi8(0x0f));
+        const __m128i lowerNibble = _mm_and_si128(input, _mm_set1_epi8(0x0f));
+
+        const __m128i classMask = _mm_shuffle_epi8(maskLut, lowerNibble);
+        const __m128i classBit = _mm_shuffle_epi8(bitPosLut, higherNibble);
+        const __m128i nonMatch =
+            _mm_cmpeq_epi8(_mm_and_si128(classMask, classBit), _mm_setzero_si128());
+        if (_mm_movemask_epi8(nonMatch)) {
+            // Padding or an invalid character: let the scalar loop take it from here.
+            break;
+        }
 
-string base64::encode(const char* data, int size) {
-    stringstream ss;
-    encode(ss, data, size);
-    return ss.str();
+        // Translate ASCII to 6-bit values; '/' shares a shift bucket with digits and
+        // needs a correction.
+        const __m128i eqSlash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+        const __m128i shift =
+            _mm_or_si128(_mm_andnot_si128(eqSlash, _mm_shuffle_epi8(shiftLut, higherNibble)),
+                         _mm_and_si128(eqSlash, _mm_set1_epi8(16)));
+        const __m128i values = _mm_add_epi8(input, shift);
+
+        // Pack the four 6-bit values of each lane into 3 bytes and compress the lanes.
+        const __m128i mergedPairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i packed = _mm_madd_epi16(mergedPairs, _mm_set1_epi32(0x00011000));
+        const __m128i output = _mm_shuffle_epi8(
+            packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), output);
+        out += 12;
+        produced += 12;
+        i += 16;
+    }
+    *outLen = produced;
+    return i;
 }
 
-string base64::encode(const string& s) {
-    return encode(s.c_str(), s.size());
+bool haveSsse3() {
+    static const bool have = __builtin_cpu_supports("ssse3");
+    return have;
 }
 
+#endif  // MONGO_BASE64_HAVE_SSSE3
+
+// Decodes into out, returning the number of bytes produced. Requires size % 4 == 0
+// (checked by the caller) and out to have room for 3 * (size / 4) bytes plus 4 bytes of
+// slack for the vectorized path's full-width stores.
+size_t decodeImpl(char* out, const unsigned char* data, size_t size) {
+    char* const outStart = out;
+    size_t i = 0;
+
+#ifdef MONGO_BASE64_HAVE_SSSE3
+    if (haveSsse3() && size >= 24) {
+        // Keep the last 8 characters for the scalar loop so terminating padding gets the
+        // usual handling.
+        size_t outLen;
+        i = decodeBlocksSsse3(out, data, size - 8, &outLen);
+        out += outLen;
+    }
+#endif
 
-void base64::decode(stringstream& ss, const string& s) {
-    uassert(10270, "invalid base64", s.size() % 4 == 0);
-    auto const data = reinterpret_cast<const unsigned char*>(s.c_str());
-    auto const size = s.size();
     bool done = false;
-
-    for (size_t i = 0; i < size; i += 4) {
+    for (; i < size; i += 4) {
         uassert(
             40538, "Invalid Base64 stream. Additional data following terminating sequence.", !done);
         auto const start = data + i;
         done = (start[2] == '=') || (start[3] == '=');
 
-        ss << (char)(((alphabet.d(start[0]) << 2) & 0xFC) | ((alphabet.d(start[1]) >> 4) & 0x3));
+        *out++ = ((alphabet.d(start[0]) << 2) & 0xFC) | ((alphabet.d(start[1]) >> 4) & 0x3);
         if (start[2] != '=') {
-            ss << (char)(((alphabet.d(start[1]) << 4) & 0xF0) |
-                         ((alphabet.d(start[2]) >> 2) & 0xF));
+            *out++ = ((alphabet.d(start[1]) << 4) & 0xF0) | ((alphabet.d(start[2]) >> 2) & 0xF);
             if (!done) {
-                ss << (char)(((alphabet.d(start[2]) << 6) & 0xC0) |
-                             ((alphabet.d(start[3]) & 0x3F)));
+                *out++ = ((alphabet.d(start[2]) << 6) & 0xC0) | (alphabet.d(start[3]) & 0x3F);
             }
         }
     }
+    return out - outStart;
+}
+
+}  // namespace
+
+void base64::encode(stringstream& ss, const char* data, int size) {
+    ss << encode(data, size);
+}
+
+string base64::encode(const char* data, int size) {
+    string ret;
+    ret.resize(4 * ((static_cast<size_t>(size) + 2) / 3));
+#ifdef MONGO_BASE64_HAVE_SSSE3
+    if (haveSsse3()) {
+        encodeSsse3(&ret[0], reinterpret_cast<const unsigned char*>(data), size);
+        return ret;
+    }
+#endif
+    encodeScalar(&ret[0], reinterpret_cast<const unsigned char*>(data), size);
+    return ret;
+}
+
+string base64::encode(const string& s) {
+    return encode(s.c_str(), s.size());
+}
+
+
+void base64::decode(stringstream& ss, const string& s) {
+    ss << decode(s);
 }
 
 string base64::decode(const string& s) {
-    stringstream ss;
-    decode(ss, s);
-    return ss.str();
+    uassert(10270, "invalid base64", s.size() % 4 == 0);
+    string ret;
+    // 4 bytes of slack for the vectorized path's 16-byte stores.
+    ret.resize(3 * (s.size() / 4) + 4);
+    size_t len = decodeImpl(&ret[0], reinterpret_cast<const unsigned char*>(s.c_str()), s.size());
+    ret.resize(len);
+    return ret;
 }
 
 bool base64::validate(const StringData s) {
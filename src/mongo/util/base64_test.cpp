@@ -64,6 +64,22 @@ TEST(Base64Test, transcode) {
     }
 }
 
+TEST(Base64Test, longPayloadRoundTrip) {
+    // Exercise the vectorized bulk path as well as every tail length around its block
+    // boundaries.
+    std::string plain;
+    for (int i = 0; i < 1024; ++i) {
+        plain.push_back(static_cast<char>(i * 131));
+    }
+    for (size_t len = plain.size() - 40; len <= plain.size(); ++len) {
+        const std::string prefix = plain.substr(0, len);
+        const std::string encoded = base64::encode(prefix);
+        ASSERT_EQUALS(4 * ((len + 2) / 3), encoded.size());
+        ASSERT_TRUE(base64::validate(encoded));
+        ASSERT_EQUALS(base64::decode(encoded), prefix);
+    }
+}
+
 TEST(Base64Test, parseFail) {
     const struct {
         std::string encoded;
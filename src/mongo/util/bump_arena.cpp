@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/bump_arena.h"
+
+#include <algorithm>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+const size_t kAlignment = 8;
+
+size_t alignUp(size_t bytes) {
+    return (bytes + kAlignment - 1) & ~(kAlignment - 1);
+}
+}  // namespace
+
+BumpArena::BumpArena(size_t chunkSize) : _chunkSize(alignUp(chunkSize)) {
+    invariant(_chunkSize > 0);
+}
+
+BumpArena::~BumpArena() = default;
+
+char* BumpArena::allocate(size_t bytes) {
+    bytes = alignUp(bytes);
+    if (static_cast<size_t>(_end - _next) >= bytes) {
+        char* out = _next;
+        _next += bytes;
+        return out;
+    }
+    return _allocateInNewChunk(bytes);
+}
+
+char* BumpArena::_allocateInNewChunk(size_t bytes) {
+    // Oversized requests get a chunk of exactly the requested size so they don't strand the
+    // tail of a standard chunk; everything else starts a fresh standard chunk.
+    const size_t chunkBytes = std::max(bytes, _chunkSize);
+    _chunks.push_back({std::unique_ptr<char[]>(new char[chunkBytes]), chunkBytes});
+    _capacity += chunkBytes;
+
+    Chunk& chunk = _chunks.back();
+    if (chunkBytes == _chunkSize) {
+        // Standard chunk: keep bumping out of it for subsequent allocations.
+        _next = chunk.data.get() + bytes;
+        _end = chunk.data.get() + chunkBytes;
+    }
+    // For an oversized chunk leave _next/_end alone; the current standard chunk (if any) may
+    // still have room for smaller allocations.
+    return chunk.data.get();
+}
+
+void BumpArena::reset() {
+    // Retain only the first standard chunk. Releasing the rest bounds the memory kept alive
+    // by an occasional large operation while keeping the steady-state reset allocation-free.
+    while (_chunks.size() > 1) {
+        _capacity -= _chunks.back().size;
+        _chunks.pop_back();
+    }
+    if (!_chunks.empty() && _chunks.front().size == _chunkSize) {
+        _next = _chunks.front().data.get();
+        _end = _next + _chunks.front().size;
+    } else {
+        _chunks.clear();
+        _capacity = 0;
+        _next = _end = nullptr;
+    }
+}
+
+}  // namespace mongo
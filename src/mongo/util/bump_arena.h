@@ -0,0 +1,94 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+
+namespace mongo {
+
+/**
+ * A resettable bump allocator. Allocations are satisfied by advancing a pointer through
+ * heap-allocated chunks; individual allocations are never freed. Instead, reset() makes the
+ * entire arena reusable in O(number of chunks), retaining the capacity already acquired.
+ *
+ * This is intended for request-scoped allocation patterns, where many small short-lived
+ * buffers are created while servicing a single operation and can all be discarded together
+ * when the operation completes.
+ *
+ * Not thread-safe. Memory returned by allocate() remains valid until reset() or destruction.
+ */
+class BumpArena {
+    MONGO_DISALLOW_COPYING(BumpArena);
+
+public:
+    static const size_t kDefaultChunkSize = 64 * 1024;
+
+    explicit BumpArena(size_t chunkSize = kDefaultChunkSize);
+    ~BumpArena();
+
+    /**
+     * Returns a pointer to 'bytes' bytes of uninitialized storage, aligned suitably for any
+     * scalar type. Allocations larger than the chunk size get a dedicated chunk.
+     */
+    char* allocate(size_t bytes);
+
+    /**
+     * Invalidates all outstanding allocations and makes the arena's capacity available for
+     * reuse. The first chunk is retained; oversized and overflow chunks are returned to the
+     * heap so a single large request does not pin memory for the lifetime of the arena.
+     */
+    void reset();
+
+    /**
+     * Total bytes of capacity currently owned by the arena.
+     */
+    size_t capacity() const {
+        return _capacity;
+    }
+
+private:
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    char* _allocateInNewChunk(size_t bytes);
+
+    std::vector<Chunk> _chunks;
+    char* _next = nullptr;  // next free byte in the current chunk
+    char* _end = nullptr;   // one past the end of the current chunk
+    size_t _chunkSize;
+    size_t _capacity = 0;
+};
+
+}  // namespace mongo
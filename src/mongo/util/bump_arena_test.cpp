@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cstring>
+
+#include "mongo/bson/util/builder.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/bump_arena.h"
+
+namespace {
+
+using namespace mongo;
+
+TEST(BumpArena, AllocationsAreDistinctAndAligned) {
+    BumpArena arena(1024);
+    char* a = arena.allocate(10);
+    char* b = arena.allocate(1);
+    char* c = arena.allocate(100);
+    ASSERT_NOT_EQUALS(a, b);
+    ASSERT_NOT_EQUALS(b, c);
+    ASSERT_EQUALS(reinterpret_cast<uintptr_t>(a) % 8, 0u);
+    ASSERT_EQUALS(reinterpret_cast<uintptr_t>(b) % 8, 0u);
+    ASSERT_EQUALS(reinterpret_cast<uintptr_t>(c) % 8, 0u);
+}
+
+TEST(BumpArena, OversizedAllocationGetsDedicatedChunk) {
+    BumpArena arena(64);
+    char* small = arena.allocate(8);
+    char* big = arena.allocate(4096);
+    // The small chunk must remain usable after the oversized allocation.
+    char* small2 = arena.allocate(8);
+    memset(big, 0xab, 4096);
+    ASSERT_EQUALS(small + 8, small2);
+}
+
+TEST(BumpArena, ResetReusesCapacity) {
+    BumpArena arena(1024);
+    arena.allocate(512);
+    arena.allocate(512);
+    arena.allocate(512);  // spills into a second chunk
+    const size_t capacityBefore = arena.capacity();
+    ASSERT_GREATER_THAN(capacityBefore, 1024u);
+    arena.reset();
+    ASSERT_LESS_THAN_OR_EQUALS(arena.capacity(), 1024u);
+    char* a = arena.allocate(16);
+    arena.reset();
+    char* b = arena.allocate(16);
+    ASSERT_EQUALS(a, b);
+}
+
+TEST(ArenaBufBuilder, AppendAndGrow) {
+    BumpArena arena;
+    ArenaBufBuilder b(arena, 8);
+    for (int i = 0; i < 1000; i++) {
+        b.appendNum(i);
+    }
+    ASSERT_EQUALS(b.len(), 4000);
+    const char* data = b.buf();
+    for (int i = 0; i < 1000; i++) {
+        int value;
+        memcpy(&value, data + 4 * i, sizeof(value));
+        ASSERT_EQUALS(value, i);
+    }
+}
+
+}  // namespace
@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/instrumented_mutex.h"
+
+#include <set>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/compiler.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+namespace {
+
+// Only 1 in kSampleRate acquisitions per thread takes the timed path. Power of two, so the
+// common-path check is a mask rather than a division.
+const uint32_t kSampleRate = 256;
+
+// Registry of live instances, walked by appendStats(). Leaked deliberately so latches with
+// static storage duration can still unregister during shutdown regardless of destruction order.
+stdx::mutex& registryMutex() {
+    static stdx::mutex* const mutex = new stdx::mutex();
+    return *mutex;
+}
+
+std::set<const InstrumentedMutex*>& registry() {
+    static std::set<const InstrumentedMutex*>* const instances =
+        new std::set<const InstrumentedMutex*>();
+    return *instances;
+}
+
+/**
+ * Returns the histogram bucket for a sampled wait: 0 for no wait, otherwise one plus the
+ * position of the highest set bit of the wait in microseconds, clamped to the last bucket.
+ */
+int bucketFor(long long waitMicros) {
+    int bucket = 0;
+    while (waitMicros > 0 && bucket < InstrumentedMutex::kNumWaitBuckets - 1) {
+        waitMicros >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+}  // namespace
+
+InstrumentedMutex::InstrumentedMutex(StringData name) : _name(name.toString()) {
+    stdx::lock_guard<stdx::mutex> lk(registryMutex());
+    registry().insert(this);
+}
+
+InstrumentedMutex::~InstrumentedMutex() {
+    stdx::lock_guard<stdx::mutex> lk(registryMutex());
+    registry().erase(this);
+}
+
+void InstrumentedMutex::lock() {
+    thread_local uint32_t samplingCounter = 0;
+    if (MONGO_unlikely((++samplingCounter & (kSampleRate - 1)) == 0)) {
+        _lockSampled();
+        return;
+    }
+    _mutex.lock();
+}
+
+void InstrumentedMutex::_lockSampled() {
+    _sampledAcquisitions.fetchAndAdd(1);
+
+    if (_mutex.try_lock()) {
+        _waitBuckets[0].fetchAndAdd(1);
+        return;
+    }
+
+    Timer timer;
+    _mutex.lock();
+    const long long waitMicros = timer.micros();
+
+    _sampledContended.fetchAndAdd(1);
+    _sampledWaitMicros.fetchAndAdd(waitMicros);
+    _waitBuckets[bucketFor(waitMicros)].fetchAndAdd(1);
+}
+
+void InstrumentedMutex::appendStats(BSONObjBuilder* builder) {
+    struct LatchStats {
+        long long instances = 0;
+        long long sampledAcquisitions = 0;
+        long long sampledContended = 0;
+        long long sampledWaitMicros = 0;
+        long long waitBuckets[kNumWaitBuckets] = {};
+    };
+
+    StringMap<LatchStats> statsByName;
+    {
+        stdx::lock_guard<stdx::mutex> lk(registryMutex());
+        for (const InstrumentedMutex* latch : registry()) {
+            LatchStats& stats = statsByName[latch->_name];
+            stats.instances++;
+            stats.sampledAcquisitions += latch->_sampledAcquisitions.load();
+            stats.sampledContended += latch->_sampledContended.load();
+            stats.sampledWaitMicros += latch->_sampledWaitMicros.load();
+            for (int i = 0; i < kNumWaitBuckets; i++) {
+                stats.waitBuckets[i] += latch->_waitBuckets[i].load();
+            }
+        }
+    }
+
+    builder->append("sampleRate", static_cast<int>(kSampleRate));
+    for (const auto& entry : statsByName) {
+        const LatchStats& stats = entry.second;
+        BSONObjBuilder latchBuilder(builder->subobjStart(entry.first));
+        latchBuilder.append("instances", stats.instances);
+        latchBuilder.append("sampledAcquisitions", stats.sampledAcquisitions);
+        latchBuilder.append("sampledContended", stats.sampledContended);
+        latchBuilder.append("sampledWaitMicros", stats.sampledWaitMicros);
+
+        // Keys are the lower bound of each bucket's wait, in microseconds.
+        BSONObjBuilder histogramBuilder(latchBuilder.subobjStart("waitHistogramMicros"));
+        long long lowerBound = 0;
+        for (int i = 0; i < kNumWaitBuckets; i++) {
+            histogramBuilder.append(std::to_string(lowerBound), stats.waitBuckets[i]);
+            lowerBound = lowerBound ? lowerBound * 2 : 1;
+        }
+        histogramBuilder.done();
+        latchBuilder.done();
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * A mutex that samples its own acquisition wait times, so the latches that burn CPU under
+ * contention can be identified from serverStatus (and therefore FTDC) instead of by attaching
+ * an external profiler.
+ *
+ * One in every 256 acquisitions per thread is timed and recorded into a per-latch histogram of
+ * wait durations; the other 255 pay only a thread-local counter increment over a plain
+ * stdx::mutex. Several instances may share a name (e.g. the lock manager's buckets), in which
+ * case their statistics are aggregated under that name at reporting time.
+ *
+ * Satisfies the Lockable concept, so it works with stdx::lock_guard and stdx::unique_lock.
+ */
+class InstrumentedMutex {
+    MONGO_DISALLOW_COPYING(InstrumentedMutex);
+
+public:
+    // Number of power-of-two wait-time histogram buckets. Bucket 0 holds sampled acquisitions
+    // that did not block at all; bucket i holds sampled waits of [2^(i-1), 2^i) microseconds,
+    // with the last bucket absorbing everything longer.
+    static const int kNumWaitBuckets = 11;
+
+    explicit InstrumentedMutex(StringData name);
+    ~InstrumentedMutex();
+
+    void lock();
+
+    void unlock() {
+        _mutex.unlock();
+    }
+
+    bool try_lock() {
+        return _mutex.try_lock();
+    }
+
+    const std::string& name() const {
+        return _name;
+    }
+
+    /**
+     * Appends the sampled statistics of all live instances to 'builder', one subobject per
+     * latch name, instances with the same name summed together. Used by the "latches"
+     * serverStatus section.
+     */
+    static void appendStats(BSONObjBuilder* builder);
+
+private:
+    /**
+     * Slow path for sampled acquisitions: times the wait and records it.
+     */
+    void _lockSampled();
+
+    const std::string _name;
+    stdx::mutex _mutex;
+
+    // All counters are written only on the 1-in-256 sampled path.
+    AtomicInt64 _sampledAcquisitions{0};
+    AtomicInt64 _sampledContended{0};
+    AtomicInt64 _sampledWaitMicros{0};
+    AtomicInt64 _waitBuckets[kNumWaitBuckets];
+};
+
+}  // namespace mongo
@@ -35,6 +35,7 @@
 
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -68,26 +69,44 @@ bool TicketHolder::tryAcquire() {
 }
 
 void TicketHolder::waitForTicket() {
+    if (tryAcquire())
+        return;
+
+    _queued.fetchAndAdd(1);
+    Timer timer;
     while (0 != sem_wait(&_sem)) {
         if (errno != EINTR)
             _check(-1);
     }
+    _totalTimeQueuedMicros.fetchAndAdd(timer.micros());
+    _queued.fetchAndSubtract(1);
 }
 
 bool TicketHolder::waitForTicketUntil(Date_t until) {
+    if (tryAcquire())
+        return true;
+
     const long long millisSinceEpoch = until.toMillisSinceEpoch();
     struct timespec ts;
 
     ts.tv_sec = millisSinceEpoch / 1000;
     ts.tv_nsec = (millisSinceEpoch % 1000) * (1000 * 1000);
+
+    _queued.fetchAndAdd(1);
+    Timer timer;
+    bool acquired = true;
     while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT)
-            return false;
+        if (errno == ETIMEDOUT) {
+            acquired = false;
+            break;
+        }
 
         if (errno != EINTR)
             _check(-1);
     }
-    return true;
+    _totalTimeQueuedMicros.fetchAndAdd(timer.micros());
+    _queued.fetchAndSubtract(1);
+    return acquired;
 }
 
 void TicketHolder::release() {
@@ -149,15 +168,31 @@ bool TicketHolder::tryAcquire() {
 void TicketHolder::waitForTicket() {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
 
+    if (_tryAcquire())
+        return;
+
+    _queued.fetchAndAdd(1);
+    Timer timer;
     while (!_tryAcquire()) {
         _newTicket.wait(lk);
     }
+    _totalTimeQueuedMicros.fetchAndAdd(timer.micros());
+    _queued.fetchAndSubtract(1);
 }
 
 bool TicketHolder::waitForTicketUntil(Date_t until) {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
 
-    return _newTicket.wait_until(lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+    if (_tryAcquire())
+        return true;
+
+    _queued.fetchAndAdd(1);
+    Timer timer;
+    const bool acquired =
+        _newTicket.wait_until(lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+    _totalTimeQueuedMicros.fetchAndAdd(timer.micros());
+    _queued.fetchAndSubtract(1);
+    return acquired;
 }
 
 void TicketHolder::release() {
@@ -213,4 +248,12 @@ bool TicketHolder::_tryAcquire() {
     return true;
 }
 #endif
+
+int TicketHolder::queued() const {
+    return _queued.load();
+}
+
+long long TicketHolder::totalTimeQueuedMicros() const {
+    return _totalTimeQueuedMicros.load();
+}
 }
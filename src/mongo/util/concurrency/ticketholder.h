@@ -31,6 +31,7 @@
 #endif
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/mutex.h"
@@ -61,7 +62,23 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of threads currently blocked waiting for a ticket.
+     */
+    int queued() const;
+
+    /**
+     * Returns the cumulative time threads have spent blocked waiting for a ticket, in
+     * microseconds. Only the blocking path is accounted; immediately granted tickets add
+     * nothing.
+     */
+    long long totalTimeQueuedMicros() const;
+
 private:
+    AtomicInt32 _queued;
+    AtomicInt64 _totalTimeQueuedMicros;
+
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
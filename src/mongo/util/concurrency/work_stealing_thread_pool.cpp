@@ -0,0 +1,369 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kExecutor
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+
+#include "mongo/base/status.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+// Counter used to assign unique names to otherwise-unnamed thread pools.
+AtomicInt32 nextUnnamedThreadPoolId{0};
+
+// Parked workers re-check their own deque and the steal targets this often, which bounds how
+// long a task can languish if its wakeup notification raced with the worker going to sleep.
+const Milliseconds kParkedRecheckInterval{10};
+
+WorkStealingThreadPool::Options cleanUpOptions(WorkStealingThreadPool::Options&& options) {
+    if (options.poolName.empty()) {
+        options.poolName = str::stream() << "WorkStealingThreadPool"
+                                         << nextUnnamedThreadPoolId.fetchAndAdd(1);
+    }
+    if (options.threadNamePrefix.empty()) {
+        options.threadNamePrefix = str::stream() << options.poolName << '-';
+    }
+    invariant(options.numThreads > 0);
+    return std::move(options);
+}
+
+}  // namespace
+
+struct WorkStealingThreadPool::Worker {
+    // Guards "tasks" and "sleeping".
+    stdx::mutex mutex;
+
+    // The owning worker pushes and pops at the back (LIFO); thieves and external submitters
+    // operate on the front, so the oldest tasks migrate first.
+    std::deque<Task> tasks;
+
+    stdx::condition_variable wakeCV;
+    bool sleeping = false;
+};
+
+thread_local WorkStealingThreadPool* WorkStealingThreadPool::_currentPool = nullptr;
+thread_local WorkStealingThreadPool::Worker* WorkStealingThreadPool::_currentWorker = nullptr;
+
+WorkStealingThreadPool::WorkStealingThreadPool(Options options)
+    : _options(cleanUpOptions(std::move(options))) {
+    for (size_t i = 0; i < _options.numThreads; ++i) {
+        _workers.push_back(stdx::make_unique<Worker>());
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _shutdown_inlock();
+    if (shutdownComplete != _state) {
+        _join_inlock(&lk);
+    }
+    invariant(shutdownComplete == _state);
+}
+
+void WorkStealingThreadPool::startup() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_state != preStart) {
+        severe() << "Attempting to start pool " << _options.poolName
+                 << ", but it has already started";
+        fassertFailed(51860);
+    }
+    _state = running;
+    for (size_t i = 0; i < _options.numThreads; ++i) {
+        const std::string threadName = str::stream() << _options.threadNamePrefix << i;
+        _threads.emplace_back([this, i, threadName] { _workerThreadBody(this, i, threadName); });
+    }
+}
+
+void WorkStealingThreadPool::shutdown() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _shutdown_inlock();
+}
+
+void WorkStealingThreadPool::_shutdown_inlock() {
+    switch (_state) {
+        case preStart:
+        case running:
+            _state = joinRequired;
+            _draining.store(true);
+            // Wake every worker so it can observe _draining. Taking each worker's mutex before
+            // notifying closes the race with a worker that has decided to sleep but not yet
+            // entered the wait.
+            for (auto&& worker : _workers) {
+                stdx::lock_guard<stdx::mutex> wk(worker->mutex);
+                worker->wakeCV.notify_one();
+            }
+            _stateChange.notify_all();
+            break;
+        case joinRequired:
+        case joining:
+        case shutdownComplete:
+            break;
+    }
+}
+
+void WorkStealingThreadPool::join() {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    _join_inlock(&lk);
+}
+
+void WorkStealingThreadPool::_join_inlock(stdx::unique_lock<stdx::mutex>* lk) {
+    _stateChange.wait(*lk, [this] {
+        switch (_state) {
+            case preStart:
+                return false;
+            case running:
+                return false;
+            case joinRequired:
+                return true;
+            case joining:
+            case shutdownComplete:
+                severe() << "Attempted to join pool " << _options.poolName << " more than once";
+                fassertFailed(51861);
+        }
+        MONGO_UNREACHABLE;
+    });
+    _state = joining;
+    std::vector<stdx::thread> threads;
+    threads.swap(_threads);
+    lk->unlock();
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    // Tasks scheduled before startup, or that raced with shutdown onto a deque after its owner
+    // had already drained past it, are run here so join() never strands work.
+    _drainAllDeques();
+    lk->lock();
+    invariant(joining == _state);
+    _state = shutdownComplete;
+    _stateChange.notify_all();
+}
+
+Status WorkStealingThreadPool::schedule(Task task) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        switch (_state) {
+            case joinRequired:
+            case joining:
+            case shutdownComplete:
+                return Status(ErrorCodes::ShutdownInProgress,
+                              str::stream() << "Shutdown of thread pool " << _options.poolName
+                                            << " in progress");
+            case preStart:
+            case running:
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+    }
+
+    Worker* target;
+    bool submitterOwnsTarget;
+    if (_currentPool == this) {
+        // Submissions from a pool thread stay local; the owner will pop this task next, while
+        // it is still warm in cache. Idle siblings can steal it from the front if the owner is
+        // busy for a while.
+        target = _currentWorker;
+        submitterOwnsTarget = true;
+    } else {
+        target = _workers[_nextWorker.fetchAndAdd(1) % _workers.size()].get();
+        submitterOwnsTarget = false;
+    }
+
+    bool targetWasSleeping;
+    {
+        stdx::lock_guard<stdx::mutex> lk(target->mutex);
+        target->tasks.push_back(std::move(task));
+        targetWasSleeping = target->sleeping;
+    }
+
+    if (targetWasSleeping) {
+        target->wakeCV.notify_one();
+    } else if (!submitterOwnsTarget) {
+        // The deque's owner is busy; wake at most one parked sibling to come steal. Submissions
+        // from a pool thread skip this — the whole pool is demonstrably awake and the next
+        // periodic recheck or steal scan will find the task.
+        _wakeOneSleeper();
+    }
+    return Status::OK();
+}
+
+void WorkStealingThreadPool::_wakeOneSleeper() {
+    if (_sleeperCount.load() == 0) {
+        return;
+    }
+    for (auto&& worker : _workers) {
+        stdx::unique_lock<stdx::mutex> lk(worker->mutex);
+        if (worker->sleeping) {
+            lk.unlock();
+            worker->wakeCV.notify_one();
+            return;
+        }
+    }
+}
+
+void WorkStealingThreadPool::_workerThreadBody(WorkStealingThreadPool* pool,
+                                               size_t workerIndex,
+                                               const std::string& threadName) {
+    setThreadName(threadName);
+    pool->_options.onCreateThread(threadName);
+    _currentPool = pool;
+    _currentWorker = pool->_workers[workerIndex].get();
+    LOG(1) << "starting thread in pool " << pool->_options.poolName;
+    pool->_consumeTasks(workerIndex);
+    _currentPool = nullptr;
+    _currentWorker = nullptr;
+
+    // This thread may no longer be safe to touch "pool" after this point.
+    LOG(1) << "shutting down thread in pool " << threadName;
+}
+
+void WorkStealingThreadPool::_consumeTasks(size_t workerIndex) {
+    Worker* const self = _workers[workerIndex].get();
+    const int64_t seed = static_cast<int64_t>(workerIndex * 2654435761ULL) ^
+        static_cast<int64_t>(reinterpret_cast<intptr_t>(this));
+    PseudoRandom random(seed);
+
+    while (true) {
+        Task task;
+        {
+            stdx::unique_lock<stdx::mutex> lk(self->mutex);
+            if (!self->tasks.empty()) {
+                task = std::move(self->tasks.back());
+                self->tasks.pop_back();
+            }
+        }
+        if (!task) {
+            task = _trySteal(self, &random);
+        }
+        if (task) {
+            _runTask(std::move(task));
+            continue;
+        }
+
+        stdx::unique_lock<stdx::mutex> lk(self->mutex);
+        if (!self->tasks.empty()) {
+            continue;
+        }
+        if (_draining.load()) {
+            break;
+        }
+        self->sleeping = true;
+        _sleeperCount.fetchAndAdd(1);
+        {
+            MONGO_IDLE_THREAD_BLOCK;
+            // Bounded wait rather than an open-ended one: a submitter that saw this worker as
+            // awake does not notify it, so parked workers recheck for stealable work on a
+            // short period instead of depending on a wakeup that may never target them.
+            self->wakeCV.wait_for(lk, kParkedRecheckInterval.toSystemDuration(), [&] {
+                return !self->tasks.empty() || _draining.load();
+            });
+        }
+        self->sleeping = false;
+        _sleeperCount.fetchAndSubtract(1);
+    }
+
+    // Drain phase: shutdown has been requested, but tasks accepted before the state change may
+    // still be queued on any deque. Keep working until everything is visibly empty.
+    while (true) {
+        Task task;
+        {
+            stdx::lock_guard<stdx::mutex> lk(self->mutex);
+            if (!self->tasks.empty()) {
+                task = std::move(self->tasks.back());
+                self->tasks.pop_back();
+            }
+        }
+        if (!task) {
+            task = _trySteal(self, &random);
+        }
+        if (!task) {
+            return;
+        }
+        _runTask(std::move(task));
+    }
+}
+
+WorkStealingThreadPool::Task WorkStealingThreadPool::_trySteal(Worker* self,
+                                                               PseudoRandom* random) {
+    const size_t numWorkers = _workers.size();
+    const size_t start = static_cast<size_t>(random->nextInt32(numWorkers));
+    for (size_t i = 0; i < numWorkers; ++i) {
+        Worker* victim = _workers[(start + i) % numWorkers].get();
+        if (victim == self) {
+            continue;
+        }
+        stdx::lock_guard<stdx::mutex> lk(victim->mutex);
+        if (!victim->tasks.empty()) {
+            Task task = std::move(victim->tasks.front());
+            victim->tasks.pop_front();
+            return task;
+        }
+    }
+    return Task();
+}
+
+void WorkStealingThreadPool::_runTask(Task task) {
+    try {
+        task();
+    } catch (...) {
+        severe() << "Exception escaped task in thread pool " << _options.poolName;
+        std::terminate();
+    }
+}
+
+void WorkStealingThreadPool::_drainAllDeques() {
+    for (auto&& worker : _workers) {
+        while (true) {
+            Task task;
+            {
+                stdx::lock_guard<stdx::mutex> lk(worker->mutex);
+                if (worker->tasks.empty()) {
+                    break;
+                }
+                task = std::move(worker->tasks.front());
+                worker->tasks.pop_front();
+            }
+            _runTask(std::move(task));
+        }
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,177 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_pool_interface.h"
+
+namespace mongo {
+
+class PseudoRandom;
+class Status;
+
+/**
+ * A fixed-size thread pool for high task rates, with one task deque per worker instead of the
+ * single shared queue ThreadPool uses.
+ *
+ * Each worker treats its own deque as a LIFO stack (good cache locality for tasks that spawn
+ * more tasks) and steals the oldest task from a randomly chosen victim when its own deque runs
+ * dry. Submissions from threads outside the pool are spread round-robin over the deques;
+ * submissions from a pool thread go to that thread's own deque. Wakeups are batched: a
+ * submission wakes at most one sleeping worker, and parked workers periodically re-check for
+ * stealable work, so a burst of submissions does not produce a thundering herd on one mutex.
+ *
+ * Unlike ThreadPool, the thread count is fixed at startup (no on-demand growth or idle-thread
+ * reaping); this pool targets long-lived internal consumers that are sized once.
+ */
+class WorkStealingThreadPool final : public ThreadPoolInterface {
+    MONGO_DISALLOW_COPYING(WorkStealingThreadPool);
+
+public:
+    /**
+     * Structure used to configure an instance of WorkStealingThreadPool.
+     */
+    struct Options {
+        // Name of the thread pool. If this string is empty, the pool will be assigned a
+        // name unique to the current process.
+        std::string poolName;
+
+        // Prefix used to name threads for logging purposes. An integer is appended to create
+        // each thread's name. If you leave this empty, the prefix will be the pool name
+        // followed by a hyphen.
+        std::string threadNamePrefix;
+
+        // Number of worker threads, and therefore task deques. Fixed for the pool's lifetime.
+        size_t numThreads = 8;
+
+        // This function is run before each worker thread begins consuming tasks.
+        using OnCreateThreadFn = stdx::function<void(const std::string& threadName)>;
+        OnCreateThreadFn onCreateThread = [](const std::string&) {};
+    };
+
+    /**
+     * Constructs a pool, configured with the given "options".
+     */
+    explicit WorkStealingThreadPool(Options options);
+
+    ~WorkStealingThreadPool() override;
+
+    void startup() override;
+    void shutdown() override;
+    void join() override;
+    Status schedule(Task task) override;
+
+private:
+    struct Worker;
+
+    /**
+     * Same stage-of-life diagram as ThreadPool:
+     *
+     * preStart -> running -> joinRequired -> joining -> shutdownComplete
+     *        \               ^
+     *         \_____________/
+     */
+    enum LifecycleState { preStart, running, joinRequired, joining, shutdownComplete };
+
+    /**
+     * Thread body for worker threads. A static member function so that late in its execution,
+     * after the pool may have been destroyed, it does not touch "pool".
+     */
+    static void _workerThreadBody(WorkStealingThreadPool* pool,
+                                  size_t workerIndex,
+                                  const std::string& threadName);
+
+    /**
+     * Run loop of the worker owning _workers[workerIndex].
+     */
+    void _consumeTasks(size_t workerIndex);
+
+    /**
+     * Pops the oldest task from the first non-empty victim deque, scanning from a random
+     * starting point. Returns an empty task if every other deque is empty.
+     */
+    Task _trySteal(Worker* self, PseudoRandom* random);
+
+    /**
+     * Wakes one sleeping worker, if there is one. Called after pushing work onto a deque whose
+     * owner was awake, so an idle sibling can come steal it.
+     */
+    void _wakeOneSleeper();
+
+    /**
+     * Runs "task", terminating the process if it throws.
+     */
+    void _runTask(Task task);
+
+    /**
+     * Runs every task remaining in every deque on the calling thread. Used to drain work that
+     * raced with shutdown, and to run all pending work when a never-started pool is joined.
+     */
+    void _drainAllDeques();
+
+    void _shutdown_inlock();
+    void _join_inlock(stdx::unique_lock<stdx::mutex>* lk);
+
+    const Options _options;
+
+    // Guards _state and _threads.
+    mutable stdx::mutex _mutex;
+    stdx::condition_variable _stateChange;
+    LifecycleState _state = preStart;
+    std::vector<stdx::thread> _threads;
+
+    // Set when shutdown is requested, so workers can notice without taking _mutex.
+    AtomicBool _draining{false};
+
+    // Task deques, one per worker, created at construction so tasks can be scheduled before
+    // startup.
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    // Round-robin cursor for submissions from threads outside the pool.
+    AtomicUInt32 _nextWorker{0};
+
+    // Number of workers currently parked; lets schedule() skip the wake scan at saturation.
+    AtomicInt32 _sleeperCount{0};
+
+    // Identify the worker deque owned by the current thread, if it belongs to this pool.
+    static thread_local WorkStealingThreadPool* _currentPool;
+    static thread_local Worker* _currentWorker;
+};
+
+}  // namespace mongo
@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/base/init.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/thread_pool_test_common.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+#include "mongo/util/time_support.h"
+
+namespace {
+
+using namespace mongo;
+
+MONGO_INITIALIZER(WorkStealingThreadPoolCommonTests)(InitializerContext*) {
+    addTestsForThreadPool("WorkStealingThreadPoolCommon", []() {
+        return stdx::make_unique<WorkStealingThreadPool>(WorkStealingThreadPool::Options());
+    });
+    return Status::OK();
+}
+
+TEST(WorkStealingThreadPoolTest, ManySubmittersAllTasksComplete) {
+    WorkStealingThreadPool::Options options;
+    options.poolName = "manySubmitters";
+    options.numThreads = 4;
+    WorkStealingThreadPool pool(std::move(options));
+    pool.startup();
+
+    const int kSubmitters = 8;
+    const int kTasksPerSubmitter = 500;
+    AtomicInt32 count(0);
+    std::vector<stdx::thread> submitters;
+    for (int i = 0; i < kSubmitters; ++i) {
+        submitters.emplace_back([&pool, &count] {
+            for (int j = 0; j < kTasksPerSubmitter; ++j) {
+                ASSERT_OK(pool.schedule([&count] { count.fetchAndAdd(1); }));
+            }
+        });
+    }
+    for (auto& thread : submitters) {
+        thread.join();
+    }
+    pool.shutdown();
+    pool.join();
+    ASSERT_EQ(kSubmitters * kTasksPerSubmitter, count.load());
+}
+
+TEST(WorkStealingThreadPoolTest, TasksSpawnedByTasksAllRun) {
+    WorkStealingThreadPool::Options options;
+    options.poolName = "spawningTasks";
+    options.numThreads = 2;
+    WorkStealingThreadPool pool(std::move(options));
+    pool.startup();
+
+    // Each top-level task fans out children from inside the pool, exercising the
+    // submit-to-own-deque path and stealing by the other worker.
+    const int kParents = 20;
+    const int kChildrenPerParent = 50;
+    AtomicInt32 count(0);
+    AtomicInt32 parentsDone(0);
+    for (int i = 0; i < kParents; ++i) {
+        ASSERT_OK(pool.schedule([&pool, &count, &parentsDone] {
+            for (int j = 0; j < kChildrenPerParent; ++j) {
+                ASSERT_OK(pool.schedule([&count] { count.fetchAndAdd(1); }));
+            }
+            parentsDone.fetchAndAdd(1);
+        }));
+    }
+    // Wait for every parent to finish scheduling before shutting down, since schedule() rejects
+    // new work once shutdown has begun.
+    while (parentsDone.load() < kParents) {
+        sleepmillis(1);
+    }
+    pool.shutdown();
+    pool.join();
+    ASSERT_EQ(kParents * kChildrenPerParent, count.load());
+}
+
+}  // namespace
@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/crc32c.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define MONGO_CRC32C_HAVE_SSE42 1
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define MONGO_CRC32C_HAVE_ARMV8 1
+#include <arm_acle.h>
+#endif
+
+namespace mongo {
+namespace {
+
+// CRC-32C uses the Castagnoli polynomial, 0x1EDC6F41, here in reflected form.
+constexpr std::uint32_t kCastagnoliPoly = 0x82f63b78U;
+
+const std::array<std::uint32_t, 256>& softwareTable() {
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t;
+        for (std::uint32_t i = 0; i < 256; i++) {
+            std::uint32_t crc = i;
+            for (int j = 0; j < 8; j++) {
+                crc = (crc & 1) ? (crc >> 1) ^ kCastagnoliPoly : (crc >> 1);
+            }
+            t[i] = crc;
+        }
+        return t;
+    }();
+    return table;
+}
+
+std::uint32_t crc32cSoftware(std::uint32_t crc, const char* data, std::size_t len) {
+    const auto& table = softwareTable();
+    std::uint32_t c = ~crc;
+    for (std::size_t i = 0; i < len; i++) {
+        c = table[(c ^ static_cast<std::uint8_t>(data[i])) & 0xff] ^ (c >> 8);
+    }
+    return ~c;
+}
+
+#ifdef MONGO_CRC32C_HAVE_SSE42
+__attribute__((target("sse4.2"))) std::uint32_t crc32cSse42(std::uint32_t crc,
+                                                            const char* data,
+                                                            std::size_t len) {
+    // The 64-bit form of the instruction takes and returns the crc in a 64-bit register
+    // with the upper half zeroed.
+    std::uint64_t c = ~crc;
+    while (len >= 8) {
+        std::uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        c = _mm_crc32_u64(c, word);
+        data += 8;
+        len -= 8;
+    }
+    std::uint32_t c32 = static_cast<std::uint32_t>(c);
+    while (len) {
+        c32 = _mm_crc32_u8(c32, static_cast<std::uint8_t>(*data));
+        data++;
+        len--;
+    }
+    return ~c32;
+}
+#endif
+
+#ifdef MONGO_CRC32C_HAVE_ARMV8
+std::uint32_t crc32cArmv8(std::uint32_t crc, const char* data, std::size_t len) {
+    std::uint32_t c = ~crc;
+    while (len >= 8) {
+        std::uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        c = __crc32cd(c, word);
+        data += 8;
+        len -= 8;
+    }
+    while (len) {
+        c = __crc32cb(c, static_cast<std::uint8_t>(*data));
+        data++;
+        len--;
+    }
+    return ~c;
+}
+#endif
+
+using Crc32cFn = std::uint32_t (*)(std::uint32_t, const char*, std::size_t);
+
+Crc32cFn chooseImpl() {
+#ifdef MONGO_CRC32C_HAVE_SSE42
+    if (__builtin_cpu_supports("sse4.2")) {
+        return crc32cSse42;
+    }
+#endif
+#ifdef MONGO_CRC32C_HAVE_ARMV8
+    return crc32cArmv8;
+#endif
+    return crc32cSoftware;
+}
+
+}  // namespace
+
+std::uint32_t crc32c(std::uint32_t crc, const void* data, std::size_t len) {
+    static const Crc32cFn impl = chooseImpl();
+    return impl(crc, static_cast<const char*>(data), len);
+}
+
+}  // namespace mongo
@@ -0,0 +1,54 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mongo {
+
+/**
+ * Computes the CRC-32C (Castagnoli) checksum of 'len' bytes at 'data', continuing from
+ * 'crc'. Pass 0 as the initial value; the result of one call may be passed as 'crc' to a
+ * subsequent call to checksum data incrementally.
+ *
+ * Uses the SSE4.2 CRC32 instruction when the CPU supports it (or the ARMv8 CRC32
+ * extension when compiled for it), falling back to a table-driven software
+ * implementation otherwise.
+ */
+std::uint32_t crc32c(std::uint32_t crc, const void* data, std::size_t len);
+
+/**
+ * Computes the CRC-32C checksum of 'len' bytes at 'data'.
+ */
+inline std::uint32_t crc32c(const void* data, std::size_t len) {
+    return crc32c(0, data, len);
+}
+
+}  // namespace mongo
@@ -0,0 +1,82 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/crc32c.h"
+
+#include <cstring>
+#include <vector>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(CRC32C, KnownVectors) {
+    // Standard CRC-32C check value.
+    ASSERT_EQUALS(0xe3069283U, crc32c("123456789", 9));
+
+    // Test vectors from RFC 3720 (iSCSI), appendix B.4.
+    std::vector<unsigned char> buf(32, 0x00);
+    ASSERT_EQUALS(0x8a9136aaU, crc32c(buf.data(), buf.size()));
+
+    buf.assign(32, 0xff);
+    ASSERT_EQUALS(0x62a8ab43U, crc32c(buf.data(), buf.size()));
+
+    buf.resize(32);
+    for (int i = 0; i < 32; i++) {
+        buf[i] = static_cast<unsigned char>(i);
+    }
+    ASSERT_EQUALS(0x46dd794eU, crc32c(buf.data(), buf.size()));
+}
+
+TEST(CRC32C, Empty) {
+    ASSERT_EQUALS(0U, crc32c("", 0));
+}
+
+TEST(CRC32C, Incremental) {
+    const char data[] = "123456789";
+    for (size_t split = 0; split <= 9; split++) {
+        auto crc = crc32c(data, split);
+        crc = crc32c(crc, data + split, 9 - split);
+        ASSERT_EQUALS(0xe3069283U, crc);
+    }
+}
+
+TEST(CRC32C, Alignment) {
+    // The checksum must not depend on the alignment of the input buffer.
+    const char data[] = "xxxxxxx123456789";
+    for (size_t offset = 0; offset < 8; offset++) {
+        std::vector<char> buf(data + offset, data + offset + 9);
+        ASSERT_EQUALS(crc32c(data + offset, 9), crc32c(buf.data(), 9));
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -152,6 +152,22 @@ TEST(DecorableTest, ThrowingConstructor) {
     ASSERT_EQ(1, numDestructedAs);
 }
 
+TEST(DecorableTest, TriviallyConstructibleDecorationsAreZeroInitialized) {
+    // Trivial decorations skip their constructor and destructor entries entirely and rely on
+    // the container's zero-initialized buffer, which must match value-initialization.
+    struct Pod {
+        int x;
+        long long y;
+    };
+    DecorationRegistry registry;
+    const auto pod = registry.declareDecoration<Pod>();
+    const auto count = registry.declareDecoration<int>();
+    DecorationContainer d(&registry);
+    ASSERT_EQ(0, d.getDecoration(pod).x);
+    ASSERT_EQ(0LL, d.getDecoration(pod).y);
+    ASSERT_EQ(0, d.getDecoration(count));
+}
+
 TEST(DecorableTest, Alignment) {
     DecorationRegistry registry;
     const auto firstChar = registry.declareDecoration<char>();
@@ -36,7 +36,9 @@ namespace mongo {
 
 DecorationContainer::DecorationContainer(const DecorationRegistry* registry)
     : _registry(registry),
-      _decorationData(new unsigned char[registry->getDecorationBufferSizeBytes()]) {
+      // The buffer is value-initialized: trivially constructible decorations rely on their
+      // storage being zeroed in lieu of running a constructor.
+      _decorationData(new unsigned char[registry->getDecorationBufferSizeBytes()]()) {
     _registry->construct(this);
 }
 
@@ -51,13 +51,19 @@ void DecorationRegistry::construct(DecorationContainer* decorable) const {
     auto iter = _decorationInfo.cbegin();
     try {
         for (; iter != _decorationInfo.cend(); ++iter) {
-            iter->constructor(decorable->getDecoration(iter->descriptor));
+            // Trivially constructible decorations have no constructor entry; their
+            // zero-initialized storage is already a constructed instance.
+            if (iter->constructor) {
+                iter->constructor(decorable->getDecoration(iter->descriptor));
+            }
         }
     } catch (...) {
         try {
             while (iter != _decorationInfo.cbegin()) {
                 --iter;
-                iter->destructor(decorable->getDecoration(iter->descriptor));
+                if (iter->destructor) {
+                    iter->destructor(decorable->getDecoration(iter->descriptor));
+                }
             }
         } catch (...) {
             std::terminate();
@@ -72,7 +78,9 @@ void DecorationRegistry::destruct(DecorationContainer* decorable) const {
                                                           end = _decorationInfo.rend();
              iter != end;
              ++iter) {
-            iter->destructor(decorable->getDecoration(iter->descriptor));
+            if (iter->destructor) {
+                iter->destructor(decorable->getDecoration(iter->descriptor));
+            }
         }
     } catch (...) {
         std::terminate();
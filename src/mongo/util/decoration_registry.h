@@ -33,7 +33,6 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/static_assert.h"
-#include "mongo/stdx/functional.h"
 #include "mongo/util/decoration_container.h"
 
 namespace mongo {
@@ -62,8 +61,14 @@ public:
     DecorationContainer::DecorationDescriptorWithType<T> declareDecoration() {
         MONGO_STATIC_ASSERT_MSG(std::is_nothrow_destructible<T>::value,
                                 "Decorations must be nothrow destructible");
+        // Trivial types need no per-instance work: the decoration buffer is zero-initialized,
+        // which is what value-initializing them would do, so their constructor and destructor
+        // entries are left null and skipped when containers are created and destroyed.
         return DecorationContainer::DecorationDescriptorWithType<T>(std::move(declareDecoration(
-            sizeof(T), std::alignment_of<T>::value, &constructAt<T>, &destructAt<T>)));
+            sizeof(T),
+            std::alignment_of<T>::value,
+            std::is_trivially_default_constructible<T>::value ? nullptr : &constructAt<T>,
+            std::is_trivially_destructible<T>::value ? nullptr : &destructAt<T>)));
     }
 
     size_t getDecorationBufferSizeBytes() const {
@@ -87,14 +92,16 @@ public:
 
 private:
     /**
-     * Function that constructs (initializes) a single instance of a decoration.
+     * Function that constructs (initializes) a single instance of a decoration. Null for
+     * decorations whose zero-initialized storage is already a constructed instance.
      */
-    using DecorationConstructorFn = stdx::function<void(void*)>;
+    using DecorationConstructorFn = void (*)(void*);
 
     /**
-     * Function that destructs (deinitializes) a single instance of a decoration.
+     * Function that destructs (deinitializes) a single instance of a decoration. Null for
+     * decorations with trivial destructors.
      */
-    using DecorationDestructorFn = stdx::function<void(void*)>;
+    using DecorationDestructorFn = void (*)(void*);
 
     struct DecorationInfo {
         DecorationInfo() {}
@@ -72,6 +72,8 @@ thread_local std::unique_ptr<FailPointPRNG> FailPointPRNG::_failPointPrng;
 
 }  // namespace
 
+AtomicUInt32 FailPoint::_numActiveFailPoints;
+
 void FailPoint::setThreadPRNGSeed(int32_t seed) {
     FailPointPRNG::current()->resetSeed(seed);
 }
@@ -126,6 +128,12 @@ void FailPoint::enableFailPoint() {
         newVal = expectedCurrentVal | ACTIVE_BIT;
         currentVal = _fpInfo.compareAndSwap(expectedCurrentVal, newVal);
     } while (expectedCurrentVal != currentVal);
+
+    // Only the thread whose compare-and-swap actually set the bit counts the transition,
+    // so concurrent enables cannot inflate the global armed count.
+    if ((expectedCurrentVal & ACTIVE_BIT) == 0) {
+        _numActiveFailPoints.addAndFetch(1);
+    }
 }
 
 void FailPoint::disableFailPoint() {
@@ -139,6 +147,12 @@ void FailPoint::disableFailPoint() {
         newVal = expectedCurrentVal & REF_COUNTER_MASK;
         currentVal = _fpInfo.compareAndSwap(expectedCurrentVal, newVal);
     } while (expectedCurrentVal != currentVal);
+
+    // As in enableFailPoint(), only the witness of the on->off transition counts it.
+    // This also covers nTimes exhaustion, which disables without holding _modMutex.
+    if (expectedCurrentVal & ACTIVE_BIT) {
+        _numActiveFailPoints.subtractAndFetch(1);
+    }
 }
 
 FailPoint::RetCode FailPoint::slowShouldFailOpenBlock() {
@@ -109,6 +109,13 @@ public:
      * @return slowOn if fail point is active.
      */
     inline RetCode shouldFailOpenBlock() {
+        // All fail points share one armed counter, so the dozens of checks on the
+        // per-operation path hit a single read-only cache line while no fail point in
+        // the process is set; the per-instance state is only inspected past that gate.
+        if (MONGO_likely(_numActiveFailPoints.loadRelaxed() == 0)) {
+            return fastOff;
+        }
+
         if (MONGO_likely((_fpInfo.loadRelaxed() & ACTIVE_BIT) == 0)) {
             return fastOff;
         }
@@ -152,6 +159,10 @@ private:
     static const ValType ACTIVE_BIT = 1 << 31;
     static const ValType REF_COUNTER_MASK = ~ACTIVE_BIT;
 
+    // Number of fail points in the process whose ACTIVE_BIT is set. Maintained by
+    // enableFailPoint()/disableFailPoint() on the actual off<->on transitions.
+    static AtomicUInt32 _numActiveFailPoints;
+
     // Bit layout:
     // 31: tells whether this fail point is active.
     // 0~30: unsigned ref counter for active dynamic instances.
@@ -37,6 +37,7 @@
 #include "mongo/db/server_parameters.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stacktrace.h"
+#include "mongo/util/time_support.h"
 
 #include <gperftools/malloc_hook.h>
 #include <third_party/murmurhash3/MurmurHash3.h>
@@ -110,6 +111,14 @@
 // be obtained and examined manually, and can be further processed by
 // tools.
 //
+// To investigate growth on a live instance a baseline of the current
+// per-stack active bytes can be captured with
+//     db.serverStatus({heapProfile: {markBaseline: true}})
+// Subsequent heapProfile sections then report, per stack, the signed
+// difference between current and baseline active bytes as
+// sinceBaselineBytes, so the stacks responsible for growth since the
+// baseline can be identified directly rather than by comparing dumps.
+//
 // We will need about 1 active ObjInfo for every sampleIntervalBytes live bytes,
 // so max active memory we can handle is sampleIntervalBytes * kMaxObjInfos.
 // With the current defaults of
@@ -321,9 +330,10 @@ private:
 
     // Stack HashTable Value.
     struct StackInfo {
-        int stackNum = 0;        // used for stack short name
-        BSONObj stackObj{};      // symbolized representation
-        size_t activeBytes = 0;  // number of live allocated bytes charged to this stack
+        int stackNum = 0;          // used for stack short name
+        BSONObj stackObj{};        // symbolized representation
+        size_t activeBytes = 0;    // number of live allocated bytes charged to this stack
+        size_t baselineBytes = 0;  // activeBytes when the baseline was last marked
         explicit StackInfo(int stackNum) : stackNum(stackNum) {}
         StackInfo() {}
     };
@@ -521,7 +531,12 @@ private:
     int numImportantSamples = 0;                // samples currently included in importantStacks
     const int kMaxImportantSamples = 4 * 3600;  // reset every 4 hours at default 1 sample / sec
 
-    void _generateServerStatusSection(BSONObjBuilder& builder) {
+    // Baseline state, updated only under stackinfo_mutex via markBaseline requests.
+    bool baselineMarked = false;      // a baseline has been captured
+    size_t totalBaselineBytes = 0;    // totalActiveBytes when the baseline was marked
+    Date_t baselineTime;              // when the baseline was marked
+
+    void _generateServerStatusSection(BSONObjBuilder& builder, bool markBaseline) {
         // compute and log some informational stats first time through
         if (logGeneralStats) {
             const size_t maxActiveMemory = sampleIntervalBytes * kMaxObjInfos;
@@ -538,6 +553,22 @@ private:
             logGeneralStats = false;
         }
 
+        // Guard against races updating the StackInfo bson representation and the baseline.
+        stdx::lock_guard<stdx::mutex> lk(stackinfo_mutex);
+
+        // Capture a new baseline if requested. Only this thread writes baselineBytes, and the
+        // skew wrt concurrently updated activeBytes is acceptable, same as for the traversal
+        // below.
+        if (markBaseline) {
+            stackHashTable.forEach([](Stack& stack, StackInfo& stackInfo) {
+                stackInfo.baselineBytes = stackInfo.activeBytes;
+            });
+            totalBaselineBytes = totalActiveBytes;
+            baselineTime = Date_t::now();
+            baselineMarked = true;
+            log() << "heapProfile baseline marked at " << totalBaselineBytes << " active bytes";
+        }
+
         // Stats subsection.
         BSONObjBuilder statsBuilder(builder.subobjStart("stats"));
         statsBuilder.appendNumber("totalActiveBytes", totalActiveBytes);
@@ -545,11 +576,14 @@ private:
         statsBuilder.appendNumber("numStacks", stackHashTable.size());
         statsBuilder.appendNumber("currentObjEntries", objHashTable.size());
         statsBuilder.appendNumber("maxObjEntriesUsed", objHashTable.maxSizeSeen());
+        if (baselineMarked) {
+            statsBuilder.append("baselineTime", baselineTime);
+            statsBuilder.appendNumber("totalSinceBaselineBytes",
+                                      static_cast<long long>(totalActiveBytes) -
+                                          static_cast<long long>(totalBaselineBytes));
+        }
         statsBuilder.doneFast();
 
-        // Guard against races updating the StackInfo bson representation.
-        stdx::lock_guard<stdx::mutex> lk(stackinfo_mutex);
-
         // Traverse stackHashTable accumulating potential stacks to emit.
         // We do this traversal without locking hashtable_mutex because we need to use the heap.
         // forEach guarantees this is safe wrt to insert(), and we never call remove().
@@ -579,6 +613,38 @@ private:
                 break;
         }
 
+        // If a baseline was marked also deem important the stacks accounting for most of the
+        // growth since the baseline, so the answer to "what grew" is emitted even when the
+        // growing stacks are still small relative to total active bytes.
+        if (baselineMarked) {
+            auto sinceBaseline = [](StackInfo* stackInfo) -> long long {
+                return static_cast<long long>(stackInfo->activeBytes) -
+                    static_cast<long long>(stackInfo->baselineBytes);
+            };
+            auto sortBySinceBaseline = [&](StackInfo* a, StackInfo* b) -> bool {
+                return sinceBaseline(a) > sinceBaseline(b);
+            };
+            std::stable_sort(stackInfos.begin(), stackInfos.end(), sortBySinceBaseline);
+            long long totalGrowth = 0;
+            for (auto it = stackInfos.begin(); it != stackInfos.end(); ++it) {
+                long long growth = sinceBaseline(*it);
+                if (growth > 0)
+                    totalGrowth += growth;
+            }
+            long long growthThreshold = totalGrowth * 0.99;
+            long long cumulativeGrowth = 0;
+            for (auto it = stackInfos.begin(); it != stackInfos.end(); ++it) {
+                StackInfo* stackInfo = *it;
+                long long growth = sinceBaseline(stackInfo);
+                if (growth <= 0)
+                    break;
+                importantStacks.insert(stackInfo);
+                cumulativeGrowth += growth;
+                if (cumulativeGrowth > growthThreshold)
+                    break;
+            }
+        }
+
         // Build the stacks subsection by emitting the "important" stacks.
         BSONObjBuilder stacksBuilder(builder.subobjStart("stacks"));
         for (auto it = importantStacks.begin(); it != importantStacks.end(); ++it) {
@@ -587,6 +653,11 @@ private:
             shortName << "stack" << stackInfo->stackNum;
             BSONObjBuilder stackBuilder(stacksBuilder.subobjStart(shortName.str()));
             stackBuilder.appendNumber("activeBytes", stackInfo->activeBytes);
+            if (baselineMarked) {
+                stackBuilder.appendNumber("sinceBaselineBytes",
+                                          static_cast<long long>(stackInfo->activeBytes) -
+                                              static_cast<long long>(stackInfo->baselineBytes));
+            }
             stackBuilder.append("stack", stackInfo->stackObj);
         }
         stacksBuilder.doneFast();
@@ -631,9 +702,9 @@ public:
         MallocHook::AddDeleteHook(free);
     }
 
-    static void generateServerStatusSection(BSONObjBuilder& builder) {
+    static void generateServerStatusSection(BSONObjBuilder& builder, bool markBaseline) {
         if (heapProfiler)
-            heapProfiler->_generateServerStatusSection(builder);
+            heapProfiler->_generateServerStatusSection(builder, markBaseline);
     }
 };
 
@@ -651,8 +722,12 @@ public:
 
     BSONObj generateSection(OperationContext* opCtx,
                             const BSONElement& configElement) const override {
+        // serverStatus({heapProfile: {markBaseline: true}}) snapshots the current per-stack
+        // active bytes so later sections can report growth since this point.
+        const bool markBaseline = configElement.isABSONObj() &&
+            configElement.Obj()["markBaseline"].trueValue();
         BSONObjBuilder builder;
-        HeapProfiler::generateServerStatusSection(builder);
+        HeapProfiler::generateServerStatusSection(builder, markBaseline);
         return builder.obj();
     }
 } heapProfilerServerStatusSection;
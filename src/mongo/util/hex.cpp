@@ -33,8 +33,72 @@
 #include <sstream>
 #include <string>
 
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define MONGO_HEX_HAVE_SSSE3 1
+#include <tmmintrin.h>
+#endif
+
 namespace mongo {
 
+namespace {
+
+// Expands each input byte to two hex characters drawn from the 16-entry table.
+void hexEncodeScalar(char* out, const unsigned char* in, size_t len, const char* hexchars) {
+    for (size_t i = 0; i < len; ++i) {
+        *out++ = hexchars[in[i] >> 4];
+        *out++ = hexchars[in[i] & 0x0F];
+    }
+}
+
+#ifdef MONGO_HEX_HAVE_SSSE3
+
+// Vectorized variant: interleave the high and low nibbles of 8 input bytes and map them
+// through the table with a single pshufb, producing 16 output characters per round.
+__attribute__((target("ssse3"))) void hexEncodeSsse3(char* out,
+                                                     const unsigned char* in,
+                                                     size_t len,
+                                                     const char* hexchars) {
+    const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hexchars));
+    while (len >= 8) {
+        const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in));
+        const __m128i lo = _mm_and_si128(v, _mm_set1_epi8(0x0F));
+        const __m128i hi = _mm_and_si128(_mm_srli_epi32(v, 4), _mm_set1_epi8(0x0F));
+        const __m128i nibbles = _mm_unpacklo_epi8(hi, lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(table, nibbles));
+        in += 8;
+        out += 16;
+        len -= 8;
+    }
+    hexEncodeScalar(out, in, len, hexchars);
+}
+
+#endif  // MONGO_HEX_HAVE_SSSE3
+
+std::string hexEncode(const void* inRaw, int len, const char* hexchars) {
+    std::string out;
+    out.resize(static_cast<size_t>(len) * 2);
+    auto in = reinterpret_cast<const unsigned char*>(inRaw);
+#ifdef MONGO_HEX_HAVE_SSSE3
+    static const bool haveSsse3 = __builtin_cpu_supports("ssse3");
+    if (haveSsse3) {
+        hexEncodeSsse3(&out[0], in, len, hexchars);
+        return out;
+    }
+#endif
+    hexEncodeScalar(&out[0], in, len, hexchars);
+    return out;
+}
+
+}  // namespace
+
+std::string toHex(const void* inRaw, int len) {
+    return hexEncode(inRaw, len, "0123456789ABCDEF");
+}
+
+std::string toHexLower(const void* inRaw, int len) {
+    return hexEncode(inRaw, len, "0123456789abcdef");
+}
+
 template <typename T>
 std::string integerToHexDef(T inInt) {
     if (!inInt)
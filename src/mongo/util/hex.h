@@ -53,40 +53,12 @@ inline char fromHex(StringData c) {
     return (char)((fromHex(c[0]) << 4) | fromHex(c[1]));
 }
 
-inline std::string toHex(const void* inRaw, int len) {
-    static const char hexchars[] = "0123456789ABCDEF";
-
-    StringBuilder out;
-    const char* in = reinterpret_cast<const char*>(inRaw);
-    for (int i = 0; i < len; ++i) {
-        char c = in[i];
-        char hi = hexchars[(c & 0xF0) >> 4];
-        char lo = hexchars[(c & 0x0F)];
-
-        out << hi << lo;
-    }
-
-    return out.str();
-}
+std::string toHex(const void* inRaw, int len);
 
 template <typename T>
 std::string integerToHex(T val);
 
-inline std::string toHexLower(const void* inRaw, int len) {
-    static const char hexchars[] = "0123456789abcdef";
-
-    StringBuilder out;
-    const char* in = reinterpret_cast<const char*>(inRaw);
-    for (int i = 0; i < len; ++i) {
-        char c = in[i];
-        char hi = hexchars[(c & 0xF0) >> 4];
-        char lo = hexchars[(c & 0x0F)];
-
-        out << hi << lo;
-    }
-
-    return out.str();
-}
+std::string toHexLower(const void* inRaw, int len);
 
 /* @return a dump of the buffer as hex byte ascii output */
 std::string hexdump(const char* data, unsigned len);
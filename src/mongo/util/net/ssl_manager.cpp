@@ -62,6 +62,8 @@
 #include <openssl/asn1.h>
 #include <openssl/asn1t.h>
 #include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
 #include <openssl/x509_vfy.h>
 #include <openssl/x509v3.h>
 #if defined(_WIN32)
@@ -246,6 +248,115 @@ void _free_ssl_context(SSL_CTX* ctx) {
     }
 }
 
+#ifdef SSL_CTRL_SET_TLSEXT_TICKET_KEY_CB
+/**
+ * Rotating TLS session ticket keys, shared by every ingress SSL context in the process.
+ *
+ * By default OpenSSL generates one random ticket key per SSL_CTX when the context is
+ * created and uses it for the life of the process. Serving tickets from a single rotating
+ * store instead limits how long any one key can decrypt captured tickets, and lets clients
+ * resume against any of the server's contexts. The previous key is kept so that tickets
+ * issued shortly before a rotation can still be redeemed; OpenSSL is told to reissue such
+ * tickets under the current key.
+ */
+class SSLSessionTicketKeyManager {
+public:
+    static SSLSessionTicketKeyManager& get() {
+        static SSLSessionTicketKeyManager instance;
+        return instance;
+    }
+
+    int handleTicket(
+        unsigned char* keyName, unsigned char* iv, EVP_CIPHER_CTX* ctx, HMAC_CTX* hctx, int enc) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto now = Date_t::now();
+
+        if (enc) {
+            if (!_haveCurrent || now - _currentCreated >= kRotationInterval) {
+                if (!_rotateInLock(now)) {
+                    return -1;
+                }
+            }
+            memcpy(keyName, _current.name, sizeof(_current.name));
+            if (RAND_bytes(iv, EVP_MAX_IV_LENGTH) != 1 ||
+                EVP_EncryptInit_ex(ctx, EVP_aes_128_cbc(), nullptr, _current.aesKey, iv) != 1 ||
+                HMAC_Init_ex(
+                    hctx, _current.hmacKey, sizeof(_current.hmacKey), EVP_sha256(), nullptr) != 1) {
+                return -1;
+            }
+            return 1;
+        }
+
+        const Key* key = nullptr;
+        bool isCurrent = false;
+        if (_haveCurrent && memcmp(keyName, _current.name, sizeof(_current.name)) == 0) {
+            key = &_current;
+            isCurrent = true;
+        } else if (_havePrevious && memcmp(keyName, _previous.name, sizeof(_previous.name)) == 0) {
+            key = &_previous;
+        }
+
+        if (!key) {
+            // The ticket was encrypted under a key we no longer have; fall back to a full
+            // handshake.
+            return 0;
+        }
+
+        if (HMAC_Init_ex(hctx, key->hmacKey, sizeof(key->hmacKey), EVP_sha256(), nullptr) != 1 ||
+            EVP_DecryptInit_ex(ctx, EVP_aes_128_cbc(), nullptr, key->aesKey, iv) != 1) {
+            return -1;
+        }
+
+        // Returning 2 instructs OpenSSL to accept the ticket but send the client a fresh one
+        // under the current key.
+        return (isCurrent && now - _currentCreated < kRotationInterval) ? 1 : 2;
+    }
+
+private:
+    static constexpr auto kRotationInterval = Hours{12};
+
+    struct Key {
+        unsigned char name[16];
+        unsigned char aesKey[16];
+        unsigned char hmacKey[32];
+    };
+
+    bool _rotateInLock(Date_t now) {
+        Key fresh;
+        if (RAND_bytes(fresh.name, sizeof(fresh.name)) != 1 ||
+            RAND_bytes(fresh.aesKey, sizeof(fresh.aesKey)) != 1 ||
+            RAND_bytes(fresh.hmacKey, sizeof(fresh.hmacKey)) != 1) {
+            error() << "Failed to generate a TLS session ticket key: "
+                    << SSLManagerInterface::getSSLErrorMessage(ERR_get_error());
+            return false;
+        }
+
+        _previous = _current;
+        _havePrevious = _haveCurrent;
+        _current = fresh;
+        _haveCurrent = true;
+        _currentCreated = now;
+        return true;
+    }
+
+    stdx::mutex _mutex;
+    Key _current;
+    Key _previous;
+    bool _haveCurrent = false;
+    bool _havePrevious = false;
+    Date_t _currentCreated;
+};
+
+int sslSessionTicketKeyCallback(SSL* ssl,
+                                unsigned char* keyName,
+                                unsigned char* iv,
+                                EVP_CIPHER_CTX* ctx,
+                                HMAC_CTX* hctx,
+                                int enc) {
+    return SSLSessionTicketKeyManager::get().handleTicket(keyName, iv, ctx, hctx, enc);
+}
+#endif  // SSL_CTRL_SET_TLSEXT_TICKET_KEY_CB
+
 ////////////////////////////////////////////////////////////////
 
 SimpleMutex sslManagerMtx;
@@ -704,6 +815,15 @@ Status SSLManager::initSSLContext(SSL_CTX* context,
                                     << getSSLErrorMessage(ERR_get_error()));
     }
 
+#ifdef SSL_CTRL_SET_TLSEXT_TICKET_KEY_CB
+    if (direction == ConnectionDirection::kIncoming) {
+        // Serve session tickets from the process-wide rotating key store, so that
+        // resumption keeps working across ticket key rotation and across all of the
+        // server's SSL contexts.
+        SSL_CTX_set_tlsext_ticket_key_cb(context, &sslSessionTicketKeyCallback);
+    }
+#endif
+
     if (direction == ConnectionDirection::kOutgoing && !params.sslClusterFile.empty()) {
         ::EVP_set_pw_prompt("Enter cluster certificate passphrase");
         if (!_setupPEM(context, params.sslClusterFile, params.sslClusterPassword)) {
@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects
+ *    for all of the code used other than as permitted herein. If you modify
+ *    file(s) with this exception, you may extend this exception to your
+ *    version of the file(s), but you are not obligated to do so. If you do not
+ *    wish to do so, delete this exception statement from your version. If you
+ *    delete this exception statement from all source files in the program,
+ *    then also delete it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "mongo/db/commands/server_status.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Reports how this process's resident memory is spread across NUMA nodes, so the effect
+ * of an interleaving policy (see the numactl startup warning) can be quantified from a
+ * live instance.
+ *
+ * Gathering the data walks /proc/self/numa_maps, which the kernel answers by scanning
+ * page tables, so the section is only included when explicitly requested with
+ * serverStatus({numa: 1}).
+ */
+class NumaServerStatusSection final : public ServerStatusSection {
+public:
+    NumaServerStatusSection() : ServerStatusSection("numa") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+#ifdef __linux__
+        std::ifstream maps("/proc/self/numa_maps", std::ifstream::in);
+        if (!maps.is_open()) {
+            builder.append("supported", false);
+            return builder.obj();
+        }
+        builder.append("supported", true);
+
+        // Each line describes one mapping:
+        //     <addr> <policy> [file=...|heap|stack] [anon=<pages>] [dirty=<pages>]
+        //     [N<node>=<pages>]... [kernelpagesize_kB=<kB>]
+        std::map<int, long long> residentBytesPerNode;
+        std::map<std::string, long long> mappingsPerPolicy;
+        const long long defaultPageSize = sysconf(_SC_PAGESIZE);
+
+        std::string line;
+        while (std::getline(maps, line)) {
+            std::istringstream tokens(line);
+            std::string addr;
+            std::string policy;
+            tokens >> addr >> policy;
+            if (policy.empty()) {
+                continue;
+            }
+            // Strip per-mapping policy details, e.g. "interleave:0-1" -> "interleave".
+            mappingsPerPolicy[policy.substr(0, policy.find(':'))]++;
+
+            std::map<int, long long> pagesPerNode;
+            long long pageSize = defaultPageSize;
+            std::string token;
+            while (tokens >> token) {
+                const size_t eq = token.find('=');
+                if (eq == std::string::npos) {
+                    continue;
+                }
+                if (token[0] == 'N') {
+                    pagesPerNode[atoi(token.substr(1, eq - 1).c_str())] +=
+                        atoll(token.c_str() + eq + 1);
+                } else if (token.compare(0, eq, "kernelpagesize_kB") == 0) {
+                    pageSize = atoll(token.c_str() + eq + 1) * 1024;
+                }
+            }
+            for (const auto& nodePages : pagesPerNode) {
+                residentBytesPerNode[nodePages.first] += nodePages.second * pageSize;
+            }
+        }
+
+        {
+            BSONObjBuilder policies(builder.subobjStart("mappingsPerPolicy"));
+            for (const auto& policyCount : mappingsPerPolicy) {
+                policies.appendNumber(policyCount.first, policyCount.second);
+            }
+        }
+
+        long long totalBytes = 0;
+        {
+            BSONObjBuilder nodes(builder.subobjStart("residentBytesPerNode"));
+            for (const auto& nodeBytes : residentBytesPerNode) {
+                std::ostringstream name;
+                name << "node" << nodeBytes.first;
+                nodes.appendNumber(name.str(), nodeBytes.second);
+                totalBytes += nodeBytes.second;
+            }
+        }
+        builder.appendNumber("totalResidentBytes", totalBytes);
+#else
+        builder.append("supported", false);
+#endif  // __linux__
+        return builder.obj();
+    }
+} numaServerStatusSection;
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/invariant.h"
+
+namespace mongo {
+
+/**
+ * A thread-safe caching structure with an approximate least recently used replacement policy,
+ * suitable for hot, read-mostly caches that would otherwise wrap an LRUCache in one mutex.
+ *
+ * Entries are partitioned into shards by key hash, each with its own lock, so lookups of
+ * different keys rarely contend. Within a shard, recency is tracked CLOCK-style: a hit only
+ * sets a referenced bit on the entry, rather than splicing it to the front of a list, and
+ * eviction sweeps a clock hand that skips (and clears the bit of) recently referenced entries.
+ * This makes hits cheap and concurrent at the cost of eviction order being approximate.
+ *
+ * Unlike LRUCache, lookups return the value by copy instead of an iterator, since references
+ * into the cache cannot outlive the shard lock. V is typically a value type or shared_ptr.
+ */
+template <typename K,
+          typename V,
+          typename Hash = typename stdx::unordered_map<K, V>::hasher,
+          typename KeyEqual = typename stdx::unordered_map<K, V, Hash>::key_equal>
+class ShardedLRUCache {
+    MONGO_DISALLOW_COPYING(ShardedLRUCache);
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+
+    /**
+     * Constructs a cache holding at most "maxSize" entries, partitioned into "numShards"
+     * shards. Each shard enforces its own share of the budget, so a skewed key distribution
+     * can evict from a hot shard while other shards have room.
+     */
+    explicit ShardedLRUCache(std::size_t maxSize, std::size_t numShards = 16)
+        : _numShards(std::max<std::size_t>(1, numShards)),
+          _perShardMaxSize(std::max<std::size_t>(1, maxSize / _numShards)),
+          _shards(_numShards) {
+        for (auto& shard : _shards) {
+            shard = stdx::make_unique<Shard>();
+        }
+    }
+
+    /**
+     * Inserts a new entry into the cache, replacing any existing entry with the same key.
+     * If the owning shard is full, evicts one entry, which is returned to the caller.
+     */
+    boost::optional<V> add(const K& key, V entry) {
+        Shard& shard = _shardFor(key);
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+
+        auto it = shard.map.find(key);
+        if (it != shard.map.end()) {
+            it->second.value = std::move(entry);
+            it->second.referenced = true;
+            return boost::none;
+        }
+
+        boost::optional<V> evicted;
+        if (shard.map.size() >= _perShardMaxSize) {
+            evicted = _evictOne(&shard);
+        }
+
+        shard.ring.push_back(key);
+        auto ringPos = std::prev(shard.ring.end());
+        shard.map.emplace(key, Entry{std::move(entry), false, ringPos});
+        return evicted;
+    }
+
+    /**
+     * Finds an entry in the cache by key, returning a copy of its value, and marks the entry
+     * as recently referenced.
+     */
+    boost::optional<V> get(const K& key) {
+        Shard& shard = _shardFor(key);
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return boost::none;
+        }
+        it->second.referenced = true;
+        return it->second.value;
+    }
+
+    /**
+     * Removes the entry with the given key, if present. Returns how many entries were
+     * removed.
+     */
+    std::size_t erase(const K& key) {
+        Shard& shard = _shardFor(key);
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return 0;
+        }
+        if (shard.hand == it->second.ringPos) {
+            ++shard.hand;
+        }
+        shard.ring.erase(it->second.ringPos);
+        shard.map.erase(it);
+        return 1;
+    }
+
+    /**
+     * Removes all entries from the cache.
+     */
+    void clear() {
+        for (auto& shard : _shards) {
+            stdx::lock_guard<stdx::mutex> lk(shard->mutex);
+            shard->map.clear();
+            shard->ring.clear();
+            shard->hand = shard->ring.end();
+        }
+    }
+
+    /**
+     * Returns the number of entries currently in the cache.
+     */
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (auto& shard : _shards) {
+            stdx::lock_guard<stdx::mutex> lk(shard->mutex);
+            total += shard->map.size();
+        }
+        return total;
+    }
+
+    /**
+     * Returns the total number of entries the cache can hold.
+     */
+    std::size_t maxSize() const {
+        return _perShardMaxSize * _numShards;
+    }
+
+private:
+    using Ring = std::list<K>;
+
+    struct Entry {
+        V value;
+        bool referenced;
+        typename Ring::iterator ringPos;
+    };
+
+    struct Shard {
+        stdx::mutex mutex;
+        stdx::unordered_map<K, Entry, Hash, KeyEqual> map;
+        Ring ring;
+        typename Ring::iterator hand = ring.end();
+    };
+
+    Shard& _shardFor(const K& key) {
+        return *_shards[Hash()(key) % _numShards];
+    }
+
+    /**
+     * Advances the clock hand until it finds an entry that has not been referenced since the
+     * hand last passed it, and evicts that entry. Referenced entries get their bit cleared
+     * and a second chance. Must be called with the shard lock held and the shard non-empty.
+     */
+    V _evictOne(Shard* shard) {
+        invariant(!shard->map.empty());
+        while (true) {
+            if (shard->hand == shard->ring.end()) {
+                shard->hand = shard->ring.begin();
+            }
+            auto it = shard->map.find(*shard->hand);
+            invariant(it != shard->map.end());
+            if (it->second.referenced) {
+                it->second.referenced = false;
+                ++shard->hand;
+                continue;
+            }
+            V evicted = std::move(it->second.value);
+            shard->hand = shard->ring.erase(it->second.ringPos);
+            shard->map.erase(it);
+            return evicted;
+        }
+    }
+
+    const std::size_t _numShards;
+    const std::size_t _perShardMaxSize;
+    std::vector<std::unique_ptr<Shard>> _shards;
+};
+
+}  // namespace mongo
@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2017 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/sharded_lru_cache.h"
+
+namespace mongo {
+namespace {
+
+TEST(ShardedLRUCache, AddGetAndErase) {
+    ShardedLRUCache<int, int> cache(100, 4);
+    ASSERT_FALSE(cache.get(1));
+
+    cache.add(1, 10);
+    cache.add(2, 20);
+    auto found = cache.get(1);
+    ASSERT_TRUE(static_cast<bool>(found));
+    ASSERT_EQUALS(10, *found);
+    ASSERT_EQUALS(2U, cache.size());
+
+    // Replacing a key does not grow the cache.
+    cache.add(1, 11);
+    found = cache.get(1);
+    ASSERT_EQUALS(11, *found);
+    ASSERT_EQUALS(2U, cache.size());
+
+    ASSERT_EQUALS(1U, cache.erase(1));
+    ASSERT_EQUALS(0U, cache.erase(1));
+    ASSERT_FALSE(cache.get(1));
+    ASSERT_EQUALS(1U, cache.size());
+}
+
+TEST(ShardedLRUCache, EvictionKeepsSizeBounded) {
+    ShardedLRUCache<int, int> cache(64, 4);
+    for (int i = 0; i < 10000; i++) {
+        cache.add(i, i);
+    }
+    ASSERT_LESS_THAN_OR_EQUALS(cache.size(), cache.maxSize());
+}
+
+TEST(ShardedLRUCache, SingleShardEvictionPrefersUnreferencedEntries) {
+    // One shard holding two entries makes the clock sweep deterministic.
+    ShardedLRUCache<int, int> cache(2, 1);
+    cache.add(1, 10);
+    cache.add(2, 20);
+
+    // Touch key 1 so the clock hand gives it a second chance; inserting a third entry must
+    // evict key 2.
+    ASSERT_TRUE(static_cast<bool>(cache.get(1)));
+    auto evicted = cache.add(3, 30);
+    ASSERT_TRUE(static_cast<bool>(evicted));
+    ASSERT_EQUALS(20, *evicted);
+    ASSERT_TRUE(static_cast<bool>(cache.get(1)));
+    ASSERT_FALSE(cache.get(2));
+    ASSERT_TRUE(static_cast<bool>(cache.get(3)));
+}
+
+TEST(ShardedLRUCache, ClearEmptiesAllShards) {
+    ShardedLRUCache<int, int> cache(100, 8);
+    for (int i = 0; i < 50; i++) {
+        cache.add(i, i);
+    }
+    cache.clear();
+    ASSERT_EQUALS(0U, cache.size());
+    ASSERT_FALSE(cache.get(25));
+    // The cache remains usable after a clear.
+    cache.add(1, 10);
+    ASSERT_TRUE(static_cast<bool>(cache.get(1)));
+}
+
+TEST(ShardedLRUCache, ConcurrentMixedWorkload) {
+    ShardedLRUCache<int, int> cache(128, 8);
+    const int kNumThreads = 8;
+    const int kOpsPerThread = 5000;
+
+    std::vector<stdx::thread> threads;
+    for (int t = 0; t < kNumThreads; t++) {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < kOpsPerThread; i++) {
+                const int key = (t * kOpsPerThread + i) % 500;
+                cache.add(key, key);
+                // Values always equal their key, concurrent eviction notwithstanding.
+                auto found = cache.get(key % 250);
+                if (found) {
+                    ASSERT_EQUALS(key % 250, *found);
+                }
+                if (i % 97 == 0) {
+                    cache.erase(key);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_LESS_THAN_OR_EQUALS(cache.size(), cache.maxSize());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -45,6 +45,10 @@
 #include "mongo/util/allocator.h"
 #include "mongo/util/mongoutils/str.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 
 namespace mongo {
@@ -119,34 +123,46 @@ inline int leadingOnes(unsigned char c) {
 }
 
 bool isValidUTF8(const std::string& s) {
-    return isValidUTF8(s.c_str());
+    return isValidUTF8(StringData(s));
 }
 
 bool isValidUTF8(const char* s) {
-    int left = 0;  // how many bytes are left in the current codepoint
-    while (*s) {
-        const unsigned char c = (unsigned char)*(s++);
+    return isValidUTF8(StringData(s));
+}
+
+bool isValidUTF8(StringData s) {
+    const char* p = s.rawData();
+    const size_t len = s.size();
+    size_t i = 0;
+    while (i < len) {
+#if defined(__SSE2__)
+        // At a codepoint boundary: consume runs of ASCII bytes 16 at a time. A chunk is
+        // all-ASCII iff no byte has its high bit set.
+        while (i + 16 <= len) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            if (_mm_movemask_epi8(chunk) != 0)
+                break;
+            i += 16;
+        }
+        if (i >= len)
+            break;
+#endif
+        const unsigned char c = (unsigned char)p[i++];
         const int ones = leadingOnes(c);
-        if (left) {
-            if (ones != 1)
+        if (ones == 0)
+            continue;  // ASCII byte
+        if (ones == 1)
+            return false;  // unexpected continuation byte
+        if (c > 0xF4)
+            return false;  // codepoint too large (< 0x10FFFF)
+        if (c == 0xC0 || c == 0xC1)
+            return false;  // codepoints <= 0x7F shouldn't be 2 bytes
+
+        for (int left = ones - 1; left; left--) {
+            if (i >= len || leadingOnes((unsigned char)p[i++]) != 1)
                 return false;  // should be a continuation byte
-            left--;
-        } else {
-            if (ones == 0)
-                continue;  // ASCII byte
-            if (ones == 1)
-                return false;  // unexpected continuation byte
-            if (c > 0xF4)
-                return false;  // codepoint too large (< 0x10FFFF)
-            if (c == 0xC0 || c == 0xC1)
-                return false;  // codepoints <= 0x7F shouldn't be 2 bytes
-
-            // still valid
-            left = ones - 1;
         }
     }
-    if (left != 0)
-        return false;  // string ended mid-codepoint
     return true;
 }
 
@@ -34,6 +34,7 @@
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
 #include "mongo/config.h"
 
 namespace mongo {
@@ -73,6 +74,12 @@ private:
 bool isValidUTF8(const char* s);
 bool isValidUTF8(const std::string& s);
 
+/* Length-based variant of the above. Runs of ASCII bytes are checked 16 at a time with SSE2
+ * where available, so this is the preferred form for bulk validation of length-prefixed data
+ * such as BSON strings. Embedded NUL bytes are treated as ordinary ASCII characters.
+ */
+bool isValidUTF8(StringData s);
+
 #if defined(_WIN32)
 
 std::string toUtf8String(const std::wstring& wide);